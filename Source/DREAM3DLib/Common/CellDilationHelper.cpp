@@ -0,0 +1,320 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "CellDilationHelper.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "DREAM3DLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief Finds the neighbor each **Cell** of a layer copies its data from. The votes only
+ * read the GrainIds so the **Cells** of a layer can be handled concurrently.
+ */
+class CellDilationVoteImpl
+{
+  public:
+    CellDilationVoteImpl(const int32_t* grainIds, const int64_t* dims, const int64_t* frontier, int64_t* sources,
+                         bool dilation, int32_t badMin, int32_t badMax, int32_t goodMin) :
+      m_GrainIds(grainIds),
+      m_Dims(dims),
+      m_Frontier(frontier),
+      m_Sources(sources),
+      m_Dilation(dilation),
+      m_BadMin(badMin),
+      m_BadMax(badMax),
+      m_GoodMin(goodMin)
+    {}
+    virtual ~CellDilationVoteImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      int64_t neighpoints[6];
+      neighpoints[0] = -m_Dims[0] * m_Dims[1];
+      neighpoints[1] = -m_Dims[0];
+      neighpoints[2] = -1;
+      neighpoints[3] = 1;
+      neighpoints[4] = m_Dims[0];
+      neighpoints[5] = m_Dims[0] * m_Dims[1];
+
+      int32_t grains[6];
+      int counts[6];
+      for (size_t t = start; t < end; ++t)
+      {
+        int64_t index = m_Frontier[t];
+        int64_t column = index % m_Dims[0];
+        int64_t row = (index / m_Dims[0]) % m_Dims[1];
+        int64_t plane = index / (m_Dims[0] * m_Dims[1]);
+        int64_t source = -1;
+        int numGrains = 0;
+        int most = 0;
+        for (int l = 0; l < 6; l++)
+        {
+          if (l == 0 && plane == 0) { continue; }
+          if (l == 5 && plane == (m_Dims[2] - 1)) { continue; }
+          if (l == 1 && row == 0) { continue; }
+          if (l == 4 && row == (m_Dims[1] - 1)) { continue; }
+          if (l == 2 && column == 0) { continue; }
+          if (l == 3 && column == (m_Dims[0] - 1)) { continue; }
+          int64_t neighpoint = index + neighpoints[l];
+          int32_t grain = m_GrainIds[neighpoint];
+          if (m_Dilation == true)
+          {
+            if (grain < m_GoodMin) { continue; }
+            int g = 0;
+            while (g < numGrains && grains[g] != grain) { g++; }
+            if (g == numGrains)
+            {
+              grains[g] = grain;
+              counts[g] = 0;
+              numGrains++;
+            }
+            counts[g]++;
+            if (counts[g] > most)
+            {
+              most = counts[g];
+              source = neighpoint;
+            }
+          }
+          else if (grain >= m_BadMin && grain <= m_BadMax)
+          {
+            source = neighpoint;
+          }
+        }
+        m_Sources[t] = source;
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const int32_t* m_GrainIds;
+    const int64_t* m_Dims;
+    const int64_t* m_Frontier;
+    int64_t* m_Sources;
+    bool m_Dilation;
+    int32_t m_BadMin;
+    int32_t m_BadMax;
+    int32_t m_GoodMin;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CellDilationHelper::CellDilationHelper(VoxelDataContainer* m, int32_t* grainIds, int32_t badMin, int32_t badMax, int32_t goodMin) :
+  m_DataContainer(m),
+  m_GrainIds(grainIds),
+  m_BadMin(badMin),
+  m_BadMax(badMax),
+  m_GoodMin(goodMin)
+{
+  size_t udims[3] = {0, 0, 0};
+  m->getDimensions(udims);
+  m_Dims[0] = static_cast<int64_t>(udims[0]);
+  m_Dims[1] = static_cast<int64_t>(udims[1]);
+  m_Dims[2] = static_cast<int64_t>(udims[2]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CellDilationHelper::~CellDilationHelper()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CellDilationHelper::dilate(int maxLayers)
+{
+  return run(true, maxLayers);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CellDilationHelper::erode(int maxLayers)
+{
+  return run(false, maxLayers);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t CellDilationHelper::run(bool dilation, int maxLayers)
+{
+  int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+  m_Queued.assign(totalPoints, 0);
+
+  int64_t neighpoints[6];
+  neighpoints[0] = -m_Dims[0] * m_Dims[1];
+  neighpoints[1] = -m_Dims[0];
+  neighpoints[2] = -1;
+  neighpoints[3] = 1;
+  neighpoints[4] = m_Dims[0];
+  neighpoints[5] = m_Dims[0] * m_Dims[1];
+
+  // The first layer is every Cell that will change and touches a Cell of the other kind.
+  // This is the only pass over the whole volume
+  std::vector<int64_t> frontier;
+  int64_t index = 0;
+  for (int64_t plane = 0; plane < m_Dims[2]; plane++)
+  {
+    for (int64_t row = 0; row < m_Dims[1]; row++)
+    {
+      for (int64_t column = 0; column < m_Dims[0]; column++, index++)
+      {
+        if ((dilation == true && isBad(m_GrainIds[index]) == false) || (dilation == false && isGood(m_GrainIds[index]) == false))
+        {
+          continue;
+        }
+        for (int l = 0; l < 6; l++)
+        {
+          if (l == 0 && plane == 0) { continue; }
+          if (l == 5 && plane == (m_Dims[2] - 1)) { continue; }
+          if (l == 1 && row == 0) { continue; }
+          if (l == 4 && row == (m_Dims[1] - 1)) { continue; }
+          if (l == 2 && column == 0) { continue; }
+          if (l == 3 && column == (m_Dims[0] - 1)) { continue; }
+          int32_t grain = m_GrainIds[index + neighpoints[l]];
+          if ((dilation == true && isGood(grain) == true) || (dilation == false && isBad(grain) == true))
+          {
+            frontier.push_back(index);
+            m_Queued[index] = 1;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<int64_t> sources;
+  std::vector<int64_t> targets;
+  std::vector<int64_t> next;
+  size_t changed = 0;
+  int layers = 0;
+  while (frontier.empty() == false && (maxLayers < 0 || layers < maxLayers))
+  {
+    sources.resize(frontier.size());
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size()),
+                        CellDilationVoteImpl(m_GrainIds, m_Dims, &(frontier.front()), &(sources.front()), dilation, m_BadMin, m_BadMax, m_GoodMin),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      CellDilationVoteImpl serial(m_GrainIds, m_Dims, &(frontier.front()), &(sources.front()), dilation, m_BadMin, m_BadMax, m_GoodMin);
+      serial.generate(0, frontier.size());
+    }
+
+    targets.clear();
+    size_t numSources = 0;
+    for (size_t t = 0; t < frontier.size(); t++)
+    {
+      if (sources[t] < 0) { continue; }
+      targets.push_back(frontier[t]);
+      sources[numSources++] = sources[t];
+    }
+    sources.resize(numSources);
+    copyCellData(targets, sources);
+    changed += targets.size();
+
+    // Only the Cells next to the ones that just changed can change in the next layer
+    next.clear();
+    for (size_t t = 0; t < targets.size(); t++)
+    {
+      index = targets[t];
+      int64_t column = index % m_Dims[0];
+      int64_t row = (index / m_Dims[0]) % m_Dims[1];
+      int64_t plane = index / (m_Dims[0] * m_Dims[1]);
+      for (int l = 0; l < 6; l++)
+      {
+        if (l == 0 && plane == 0) { continue; }
+        if (l == 5 && plane == (m_Dims[2] - 1)) { continue; }
+        if (l == 1 && row == 0) { continue; }
+        if (l == 4 && row == (m_Dims[1] - 1)) { continue; }
+        if (l == 2 && column == 0) { continue; }
+        if (l == 3 && column == (m_Dims[0] - 1)) { continue; }
+        int64_t neighpoint = index + neighpoints[l];
+        if (m_Queued[neighpoint] != 0) { continue; }
+        if ((dilation == true && isBad(m_GrainIds[neighpoint]) == true) || (dilation == false && isGood(m_GrainIds[neighpoint]) == true))
+        {
+          next.push_back(neighpoint);
+          m_Queued[neighpoint] = 1;
+        }
+      }
+    }
+    // Keeping the queue in index order keeps the work of each task to a few z slabs
+    std::sort(next.begin(), next.end());
+    frontier.swap(next);
+    layers++;
+  }
+  return changed;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CellDilationHelper::copyCellData(const std::vector<int64_t>& targets, const std::vector<int64_t>& sources)
+{
+  std::list<std::string> voxelArrayNames = m_DataContainer->getCellArrayNameList();
+  for (std::list<std::string>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer p = m_DataContainer->getCellData(*iter);
+    for (size_t t = 0; t < targets.size(); t++)
+    {
+      p->CopyTuple(sources[t], targets[t]);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _CellDilationHelper_H_
+#define _CellDilationHelper_H_
+
+#include <vector>
+
+#include "MXA/MXA.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+
+/**
+ * @class CellDilationHelper CellDilationHelper.h DREAM3DLib/Common/CellDilationHelper.h
+ * @brief Grows the good **Cells** of a volume into the bad ones (or the bad ones into
+ * the good ones) one layer at a time. This is the loop that FillBadData, MinSize,
+ * MinNeighbors and OpenCloseBadData used to run as repeated sweeps over the whole volume.
+ *
+ * Only the **Cells** on the boundary between the good and the bad regions are kept in
+ * a work queue, so the run time depends on the number of bad **Cells** instead of the
+ * size of the volume times the number of sweeps. The queue is kept in index order and
+ * the neighbor votes of a layer are found concurrently. Each layer only reads the
+ * GrainIds of the previous one, so the result is the same as the old sweeps.
+ *
+ * A **Cell** is bad if its GrainId is in [badMin, badMax] and good if its GrainId is at
+ * least goodMin. Any other **Cell** is neither grown into nor grows.
+ */
+class DREAM3DLib_EXPORT CellDilationHelper
+{
+  public:
+    CellDilationHelper(VoxelDataContainer* m, int32_t* grainIds, int32_t badMin, int32_t badMax, int32_t goodMin);
+    virtual ~CellDilationHelper();
+
+    /**
+     * @brief Each bad **Cell** next to a good one copies all the cell data of the good
+     * neighbor whose **Field** has the most faces in common with it. Ties go to the
+     * neighbor that reached the highest count first in the order -z, -y, -x, +x, +y, +z.
+     * @param maxLayers The number of layers to fill, or -1 to fill until no bad **Cell**
+     * touches a good one.
+     * @return The number of **Cells** that were filled
+     */
+    size_t dilate(int maxLayers);
+
+    /**
+     * @brief Each good **Cell** next to a bad one copies all the cell data of the bad
+     * neighbor with the largest index.
+     * @param maxLayers The number of layers to erode, or -1 to erode until nothing changes.
+     * @return The number of **Cells** that were eroded
+     */
+    size_t erode(int maxLayers);
+
+  private:
+    VoxelDataContainer* m_DataContainer;
+    int32_t* m_GrainIds;
+    int32_t m_BadMin;
+    int32_t m_BadMax;
+    int32_t m_GoodMin;
+    int64_t m_Dims[3];
+    std::vector<char> m_Queued;
+
+    bool isBad(int32_t grain) const { return grain >= m_BadMin && grain <= m_BadMax; }
+    bool isGood(int32_t grain) const { return grain >= m_GoodMin; }
+
+    size_t run(bool dilation, int maxLayers);
+    void copyCellData(const std::vector<int64_t>& targets, const std::vector<int64_t>& sources);
+
+    CellDilationHelper(const CellDilationHelper&); // Copy Constructor Not Implemented
+    void operator=(const CellDilationHelper&); // Operator '=' Not Implemented
+};
+
+#endif /* _CellDilationHelper_H_ */
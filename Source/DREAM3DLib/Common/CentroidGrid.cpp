@@ -0,0 +1,209 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "CentroidGrid.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CentroidGrid::CentroidGrid() :
+  m_Points(NULL),
+  m_CellSize(1.0f)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    m_Origin[i] = 0.0f;
+    m_Min[i] = 0;
+    m_Dims[i] = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CentroidGrid::~CentroidGrid()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CentroidGrid::getCell(const float xyz[3], int cell[3]) const
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    cell[a] = static_cast<int>((xyz[a] - m_Origin[a]) / m_CellSize);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CentroidGrid::build(const float* points, size_t first, size_t end, float cellSize, const float origin[3], const bool* skip)
+{
+  m_Points = points;
+  m_CellSize = (cellSize > 0.0f) ? cellSize : 1.0f;
+  m_Origin[0] = origin[0];
+  m_Origin[1] = origin[1];
+  m_Origin[2] = origin[2];
+  m_CellOffsets.clear();
+  m_CellPoints.clear();
+
+  // Find the range of cells that hold points
+  int max[3] = {0, 0, 0};
+  bool empty = true;
+  int cell[3];
+  std::vector<int> cells(3 * end, 0);
+  for (size_t i = first; i < end; ++i)
+  {
+    if (NULL != skip && skip[i] == true) { continue; }
+    getCell(m_Points + 3 * i, cell);
+    for (int a = 0; a < 3; ++a)
+    {
+      cells[3 * i + a] = cell[a];
+      if (empty == true || cell[a] < m_Min[a]) { m_Min[a] = cell[a]; }
+      if (empty == true || cell[a] > max[a]) { max[a] = cell[a]; }
+    }
+    empty = false;
+  }
+  if (empty == true)
+  {
+    m_Dims[0] = m_Dims[1] = m_Dims[2] = 0;
+    return;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    m_Dims[a] = max[a] - m_Min[a] + 1;
+  }
+  size_t numCells = static_cast<size_t>(m_Dims[0]) * m_Dims[1] * m_Dims[2];
+
+  // Counting sort of the points by cell. The points of a cell stay in index order
+  m_CellOffsets.assign(numCells + 1, 0);
+  std::vector<size_t> pointCells(end, 0);
+  for (size_t i = first; i < end; ++i)
+  {
+    if (NULL != skip && skip[i] == true) { continue; }
+    size_t index = (static_cast<size_t>(cells[3 * i + 2] - m_Min[2]) * m_Dims[1] + (cells[3 * i + 1] - m_Min[1])) * m_Dims[0] + (cells[3 * i] - m_Min[0]);
+    pointCells[i] = index;
+    m_CellOffsets[index + 1]++;
+  }
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    m_CellOffsets[c + 1] += m_CellOffsets[c];
+  }
+  m_CellPoints.resize(m_CellOffsets[numCells]);
+  std::vector<size_t> fill(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+  for (size_t i = first; i < end; ++i)
+  {
+    if (NULL != skip && skip[i] == true) { continue; }
+    m_CellPoints[fill[pointCells[i]]++] = static_cast<int>(i);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CentroidGrid::appendCells(const int lo[3], const int hi[3], std::vector<int>& result) const
+{
+  int l[3], h[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    l[a] = std::max(lo[a] - m_Min[a], 0);
+    h[a] = std::min(hi[a] - m_Min[a], m_Dims[a] - 1);
+    if (l[a] > h[a]) { return; }
+  }
+  for (int z = l[2]; z <= h[2]; ++z)
+  {
+    for (int y = l[1]; y <= h[1]; ++y)
+    {
+      size_t row = (static_cast<size_t>(z) * m_Dims[1] + y) * m_Dims[0];
+      // The cells of a row are next to each other in the flat list
+      size_t start = m_CellOffsets[row + l[0]];
+      size_t end = m_CellOffsets[row + h[0] + 1];
+      result.insert(result.end(), m_CellPoints.begin() + start, m_CellPoints.begin() + end);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CentroidGrid::findInCellRange(const int cell[3], int reach, std::vector<int>& result) const
+{
+  if (reach < 0 || m_CellPoints.empty() == true) { return; }
+  int lo[3], hi[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    lo[a] = cell[a] - reach;
+    hi[a] = cell[a] + reach;
+  }
+  appendCells(lo, hi, result);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CentroidGrid::findInRadius(const float xyz[3], float radius, std::vector<int>& result) const
+{
+  if (radius < 0.0f || m_CellPoints.empty() == true) { return; }
+  // Rounding towards zero never decreases, so the cells of the corners of the box
+  // around the sphere bound the cells of every point inside it
+  float corner[3];
+  int lo[3], hi[3];
+  for (int a = 0; a < 3; ++a) { corner[a] = xyz[a] - radius; }
+  getCell(corner, lo);
+  for (int a = 0; a < 3; ++a) { corner[a] = xyz[a] + radius; }
+  getCell(corner, hi);
+
+  size_t start = result.size();
+  appendCells(lo, hi, result);
+  float radius2 = radius * radius;
+  size_t kept = start;
+  for (size_t r = start; r < result.size(); ++r)
+  {
+    const float* p = m_Points + 3 * result[r];
+    float dx = p[0] - xyz[0];
+    float dy = p[1] - xyz[1];
+    float dz = p[2] - xyz[2];
+    if (dx * dx + dy * dy + dz * dz <= radius2)
+    {
+      result[kept++] = result[r];
+    }
+  }
+  result.resize(kept);
+}
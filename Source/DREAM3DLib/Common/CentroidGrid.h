@@ -0,0 +1,105 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _CentroidGrid_H_
+#define _CentroidGrid_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "MXA/MXA.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+
+/**
+ * @class CentroidGrid CentroidGrid.h DREAM3DLib/Common/CentroidGrid.h
+ * @brief Uniform grid of cubic cells over a set of points, usually the centroids of
+ * the **Fields**, for finding the points near a location without looking at all of
+ * them. The points of each cell are kept in one flat list with an offset per cell.
+ *
+ * The cell of a coordinate is int((x - origin) / cellSize) on each axis, which is how
+ * FindNeighborhoods has always binned the centroids. The query methods are const and
+ * may be called from several threads at once once the grid is built.
+ */
+class DREAM3DLib_EXPORT CentroidGrid
+{
+  public:
+    CentroidGrid();
+    virtual ~CentroidGrid();
+
+    /**
+     * @brief Bins the xyz triples of 'points' with an index from 'first' up to but not
+     * including 'end'. The array is not copied and must outlive the grid.
+     * @param skip Optional flags. Points whose flag is true are left out of the grid
+     */
+    void build(const float* points, size_t first, size_t end, float cellSize, const float origin[3], const bool* skip = NULL);
+
+    /**
+     * @brief The cell of a location. The cell may be outside of the grid.
+     */
+    void getCell(const float xyz[3], int cell[3]) const;
+
+    float getCellSize() const { return m_CellSize; }
+
+    /**
+     * @brief Appends to 'result' the points whose cell is at most 'reach' cells away
+     * from 'cell' along every axis, in no particular order.
+     */
+    void findInCellRange(const int cell[3], int reach, std::vector<int>& result) const;
+
+    /**
+     * @brief Appends to 'result' the points that are at most 'radius' from 'xyz', in
+     * no particular order.
+     */
+    void findInRadius(const float xyz[3], float radius, std::vector<int>& result) const;
+
+  private:
+    const float* m_Points;
+    float m_CellSize;
+    float m_Origin[3];
+    int m_Min[3];
+    int m_Dims[3];
+    std::vector<size_t> m_CellOffsets;
+    std::vector<int> m_CellPoints;
+
+    void appendCells(const int lo[3], const int hi[3], std::vector<int>& result) const;
+
+    CentroidGrid(const CentroidGrid&); // Copy Constructor Not Implemented
+    void operator=(const CentroidGrid&); // Operator '=' Not Implemented
+};
+
+#endif /* _CentroidGrid_H_ */
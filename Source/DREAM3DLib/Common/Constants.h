@@ -292,6 +292,8 @@ namespace DREAM3D
     const DREAM3D_STRING SurfaceMeshDataContainerName("SurfaceMeshDataContainer");
     const DREAM3D_STRING SolidMeshDataContainerName("SolidMeshDataContainer");
     const DREAM3D_STRING MeshVertLinksName("MeshVertLinks");
+    const DREAM3D_STRING MeshVertLinksOffsetsName("MeshVertLinksOffsets");
+    const DREAM3D_STRING MeshVertLinksFacesName("MeshVertLinksFaces");
 
     const DREAM3D_STRING VoxelDataName("VoxelData");
     const DREAM3D_STRING PipelineGroupName("Pipeline");
@@ -303,6 +305,8 @@ namespace DREAM3D
     const DREAM3D_STRING EdgesName("Edges");
     const DREAM3D_STRING MeshLinksName("MeshLinks");
     const DREAM3D_STRING MeshFaceNeighborLists("MeshFaceNeighborLists");
+    const DREAM3D_STRING MeshFaceNeighborListsOffsets("MeshFaceNeighborListsOffsets");
+    const DREAM3D_STRING MeshFaceNeighborListsFaces("MeshFaceNeighborListsFaces");
 
     //  const DREAM3D_STRING Grain_ID("Grain_ID");
     // const DREAM3D_STRING SchmidFactor ("SchmidFactor");
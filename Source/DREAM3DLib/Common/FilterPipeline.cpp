@@ -41,6 +41,7 @@
 FilterPipeline::FilterPipeline() :
     Observer(),
     m_ErrorCondition(0),
+    m_Profiler(PipelineProfiler::NullPointer()),
     m_Cancel(false)
 {
 
@@ -359,7 +360,15 @@ void FilterPipeline::execute()
     (*iter)->setSurfaceMeshDataContainer(sm.get());
     (*iter)->setSolidMeshDataContainer(solid.get());
     setCurrentFilter(*iter);
+    if (NULL != m_Profiler.get())
+    {
+      m_Profiler->startFilter((*iter).get());
+    }
     (*iter)->execute();
+    if (NULL != m_Profiler.get())
+    {
+      m_Profiler->endFilter((*iter).get());
+    }
     (*iter)->removeObserver(static_cast<Observer*>(this));
     (*iter)->setVoxelDataContainer(NULL);
     (*iter)->setSurfaceMeshDataContainer(NULL);
@@ -40,6 +40,7 @@
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 #include "DREAM3DLib/Common/Observer.h"
 #include "DREAM3DLib/Common/AbstractFilter.h"
+#include "DREAM3DLib/Common/PipelineProfiler.h"
 
 /**
  * @class FilterPipeline FilterPipeline.h DREAM3DLib/Common/FilterPipeline.h
@@ -63,6 +64,10 @@ class DREAM3DLib_EXPORT FilterPipeline : public Observer
 
     DREAM3D_INSTANCE_PROPERTY(int, ErrorCondition)
     DREAM3D_INSTANCE_PROPERTY(AbstractFilter::Pointer, CurrentFilter)
+    /**
+     * @brief If set, each filter that executes is profiled into this object
+     */
+    DREAM3D_INSTANCE_PROPERTY(PipelineProfiler::Pointer, Profiler)
 
     /**
      * @brief Cancel the operation
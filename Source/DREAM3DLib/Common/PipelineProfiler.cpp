@@ -0,0 +1,404 @@
+/* ============================================================================
+ * Copyright (c) 2011, Michael A. Jackson (BlueQuartz Software)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Jackson nor the names of its contributors may
+ * be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineProfiler.h"
+
+#if defined (_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#if defined (_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include <list>
+
+#include "MXA/Common/LogTime.h"
+
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/DataContainers/SolidMeshDataContainer.h"
+
+namespace Detail
+{
+  static const char* ArrayGroupNames[FilterProfile::NumArrayGroups] = { "Cell", "Field", "Ensemble", "Mesh" };
+
+  /**
+   * @brief Returns the number of bytes held by the array or 0 for a NULL array
+   */
+  static uint64_t arrayBytes(IDataArray::Pointer array)
+  {
+    if (NULL == array.get()) { return 0; }
+    return static_cast<uint64_t>(array->GetSize()) * static_cast<uint64_t>(array->GetTypeSize());
+  }
+
+  /**
+   * @brief Writes the string as a quoted JSON string
+   */
+  static void writeJsonString(std::ostream &out, const std::string &str)
+  {
+    out << "\"";
+    for (std::string::size_type i = 0; i < str.size(); ++i)
+    {
+      char c = str[i];
+      if (c == '"' || c == '\\') { out << '\\' << c; }
+      else if (c == '\n') { out << "\\n"; }
+      else if (c == '\t') { out << "\\t"; }
+      else { out << c; }
+    }
+    out << "\"";
+  }
+
+  /**
+   * @brief Writes the string as a CSV field, quoting it if it holds a delimiter or a quote
+   */
+  static void writeCsvString(std::ostream &out, const std::string &str)
+  {
+    if (str.find_first_of(",\"\n") == std::string::npos)
+    {
+      out << str;
+      return;
+    }
+    out << "\"";
+    for (std::string::size_type i = 0; i < str.size(); ++i)
+    {
+      if (str[i] == '"') { out << "\""; }
+      out << str[i];
+    }
+    out << "\"";
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterProfile::FilterProfile() :
+  pipelineIndex(-1),
+  errorCondition(0),
+  wallMillis(0),
+  cpuMillis(0),
+  peakRssDelta(0)
+{
+  for (int i = 0; i < NumArrayGroups; ++i)
+  {
+    bytesCreated[i] = 0;
+    bytesRemoved[i] = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfiler::PipelineProfiler() :
+  m_StartWallMillis(0),
+  m_StartCpuMillis(0),
+  m_StartPeakRss(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineProfiler::~PipelineProfiler()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t PipelineProfiler::getProcessCpuMillis()
+{
+#if defined (_WIN32)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime) == 0)
+  {
+    return 0;
+  }
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  // FILETIME counts in 100 nanosecond intervals
+  return (kernel.QuadPart + user.QuadPart) / 10000;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+  uint64_t millis = static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000;
+  millis += static_cast<uint64_t>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+  return millis;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PipelineProfiler::getPeakRss()
+{
+#if defined (_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<int64_t>(counters.PeakWorkingSetSize);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined (__APPLE__)
+  // OS X reports bytes
+  return static_cast<int64_t>(usage.ru_maxrss);
+#else
+  // Linux reports kilobytes
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::collectArraySizes(AbstractFilter* filter, ArraySizeMap* sizes)
+{
+  for (int i = 0; i < FilterProfile::NumArrayGroups; ++i)
+  {
+    sizes[i].clear();
+  }
+  std::list<std::string> names;
+
+  VoxelDataContainer* m = filter->getVoxelDataContainer();
+  if (NULL != m)
+  {
+    names = m->getCellArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      sizes[FilterProfile::CellArrays]["Voxel/" + *iter] = Detail::arrayBytes(m->getCellData(*iter));
+    }
+    names = m->getFieldArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      sizes[FilterProfile::FieldArrays]["Voxel/" + *iter] = Detail::arrayBytes(m->getFieldData(*iter));
+    }
+    names = m->getEnsembleArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      sizes[FilterProfile::EnsembleArrays]["Voxel/" + *iter] = Detail::arrayBytes(m->getEnsembleData(*iter));
+    }
+  }
+
+  SurfaceMeshDataContainer* sm = filter->getSurfaceMeshDataContainer();
+  if (NULL != sm)
+  {
+    ArraySizeMap& mesh = sizes[FilterProfile::MeshArrays];
+    mesh["SurfaceMesh/Vertices"] = Detail::arrayBytes(sm->getVertices());
+    mesh["SurfaceMesh/Faces"] = Detail::arrayBytes(sm->getFaces());
+    names = sm->getPointArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SurfaceMesh/Vertex/" + *iter] = Detail::arrayBytes(sm->getVertexData(*iter));
+    }
+    names = sm->getFaceArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SurfaceMesh/Face/" + *iter] = Detail::arrayBytes(sm->getFaceData(*iter));
+    }
+    names = sm->getEdgeArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SurfaceMesh/Edge/" + *iter] = Detail::arrayBytes(sm->getEdgeData(*iter));
+    }
+    names = sm->getFieldArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      sizes[FilterProfile::FieldArrays]["SurfaceMesh/" + *iter] = Detail::arrayBytes(sm->getFieldData(*iter));
+    }
+    names = sm->getEnsembleArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      sizes[FilterProfile::EnsembleArrays]["SurfaceMesh/" + *iter] = Detail::arrayBytes(sm->getEnsembleData(*iter));
+    }
+  }
+
+  SolidMeshDataContainer* solid = filter->getSolidMeshDataContainer();
+  if (NULL != solid)
+  {
+    ArraySizeMap& mesh = sizes[FilterProfile::MeshArrays];
+    mesh["SolidMesh/Vertices"] = Detail::arrayBytes(solid->getVertices());
+    mesh["SolidMesh/Tetrahedrons"] = Detail::arrayBytes(solid->getTetrahedrons());
+    names = solid->getPointArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SolidMesh/Vertex/" + *iter] = Detail::arrayBytes(solid->getVertexData(*iter));
+    }
+    names = solid->getFaceArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SolidMesh/Face/" + *iter] = Detail::arrayBytes(solid->getFaceData(*iter));
+    }
+    names = solid->getEdgeArrayNameList();
+    for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+    {
+      mesh["SolidMesh/Edge/" + *iter] = Detail::arrayBytes(solid->getEdgeData(*iter));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::startFilter(AbstractFilter* filter)
+{
+  collectArraySizes(filter, m_ArraySizes);
+  m_StartPeakRss = getPeakRss();
+  m_StartCpuMillis = getProcessCpuMillis();
+  m_StartWallMillis = MXA::getMilliSeconds();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::endFilter(AbstractFilter* filter)
+{
+  FilterProfile profile;
+  profile.wallMillis = MXA::getMilliSeconds() - m_StartWallMillis;
+  profile.cpuMillis = getProcessCpuMillis() - m_StartCpuMillis;
+  profile.peakRssDelta = getPeakRss() - m_StartPeakRss;
+  profile.pipelineIndex = filter->getPipelineIndex();
+  profile.filterClassName = filter->getNameOfClass();
+  profile.humanLabel = filter->getHumanLabel();
+  profile.errorCondition = filter->getErrorCondition();
+
+  // An array that grew or is new counts as created, one that shrank or is gone as removed
+  ArraySizeMap after[FilterProfile::NumArrayGroups];
+  collectArraySizes(filter, after);
+  for (int i = 0; i < FilterProfile::NumArrayGroups; ++i)
+  {
+    ArraySizeMap& before = m_ArraySizes[i];
+    for (ArraySizeMap::iterator iter = after[i].begin(); iter != after[i].end(); ++iter)
+    {
+      ArraySizeMap::iterator old = before.find(iter->first);
+      uint64_t oldBytes = (old == before.end()) ? 0 : old->second;
+      if (iter->second > oldBytes) { profile.bytesCreated[i] += iter->second - oldBytes; }
+      else { profile.bytesRemoved[i] += oldBytes - iter->second; }
+    }
+    for (ArraySizeMap::iterator iter = before.begin(); iter != before.end(); ++iter)
+    {
+      if (after[i].find(iter->first) == after[i].end()) { profile.bytesRemoved[i] += iter->second; }
+    }
+    before.clear();
+  }
+  m_Profiles.push_back(profile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::clear()
+{
+  m_Profiles.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<FilterProfile>& PipelineProfiler::getProfiles()
+{
+  return m_Profiles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::writeJson(std::ostream &out)
+{
+  out << "{" << std::endl;
+  out << "  \"Filters\": [";
+  for (size_t p = 0; p < m_Profiles.size(); ++p)
+  {
+    FilterProfile& profile = m_Profiles[p];
+    out << (p == 0 ? "" : ",") << std::endl;
+    out << "    {" << std::endl;
+    out << "      \"PipelineIndex\": " << profile.pipelineIndex << "," << std::endl;
+    out << "      \"ClassName\": ";
+    Detail::writeJsonString(out, profile.filterClassName);
+    out << "," << std::endl;
+    out << "      \"HumanLabel\": ";
+    Detail::writeJsonString(out, profile.humanLabel);
+    out << "," << std::endl;
+    out << "      \"ErrorCondition\": " << profile.errorCondition << "," << std::endl;
+    out << "      \"WallMillis\": " << profile.wallMillis << "," << std::endl;
+    out << "      \"CpuMillis\": " << profile.cpuMillis << "," << std::endl;
+    out << "      \"PeakRssDeltaBytes\": " << profile.peakRssDelta;
+    for (int i = 0; i < FilterProfile::NumArrayGroups; ++i)
+    {
+      out << "," << std::endl << "      \"" << Detail::ArrayGroupNames[i] << "BytesCreated\": " << profile.bytesCreated[i];
+      out << "," << std::endl << "      \"" << Detail::ArrayGroupNames[i] << "BytesRemoved\": " << profile.bytesRemoved[i];
+    }
+    out << std::endl << "    }";
+  }
+  out << std::endl << "  ]" << std::endl;
+  out << "}" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineProfiler::writeCsv(std::ostream &out)
+{
+  out << "PipelineIndex,ClassName,HumanLabel,ErrorCondition,WallMillis,CpuMillis,PeakRssDeltaBytes";
+  for (int i = 0; i < FilterProfile::NumArrayGroups; ++i)
+  {
+    out << "," << Detail::ArrayGroupNames[i] << "BytesCreated," << Detail::ArrayGroupNames[i] << "BytesRemoved";
+  }
+  out << std::endl;
+  for (size_t p = 0; p < m_Profiles.size(); ++p)
+  {
+    FilterProfile& profile = m_Profiles[p];
+    out << profile.pipelineIndex << ",";
+    Detail::writeCsvString(out, profile.filterClassName);
+    out << ",";
+    Detail::writeCsvString(out, profile.humanLabel);
+    out << "," << profile.errorCondition << "," << profile.wallMillis << "," << profile.cpuMillis << "," << profile.peakRssDelta;
+    for (int i = 0; i < FilterProfile::NumArrayGroups; ++i)
+    {
+      out << "," << profile.bytesCreated[i] << "," << profile.bytesRemoved[i];
+    }
+    out << std::endl;
+  }
+}
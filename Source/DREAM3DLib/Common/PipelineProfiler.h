@@ -0,0 +1,154 @@
+/* ============================================================================
+ * Copyright (c) 2011, Michael A. Jackson (BlueQuartz Software)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Jackson nor the names of its contributors may
+ * be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _PipelineProfiler_H_
+#define _PipelineProfiler_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
+#include "DREAM3DLib/Common/AbstractFilter.h"
+
+/**
+ * @brief The performance numbers that were recorded for one filter of a pipeline
+ */
+struct DREAM3DLib_EXPORT FilterProfile
+{
+  /**
+   * @brief The groups of arrays that the created and removed bytes are reported for.
+   * Mesh holds the vertex, face and edge arrays of the surface and solid meshes.
+   */
+  enum ArrayGroup
+  {
+    CellArrays = 0,
+    FieldArrays,
+    EnsembleArrays,
+    MeshArrays,
+    NumArrayGroups
+  };
+
+  FilterProfile();
+
+  int pipelineIndex;
+  std::string filterClassName;
+  std::string humanLabel;
+  int errorCondition;
+  uint64_t wallMillis;
+  uint64_t cpuMillis;
+  int64_t peakRssDelta;
+  uint64_t bytesCreated[NumArrayGroups];
+  uint64_t bytesRemoved[NumArrayGroups];
+};
+
+/**
+ * @class PipelineProfiler PipelineProfiler.h DREAM3DLib/Common/PipelineProfiler.h
+ * @brief Records the wall time, CPU time, growth of the peak resident memory and the
+ * bytes of the arrays that each filter of a pipeline creates or removes. Set an instance
+ * on a FilterPipeline with setProfiler() before running it and then write the report
+ * with writeJson() or writeCsv().
+ *
+ * The CPU time is the time of the whole process so it includes any threads that the
+ * filter starts. The peak resident memory only grows, so the delta is how far a filter
+ * raised the high water mark of the process and is 0 for a filter that stays below it.
+ * @version 1.0
+ */
+class DREAM3DLib_EXPORT PipelineProfiler
+{
+  public:
+    DREAM3D_SHARED_POINTERS(PipelineProfiler)
+    DREAM3D_TYPE_MACRO(PipelineProfiler)
+    DREAM3D_STATIC_NEW_MACRO(PipelineProfiler)
+
+    virtual ~PipelineProfiler();
+
+    /**
+     * @brief Takes a snapshot of the clocks and of the arrays in the data containers
+     * that are set on the filter. Call this just before the filter executes.
+     */
+    void startFilter(AbstractFilter* filter);
+
+    /**
+     * @brief Compares the clocks and the arrays against the snapshot from startFilter()
+     * and appends the results to the list of profiles. Call this right after the filter
+     * executes and before its data containers are removed.
+     */
+    void endFilter(AbstractFilter* filter);
+
+    /**
+     * @brief Removes all of the recorded profiles
+     */
+    void clear();
+
+    std::vector<FilterProfile>& getProfiles();
+
+    /**
+     * @brief Writes the recorded profiles as a JSON document
+     */
+    void writeJson(std::ostream &out);
+
+    /**
+     * @brief Writes the recorded profiles as comma separated values with a header line
+     */
+    void writeCsv(std::ostream &out);
+
+    /**
+     * @brief Returns the user plus system CPU time of the process in milliseconds
+     */
+    static uint64_t getProcessCpuMillis();
+
+    /**
+     * @brief Returns the peak resident memory of the process in bytes or 0 if the
+     * platform does not report it
+     */
+    static int64_t getPeakRss();
+
+  protected:
+    PipelineProfiler();
+
+  private:
+    typedef std::map<std::string, uint64_t> ArraySizeMap;
+
+    std::vector<FilterProfile> m_Profiles;
+    ArraySizeMap m_ArraySizes[FilterProfile::NumArrayGroups];
+    uint64_t m_StartWallMillis;
+    uint64_t m_StartCpuMillis;
+    int64_t m_StartPeakRss;
+
+    void collectArraySizes(AbstractFilter* filter, ArraySizeMap* sizes);
+
+    PipelineProfiler(const PipelineProfiler&); // Copy Constructor Not Implemented
+    void operator=(const PipelineProfiler&); // Operator '=' Not Implemented
+};
+
+#endif /* _PipelineProfiler_H_ */
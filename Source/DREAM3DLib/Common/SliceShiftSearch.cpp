@@ -0,0 +1,420 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SliceShiftSearch.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <complex>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "DREAM3DLib/Math/DREAM3DMath.h"
+
+typedef std::complex<double> ComplexType;
+
+/**
+ * @brief Searches the shifts of a range of slices
+ */
+class SliceShiftSearchImpl
+{
+    const SliceShiftSearch* m_Search;
+    int* m_XShifts;
+    int* m_YShifts;
+
+  public:
+    SliceShiftSearchImpl(const SliceShiftSearch* search, int* xshifts, int* yshifts) :
+      m_Search(search),
+      m_XShifts(xshifts),
+      m_YShifts(yshifts)
+    {}
+    virtual ~SliceShiftSearchImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t slice = start; slice < end; ++slice)
+      {
+        m_Search->findShift(static_cast<int64_t>(slice), m_XShifts[slice], m_YShifts[slice]);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+// Plain complex product, std::complex checks for infinities on every multiply
+// -----------------------------------------------------------------------------
+static inline ComplexType mul(const ComplexType &a, const ComplexType &b)
+{
+  return ComplexType(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// -----------------------------------------------------------------------------
+// exp(-2 pi i k / n) for k < n / 2
+// -----------------------------------------------------------------------------
+static void twiddles(size_t n, std::vector<ComplexType> &w)
+{
+  w.resize(n / 2);
+  for (size_t k = 0; k < n / 2; ++k)
+  {
+    double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+    w[k] = ComplexType(cos(angle), sin(angle));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// In place radix 2 transform of n contiguous values
+// -----------------------------------------------------------------------------
+static void fft(ComplexType* data, size_t n, const std::vector<ComplexType> &w, bool inverse)
+{
+  for (size_t i = 1, j = 0; i < n; ++i)
+  {
+    size_t bit = n >> 1;
+    for (; (j & bit) != 0; bit >>= 1)
+    {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) { std::swap(data[i], data[j]); }
+  }
+  for (size_t len = 2; len <= n; len <<= 1)
+  {
+    size_t half = len / 2;
+    size_t stride = n / len;
+    for (size_t i = 0; i < n; i += len)
+    {
+      for (size_t j = 0; j < half; ++j)
+      {
+        ComplexType t = inverse ? std::conj(w[j * stride]) : w[j * stride];
+        ComplexType u = data[i + j];
+        ComplexType v = mul(data[i + j + half], t);
+        data[i + j] = u + v;
+        data[i + j + half] = u - v;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// 2D transform of a px * py image stored row by row. The inverse is not scaled.
+// -----------------------------------------------------------------------------
+static void fft2(std::vector<ComplexType> &data, size_t px, size_t py, const std::vector<ComplexType> &wx,
+                 const std::vector<ComplexType> &wy, bool inverse)
+{
+  for (size_t y = 0; y < py; ++y)
+  {
+    fft(&(data[y * px]), px, wx, inverse);
+  }
+  std::vector<ComplexType> column(py);
+  for (size_t x = 0; x < px; ++x)
+  {
+    for (size_t y = 0; y < py; ++y) { column[y] = data[y * px + x]; }
+    fft(&(column.front()), py, wy, inverse);
+    for (size_t y = 0; y < py; ++y) { data[y * px + x] = column[y]; }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Splits the transform z of a + ib, with a and b real, into the transforms of a and b
+// -----------------------------------------------------------------------------
+static void unpack(const std::vector<ComplexType> &z, size_t px, size_t py, std::vector<ComplexType> &a, std::vector<ComplexType> &b)
+{
+  const ComplexType halfI(0.0, -0.5);
+  for (size_t y = 0; y < py; ++y)
+  {
+    size_t my = (py - y) % py;
+    for (size_t x = 0; x < px; ++x)
+    {
+      size_t mx = (px - x) % px;
+      ComplexType zk = z[y * px + x];
+      ComplexType zm = std::conj(z[my * px + mx]);
+      a[y * px + x] = 0.5 * (zk + zm);
+      b[y * px + x] = mul(halfI, zk - zm);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static size_t nextPowerOfTwo(int64_t value)
+{
+  size_t p = 1;
+  while (static_cast<int64_t>(p) < value) { p <<= 1; }
+  return p;
+}
+
+// -----------------------------------------------------------------------------
+// Floor division for possibly negative numerators
+// -----------------------------------------------------------------------------
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+  int64_t q = a / b;
+  if (q * b > a) { --q; }
+  return q;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceShiftSearch::SliceShiftSearch(const SliceShiftScorer* scorer, const size_t dims[3]) :
+  m_PyramidLevels(0),
+  m_PreferSmallShifts(false),
+  m_UseCostTable(false),
+  m_Scorer(scorer)
+{
+  m_Dims[0] = static_cast<int64_t>(dims[0]);
+  m_Dims[1] = static_cast<int64_t>(dims[1]);
+  m_Dims[2] = static_cast<int64_t>(dims[2]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceShiftSearch::~SliceShiftSearch()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceShiftSearch::findShifts(int64_t firstSlice, int64_t lastSlice, std::vector<int> &xshifts, std::vector<int> &yshifts) const
+{
+  if (lastSlice <= firstSlice) { return; }
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(static_cast<size_t>(firstSlice), static_cast<size_t>(lastSlice), 1),
+                      SliceShiftSearchImpl(this, &(xshifts.front()), &(yshifts.front())), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SliceShiftSearchImpl serial(this, &(xshifts.front()), &(yshifts.front()));
+    serial.generate(static_cast<size_t>(firstSlice), static_cast<size_t>(lastSlice));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceShiftSearch::findShift(int64_t slice, int &xshift, int &yshift) const
+{
+  std::vector<float> visited(m_Dims[0] * m_Dims[1], 0.0f);
+  xshift = 0;
+  yshift = 0;
+
+  if (m_UseCostTable == true && m_Scorer->costTable(slice, visited) == true)
+  {
+    bestInTable(visited, xshift, yshift);
+    return;
+  }
+
+  for (int level = m_PyramidLevels; level > 0; --level)
+  {
+    climb(slice, 1 << level, visited, xshift, yshift);
+    visited.assign(visited.size(), 0.0f);
+  }
+  climb(slice, 1, visited, xshift, yshift);
+}
+
+// -----------------------------------------------------------------------------
+// Ties go to the shift closest to no shift at all
+// -----------------------------------------------------------------------------
+void SliceShiftSearch::bestInTable(const std::vector<float> &table, int &xshift, int &yshift) const
+{
+  int64_t halfX = m_Dims[0] / 2;
+  int64_t halfY = m_Dims[1] / 2;
+  float mincost = 100000000;
+  xshift = 0;
+  yshift = 0;
+  for (int y = static_cast<int>(1 - halfY); y < halfY; ++y)
+  {
+    for (int x = static_cast<int>(1 - halfX); x < halfX; ++x)
+    {
+      float cost = table[(y + halfY) * m_Dims[0] + (x + halfX)];
+      if (cost < mincost || (cost == mincost && abs(x) + abs(y) < abs(xshift) + abs(yshift)))
+      {
+        xshift = x;
+        yshift = y;
+        mincost = cost;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Shifts that were scored keep their cost in 'visited'. As before a cost of exactly
+// 0 is treated as not scored yet.
+// -----------------------------------------------------------------------------
+void SliceShiftSearch::climb(int64_t slice, int spacing, std::vector<float> &visited, int &xshift, int &yshift) const
+{
+  int64_t halfX = m_Dims[0] / 2;
+  int64_t halfY = m_Dims[1] / 2;
+  int step = 4 * spacing;
+  float mincost = 100000000;
+  int newxshift = xshift;
+  int newyshift = yshift;
+  int oldxshift = newxshift + 1;
+  int oldyshift = newyshift;
+  while (newxshift != oldxshift || newyshift != oldyshift)
+  {
+    oldxshift = newxshift;
+    oldyshift = newyshift;
+    for (int j = -3; j < 4; j++)
+    {
+      for (int k = -3; k < 4; k++)
+      {
+        int x = oldxshift + k * spacing;
+        int y = oldyshift + j * spacing;
+        if (abs(x) >= halfX || abs(y) >= halfY) { continue; }
+        size_t index = static_cast<size_t>((y + halfY) * m_Dims[0] + (x + halfX));
+        if (visited[index] != 0) { continue; }
+        float cost = m_Scorer->cost(slice, x, y, step);
+        visited[index] = cost;
+        if (cost < mincost
+            || (m_PreferSmallShifts == true && cost == mincost && (abs(x) < abs(newxshift) || abs(y) < abs(newyshift))))
+        {
+          newxshift = x;
+          newyshift = y;
+          mincost = cost;
+        }
+      }
+    }
+  }
+  xshift = newxshift;
+  yshift = newyshift;
+}
+
+// -----------------------------------------------------------------------------
+// The reference is only sampled at multiples of 'step', so a shift k = step * t + r
+// only meets the cur **Cells** with an index = r (mod step). For each phase r the
+// cur slice is decimated to those **Cells** and cross correlated with the sampled
+// reference on a grid 'step' times smaller in each direction.
+//
+// With G the good flags, I the in bounds flags of the decimated cur slice and the
+// sums running over the samples q:
+//   count(t)    = sum 1 * I(q + t)
+//   mismatch(t) = sum Gref(q) * (I(q + t) - 2 Gcur(q + t)) + 1 * Gcur(q + t)
+// -----------------------------------------------------------------------------
+void SliceShiftSearch::mismatchTable(const bool* ref, const bool* cur, const int64_t dims[2], int step, std::vector<float> &table)
+{
+  int64_t nx = dims[0];
+  int64_t ny = dims[1];
+  table.assign(nx * ny, 0.0f);
+  int64_t halfX = nx / 2;
+  int64_t halfY = ny / 2;
+  if (halfX < 1 || halfY < 1) { return; }
+
+  int64_t qx = (nx + step - 1) / step;
+  int64_t qy = (ny + step - 1) / step;
+  int64_t tMinX = floorDiv(1 - halfX, step), tMaxX = floorDiv(halfX - 1, step);
+  int64_t tMinY = floorDiv(1 - halfY, step), tMaxY = floorDiv(halfY - 1, step);
+  size_t px = nextPowerOfTwo(qx + std::max(-tMinX, tMaxX) + 1);
+  size_t py = nextPowerOfTwo(qy + std::max(-tMinY, tMaxY) + 1);
+  size_t size = px * py;
+  double scale = 1.0 / static_cast<double>(size);
+  std::vector<ComplexType> wx, wy;
+  twiddles(px, wx);
+  twiddles(py, wy);
+
+  std::vector<ComplexType> work(size);
+  std::vector<ComplexType> onesF(size), refF(size), inF(size), curF(size);
+
+  for (int64_t y = 0; y < qy; ++y)
+  {
+    for (int64_t x = 0; x < qx; ++x)
+    {
+      work[y * px + x] = ComplexType(1.0, ref[(y * step) * nx + x * step] ? 1.0 : 0.0);
+    }
+  }
+  fft2(work, px, py, wx, wy, false);
+  unpack(work, px, py, onesF, refF);
+
+  for (int ry = 0; ry < step; ++ry)
+  {
+    for (int rx = 0; rx < step; ++rx)
+    {
+      work.assign(size, ComplexType(0.0, 0.0));
+      for (int64_t y = 0; y * step + ry < ny; ++y)
+      {
+        for (int64_t x = 0; x * step + rx < nx; ++x)
+        {
+          work[y * px + x] = ComplexType(1.0, cur[(y * step + ry) * nx + x * step + rx] ? 1.0 : 0.0);
+        }
+      }
+      fft2(work, px, py, wx, wy, false);
+      unpack(work, px, py, inF, curF);
+      for (size_t n = 0; n < size; ++n)
+      {
+        ComplexType mismatch = mul(std::conj(refF[n]), inF[n] - 2.0 * curF[n]) + mul(std::conj(onesF[n]), curF[n]);
+        ComplexType count = mul(std::conj(onesF[n]), inF[n]);
+        work[n] = ComplexType(mismatch.real() - count.imag(), mismatch.imag() + count.real());
+      }
+      fft2(work, px, py, wx, wy, true);
+
+      int64_t firstY = ry - step * ((halfY - 1 + ry) / step);
+      int64_t firstX = rx - step * ((halfX - 1 + rx) / step);
+      for (int64_t j = firstY; j < halfY; j += step)
+      {
+        int64_t ty = floorDiv(j, step);
+        size_t row = static_cast<size_t>((ty + static_cast<int64_t>(py)) % static_cast<int64_t>(py)) * px;
+        for (int64_t k = firstX; k < halfX; k += step)
+        {
+          int64_t tx = floorDiv(k, step);
+          ComplexType value = work[row + static_cast<size_t>((tx + static_cast<int64_t>(px)) % static_cast<int64_t>(px))] * scale;
+          float mismatches = static_cast<float>(floor(value.real() + 0.5));
+          float count = static_cast<float>(floor(value.imag() + 0.5));
+          table[(j + halfY) * nx + (k + halfX)] = mismatches / count;
+        }
+      }
+    }
+  }
+}
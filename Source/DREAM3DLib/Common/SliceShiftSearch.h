@@ -0,0 +1,139 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _SliceShiftSearch_H_
+#define _SliceShiftSearch_H_
+
+#include <vector>
+
+#include "MXA/MXA.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
+
+/**
+ * @class SliceShiftScorer SliceShiftSearch.h DREAM3DLib/Common/SliceShiftSearch.h
+ * @brief The cost function of one of the AlignSections filters. A slice is compared
+ * against the slice above it (slice + 1), which is sampled every 'step' **Cells**
+ * along x and y. Lower costs are better.
+ *
+ * The costs of different slices are asked for concurrently, so a scorer may only read
+ * shared data and must keep its scratch space on the stack.
+ */
+class DREAM3DLib_EXPORT SliceShiftScorer
+{
+  public:
+    SliceShiftScorer() {}
+    virtual ~SliceShiftScorer() {}
+
+    /**
+     * @brief Returns the cost of moving 'slice' by (xshift, yshift) relative to slice + 1.
+     */
+    virtual float cost(int64_t slice, int xshift, int yshift, int step) const = 0;
+
+    /**
+     * @brief Fills 'table' with the cost at step 4 of every shift with |xshift| < dims[0]/2
+     * and |yshift| < dims[1]/2, at index (yshift + dims[1]/2) * dims[0] + (xshift + dims[0]/2).
+     * Scorers that can not do better than calling cost() for each shift return false.
+     */
+    virtual bool costTable(int64_t slice, std::vector<float> &table) const { return false; }
+};
+
+/**
+ * @class SliceShiftSearch SliceShiftSearch.h DREAM3DLib/Common/SliceShiftSearch.h
+ * @brief Finds the shift of each slice relative to the slice above it by the hill
+ * climb the AlignSections filters have always used. Every step scores a 7 x 7 window
+ * of shifts around the current best one and moves to the best of them, until the
+ * best shift stays where it is.
+ *
+ * The slice pairs are independent of each other and are searched concurrently.
+ *
+ * With PyramidLevels > 0 the climb first runs on coarser grids. On level L the window
+ * is spaced 2^L **Cells** apart and the slices are sampled 2^L times more sparsely;
+ * each level starts from the result of the one above it. Large misalignments are then
+ * found in a few steps instead of one 3 **Cell** step at a time.
+ *
+ * With UseCostTable the scorer's costTable() is used when it provides one, and the
+ * shift with the lowest cost in the whole table is taken instead of climbing. This
+ * can not get stuck in a local minimum and costs the same however far apart the
+ * slices are. The pyramid is not used in that case.
+ */
+class DREAM3DLib_EXPORT SliceShiftSearch
+{
+  public:
+    SliceShiftSearch(const SliceShiftScorer* scorer, const size_t dims[3]);
+    virtual ~SliceShiftSearch();
+
+    DREAM3D_INSTANCE_PROPERTY(int, PyramidLevels)
+    /* On equal costs move to the shift closer to no shift at all (AlignSectionsMisorientation) */
+    DREAM3D_INSTANCE_PROPERTY(bool, PreferSmallShifts)
+    DREAM3D_INSTANCE_PROPERTY(bool, UseCostTable)
+
+    /**
+     * @brief Finds the shifts of the slices in [firstSlice, lastSlice).
+     * @param xshifts The shift of each slice, indexed by slice. Must hold at least lastSlice values.
+     * @param yshifts The shift of each slice, indexed by slice.
+     */
+    void findShifts(int64_t firstSlice, int64_t lastSlice, std::vector<int> &xshifts, std::vector<int> &yshifts) const;
+
+    /**
+     * @brief Finds the shift of a single slice.
+     */
+    void findShift(int64_t slice, int &xshift, int &yshift) const;
+
+    /**
+     * @brief Builds the cost table of the 'good voxel' alignment for one slice pair: the
+     * fraction of the sampled **Cells** of 'ref' whose flag differs from the shifted
+     * **Cell** of 'cur'. The counts are found with FFT cross correlations, one for each
+     * of the step * step phases of the shift, and are the same as counting directly.
+     * @param ref The upper slice, dims[0] * dims[1] flags
+     * @param cur The slice that is moved
+     * @param table The costs, laid out as for SliceShiftScorer::costTable()
+     */
+    static void mismatchTable(const bool* ref, const bool* cur, const int64_t dims[2], int step, std::vector<float> &table);
+
+  private:
+    const SliceShiftScorer* m_Scorer;
+    int64_t m_Dims[3];
+
+    void climb(int64_t slice, int spacing, std::vector<float> &visited, int &xshift, int &yshift) const;
+    void bestInTable(const std::vector<float> &table, int &xshift, int &yshift) const;
+
+    SliceShiftSearch(const SliceShiftSearch&); // Copy Constructor Not Implemented
+    void operator=(const SliceShiftSearch&); // Operator '=' Not Implemented
+};
+
+#endif /* _SliceShiftSearch_H_ */
@@ -21,6 +21,7 @@ set(DREAM3DLib_Common_HDRS
   ${DREAM3DLib_SOURCE_DIR}/Common/ModifiedLambertProjectionArray.h
   ${DREAM3DLib_SOURCE_DIR}/Common/Observable.h
   ${DREAM3DLib_SOURCE_DIR}/Common/Observer.h
+  ${DREAM3DLib_SOURCE_DIR}/Common/PipelineProfiler.h
   ${DREAM3DLib_SOURCE_DIR}/Common/PhaseType.h
   ${DREAM3DLib_SOURCE_DIR}/Common/PipelineMessage.h
   ${DREAM3DLib_SOURCE_DIR}/Common/ShapeType.h
@@ -30,6 +31,9 @@ set(DREAM3DLib_Common_HDRS
   ${DREAM3DLib_SOURCE_DIR}/Common/ScopedFileMonitor.hpp
   ${DREAM3DLib_SOURCE_DIR}/Common/IDataArrayFilter.h
   ${DREAM3DLib_SOURCE_DIR}/Common/ThresholdFilterHelper.h
+  ${DREAM3DLib_SOURCE_DIR}/Common/CellDilationHelper.h
+  ${DREAM3DLib_SOURCE_DIR}/Common/CentroidGrid.h
+  ${DREAM3DLib_SOURCE_DIR}/Common/SliceShiftSearch.h
   ${DREAM3DLib_SOURCE_DIR}/Common/CreatedArrayHelpIndexEntry.h
 )
 
@@ -41,6 +45,7 @@ set(DREAM3DLib_Common_SRCS
   ${DREAM3DLib_SOURCE_DIR}/Common/ModifiedLambertProjection.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/ModifiedLambertProjectionArray.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/Observer.cpp
+  ${DREAM3DLib_SOURCE_DIR}/Common/PipelineProfiler.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/Observable.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/PhaseType.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/ShapeType.cpp
@@ -49,6 +54,9 @@ set(DREAM3DLib_Common_SRCS
   ${DREAM3DLib_SOURCE_DIR}/Common/TexturePreset.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/IDataArrayFilter.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/ThresholdFilterHelper.cpp
+  ${DREAM3DLib_SOURCE_DIR}/Common/CellDilationHelper.cpp
+  ${DREAM3DLib_SOURCE_DIR}/Common/CentroidGrid.cpp
+  ${DREAM3DLib_SOURCE_DIR}/Common/SliceShiftSearch.cpp
   ${DREAM3DLib_SOURCE_DIR}/Common/CreatedArrayHelpIndexEntry.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "DREAM3DLib/Common" "${DREAM3DLib_Common_HDRS}" "${DREAM3DLib_Common_SRCS}" "0")
@@ -252,7 +252,7 @@ class DREAM3DLib_EXPORT StatsGen
           totaldensity = totaldensity + density;
           if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
         }
-        ops.determineEulerAngles(choose, ea1, ea2, ea3);
+        ops.determineEulerAngles(rg, choose, ea1, ea2, ea3);
         OrientationMath::EulertoQuat(q1, ea1, ea2, ea3);
         ops.getFZQuat(q1);
         random = rg.genrand_res53();
@@ -429,7 +429,7 @@ class DREAM3DLib_EXPORT StatsGen
           totaldensity = totaldensity + density;
           if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
         }
-        ops.determineEulerAngles(choose, ea1, ea2, ea3);
+        ops.determineEulerAngles(rg, choose, ea1, ea2, ea3);
         OrientationMath::EulertoQuat(q1, ea1, ea2, ea3);
         ops.getFZQuat(q1);
         random = rg.genrand_res53();
@@ -565,7 +565,7 @@ class DREAM3DLib_EXPORT StatsGen
             break;
           }
         }
-        ops.determineEulerAngles(choose, ea1, ea2, ea3);
+        ops.determineEulerAngles(rg, choose, ea1, ea2, ea3);
         OrientationMath::EulertoQuat(q1, ea1, ea2, ea3);
         ops.getFZQuat(q1);
         random = rg.genrand_res53();
@@ -742,7 +742,7 @@ class DREAM3DLib_EXPORT StatsGen
           totaldensity = totaldensity + density;
           if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
         }
-        ops.determineEulerAngles(choose, ea1, ea2, ea3);
+        ops.determineEulerAngles(rg, choose, ea1, ea2, ea3);
         OrientationMath::EulertoQuat(q1, ea1, ea2, ea3);
         ops.getFZQuat(q1);
         g[0][0] = (1 - 2 * q1.y * q1.y - 2 * q1.z * q1.z);
@@ -844,7 +844,7 @@ class DREAM3DLib_EXPORT StatsGen
             break;
           }
         }
-        ops.determineRodriguesVector(choose, r1, r2, r3);
+        ops.determineRodriguesVector(rg, choose, r1, r2, r3);
         OrientationMath::RodtoAxisAngle(r1, r2, r3, w, n1, n2, n3);
         w = w * radtodeg;
         yval[int(w / 5.0)]++;
@@ -902,7 +902,7 @@ class DREAM3DLib_EXPORT StatsGen
           totaldensity = totaldensity + density;
           if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
         }
-        ops.determineRodriguesVector(choose, r1, r2, r3);
+        ops.determineRodriguesVector(rg, choose, r1, r2, r3);
         OrientationMath::RodtoAxisAngle(r1, r2, r3, w, n1, n2, n3);
         w = w * radtodeg;
         size_t index = static_cast<size_t>(w / 5.0f);
@@ -502,9 +502,9 @@ class DREAM3DLib_EXPORT Texture
           if(random1 >= d && random1 < totaldensity) choose1 = static_cast<int>(j);
           if(random2 >= d && random2 < totaldensity) choose2 = static_cast<int>(j);
         }
-        orientationOps.determineEulerAngles(choose1, ea11, ea12, ea13);
+        orientationOps.determineEulerAngles(rg, choose1, ea11, ea12, ea13);
         OrientationMath::EulertoQuat(q1, ea11, ea12, ea13);
-        orientationOps.determineEulerAngles(choose2, ea21, ea22, ea23);
+        orientationOps.determineEulerAngles(rg, choose2, ea21, ea22, ea23);
         OrientationMath::EulertoQuat(q2, ea21, ea22, ea23);
         w = orientationOps.getMisoQuat(q1, q2, n1, n2, n3);
         OrientationMath::AxisAngletoRod(w, n1, n2, n3, r1, r2, r3);
@@ -48,6 +48,7 @@
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 #include "DREAM3DLib/Common/IDataArrayFilter.h"
 #include "DREAM3DLib/DataArrays/IDataArray.h"
+#include "DREAM3DLib/DataArrays/MemoryMappedFile.h"
 #include "DREAM3DLib/HDF5/H5DataArrayWriter.hpp"
 #include "DREAM3DLib/HDF5/H5DataArrayReader.h"
 
@@ -206,6 +207,28 @@ class DataArray : public IDataArray
       return ptr;
     }
 
+    /**
+     * @brief Static constructor for an array that is stored in a memory mapped file no matter
+     * how small it is. The array stays mapped when it is resized.
+     * @param numTuples The number of tuples in the array.
+     * @param numComponents The number of Components in each Tuple
+     * @param name The name of the array
+     * @return Boost::Shared_Ptr wrapping an instance of DataArrayTemplate<T>
+     */
+    static Pointer CreateMappedArray(size_t numTuples, int numComponents, const std::string &name)
+    {
+      DataArray<T>* d = new DataArray<T> (numTuples, numComponents, true);
+      d->m_MapRequested = true;
+      if (d->Allocate() < 0)
+      { // Could not allocate enough memory, reset the pointer to null and return
+        delete d;
+        return DataArray<T>::NullPointer();
+      }
+      d->SetName(name);
+      Pointer ptr(d);
+      return ptr;
+    }
+
     /**
      * @brief Static Method to create a DataArray from a std::vector through a deep copy of the data
      * contained in the vector. The number of components will be set to 1.
@@ -298,9 +321,42 @@ class DataArray : public IDataArray
      */
     virtual void releaseOwnership()
     {
+      // Whoever keeps the memory will free() it so it can not stay in a mapped file
+      if (NULL != m_MappedFile)
+      {
+        _moveToHeap();
+      }
       m_OwnsData = false;
     }
 
+    /**
+     * @brief Returns true if the values are stored in a memory mapped file instead of on the heap
+     */
+    virtual bool isMemoryMapped()
+    {
+      return (NULL != m_MappedFile);
+    }
+
+    /**
+     * @brief Copies the values into a memory mapped file or back onto the heap. An array that
+     * is asked to be mapped stays mapped when it is resized, even while it is empty.
+     * @param mapped
+     * @return 1 on success, -1 on failure
+     */
+    virtual int32_t setMemoryMapped(bool mapped)
+    {
+      m_MapRequested = mapped;
+      if (mapped == isMemoryMapped() || m_Size == 0)
+      {
+        return 1;
+      }
+      if (mapped == true)
+      {
+        return _mapToFile(m_Size) ? 1 : -1;
+      }
+      return _moveToHeap() ? 1 : -1;
+    }
+
     /**
      * @brief Allocates the memory needed for this class
      * @return 1 on success, -1 on failure
@@ -322,6 +378,14 @@ class DataArray : public IDataArray
 
 
       size_t newSize = m_Size;
+      if (m_MapRequested == true || MemoryMappedFile::ShouldMap(newSize * sizeof(T)))
+      {
+        if (_mapToFile(newSize) == true)
+        {
+          return 1;
+        }
+        std::cout << "Unable to memory map " << newSize << " elements of size " << sizeof(T) << " bytes. Using the heap instead." << std::endl;
+      }
 #if defined ( AIM_USE_SSE ) && defined ( __SSE2__ )
       Array = static_cast<T*>( _mm_malloc (newSize * sizeof(T), 16) );
 #else
@@ -387,16 +451,14 @@ class DataArray : public IDataArray
      */
     virtual int EraseTuples(std::vector<size_t> &idxs)
     {
-
-      int err = 0;
-
       // If nothing is to be erased just return
       if(idxs.size() == 0)
       {
         return 0;
       }
 
-      if (idxs.size() >= GetNumberOfTuples() )
+      size_t numTuples = GetNumberOfTuples();
+      if (idxs.size() >= numTuples )
       {
         Resize(0);
         return 0;
@@ -404,96 +466,73 @@ class DataArray : public IDataArray
 
       // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
       // off the end of the array and return an error code.
+      std::vector<bool> keep(numTuples, true);
       for(std::vector<size_t>::size_type i = 0; i < idxs.size(); ++i)
       {
-        if (idxs[i] * this->NumberOfComponents > m_MaxId) { return -100; }
+        if (idxs[i] >= numTuples) { return -100; }
+        keep[idxs[i]] = false;
       }
+      return CompactTuples(keep);
+    }
 
-      // Calculate the new size of the array to copy into
-      size_t newSize = (GetNumberOfTuples() - idxs.size()) * NumberOfComponents ;
-
-      // Create a new Array to copy into
-      T* newArray = (T*)malloc(newSize * sizeof(T));
-    if (NULL == newArray)
+    /**
+     * @brief Moves each run of kept tuples down to the end of the previous one and then shrinks
+     * the allocation. The runs only ever move towards the front so this is done in place in one
+     * pass. An array that does not own its memory is compacted into a new array that it owns so
+     * the caller's buffer is left untouched.
+     * @param keep One flag per tuple
+     * @return 0 on success, -100 if 'keep' does not have one flag per tuple, -1000 if the
+     * memory could not be allocated
+     */
+    virtual int CompactTuples(const std::vector<bool> &keep)
     {
-      return -1000;
-    }
-      // Splat AB across the array so we know if we are copying the values or not
-      ::memset(newArray, 0xAB, newSize * sizeof(T));
-
-      // Keep the current Destination Pointer
-      T* currentDest = newArray;
-      size_t j = 0;
-      size_t k = 0;
-      // Find the first chunk to copy by walking the idxs array until we get an
-      // index that is NOT a continuous increment from the start
-      for (k = 0; k < idxs.size(); ++k)
+      size_t numTuples = GetNumberOfTuples();
+      if (keep.size() != numTuples) { return -100; }
+
+      T* dest = m_Array;
+      if (false == m_OwnsData && numTuples > 0)
       {
-        if(j == idxs[k])
+        dest = (T*)malloc(m_Size * sizeof(T));
+        if (NULL == dest)
         {
-          ++j;
+          return -1000;
         }
-        else
-        {
-          break;
-        }
-      }
-
-      if(k == idxs.size()) // Only front elements are being dropped
-      {
-        T* currentSrc = m_Array + (j * NumberOfComponents);
-        ::memcpy(currentDest, currentSrc, (GetNumberOfTuples() - idxs.size()) * NumberOfComponents * sizeof(T));
-        _deallocate(); // We are done copying - delete the current Array
-        m_Size = newSize;
-        m_Array= newArray;
-        m_OwnsData = true;
-        m_MaxId = newSize - 1;
-        return 0;
       }
 
-      std::vector<size_t> srcIdx(idxs.size() + 1);
-      std::vector<size_t> destIdx(idxs.size() + 1);
-      std::vector<size_t> copyElements(idxs.size() + 1);
-      srcIdx[0] = 0;
-      destIdx[0] = 0;
-      copyElements[0] = (idxs[0] - 0) * NumberOfComponents;
-
-      for (size_t i = 1; i < srcIdx.size(); ++i)
+      size_t kept = 0;
+      size_t runStart = 0;
+      while (runStart < numTuples)
       {
-        srcIdx[i] = (idxs[i - 1] + 1) * NumberOfComponents;
-
-        if(i < srcIdx.size() - 1)
-        {
-          copyElements[i] = (idxs[i] - idxs[i - 1] - 1) * NumberOfComponents;
-        }
-        else
+        if (keep[runStart] == false) { ++runStart; continue; }
+        size_t runEnd = runStart + 1;
+        while (runEnd < numTuples && keep[runEnd] == true) { ++runEnd; }
+        if (dest != m_Array || kept != runStart)
         {
-          copyElements[i] = (GetNumberOfTuples() - idxs[i - 1] - 1) * NumberOfComponents;
+          ::memmove(dest + kept * NumberOfComponents, m_Array + runStart * NumberOfComponents, (runEnd - runStart) * NumberOfComponents * sizeof(T));
         }
-        destIdx[i] = copyElements[i - 1] + destIdx[i - 1];
+        kept += runEnd - runStart;
+        runStart = runEnd;
       }
 
-      // Copy the data
-      for (size_t i = 0; i < srcIdx.size(); ++i)
+      if (dest != m_Array)
       {
-        currentDest = newArray + destIdx[i];
-        T* currentSrc = m_Array + srcIdx[i];
-        size_t bytes = copyElements[i] * sizeof(T);
-        ::memcpy(currentDest, currentSrc, bytes);
+        // The old array belongs to someone else so just start using the new one
+        m_Array = dest;
+        m_OwnsData = true;
+        m_IsAllocated = true;
       }
-
-      // We are done copying - delete the current Array
-      _deallocate();
-
-      // Allocation was successful.  Save it.
-      m_Size = newSize;
-      m_Array= newArray;
-      // This object has now allocated its memory and owns it.
-      m_OwnsData = true;
-
-      m_MaxId = newSize - 1;
-
-      return err;
+      if (kept == numTuples) { return 0; }
+      // Shrinking an array we own is a realloc and does not copy on most platforms. A memory mapped
+      // file is not shrunk because a failed remap would lose the values. When either is skipped or
+      // the realloc fails the kept values are already at the front of the larger block, so only
+      // the size changes.
+      size_t newSize = kept * NumberOfComponents;
+      if (NULL != m_MappedFile || RawResize(newSize) == 0)
+      {
+        m_Size = newSize;
+        m_MaxId = (newSize > 0) ? newSize - 1 : 0;
+      }
+      return 0;
     }
 
     /**
@@ -778,6 +817,18 @@ class DataArray : public IDataArray
       return H5DataArrayWriter<T>::writeArray(parentId, GetName(), GetNumberOfTuples(), GetNumberOfComponents(), m_Array, getFullNameOfClass());
     }
 
+    /**
+     *
+     * @param parentId
+     * @param options
+     * @return
+     */
+    virtual int writeH5DataChunked(hid_t parentId, const H5Lite::ChunkedWriteOptions &options)
+    {
+      if (m_Array == NULL) { return -85648; }
+      return H5DataArrayWriter<T>::writeArray(parentId, GetName(), GetNumberOfTuples(), GetNumberOfComponents(), m_Array, getFullNameOfClass(), &options);
+    }
+
     /**
      * @brief writeXdmfAttribute
      * @param out
@@ -840,8 +891,15 @@ class DataArray : public IDataArray
       this->NumberOfComponents = p->GetNumberOfComponents();
       m_Size = p->GetSize();
       m_MaxId = (m_Size == 0) ? 0 : m_Size -1;
-      m_Array= reinterpret_cast<T*>(p->GetVoidPointer(0));
+      DataArray<T>* src = DataArray<T>::SafePointerDownCast(p.get());
+      if (NULL != src && NULL != src->m_MappedFile)
+      {
+        // Take over the mapped file instead of copying it onto the heap
+        m_MappedFile = src->m_MappedFile;
+        src->m_MappedFile = NULL;
+      }
       p->releaseOwnership();
+      m_Array= reinterpret_cast<T*>(p->GetVoidPointer(0));
 
       return err;
     }
@@ -900,7 +958,9 @@ class DataArray : public IDataArray
       m_Array(NULL),
       m_Size(numElements),
       m_OwnsData(ownsData),
-      m_IsAllocated(false)
+      m_IsAllocated(false),
+      m_MappedFile(NULL),
+      m_MapRequested(false)
     {
       NumberOfComponents = 1;
       m_MaxId = (m_Size > 0) ? m_Size - 1: m_Size;
@@ -917,7 +977,9 @@ class DataArray : public IDataArray
     DataArray(size_t numTuples, int numComponents, bool ownsData = true) :
       m_Array(NULL),
       m_OwnsData(ownsData),
-      m_IsAllocated(false)
+      m_IsAllocated(false),
+      m_MappedFile(NULL),
+      m_MapRequested(false)
     {
       NumberOfComponents = numComponents;
       m_Size = numTuples * numComponents;
@@ -953,15 +1015,73 @@ class DataArray : public IDataArray
       }
 #endif
 
+      if (NULL != m_MappedFile)
+      {
+        delete m_MappedFile;
+        m_MappedFile = NULL;
+      }
+      else
+      {
 #if defined ( AIM_USE_SSE ) && defined ( __SSE2__ )
-      _mm_free( this->m_buffer );
+        _mm_free( this->m_buffer );
 #else
-      free(this->m_Array);
+        free(this->m_Array);
 #endif
+      }
       m_Array= NULL;
       m_IsAllocated = false;
     }
 
+    /**
+     * @brief Moves the values into a new memory mapped file of 'newSize' elements. Elements
+     * past the old size are zero.
+     * @return false if the file could not be created, in which case nothing has changed
+     */
+    bool _mapToFile(size_t newSize)
+    {
+      MemoryMappedFile* file = new MemoryMappedFile;
+      T* newArray = static_cast<T*>(file->create(newSize * sizeof(T)));
+      if (NULL == newArray)
+      {
+        delete file;
+        return false;
+      }
+      if (NULL != m_Array)
+      {
+        ::memcpy(newArray, m_Array, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
+        if (true == m_OwnsData)
+        {
+          _deallocate();
+        }
+      }
+      m_MappedFile = file;
+      m_Array = newArray;
+      m_Size = newSize;
+      m_MaxId = newSize - 1;
+      m_OwnsData = true;
+      m_IsAllocated = true;
+      return true;
+    }
+
+    /**
+     * @brief Copies the values of a memory mapped array onto the heap and deletes the file
+     * @return false if the memory could not be allocated, in which case nothing has changed
+     */
+    bool _moveToHeap()
+    {
+      T* newArray = (T*)malloc(m_Size * sizeof(T));
+      if (NULL == newArray)
+      {
+        std::cout << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes. " << std::endl;
+        return false;
+      }
+      ::memcpy(newArray, m_Array, m_Size * sizeof(T));
+      _deallocate();
+      m_Array = newArray;
+      m_IsAllocated = true;
+      return true;
+    }
+
     /**
      * @brief resizes the internal array to be 'size' elements in length
      * @param size
@@ -999,8 +1119,28 @@ class DataArray : public IDataArray
       dontUseRealloc=true;
 #endif
 
+      if (NULL != m_MappedFile)
+      {
+        // The file holds the values so it only has to be resized and mapped again
+        newArray = static_cast<T*>(m_MappedFile->resize(newSize * sizeof(T)));
+        if (!newArray)
+        {
+          std::cout << "Unable to resize the memory mapped file to " << newSize << " elements of size " << sizeof(T) << " bytes. " << std::endl;
+          // The file has been closed and the old mapping is gone
+          m_Array = NULL;
+          delete m_MappedFile;
+          m_MappedFile = NULL;
+          this->initialize();
+          return 0;
+        }
+      }
+      else if ((m_MapRequested == true || (newSize > m_Size && MemoryMappedFile::ShouldMap(newSize * sizeof(T))))
+               && _mapToFile(newSize) == true)
+      {
+        return this->m_Array;
+      }
       // Allocate a new array if we DO NOT own the current array
-      if ((NULL != this->m_Array) && (false == m_OwnsData))
+      else if ((NULL != this->m_Array) && (false == m_OwnsData))
       {
         // The old array is owned by the user so we cannot try to
         // reallocate it.  Just allocate new memory that we will own.
@@ -1066,6 +1206,8 @@ class DataArray : public IDataArray
 
     bool m_IsAllocated;
     //   unsigned long long int MUD_FLAP_3;
+    MemoryMappedFile* m_MappedFile;
+    bool m_MapRequested;
     std::string m_Name;
     //  unsigned long long int MUD_FLAP_5;
 
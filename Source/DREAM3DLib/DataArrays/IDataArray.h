@@ -19,6 +19,8 @@
 
 #include <hdf5.h>
 
+#include "H5Support/H5Lite.h"
+
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 
@@ -146,6 +148,24 @@ class DREAM3DLib_EXPORT IDataArray
      */
     virtual int EraseTuples(std::vector<size_t> &idxs) = 0;
 
+    /**
+     * @brief Keeps the tuples whose entry in 'keep' is true, in their current order, and drops
+     * the rest. Arrays that can do so move the kept tuples down in place and then shrink, so no
+     * second copy of the array is made. The default builds the index list for EraseTuples().
+     * @param keep One flag per tuple
+     * @return 0 on success, -100 if 'keep' does not have one flag per tuple
+     */
+    virtual int CompactTuples(const std::vector<bool> &keep)
+    {
+      if (keep.size() != GetNumberOfTuples()) { return -100; }
+      std::vector<size_t> idxs;
+      for (size_t i = 0; i < keep.size(); ++i)
+      {
+        if (keep[i] == false) { idxs.push_back(i); }
+      }
+      return EraseTuples(idxs);
+    }
+
     /**
      * @brief Copies a Tuple from one position to another.
      * @param currentPos The index of the source data
@@ -194,6 +214,35 @@ class DREAM3DLib_EXPORT IDataArray
     virtual int writeH5Data(hid_t parentId) = 0;
     virtual int readH5Data(hid_t parentId) = 0;
 
+    /**
+     * @brief Returns true if the values are stored in a memory mapped file instead of on the heap
+     */
+    virtual bool isMemoryMapped() { return false; }
+
+    /**
+     * @brief Moves the values into a memory mapped file or back onto the heap. Arrays that
+     * can not be memory mapped return -1 when asked to be.
+     * @param mapped
+     * @return 1 on success, -1 on failure
+     */
+    virtual int32_t setMemoryMapped(bool mapped)
+    {
+      return (mapped == true) ? -1 : 1;
+    }
+
+    /**
+     * @brief Writes the data using a chunked, optionally compressed, dataset
+     * layout. Arrays that do not support chunking write their normal layout.
+     * @param parentId
+     * @param options The chunk shape, filter and chunk cache settings
+     * @return
+     */
+    virtual int writeH5DataChunked(hid_t parentId, const H5Lite::ChunkedWriteOptions &options)
+    {
+      (void)(options);
+      return writeH5Data(parentId);
+    }
+
     virtual int writeXdmfAttribute(std::ostream &out, int64_t* volDims, const std::string &hdfFileName, const std::string &groupPath, const std::string &label) = 0;
 //    {
 //      std::cout << "IDataArray::writeXdmfAttribute needs to be implemented for the data being written." << std::endl;
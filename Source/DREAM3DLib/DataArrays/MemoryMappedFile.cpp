@@ -0,0 +1,292 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MemoryMappedFile.h"
+
+#include <stdlib.h>
+
+#include <vector>
+
+#if defined (_WIN32)
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "MXA/Utilities/MXADir.h"
+
+namespace Detail
+{
+  static uint64_t MappingThresholdFromEnvironment()
+  {
+    const char* megaBytes = getenv("DREAM3D_MAPPED_ARRAY_THRESHOLD_MB");
+    if (NULL == megaBytes) { return 0; }
+    return static_cast<uint64_t>(atof(megaBytes) * 1048576.0);
+  }
+
+  // Initialized while the library is loaded, before any filter can start threads that
+  // allocate arrays, so reading it later needs no lock
+  static uint64_t MappingThreshold = MappingThresholdFromEnvironment();
+  static std::string TemporaryDirectory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile() :
+  m_Pointer(NULL),
+  m_Size(0),
+#if defined (_WIN32)
+  m_File(INVALID_HANDLE_VALUE),
+  m_Mapping(NULL)
+#else
+  m_FileDescriptor(-1)
+#endif
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MemoryMappedFile::create(size_t bytes)
+{
+  close();
+  if (bytes == 0)
+  {
+    return NULL;
+  }
+  std::string dir = GetTemporaryDirectory();
+#if defined (_WIN32)
+  char name[MAX_PATH];
+  if (GetTempFileNameA(dir.c_str(), "D3D", 0, name) == 0)
+  {
+    return NULL;
+  }
+  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    DeleteFileA(name);
+    return NULL;
+  }
+  // Without the sparse flag NTFS writes out zeros for the whole length of the file
+  DWORD returned = 0;
+  DeviceIoControl(file, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &returned, NULL);
+  m_File = file;
+#else
+  if (dir.empty() == true || dir[dir.size() - 1] != '/')
+  {
+    dir.push_back('/');
+  }
+  dir.append("DREAM3D_XXXXXX");
+  std::vector<char> name(dir.begin(), dir.end());
+  name.push_back('\0');
+  int fd = mkstemp(&(name.front()));
+  if (fd < 0)
+  {
+    return NULL;
+  }
+  // The open descriptor keeps the file alive, removing the name now means the space is given
+  // back even if the program never gets to close it.
+  unlink(&(name.front()));
+  m_FileDescriptor = fd;
+#endif
+  if (map(bytes) == false)
+  {
+    close();
+    return NULL;
+  }
+  return m_Pointer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MemoryMappedFile::resize(size_t bytes)
+{
+  if (NULL == m_Pointer)
+  {
+    return create(bytes);
+  }
+  if (bytes == m_Size)
+  {
+    return m_Pointer;
+  }
+  unmap();
+  if (bytes == 0 || map(bytes) == false)
+  {
+    close();
+    return NULL;
+  }
+  return m_Pointer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close()
+{
+  unmap();
+#if defined (_WIN32)
+  if (m_File != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(m_File);
+    m_File = INVALID_HANDLE_VALUE;
+  }
+#else
+  if (m_FileDescriptor >= 0)
+  {
+    ::close(m_FileDescriptor);
+    m_FileDescriptor = -1;
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Sets the length of the file and maps all of it
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::map(size_t bytes)
+{
+#if defined (_WIN32)
+  LARGE_INTEGER size;
+  size.QuadPart = static_cast<LONGLONG>(bytes);
+  if (SetFilePointerEx(m_File, size, NULL, FILE_BEGIN) == 0 || SetEndOfFile(m_File) == 0)
+  {
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(m_File, NULL, PAGE_READWRITE, size.HighPart, size.LowPart, NULL);
+  if (NULL == mapping)
+  {
+    return false;
+  }
+  void* ptr = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+  if (NULL == ptr)
+  {
+    CloseHandle(mapping);
+    return false;
+  }
+  m_Mapping = mapping;
+#else
+  if (ftruncate(m_FileDescriptor, static_cast<off_t>(bytes)) != 0)
+  {
+    return false;
+  }
+  void* ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+  if (MAP_FAILED == ptr)
+  {
+    return false;
+  }
+#endif
+  m_Pointer = ptr;
+  m_Size = bytes;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmap()
+{
+  if (NULL == m_Pointer)
+  {
+    return;
+  }
+#if defined (_WIN32)
+  UnmapViewOfFile(m_Pointer);
+  CloseHandle(m_Mapping);
+  m_Mapping = NULL;
+#else
+  munmap(m_Pointer, m_Size);
+#endif
+  m_Pointer = NULL;
+  m_Size = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::SetMappingThreshold(uint64_t bytes)
+{
+  Detail::MappingThreshold = bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t MemoryMappedFile::GetMappingThreshold()
+{
+  return Detail::MappingThreshold;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::ShouldMap(uint64_t bytes)
+{
+  uint64_t threshold = GetMappingThreshold();
+  return (threshold > 0 && bytes >= threshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::SetTemporaryDirectory(const std::string &path)
+{
+  Detail::TemporaryDirectory = path;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string MemoryMappedFile::GetTemporaryDirectory()
+{
+  if (Detail::TemporaryDirectory.empty() == true)
+  {
+    return MXADir::tempPath();
+  }
+  return Detail::TemporaryDirectory;
+}
@@ -0,0 +1,125 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _MEMORYMAPPEDFILE_H_
+#define _MEMORYMAPPEDFILE_H_
+
+#include <string>
+
+#include "MXA/MXA.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+
+/**
+ * @class MemoryMappedFile MemoryMappedFile.h DREAM3DLib/DataArrays/MemoryMappedFile.h
+ * @brief Backs a block of memory with a temporary file mapped into the address space, so the
+ * operating system pages it to and from the file instead of the swap file. The file is sparse,
+ * so blocks that are never written use no disk space, and it is deleted as soon as it is
+ * created (or marked delete-on-close on Windows) so nothing is left behind if the program dies.
+ *
+ * DataArray uses this for arrays of at least GetMappingThreshold() bytes and for arrays that
+ * were asked to be memory mapped. Setting the DREAM3D_MAPPED_ARRAY_THRESHOLD_MB environment
+ * variable sets the initial threshold.
+ * @version 1.0
+ */
+class DREAM3DLib_EXPORT MemoryMappedFile
+{
+  public:
+    MemoryMappedFile();
+    virtual ~MemoryMappedFile();
+
+    /**
+     * @brief Creates a zero filled temporary file of 'bytes' bytes in the temporary directory
+     * and maps it, closing any file this object already had open.
+     * @return The mapped memory or NULL if the file could not be created or mapped
+     */
+    void* create(size_t bytes);
+
+    /**
+     * @brief Grows or shrinks the file and maps it again. The contents up to the smaller of
+     * the two sizes are kept and new bytes are zero. The memory may move.
+     * @return The mapped memory or NULL if the file could not be resized, in which case the
+     * file is closed.
+     */
+    void* resize(size_t bytes);
+
+    /**
+     * @brief Unmaps and deletes the file.
+     */
+    void close();
+
+    void* getPointer() { return m_Pointer; }
+    size_t getSize() { return m_Size; }
+
+    /**
+     * @brief Arrays of at least this many bytes are memory mapped. 0 turns the automatic
+     * mapping off, which is the default unless DREAM3D_MAPPED_ARRAY_THRESHOLD_MB is set.
+     * Arrays are allocated from many threads without a lock, so only call this at startup
+     * before any filter runs.
+     */
+    static void SetMappingThreshold(uint64_t bytes);
+    static uint64_t GetMappingThreshold();
+
+    /**
+     * @brief Returns true if an array of 'bytes' bytes should be memory mapped
+     */
+    static bool ShouldMap(uint64_t bytes);
+
+    /**
+     * @brief The directory the files are created in. Defaults to the system temporary directory.
+     * Like the threshold this should only be set at startup.
+     */
+    static void SetTemporaryDirectory(const std::string &path);
+    static std::string GetTemporaryDirectory();
+
+  private:
+    void* m_Pointer;
+    size_t m_Size;
+#if defined (_WIN32)
+    void* m_File;
+    void* m_Mapping;
+#else
+    int m_FileDescriptor;
+#endif
+
+    bool map(size_t bytes);
+    void unmap();
+
+    MemoryMappedFile(const MemoryMappedFile&); // Copy Constructor Not Implemented
+    void operator=(const MemoryMappedFile&); // Operator '=' Not Implemented
+};
+
+#endif /* _MEMORYMAPPEDFILE_H_ */
@@ -55,6 +55,15 @@
 /**
  * @class NeighborList NeighborList.hpp DREAM3DLib/Common/NeighborList.hpp
  * @brief Template class for wrapping raw arrays of data.
+ *
+ * The lists are either stored as one vector per list or, in the compact mode, as a single
+ * array of values plus an array of offsets where list 'i' runs from offsets[i] to
+ * offsets[i+1] (compressed sparse row). The compact mode is used by the filters that build
+ * all of the lists at once and by readH5Data() since that is also the layout in the file.
+ * The const methods getListSize(), getListPointer(), getValue() and copyOfList() work directly
+ * on the compact storage and never change it, so any number of threads may call them at once.
+ * Any method that hands out or modifies a vector converts the lists to vectors first. Code that
+ * uses those methods from several threads must call convertToVectors() before the threads start.
  * @author mjackson
  * @date July 3, 2008
  * @version 1.0
@@ -140,14 +149,14 @@ class NeighborList : public IDataArray
      */
     virtual int EraseTuples(std::vector<size_t>& idxs)
     {
-      int err = 0;
       // If nothing is to be erased just return
       if(idxs.size() == 0)
       {
         return 0;
       }
 
-      if (idxs.size() >= GetNumberOfTuples() )
+      size_t numTuples = GetNumberOfTuples();
+      if (idxs.size() >= numTuples )
       {
         Resize(0);
         return 0;
@@ -155,34 +164,60 @@ class NeighborList : public IDataArray
 
       // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
       // off the end of the array and return an error code.
+      std::vector<bool> keep(numTuples, true);
       for(std::vector<size_t>::size_type i = 0; i < idxs.size(); ++i)
       {
-        if (idxs[i] >= _data.size()) { return -100; }
+        if (idxs[i] >= numTuples) { return -100; }
+        keep[idxs[i]] = false;
       }
+      return CompactTuples(keep);
+    }
 
+    /**
+     * @brief Drops the lists whose flag in 'keep' is false. Compact lists are compacted in place
+     * in the values and offsets arrays, otherwise the kept shared pointers are moved down.
+     * @param keep One flag per list
+     * @return 0 on success, -100 if 'keep' does not have one flag per list
+     */
+    virtual int CompactTuples(const std::vector<bool>& keep)
+    {
+      size_t numTuples = GetNumberOfTuples();
+      if (keep.size() != numTuples) { return -100; }
 
-      std::vector<SharedVectorType> replacement(_data.size() - idxs.size());
-      size_t idxsIndex = 0;
-      size_t rIdx = 0;
-      for(size_t dIdx = 0; dIdx < _data.size(); ++dIdx)
+      size_t kept = 0;
+      if (m_Compact == true)
       {
-        if (dIdx != idxs[idxsIndex])
-        {
-          replacement[rIdx] = _data[dIdx];
-          ++rIdx;
-        }
-        else
+        size_t numValues = 0;
+        for(size_t i = 0; i < numTuples; ++i)
         {
-          ++idxsIndex;
-          if (idxsIndex == idxs.size() ) { idxsIndex--;}
+          if (keep[i] == false) { continue; }
+          // Only m_Offsets[1] to m_Offsets[kept] have been rewritten and kept <= i, so both ends
+          // of list 'i' still hold their original values
+          for(size_t v = m_Offsets[i]; v < m_Offsets[i + 1]; ++v)
+          {
+            m_Values[numValues++] = m_Values[v];
+          }
+          ++kept;
+          m_Offsets[kept] = numValues;
         }
+        m_Offsets.resize(kept + 1);
+        m_Values.resize(numValues);
+        return 0;
       }
-      _data = replacement;
-      return err;
+
+      for(size_t i = 0; i < numTuples; ++i)
+      {
+        if (keep[i] == false) { continue; }
+        if (kept != i) { _data[kept].swap(_data[i]); }
+        ++kept;
+      }
+      _data.resize(kept);
+      return 0;
     }
 
     virtual int CopyTuple(size_t currentPos, size_t newPos)
     {
+      convertToVectors();
       _data[newPos] = _data[currentPos];
       return 0;
     }
@@ -199,7 +234,11 @@ class NeighborList : public IDataArray
 
 
 
-    size_t GetNumberOfTuples() {   return _data.size(); }
+    size_t GetNumberOfTuples()
+    {
+      if (m_Compact == true) { return m_Offsets.empty() ? 0 : m_Offsets.size() - 1; }
+      return _data.size();
+    }
 
     /**
      * @brief GetSize Returns the total number of data items that are being stored. This is the sum of all the sizes
@@ -208,6 +247,7 @@ class NeighborList : public IDataArray
      */
     size_t GetSize()
     {
+      if (m_Compact == true) { return m_Values.size(); }
       size_t total = 0;
       for(size_t dIdx = 0; dIdx < _data.size(); ++dIdx)
       {
@@ -223,10 +263,10 @@ class NeighborList : public IDataArray
     int GetNumberOfComponents() { return 1; }
 
 
-    size_t GetTypeSize()  { return sizeof(SharedVectorType); }
+    size_t GetTypeSize()  { return sizeof(T); }
 
 
-    void initializeWithZeros() { _data.clear(); }
+    void initializeWithZeros() { clearAllLists(); }
 
     /**
      * @brief deepCopy
@@ -235,6 +275,13 @@ class NeighborList : public IDataArray
     IDataArray::Pointer deepCopy()
     {
       typename NeighborList<T>::Pointer daCopyPtr = NeighborList<T>::New();
+      if (m_Compact == true)
+      {
+        std::vector<size_t> offsets(m_Offsets);
+        std::vector<T> values(m_Values);
+        daCopyPtr->setCompactLists(offsets, values);
+        return daCopyPtr;
+      }
       daCopyPtr->Resize(GetNumberOfTuples());
 
       //NeighborList<T>* daCopy = NeighborList<T>::SafeObjectDownCast<IDataArray*, NeighborList<T>*>(daCopyPtr.get());
@@ -250,6 +297,7 @@ class NeighborList : public IDataArray
 
     int32_t RawResize(size_t size)
     {
+      convertToVectors();
       size_t old = _data.size();
       _data.resize(size);
       // Initialize with zero length Vectors
@@ -270,6 +318,15 @@ class NeighborList : public IDataArray
     //FIXME: These need to be implemented
     virtual void printTuple(std::ostream& out, size_t i, char delimiter = ',')
     {
+      if (m_Compact == true)
+      {
+        out << (m_Offsets[i + 1] - m_Offsets[i]);
+        for(size_t v = m_Offsets[i]; v < m_Offsets[i + 1]; v++)
+        {
+          out << delimiter << m_Values[v];
+        }
+        return;
+      }
       SharedVectorType sharedVec = _data[i];
       VectorType* vec = sharedVec.get();
       size_t size = vec->size();
@@ -299,12 +356,13 @@ class NeighborList : public IDataArray
       // can compare this with what is written in the file. If they are
       // different we are going to overwrite what is in the file with what
       // we compute here.
-      std::vector<int32_t> numNeighbors(_data.size());
+      size_t numLists = GetNumberOfTuples();
+      std::vector<int32_t> numNeighbors(numLists);
       size_t total = 0;
-      for(size_t dIdx = 0; dIdx < _data.size(); ++dIdx)
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
       {
-        numNeighbors[dIdx] = static_cast<int32_t>(_data[dIdx]->size());
-        total += _data[dIdx]->size();
+        numNeighbors[dIdx] = static_cast<int32_t>(getListSize(static_cast<int>(dIdx)));
+        total += numNeighbors[dIdx];
       }
 
       // Check to see if the NumNeighbors is already written to the file
@@ -333,7 +391,7 @@ class NeighborList : public IDataArray
       {
         // The NumNeighbors array is in the dream3d file so read it up into memory and compare with what
         // we have in memory.
-        std::vector<int32_t> fileNumNeigh(_data.size());
+        std::vector<int32_t> fileNumNeigh(numLists);
         err = H5Lite::readVectorDataset(parentId, m_NumNeighborsArrayName, fileNumNeigh);
         if (err < 0)
         {
@@ -380,19 +438,29 @@ class NeighborList : public IDataArray
 
       // Allocate an array of the proper size to we can concatenate all the arrays together into a single array that
       // can be written to the HDF5 File. This operation can ballon the memory size temporarily until this operation
-      // is complete.
-      std::vector<T> flat (total);
-      size_t currentStart = 0;
-      for(size_t dIdx = 0; dIdx < _data.size(); ++dIdx)
+      // is complete. The compact lists are already stored that way and are written as they are.
+      std::vector<T> flat;
+      T* flatPtr = NULL;
+      if (m_Compact == true)
       {
-        size_t nEle = _data[dIdx]->size();
-        if (nEle == 0) { continue; }
-        T* start = &(_data[dIdx]->front()); // Get the pointer to the front of the array
-        //    T* end = start + nEle; // Get the pointer to the end of the array
-        T* dst = &(flat.front()) + currentStart;
-        ::memcpy(dst, start, nEle * sizeof(T));
-
-        currentStart += _data[dIdx]->size();
+        if (total > 0) { flatPtr = &(m_Values.front()); }
+      }
+      else
+      {
+        flat.resize(total);
+        size_t currentStart = 0;
+        for(size_t dIdx = 0; dIdx < _data.size(); ++dIdx)
+        {
+          size_t nEle = _data[dIdx]->size();
+          if (nEle == 0) { continue; }
+          T* start = &(_data[dIdx]->front()); // Get the pointer to the front of the array
+          //    T* end = start + nEle; // Get the pointer to the end of the array
+          T* dst = &(flat.front()) + currentStart;
+          ::memcpy(dst, start, nEle * sizeof(T));
+
+          currentStart += _data[dIdx]->size();
+        }
+        if (total > 0) { flatPtr = &(flat.front()); }
       }
 
       // Now we can actually write the actual array data.
@@ -400,7 +468,7 @@ class NeighborList : public IDataArray
       hsize_t dims[1] = { total };
       if (total > 0)
       {
-        err = H5Lite::writePointerDataset(parentId, GetName(), rank, dims, &(flat.front()));
+        err = H5Lite::writePointerDataset(parentId, GetName(), rank, dims, flatPtr);
         if(err < 0)
         {
           return -605;
@@ -495,28 +563,18 @@ class NeighborList : public IDataArray
         return err;
       }
 
-      // Loop over all the entries and make new Vectors to hold the incoming data
-      _data.resize(numNeighbors.size());
-      size_t currentStart = 0;
+      // The file already stores the lists back to back so they are kept in the compact layout
+      std::vector<size_t> offsets(numNeighbors.size() + 1, 0);
       for(std::vector<int32_t>::size_type dIdx = 0; dIdx < numNeighbors.size(); ++dIdx)
       {
-        size_t nEle = numNeighbors[dIdx];
-        if(nEle > 0)
-        {
-          _data[dIdx] = SharedVectorType(new VectorType(numNeighbors[dIdx]));
-
-          T* dst = &(_data[dIdx]->front()); // Get the pointer to the front of the array
-          //    T* end = start + nEle; // Get the pointer to the end of the array
-          T* start = &(flat.front()) + currentStart;
-          ::memcpy(dst, start, nEle * sizeof(T));
-          currentStart += nEle;
-        }
-        else
-        {
-          _data[dIdx] = SharedVectorType(new VectorType(0));
-        }
+        offsets[dIdx + 1] = offsets[dIdx] + numNeighbors[dIdx];
       }
-
+      if (offsets.back() > flat.size())
+      {
+        return -704;
+      }
+      flat.resize(offsets.back());
+      setCompactLists(offsets, flat);
 
       return err;
     }
@@ -526,6 +584,7 @@ class NeighborList : public IDataArray
     */
     void addEntry(int grainId, int value)
     {
+      convertToVectors();
       if(grainId >= static_cast<int>(_data.size()) )
       {
         size_t old = _data.size();
@@ -545,6 +604,34 @@ class NeighborList : public IDataArray
     void clearAllLists()
     {
       _data.clear();
+      m_Offsets.clear();
+      m_Values.clear();
+      m_Compact = false;
+    }
+
+    /**
+     * @brief Replaces all of the lists with the compact layout. The contents of 'offsets' and
+     * 'values' are swapped into this object so both vectors are left empty.
+     * @param offsets numLists + 1 entries, list 'i' is values[offsets[i]] up to values[offsets[i+1]]
+     * @param values The lists stored back to back
+     */
+    void setCompactLists(std::vector<size_t>& offsets, std::vector<T>& values)
+    {
+      _data.clear();
+      m_Offsets.clear();
+      m_Values.clear();
+      m_Offsets.swap(offsets);
+      m_Values.swap(values);
+      m_Compact = true;
+    }
+
+    /**
+     * @brief isCompact
+     * @return true if the lists are stored in the compact layout
+     */
+    bool isCompact() const
+    {
+      return m_Compact;
     }
 
 
@@ -553,6 +640,7 @@ class NeighborList : public IDataArray
      */
     void setList(int grainId, SharedVectorType neighborList)
     {
+      convertToVectors();
       if(grainId >= static_cast<int>(_data.size()) )
       {
         size_t old = _data.size();
@@ -569,12 +657,21 @@ class NeighborList : public IDataArray
     /**
      *
      */
-    T getValue(int grainId, int index, bool& ok)
+    T getValue(int grainId, int index, bool& ok) const
     {
+      if (m_Compact == true)
+      {
+        if(index < 0 || static_cast<size_t>(index) >= m_Offsets[grainId + 1] - m_Offsets[grainId])
+        {
+          ok = false;
+          return -1;
+        }
+        return m_Values[m_Offsets[grainId] + index];
+      }
 #ifndef NDEBUG
       if (_data.size() > 0u) { BOOST_ASSERT(grainId < static_cast<int>(_data.size()));}
 #endif
-      SharedVectorType vec = _data[grainId];
+      const SharedVectorType& vec = _data[grainId];
       if(index < 0 || static_cast<size_t>(index) >= vec->size())
       {
         ok = false;
@@ -589,7 +686,7 @@ class NeighborList : public IDataArray
      */
     int getNumberOfLists()
     {
-      return static_cast<int>(_data.size());
+      return static_cast<int>(GetNumberOfTuples());
     }
 
     /**
@@ -597,14 +694,43 @@ class NeighborList : public IDataArray
      * @param grainId
      * @return
      */
-    int getListSize(int grainId)
+    int getListSize(int grainId) const
     {
+      if (m_Compact == true) { return static_cast<int>(m_Offsets[grainId + 1] - m_Offsets[grainId]); }
 #ifndef NDEBUG
       if (_data.size() > 0u) { BOOST_ASSERT(grainId < static_cast<int>(_data.size()));}
 #endif
       return static_cast<int>(_data[grainId]->size());
     }
 
+    /**
+     * @brief getListPointer Returns a pointer to the first value of a list without
+     * converting the compact lists to vectors.
+     * @param grainId
+     * @return NULL if the list is empty
+     */
+    const T* getListPointer(int grainId) const
+    {
+      if (m_Compact == true)
+      {
+        if (m_Offsets[grainId + 1] == m_Offsets[grainId]) { return NULL; }
+        return &(m_Values[m_Offsets[grainId]]);
+      }
+      if (_data[grainId]->empty() == true) { return NULL; }
+      return &(_data[grainId]->front());
+    }
+
+    /**
+     * @brief getListPointer Returns a pointer to the first value of a list that the values
+     * can be changed through, without converting the compact lists to vectors.
+     * @param grainId
+     * @return NULL if the list is empty
+     */
+    T* getListPointer(int grainId)
+    {
+      return const_cast<T*>(static_cast<const NeighborList<T>*>(this)->getListPointer(grainId));
+    }
+
 
     /**
      * @brief getList
@@ -613,6 +739,7 @@ class NeighborList : public IDataArray
      */
     SharedVectorType getList(int grainId)
     {
+      convertToVectors();
 #ifndef NDEBUG
       if (_data.size() > 0u) { BOOST_ASSERT(grainId < static_cast<int>(_data.size()));}
 #endif
@@ -624,8 +751,12 @@ class NeighborList : public IDataArray
      * @param grainId
      * @return
      */
-    VectorType copyOfList(int grainId)
+    VectorType copyOfList(int grainId) const
     {
+      if (m_Compact == true)
+      {
+        return VectorType(m_Values.begin() + m_Offsets[grainId], m_Values.begin() + m_Offsets[grainId + 1]);
+      }
 #ifndef NDEBUG
       if (_data.size() > 0u) { BOOST_ASSERT(grainId < static_cast<int>(_data.size()));}
 #endif
@@ -634,6 +765,25 @@ class NeighborList : public IDataArray
       return copy;
     }
 
+    /**
+     * @brief Moves the compact lists into one vector per list. The methods that hand out or
+     * modify a vector do this on demand, so it only has to be called directly before handing
+     * a compact list to several threads that use those methods.
+     */
+    void convertToVectors()
+    {
+      if (m_Compact == false) { return; }
+      size_t numLists = GetNumberOfTuples();
+      _data.resize(numLists);
+      for (size_t i = 0; i < numLists; ++i)
+      {
+        _data[i] = SharedVectorType(new VectorType(m_Values.begin() + m_Offsets[i], m_Values.begin() + m_Offsets[i + 1]));
+      }
+      std::vector<size_t>().swap(m_Offsets);
+      std::vector<T>().swap(m_Values);
+      m_Compact = false;
+    }
+
     /**
      * @brief operator []
      * @param grainId
@@ -641,6 +791,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](int grainId)
     {
+      convertToVectors();
 #ifndef NDEBUG
       if (_data.size() > 0u) { BOOST_ASSERT(grainId < static_cast<int>(_data.size()));}
 #endif
@@ -654,6 +805,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](size_t grainId)
     {
+      convertToVectors();
 #ifndef NDEBUG
       if (_data.size() > 0ul) { BOOST_ASSERT(grainId < _data.size());}
 #endif
@@ -667,13 +819,18 @@ class NeighborList : public IDataArray
      * @brief NeighborList
      */
     NeighborList() :
-      m_Name("NeighborList")  {    }
+      m_Name("NeighborList"),
+      m_Compact(false)  {    }
 
   private:
     std::string m_Name;
 
     std::vector<SharedVectorType> _data;
 
+    bool m_Compact;
+    std::vector<size_t> m_Offsets;
+    std::vector<T> m_Values;
+
     NeighborList(const NeighborList&); // Copy Constructor Not Implemented
     void operator=(const NeighborList&); // Operator '=' Not Implemented
 };
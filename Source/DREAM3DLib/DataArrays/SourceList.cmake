@@ -13,6 +13,7 @@ set(DREAM3DLib_DataArrays_HDRS
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/DataArray.hpp
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/IDataArray.h
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/ManagedArrayOfArrays.hpp
+  ${DREAM3DLib_SOURCE_DIR}/DataArrays/MemoryMappedFile.h
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/StatsDataArray.h
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/StringDataArray.hpp
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/StructArray.hpp
@@ -20,6 +21,7 @@ set(DREAM3DLib_DataArrays_HDRS
 
 set(DREAM3DLib_DataArrays_SRCS
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/IDataArray.cpp
+  ${DREAM3DLib_SOURCE_DIR}/DataArrays/MemoryMappedFile.cpp
   ${DREAM3DLib_SOURCE_DIR}/DataArrays/StatsDataArray.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "DREAM3DLib/DataArrays" "${DREAM3DLib_DataArrays_HDRS}" "${DREAM3DLib_DataArrays_SRCS}" "0")
@@ -41,6 +41,7 @@
 // C++ Includes
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 // EbsdLib Includes
 #include "EbsdLib/EbsdConstants.h"
@@ -50,6 +51,62 @@
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
 #include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace Detail
+{
+  /**
+   * @brief Sorts arrays by the number of bytes they hold, largest first
+   */
+  class LargerArray
+  {
+    public:
+      bool operator()(const IDataArray::Pointer &a, const IDataArray::Pointer &b) const
+      {
+        return a->GetSize() * a->GetTypeSize() > b->GetSize() * b->GetTypeSize();
+      }
+  };
+}
+
+/**
+ * @brief Compacts a set of arrays with the same keep flags. The arrays are independent of
+ * each other so each one can be compacted by a different thread.
+ */
+class CompactTuplesImpl
+{
+  public:
+    CompactTuplesImpl(IDataArray::Pointer* arrays, const std::vector<bool>* keep, int* errors) :
+      m_Arrays(arrays),
+      m_Keep(keep),
+      m_Errors(errors)
+    {}
+    virtual ~CompactTuplesImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        m_Errors[i] = m_Arrays[i]->CompactTuples(*m_Keep);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    IDataArray::Pointer* m_Arrays;
+    const std::vector<bool>* m_Keep;
+    int* m_Errors;
+};
+
 
 // -----------------------------------------------------------------------------
 //
@@ -60,7 +117,8 @@ m_NumEdgeTuples(0),
 m_NumFaceTuples(0),
 m_NumCellTuples(0),
 m_NumFieldTuples(0),
-m_NumEnsembleTuples(0)
+m_NumEnsembleTuples(0),
+m_MemoryBudget(0)
 {
   m_Dimensions[0] = 0; m_Dimensions[1] = 0; m_Dimensions[2] = 0;
   m_Resolution[0] = 1.0f; m_Resolution[1] = 1.0f; m_Resolution[2] = 1.0f;
@@ -100,6 +158,7 @@ void VoxelDataContainer::addVertexData(const std::string &name, IDataArray::Poin
   }
   m_VertexData[name] = data;
   m_NumVertexTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 // -----------------------------------------------------------------------------
@@ -193,6 +252,7 @@ void VoxelDataContainer::addEdgeData(const std::string &name, IDataArray::Pointe
   }
   m_EdgeData[name] = data;
   m_NumEdgeTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 // -----------------------------------------------------------------------------
@@ -286,6 +346,7 @@ void VoxelDataContainer::addFaceData(const std::string &name, IDataArray::Pointe
   }
   m_FaceData[name] = data;
   m_NumFaceTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 // -----------------------------------------------------------------------------
@@ -379,6 +440,7 @@ void VoxelDataContainer::addCellData(const std::string &name, IDataArray::Pointe
   }
   m_CellData[name] = data;
   m_NumCellTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 // -----------------------------------------------------------------------------
@@ -488,6 +550,7 @@ void VoxelDataContainer::addFieldData(const std::string &name, IDataArray::Point
   }
   m_FieldData[name] = data;
   m_NumFieldTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 // -----------------------------------------------------------------------------
@@ -568,6 +631,134 @@ void VoxelDataContainer::resizeFieldDataArrays(size_t size)
   m_NumFieldTuples = size;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VoxelDataContainer::setMemoryBudget(uint64_t bytes)
+{
+  m_MemoryBudget = bytes;
+  applyMemoryBudget();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t VoxelDataContainer::getMemoryBudget()
+{
+  return m_MemoryBudget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t VoxelDataContainer::applyMemoryBudget()
+{
+  std::vector<IDataArray::Pointer> heapArrays;
+  uint64_t heapBytes = getHeapBytes(&heapArrays);
+  if (m_MemoryBudget == 0 || heapBytes <= m_MemoryBudget)
+  {
+    return heapBytes;
+  }
+
+  // Moving the largest arrays first keeps the small, often used ones on the heap
+  std::sort(heapArrays.begin(), heapArrays.end(), Detail::LargerArray());
+  for(size_t i = 0; i < heapArrays.size() && heapBytes > m_MemoryBudget; ++i)
+  {
+    uint64_t bytes = heapArrays[i]->GetSize() * heapArrays[i]->GetTypeSize();
+    if (bytes > 0 && heapArrays[i]->setMemoryMapped(true) > 0)
+    {
+      heapBytes -= bytes;
+    }
+  }
+  return heapBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t VoxelDataContainer::getHeapBytes(std::vector<IDataArray::Pointer>* heapArrays)
+{
+  std::map<std::string, IDataArray::Pointer>* groups[6] = { &m_VertexData, &m_EdgeData, &m_FaceData, &m_CellData, &m_FieldData, &m_EnsembleData };
+  uint64_t heapBytes = 0;
+  for(int g = 0; g < 6; ++g)
+  {
+    for(std::map<std::string, IDataArray::Pointer>::iterator iter = groups[g]->begin(); iter != groups[g]->end(); ++iter)
+    {
+      IDataArray::Pointer d = (*iter).second;
+      if (d->isMemoryMapped() == true) { continue; }
+      heapBytes += d->GetSize() * d->GetTypeSize();
+      if (NULL != heapArrays) { heapArrays->push_back(d); }
+    }
+  }
+  return heapBytes;
+}
+
+// -----------------------------------------------------------------------------
+// Filters hold on to the pointers of the arrays they already have, so only the
+// array that was just added may be moved
+// -----------------------------------------------------------------------------
+void VoxelDataContainer::mapIfOverMemoryBudget(IDataArray::Pointer data)
+{
+  if (m_MemoryBudget == 0 || data->isMemoryMapped() == true)
+  {
+    return;
+  }
+  if (getHeapBytes(NULL) > m_MemoryBudget)
+  {
+    data->setMemoryMapped(true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int VoxelDataContainer::compactFieldDataArrays(const std::vector<bool> &keep, std::vector<int64_t> &newIds)
+{
+  newIds.resize(keep.size());
+  int64_t kept = 0;
+  for(size_t i = 0; i < keep.size(); ++i)
+  {
+    newIds[i] = (keep[i] == true) ? kept++ : -1;
+  }
+
+  std::vector<IDataArray::Pointer> arrays;
+  arrays.reserve(m_FieldData.size());
+  for(std::map<std::string, IDataArray::Pointer>::iterator iter = m_FieldData.begin(); iter != m_FieldData.end(); ++iter)
+  {
+    // Check every array before any of them is changed
+    if ((*iter).second->GetNumberOfTuples() != keep.size()) { return -100; }
+    arrays.push_back((*iter).second);
+  }
+  int err = 0;
+  if (arrays.empty() == false)
+  {
+    std::vector<int> errors(arrays.size(), 0);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, arrays.size(), 1),
+                        CompactTuplesImpl(&(arrays.front()), &keep, &(errors.front())), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      CompactTuplesImpl serial(&(arrays.front()), &keep, &(errors.front()));
+      serial.generate(0, arrays.size());
+    }
+    for(size_t i = 0; i < errors.size(); ++i)
+    {
+      if (errors[i] >= 0) { continue; }
+      // The other arrays have already been compacted so drop this one rather than leave it with the old Fields
+      if (err == 0) { err = errors[i]; }
+      removeFieldData(arrays[i]->GetName());
+    }
+  }
+  m_NumFieldTuples = static_cast<size_t>(kept);
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -596,6 +787,7 @@ void VoxelDataContainer::addEnsembleData(const std::string &name, IDataArray::Po
   }
   m_EnsembleData[name] = data;
   m_NumEnsembleTuples = data->GetNumberOfTuples();
+  mapIfOverMemoryBudget(data);
 }
 
 
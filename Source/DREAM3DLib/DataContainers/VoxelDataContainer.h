@@ -355,6 +355,19 @@ class DREAM3DLib_EXPORT VoxelDataContainer : public Observable
     */
     virtual void resizeFieldDataArrays(size_t size);
 
+    /**
+    * @brief Removes the Fields whose flag in 'keep' is false from every Field Array in one pass.
+    * Each array is compacted in place and the arrays are compacted concurrently. Nothing is
+    * changed unless every Field Array has one tuple per flag. An array that still fails, which
+    * only happens when memory runs out, is removed so the arrays that are left all have the new
+    * number of Fields.
+    * @param keep One flag per Field
+    * @param newIds Filled with the new index of each old Field, or -1 if the Field was removed
+    * @return 0 on success, -100 if an array does not have one tuple per flag, otherwise the
+    * error code of the first array that failed
+    */
+    virtual int compactFieldDataArrays(const std::vector<bool> &keep, std::vector<int64_t> &newIds);
+
     /**
     * @brief Adds/overwrites the data for a named array
     * @param name The name that the array will be known by
@@ -419,6 +432,25 @@ class DREAM3DLib_EXPORT VoxelDataContainer : public Observable
 
 
 
+    /**
+    * @brief Sets how many bytes of array data the container may keep on the heap, 0 (the
+    * default) means no limit. The largest heap arrays are moved to memory mapped files right
+    * away, after that an array that is added while the container is over budget is moved to a
+    * memory mapped file. Arrays that are bigger than MemoryMappedFile::GetMappingThreshold()
+    * never use the heap in the first place.
+    * @param bytes
+    */
+    virtual void setMemoryBudget(uint64_t bytes);
+    virtual uint64_t getMemoryBudget();
+
+    /**
+    * @brief Moves the largest heap arrays of the container to memory mapped files until the
+    * rest fit in the memory budget. The moved arrays get new pointers so this must not be
+    * called while a filter holds on to array pointers.
+    * @return The number of bytes of array data that are still on the heap
+    */
+    virtual uint64_t applyMemoryBudget();
+
     DOES_DATASET_EXIST_DECL(VertexData)
     DOES_DATASET_EXIST_DECL(EdgeData)
     DOES_DATASET_EXIST_DECL(FaceData)
@@ -438,6 +470,10 @@ class DREAM3DLib_EXPORT VoxelDataContainer : public Observable
     std::map<std::string, IDataArray::Pointer> m_CellData;
     std::map<std::string, IDataArray::Pointer> m_FieldData;
     std::map<std::string, IDataArray::Pointer> m_EnsembleData;
+    uint64_t m_MemoryBudget;
+
+    uint64_t getHeapBytes(std::vector<IDataArray::Pointer>* heapArrays);
+    void mapIfOverMemoryBudget(IDataArray::Pointer data);
 
     VoxelDataContainer(const VoxelDataContainer&);
     void operator =(const VoxelDataContainer&);
@@ -163,46 +163,43 @@ void RenumberGrains::execute()
   }
 
   std::stringstream ss;
-  size_t goodcount = 1;
-  std::vector<size_t> NewNames;
-  NewNames.resize(totalFields,0);
-
   ss.str("");
   ss << " - Generating Active Grain List";
   notifyStatusMessage(ss.str());
-  std::vector<size_t> RemoveList;
+  std::vector<bool> keep(totalFields, true);
+  size_t removeCount = 0;
   for(size_t i = 1; i < totalFields; i++)
   {
     if(m_Active[i] == false)
     {
-      RemoveList.push_back(i);
-      NewNames[i] = 0;
-    }
-    else
-    {
-      NewNames[i] = goodcount;
-      goodcount++;
+      keep[i] = false;
+      removeCount++;
     }
   }
 
 
-  if(RemoveList.size() > 0)
+  if(removeCount > 0)
   {
+    // The neighbor lists hold the old grain ids so they are dropped instead of compacted
     std::list<std::string> headers = m->getFieldArrayNameList();
     for (std::list<std::string>::iterator iter = headers.begin(); iter != headers.end(); ++iter)
     {
       IDataArray::Pointer p = m->getFieldData(*iter);
-      ss.str("");
-      //ss << " erasing " << RemoveList.size() << " tuples from array '" << *iter << "'";
-      //ss << " with NumTuples: " << p->GetNumberOfTuples() << " NumComp:" << p->GetNumberOfComponents();
-      ss << "Updating Field Array '" << *iter << "'";
-      notifyStatusMessage(ss.str());
-	  std::string type = p->getTypeAsString();
+      std::string type = p->getTypeAsString();
       if(type.compare("NeighborList<T>") == 0) { m->removeFieldData(*iter);}
-      else {p->EraseTuples(RemoveList);}
-      //std::cout << "  Tuples Remain: " << p->GetNumberOfTuples() << " NumComp:" << p->GetNumberOfComponents() << std::endl << std::endl;
     }
-    m->setNumFieldTuples(m->getNumFieldTuples() - RemoveList.size());
+
+    ss.str("");
+    ss << "Updating Field Arrays";
+    notifyStatusMessage(ss.str());
+    std::vector<int64_t> newIds;
+    int err = m->compactFieldDataArrays(keep, newIds);
+    if (err < 0)
+    {
+      setErrorCondition(err);
+      notifyErrorMessage("A Field Array could not be compacted", err);
+      return;
+    }
     totalFields = m->getNumFieldTuples();
     dataCheck(false, totalPoints, totalFields, m->getNumEnsembleTuples());
 
@@ -210,12 +207,12 @@ void RenumberGrains::execute()
     ss.str("");
     ss << "Renumbering Cell Region Ids";
     notifyStatusMessage(ss.str());
-    for (int i = 0; i < totalPoints; i++)
+    for (int64_t i = 0; i < totalPoints; i++)
     {
-      //  notify(ss.str(), 0, Observable::UpdateProgressMessage);
       if(m_GrainIds[i] > 0)
       {
-        m_GrainIds[i] = static_cast<int32_t>( NewNames[m_GrainIds[i]] );
+        int64_t newId = newIds[m_GrainIds[i]];
+        m_GrainIds[i] = (newId < 0) ? 0 : static_cast<int32_t>(newId);
       }
     }
   }
@@ -90,6 +90,99 @@ namespace Detail
     }
     return ptr;
   }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  IDataArray::Pointer readH5DatasetSubVolume(hid_t locId,
+                                             const std::string &datasetPath,
+                                             const std::vector<hsize_t> &dims,
+                                             const int64_t* volDims,
+                                             const int64_t* bounds)
+  {
+    IDataArray::Pointer ptr = IDataArray::NullPointer();
+    hsize_t numComp = (dims.size() > 1) ? dims[1] : 1;
+    hsize_t totalPoints = static_cast<hsize_t>(volDims[0] * volDims[1] * volDims[2]);
+    if(dims.size() > 2 || dims[0] != totalPoints)
+    {
+      std::cout << "readH5DatasetSubVolume: '" << datasetPath << "' does not hold one tuple per Cell" << std::endl;
+      return ptr;
+    }
+    hsize_t xP = static_cast<hsize_t>(bounds[1] - bounds[0] + 1);
+    hsize_t yP = static_cast<hsize_t>(bounds[3] - bounds[2] + 1);
+    hsize_t zP = static_cast<hsize_t>(bounds[5] - bounds[4] + 1);
+    hsize_t sliceTuples = xP * yP;
+
+    DataArray<T>* array = NULL;
+    {
+      typename DataArray<T>::Pointer p = DataArray<T>::CreateArray(sliceTuples * zP, static_cast<int>(numComp), datasetPath);
+      array = p.get();
+      ptr = p;
+    }
+    if (NULL == array->GetPointer(0))
+    {
+      return IDataArray::NullPointer();
+    }
+    hid_t dataType = H5Lite::HDFTypeForPrimitive(T(0));
+
+    // Keep a few decompressed chunks around as the slices walk through them
+    H5Lite::ChunkedWriteOptions cacheOptions;
+    cacheOptions.ChunkCacheBytes = 64 * 1024 * 1024;
+    hid_t dapl = H5Lite::createChunkCacheAccessPList(cacheOptions);
+    hid_t did = H5Dopen(locId, datasetPath.c_str(), dapl);
+    H5Lite::closeChunkCacheAccessPList(dapl);
+    if (did < 0)
+    {
+      return IDataArray::NullPointer();
+    }
+    hid_t fileSpace = H5Dget_space(did);
+    hsize_t memDims[1] = { sliceTuples * numComp };
+    hid_t memSpace = H5Screate_simple(1, memDims, NULL);
+
+    herr_t err = 0;
+    hsize_t dimX = static_cast<hsize_t>(volDims[0]);
+    hsize_t xyPoints = dimX * static_cast<hsize_t>(volDims[1]);
+    for (hsize_t z = 0; z < zP && err >= 0; ++z)
+    {
+      // The rows of the box in this slice are yP runs of xP tuples spaced one X row apart
+      hsize_t start[2] = { (static_cast<hsize_t>(bounds[4]) + z) * xyPoints + static_cast<hsize_t>(bounds[2]) * dimX + static_cast<hsize_t>(bounds[0]), 0 };
+      hsize_t stride[2] = { dimX, 1 };
+      hsize_t count[2] = { yP, 1 };
+      hsize_t block[2] = { xP, numComp };
+      err = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, stride, count, block);
+      if (err >= 0)
+      {
+        err = H5Dread(did, dataType, memSpace, fileSpace, H5P_DEFAULT, array->GetPointer(z * sliceTuples * numComp));
+      }
+    }
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+    H5Dclose(did);
+    if (err < 0)
+    {
+      std::cout << "readH5DatasetSubVolume read error: " << __FILE__ << "(" << __LINE__ << ")" << std::endl;
+      ptr = IDataArray::NullPointer();
+    }
+    return ptr;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  IDataArray::Pointer readH5Dataset(hid_t locId,
+                                    const std::string &datasetPath,
+                                    const std::vector<hsize_t> &dims,
+                                    const int64_t* volDims,
+                                    const int64_t* bounds)
+  {
+    if (NULL != volDims && NULL != bounds)
+    {
+      return readH5DatasetSubVolume<T>(locId, datasetPath, dims, volDims, bounds);
+    }
+    return readH5Dataset<T>(locId, datasetPath, dims);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -182,6 +275,24 @@ IDataArray::Pointer H5DataArrayReader::readStringDataArray(hid_t gid, const std:
 //
 // -----------------------------------------------------------------------------
 IDataArray::Pointer H5DataArrayReader::readIDataArray(hid_t gid, const std::string &name, bool preflightOnly)
+{
+  return readIDataArray(gid, name, preflightOnly, NULL, NULL);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer H5DataArrayReader::readIDataArraySubVolume(hid_t gid, const std::string &name, const int64_t volDims[3],
+                                                               const int64_t bounds[6], bool preflightOnly)
+{
+  return readIDataArray(gid, name, preflightOnly, volDims, bounds);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer H5DataArrayReader::readIDataArray(hid_t gid, const std::string &name, bool preflightOnly,
+                                                      const int64_t* volDims, const int64_t* bounds)
 {
 
   herr_t err = -1;
@@ -221,7 +332,7 @@ IDataArray::Pointer H5DataArrayReader::readIDataArray(hid_t gid, const std::stri
     // Check to see if we are reading a bool array and if so read it and return
     if (classType.compare("DataArray<bool>") == 0)
     {
-      if (preflightOnly == false) ptr = Detail::readH5Dataset<bool>(gid, name, dims);
+      if (preflightOnly == false) ptr = Detail::readH5Dataset<bool>(gid, name, dims, volDims, bounds);
       else ptr = DataArray<bool>::CreateArray(1, numComp, name);
       CloseH5T(typeId, err, retErr);
       return ptr; // <== Note early return here.
@@ -242,42 +353,42 @@ IDataArray::Pointer H5DataArrayReader::readIDataArray(hid_t gid, const std::stri
         //std::cout << "User Meta Data Type is Integer" << std::endl;
         if(H5Tequal(typeId, H5T_STD_U8BE) || H5Tequal(typeId, H5T_STD_U8LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint8_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint8_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<uint8_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_U16BE) || H5Tequal(typeId, H5T_STD_U16LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint16_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint16_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<uint16_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_U32BE) || H5Tequal(typeId, H5T_STD_U32LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint32_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint32_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<uint32_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_U64BE) || H5Tequal(typeId, H5T_STD_U64LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint64_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<uint64_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<uint64_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_I8BE) || H5Tequal(typeId, H5T_STD_I8LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<int8_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<int8_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<int8_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_I16BE) || H5Tequal(typeId, H5T_STD_I16LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<int16_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<int16_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<int16_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_I32BE) || H5Tequal(typeId, H5T_STD_I32LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<int32_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<int32_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<int32_t>::CreateArray(1, numComp, name);
         }
         else if(H5Tequal(typeId, H5T_STD_I64BE) || H5Tequal(typeId, H5T_STD_I64LE))
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<int64_t>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<int64_t>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<int64_t>::CreateArray(1, numComp, name);
         }
         else
@@ -290,12 +401,12 @@ IDataArray::Pointer H5DataArrayReader::readIDataArray(hid_t gid, const std::stri
       case H5T_FLOAT:
         if(attr_size == 4)
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<float>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<float>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<float>::CreateArray(1, numComp, name);
         }
         else if(attr_size == 8)
         {
-          if (preflightOnly == false) ptr = Detail::readH5Dataset<double>(gid, name, dims);
+          if (preflightOnly == false) ptr = Detail::readH5Dataset<double>(gid, name, dims, volDims, bounds);
           else ptr = DataArray<double>::CreateArray(1, numComp, name);
         }
         else
@@ -60,6 +60,21 @@ class DREAM3DLib_EXPORT H5DataArrayReader
      */
     static IDataArray::Pointer readIDataArray(hid_t gid, const std::string &name, bool preflightOnly = false);
 
+    /**
+     * @brief Reads only the Cells inside a bounding box from an array that holds
+     * one tuple per Cell of a volume. Each Z slice of the box is read with a
+     * single strided HDF5 hyperslab selection so the rest of the array is never
+     * read from disk.
+     * @param gid
+     * @param name
+     * @param volDims The dimensions of the full volume stored in the file
+     * @param bounds The inclusive bounding box as {xMin, xMax, yMin, yMax, zMin, zMax}
+     * @param preflightOnly
+     * @return
+     */
+    static IDataArray::Pointer readIDataArraySubVolume(hid_t gid, const std::string &name, const int64_t volDims[3],
+                                                       const int64_t bounds[6], bool preflightOnly = false);
+
     /**
      *
      * @param gid
@@ -81,6 +96,9 @@ class DREAM3DLib_EXPORT H5DataArrayReader
   protected:
     H5DataArrayReader();
 
+    static IDataArray::Pointer readIDataArray(hid_t gid, const std::string &name, bool preflightOnly,
+                                              const int64_t* volDims, const int64_t* bounds);
+
   private:
     H5DataArrayReader(const H5DataArrayReader&); // Copy Constructor Not Implemented
     void operator=(const H5DataArrayReader&); // Operator '=' Not Implemented
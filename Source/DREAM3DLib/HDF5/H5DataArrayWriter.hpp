@@ -58,7 +58,13 @@ class H5DataArrayWriter
   public:
   virtual ~H5DataArrayWriter() {}
 
-  static int writeArray(hid_t gid, const std::string &name, size_t numTuples, int numComp, T* data, const std::string &className)
+  /**
+   * @brief Writes the array as a dataset of numTuples by numComp values
+   * @param options If non NULL the dataset is written with a chunked layout
+   * using these settings, otherwise the default contiguous layout is used.
+   */
+  static int writeArray(hid_t gid, const std::string &name, size_t numTuples, int numComp, T* data, const std::string &className,
+                        const H5Lite::ChunkedWriteOptions* options = NULL)
   {
       int32_t rank = 0;
       if(numComp == 1)
@@ -73,7 +79,14 @@ class H5DataArrayWriter
       hsize_t dims[2] = { hsize_t(numTuples), hsize_t(numComp) };
       int err = 0;
       if (H5Lite::datasetExists(gid, name) == false) {
-        err = H5Lite::writePointerDataset(gid, name, rank, dims, data);
+        if (NULL != options)
+        {
+          err = H5Lite::writePointerDatasetChunked(gid, name, rank, dims, data, *options);
+        }
+        else
+        {
+          err = H5Lite::writePointerDataset(gid, name, rank, dims, data);
+        }
         if(err < 0)
         {
           return err;
@@ -58,7 +58,14 @@ DataContainerReader::DataContainerReader() :
   m_ReadVoxelData(true),
   m_ReadSurfaceMeshData(false),
   m_ReadSolidMeshData(false),
-  m_ReadAllArrays(true)
+  m_ReadAllArrays(true),
+  m_ReadSubVolume(false),
+  m_XMin(0),
+  m_YMin(0),
+  m_ZMin(0),
+  m_XMax(0),
+  m_YMax(0),
+  m_ZMax(0)
 {
   m_PipelineFromFile = FilterPipeline::New();
   setupFilterParameters();
@@ -77,6 +84,68 @@ DataContainerReader::~DataContainerReader()
 void DataContainerReader::setupFilterParameters()
 {
   std::vector<FilterParameter::Pointer> parameters;
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Read Sub-Volume");
+    option->setPropertyName("ReadSubVolume");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("X Min");
+    option->setPropertyName("XMin");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("X Max");
+    option->setPropertyName("XMax");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Y Min");
+    option->setPropertyName("YMin");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Y Max");
+    option->setPropertyName("YMax");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Z Min");
+    option->setPropertyName("ZMin");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Z Max");
+    option->setPropertyName("ZMax");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("Cell Index");
+    parameters.push_back(option);
+  }
 
   setFilterParameters(parameters);
 }
@@ -91,6 +160,13 @@ void DataContainerReader::readFilterParameters(AbstractFilterParametersReader* r
   setReadVoxelData( reader->readValue("ReadVoxelData", getReadVoxelData() ) );
   setReadSurfaceMeshData( reader->readValue("ReadSurfaceMeshData", getReadSurfaceMeshData() ) );
   setReadSolidMeshData( reader->readValue("ReadSolidMeshData", getReadSolidMeshData() ) );
+  setReadSubVolume( reader->readValue("ReadSubVolume", getReadSubVolume() ) );
+  setXMin( reader->readValue("XMin", getXMin()) );
+  setYMin( reader->readValue("YMin", getYMin()) );
+  setZMin( reader->readValue("ZMin", getZMin()) );
+  setXMax( reader->readValue("XMax", getXMax()) );
+  setYMax( reader->readValue("YMax", getYMax()) );
+  setZMax( reader->readValue("ZMax", getZMax()) );
 
   setSelectedVoxelCellArrays( reader->readValue("SelectedVoxelCellArrays", getSelectedVoxelCellArrays() ) );
   setSelectedVoxelFieldArrays( reader->readValue("SelectedVoxelFieldArrays", getSelectedVoxelFieldArrays() ) );
@@ -119,6 +195,13 @@ int DataContainerReader::writeFilterParameters(AbstractFilterParametersWriter* w
   writer->writeValue("ReadVoxelData", getReadVoxelData() );
   writer->writeValue("ReadSurfaceMeshData", getReadSurfaceMeshData() );
   writer->writeValue("ReadSolidMeshData", getReadSolidMeshData() );
+  writer->writeValue("ReadSubVolume", getReadSubVolume() );
+  writer->writeValue("XMin", getXMin() );
+  writer->writeValue("YMin", getYMin() );
+  writer->writeValue("ZMin", getZMin() );
+  writer->writeValue("XMax", getXMax() );
+  writer->writeValue("YMax", getYMax() );
+  writer->writeValue("ZMax", getZMax() );
 
   writer->writeValue("SelectedVoxelCellArrays", getSelectedVoxelCellArrays() );
   writer->writeValue("SelectedVoxelFieldArrays", getSelectedVoxelFieldArrays() );
@@ -177,6 +260,13 @@ void DataContainerReader::dataCheck(bool preflight, size_t voxels, size_t fields
     {
       VoxelDataContainerReader::Pointer voxelReader = VoxelDataContainerReader::New();
       voxelReader->setHdfFileId(fileId);
+      voxelReader->setReadSubVolume(m_ReadSubVolume);
+      voxelReader->setXMin(m_XMin);
+      voxelReader->setYMin(m_YMin);
+      voxelReader->setZMin(m_ZMin);
+      voxelReader->setXMax(m_XMax);
+      voxelReader->setYMax(m_YMax);
+      voxelReader->setZMax(m_ZMax);
       voxelReader->setVoxelDataContainer(getVoxelDataContainer());
       voxelReader->setObservers(getObservers());
       ss.str("");
@@ -277,6 +367,13 @@ void DataContainerReader::execute()
     voxelReader->setFieldArraysToRead(m_SelectedVoxelFieldArrays);
     voxelReader->setEnsembleArraysToRead(m_SelectedVoxelEnsembleArrays);
     voxelReader->setReadAllArrays(m_ReadAllArrays);
+    voxelReader->setReadSubVolume(m_ReadSubVolume);
+    voxelReader->setXMin(m_XMin);
+    voxelReader->setYMin(m_YMin);
+    voxelReader->setZMin(m_ZMin);
+    voxelReader->setXMax(m_XMax);
+    voxelReader->setYMax(m_YMax);
+    voxelReader->setZMax(m_ZMax);
     voxelReader->setVoxelDataContainer(getVoxelDataContainer());
     voxelReader->setObservers(getObservers());
     ss.str("");
@@ -285,6 +382,7 @@ void DataContainerReader::execute()
     voxelReader->execute();
     if (voxelReader->getErrorCondition() < 0)
     {
+      setErrorCondition(voxelReader->getErrorCondition());
       notifyErrorMessage("Error Reading the Voxel Data", -803);
       return;
     }
@@ -66,6 +66,13 @@ class DREAM3DLib_EXPORT DataContainerReader : public AbstractFilter
     DREAM3D_INSTANCE_PROPERTY(bool, ReadSurfaceMeshData)
     DREAM3D_INSTANCE_PROPERTY(bool, ReadSolidMeshData)
     DREAM3D_INSTANCE_PROPERTY(bool, ReadAllArrays)
+    DREAM3D_INSTANCE_PROPERTY(bool, ReadSubVolume)
+    DREAM3D_INSTANCE_PROPERTY(int, XMin)
+    DREAM3D_INSTANCE_PROPERTY(int, YMin)
+    DREAM3D_INSTANCE_PROPERTY(int, ZMin)
+    DREAM3D_INSTANCE_PROPERTY(int, XMax)
+    DREAM3D_INSTANCE_PROPERTY(int, YMax)
+    DREAM3D_INSTANCE_PROPERTY(int, ZMax)
 
     DREAM3D_INSTANCE_PROPERTY(std::set<std::string>, SelectedVoxelVertexArrays)
     DREAM3D_INSTANCE_PROPERTY(std::set<std::string>, SelectedVoxelFaceArrays)
@@ -65,6 +65,9 @@ DataContainerWriter::DataContainerWriter() :
   m_WriteSurfaceMeshData(true),
   m_WriteSolidMeshData(false),
   m_WriteXdmfFile(true),
+  m_WriteChunkedData(false),
+  m_CompressionLevel(4),
+  m_ChunkSize(1024),
   m_FileId(-1)
 {
   setupFilterParameters();
@@ -119,6 +122,32 @@ void DataContainerWriter::setupFilterParameters()
     option->setUnits("ParaView Compatible File");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Write Chunked Data");
+    option->setPropertyName("WriteChunkedData");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Compression Level");
+    option->setPropertyName("CompressionLevel");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("0 to 9, 0 = No Compression");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Chunk Size");
+    option->setPropertyName("ChunkSize");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("KB");
+    parameters.push_back(option);
+  }
 
   setFilterParameters(parameters);
 }
@@ -136,6 +165,9 @@ void DataContainerWriter::readFilterParameters(AbstractFilterParametersReader* r
   setWriteSurfaceMeshData( reader->readValue("WriteSurfaceMeshData", getWriteSurfaceMeshData() ) );
   setWriteSolidMeshData( reader->readValue("WriteSolidMeshData", getWriteSolidMeshData() ) );
   setWriteXdmfFile( reader->readValue("WriteXdmfFile", getWriteXdmfFile()) );
+  setWriteChunkedData( reader->readValue("WriteChunkedData", getWriteChunkedData()) );
+  setCompressionLevel( reader->readValue("CompressionLevel", getCompressionLevel()) );
+  setChunkSize( reader->readValue("ChunkSize", getChunkSize()) );
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -151,6 +183,9 @@ int DataContainerWriter::writeFilterParameters(AbstractFilterParametersWriter* w
   writer->writeValue("WriteSurfaceMeshData", getWriteSurfaceMeshData() );
   writer->writeValue("WriteSolidMeshData", getWriteSolidMeshData() );
   writer->writeValue("WriteXdmfFile", getWriteXdmfFile() );
+  writer->writeValue("WriteChunkedData", getWriteChunkedData() );
+  writer->writeValue("CompressionLevel", getCompressionLevel() );
+  writer->writeValue("ChunkSize", getChunkSize() );
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -183,6 +218,21 @@ void DataContainerWriter::dataCheck(bool preflight, size_t voxels, size_t fields
     m_OutputFile.append(".dream3d");
   }
 
+  if (m_WriteChunkedData == true && (m_CompressionLevel < 0 || m_CompressionLevel > 9))
+  {
+    ss.str("");
+    ss << "The Compression Level must be between 0 and 9.";
+    addErrorMessage(getHumanLabel(), ss.str(), -1);
+    setErrorCondition(-1);
+  }
+  if (m_WriteChunkedData == true && m_ChunkSize <= 0)
+  {
+    ss.str("");
+    ss << "The Chunk Size must be larger than 0 KB.";
+    addErrorMessage(getHumanLabel(), ss.str(), -1);
+    setErrorCondition(-1);
+  }
+
 }
 
 // -----------------------------------------------------------------------------
@@ -209,6 +259,10 @@ void DataContainerWriter::execute()
   }
   setErrorCondition(0);
   dataCheck(false, 1, 1, 1);
+  if (getErrorCondition() < 0)
+  {
+    return;
+  }
 
   std::stringstream ss;
   int err = 0;
@@ -263,6 +317,11 @@ void DataContainerWriter::execute()
   // Write the Pipeline to the File
   err = writePipeline();
 
+  H5Lite::ChunkedWriteOptions chunkOptions;
+  chunkOptions.DeflateLevel = m_CompressionLevel;
+  chunkOptions.Shuffle = (m_CompressionLevel > 0);
+  chunkOptions.TargetChunkBytes = static_cast<size_t>(m_ChunkSize) * 1024;
+
   /* WRITE THE VOXEL DATA TO THE HDF5 FILE */
   if (getVoxelDataContainer() != NULL && m_WriteVoxelData == true)
   {
@@ -272,6 +331,8 @@ void DataContainerWriter::execute()
     writer->setObservers(getObservers());
     writer->setWriteXdmfFile(getWriteXdmfFile());
     writer->setXdmfOStream(&xdmf);
+    writer->setWriteChunkedData(m_WriteChunkedData);
+    writer->setChunkedWriteOptions(chunkOptions);
     ss.str("");
     ss << getMessagePrefix() << " |--> Writing Voxel Data ";
     writer->setMessagePrefix(ss.str());
@@ -292,6 +353,8 @@ void DataContainerWriter::execute()
     writer->setObservers(getObservers());
     writer->setWriteXdmfFile(getWriteXdmfFile());
     writer->setXdmfOStream(&xdmf);
+    writer->setWriteChunkedData(m_WriteChunkedData);
+    writer->setChunkedWriteOptions(chunkOptions);
     ss.str("");
     ss << getMessagePrefix() << " |--> Writing SurfaceMesh Data ";
     writer->setMessagePrefix(ss.str());
@@ -71,6 +71,9 @@ class DREAM3DLib_EXPORT DataContainerWriter : public AbstractFilter
     DREAM3D_INSTANCE_PROPERTY(bool, WriteSurfaceMeshData)
     DREAM3D_INSTANCE_PROPERTY(bool, WriteSolidMeshData)
     DREAM3D_INSTANCE_PROPERTY(bool, WriteXdmfFile)
+    DREAM3D_INSTANCE_PROPERTY(bool, WriteChunkedData)
+    DREAM3D_INSTANCE_PROPERTY(int, CompressionLevel)
+    DREAM3D_INSTANCE_PROPERTY(int, ChunkSize)
 
 
     virtual void preflight();
@@ -56,6 +56,203 @@
 
 #include "DREAM3DLib/Common/Observable.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/atomic.h>
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief Writes parsed EBSD files into the H5Ebsd file one slice at a time and
+ * collects the overall volume dimensions. Both the serial and the parallel
+ * import push every slice through this class so they produce the same file.
+ */
+class EbsdSliceWriter
+{
+  public:
+    EbsdSliceWriter(EbsdToH5Ebsd* filter, EbsdImporter::Pointer importer, hid_t fileId) :
+      m_Filter(filter),
+      m_Importer(importer),
+      m_FileId(fileId),
+      m_TotalSlicesImported(0),
+      m_BiggestXDim(0),
+      m_BiggestYDim(0),
+      m_XRes(0.0f),
+      m_YRes(0.0f)
+    {}
+    virtual ~EbsdSliceWriter(){}
+
+    /**
+     * @brief Writes a single parsed file into the HDF5 file
+     * @return false if the import must stop because of an error or because the
+     * user canceled the import.
+     */
+    bool write(int64_t z, const std::string &ebsdFName, EbsdReader::Pointer reader)
+    {
+      int err = m_Importer->writeParsedFile(m_FileId, z, ebsdFName, reader);
+      if (err < 0)
+      {
+        if (err != -600)
+        {
+          m_Filter->setErrorCondition(m_Importer->getErrorCondition());
+          m_Filter->notifyErrorMessage(m_Importer->getPipelineMessage(), m_Filter->getErrorCondition());
+          return false;
+        }
+        else
+        {
+          m_Filter->notifyWarningMessage(m_Importer->getPipelineMessage(), m_Importer->getErrorCondition() );
+        }
+      }
+      m_TotalSlicesImported = m_TotalSlicesImported + m_Importer->numberOfSlicesImported();
+
+      int64_t xDim = 0, yDim = 0;
+      m_Importer->getDims(xDim, yDim);
+      m_Importer->getResolution(m_XRes, m_YRes);
+      if(xDim > m_BiggestXDim) m_BiggestXDim = xDim;
+      if(yDim > m_BiggestYDim) m_BiggestYDim = yDim;
+
+      m_Indices.push_back( static_cast<int>(z) );
+      if(m_Filter->getCancel() == true)
+      {
+        m_Filter->notifyStatusMessage("Conversion was Canceled");
+        return false;
+      }
+      return true;
+    }
+
+    int getTotalSlicesImported() { return m_TotalSlicesImported; }
+    int64_t getBiggestXDim() { return m_BiggestXDim; }
+    int64_t getBiggestYDim() { return m_BiggestYDim; }
+    float getXRes() { return m_XRes; }
+    float getYRes() { return m_YRes; }
+    std::vector<int>& getIndices() { return m_Indices; }
+
+  private:
+    EbsdToH5Ebsd* m_Filter;
+    EbsdImporter::Pointer m_Importer;
+    hid_t m_FileId;
+    int m_TotalSlicesImported;
+    int64_t m_BiggestXDim;
+    int64_t m_BiggestYDim;
+    float m_XRes;
+    float m_YRes;
+    std::vector<int> m_Indices;
+};
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+/**
+ * @brief A single slice travelling through the import pipeline
+ */
+struct EbsdSliceToken
+{
+  int64_t z;
+  std::string fileName;
+  EbsdReader::Pointer reader;
+};
+
+/**
+ * @brief Hands out the files in slice order. The number of tokens the pipeline
+ * is run with bounds how many parsed slices can be held in memory at once.
+ */
+class EbsdSliceInputFilter : public tbb::filter
+{
+  public:
+    EbsdSliceInputFilter(EbsdToH5Ebsd* filter, const std::vector<std::string> &files, int64_t zStart, tbb::atomic<int> &stop) :
+      tbb::filter(tbb::filter::serial_in_order),
+      m_Filter(filter),
+      m_Files(files),
+      m_Index(0),
+      m_Z(zStart),
+      m_Stop(stop)
+    {}
+    virtual ~EbsdSliceInputFilter(){}
+
+    void* operator()(void*)
+    {
+      if (m_Index >= m_Files.size() || m_Stop != 0 || m_Filter->getCancel() == true)
+      {
+        return NULL;
+      }
+      EbsdSliceToken* token = new EbsdSliceToken;
+      token->z = m_Z++;
+      token->fileName = m_Files[m_Index++];
+      return token;
+    }
+
+  private:
+    EbsdToH5Ebsd* m_Filter;
+    const std::vector<std::string> &m_Files;
+    size_t m_Index;
+    int64_t m_Z;
+    tbb::atomic<int> &m_Stop;
+};
+
+/**
+ * @brief Parses the files. Runs on as many threads as there are tokens in flight.
+ */
+class EbsdSliceParseFilter : public tbb::filter
+{
+  public:
+    EbsdSliceParseFilter(EbsdImporter::Pointer importer, tbb::atomic<int> &stop) :
+      tbb::filter(tbb::filter::parallel),
+      m_Importer(importer),
+      m_Stop(stop)
+    {}
+    virtual ~EbsdSliceParseFilter(){}
+
+    void* operator()(void* item)
+    {
+      EbsdSliceToken* token = static_cast<EbsdSliceToken*>(item);
+      if (m_Stop == 0)
+      {
+        token->reader = m_Importer->parseFile(token->fileName);
+      }
+      return token;
+    }
+
+  private:
+    EbsdImporter::Pointer m_Importer;
+    tbb::atomic<int> &m_Stop;
+};
+
+/**
+ * @brief Writes the parsed slices into the HDF5 file, one at a time and in
+ * slice order, then releases the memory held by the slice.
+ */
+class EbsdSliceWriteFilter : public tbb::filter
+{
+  public:
+    EbsdSliceWriteFilter(EbsdToH5Ebsd* filter, EbsdSliceWriter &writer, tbb::atomic<int> &stop) :
+      tbb::filter(tbb::filter::serial_in_order),
+      m_Filter(filter),
+      m_Writer(writer),
+      m_Stop(stop)
+    {}
+    virtual ~EbsdSliceWriteFilter(){}
+
+    void* operator()(void* item)
+    {
+      EbsdSliceToken* token = static_cast<EbsdSliceToken*>(item);
+      if (m_Stop == 0)
+      {
+        std::string msg = "Converting File: " + token->fileName;
+        m_Filter->notifyStatusMessage(msg.c_str());
+        if (m_Writer.write(token->z, token->fileName, token->reader) == false)
+        {
+          m_Stop = 1;
+        }
+      }
+      delete token;
+      return NULL;
+    }
+
+  private:
+    EbsdToH5Ebsd* m_Filter;
+    EbsdSliceWriter &m_Writer;
+    tbb::atomic<int> &m_Stop;
+};
+#endif
+
 
 // -----------------------------------------------------------------------------
 //
@@ -65,7 +262,9 @@ EbsdToH5Ebsd::EbsdToH5Ebsd() :
   m_ZEndIndex(0),
   m_ZResolution(1.0),
   m_SampleTransformationAngle(0.0),
-  m_EulerTransformationAngle(0.0)
+  m_EulerTransformationAngle(0.0),
+  m_UseParallelImport(false),
+  m_ImportMemoryLimit(1024)
 {
   m_SampleTransformationAxis.resize(3);
   m_SampleTransformationAxis[0] = 0.0;
@@ -111,6 +310,8 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setEulerTransformationAxis( reader->readValue("EulerTransformationAxis", getEulerTransformationAxis()) );
   setRefFrameZDir( static_cast<Ebsd::RefFrameZDir>( reader->readValue("RefFrameZDir", getRefFrameZDir() ) ) );
   setEbsdFileList( reader->readValue("EbsdFileList", getEbsdFileList()) );
+  setUseParallelImport( reader->readValue("UseParallelImport", getUseParallelImport()) );
+  setImportMemoryLimit( reader->readValue("ImportMemoryLimit", getImportMemoryLimit()) );
   reader->closeFilterGroup();
 }
 
@@ -130,6 +331,8 @@ int EbsdToH5Ebsd::writeFilterParameters(AbstractFilterParametersWriter* writer,
   writer->writeValue("EulerTransformationAxis", getEulerTransformationAxis());
   writer->writeValue("RefFrameZDir", getRefFrameZDir());
   writer->writeValue("EbsdFileList", getEbsdFileList());
+  writer->writeValue("UseParallelImport", getUseParallelImport());
+  writer->writeValue("ImportMemoryLimit", getImportMemoryLimit());
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -362,13 +565,7 @@ void EbsdToH5Ebsd::execute()
     return;
   }
 
-  std::vector<int> indices;
   // Loop on Each EBSD File
-  float total = static_cast<float>( m_ZEndIndex - m_ZStartIndex );
-  int progress = 0;
-  int64_t z = m_ZStartIndex;
-  int64_t xDim = 0, yDim = 0;
-  float xRes = 0.0f, yRes = 0.0f;
   /* There is a frailness about the z index and the file list. The programmer
    * using this code MUST ensure that the list of files that is sent into this
    * class is in the appropriate order to match up with the z index (slice index)
@@ -392,49 +589,72 @@ void EbsdToH5Ebsd::execute()
    * which is going to cause problems because the data is going to be placed
    * into the HDF5 file at the wrong index. YOU HAVE BEEN WARNED.
    */
-  int64_t biggestxDim = 0;
-  int64_t biggestyDim = 0;
-  int totalSlicesImported = 0;
-  for (std::vector<std::string>::iterator filepath = m_EbsdFileList.begin(); filepath != m_EbsdFileList.end(); ++filepath)
+  EbsdSliceWriter sliceWriter(this, fileImporter, fileId);
+  bool completed = true;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (m_UseParallelImport == true && m_EbsdFileList.size() > 1)
   {
-    std::string ebsdFName = *filepath;
-    progress = static_cast<int>( z - m_ZStartIndex );
-    progress = (int)(100.0f * (float)(progress) / total);
-    std::string msg = "Converting File: " + ebsdFName;
-    ss.str("");
-
-    notifyStatusMessage(msg.c_str());
-    err = fileImporter->importFile(fileId, z, ebsdFName);
-    if (err < 0)
+    tbb::task_scheduler_init init;
+    // The parsed slices hold about as much memory as the text files they came
+    // from so the largest file decides how many slices may be in flight.
+    uint64_t largestFile = 1;
+    for (std::vector<std::string>::iterator filepath = m_EbsdFileList.begin(); filepath != m_EbsdFileList.end(); ++filepath)
     {
-      if (err != -600)
-      {
-        setErrorCondition(fileImporter->getErrorCondition());
-        notifyErrorMessage(fileImporter->getPipelineMessage(), getErrorCondition());
-        return;
-      }
-      else
-      {
-        notifyWarningMessage(fileImporter->getPipelineMessage(), fileImporter->getErrorCondition() );
-        //setErrorCondition(fileImporter->getErrorCondition() );
-        err = 0;
-      }
+      uint64_t size = MXAFileInfo::fileSize(*filepath);
+      if (size > largestFile) { largestFile = size; }
     }
-    totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
-
-    fileImporter->getDims(xDim, yDim);
-    fileImporter->getResolution(xRes, yRes);
-    if(xDim > biggestxDim) biggestxDim = xDim;
-    if(yDim > biggestyDim) biggestyDim = yDim;
-
-    indices.push_back( static_cast<int>(z) );
-    ++z;
-    if(getCancel() == true)
+    uint64_t memoryLimit = static_cast<uint64_t>(m_ImportMemoryLimit) * 1024 * 1024;
+    size_t maxTokens = static_cast<size_t>(memoryLimit / largestFile);
+    // One slice per parsing thread plus the one being written keeps every thread busy
+    size_t maxThreads = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) + 1;
+    if (maxTokens > maxThreads) { maxTokens = maxThreads; }
+    // At least one slice has to be held while it is being written
+    if (maxTokens < 1) { maxTokens = 1; }
+
+    tbb::atomic<int> stop;
+    stop = 0;
+    EbsdSliceInputFilter inputFilter(this, m_EbsdFileList, m_ZStartIndex, stop);
+    EbsdSliceParseFilter parseFilter(fileImporter, stop);
+    EbsdSliceWriteFilter writeFilter(this, sliceWriter, stop);
+    tbb::pipeline pipeline;
+    pipeline.add_filter(inputFilter);
+    pipeline.add_filter(parseFilter);
+    pipeline.add_filter(writeFilter);
+    pipeline.run(maxTokens);
+    pipeline.clear();
+    if (stop == 0 && getCancel() == true)
     {
       notifyStatusMessage("Conversion was Canceled");
-      return;
     }
+    completed = (stop == 0 && getCancel() == false);
+  }
+  else
+#endif
+  {
+    int64_t z = m_ZStartIndex;
+    for (std::vector<std::string>::iterator filepath = m_EbsdFileList.begin(); filepath != m_EbsdFileList.end(); ++filepath)
+    {
+      std::string ebsdFName = *filepath;
+      std::string msg = "Converting File: " + ebsdFName;
+      notifyStatusMessage(msg.c_str());
+      if (sliceWriter.write(z, ebsdFName, fileImporter->parseFile(ebsdFName)) == false)
+      {
+        completed = false;
+        break;
+      }
+      ++z;
+    }
+  }
+  if (completed == false)
+  {
+    return;
   }
+  int totalSlicesImported = sliceWriter.getTotalSlicesImported();
+  int64_t biggestxDim = sliceWriter.getBiggestXDim();
+  int64_t biggestyDim = sliceWriter.getBiggestYDim();
+  float xRes = sliceWriter.getXRes();
+  float yRes = sliceWriter.getYRes();
+  std::vector<int>& indices = sliceWriter.getIndices();
 
   // Write Z index start, Z index end and Z Resolution to the HDF5 file
   err = H5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, m_ZStartIndex);
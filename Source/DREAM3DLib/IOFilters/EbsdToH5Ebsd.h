@@ -85,6 +85,10 @@ class DREAM3DLib_EXPORT EbsdToH5Ebsd : public AbstractFilter
     DREAM3D_INSTANCE_PROPERTY(float, EulerTransformationAngle)
     DREAM3D_INSTANCE_PROPERTY(std::vector<float>, EulerTransformationAxis)
     DREAM3D_INSTANCE_PROPERTY(Ebsd::RefFrameZDir, RefFrameZDir)
+    /* Parse several files concurrently while a single thread writes the slices in order */
+    DREAM3D_INSTANCE_PROPERTY(bool, UseParallelImport)
+    /* Upper bound in MB on the memory held by parsed slices waiting to be written */
+    DREAM3D_INSTANCE_PROPERTY(int, ImportMemoryLimit)
 
     virtual void preflight();
 
@@ -46,6 +46,25 @@
 #include "DREAM3DLib/HDF5/H5DataArrayReader.h"
 #include "DREAM3DLib/DataArrays/StatsDataArray.h"
 
+// -----------------------------------------------------------------------------
+// Reads one of the flat link arrays. An empty mesh writes empty arrays, which
+// are not handed to HDF5 because there is no buffer to read them into
+// -----------------------------------------------------------------------------
+template<typename T>
+static herr_t readLinkArray(hid_t dcGid, const std::string &name, std::vector<T> &values)
+{
+  std::vector<hsize_t> dims;
+  H5T_class_t type_class;
+  size_t type_size = 0;
+  values.clear();
+  herr_t err = H5Lite::getDatasetInfo(dcGid, name, dims, type_class, type_size);
+  if (err < 0 || dims.empty() == true || dims[0] == 0)
+  {
+    return err;
+  }
+  return H5Lite::readVectorDataset(dcGid, name, values);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -411,7 +430,17 @@ int SurfaceMeshDataContainerReader::readMeshVertLinks(hid_t dcGid, bool prefligh
   std::vector<hsize_t> dims;
   H5T_class_t type_class;
   size_t type_size = 0;
-  err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshVertLinksName, dims, type_class, type_size);
+  // Older files store the links packed into a single byte array
+  bool packedLinks = false;
+  if (H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName) == true)
+  {
+    err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName, dims, type_class, type_size);
+  }
+  else
+  {
+    err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshVertLinksName, dims, type_class, type_size);
+    packedLinks = true;
+  }
   if (err < 0)
   {
     return err;
@@ -421,7 +450,7 @@ int SurfaceMeshDataContainerReader::readMeshVertLinks(hid_t dcGid, bool prefligh
     sm->setMeshVertLinks(meshVertLinks);
   }
 
-  if (false == preflight && type_size > 0)
+  if (false == preflight && type_size > 0 && true == packedLinks)
   {
     //Read the array into the buffer
     std::vector<uint8_t> buffer;
@@ -435,6 +464,30 @@ int SurfaceMeshDataContainerReader::readMeshVertLinks(hid_t dcGid, bool prefligh
     meshVertLinks->deserializeLinks(buffer, nVerts);
     sm->setMeshVertLinks(meshVertLinks);
   }
+  else if (false == preflight && type_size > 0)
+  {
+    std::vector<int64_t> offsets;
+    std::vector<int32_t> cells;
+    err = readLinkArray(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName, offsets);
+    if (err >= 0)
+    {
+      err = readLinkArray(dcGid, DREAM3D::HDF5::MeshVertLinksFacesName, cells);
+    }
+    // Links that were never generated are written as 2 empty arrays
+    if (offsets.empty() == true && cells.empty() == true) { offsets.assign(nVerts + 1, 0); }
+    if (err >= 0 && (offsets.size() != nVerts + 1 || offsets.back() != static_cast<int64_t>(cells.size())))
+    {
+      err = -1;
+    }
+    if (err < 0)
+    {
+      setErrorCondition(err);
+      notifyErrorMessage("Error Reading Vertex Links from Data file", getErrorCondition());
+      return err;
+    }
+    meshVertLinks->setLinks(offsets, cells);
+    sm->setMeshVertLinks(meshVertLinks);
+  }
 
   return err;
 }
@@ -504,7 +557,17 @@ int SurfaceMeshDataContainerReader::readMeshTriangleNeighborLists(hid_t dcGid, b
   std::vector<hsize_t> dims;
   H5T_class_t type_class;
   size_t type_size = 0;
-  err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshFaceNeighborLists, dims, type_class, type_size);
+  // Older files store the lists packed into a single byte array
+  bool packedLists = false;
+  if (H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets) == true)
+  {
+    err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets, dims, type_class, type_size);
+  }
+  else
+  {
+    err = H5Lite::getDatasetInfo(dcGid, DREAM3D::HDF5::MeshFaceNeighborLists, dims, type_class, type_size);
+    packedLists = true;
+  }
   if (err < 0)
   {
     return err;
@@ -514,7 +577,33 @@ int SurfaceMeshDataContainerReader::readMeshTriangleNeighborLists(hid_t dcGid, b
     sm->setMeshFaceNeighborLists(meshTriangleNeighbors);
   }
 
-  if(false == preflight && type_size > 0)
+  if(false == preflight && type_size > 0 && false == packedLists)
+  {
+    std::vector<int64_t> offsets;
+    std::vector<int32_t> cells;
+    err = readLinkArray(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets, offsets);
+    if (err >= 0)
+    {
+      err = readLinkArray(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsFaces, cells);
+    }
+    // Links that were never generated are written as 2 empty arrays
+    if (offsets.empty() == true && cells.empty() == true) { offsets.assign(nFaces + 1, 0); }
+    if (err >= 0 && (offsets.size() != nFaces + 1 || offsets.back() != static_cast<int64_t>(cells.size())))
+    {
+      err = -1;
+    }
+    if (err < 0)
+    {
+      setErrorCondition(err);
+      notifyErrorMessage("Error Reading Face Neighbor Links from Data file", getErrorCondition());
+    }
+    else
+    {
+      meshTriangleNeighbors->setLinks(offsets, cells);
+      sm->setMeshFaceNeighborLists(meshTriangleNeighbors);
+    }
+  }
+  else if(false == preflight && type_size > 0)
   {
     //Read the array into the buffer
     std::vector<uint8_t> buffer;
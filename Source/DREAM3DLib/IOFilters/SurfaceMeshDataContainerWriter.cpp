@@ -66,6 +66,19 @@ public:
    hid_t* gid;
 };
 
+// -----------------------------------------------------------------------------
+// Writes one of the flat link arrays. An empty array is still written so the
+// file always holds both the offsets and the list
+// -----------------------------------------------------------------------------
+template<typename T>
+static herr_t writeLinkArray(hid_t dcGid, const std::string &name, std::vector<T> &values)
+{
+  hsize_t dims[1] = { values.size() };
+  T empty = static_cast<T>(0);
+  T* data = (values.empty() ? &empty : &(values.front()));
+  return H5Lite::writePointerDataset(dcGid, name, 1, dims, data);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -73,6 +86,7 @@ SurfaceMeshDataContainerWriter::SurfaceMeshDataContainerWriter() :
   AbstractFilter(),
   m_HdfFileId(-1),
   m_WriteXdmfFile(false),
+  m_WriteChunkedData(false),
   m_XdmfPtr(NULL)
 {
   setupFilterParameters();
@@ -512,7 +526,15 @@ int SurfaceMeshDataContainerWriter::writeVertices(hid_t dcGid)
 
   DREAM3D::SurfaceMesh::Float_t* data = reinterpret_cast<DREAM3D::SurfaceMesh::Float_t*>(verticesPtr->GetPointer(0));
 
-  herr_t err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::VerticesName, rank, dims, data);
+  herr_t err = 0;
+  if (m_WriteChunkedData == true)
+  {
+    err = H5Lite::writePointerDatasetChunked(dcGid, DREAM3D::HDF5::VerticesName, rank, dims, data, m_ChunkedWriteOptions);
+  }
+  else
+  {
+    err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::VerticesName, rank, dims, data);
+  }
   if (err < 0) {
     setErrorCondition(err);
     notifyErrorMessage("Error Writing Vertex List to DREAM3D file", getErrorCondition());
@@ -536,36 +558,16 @@ int SurfaceMeshDataContainerWriter::writeMeshVertLinks(hid_t dcGid)
   {
     return -1;
   }
-
+  // The links are already stored as an offset for each vertex and the flat list
+  // of Face ids so write those 2 arrays as they are
   herr_t err = -1;
-  size_t total = 0;
-  size_t nVerts = verticesPtr->GetNumberOfTuples();
-  for(size_t v = 0; v < nVerts; ++v)
-  {
-    total += links->getNumberOfFaces(v);
-  }
-
-  size_t totalBytes = nVerts * sizeof(uint16_t) + total * sizeof(int32_t);
-
-  // Allocate a flat array to copy the data into
-  std::vector<uint8_t> buffer(totalBytes, 0);
-  uint8_t* bufPtr = &(buffer.front());
-  size_t offset = 0;
-
-  for(size_t v = 0; v < nVerts; ++v)
+  err = writeLinkArray(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName, links->getOffsets());
+  if (err < 0)
   {
-    uint16_t ncells = links->getNumberOfFaces(v);
-    int32_t* cells = links->getFaceListPointer(v);
-    ::memcpy(bufPtr + offset, &ncells, sizeof(uint16_t));
-    offset += sizeof(uint16_t);
-    ::memcpy(bufPtr + offset, cells, ncells*sizeof(int32_t) );
-    offset += ncells*sizeof(int32_t);
+    notifyErrorMessage("Error writing the Mesh Vert Links", -999);
+    return err;
   }
-
-  int32_t rank = 1;
-  hsize_t dims[1] = {totalBytes};
-
-  err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::MeshVertLinksName, rank, dims, bufPtr);
+  err = writeLinkArray(dcGid, DREAM3D::HDF5::MeshVertLinksFacesName, links->getCells());
   if (err < 0)
   {
     notifyErrorMessage("Error writing the Mesh Vert Links", -999);
@@ -613,7 +615,14 @@ int SurfaceMeshDataContainerWriter::writeVertexAttributeData(hid_t dcGid)
     ss << "Writing Cell Data '" << *iter << "' to HDF5 File" << std::endl;
     notifyStatusMessage(ss.str());
     IDataArray::Pointer array = sm->getVertexData(*iter);
-    err = array->writeH5Data(cellGroupId);
+    if (m_WriteChunkedData == true)
+    {
+      err = array->writeH5DataChunked(cellGroupId, m_ChunkedWriteOptions);
+    }
+    else
+    {
+      err = array->writeH5Data(cellGroupId);
+    }
     if(err < 0)
     {
       ss.str("");
@@ -647,36 +656,14 @@ int SurfaceMeshDataContainerWriter::writeMeshFaceNeighborLists(hid_t dcGid)
   {
     return -1;
   }
-
   herr_t err = -1;
-  size_t total = 0;
-  size_t nFaces = facesPtr->GetNumberOfTuples();
-  for(size_t v = 0; v < nFaces; ++v)
-  {
-    total += links->getNumberOfFaces(v);
-  }
-
-  size_t totalBytes = nFaces * sizeof(uint16_t) + total * sizeof(int32_t);
-
-  // Allocate a flat array to copy the data into
-  std::vector<uint8_t> buffer(totalBytes, 0);
-  uint8_t* bufPtr = &(buffer.front());
-  size_t offset = 0;
-
-  for(size_t v = 0; v < nFaces; ++v)
+  err = writeLinkArray(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets, links->getOffsets());
+  if (err < 0)
   {
-    uint16_t ncells = links->getNumberOfFaces(v);
-    int32_t* cells = links->getNeighborListPointer(v);
-    ::memcpy(bufPtr + offset, &ncells, sizeof(uint16_t));
-    offset += sizeof(uint16_t);
-    ::memcpy(bufPtr + offset, cells, ncells*sizeof(int32_t) );
-    offset += ncells*sizeof(int32_t);
+    notifyErrorMessage("Error writing the Mesh Face Neighbor Lists", -998);
+    return err;
   }
-
-  int32_t rank = 1;
-  hsize_t dims[1] = {totalBytes};
-
-  err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::MeshFaceNeighborLists, rank, dims, bufPtr);
+  err = writeLinkArray(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsFaces, links->getCells());
   if (err < 0)
   {
     notifyErrorMessage("Error writing the Mesh Face Neighbor Lists", -998);
@@ -703,7 +690,15 @@ int SurfaceMeshDataContainerWriter::writeFaces(hid_t dcGid)
 
   int32_t* data = reinterpret_cast<int32_t*>(facesPtr->GetPointer(0));
 
-  herr_t err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::FacesName, rank, dims, data);
+  herr_t err = 0;
+  if (m_WriteChunkedData == true)
+  {
+    err = H5Lite::writePointerDatasetChunked(dcGid, DREAM3D::HDF5::FacesName, rank, dims, data, m_ChunkedWriteOptions);
+  }
+  else
+  {
+    err = H5Lite::writePointerDataset(dcGid, DREAM3D::HDF5::FacesName, rank, dims, data);
+  }
   if (err < 0) {
     setErrorCondition(err);
     notifyErrorMessage("Error Writing Face List to DREAM3D file", getErrorCondition());
@@ -749,7 +744,14 @@ int SurfaceMeshDataContainerWriter::writeFaceAttributeData(hid_t dcGid)
     ss << "Writing Face Data '" << *iter << "' to HDF5 File" << std::endl;
     notifyStatusMessage(ss.str());
     IDataArray::Pointer array = sm->getFaceData(*iter);
-    err = array->writeH5Data(cellGroupId);
+    if (m_WriteChunkedData == true)
+    {
+      err = array->writeH5DataChunked(cellGroupId, m_ChunkedWriteOptions);
+    }
+    else
+    {
+      err = array->writeH5Data(cellGroupId);
+    }
     if(err < 0)
     {
       ss.str("");
@@ -813,7 +815,14 @@ int SurfaceMeshDataContainerWriter::writeEdgeAttributeData(hid_t dcGid)
     ss << "Writing Edge Data '" << *iter << "' to HDF5 File" << std::endl;
     notifyStatusMessage(ss.str());
     IDataArray::Pointer array = sm->getEdgeData(*iter);
-    err = array->writeH5Data(cellGroupId);
+    if (m_WriteChunkedData == true)
+    {
+      err = array->writeH5DataChunked(cellGroupId, m_ChunkedWriteOptions);
+    }
+    else
+    {
+      err = array->writeH5Data(cellGroupId);
+    }
     if(err < 0)
     {
       ss.str("");
@@ -39,6 +39,8 @@
 #include <sstream>
 #include <string>
 
+#include "H5Support/H5Lite.h"
+
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 #include "DREAM3DLib/DataArrays/IDataArray.h"
@@ -64,6 +66,10 @@ class DREAM3DLib_EXPORT SurfaceMeshDataContainerWriter : public AbstractFilter
     /* Place your input parameters here. You can use some of the DREAM3D Macros if you want to */
     DREAM3D_INSTANCE_PROPERTY(hid_t, HdfFileId)
     DREAM3D_INSTANCE_PROPERTY(bool, WriteXdmfFile)
+    /* If true the vertices, faces and attribute arrays are written with a
+     * chunked, optionally compressed, layout. */
+    DREAM3D_INSTANCE_PROPERTY(bool, WriteChunkedData)
+    DREAM3D_INSTANCE_PROPERTY(H5Lite::ChunkedWriteOptions, ChunkedWriteOptions)
 
     typedef std::list<std::string> NameListType;
 
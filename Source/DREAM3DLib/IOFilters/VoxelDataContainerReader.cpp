@@ -44,6 +44,7 @@
 #include "DREAM3DLib/HDF5/VTKH5Constants.h"
 #include "DREAM3DLib/HDF5/H5DataArrayReader.h"
 #include "DREAM3DLib/DataArrays/StatsDataArray.h"
+#include "DREAM3DLib/GenericFilters/RenumberGrains.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -57,7 +58,14 @@ VoxelDataContainerReader::VoxelDataContainerReader() :
   m_ReadCellData(true),
   m_ReadFieldData(true),
   m_ReadEnsembleData(true),
-  m_ReadAllArrays(false)
+  m_ReadAllArrays(false),
+  m_ReadSubVolume(false),
+  m_XMin(0),
+  m_YMin(0),
+  m_ZMin(0),
+  m_XMax(0),
+  m_YMax(0),
+  m_ZMax(0)
 {
   setupFilterParameters();
 }
@@ -273,6 +281,10 @@ int VoxelDataContainerReader::gatherData(bool preflight)
   { 1.0f, 1.0f, 1.0f };
   float origin[3] =
   { 0.0f, 0.0f, 0.0f };
+  int64_t fileDims[3] =
+  { 0, 0, 0 };
+  int64_t bounds[6] =
+  { 0, 0, 0, 0, 0, 0 };
   VoxelDataContainer* m = getVoxelDataContainer();
 
   if(m_HdfFileId < 0)
@@ -306,6 +318,33 @@ int VoxelDataContainerReader::gatherData(bool preflight)
       setErrorCondition(err);
       return -1;
     }
+    if (m_ReadSubVolume == true)
+    {
+      if (m_XMin < 0 || m_YMin < 0 || m_ZMin < 0
+          || m_XMax < m_XMin || m_YMax < m_YMin || m_ZMax < m_ZMin
+          || m_XMax >= volDims[0] || m_YMax >= volDims[1] || m_ZMax >= volDims[2])
+      {
+        ss.str("");
+        ss << "The sub-volume bounds must satisfy 0 <= Min <= Max < Dimension for each axis. The volume is "
+           << volDims[0] << " x " << volDims[1] << " x " << volDims[2];
+        err |= H5Gclose(dcGid);
+        setErrorCondition(-155);
+        addErrorMessage(getHumanLabel(), ss.str(), getErrorCondition());
+        return -1;
+      }
+      bounds[0] = m_XMin; bounds[1] = m_XMax;
+      bounds[2] = m_YMin; bounds[3] = m_YMax;
+      bounds[4] = m_ZMin; bounds[5] = m_ZMax;
+      fileDims[0] = volDims[0];
+      fileDims[1] = volDims[1];
+      fileDims[2] = volDims[2];
+      volDims[0] = m_XMax - m_XMin + 1;
+      volDims[1] = m_YMax - m_YMin + 1;
+      volDims[2] = m_ZMax - m_ZMin + 1;
+      origin[0] = origin[0] + m_XMin * spacing[0];
+      origin[1] = origin[1] + m_YMin * spacing[1];
+      origin[2] = origin[2] + m_ZMin * spacing[2];
+    }
     m->setDimensions(volDims[0], volDims[1], volDims[2]); // We use this signature so the compiler will cast the value to the proper int type
     m->setResolution(spacing);
     m->setOrigin(origin);
@@ -350,7 +389,14 @@ int VoxelDataContainerReader::gatherData(bool preflight)
   if(m_ReadCellData == true)
   {
     std::vector<std::string> readNames;
-    err |= readGroupsData(dcGid, H5_CELL_DATA_GROUP_NAME, preflight, readNames, m_CellArraysToRead);
+    if (m_ReadSubVolume == true)
+    {
+      err |= readGroupsData(dcGid, H5_CELL_DATA_GROUP_NAME, preflight, readNames, m_CellArraysToRead, fileDims, bounds);
+    }
+    else
+    {
+      err |= readGroupsData(dcGid, H5_CELL_DATA_GROUP_NAME, preflight, readNames, m_CellArraysToRead);
+    }
     if(err < 0)
     {
       err |= H5Gclose(dcGid);
@@ -385,16 +431,81 @@ int VoxelDataContainerReader::gatherData(bool preflight)
 
   err |= H5Gclose(dcGid);
 
+  if (m_ReadSubVolume == true && preflight == false && m_ReadCellData == true && m_ReadFieldData == true)
+  {
+    err |= removeUnreferencedFields();
+  }
+
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int VoxelDataContainerReader::removeUnreferencedFields()
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+  Int32ArrayType* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get());
+  size_t totalFields = m->getNumFieldTuples();
+  if (NULL == grainIds || totalFields == 0)
+  {
+    return 0;
+  }
+
+  // RenumberGrains works from the Active array so create one if the file did not have it
+  bool createdActive = false;
+  BoolArrayType* active = BoolArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::Active).get());
+  if (NULL == active)
+  {
+    BoolArrayType::Pointer activePtr = BoolArrayType::CreateArray(totalFields, DREAM3D::FieldData::Active);
+    m->addFieldData(DREAM3D::FieldData::Active, activePtr);
+    active = activePtr.get();
+    createdActive = true;
+  }
+  active->initializeWithValues(false);
+
+  int32_t* ids = grainIds->GetPointer(0);
+  int64_t totalPoints = m->getTotalPoints();
+  for (int64_t i = 0; i < totalPoints; ++i)
+  {
+    if (ids[i] > 0 && static_cast<size_t>(ids[i]) < totalFields)
+    {
+      active->SetValue(ids[i], true);
+    }
+  }
+
+  RenumberGrains::Pointer renum = RenumberGrains::New();
+  renum->setVoxelDataContainer(m);
+  renum->setObservers(getObservers());
+  renum->setMessagePrefix(getMessagePrefix());
+  renum->execute();
+  if (renum->getErrorCondition() < 0)
+  {
+    setErrorCondition(renum->getErrorCondition());
+    addErrorMessages(renum->getPipelineMessages());
+    return -1;
+  }
+  if (createdActive == true)
+  {
+    m->removeFieldData(DREAM3D::FieldData::Active);
+  }
+  else
+  {
+    // The surviving Fields are all referenced by the sub-volume
+    BoolArrayType* renumbered = BoolArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::Active).get());
+    if (NULL != renumbered) { renumbered->initializeWithValues(true); }
+  }
+  return 0;
+}
+
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 int VoxelDataContainerReader::readGroupsData(hid_t dcGid, const std::string &groupName, bool preflight,
                                                 std::vector<std::string> &namesRead,
-                                                std::set<std::string> &namesToRead)
+                                                std::set<std::string> &namesToRead,
+                                                const int64_t* volDims, const int64_t* bounds)
 {
   std::stringstream ss;
   int err = 0;
@@ -423,7 +534,21 @@ int VoxelDataContainerReader::readGroupsData(hid_t dcGid, const std::string &gro
     //   std::cout << groupName << " Array: " << *iter << " with C++ ClassType of " << classType << std::endl;
     IDataArray::Pointer dPtr = IDataArray::NullPointer();
 
-    if(classType.find("DataArray") == 0)
+    if(NULL != volDims && NULL != bounds)
+    {
+      // Only arrays with one fixed size tuple per Cell can be cut down to a sub-volume
+      if(classType.find("DataArray") == 0)
+      {
+        dPtr = H5DataArrayReader::readIDataArraySubVolume(gid, *iter, volDims, bounds, preflight);
+      }
+      else
+      {
+        ss.str("");
+        ss << "Array '" << *iter << "' can not be read as a sub-volume and was skipped";
+        addWarningMessage(getHumanLabel(), ss.str(), -156);
+      }
+    }
+    else if(classType.find("DataArray") == 0)
     {
       dPtr = H5DataArrayReader::readIDataArray(gid, *iter, preflight);
     }
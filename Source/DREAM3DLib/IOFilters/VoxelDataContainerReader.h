@@ -79,6 +79,17 @@ class DREAM3DLib_EXPORT VoxelDataContainerReader : public AbstractFilter
     DREAM3D_INSTANCE_PROPERTY(std::set<std::string>, EnsembleArraysToRead)
     DREAM3D_INSTANCE_PROPERTY(bool, ReadAllArrays)
 
+    /* If ReadSubVolume is true only the Cells inside the inclusive box
+     * [XMin, XMax] x [YMin, YMax] x [ZMin, ZMax] are read and the Field data
+     * is reduced to the Fields that are referenced inside that box. */
+    DREAM3D_INSTANCE_PROPERTY(bool, ReadSubVolume)
+    DREAM3D_INSTANCE_PROPERTY(int, XMin)
+    DREAM3D_INSTANCE_PROPERTY(int, YMin)
+    DREAM3D_INSTANCE_PROPERTY(int, ZMin)
+    DREAM3D_INSTANCE_PROPERTY(int, XMax)
+    DREAM3D_INSTANCE_PROPERTY(int, YMax)
+    DREAM3D_INSTANCE_PROPERTY(int, ZMax)
+
     typedef std::list<std::string> NameListType;
 
 
@@ -143,7 +154,9 @@ class DREAM3DLib_EXPORT VoxelDataContainerReader : public AbstractFilter
     int gatherData(bool preflight);
     int readGroupsData(hid_t dcGid, const std::string &groupName, bool preflight,
                        std::vector<std::string> &namesRead,
-                       std::set<std::string> &namesToRead);
+                       std::set<std::string> &namesToRead,
+                       const int64_t* volDims = NULL, const int64_t* bounds = NULL);
+    int removeUnreferencedFields();
     int gatherMetaData(hid_t dcId, int64_t volDims[3], float spacing[3], float origin[3]);
 
   private:
@@ -53,6 +53,7 @@ VoxelDataContainerWriter::VoxelDataContainerWriter() :
   AbstractFilter(),
   m_HdfFileId(-1),
   m_WriteXdmfFile(false),
+  m_WriteChunkedData(false),
   m_XdmfPtr(NULL)
 {
   setupFilterParameters();
@@ -554,6 +555,10 @@ int VoxelDataContainerWriter::writeCellData(hid_t dcGid)
     H5Gclose(dcGid); // Close the Data Container Group
     return err;
   }
+  // Chunks of Cell data hold whole XY slices so sub-volumes can be read back efficiently
+  H5Lite::ChunkedWriteOptions chunkOptions = m_ChunkedWriteOptions;
+  chunkOptions.ChunkDim0Multiple = static_cast<hsize_t>(volDims[0] * volDims[1]);
+
   NameListType names = m->getCellArrayNameList();
   for (NameListType::iterator iter = names.begin(); iter != names.end(); ++iter)
   {
@@ -561,7 +566,14 @@ int VoxelDataContainerWriter::writeCellData(hid_t dcGid)
     ss << "Writing Cell Data '" << *iter << "' to HDF5 File" << std::endl;
     notifyStatusMessage(ss.str());
     IDataArray::Pointer array = m->getCellData(*iter);
-    err = array->writeH5Data(cellGroupId);
+    if (m_WriteChunkedData == true)
+    {
+      err = array->writeH5DataChunked(cellGroupId, chunkOptions);
+    }
+    else
+    {
+      err = array->writeH5Data(cellGroupId);
+    }
     if(err < 0)
     {
       ss.str("");
@@ -655,7 +667,14 @@ int VoxelDataContainerWriter::writeFieldData(hid_t dcGid)
     }
     else if (NULL != array.get())
     {
-      err = array->writeH5Data(fieldGroupId);
+      if (m_WriteChunkedData == true)
+      {
+        err = array->writeH5DataChunked(fieldGroupId, m_ChunkedWriteOptions);
+      }
+      else
+      {
+        err = array->writeH5Data(fieldGroupId);
+      }
       if(err < 0)
       {
         ss.str("");
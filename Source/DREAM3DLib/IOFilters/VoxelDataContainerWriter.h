@@ -42,6 +42,8 @@
 #include <hdf5.h>
 
 
+#include "H5Support/H5Lite.h"
+
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 #include "DREAM3DLib/DataArrays/IDataArray.h"
@@ -68,6 +70,10 @@ class DREAM3DLib_EXPORT VoxelDataContainerWriter : public AbstractFilter
     /* Place your input parameters here. You can use some of the DREAM3D Macros if you want to */
     DREAM3D_INSTANCE_PROPERTY(hid_t, HdfFileId)
     DREAM3D_INSTANCE_PROPERTY(bool, WriteXdmfFile)
+    /* If true the Cell and Field arrays are written with a chunked, optionally
+     * compressed, layout. Cell chunks always hold whole XY slices. */
+    DREAM3D_INSTANCE_PROPERTY(bool, WriteChunkedData)
+    DREAM3D_INSTANCE_PROPERTY(H5Lite::ChunkedWriteOptions, ChunkedWriteOptions)
 
     typedef std::list<std::string> NameListType;
 
@@ -41,6 +41,7 @@
 // to expose some of the constants needed below
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Math/OrientationMath.h"
+#include "DREAM3DLib/OrientationOps/MisoQuatBatch.hpp"
 #include "DREAM3DLib/Common/ModifiedLambertProjection.h"
 #include "DREAM3DLib/Utilities/ImageUtilities.h"
 #include "DREAM3DLib/Utilities/ColorTable.h"
@@ -218,6 +219,14 @@ float CubicLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float
   return _calcMisoQuat(CubicLowQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicLowOps::getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+{
+  MisoQuatBatch<k_NumSymQuats>::calculate(CubicLowQuatSym, q1, q2, n, angles, axes);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -369,7 +378,7 @@ int CubicLowOps::getMisoBin(float r1, float r2, float r3)
   return _calcMisoBin(dim, bins, step, r1, r2, r3);
 }
 
-void CubicLowOps::determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3)
+void CubicLowOps::determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3)
 {
   float init[3];
   float step[3];
@@ -386,13 +395,13 @@ void CubicLowOps::determineEulerAngles(int choose, float& synea1, float& synea2,
   phi[1] = static_cast<float>((choose / 36) % 36);
   phi[2] = static_cast<float>(choose / (36 * 36));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getODFFZRod(r1, r2, r3);
   OrientationMath::RodtoEuler(r1, r2, r3, synea1, synea2, synea3);
 }
 
-void CubicLowOps::determineRodriguesVector(int choose, float& r1, float& r2, float& r3)
+void CubicLowOps::determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3)
 {
   float init[3];
   float step[3];
@@ -408,7 +417,7 @@ void CubicLowOps::determineRodriguesVector(int choose, float& r1, float& r2, flo
   phi[1] = static_cast<float>((choose / 36) % 36);
   phi[2] = static_cast<float>(choose / (36 * 36));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getMDFFZRod(r1, r2, r3);
 }
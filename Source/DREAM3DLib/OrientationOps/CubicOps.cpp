@@ -37,6 +37,7 @@
 // Include this FIRST because there is a needed define for some compiles
 // to expose some of the constants needed below
 #include <limits>
+#include <algorithm>
 
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Math/OrientationMath.h"
@@ -295,6 +296,71 @@ CubicOps::~CubicOps()
 {
 }
 
+// -----------------------------------------------------------------------------
+// Finishes the cubic misorientation once the absolute values of the components
+// of the misorientation quaternion have been sorted in ascending order.
+// -----------------------------------------------------------------------------
+static inline float cubicMisoQuatFromSorted(const QuatF& qco, float& n1, float& n2, float& n3)
+{
+  float wmin = qco.w;
+  int type = 1;
+  float sin_wmin_over_2 = 0.0;
+  if (((qco.z + qco.w) / (DREAM3D::Constants::k_Sqrt2)) > wmin)
+  {
+    wmin = ((qco.z + qco.w) / (DREAM3D::Constants::k_Sqrt2));
+    type = 2;
+  }
+  if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
+  {
+    wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
+    type = 3;
+  }
+  if (wmin < -1.0)
+  {
+    //  wmin = -1.0;
+    wmin = DREAM3D::Constants::k_ACosNeg1;
+    sin_wmin_over_2 = sinf(wmin);
+  }
+  else if (wmin > 1.0)
+  {
+    //   wmin = 1.0;
+    wmin = DREAM3D::Constants::k_ACos1;
+    sin_wmin_over_2 = sinf(wmin);
+  }
+  else
+  {
+    wmin = acos(wmin);
+    sin_wmin_over_2 = sinf(wmin);
+  }
+
+  if(type == 1)
+  {
+    n1 = qco.x / sin_wmin_over_2;
+    n2 = qco.y / sin_wmin_over_2;
+    n3 = qco.z / sin_wmin_over_2;
+  }
+  if(type == 2)
+  {
+    n1 = ((qco.x - qco.y) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
+    n2 = ((qco.x + qco.y) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
+    n3 = ((qco.z - qco.w) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
+  }
+  if(type == 3)
+  {
+    n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+    n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+    n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
+  }
+  float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+  n1 = n1 / denom;
+  n2 = n2 / denom;
+  n3 = n3 / denom;
+  if(denom == 0) { n1 = 0.0, n2 = 0.0, n3 = 1.0; }
+  if(wmin == 0) { n1 = 0.0, n2 = 0.0, n3 = 1.0; }
+  wmin = 2.0f * wmin;
+  return wmin;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -306,6 +372,69 @@ float CubicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n
   return _calcMisoQuat(CubicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+{
+  // The cubic misorientation has a closed form that only needs the absolute
+  // values of the misorientation quaternion in ascending order. The sort is done
+  // with a min/max network over blocks of pairs so it vectorizes.
+  static const size_t BlockSize = 64;
+  float a[4][BlockSize];
+  QuatF qc;
+  QuatF qco;
+  QuatF q2inv;
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+  for (size_t start = 0; start < n; start += BlockSize)
+  {
+    size_t count = n - start;
+    if (count > BlockSize) { count = BlockSize; }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      QuaternionMathF::Copy(q2[start + i], q2inv);
+      QuaternionMathF::Conjugate(q2inv);
+      QuaternionMathF::Multiply(q2inv, q1[start + i], qc);
+      QuaternionMathF::ElementWiseAbs(qc);
+      a[0][i] = qc.x;
+      a[1][i] = qc.y;
+      a[2][i] = qc.z;
+      a[3][i] = qc.w;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      float lo01 = std::min(a[0][i], a[1][i]);
+      float hi01 = std::max(a[0][i], a[1][i]);
+      float lo23 = std::min(a[2][i], a[3][i]);
+      float hi23 = std::max(a[2][i], a[3][i]);
+      float mid1 = std::max(lo01, lo23);
+      float mid2 = std::min(hi01, hi23);
+      a[0][i] = std::min(lo01, lo23);
+      a[1][i] = std::min(mid1, mid2);
+      a[2][i] = std::max(mid1, mid2);
+      a[3][i] = std::max(hi01, hi23);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      qco.x = a[0][i];
+      qco.y = a[1][i];
+      qco.z = a[2][i];
+      qco.w = a[3][i];
+      angles[start + i] = cubicMisoQuatFromSorted(qco, n1, n2, n3);
+      if (NULL != axes)
+      {
+        axes[3 * (start + i)] = n1;
+        axes[3 * (start + i) + 1] = n2;
+        axes[3 * (start + i) + 2] = n3;
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -313,13 +442,9 @@ float CubicOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
                               QuatF& q1, QuatF& q2,
                               float& n1, float& n2, float& n3)
 {
-  float wmin = 9999999.0f; //,na,nb,nc;
   QuatF qco;
   QuatF qc;
   QuatF q2inv;
-  int type = 1;
-  float sin_wmin_over_2 = 0.0;
-  //  float _1, _2,  _6;
 
   QuaternionMathF::Copy(q2, q2inv);
   QuaternionMathF::Conjugate(q2inv);
@@ -431,62 +556,7 @@ float CubicOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
       else { qco.z = qc.y, qco.w = qc.x; }
     }
   }
-  wmin = qco.w;
-  if (((qco.z + qco.w) / (DREAM3D::Constants::k_Sqrt2)) > wmin)
-  {
-    wmin = ((qco.z + qco.w) / (DREAM3D::Constants::k_Sqrt2));
-    type = 2;
-  }
-  if (((qco.x + qco.y + qco.z + qco.w) / 2) > wmin)
-  {
-    wmin = ((qco.x + qco.y + qco.z + qco.w) / 2);
-    type = 3;
-  }
-  if (wmin < -1.0)
-  {
-    //  wmin = -1.0;
-    wmin = DREAM3D::Constants::k_ACosNeg1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else if (wmin > 1.0)
-  {
-    //   wmin = 1.0;
-    wmin = DREAM3D::Constants::k_ACos1;
-    sin_wmin_over_2 = sinf(wmin);
-  }
-  else
-  {
-    wmin = acos(wmin);
-    sin_wmin_over_2 = sinf(wmin);
-  }
-
-  if(type == 1)
-  {
-    n1 = qco.x / sin_wmin_over_2;
-    n2 = qco.y / sin_wmin_over_2;
-    n3 = qco.z / sin_wmin_over_2;
-  }
-  if(type == 2)
-  {
-    n1 = ((qco.x - qco.y) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
-    n3 = ((qco.z - qco.w) / (DREAM3D::Constants::k_Sqrt2)) / sin_wmin_over_2;
-  }
-  if(type == 3)
-  {
-    n1 = ((qco.x - qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n2 = ((qco.x + qco.y - qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-    n3 = ((-qco.x + qco.y + qco.z - qco.w) / (2.0f)) / sin_wmin_over_2;
-  }
-  float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
-  n1 = n1 / denom;
-  n2 = n2 / denom;
-  n3 = n3 / denom;
-  if(denom == 0) { n1 = 0.0, n2 = 0.0, n3 = 1.0; }
-  if(wmin == 0) { n1 = 0.0, n2 = 0.0, n3 = 1.0; }
-  wmin = 2.0f * wmin;
-  return wmin;
-
+  return cubicMisoQuatFromSorted(qco, n1, n2, n3);
 }
 
 void CubicOps::getODFFZRod(float& r1, float& r2, float& r3)
@@ -592,7 +662,7 @@ int CubicOps::getMisoBin(float r1, float r2, float r3)
   return _calcMisoBin(dim, bins, step, r1, r2, r3);
 }
 
-void CubicOps::determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3)
+void CubicOps::determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3)
 {
   float init[3];
   float step[3];
@@ -609,13 +679,13 @@ void CubicOps::determineEulerAngles(int choose, float& synea1, float& synea2, fl
   phi[1] = static_cast<float>((choose / 18) % 18);
   phi[2] = static_cast<float>(choose / (18 * 18));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getODFFZRod(r1, r2, r3);
   OrientationMath::RodtoEuler(r1, r2, r3, synea1, synea2, synea3);
 }
 
-void CubicOps::determineRodriguesVector(int choose, float& r1, float& r2, float& r3)
+void CubicOps::determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3)
 {
   float init[3];
   float step[3];
@@ -631,7 +701,7 @@ void CubicOps::determineRodriguesVector(int choose, float& r1, float& r2, float&
   phi[1] = static_cast<float>((choose / 18) % 18);
   phi[2] = static_cast<float>(choose / (18 * 18));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getMDFFZRod(r1, r2, r3);
 }
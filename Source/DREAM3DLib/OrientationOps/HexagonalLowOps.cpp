@@ -41,6 +41,7 @@
 // to expose some of the constants needed below
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Math/OrientationMath.h"
+#include "DREAM3DLib/OrientationOps/MisoQuatBatch.hpp"
 #include "DREAM3DLib/Common/ModifiedLambertProjection.h"
 #include "DREAM3DLib/Utilities/ImageUtilities.h"
 #include "DREAM3DLib/Utilities/ColorTable.h"
@@ -204,6 +205,14 @@ float HexagonalLowOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, f
   return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void HexagonalLowOps::getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+{
+  MisoQuatBatch<k_NumSymQuats>::calculate(HexQuatSym, q1, q2, n, angles, axes);
+}
+
 void HexagonalLowOps::getQuatSymOp(int i, QuatF& q)
 {
   QuaternionMathF::Copy(HexQuatSym[i], q);
@@ -308,7 +317,7 @@ int HexagonalLowOps::getMisoBin(float r1, float r2, float r3)
 }
 
 
-void HexagonalLowOps::determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3)
+void HexagonalLowOps::determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3)
 {
   float init[3];
   float step[3];
@@ -325,14 +334,14 @@ void HexagonalLowOps::determineEulerAngles(int choose, float& synea1, float& syn
   phi[1] = static_cast<float>((choose / 72) % 72);
   phi[2] = static_cast<float>(choose / (72 * 72));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getODFFZRod(r1, r2, r3);
   OrientationMath::RodtoEuler(r1, r2, r3, synea1, synea2, synea3);
 }
 
 
-void HexagonalLowOps::determineRodriguesVector( int choose, float& r1, float& r2, float& r3)
+void HexagonalLowOps::determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3)
 {
   float init[3];
   float step[3];
@@ -348,7 +357,7 @@ void HexagonalLowOps::determineRodriguesVector( int choose, float& r1, float& r2
   phi[1] = static_cast<float>((choose / 72) % 72);
   phi[2] = static_cast<float>(choose / (72 * 72));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getMDFFZRod(r1, r2, r3);
 }
@@ -74,6 +74,7 @@ class DREAM3DLib_EXPORT HexagonalOps : public OrientationOps
     std::string getSymmetryName() { return "Hexagonal-High 6/mmm"; }
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
@@ -83,8 +84,8 @@ class DREAM3DLib_EXPORT HexagonalOps : public OrientationOps
     virtual void getFZQuat(QuatF& qr);
     virtual int getMisoBin(float r1, float r2, float r3);
     virtual bool inUnitTriangle(float eta, float chi);
-    virtual void determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3);
-    virtual void determineRodriguesVector(int choose, float& r1, float& r2, float& r3);
+    virtual void determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3);
+    virtual void determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3);
     virtual int getOdfBin(float r1, float r2, float r3);
     virtual void getSchmidFactorAndSS(float loadx, float loady, float loadz, float& schmidfactor, int& slipsys);
     virtual void getmPrime(QuatF& q1, QuatF& q2, float LD[3], float& mPrime);
@@ -0,0 +1,184 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Michael A. Groeber (US Air Force Research Laboratory)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _MisoQuatBatch_H_
+#define _MisoQuatBatch_H_
+
+#include <cmath>
+#include <cstddef>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Math/QuaternionMath.hpp"
+#include "DREAM3DLib/Math/OrientationMath.h"
+
+/*
+ * @class MisoQuatBatch MisoQuatBatch.hpp DREAM3DLib/OrientationOps/MisoQuatBatch.hpp
+ * @brief Computes the misorientations of many pairs of quaternions for a Laue class
+ * with NumSym symmetry operators. The smallest misorientation angle belongs to the
+ * operator that gives the largest |w| component of the product, so the loop over the
+ * operators only needs a 4 term dot product per pair. That loop runs over small
+ * structure of arrays blocks without branches so the compiler can vectorize it.
+ * The angle and axis are then computed, with the same operations _calcMisoQuat() uses,
+ * for the operators whose |w| is within rounding of the largest one, taking the first
+ * smallest angle in operator order. The results are the same as getMisoQuat().
+ * @version 1.0
+ */
+template<int NumSym>
+class MisoQuatBatch
+{
+  public:
+    enum { BlockSize = 64 };
+
+    /**
+     * @brief Operators whose |w| is this close to the largest one are evaluated in full
+     * because rounding in the angle calculation can still make them the smallest angle.
+     */
+    static float TieTolerance() { return 1.0e-5f; }
+
+    /**
+     * @brief calculate Computes the misorientation between q1[i] and q2[i] for i in [0, n)
+     * @param quatsym The first NumSym entries are the symmetry operators of the Laue class
+     * @param q1 Array of n quaternions
+     * @param q2 Array of n quaternions
+     * @param n Number of pairs
+     * @param angles [output] n misorientation angles in radians
+     * @param axes [output] 3 * n axis components. May be NULL if only the angles are needed.
+     */
+    static void calculate(const QuatF* quatsym, const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+    {
+      QuatF qr[BlockSize];
+      float rx[BlockSize];
+      float ry[BlockSize];
+      float rz[BlockSize];
+      float rw[BlockSize];
+      float best[BlockSize];
+      float axis[3];
+      float candidate[3];
+      QuatF q2inv;
+
+      for (size_t start = 0; start < n; start += BlockSize)
+      {
+        size_t count = n - start;
+        if (count > BlockSize) { count = BlockSize; }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          QuaternionMathF::Copy(q2[start + i], q2inv);
+          QuaternionMathF::Conjugate(q2inv);
+          QuaternionMathF::Multiply(q2inv, q1[start + i], qr[i]);
+          rx[i] = qr[i].x;
+          ry[i] = qr[i].y;
+          rz[i] = qr[i].z;
+          rw[i] = qr[i].w;
+          best[i] = -1.0f;
+        }
+
+        for (int s = 0; s < NumSym; ++s)
+        {
+          const float sx = quatsym[s].x;
+          const float sy = quatsym[s].y;
+          const float sz = quatsym[s].z;
+          const float sw = quatsym[s].w;
+          for (size_t i = 0; i < count; ++i)
+          {
+            // The w component of qr * quatsym[s]
+            float w = fabsf(sw * rw[i] - sx * rx[i] - sy * ry[i] - sz * rz[i]);
+            best[i] = (w > best[i]) ? w : best[i];
+          }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          const float cutoff = best[i] - TieTolerance();
+          float wmin = 9999999.0f;
+          axis[0] = 0.0f;
+          axis[1] = 0.0f;
+          axis[2] = 1.0f;
+          for (int s = 0; s < NumSym; ++s)
+          {
+            float w = fabsf(quatsym[s].w * rw[i] - quatsym[s].x * rx[i] - quatsym[s].y * ry[i] - quatsym[s].z * rz[i]);
+            if (w < cutoff) { continue; }
+            w = axisAngle(qr[i], quatsym[s], candidate);
+            if (w < wmin)
+            {
+              wmin = w;
+              axis[0] = candidate[0];
+              axis[1] = candidate[1];
+              axis[2] = candidate[2];
+            }
+          }
+          angles[start + i] = wmin;
+          if (NULL != axes)
+          {
+            axes[3 * (start + i)] = axis[0];
+            axes[3 * (start + i) + 1] = axis[1];
+            axes[3 * (start + i) + 2] = axis[2];
+          }
+        }
+      }
+    }
+
+  private:
+    static float axisAngle(QuatF& qr, const QuatF& sym, float* axis)
+    {
+      QuatF qc;
+      float w = 0.0f;
+      float n1 = 0.0f;
+      float n2 = 0.0f;
+      float n3 = 0.0f;
+      QuaternionMathF::Multiply(qr, sym, qc);
+      if (qc.w < -1)
+      {
+        qc.w = -1;
+      }
+      else if (qc.w > 1)
+      {
+        qc.w = 1;
+      }
+      OrientationMath::QuattoAxisAngle(qc, w, n1, n2, n3);
+      if (w > DREAM3D::Constants::k_Pi)
+      {
+        w = DREAM3D::Constants::k_2Pi - w;
+      }
+      float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+      axis[0] = n1 / denom;
+      axis[1] = n2 / denom;
+      axis[2] = n3 / denom;
+      if(denom == 0 || w == 0) { axis[0] = 0.0, axis[1] = 0.0, axis[2] = 1.0; }
+      return w;
+    }
+
+    MisoQuatBatch(); // Not Implemented
+};
+
+#endif /* _MisoQuatBatch_H_ */
@@ -41,6 +41,7 @@
 // to expose some of the constants needed below
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Math/OrientationMath.h"
+#include "DREAM3DLib/OrientationOps/MisoQuatBatch.hpp"
 #include "DREAM3DLib/Common/ModifiedLambertProjection.h"
 #include "DREAM3DLib/Utilities/ImageUtilities.h"
 #include "DREAM3DLib/Utilities/ColorTable.h"
@@ -122,6 +123,14 @@ float MonoclinicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, flo
   return _calcMisoQuat(MonoclinicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MonoclinicOps::getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+{
+  MisoQuatBatch<k_NumSymQuats>::calculate(MonoclinicQuatSym, q1, q2, n, angles, axes);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -249,7 +258,7 @@ int MonoclinicOps::getMisoBin(float r1, float r2, float r3)
   return _calcMisoBin(dim, bins, step, r1, r2, r3);
 }
 
-void MonoclinicOps::determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3)
+void MonoclinicOps::determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3)
 {
   float init[3];
   float step[3];
@@ -266,13 +275,13 @@ void MonoclinicOps::determineEulerAngles(int choose, float& synea1, float& synea
   phi[1] = static_cast<float>((choose / 72) % 36);
   phi[2] = static_cast<float>(choose / (72 * 36));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getODFFZRod(r1, r2, r3);
   OrientationMath::RodtoEuler(r1, r2, r3, synea1, synea2, synea3);
 }
 
-void MonoclinicOps::determineRodriguesVector(int choose, float& r1, float& r2, float& r3)
+void MonoclinicOps::determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3)
 {
   float init[3];
   float step[3];
@@ -288,7 +297,7 @@ void MonoclinicOps::determineRodriguesVector(int choose, float& r1, float& r2, f
   phi[1] = static_cast<float>((choose / 72) % 36);
   phi[2] = static_cast<float>(choose / (72 * 36));
 
-  _calcDetermineHomochoricValues(init, step, phi, choose, r1, r2, r3);
+  _calcDetermineHomochoricValues(rg, init, step, phi, choose, r1, r2, r3);
   OrientationMath::HomochorictoRod(r1, r2, r3);
   getMDFFZRod(r1, r2, r3);
 }
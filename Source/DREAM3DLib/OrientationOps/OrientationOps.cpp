@@ -132,6 +132,28 @@ float OrientationOps::_calcMisoQuat(const QuatF quatsym[24], int numsym,
   return wmin;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OrientationOps::getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes)
+{
+  QuatF qa;
+  QuatF qb;
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+  for (size_t i = 0; i < n; ++i)
+  {
+    QuaternionMathF::Copy(q1[i], qa);
+    QuaternionMathF::Copy(q2[i], qb);
+    angles[i] = getMisoQuat(qa, qb, n1, n2, n3);
+    if (NULL != axes)
+    {
+      axes[3 * i] = n1;
+      axes[3 * i + 1] = n2;
+      axes[3 * i + 2] = n3;
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -242,11 +264,10 @@ int OrientationOps::_calcMisoBin(float dim[3], float bins[3], float step[3], flo
   return (static_cast<int>( (bins[0] * bins[1] * miso3bin) + (bins[0] * miso2bin) + miso1bin ));
 }
 
-void OrientationOps::_calcDetermineHomochoricValues(float init[3], float step[3], float phi[3], int choose, float& r1, float& r2, float& r3)
+void OrientationOps::_calcDetermineHomochoricValues(DREAM3DRandom& rg, float init[3], float step[3], float phi[3], int choose, float& r1, float& r2, float& r3)
 {
   float random;
 
-  DREAM3D_RANDOMNG_NEW()
   random = static_cast<float>( rg.genrand_res53() );
   r1 = (step[0] * phi[0]) + (step[0] * random) - (init[0]);
   random = static_cast<float>( rg.genrand_res53() );
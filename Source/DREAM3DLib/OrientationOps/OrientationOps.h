@@ -114,6 +114,18 @@ class DREAM3DLib_EXPORT OrientationOps
      */
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3) = 0;
 
+    /**
+     * @brief getMisoQuatBatch Finds the misorientations of n pairs of quaternions. The
+     * subclasses implement this with a kernel specialized for their symmetry operators
+     * that is much faster than calling getMisoQuat() for each pair.
+     * @param q1 Array of n quaternions
+     * @param q2 Array of n quaternions
+     * @param n Number of pairs
+     * @param angles [output] The n misorientation angles in radians
+     * @param axes [output] The 3 * n components of the misorientation axes. May be NULL.
+     */
+    virtual void getMisoQuatBatch(const QuatF* q1, const QuatF* q2, size_t n, float* angles, float* axes);
+
     /**
      * @brief getQuatSymOp Copies the symmetry operator at index i into q
      * @param i The index into the Symmetry operators array
@@ -127,8 +139,12 @@ class DREAM3DLib_EXPORT OrientationOps
     virtual void getNearestQuat(QuatF& q1, QuatF& q2) = 0;
     virtual int getMisoBin(float r1, float r2, float r3) = 0;
     virtual bool inUnitTriangle(float eta, float chi) = 0;
-    virtual void determineEulerAngles(int choose, float& synea1, float& synea2, float& synea3) = 0;
-    virtual void determineRodriguesVector(int choose, float& r1, float& r2, float& r3) = 0;
+    /**
+     * @brief determineEulerAngles Picks a random orientation inside the ODF bin 'choose'
+     * @param rg The generator to draw from. Callers that need repeatable picks pass a seeded generator.
+     */
+    virtual void determineEulerAngles(DREAM3DRandom& rg, int choose, float& synea1, float& synea2, float& synea3) = 0;
+    virtual void determineRodriguesVector(DREAM3DRandom& rg, int choose, float& r1, float& r2, float& r3) = 0;
     virtual int getOdfBin(float r1, float r2, float r3) = 0;
     virtual void getSchmidFactorAndSS(float loadx, float loady, float loadz, float& schmidfactor, int& slipsys) = 0;
     virtual void getmPrime(QuatF& q1, QuatF& q2, float LD[3], float& mPrime) = 0;
@@ -202,7 +218,7 @@ class DREAM3DLib_EXPORT OrientationOps
     void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
 
     int _calcMisoBin(float dim[3], float bins[3], float step[3], float r1, float r2, float r3);
-    void _calcDetermineHomochoricValues(float init[3], float step[3], float phi[3], int choose, float& r1, float& r2, float& r3);
+    void _calcDetermineHomochoricValues(DREAM3DRandom& rg, float init[3], float step[3], float phi[3], int choose, float& r1, float& r2, float& r3);
     int _calcODFBin(float dim[3], float bins[3], float step[3], float r1, float r2, float r3);
 
   private:
@@ -24,6 +24,7 @@ set(DREAM3DLib_OrientationOps_HDRS
   ${DREAM3DLib_SOURCE_DIR}/OrientationOps/TetragonalLowOps.h
   ${DREAM3DLib_SOURCE_DIR}/OrientationOps/TriclinicOps.h
   ${DREAM3DLib_SOURCE_DIR}/OrientationOps/MonoclinicOps.h
+  ${DREAM3DLib_SOURCE_DIR}/OrientationOps/MisoQuatBatch.hpp
 )
 set(DREAM3DLib_OrientationOps_SRCS
   ${DREAM3DLib_SOURCE_DIR}/OrientationOps/OrientationOps.cpp
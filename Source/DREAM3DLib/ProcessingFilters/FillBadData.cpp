@@ -37,7 +37,10 @@
 #include "FillBadData.h"
 
 
+#include <limits>
+
 #include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/CellDilationHelper.h"
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
@@ -57,7 +60,6 @@ AbstractFilter(),
 m_GrainIdsArrayName(DREAM3D::CellData::GrainIds),
 m_MinAllowedDefectSize(1),
 m_AlreadyChecked(NULL),
-m_Neighbors(NULL),
 m_GrainIds(NULL)
 {
   setupFilterParameters();
@@ -155,10 +157,6 @@ void FillBadData::execute()
   }
   setErrorCondition(0);
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->GetPointer(0);
-  neighborsPtr->initializeWithValues(-1);
-
   BoolArrayType::Pointer alreadCheckedPtr = BoolArrayType::CreateArray(totalPoints, "AlreadyChecked");
   m_AlreadyChecked = alreadCheckedPtr->GetPointer(0);
   alreadCheckedPtr->initializeWithZeros();
@@ -182,10 +180,7 @@ void FillBadData::execute()
   int good = 1;
   int neighbor;
   int index = 0;
-  float x, y, z;
   DimType column, row, plane;
-  int neighpoint;
-  size_t numgrains = m->getNumFieldTuples();
 
   int neighpoints[6];
   neighpoints[0] = static_cast<int>(-dims[0] * dims[1]);
@@ -249,84 +244,10 @@ void FillBadData::execute()
 		}
   }
 
-  int grainname, grain;
-  int current = 0;
-  int most = 0;
-
-  std::vector<int > n(numgrains + 1,0);
-  while (count != 0)
-  {
-    count = 0;
-    for (int i = 0; i < totalPoints; i++)
-    {
-      grainname = m_GrainIds[i];
-      if (grainname < 0)
-      {
-        count++;
-		current = 0;
-		most = 0;
-		x = static_cast<float>(i % dims[0]);
-        y = static_cast<float>((i / dims[0]) % dims[1]);
-        z = static_cast<float>(i / (dims[0] * dims[1]));
-        for (int j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighpoint = i + neighpoints[j];
-          if (j == 0 && z == 0) good = 0;
-          if (j == 5 && z == (dims[2] - 1)) good = 0;
-          if (j == 1 && y == 0) good = 0;
-          if (j == 4 && y == (dims[1] - 1)) good = 0;
-          if (j == 2 && x == 0) good = 0;
-          if (j == 3 && x == (dims[0] - 1)) good = 0;
-          if (good == 1)
-          {
-            grain = m_GrainIds[neighpoint];
-			if (grain > 0)
-            {
-				n[grain]++;
-				current = n[grain];
-				if (current > most)
-				{
-					most = current;
-					m_Neighbors[i] = neighpoint;
-				}
-			}
-		  }
-		}
-		for (int l = 0; l < 6; l++)
-		{
-		  good = 1;
-          neighpoint = i + neighpoints[l];
-		  if (l == 0 && z == 0) good = 0;
-		  if (l == 5 && z == (dims[2] - 1)) good = 0;
-		  if (l == 1 && y == 0) good = 0;
-		  if (l == 4 && y == (dims[1] - 1)) good = 0;
-		  if (l == 2 && x == 0) good = 0;
-		  if (l == 3 && x == (dims[0] - 1)) good = 0;
-		  if (good == 1)
-		  {
-			grain = m_GrainIds[neighpoint];
-			if(grain > 0) n[grain] = 0;
-		  }
-		}
-      }
-    }
-    std::list<std::string> voxelArrayNames = m->getCellArrayNameList();
-    for (int j = 0; j < totalPoints; j++)
-    {
-      grainname = m_GrainIds[j];
-      neighbor = m_Neighbors[j];
-      if (grainname < 0 && neighbor != -1 && m_GrainIds[neighbor] > 0)
-      {
-          for(std::list<std::string>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            std::string name = *iter;
-            IDataArray::Pointer p = m->getCellData(*iter);
-            p->CopyTuple(neighbor, j);
-          }
-      }
-    }
-  }
+  // Grow the Fields into the small defects (GrainIds < 0) one layer at a time. The
+  // large defects keep GrainId 0 and are left alone
+  CellDilationHelper helper(m, m_GrainIds, std::numeric_limits<int32_t>::min(), -1, 1);
+  helper.dilate(-1);
 
   // If there is an error set this to something negative and also set a message
  notifyStatusMessage("Filling Bad Data Complete");
@@ -95,7 +95,6 @@ class DREAM3DLib_EXPORT FillBadData : public AbstractFilter
 
   private:
     bool* m_AlreadyChecked;
-    int32_t* m_Neighbors;
 
     int32_t* m_GrainIds;
 
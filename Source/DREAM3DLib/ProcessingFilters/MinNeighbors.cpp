@@ -37,7 +37,10 @@
 #include "MinNeighbors.h"
 
 
+#include <limits>
+
 #include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/CellDilationHelper.h"
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
@@ -61,7 +64,6 @@ m_NumNeighborsArrayName(DREAM3D::FieldData::NumNeighbors),
 m_ActiveArrayName(DREAM3D::FieldData::Active),
 m_MinNumNeighbors(1),
 m_AlreadyChecked(NULL),
-m_Neighbors(NULL),
 m_GrainIds(NULL),
 m_NumNeighbors(NULL),
 m_Active(NULL)
@@ -186,10 +188,6 @@ void MinNeighbors::execute()
   }
   setErrorCondition(0);
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->GetPointer(0);
-  neighborsPtr->initializeWithZeros();
-
   BoolArrayType::Pointer alreadCheckedPtr = BoolArrayType::CreateArray(totalPoints, "AlreadyChecked");
   m_AlreadyChecked = alreadCheckedPtr->GetPointer(0);
   alreadCheckedPtr->initializeWithZeros();
@@ -220,131 +218,10 @@ void MinNeighbors::execute()
 void MinNeighbors::assign_badpoints()
 {
   VoxelDataContainer* m = getVoxelDataContainer();
-  int64_t totalPoints = m->getTotalPoints();
-  size_t udims[3] = {0,0,0};
-  m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->GetPointer(0);
-  neighborsPtr->initializeWithValues(-1);
-
-  std::vector<int > remove;
-  int good = 1;
-//  int neighbor;
-//  int index = 0;
-//  float x, y, z;
-  int current = 0;
-  int most = 0;
-//  int curgrain = 0;
- // DimType row, plane;
-  int neighpoint;
-  size_t numgrains = m->getNumFieldTuples();
-
-  int neighpoints[6];
-  neighpoints[0] = static_cast<int>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int>(-dims[0]);
-  neighpoints[2] = static_cast<int>(-1);
-  neighpoints[3] = static_cast<int>(1);
-  neighpoints[4] = static_cast<int>(dims[0]);
-  neighpoints[5] = static_cast<int>(dims[0] * dims[1]);
-  std::vector<int> currentvlist;
-
-  size_t counter = 1;
-  size_t count = 0;
-  int kstride, jstride;
-  int grainname, grain;
-  int neighbor;
-  std::vector<int > n(numgrains + 1,0);
-  while (counter != 0)
-  {
-    counter = 0;
-    for (int k = 0; k < dims[2]; k++)
-    {
-		kstride = static_cast<int>( dims[0]*dims[1]*k );
-	    for (int j = 0; j < dims[1]; j++)
-	    {
-			jstride = static_cast<int>( dims[0]*j );
-		    for (int i = 0; i < dims[0]; i++)
-		    {
-			  count = kstride+jstride+i;
-			  std::stringstream ss;
-			  grainname = m_GrainIds[count];
-			  if (grainname < 0)
-			  {
-			    counter++;
-				current = 0;
-				most = 0;
-				for (int l = 0; l < 6; l++)
-				{
-				  good = 1;
-				  neighpoint = static_cast<int>( count + neighpoints[l] );
-				  if (l == 0 && k == 0) good = 0;
-				  if (l == 5 && k == (dims[2] - 1)) good = 0;
-				  if (l == 1 && j == 0) good = 0;
-				  if (l == 4 && j == (dims[1] - 1)) good = 0;
-				  if (l == 2 && i == 0) good = 0;
-				  if (l == 3 && i == (dims[0] - 1)) good = 0;
-				  if (good == 1)
-				  {
-					grain = m_GrainIds[neighpoint];
-					if (grain >= 0)
-					{
-					  n[grain]++;
-					  current = n[grain];
-					  if (current > most)
-					  {
-						most = current;
-					    m_Neighbors[count] = neighpoint;
-					  }
-					}
-				  }
-				}
-				for (int l = 0; l < 6; l++)
-				{
-				  good = 1;
-				  neighpoint = static_cast<int>( count + neighpoints[l] );
-				  if (l == 0 && k == 0) good = 0;
-				  if (l == 5 && k == (dims[2] - 1)) good = 0;
-				  if (l == 1 && j == 0) good = 0;
-				  if (l == 4 && j == (dims[1] - 1)) good = 0;
-				  if (l == 2 && i == 0) good = 0;
-				  if (l == 3 && i == (dims[0] - 1)) good = 0;
-				  if (good == 1)
-				  {
-					grain = m_GrainIds[neighpoint];
-					if(grain >= 0) n[grain] = 0;
-				  }
-				}
-			}
-		  }
-		}
-	}
-    std::list<std::string> voxelArrayNames = m->getCellArrayNameList();
-    for (int j = 0; j < totalPoints; j++)
-    {
-      grainname = m_GrainIds[j];
-      neighbor = m_Neighbors[j];
-      if (grainname < 0 && neighbor >= 0 && m_GrainIds[neighbor] >= 0)
-      {
-          for(std::list<std::string>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            std::string name = *iter;
-            IDataArray::Pointer p = m->getCellData(*iter);
-            p->CopyTuple(neighbor, j);
-          }
-      }
-    }
-  }
+
+  // Grow the remaining Fields into the removed Cells (GrainIds < 0) one layer at a time
+  CellDilationHelper helper(m, m_GrainIds, std::numeric_limits<int32_t>::min(), -1, 0);
+  helper.dilate(-1);
 }
 
 
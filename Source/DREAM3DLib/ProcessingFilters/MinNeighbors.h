@@ -102,7 +102,6 @@ class DREAM3DLib_EXPORT MinNeighbors : public AbstractFilter
 
   private:
     bool* m_AlreadyChecked;
-    int32_t* m_Neighbors;
 
     int32_t* m_GrainIds;
     int32_t* m_NumNeighbors;
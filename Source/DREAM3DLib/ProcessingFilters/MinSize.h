@@ -105,7 +105,6 @@ class DREAM3DLib_EXPORT MinSize : public AbstractFilter
      *  fastest way to fix the crashing bugs in the subclass. Normally these variables would
      *  be declared private.
      */
-    int32_t* m_Neighbors;
     int32_t* m_GrainIds;
     bool* m_Active;
     std::vector<std::vector<int> > voxellists;
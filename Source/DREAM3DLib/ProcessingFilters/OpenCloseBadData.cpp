@@ -38,6 +38,7 @@
 
 
 #include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/CellDilationHelper.h"
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
@@ -57,7 +58,6 @@ AbstractFilter(),
 m_GrainIdsArrayName(DREAM3D::CellData::GrainIds),
 m_Direction(0),
 m_NumIterations(1),
-m_Neighbors(NULL),
 m_GrainIds(NULL)
 {
   setupFilterParameters();
@@ -169,138 +169,16 @@ void OpenCloseBadData::execute()
   }
   setErrorCondition(0);
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->GetPointer(0);
-  neighborsPtr->initializeWithValues(-1);
-
-  size_t udims[3] = {0,0,0};
-  m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-//  size_t count = 1;
-  int good = 1;
-//  int neighbor;
-//  int index = 0;
-//  float x, y, z;
-//  DimType row, plane;
-  int neighpoint;
-  size_t numgrains = m->getNumFieldTuples();
-
-  int neighpoints[6];
-  neighpoints[0] = static_cast<int>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int>(-dims[0]);
-  neighpoints[2] = static_cast<int>(-1);
-  neighpoints[3] = static_cast<int>(1);
-  neighpoints[4] = static_cast<int>(dims[0]);
-  neighpoints[5] = static_cast<int>(dims[0] * dims[1]);
-  std::vector<int> currentvlist;
-
-  size_t count = 0;
-  int kstride, jstride;
-  int grainname, grain;
-
-  int current;
-  int most;
-
-  std::vector<int > n(numgrains + 1,0);
-  for (int iteration = 0; iteration < m_NumIterations; iteration++)
+  // Each iteration either erodes the Fields into the bad data (GrainId 0) or grows them
+  // back by one Cell. Only the Cells between the two are visited
+  CellDilationHelper helper(m, m_GrainIds, 0, 0, 1);
+  if (m_Direction == 0)
   {
-    for (int k = 0; k < dims[2]; k++)
-    {
-    kstride = static_cast<int>( dims[0]*dims[1]*k );
-      for (int j = 0; j < dims[1]; j++)
-      {
-      jstride = static_cast<int>( dims[0]*j );
-        for (int i = 0; i < dims[0]; i++)
-        {
-        count = kstride+jstride+i;
-        std::stringstream ss;
-        grainname = m_GrainIds[count];
-        if (grainname == 0)
-        {
-			current = 0;
-			most = 0;
-			for (int l = 0; l < 6; l++)
-			{
-			  good = 1;
-			  neighpoint = static_cast<int>( count + neighpoints[l] );
-			  if (l == 0 && k == 0) good = 0;
-			  if (l == 5 && k == (dims[2] - 1)) good = 0;
-			  if (l == 1 && j == 0) good = 0;
-			  if (l == 4 && j == (dims[1] - 1)) good = 0;
-			  if (l == 2 && i == 0) good = 0;
-			  if (l == 3 && i == (dims[0] - 1)) good = 0;
-			  if (good == 1)
-			  {
-				  grain = m_GrainIds[neighpoint];
-				  if (m_Direction == 0 && grain > 0)
-				  {
-					m_Neighbors[neighpoint] = count;
-				  }
-				  if ((grain > 0 && m_Direction == 1))
-				  {
-					n[grain]++;
-					current = n[grain];
-					if (current > most)
-					{
-					  most = current;
-					  m_Neighbors[count] = neighpoint;
-					}
-				  }
-			  }
-			}
-			if (m_Direction == 1)
-			{
-			  for (int l = 0; l < 6; l++)
-			  {
-  				good = 1;
-				neighpoint = static_cast<int>( count + neighpoints[l] );
-				if (l == 0 && k == 0) good = 0;
-				if (l == 5 && k == (dims[2] - 1)) good = 0;
-				if (l == 1 && j == 0) good = 0;
-				if (l == 4 && j == (dims[1] - 1)) good = 0;
-				if (l == 2 && i == 0) good = 0;
-				if (l == 3 && i == (dims[0] - 1)) good = 0;
-				if (good == 1)
-				{
-					grain = m_GrainIds[neighpoint];
-					n[grain] = 0;
-				}
-			  }
-			}
-        }
-      }
-    }
-
-    }
-    std::list<std::string> voxelArrayNames = m->getCellArrayNameList();
-    for (int j = 0; j < totalPoints; j++)
-    {
-      int grainname = m_GrainIds[j];
-      int neighbor = m_Neighbors[j];
-      if (neighbor >= 0)
-      {
-        if ( (grainname == 0 && m_GrainIds[neighbor] > 0 && m_Direction == 1)
-            || (grainname > 0 && m_GrainIds[neighbor] == 0 && m_Direction == 0))
-        {
-            for(std::list<std::string>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              std::string name = *iter;
-              IDataArray::Pointer p = m->getCellData(*iter);
-              p->CopyTuple(neighbor, j);
-            }
-        }
-      }
-    }
+    helper.erode(m_NumIterations);
+  }
+  else if (m_Direction == 1)
+  {
+    helper.dilate(m_NumIterations);
   }
 
   // If there is an error set this to something negative and also set a message
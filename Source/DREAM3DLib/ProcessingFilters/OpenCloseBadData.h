@@ -99,8 +99,6 @@ class DREAM3DLib_EXPORT OpenCloseBadData : public AbstractFilter
 
 
   private:
-    int32_t* m_Neighbors;
-
     int32_t* m_GrainIds;
 
     std::vector<std::vector<int> > voxellists;
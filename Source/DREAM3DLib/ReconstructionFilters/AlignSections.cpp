@@ -36,6 +36,7 @@
 
 #include "AlignSections.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -66,7 +67,8 @@ const static float m_pi = static_cast<float>(M_PI);
 AlignSections::AlignSections() :
   AbstractFilter(),
   m_WriteAlignmentShifts(true),
-  m_AlignmentShiftFileName("")
+  m_AlignmentShiftFileName(""),
+  m_PyramidLevels(0)
 {
 
 }
@@ -274,3 +276,61 @@ void AlignSections::find_shifts(std::vector<int> &xshifts, std::vector<int> &ysh
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSections::search_shifts(const SliceShiftScorer* scorer, bool preferSmallShifts, bool useCostTable,
+                                  std::vector<int> &xshifts, std::vector<int> &yshifts)
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+
+  size_t udims[3] = {0,0,0};
+  m->getDimensions(udims);
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
+  };
+
+  SliceShiftSearch search(scorer, udims);
+  search.setPyramidLevels(m_PyramidLevels);
+  search.setPreferSmallShifts(preferSmallShifts);
+  search.setUseCostTable(useCostTable);
+
+  // Shifts of each slice against the one above it, indexed by slice. The slice
+  // pairs are searched a block at a time so progress and cancel are still seen.
+  std::vector<int> newxshifts(dims[2], 0);
+  std::vector<int> newyshifts(dims[2], 0);
+  const int64_t blockSize = 32;
+  for (int64_t iter = 1; iter < dims[2]; iter += blockSize)
+  {
+    std::stringstream ss;
+    int progInt = static_cast<int>(((float)iter/dims[2])*100.0f);
+    ss << "Determining Shifts - " << progInt << "% Complete";
+    notifyStatusMessage(ss.str());
+    if (getCancel() == true)
+    {
+      return;
+    }
+    int64_t end = std::min(iter + blockSize, dims[2]);
+    search.findShifts(dims[2] - end, dims[2] - iter, newxshifts, newyshifts);
+  }
+
+  std::ofstream outFile;
+  if (getWriteAlignmentShifts() == true) {
+    outFile.open(getAlignmentShiftFileName().c_str());
+  }
+  for (int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter-1] + newxshifts[slice];
+    yshifts[iter] = yshifts[iter-1] + newyshifts[slice];
+    if (getWriteAlignmentShifts() == true) {
+      outFile << slice << "	" << slice+1 << "	" << newxshifts[slice] << "	" << newyshifts[slice] << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
+    }
+  }
+  if (getWriteAlignmentShifts() == true) {
+    outFile.close();
+  }
+}
+
@@ -45,6 +45,7 @@
 #include "DREAM3DLib/DataArrays/IDataArray.h"
 
 #include "DREAM3DLib/Common/AbstractFilter.h"
+#include "DREAM3DLib/Common/SliceShiftSearch.h"
 #include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
 
@@ -68,6 +69,7 @@ class DREAM3DLib_EXPORT AlignSections : public AbstractFilter
 
     DREAM3D_INSTANCE_PROPERTY(bool, WriteAlignmentShifts)
     DREAM3D_INSTANCE_STRING_PROPERTY(AlignmentShiftFileName)
+    DREAM3D_INSTANCE_PROPERTY(int, PyramidLevels)
 
     virtual const std::string getGroupName() { return DREAM3D::FilterGroups::ReconstructionFilters; }
     virtual const std::string getSubGroupName() {return DREAM3D::FilterSubGroups::AlignmentFilters;}
@@ -98,6 +100,16 @@ class DREAM3DLib_EXPORT AlignSections : public AbstractFilter
   protected:
     AlignSections();
 
+    /**
+     * @brief Finds the shifts of all slices with the given cost function, searching
+     * the slice pairs concurrently, and writes the alignment file if asked to.
+     * @param scorer The cost of shifting a slice against the one above it
+     * @param preferSmallShifts Whether ties go to the shift closer to no shift at all
+     * @param useCostTable Whether to use the cost tables of the scorer
+     */
+    void search_shifts(const SliceShiftScorer* scorer, bool preferSmallShifts, bool useCostTable,
+                       std::vector<int> &xshifts, std::vector<int> &yshifts);
+
   private:
 
     void dataCheck(bool preflight, size_t voxels, size_t fields, size_t ensembles);
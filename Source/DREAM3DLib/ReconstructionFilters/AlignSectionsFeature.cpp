@@ -65,6 +65,7 @@ const static float m_pi = static_cast<float>(M_PI);
 AlignSectionsFeature::AlignSectionsFeature() :
 AlignSections(),
 m_GoodVoxelsArrayName(DREAM3D::CellData::GoodVoxels),
+m_UseFFT(false),
 m_GoodVoxels(NULL)
 {
   setupFilterParameters();
@@ -83,6 +84,23 @@ AlignSectionsFeature::~AlignSectionsFeature()
 void AlignSectionsFeature::setupFilterParameters()
 {
   std::vector<FilterParameter::Pointer> parameters;
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Pyramid Levels");
+    option->setPropertyName("PyramidLevels");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("0 Searches at Full Resolution Only");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Use FFT");
+    option->setPropertyName("UseFFT");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
   {
     FilterParameter::Pointer option = FilterParameter::New();
     option->setHumanLabel("Write Alignment Shift File");
@@ -130,6 +148,8 @@ void AlignSectionsFeature::readFilterParameters(AbstractFilterParametersReader*
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setPyramidLevels(reader->readValue("PyramidLevels", getPyramidLevels()));
+  setUseFFT(reader->readValue("UseFFT", getUseFFT()));
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -139,6 +159,8 @@ void AlignSectionsFeature::readFilterParameters(AbstractFilterParametersReader*
 // -----------------------------------------------------------------------------
 int AlignSectionsFeature::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
 {
+  writer->writeValue("PyramidLevels", getPyramidLevels() );
+  writer->writeValue("UseFFT", getUseFFT() );
   writer->writeValue("AlignmentShiftFileName", getAlignmentShiftFileName());
   writer->writeValue("WriteAlignmentShifts", getWriteAlignmentShifts());
     writer->closeFilterGroup();
@@ -183,116 +205,65 @@ void AlignSectionsFeature::execute()
 }
 
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void AlignSectionsFeature::find_shifts(std::vector<int> &xshifts, std::vector<int> &yshifts)
+/**
+ * @brief The fraction of the sampled **Cells** of the upper slice whose good flag
+ * differs from the shifted **Cell** of the lower slice.
+ */
+class GoodVoxelShiftScorer : public SliceShiftScorer
 {
-  VoxelDataContainer* m = getVoxelDataContainer();
-  //int64_t totalPoints = m->totalPoints();
+    const int64_t* m_Dims;
+    const bool* m_GoodVoxels;
 
-  std::ofstream outFile;
-  if (getWriteAlignmentShifts() == true) {
-    outFile.open(getAlignmentShiftFileName().c_str());
-  }
-  size_t udims[3] = {0,0,0};
-  m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  float disorientation = 0;
-  float mindisorientation = 100000000;
-  int newxshift = 0;
-  int newyshift = 0;
-  int oldxshift = 0;
-  int oldyshift = 0;
-  float count = 0;
-  int slice = 0;
-//  int xspot, yspot;
-  int refposition = 0;
-  int curposition = 0;
+  public:
+    GoodVoxelShiftScorer(const int64_t* dims, const bool* goodVoxels) :
+      m_Dims(dims),
+      m_GoodVoxels(goodVoxels)
+    {}
+    virtual ~GoodVoxelShiftScorer(){}
 
-  std::vector<std::vector<float> >  misorients;
-  misorients.resize(dims[0]);
-  for (DimType a = 0; a < dims[0]; a++)
-  {
-    misorients[a].resize(dims[1], 0.0);
-  }
-  for (DimType iter = 1; iter < dims[2]; iter++)
-  {
-    std::stringstream ss;
-    ss << "Aligning Sections - Determining Shifts - " << ((float)iter/dims[2])*100 << " Percent Complete";
-  //  notifyStatusMessage(ss.str());
-    mindisorientation = 100000000;
-    slice = static_cast<int>( (dims[2] - 1) - iter );
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for (DimType a = 0; a < dims[0]; a++)
+    virtual float cost(int64_t slice, int xshift, int yshift, int step) const
     {
-      for (DimType b = 0; b < dims[1]; b++)
+      float disorientation = 0;
+      float count = 0;
+      for (int64_t l = 0; l < m_Dims[1]; l = l + step)
       {
-        misorients[a][b] = 0;
-      }
-    }
-    while (newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for (int j = -3; j < 4; j++)
-      {
-        for (int k = -3; k < 4; k++)
+        for (int64_t n = 0; n < m_Dims[0]; n = n + step)
         {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + size_t(dims[0] / 2)][j + oldyshift + (size_t)(dims[1] / 2)] == 0 && abs(k + oldxshift) < (dims[0] / 2)
-              && (j + oldyshift) < (dims[1] / 2))
+          if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
           {
-            for (DimType l = 0; l < dims[1]; l = l + 4)
-            {
-              for (DimType n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = static_cast<int>( ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n );
-                  curposition = static_cast<int>( (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift) );
-                  if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition]) disorientation++;
-                count++;
-                }
-                else
-                {
-
-        }
-              }
-            }
-            disorientation = disorientation/count;
-            misorients[k + oldxshift + int(dims[0] / 2)][j + oldyshift + int(dims[1] / 2)] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
+            int64_t refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+            int64_t curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + yshift) * m_Dims[0]) + (n + xshift);
+            if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition]) disorientation++;
+            count++;
           }
         }
       }
+      return disorientation/count;
     }
-    xshifts[iter] = xshifts[iter-1] + newxshift;
-    yshifts[iter] = yshifts[iter-1] + newyshift;
-    if (getWriteAlignmentShifts() == true) {
-      outFile << slice << "	" << slice+1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
+
+    virtual bool costTable(int64_t slice, std::vector<float> &table) const
+    {
+      int64_t sliceSize = m_Dims[0] * m_Dims[1];
+      SliceShiftSearch::mismatchTable(m_GoodVoxels + (slice + 1) * sliceSize, m_GoodVoxels + slice * sliceSize, m_Dims, 4, table);
+      return true;
     }
-  }
-  if (getWriteAlignmentShifts() == true) {
-    outFile.close();
-  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsFeature::find_shifts(std::vector<int> &xshifts, std::vector<int> &yshifts)
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+
+  size_t udims[3] = {0,0,0};
+  m->getDimensions(udims);
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
+  };
+
+  GoodVoxelShiftScorer scorer(dims, m_GoodVoxels);
+  search_shifts(&scorer, false, m_UseFFT, xshifts, yshifts);
 }
@@ -70,6 +70,9 @@ class DREAM3DLib_EXPORT AlignSectionsFeature : public AlignSections
     //------ Required Cell Data
     DREAM3D_INSTANCE_STRING_PROPERTY(GoodVoxelsArrayName)
 
+    /* Score all shifts of a slice pair at once with FFT cross correlations */
+    DREAM3D_INSTANCE_PROPERTY(bool, UseFFT)
+
     virtual const std::string getGroupName() { return DREAM3D::FilterGroups::ReconstructionFilters; }
   virtual const std::string getSubGroupName() {return DREAM3D::FilterSubGroups::AlignmentFilters;}
     virtual const std::string getHumanLabel() { return "Align Sections (Feature)"; }
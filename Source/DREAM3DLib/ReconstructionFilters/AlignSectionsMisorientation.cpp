@@ -104,6 +104,15 @@ void AlignSectionsMisorientation::setupFilterParameters()
     option->setUnits("Degrees");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Pyramid Levels");
+    option->setPropertyName("PyramidLevels");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("0 Searches at Full Resolution Only");
+    parameters.push_back(option);
+  }
   {
     FilterParameter::Pointer option = FilterParameter::New();
     option->setHumanLabel("Write Alignment Shift File");
@@ -131,6 +140,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setPyramidLevels(reader->readValue("PyramidLevels", getPyramidLevels()));
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -142,6 +152,7 @@ int AlignSectionsMisorientation::writeFilterParameters(AbstractFilterParametersW
 {
   writer->openFilterGroup(this, index);
   writer->writeValue("MisorientationTolerance", getMisorientationTolerance() );
+  writer->writeValue("PyramidLevels", getPyramidLevels() );
   writer->writeValue("AlignmentShiftFileName", getAlignmentShiftFileName());
   writer->writeValue("WriteAlignmentShifts", getWriteAlignmentShifts());
     writer->closeFilterGroup();
@@ -219,154 +230,123 @@ void AlignSectionsMisorientation::execute()
 
 
 // -----------------------------------------------------------------------------
-//
+// Returns how many of the first 'count' quaternion pairs are misoriented by
+// more than 'tolerance'
 // -----------------------------------------------------------------------------
-void AlignSectionsMisorientation::find_shifts(std::vector<int> &xshifts, std::vector<int> &yshifts)
+static int countMisaligned(const OrientationOps::Pointer &ops, std::vector<QuatF> &q1s, std::vector<QuatF> &q2s,
+                           std::vector<float> &misos, size_t count, float tolerance)
 {
-  VoxelDataContainer* m = getVoxelDataContainer();
-  //int64_t totalPoints = m->totalPoints();
-
-  std::ofstream outFile;
-  if (getWriteAlignmentShifts() == true) {
-    outFile.open(getAlignmentShiftFileName().c_str());
-  }
-
-  size_t udims[3] = {0,0,0};
-  m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
-
-  float disorientation = 0;
-  float mindisorientation = 100000000;
-  int newxshift = 0;
-  int newyshift = 0;
-  int oldxshift = 0;
-  int oldyshift = 0;
-  float count = 0;
-  int slice = 0;
-  //  int xspot, yspot;
-  float w;
-  float n1, n2, n3;
-  QuatF q1;
-  QuatF q2;
-  int refposition = 0;
-  int curposition = 0;
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  unsigned int phase1, phase2;
-  int progInt = 0;
-
-  std::vector<std::vector<float> >  misorients;
-  misorients.resize(dims[0]);
-  for (DimType a = 0; a < dims[0]; a++)
+  ops->getMisoQuatBatch(&(q1s.front()), &(q2s.front()), count, &(misos.front()), NULL);
+  int misaligned = 0;
+  for (size_t i = 0; i < count; ++i)
   {
-    misorients[a].resize(dims[1], 0.0);
+    if(misos[i] > tolerance) { misaligned++; }
   }
-  for (DimType iter = 1; iter < dims[2]; iter++)
-  {
-    std::stringstream ss;
-    progInt = ((float)iter/dims[2])*100.0f;
-    ss << "Determining Shifts - " << progInt << "% Complete";
-    notifyStatusMessage(ss.str());
-    if (getCancel() == true)
-    {
-      return;
-    }
-    mindisorientation = 100000000;
-    slice = static_cast<int>( (dims[2] - 1) - iter );
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for (DimType a = 0; a < dims[0]; a++)
-    {
-      for (DimType b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while (newxshift != oldxshift || newyshift != oldyshift)
+  return misaligned;
+}
+
+/**
+ * @brief The fraction of the sampled **Cells** of the upper slice that are misoriented
+ * by more than the tolerance from the shifted **Cell** of the lower slice.
+ */
+class MisorientationShiftScorer : public SliceShiftScorer
+{
+    const int64_t* m_Dims;
+    const QuatF* m_Quats;
+    const int32_t* m_CellPhases;
+    const bool* m_GoodVoxels;
+    const unsigned int* m_CrystalStructures;
+    const std::vector<OrientationOps::Pointer> &m_OrientationOps;
+    float m_Tolerance;
+
+  public:
+    MisorientationShiftScorer(const int64_t* dims, const QuatF* quats, const int32_t* cellPhases, const bool* goodVoxels,
+                              const unsigned int* crystalStructures, const std::vector<OrientationOps::Pointer> &ops, float tolerance) :
+      m_Dims(dims),
+      m_Quats(quats),
+      m_CellPhases(cellPhases),
+      m_GoodVoxels(goodVoxels),
+      m_CrystalStructures(crystalStructures),
+      m_OrientationOps(ops),
+      m_Tolerance(tolerance)
+    {}
+    virtual ~MisorientationShiftScorer(){}
+
+    virtual float cost(int64_t slice, int xshift, int yshift, int step) const
     {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for (int j = -3; j < 4; j++)
+      std::vector<QuatF> q1s(256);
+      std::vector<QuatF> q2s(256);
+      std::vector<float> misos(256);
+      size_t batchCount = 0;
+      unsigned int batchPhase = 0;
+      unsigned int phase1 = 0, phase2 = 0;
+      float disorientation = 0;
+      float count = 0;
+      for (int64_t l = 0; l < m_Dims[1]; l = l + step)
       {
-        for (int k = -3; k < 4; k++)
+        for (int64_t n = 0; n < m_Dims[0]; n = n + step)
         {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + size_t(dims[0] / 2)][j + oldyshift + (size_t)(dims[1] / 2)] == 0 && abs(k + oldxshift) < (dims[0] / 2)
-             && (j + oldyshift) < (dims[1] / 2))
+          if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
           {
-            for (DimType l = 0; l < dims[1]; l = l + 4)
+            count++;
+            int64_t refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+            int64_t curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + yshift) * m_Dims[0]) + (n + xshift);
+            if(m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true)
             {
-              for (DimType n = 0; n < dims[0]; n = n + 4)
+              bool sameStructure = false;
+              if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
               {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = static_cast<int>( ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n );
-                  curposition = static_cast<int>( (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift) );
-                  if(m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true)
-                  {
-                    w = 10000.0;
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      QuaternionMathF::Copy(quats[refposition], q1);
-//                      q1[1] = m_Quats[refposition * 5 + 1];
-//                      q1[2] = m_Quats[refposition * 5 + 2];
-//                      q1[3] = m_Quats[refposition * 5 + 3];
-//                      q1[4] = m_Quats[refposition * 5 + 4];
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
-//                      q2[1] = m_Quats[curposition * 5 + 1];
-//                      q2[2] = m_Quats[curposition * 5 + 2];
-//                      q2[3] = m_Quats[curposition * 5 + 3];
-//                      q2[4] = m_Quats[curposition * 5 + 4];
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < m_OrientationOps.size())
-                      {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                      }
-                    }
-                    if(w > m_MisorientationTolerance) disorientation++;
-                  }
-                  if(m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == false) disorientation++;
-                  if(m_GoodVoxels[refposition] == false && m_GoodVoxels[curposition] == true) disorientation++;
-                }
-                else
+                phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+                phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+                sameStructure = (phase1 == phase2 && phase1 < m_OrientationOps.size());
+              }
+              if(sameStructure == true)
+              {
+                // Queue the pair, the misorientations are computed a batch at a time
+                if(batchCount > 0 && (phase1 != batchPhase || batchCount == q1s.size()))
                 {
-
+                  disorientation += countMisaligned(m_OrientationOps[batchPhase], q1s, q2s, misos, batchCount, m_Tolerance);
+                  batchCount = 0;
                 }
+                batchPhase = phase1;
+                QuaternionMathF::Copy(m_Quats[refposition], q1s[batchCount]);
+                QuaternionMathF::Copy(m_Quats[curposition], q2s[batchCount]);
+                batchCount++;
+              }
+              else
+              {
+                disorientation++;
               }
             }
-            disorientation = disorientation/count;
-            misorients[k + oldxshift + int(dims[0] / 2)][j + oldyshift + int(dims[1] / 2)] = disorientation;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((abs(k+oldxshift) < abs(newxshift)) || (abs(j+oldyshift) < abs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
+            if(m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == false) disorientation++;
+            if(m_GoodVoxels[refposition] == false && m_GoodVoxels[curposition] == true) disorientation++;
           }
         }
       }
+      if(batchCount > 0)
+      {
+        disorientation += countMisaligned(m_OrientationOps[batchPhase], q1s, q2s, misos, batchCount, m_Tolerance);
+      }
+      return disorientation/count;
     }
-    xshifts[iter] = xshifts[iter-1] + newxshift;
-    yshifts[iter] = yshifts[iter-1] + newyshift;
-    if (getWriteAlignmentShifts() == true) {
-      outFile << slice << "	" << slice+1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
-    }
-  }
-  if (getWriteAlignmentShifts() == true) {
-    outFile.close();
-  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsMisorientation::find_shifts(std::vector<int> &xshifts, std::vector<int> &yshifts)
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+
+  size_t udims[3] = {0,0,0};
+  m->getDimensions(udims);
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
+  };
+
+  MisorientationShiftScorer scorer(dims, reinterpret_cast<QuatF*>(m_Quats), m_CellPhases, m_GoodVoxels,
+                                   m_CrystalStructures, m_OrientationOps, m_MisorientationTolerance);
+  search_shifts(&scorer, true, false, xshifts, yshifts);
 }
@@ -107,6 +107,15 @@ void AlignSectionsMutualInformation::setupFilterParameters()
     option->setCastableValueType("double");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Pyramid Levels");
+    option->setPropertyName("PyramidLevels");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("0 Searches at Full Resolution Only");
+    parameters.push_back(option);
+  }
   {
     FilterParameter::Pointer option = FilterParameter::New();
     option->setHumanLabel("Write Alignment Shift File");
@@ -135,6 +144,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setPyramidLevels(reader->readValue("PyramidLevels", getPyramidLevels()));
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -147,6 +157,7 @@ int AlignSectionsMutualInformation::writeFilterParameters(AbstractFilterParamete
   writer->writeValue("AlignmentShiftFileName", getAlignmentShiftFileName());
   writer->writeValue("WriteAlignmentShifts", getWriteAlignmentShifts());
   writer->writeValue("MisorientationTolerance", getMisorientationTolerance() );
+  writer->writeValue("PyramidLevels", getPyramidLevels() );
     writer->closeFilterGroup();
     return ++index; // we want to return the next index that was just written to
 }
@@ -210,6 +221,7 @@ void AlignSectionsMutualInformation::execute()
   }
 
   Int32ArrayType::Pointer p = Int32ArrayType::CreateArray((totalPoints * 1), "MI GrainIds");
+  p->initializeWithZeros();
   m_GrainIds = p->GetPointer(0);
 
   //Converting the user defined tolerance to radians.
@@ -222,206 +234,108 @@ void AlignSectionsMutualInformation::execute()
 }
 
 
+/**
+ * @brief The inverse of the mutual information of the section grain ids of the two
+ * slices. Only the grain pairs that actually meet are counted, as a sorted list of
+ * pair keys, which sums the same terms in the same order as the full
+ * graincount1 x graincount2 table did.
+ */
+class MutualInformationShiftScorer : public SliceShiftScorer
+{
+    const int64_t* m_Dims;
+    const int32_t* m_GrainIds;
+    const int* m_GrainCounts;
+
+  public:
+    MutualInformationShiftScorer(const int64_t* dims, const int32_t* grainIds, const int* grainCounts) :
+      m_Dims(dims),
+      m_GrainIds(grainIds),
+      m_GrainCounts(grainCounts)
+    {}
+    virtual ~MutualInformationShiftScorer(){}
+
+    virtual float cost(int64_t slice, int xshift, int yshift, int step) const
+    {
+      int graincount1 = m_GrainCounts[slice];
+      int graincount2 = m_GrainCounts[slice + 1];
+      std::vector<float> mutualinfo1(graincount1, 0.0f);
+      std::vector<float> mutualinfo2(graincount2, 0.0f);
+      std::vector<int64_t> pairs;
+      pairs.reserve(((m_Dims[0] + step - 1) / step) * ((m_Dims[1] + step - 1) / step));
+      float count = 0;
+      for (int64_t l = 0; l < m_Dims[1]; l = l + step)
+      {
+        for (int64_t n = 0; n < m_Dims[0]; n = n + step)
+        {
+          if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
+          {
+            int64_t refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+            int64_t curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + yshift) * m_Dims[0]) + (n + xshift);
+            int refgnum = m_GrainIds[refposition];
+            int curgnum = m_GrainIds[curposition];
+            if(curgnum >= 0 && refgnum >= 0)
+            {
+              pairs.push_back(static_cast<int64_t>(curgnum) * graincount2 + refgnum);
+              mutualinfo1[curgnum]++;
+              mutualinfo2[refgnum]++;
+              count++;
+            }
+          }
+          else
+          {
+            pairs.push_back(0);
+            mutualinfo1[0]++;
+            mutualinfo2[0]++;
+          }
+        }
+      }
+      for (int b = 0; b < graincount1; b++)
+      {
+        mutualinfo1[b] = mutualinfo1[b] / float(count);
+      }
+      for (int c = 0; c < graincount2; c++)
+      {
+        mutualinfo2[c] = mutualinfo2[c] / float(count);
+      }
+      std::sort(pairs.begin(), pairs.end());
+      float disorientation = 0;
+      for (size_t i = 0; i < pairs.size(); )
+      {
+        size_t next = i + 1;
+        while (next < pairs.size() && pairs[next] == pairs[i]) { next++; }
+        int b = static_cast<int>(pairs[i] / graincount2);
+        int c = static_cast<int>(pairs[i] % graincount2);
+        float mutualinfo12 = static_cast<float>(next - i) / float(count);
+        float value = 0;
+        if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0) value = (mutualinfo12 / (mutualinfo1[b] * mutualinfo2[c]));
+        if(value != 0) disorientation = disorientation + (mutualinfo12 * log(value));
+        i = next;
+      }
+      return static_cast<float>( 1.0 / disorientation );
+    }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void AlignSectionsMutualInformation::find_shifts(std::vector<int> &xshifts, std::vector<int> &yshifts)
 {
   VoxelDataContainer* m = getVoxelDataContainer();
-  //int64_t totalPoints = m->totalPoints();
-
-  std::ofstream outFile;
-  if (getWriteAlignmentShifts() == true) {
-    outFile.open(getAlignmentShiftFileName().c_str());
-  }
 
   size_t udims[3] = {0,0,0};
   m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0;
-  float mindisorientation = 100000000;
-  float **mutualinfo12 = NULL;
-  float *mutualinfo1 = NULL;
-  float *mutualinfo2 = NULL;
-  int graincount1, graincount2;
-  int newxshift = 0;
-  int newyshift = 0;
-  int oldxshift = 0;
-  int oldyshift = 0;
-  float count = 0;
-  int slice = 0;
-//  int xspot, yspot;
-//  float w;
-
-//  float q1[5];
-//  float q2[5];
-  int refgnum, curgnum;
-  int refposition = 0;
-  int curposition = 0;
-//  DimType newPosition;
-
-//  unsigned int  phase2;
-
   form_grains_sections();
 
-  std::vector<std::vector<float> >  misorients;
-  misorients.resize(dims[0]);
-  for (DimType a = 0; a < dims[0]; a++)
-  {
-    misorients[a].resize(dims[1], 0.0);
-  }
-  for (DimType iter = 1; iter < dims[2]; iter++)
-  {
-    std::stringstream ss;
-    ss << "Aligning Sections - Determining Shifts - " << ((float)iter/dims[2])*100 << " Percent Complete";
-  //  notifyStatusMessage(ss.str());
-    mindisorientation = 100000000;
-    slice = static_cast<int>( (dims[2] - 1) - iter );
-    graincount1 = graincounts[slice];
-    graincount2 = graincounts[slice + 1];
-    mutualinfo12 = new float *[graincount1];
-    mutualinfo1 = new float[graincount1];
-    mutualinfo2 = new float[graincount2];
-
-    for (int a = 0; a < graincount1; a++)
-    {
-        mutualinfo1[a] = 0.0f;
-        mutualinfo12[a] = new float[graincount2];
-        for (int b = 0; b < graincount2; b++)
-        {
-          mutualinfo12[a][b] = 0.0f;
-          mutualinfo2[b] = 0.0f;
-        }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for (DimType a = 0; a < dims[0]; a++)
-    {
-      for (DimType b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while (newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for (int j = -3; j < 4; j++)
-      {
-        for (int k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + size_t(dims[0] / 2)][j + oldyshift + (size_t)(dims[1] / 2)] == 0 && abs(k + oldxshift) < (dims[0] / 2)
-              && (j + oldyshift) < (dims[1] / 2))
-          {
-            for (DimType l = 0; l < dims[1]; l = l + 4)
-            {
-              for (DimType n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = static_cast<int>( ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n );
-                  curposition = static_cast<int>( (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift) );
-                  refgnum = m_GrainIds[refposition];
-                  curgnum = m_GrainIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                      mutualinfo12[curgnum][refgnum]++;
-                      mutualinfo1[curgnum]++;
-                      mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0;
-            float hb = 0;
-            float hab = 0;
-            for (int b = 0; b < graincount1; b++)
-            {
-                mutualinfo1[b] = mutualinfo1[b] / float(count);
-                if(mutualinfo1[b] != 0) ha = ha + mutualinfo1[b] * log(mutualinfo1[b]);
-            }
-            for (int c = 0; c < graincount2; c++)
-            {
-                mutualinfo2[c] = mutualinfo2[c] / float(count);
-                if(mutualinfo2[c] != 0) hb = hb + mutualinfo2[c] * log(mutualinfo2[c]);
-            }
-            for (int b = 0; b < graincount1; b++)
-            {
-                for (int c = 0; c < graincount2; c++)
-                {
-                  mutualinfo12[b][c] = mutualinfo12[b][c] / float(count);
-                  if(mutualinfo12[b][c] != 0) hab = hab + mutualinfo12[b][c] * log(mutualinfo12[b][c]);
-                  float value = 0;
-                  if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0) value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                  if(value != 0) disorientation = disorientation + (mutualinfo12[b][c] * log(value));
-                }
-            }
-            for (int b = 0; b < graincount1; b++)
-            {
-                for (int c = 0; c < graincount2; c++)
-                {
-                  mutualinfo12[b][c] = 0;
-                  mutualinfo1[b] = 0;
-                  mutualinfo2[c] = 0;
-                }
-            }
-            disorientation = static_cast<float>( 1.0 / disorientation );
-            misorients[k + oldxshift + int(dims[0] / 2)][j + oldyshift + int(dims[1] / 2)] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter-1] + newxshift;
-    yshifts[iter] = yshifts[iter-1] + newyshift;
-    if(getWriteAlignmentShifts() == true)
-    {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for (int i = 0; i < graincount1; i++)
-    {
-      delete mutualinfo12[i];
-    }
-    delete[] mutualinfo12;
-    mutualinfo1 = NULL;
-    mutualinfo2 = NULL;
-    mutualinfo12 = NULL;
-  }
+  MutualInformationShiftScorer scorer(dims, m_GrainIds, graincounts);
+  search_shifts(&scorer, false, false, xshifts, yshifts);
 
   m->removeCellData(DREAM3D::CellData::GrainIds);
-
-  if(getWriteAlignmentShifts() == true)
-  {
-    outFile.close();
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -110,6 +110,14 @@ void CAxisSegmentGrains::setupFilterParameters()
   option->setUnits("Degrees");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Parallel Segmentation (Union-Find)");
+    option->setPropertyName("UseParallelSegmentation");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
 #if 0
   {
     FilterParameter::Pointer option = FilterParameter::New();
@@ -131,6 +139,7 @@ void CAxisSegmentGrains::readFilterParameters(AbstractFilterParametersReader* re
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setUseParallelSegmentation( reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()) );
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -142,6 +151,7 @@ int CAxisSegmentGrains::writeFilterParameters(AbstractFilterParametersWriter* wr
 {
   writer->openFilterGroup(this, index);
   writer->writeValue("MisorientationTolerance", getMisorientationTolerance() );
+  writer->writeValue("UseParallelSegmentation", getUseParallelSegmentation() );
     writer->closeFilterGroup();
     return ++index; // we want to return the next index that was just written to
 }
@@ -316,7 +326,27 @@ int CAxisSegmentGrains::getSeed(size_t gnum)
 // -----------------------------------------------------------------------------
 bool CAxisSegmentGrains::determineGrouping(int referencepoint, int neighborpoint, size_t gnum)
 {
-  bool group = false;
+  if(m_GrainIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint) == true)
+  {
+    m_GrainIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentGrains::isSegmentable(int64_t point)
+{
+  return (m_GoodVoxels[point] == true && m_CellPhases[point] > 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentGrains::compareVoxels(int64_t referencepoint, int64_t neighborpoint)
+{
   float w = 10000.0;
   QuatF q1;
   QuatF q2;
@@ -325,58 +355,41 @@ bool CAxisSegmentGrains::determineGrouping(int referencepoint, int neighborpoint
   float g2[3][3];
   float g1t[3][3];
   float g2t[3][3];
- // float n1, n2, n3;
-  unsigned int phase1, phase2;
   float caxis[3] = {0,0,1};
   float c1[3];
   float c2[3];
 
-  if(m_GrainIds[neighborpoint] == 0 && m_GoodVoxels[neighborpoint] == true)
-  {
-    phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-//    q1[0] = 1;
-//    q1[1] = m_Quats[referencepoint * 5 + 1];
-//    q1[2] = m_Quats[referencepoint * 5 + 2];
-//    q1[3] = m_Quats[referencepoint * 5 + 3];
-//    q1[4] = m_Quats[referencepoint * 5 + 4];
-
-    phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
-//    q2[0] = 1;
-//    q2[1] = m_Quats[neighborpoint*5 + 1];
-//    q2[2] = m_Quats[neighborpoint*5 + 2];
-//    q2[3] = m_Quats[neighborpoint*5 + 3];
-//    q2[4] = m_Quats[neighborpoint*5 + 4];
-
-    if (m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      OrientationMath::QuattoMat(q1, g1);
-      OrientationMath::QuattoMat(q2, g2);
-
-      //transpose the g matricies so when caxis is multiplied by it
-      //it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Transpose3x3(g2, g2t);
-
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-
-      //normalize so that the dot product can be taken below without
-      //dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
-      MatrixMath::Normalize3x1(c2);
-
-      w = ((c1[0]*c2[0])+(c1[1]*c2[1])+(c1[2]*c2[2]));
-      w = acosf(w);
-      if (w <= m_MisorientationTolerance || (m_pi-w) <= m_MisorientationTolerance)
-      {
-        group = true;
-        m_GrainIds[neighborpoint] = gnum;
-      }
+  if(m_GoodVoxels[referencepoint] == false || m_GoodVoxels[neighborpoint] == false) { return false; }
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint]) { return false; }
 
-    }
-  }
+  QuaternionMathF::Copy(quats[referencepoint], q1);
+  QuaternionMathF::Copy(quats[neighborpoint], q2);
+
+  OrientationMath::QuattoMat(q1, g1);
+  OrientationMath::QuattoMat(q2, g2);
+
+  //transpose the g matricies so when caxis is multiplied by it
+  //it will give the sample direction that the caxis is along
+  MatrixMath::Transpose3x3(g1, g1t);
+  MatrixMath::Transpose3x3(g2, g2t);
 
-  return group;
+  MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+  MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+
+  //normalize so that the dot product can be taken below without
+  //dividing by the magnitudes (they would be 1)
+  MatrixMath::Normalize3x1(c1);
+  MatrixMath::Normalize3x1(c2);
+
+  w = ((c1[0]*c2[0])+(c1[1]*c2[1])+(c1[2]*c2[2]));
+  w = acosf(w);
+  return (w <= m_MisorientationTolerance || (m_pi-w) <= m_MisorientationTolerance);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* CAxisSegmentGrains::getGrainIdsPointer()
+{
+  return m_GrainIds;
 }
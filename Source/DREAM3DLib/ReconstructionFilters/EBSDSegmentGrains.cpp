@@ -100,6 +100,14 @@ void EBSDSegmentGrains::setupFilterParameters()
     option->setUnits("Degrees");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Parallel Segmentation (Union-Find)");
+    option->setPropertyName("UseParallelSegmentation");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
 #if 0
   {
     FilterParameter::Pointer option = FilterParameter::New();
@@ -122,6 +130,7 @@ void EBSDSegmentGrains::readFilterParameters(AbstractFilterParametersReader* rea
   /* Code to read the values goes between these statements */
   /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setUseParallelSegmentation( reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()) );
   /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -133,6 +142,7 @@ int EBSDSegmentGrains::writeFilterParameters(AbstractFilterParametersWriter* wri
 {
   writer->openFilterGroup(this, index);
   writer->writeValue("MisorientationTolerance", getMisorientationTolerance() );
+  writer->writeValue("UseParallelSegmentation", getUseParallelSegmentation() );
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -320,35 +330,104 @@ int EBSDSegmentGrains::getSeed(size_t gnum)
 // -----------------------------------------------------------------------------
 bool EBSDSegmentGrains::determineGrouping(int referencepoint, int neighborpoint, size_t gnum)
 {
-  bool group = false;
+  if(m_GrainIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint) == true)
+  {
+    m_GrainIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentGrains::isSegmentable(int64_t point)
+{
+  return (m_GoodVoxels[point] == true && m_CellPhases[point] > 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentGrains::compareVoxels(int64_t referencepoint, int64_t neighborpoint)
+{
   float w = 10000.0;
   QuatF q1;
   QuatF q2;
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
   float n1, n2, n3;
-  unsigned int phase1, phase2;
+  unsigned int phase1;
 
-  if(m_GrainIds[neighborpoint] == 0 && m_GoodVoxels[neighborpoint] == true)
-  {
-    phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
-    QuaternionMathF::Copy(quats[referencepoint], q1);
+  if(m_GoodVoxels[referencepoint] == false || m_GoodVoxels[neighborpoint] == false) { return false; }
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint]) { return false; }
 
-    phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
+  phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
+  QuaternionMathF::Copy(quats[referencepoint], q1);
+  QuaternionMathF::Copy(quats[neighborpoint], q2);
 
-    float misoTolRad = getMisorientationTolerance() * m_pi/180.0;
-    if (m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
+  float misoTolRad = getMisorientationTolerance() * m_pi/180.0;
+  w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
+  return (w < misoTolRad);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EBSDSegmentGrains::compareVoxelBatch(const int64_t* referencepoints, const int64_t* neighborpoints, size_t count, bool* same)
+{
+  const size_t k_BlockSize = 64;
+  QuatF q1[k_BlockSize];
+  QuatF q2[k_BlockSize];
+  float w[k_BlockSize];
+  size_t slots[k_BlockSize];
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  float misoTolRad = getMisorientationTolerance() * m_pi/180.0;
+
+  size_t numPairs = 0;
+  unsigned int blockPhase = 0;
+  for (size_t i = 0; i <= count; ++i)
+  {
+    unsigned int phase1 = 0;
+    bool queue = false;
+    if (i < count)
+    {
+      int64_t referencepoint = referencepoints[i];
+      int64_t neighborpoint = neighborpoints[i];
+      same[i] = false;
+      if(m_GoodVoxels[referencepoint] == true && m_GoodVoxels[neighborpoint] == true
+         && m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
+      {
+        phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
+        queue = true;
+      }
+    }
+    // Compute the queued pairs once the block is full, the crystal structure changes or at the end
+    if (numPairs > 0 && (i == count || (queue == true && (phase1 != blockPhase || numPairs == k_BlockSize))))
     {
-      w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
+      m_OrientationOps[blockPhase]->getMisoQuatBatch(q1, q2, numPairs, w, NULL);
+      for (size_t j = 0; j < numPairs; ++j)
+      {
+        same[slots[j]] = (w[j] < misoTolRad);
+      }
+      numPairs = 0;
     }
-    if (w < misoTolRad)
+    if (queue == true)
     {
-      group = true;
-      m_GrainIds[neighborpoint] = gnum;
+      blockPhase = phase1;
+      QuaternionMathF::Copy(quats[referencepoints[i]], q1[numPairs]);
+      QuaternionMathF::Copy(quats[neighborpoints[i]], q2[numPairs]);
+      slots[numPairs] = i;
+      numPairs++;
     }
   }
+}
 
-  return group;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* EBSDSegmentGrains::getGrainIdsPointer()
+{
+  return m_GrainIds;
 }
 
 // -----------------------------------------------------------------------------
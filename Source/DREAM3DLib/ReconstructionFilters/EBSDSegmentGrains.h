@@ -111,6 +111,10 @@ class DREAM3DLib_EXPORT EBSDSegmentGrains : public SegmentGrains
 
     virtual int getSeed(size_t gnum);
     virtual bool determineGrouping(int referencepoint, int neighborpoint, size_t gnum);
+    virtual bool isSegmentable(int64_t point);
+    virtual bool compareVoxels(int64_t referencepoint, int64_t neighborpoint);
+    virtual void compareVoxelBatch(const int64_t* referencepoints, const int64_t* neighborpoints, size_t count, bool* same);
+    virtual int32_t* getGrainIdsPointer();
 
   protected:
     EBSDSegmentGrains();
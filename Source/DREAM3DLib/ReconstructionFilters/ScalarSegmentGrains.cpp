@@ -74,6 +74,12 @@ public:
   {
     return false;
   }
+
+  // Same comparison as operator() but without assigning the GrainId
+  virtual bool compare(size_t index, size_t neighIndex)
+  {
+    return false;
+  }
 };
 
 
@@ -91,25 +97,25 @@ class TSpecificCompareFunctor : public CompareFunctor
     virtual ~TSpecificCompareFunctor(){};
 
     virtual bool operator()(size_t referencepoint, size_t neighborpoint, size_t gnum)
+    {
+      if (compare(referencepoint, neighborpoint) == true)
+      {
+        m_GrainIds[neighborpoint] = gnum;
+        return true;
+      }
+      return false;
+    }
+
+    virtual bool compare(size_t referencepoint, size_t neighborpoint)
     {
       // Sanity check the indices that are being passed in.
       if (referencepoint >= m_Length || neighborpoint >= m_Length) { return false; }
 
       if(m_Data[referencepoint] >= m_Data[neighborpoint])
       {
-        if ((m_Data[referencepoint]-m_Data[neighborpoint]) <= m_Tolerance) {
-          m_GrainIds[neighborpoint] = gnum;
-          return true;
-        }
+        return ((m_Data[referencepoint]-m_Data[neighborpoint]) <= m_Tolerance);
       }
-      else
-      {
-        if ((m_Data[neighborpoint]-m_Data[referencepoint]) <= m_Tolerance) {
-          m_GrainIds[neighborpoint] = gnum;
-          return true;
-        }
-      }
-      return false;
+      return ((m_Data[neighborpoint]-m_Data[referencepoint]) <= m_Tolerance);
     }
 
 protected:
@@ -174,6 +180,14 @@ void ScalarSegmentGrains::setupFilterParameters()
     option->setUnits("");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Parallel Segmentation (Union-Find)");
+    option->setPropertyName("UseParallelSegmentation");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
 #if 0
   {
     FilterParameter::Pointer option = FilterParameter::New();
@@ -195,6 +209,7 @@ void ScalarSegmentGrains::readFilterParameters(AbstractFilterParametersReader* r
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setUseParallelSegmentation( reader->readValue("UseParallelSegmentation", getUseParallelSegmentation()) );
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -207,6 +222,7 @@ int ScalarSegmentGrains::writeFilterParameters(AbstractFilterParametersWriter* w
   writer->openFilterGroup(this, index);
   writer->writeValue("ScalarArrayName", getScalarArrayName() );
   writer->writeValue("ScalarTolerance", getScalarTolerance() );
+  writer->writeValue("UseParallelSegmentation", getUseParallelSegmentation() );
     writer->closeFilterGroup();
     return ++index; // we want to return the next index that was just written to
 }
@@ -442,3 +458,28 @@ bool ScalarSegmentGrains::determineGrouping(int referencepoint, int neighborpoin
   //     | Functor  ||calling the operator() method of the CompareFunctor Class |
 
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentGrains::isSegmentable(int64_t point)
+{
+  // Same test getSeed() uses; there is no mask so every voxel not yet in a grain can seed one
+  return (m_GrainIds[point] == 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentGrains::compareVoxels(int64_t referencepoint, int64_t neighborpoint)
+{
+  return m_Compare->compare( (size_t)(referencepoint), (size_t)(neighborpoint) );
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* ScalarSegmentGrains::getGrainIdsPointer()
+{
+  return m_GrainIds;
+}
@@ -104,6 +104,9 @@ class DREAM3DLib_EXPORT ScalarSegmentGrains : public SegmentGrains
 
     virtual int getSeed(size_t gnum);
     virtual bool determineGrouping(int referencepoint, int neighborpoint, size_t gnum);
+    virtual bool isSegmentable(int64_t point);
+    virtual bool compareVoxels(int64_t referencepoint, int64_t neighborpoint);
+    virtual int32_t* getGrainIdsPointer();
 
   protected:
     ScalarSegmentGrains();
@@ -36,6 +36,8 @@
 
 #include "SegmentGrains.h"
 
+#include <algorithm>
+
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
@@ -47,6 +49,13 @@
 
 #include "DREAM3DLib/GenericFilters/FindCellQuats.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #define ERROR_TXT_OUT 1
 #define ERROR_TXT_OUT1 1
 
@@ -57,11 +66,215 @@ const static float m_pi = static_cast<float>(M_PI);
   boost::shared_array<m_msgType> var##Array(new m_msgType[size]);\
   m_msgType* var = var##Array.get();
 
+/**
+ * @brief Builds the union-find forest for a range of z-slabs. Every segmentable voxel starts as
+ * its own root and is then joined to its -X, -Y and -Z neighbors inside the same slab when the
+ * filter groups them. The root of a set is always its lowest voxel index. A range of slabs only
+ * touches the parents of its own voxels so disjoint ranges can be processed concurrently.
+ */
+class SegmentGrainsSlabUnion
+{
+  public:
+    SegmentGrainsSlabUnion(SegmentGrains* filter, int64_t* parents, int64_t dims[3], int64_t slabSize) :
+      m_Filter(filter),
+      m_Parents(parents),
+      m_SlabSize(slabSize)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~SegmentGrainsSlabUnion(){}
+
+    static int64_t findRoot(int64_t* parents, int64_t point)
+    {
+      // Path halving keeps the trees shallow without a second pass
+      while (parents[point] != point)
+      {
+        parents[point] = parents[parents[point]];
+        point = parents[point];
+      }
+      return point;
+    }
+
+    static void unite(int64_t* parents, int64_t point1, int64_t point2)
+    {
+      point1 = findRoot(parents, point1);
+      point2 = findRoot(parents, point2);
+      if (point1 < point2) { parents[point2] = point1; }
+      else if (point2 < point1) { parents[point1] = point2; }
+    }
+
+    void join(int64_t point, int64_t neighbor) const
+    {
+      if (m_Parents[neighbor] >= 0 && m_Filter->compareVoxels(point, neighbor) == true)
+      {
+        unite(m_Parents, point, neighbor);
+      }
+    }
+
+    enum { BatchSize = 256 };
+
+    /**
+     * @brief Compares the queued voxel pairs in one call to the filter and joins the ones that match
+     */
+    void joinBatch(const int64_t* points, const int64_t* neighbors, size_t count) const
+    {
+      bool same[BatchSize];
+      m_Filter->compareVoxelBatch(points, neighbors, count, same);
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (same[i] == true) { unite(m_Parents, points[i], neighbors[i]); }
+      }
+    }
+
+    void label(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Dims[0] * m_Dims[1];
+      int64_t points[BatchSize];
+      int64_t neighbors[BatchSize];
+      size_t count = 0;
+      for (size_t slab = start; slab < end; ++slab)
+      {
+        int64_t zStart = static_cast<int64_t>(slab) * m_SlabSize;
+        int64_t zEnd = std::min(zStart + m_SlabSize, m_Dims[2]);
+        for (int64_t plane = zStart; plane < zEnd; ++plane)
+        {
+          for (int64_t row = 0; row < m_Dims[1]; ++row)
+          {
+            for (int64_t col = 0; col < m_Dims[0]; ++col)
+            {
+              int64_t point = plane * planeSize + row * m_Dims[0] + col;
+              if (m_Filter->isSegmentable(point) == false)
+              {
+                m_Parents[point] = -1;
+                continue;
+              }
+              m_Parents[point] = point;
+              // Queue the candidate pairs so the filter can compare them a batch at a time.
+              // The neighbors all come earlier in the slab so their parents are already set.
+              if (count + 3 > BatchSize)
+              {
+                joinBatch(points, neighbors, count);
+                count = 0;
+              }
+              if (col > 0 && m_Parents[point - 1] >= 0) { points[count] = point; neighbors[count++] = point - 1; }
+              if (row > 0 && m_Parents[point - m_Dims[0]] >= 0) { points[count] = point; neighbors[count++] = point - m_Dims[0]; }
+              if (plane > zStart && m_Parents[point - planeSize] >= 0) { points[count] = point; neighbors[count++] = point - planeSize; }
+            }
+          }
+        }
+      }
+      joinBatch(points, neighbors, count);
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      label(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    SegmentGrains* m_Filter;
+    int64_t* m_Parents;
+    int64_t m_Dims[3];
+    int64_t m_SlabSize;
+};
+
+/**
+ * @brief Merges the union-find forests of neighboring groups of slabs across the face they share.
+ * At a given level every merge joins two groups of 'slabsPerGroup' slabs, so each merge owns a
+ * disjoint block of voxels and the merges of one level can run concurrently without any locking.
+ */
+class SegmentGrainsFaceMerge
+{
+  public:
+    SegmentGrainsFaceMerge(SegmentGrainsSlabUnion& slabs, int64_t* parents, int64_t dims[3], int64_t slabSize, int64_t slabsPerGroup) :
+      m_Slabs(slabs),
+      m_Parents(parents),
+      m_SlabSize(slabSize),
+      m_SlabsPerGroup(slabsPerGroup)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~SegmentGrainsFaceMerge(){}
+
+    void merge(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Dims[0] * m_Dims[1];
+      for (size_t pair = start; pair < end; ++pair)
+      {
+        int64_t plane = (2 * static_cast<int64_t>(pair) + 1) * m_SlabsPerGroup * m_SlabSize;
+        if (plane >= m_Dims[2]) { continue; }
+        for (int64_t i = 0; i < planeSize; ++i)
+        {
+          int64_t point = plane * planeSize + i;
+          if (m_Parents[point] < 0) { continue; }
+          m_Slabs.join(point, point - planeSize);
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      merge(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    SegmentGrainsSlabUnion& m_Slabs;
+    int64_t* m_Parents;
+    int64_t m_Dims[3];
+    int64_t m_SlabSize;
+    int64_t m_SlabsPerGroup;
+};
+
+/**
+ * @brief Writes the grain id of every voxel once the roots have been numbered. A root holds its
+ * own grain id and every other voxel copies the grain id of its root.
+ */
+class SegmentGrainsAssignIds
+{
+  public:
+    SegmentGrainsAssignIds(int64_t* parents, int32_t* grainIds) :
+      m_Parents(parents),
+      m_GrainIds(grainIds)
+    {}
+    virtual ~SegmentGrainsAssignIds(){}
+
+    void assign(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; ++i)
+      {
+        int64_t root = m_Parents[i];
+        if (root < 0 || root == static_cast<int64_t>(i)) { continue; }
+        while (m_Parents[root] != root) { root = m_Parents[root]; }
+        m_GrainIds[i] = m_GrainIds[root];
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      assign(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int64_t* m_Parents;
+    int32_t* m_GrainIds;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 SegmentGrains::SegmentGrains() :
-AbstractFilter()
+AbstractFilter(),
+m_UseParallelSegmentation(false)
 {
 
 }
@@ -140,6 +353,13 @@ void SegmentGrains::execute()
   DimType dims[3] =
   { static_cast<DimType>(udims[0]), static_cast<DimType>(udims[1]), static_cast<DimType>(udims[2]), };
 
+  if (m_UseParallelSegmentation == true)
+  {
+    segmentWithUnionFind();
+    notifyStatusMessage("Completed");
+    return;
+  }
+
   size_t gnum = 1;
   int seed = 0;
   int neighbor;
@@ -239,3 +459,137 @@ bool SegmentGrains::determineGrouping(int referencepoint, int neighborpoint, siz
 {
   return false;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentGrains::isSegmentable(int64_t point)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentGrains::compareVoxels(int64_t referencepoint, int64_t neighborpoint)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentGrains::compareVoxelBatch(const int64_t* referencepoints, const int64_t* neighborpoints, size_t count, bool* same)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    same[i] = compareVoxels(referencepoints[i], neighborpoints[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SegmentGrains::getGrainIdsPointer()
+{
+  return NULL;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentGrains::segmentWithUnionFind()
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+  int32_t* grainIds = getGrainIdsPointer();
+  if (NULL == grainIds)
+  {
+    setErrorCondition(-1);
+    addErrorMessage(getHumanLabel(), "This filter does not support the parallel segmentation", -1);
+    return;
+  }
+
+  size_t udims[3] = { 0, 0, 0 };
+  m->getDimensions(udims);
+  int64_t dims[3] = { static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]) };
+  int64_t totalPoints = m->getTotalPoints();
+
+  // Thin slabs give every thread several slabs to work on while keeping the number
+  // of merge levels small
+  const int64_t maxSlabs = 256;
+  int64_t slabSize = (dims[2] + maxSlabs - 1) / maxSlabs;
+  size_t numSlabs = static_cast<size_t>((dims[2] + slabSize - 1) / slabSize);
+
+  std::vector<int64_t> parents(totalPoints, -1);
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  notifyStatusMessage("Labeling Slabs");
+  SegmentGrainsSlabUnion slabs(this, &(parents.front()), dims, slabSize);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), slabs, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    slabs.label(0, numSlabs);
+  }
+  if (getCancel() == true)
+  {
+    setErrorCondition(-1);
+    return;
+  }
+
+  notifyStatusMessage("Merging Slab Faces");
+  for (int64_t slabsPerGroup = 1; slabsPerGroup < static_cast<int64_t>(numSlabs); slabsPerGroup *= 2)
+  {
+    size_t numPairs = static_cast<size_t>((static_cast<int64_t>(numSlabs) + 2 * slabsPerGroup - 1) / (2 * slabsPerGroup));
+    SegmentGrainsFaceMerge faces(slabs, &(parents.front()), dims, slabSize, slabsPerGroup);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPairs), faces, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      faces.merge(0, numPairs);
+    }
+  }
+
+  // Number the roots in voxel order so the grain ids do not depend on the slab layout
+  // or on the number of threads
+  notifyStatusMessage("Numbering Grains");
+  int32_t gnum = 1;
+  for (int64_t i = 0; i < totalPoints; ++i)
+  {
+    if (parents[i] == i)
+    {
+      grainIds[i] = gnum;
+      ++gnum;
+    }
+  }
+
+  SegmentGrainsAssignIds assignIds(&(parents.front()), grainIds);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), assignIds, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    assignIds.assign(0, totalPoints);
+  }
+
+  m->resizeFieldDataArrays(gnum);
+
+  std::stringstream ss;
+  ss << "Total Grains: " << (gnum - 1);
+  notifyStatusMessage(ss.str());
+}
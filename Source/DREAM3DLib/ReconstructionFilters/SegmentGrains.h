@@ -88,12 +88,50 @@ class DREAM3DLib_EXPORT SegmentGrains : public AbstractFilter
     virtual void execute();
     virtual void preflight();
 
+    DREAM3D_INSTANCE_PROPERTY(bool, UseParallelSegmentation)
+
     virtual int getSeed(size_t gnum);
     virtual bool determineGrouping(int referencepoint, int neighborpoint, size_t gnum);
 
+    /**
+     * @brief Returns true if the voxel can be part of a grain at all. This must agree with
+     * the test that getSeed() uses to pick a seed voxel. Used by the parallel segmentation.
+     * @param point The voxel index
+     */
+    virtual bool isSegmentable(int64_t point);
+
+    /**
+     * @brief Returns true if the two neighboring voxels belong to the same grain. Unlike
+     * determineGrouping() this must not modify any data so that it can be called from
+     * several threads at once, and the result must not depend on the order of the voxels.
+     * Used by the parallel segmentation.
+     * @param referencepoint The first voxel index
+     * @param neighborpoint The second voxel index
+     */
+    virtual bool compareVoxels(int64_t referencepoint, int64_t neighborpoint);
+
+    /**
+     * @brief Calls compareVoxels() for 'count' pairs of voxels at once and stores the results
+     * in 'same'. Subclasses can reimplement this to compare the pairs with batched kernels.
+     * Used by the parallel segmentation.
+     */
+    virtual void compareVoxelBatch(const int64_t* referencepoints, const int64_t* neighborpoints, size_t count, bool* same);
+
+    /**
+     * @brief Returns the GrainIds array that the subclass segments into. Used by the parallel segmentation.
+     */
+    virtual int32_t* getGrainIdsPointer();
+
   protected:
     SegmentGrains();
 
+    /**
+     * @brief Segments the volume with a block parallel connected components labeling. Each
+     * z-slab is labeled with a union-find forest, the forests are merged across the slab faces
+     * and the grains are then numbered in the order of their lowest voxel index.
+     */
+    void segmentWithUnionFind();
+
   private:
 
     void dataCheck(bool preflight, size_t voxels, size_t fields, size_t ensembles);
@@ -36,6 +36,9 @@
 
 #include "FindEuclideanDistMap.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
 
@@ -157,7 +160,6 @@ class FindEuclideanMap
               i = (z * xpoints * ypoints) + (y * xpoints) + x;
               if(voxel_NearestNeighbor[i] == -1)
               {
-                count++;
                 for (int j = 0; j < 6; j++)
                 {
                   neighpoint = i + neighbors[j];
@@ -169,6 +171,8 @@ class FindEuclideanMap
                     }
                   }
                 }
+                // Stop once nothing is reached, Cells cut off from every boundary keep -1
+                if(voxel_NearestNeighbor[i] != -1) { count++; }
               }
             }
           }
@@ -209,6 +213,200 @@ class FindEuclideanMap
 
 };
 
+/**
+ * @brief One sweep of the separable exact Euclidean distance transform
+ * (Felzenszwalb & Huttenlocher / Saito & Toriwaki). Each voxel carries the index
+ * of the closest seed voxel found so far. A sweep along an axis replaces that index
+ * with the best one taken from the lower envelope of the parabolas rooted at every
+ * voxel of the same line. Lines are independent so the sweep is parallel over them.
+ * Running the sweep along X, then Y, then Z gives the exact nearest seed, and the
+ * spacing of each axis is honored.
+ */
+class EuclideanDistanceTransformSweep
+{
+  public:
+    EuclideanDistanceTransformSweep(int64_t* nearest, size_t dims[3], float spacing[3], int axis) :
+      m_Nearest(nearest),
+      m_Axis(axis)
+    {
+      for(int i = 0; i < 3; i++)
+      {
+        m_Dims[i] = static_cast<int64_t>(dims[i]);
+        m_Res[i] = static_cast<double>(spacing[i]);
+      }
+    }
+    virtual ~EuclideanDistanceTransformSweep(){}
+
+    /**
+     * @brief Returns the squared distance between the voxels at index a and b
+     */
+    double distanceSquared(int64_t a, int64_t b) const
+    {
+      double dx = m_Res[0] * static_cast<double>((a % m_Dims[0]) - (b % m_Dims[0]));
+      double dy = m_Res[1] * static_cast<double>(((a / m_Dims[0]) % m_Dims[1]) - ((b / m_Dims[0]) % m_Dims[1]));
+      double dz = m_Res[2] * static_cast<double>((a / (m_Dims[0] * m_Dims[1])) - (b / (m_Dims[0] * m_Dims[1])));
+      return dx * dx + dy * dy + dz * dz;
+    }
+
+    int64_t numLines() const
+    {
+      return (m_Dims[0] * m_Dims[1] * m_Dims[2]) / m_Dims[m_Axis];
+    }
+
+    void sweep(size_t start, size_t end) const
+    {
+      int64_t count = m_Dims[m_Axis];
+      int64_t stride = 1;
+      if (m_Axis > 0) { stride *= m_Dims[0]; }
+      if (m_Axis > 1) { stride *= m_Dims[1]; }
+      double h = m_Res[m_Axis];
+
+      // Scratch for one line, reused for every line handled by this range
+      std::vector<int64_t> seeds(count, -1);
+      std::vector<double> f(count, 0.0);
+      std::vector<int64_t> v(count, 0);
+      std::vector<double> z(count + 1, 0.0);
+
+      for (size_t line = start; line < end; ++line)
+      {
+        int64_t first = lineStart(static_cast<int64_t>(line));
+        for (int64_t q = 0; q < count; ++q)
+        {
+          int64_t index = first + q * stride;
+          seeds[q] = m_Nearest[index];
+          if (seeds[q] >= 0) { f[q] = distanceSquared(index, seeds[q]); }
+        }
+
+        // Build the lower envelope of the parabolas h^2(x - q)^2 + f(q)
+        int64_t k = -1;
+        for (int64_t q = 0; q < count; ++q)
+        {
+          if (seeds[q] < 0) { continue; }
+          double pq = h * static_cast<double>(q);
+          double s = 0.0;
+          while (k >= 0)
+          {
+            double pv = h * static_cast<double>(v[k]);
+            s = ((f[q] + pq * pq) - (f[v[k]] + pv * pv)) / (2.0 * (pq - pv));
+            if (s > z[k]) { break; }
+            --k;
+          }
+          ++k;
+          v[k] = q;
+          z[k] = (k == 0) ? -std::numeric_limits<double>::max() : s;
+          z[k + 1] = std::numeric_limits<double>::max();
+        }
+        if (k < 0) { continue; } // No seed is reachable from this line yet
+
+        // Read each voxel's closest seed back off the envelope
+        k = 0;
+        for (int64_t q = 0; q < count; ++q)
+        {
+          double pq = h * static_cast<double>(q);
+          while (z[k + 1] < pq) { ++k; }
+          m_Nearest[first + q * stride] = seeds[v[k]];
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      sweep(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int64_t* m_Nearest;
+    int m_Axis;
+    int64_t m_Dims[3];
+    double m_Res[3];
+
+    /**
+     * @brief Returns the index of the first voxel on the given line of the sweep axis
+     */
+    int64_t lineStart(int64_t line) const
+    {
+      if (m_Axis == 0) { return line * m_Dims[0]; }
+      if (m_Axis == 1) { return (line / m_Dims[0]) * m_Dims[0] * m_Dims[1] + (line % m_Dims[0]); }
+      return line;
+    }
+};
+
+/**
+ * @brief Converts the nearest seed index of each voxel into the distance map value
+ * and copies the neighboring grain id of that seed into the NearestNeighbors array.
+ * When regions are given, voxels whose nearest seed lies in another region are left
+ * alone so they can be redone within their own region.
+ */
+class EuclideanDistanceTransformFinalize
+{
+  public:
+    EuclideanDistanceTransformFinalize(const EuclideanDistanceTransformSweep& metric, int64_t* nearest,
+                                       int32_t* grainIds, int32_t* regions, int32_t* nearestNeighbors, float* distances, int mapType) :
+      m_Metric(metric),
+      m_Nearest(nearest),
+      m_GrainIds(grainIds),
+      m_Regions(regions),
+      m_NearestNeighbors(nearestNeighbors),
+      m_Distances(distances),
+      m_MapType(mapType)
+    {}
+    virtual ~EuclideanDistanceTransformFinalize(){}
+
+    void finalize(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; ++i)
+      {
+        int64_t seed = m_Nearest[i];
+        if (m_GrainIds[i] <= 0 || seed < 0) { continue; }
+        if (NULL != m_Regions && m_Regions[seed] != m_Regions[i]) { continue; }
+        m_Distances[i] = static_cast<float>(sqrt(m_Metric.distanceSquared(static_cast<int64_t>(i), seed)));
+        m_NearestNeighbors[i * 3 + m_MapType] = m_NearestNeighbors[seed * 3 + m_MapType];
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      finalize(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const EuclideanDistanceTransformSweep& m_Metric;
+    int64_t* m_Nearest;
+    int32_t* m_GrainIds;
+    int32_t* m_Regions;
+    int32_t* m_NearestNeighbors;
+    float* m_Distances;
+    int m_MapType;
+};
+
+/**
+ * @brief Runs the X, Y and Z sweeps over the volume so each voxel ends up with the
+ * index of its closest seed, or -1 if there are no seeds.
+ */
+static void findNearestSeeds(int64_t* nearest, size_t dims[3], float spacing[3], bool doParallel)
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    EuclideanDistanceTransformSweep sweep(nearest, dims, spacing, axis);
+    size_t numLines = static_cast<size_t>(sweep.numLines());
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numLines), sweep, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      sweep.sweep(0, numLines);
+    }
+  }
+  (void)(doParallel);
+}
+
 
 // -----------------------------------------------------------------------------
 //
@@ -220,12 +418,14 @@ FindEuclideanDistMap::FindEuclideanDistMap() :
   m_TJEuclideanDistancesArrayName(DREAM3D::CellData::TJEuclideanDistances),
   m_QPEuclideanDistancesArrayName(DREAM3D::CellData::QPEuclideanDistances),
   m_NearestNeighborsArrayName(DREAM3D::CellData::NearestNeighbors),
+  m_CalcManhattanDist(true),
   m_GrainIds(NULL),
   m_NearestNeighbors(NULL),
   m_GBEuclideanDistances(NULL),
   m_TJEuclideanDistances(NULL),
   m_QPEuclideanDistances(NULL)
 {
+  setupFilterParameters();
 }
 
 // -----------------------------------------------------------------------------
@@ -240,6 +440,16 @@ FindEuclideanDistMap::~FindEuclideanDistMap()
 // -----------------------------------------------------------------------------
 void FindEuclideanDistMap::setupFilterParameters()
 {
+  std::vector<FilterParameter::Pointer> parameters;
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Calculate Manhattan Distance");
+    option->setPropertyName("CalcManhattanDist");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
+  setFilterParameters(parameters);
 }
 
 // -----------------------------------------------------------------------------
@@ -250,6 +460,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setCalcManhattanDist( reader->readValue("CalcManhattanDist", getCalcManhattanDist()) );
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -260,6 +471,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
 int FindEuclideanDistMap::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
 {
   writer->openFilterGroup(this, index);
+  writer->writeValue("CalcManhattanDist", getCalcManhattanDist() );
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -403,6 +615,12 @@ void FindEuclideanDistMap::find_euclideandistmap()
     else m_NearestNeighbors[a*3+0] = 0, m_NearestNeighbors[a*3+1] = 0, m_NearestNeighbors[a*3+2] = 0;
   }
 
+  if (m_CalcManhattanDist == false)
+  {
+    find_exacteuclideandistmap();
+    return;
+  }
+
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -429,3 +647,183 @@ void FindEuclideanDistMap::find_euclideandistmap()
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::find_exacteuclideandistmap()
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+
+  int64_t totalPoints = m->getTotalPoints();
+  size_t dims[3] = {0, 0, 0};
+  m->getDimensions(dims);
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  m->getResolution(res);
+
+  // Distances are measured in steps of the finest cell spacing, which is the voxel step
+  // the Manhattan distances are counted in when the resolution is isotropic
+  float minRes = std::min(res[0], std::min(res[1], res[2]));
+  float spacing[3] = {1.0f, 1.0f, 1.0f};
+  for (int i = 0; i < 3; ++i)
+  {
+    if (minRes > 0.0f) { spacing[i] = res[i] / minRes; }
+  }
+
+  float* distances[3] = { m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances };
+
+  // Cells with a GrainId of 0 or less stop the Manhattan propagation, so a Cell only
+  // takes its distance from a boundary Cell that it is connected to
+  std::vector<int32_t> regions;
+  std::vector<int64_t> regionBounds;
+  int32_t numRegions = find_regions(regions, regionBounds);
+  int32_t* regionPtr = (numRegions > 1) ? &(regions.front()) : NULL;
+
+  // A single nearest-seed scratch array and one set of per-line buffers per task
+  // are shared by all three maps instead of a full copy of the volume per map
+  std::vector<int64_t> nearest(totalPoints, -1);
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
+
+  for (int mapType = 0; mapType < 3; ++mapType)
+  {
+    float* dist = distances[mapType];
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      nearest[i] = (dist[i] == 0.0f) ? i : -1;
+    }
+
+    findNearestSeeds(&(nearest.front()), dims, spacing, doParallel);
+
+    EuclideanDistanceTransformSweep metric(&(nearest.front()), dims, spacing, 0);
+    EuclideanDistanceTransformFinalize finalize(metric, &(nearest.front()), m_GrainIds, regionPtr, m_NearestNeighbors, dist, mapType);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), finalize, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      finalize.finalize(0, totalPoints);
+    }
+
+    if (NULL == regionPtr) { continue; }
+    // Redo the regions where some Cell's nearest seed is on the other side of a Cell
+    // with no grain, using only the seeds of the region itself
+    std::vector<bool> redo(numRegions, false);
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      if (regions[i] >= 0 && nearest[i] >= 0 && regions[nearest[i]] != regions[i]) { redo[regions[i]] = true; }
+    }
+    for (int32_t r = 0; r < numRegions; ++r)
+    {
+      if (redo[r] == true) { find_regioneuclideandistmap(regions, &(regionBounds[r * 6]), r, spacing, mapType, doParallel); }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FindEuclideanDistMap::find_regions(std::vector<int32_t> &regions, std::vector<int64_t> &bounds)
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+
+  int64_t totalPoints = m->getTotalPoints();
+  int64_t xPoints = static_cast<int64_t>(m->getXPoints());
+  int64_t yPoints = static_cast<int64_t>(m->getYPoints());
+  int64_t zPoints = static_cast<int64_t>(m->getZPoints());
+  int64_t neighbors[6] = { -xPoints * yPoints, -xPoints, -1, 1, xPoints, xPoints * yPoints };
+
+  regions.assign(totalPoints, -1);
+  bounds.clear();
+  int32_t numRegions = 0;
+  std::vector<int64_t> stack;
+  for (int64_t start = 0; start < totalPoints; ++start)
+  {
+    if (m_GrainIds[start] <= 0 || regions[start] >= 0) { continue; }
+    int64_t box[6] = { xPoints, yPoints, zPoints, -1, -1, -1 };
+    regions[start] = numRegions;
+    stack.push_back(start);
+    while (stack.empty() == false)
+    {
+      int64_t a = stack.back();
+      stack.pop_back();
+      int64_t coords[3] = { a % xPoints, (a / xPoints) % yPoints, a / (xPoints * yPoints) };
+      for (int i = 0; i < 3; ++i)
+      {
+        box[i] = std::min(box[i], coords[i]);
+        box[i + 3] = std::max(box[i + 3], coords[i]);
+      }
+      for (int k = 0; k < 6; ++k)
+      {
+        if (k == 0 && coords[2] == 0) { continue; }
+        if (k == 5 && coords[2] == zPoints - 1) { continue; }
+        if (k == 1 && coords[1] == 0) { continue; }
+        if (k == 4 && coords[1] == yPoints - 1) { continue; }
+        if (k == 2 && coords[0] == 0) { continue; }
+        if (k == 3 && coords[0] == xPoints - 1) { continue; }
+        int64_t neighbor = a + neighbors[k];
+        if (m_GrainIds[neighbor] > 0 && regions[neighbor] < 0)
+        {
+          regions[neighbor] = numRegions;
+          stack.push_back(neighbor);
+        }
+      }
+    }
+    bounds.insert(bounds.end(), box, box + 6);
+    ++numRegions;
+  }
+  return numRegions;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::find_regioneuclideandistmap(const std::vector<int32_t> &regions, const int64_t* bounds, int32_t region,
+                                                       float spacing[3], int mapType, bool doParallel)
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+  int64_t xPoints = static_cast<int64_t>(m->getXPoints());
+  int64_t yPoints = static_cast<int64_t>(m->getYPoints());
+
+  float* distances[3] = { m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances };
+  float* dist = distances[mapType];
+
+  // The transform is run over the bounding box of the region only
+  size_t boxDims[3] = { static_cast<size_t>(bounds[3] - bounds[0] + 1),
+                        static_cast<size_t>(bounds[4] - bounds[1] + 1),
+                        static_cast<size_t>(bounds[5] - bounds[2] + 1) };
+  int64_t boxX = static_cast<int64_t>(boxDims[0]);
+  int64_t boxY = static_cast<int64_t>(boxDims[1]);
+  int64_t boxPoints = boxX * boxY * static_cast<int64_t>(boxDims[2]);
+  std::vector<int64_t> nearest(boxPoints, -1);
+  std::vector<int64_t> globalIndex(boxPoints, 0);
+  for (int64_t l = 0; l < boxPoints; ++l)
+  {
+    int64_t x = bounds[0] + l % boxX;
+    int64_t y = bounds[1] + (l / boxX) % boxY;
+    int64_t z = bounds[2] + l / (boxX * boxY);
+    int64_t g = (z * xPoints * yPoints) + (y * xPoints) + x;
+    globalIndex[l] = g;
+    if (regions[g] == region && dist[g] == 0.0f) { nearest[l] = l; }
+  }
+
+  findNearestSeeds(&(nearest.front()), boxDims, spacing, doParallel);
+
+  EuclideanDistanceTransformSweep metric(&(nearest.front()), boxDims, spacing, 0);
+  for (int64_t l = 0; l < boxPoints; ++l)
+  {
+    int64_t g = globalIndex[l];
+    int64_t seed = nearest[l];
+    if (regions[g] != region || seed < 0) { continue; }
+    dist[g] = static_cast<float>(sqrt(metric.distanceSquared(l, seed)));
+    m_NearestNeighbors[g * 3 + mapType] = m_NearestNeighbors[globalIndex[seed] * 3 + mapType];
+  }
+}
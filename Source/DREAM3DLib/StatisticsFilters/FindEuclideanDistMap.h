@@ -71,6 +71,8 @@ class DREAM3DLib_EXPORT FindEuclideanDistMap : public AbstractFilter
 	DREAM3D_INSTANCE_STRING_PROPERTY(QPEuclideanDistancesArrayName)
 	DREAM3D_INSTANCE_STRING_PROPERTY(NearestNeighborsArrayName)
 
+    DREAM3D_INSTANCE_PROPERTY(bool, CalcManhattanDist)
+
     virtual const std::string getGroupName() { return DREAM3D::FilterGroups::StatisticsFilters; }
 	 virtual const std::string getSubGroupName() { return DREAM3D::FilterSubGroups::MorphologicalFilters; }
     virtual const std::string getHumanLabel() { return "Find Euclidean Distance Map"; }
@@ -101,6 +103,21 @@ class DREAM3DLib_EXPORT FindEuclideanDistMap : public AbstractFilter
     FindEuclideanDistMap();
 
     void find_euclideandistmap();
+    void find_exacteuclideandistmap();
+
+    /**
+     * @brief Labels the 6-connected regions of Cells with a GrainId above 0. Other Cells get -1.
+     * @param regions Receives the region of each Cell
+     * @param bounds Receives the min X, Y, Z and max X, Y, Z Cell of each region
+     * @return The number of regions
+     */
+    int32_t find_regions(std::vector<int32_t> &regions, std::vector<int64_t> &bounds);
+
+    /**
+     * @brief Redoes one distance map over a single region, taking the seeds from that region only
+     */
+    void find_regioneuclideandistmap(const std::vector<int32_t> &regions, const int64_t* bounds, int32_t region,
+                                     float spacing[3], int mapType, bool doParallel);
 
   private:
     int32_t* m_GrainIds;
@@ -35,6 +35,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindGBCD.h"
 
+#include <algorithm>
+#include <vector>
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
@@ -52,46 +54,67 @@ const static float m_pi2 = static_cast<float>(2.0*M_PI);
 
 
 /**
- * @brief The CalculateAreasImpl class
+ * @brief Holds the partial GBCD histogram and the total face area that one thread has
+ * accumulated. The histogram is allocated the first time the thread adds its share of faces.
+ */
+struct GBCDAccumulator
+{
+  GBCDAccumulator() : totalFaceArea(0.0) {}
+  std::vector<double> gbcd;
+  double totalFaceArea;
+};
+
+/**
+ * @brief The CalculateGBCDImpl class adds the area of every face to the GBCD bins of all of
+ * its symmetrically equivalent misorientation/normal pairs. The serial path adds straight into
+ * the GBCD, the parallel path splits each chunk of faces into one even share per histogram and
+ * the histograms are summed into the GBCD once all of the faces are done. The split does not
+ * depend on the thread schedule so neither does the result.
  */
 class CalculateGBCDImpl
 {
-    size_t startOffset;
     int32_t* m_Labels;
     double* m_Normals;
+    double* m_Areas;
     int32_t* m_Phases;
     float* m_Eulers;
-    int32_t* m_Bins;
     float* m_GBCDdeltas;
     int* m_GBCDsizes;
     float* m_GBCDlimits;
+    size_t m_TotalBins;
     unsigned int* m_CrystalStructures;
     std::vector<OrientationOps::Pointer> m_OrientationOps;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    std::vector<GBCDAccumulator>* m_ThreadGBCD;
+    size_t m_FaceStart;
+    size_t m_FaceEnd;
+#endif
 
   public:
-    CalculateGBCDImpl(size_t i, int32_t* Labels, double* Normals, float* Eulers, int32_t* Phases, unsigned int* CrystalStructures,
-                      int32_t* Bins, float* GBCDdeltas, int* GBCDsizes, float* GBCDlimits) :
-      startOffset(i),
+    CalculateGBCDImpl(int32_t* Labels, double* Normals, double* Areas, float* Eulers, int32_t* Phases, unsigned int* CrystalStructures,
+                      float* GBCDdeltas, int* GBCDsizes, float* GBCDlimits, size_t totalBins) :
       m_Labels(Labels),
       m_Normals(Normals),
+      m_Areas(Areas),
       m_Phases(Phases),
       m_Eulers(Eulers),
-      m_Bins(Bins),
       m_GBCDdeltas(GBCDdeltas),
       m_GBCDsizes(GBCDsizes),
       m_GBCDlimits(GBCDlimits),
+      m_TotalBins(totalBins),
       m_CrystalStructures(CrystalStructures)
     {
       m_OrientationOps = OrientationOps::getOrientationOpsVector();
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      m_ThreadGBCD = NULL;
+      m_FaceStart = 0;
+      m_FaceEnd = 0;
+#endif
     }
     virtual ~CalculateGBCDImpl(){}
 
-    void generate(size_t start, size_t end) const
+    void generate(size_t start, size_t end, double* gbcd, double &totalFaceArea) const
     {
-
-      //DREAM3D::SurfaceMesh::Vert_t* nodes = m_Nodes->GetPointer(0);
-      //DREAM3D::SurfaceMesh::Face_t* triangles = m_Triangles->GetPointer(0);
-
       int j;//, j4;
       int k;//, k4;
       int m;
@@ -107,17 +130,16 @@ class CalculateGBCDImpl
       float euler_mis[3];
       float normal[3];
       float xstl1_norm0[3], xstl1_norm1[3], xstl1_norm_sc[2], xstl1_norm_sc_inv[2];
-      int SYMcounter=0;
-      int TRIcounter=start-startOffset;
+      double area;
 
       for (size_t i = start; i < end; i++)
       {
-        SYMcounter = 0;
         grain1 = m_Labels[2*i];
         grain2 = m_Labels[2*i+1];
         normal[0] = m_Normals[3*i];
         normal[1] = m_Normals[3*i+1];
         normal[2] = m_Normals[3*i+2];
+        area = m_Areas[i];
         if(m_Phases[grain1] == m_Phases[grain2])
         {
           unsigned int cryst = m_CrystalStructures[m_Phases[grain1]];
@@ -181,39 +203,53 @@ class CalculateGBCDImpl
                   gbcd_index = GBCDIndex (m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, xstl1_norm_sc);
                   if (gbcd_index != -1)
                   {
-                    // Add the points and up the count on the gbcd histograms.  Broke this out
-                    // so that it could be protected in an openMP thread
-                    {
-                      m_Bins[(TRIcounter*576)+SYMcounter] = gbcd_index;
-                    }
+                    gbcd[gbcd_index] += area;
+                    totalFaceArea += area;
                   }
-                  SYMcounter++;
                   //if inversion is on, do the same for that
                   if (inversion == 1)
                   {
                     gbcd_index = GBCDIndex (m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, xstl1_norm_sc_inv);
                     if (gbcd_index != -1)
                     {
-                      {
-                        m_Bins[(TRIcounter*576)+SYMcounter] = gbcd_index;
-                      }
+                      gbcd[gbcd_index] += area;
+                      totalFaceArea += area;
                     }
                   }
-                  SYMcounter++;
                 }
-                else SYMcounter += 2;
               }
             }
           }
         }
-        TRIcounter++;
       }
     }
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void setThreadGBCD(std::vector<GBCDAccumulator>* threadGBCD)
+    {
+      m_ThreadGBCD = threadGBCD;
+    }
+
+    void setFaceRange(size_t start, size_t end)
+    {
+      m_FaceStart = start;
+      m_FaceEnd = end;
+    }
+
+    // The range is over the histograms, each one gets an even share of the current faces
     void operator()(const tbb::blocked_range<size_t> &r) const
     {
-      generate(r.begin(), r.end());
+      size_t numShares = m_ThreadGBCD->size();
+      size_t numFaces = m_FaceEnd - m_FaceStart;
+      for (size_t t = r.begin(); t < r.end(); ++t)
+      {
+        GBCDAccumulator& local = (*m_ThreadGBCD)[t];
+        if (local.gbcd.empty() == true)
+        {
+          local.gbcd.resize(m_TotalBins, 0.0);
+        }
+        generate(m_FaceStart + numFaces * t / numShares, m_FaceStart + numFaces * (t + 1) / numShares, &(local.gbcd.front()), local.totalFaceArea);
+      }
     }
 #endif
 
@@ -265,6 +301,7 @@ class CalculateGBCDImpl
 };
 
 
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -279,6 +316,8 @@ FindGBCD::FindGBCD() :
   m_GBCDArrayName(DREAM3D::EnsembleData::GBCD),
   m_GBCDTextFile(""),
   m_GBCDRes(9.0),
+  m_ThreadHistogramMemory(256 * 1024 * 1024),
+  m_NumThreads(0),
   m_SurfaceMeshFaceAreas(NULL),
   m_SurfaceMeshFaceLabels(NULL),
   m_SurfaceMeshFaceNormals(NULL),
@@ -425,6 +464,18 @@ void FindGBCD::preflight()
   dataCheckVoxel(true, 1, 1, 1);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FindGBCD::ThreadsForHistograms(size_t histogramBytes, size_t numThreads, uint64_t memory)
+{
+  if (histogramBytes * numThreads > memory)
+  {
+    numThreads = std::max<size_t>(static_cast<size_t>(memory / histogramBytes), 1);
+  }
+  return numThreads;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -451,7 +502,7 @@ void FindGBCD::execute()
   notifyStatusMessage("Starting");
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
+  tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
   bool doParallel = true;
 #endif
 
@@ -469,13 +520,9 @@ void FindGBCD::execute()
 
   dataCheckVoxel(false, 0, totalFields, totalEnsembles);
 
-  size_t faceChunkSize = 100000;
-  if(totalFaces < faceChunkSize) faceChunkSize = totalFaces;
-
   FloatArrayType::Pointer gbcdDeltasArray = FloatArrayType::NullPointer();
   FloatArrayType::Pointer gbcdLimitsArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer gbcdSizesArray = Int32ArrayType::NullPointer();
-  Int32ArrayType::Pointer gbcdBinsArray = Int32ArrayType::NullPointer();
   gbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
   gbcdDeltasArray->SetNumberOfComponents(1);
   gbcdDeltasArray->initializeWithZeros();
@@ -485,12 +532,9 @@ void FindGBCD::execute()
   gbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   gbcdSizesArray->SetNumberOfComponents(1);
   gbcdSizesArray->initializeWithZeros();
-  gbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, 576, "GBCDBins");
-  gbcdBinsArray->initializeWithZeros();
   float* m_GBCDdeltas = gbcdDeltasArray->GetPointer(0);
   int32_t* m_GBCDsizes = gbcdSizesArray->GetPointer(0);
   float* m_GBCDlimits = gbcdLimitsArray->GetPointer(0);
-  int32_t* m_Bins = gbcdBinsArray->GetPointer(0);
 
   //Original Ranges from Dave R.
   //m_GBCDlimits[0] = 0.0;
@@ -532,6 +576,27 @@ void FindGBCD::execute()
 
   CREATE_NON_PREREQ_DATA(sm, DREAM3D, EnsembleData, GBCD, ss, double, DoubleArrayType, 0, m->getNumEnsembleTuples(), m_GBCDsizes[0]*m_GBCDsizes[1]*m_GBCDsizes[2]*m_GBCDsizes[3]*m_GBCDsizes[4])
 
+  size_t totalBins = m_GBCDsizes[0]*m_GBCDsizes[1]*m_GBCDsizes[2]*m_GBCDsizes[3]*m_GBCDsizes[4];
+  // The faces are only processed in chunks so that progress can be reported and the filter
+  // canceled, the faces are added straight into the histograms so no memory is needed per face.
+  size_t numThreads = 1;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  // Every thread adds into its own copy of the histogram. Only start as many threads as
+  // there are copies that fit in the memory budget, fine resolutions end up with fewer threads.
+  numThreads = (m_NumThreads > 0) ? static_cast<size_t>(m_NumThreads) : static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+  numThreads = ThreadsForHistograms(totalBins * sizeof(double), numThreads, m_ThreadHistogramMemory);
+  if (numThreads == 1) { doParallel = false; }
+  else { init.initialize(static_cast<int>(numThreads)); }
+  std::vector<GBCDAccumulator> threadGBCD(doParallel == true ? numThreads : 0);
+#endif
+  size_t faceChunkSize = std::max<size_t>(totalFaces / 100, 10000 * numThreads);
+  if(totalFaces < faceChunkSize) faceChunkSize = totalFaces;
+
+  CalculateGBCDImpl gbcdImpl(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_SurfaceMeshFaceAreas, m_FieldEulerAngles, m_FieldPhases, m_CrystalStructures, m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, totalBins);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  gbcdImpl.setThreadGBCD(&threadGBCD);
+#endif
+
       uint64_t millis = MXA::getMilliSeconds();
   uint64_t currentMillis = millis;
   uint64_t startMillis = millis;
@@ -553,19 +618,16 @@ void FindGBCD::execute()
     {
       faceChunkSize = totalFaces-i;
     }
-    gbcdBinsArray->initializeWithValues(-1);
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
     if (doParallel == true)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i+faceChunkSize),
-                        CalculateGBCDImpl(i, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_FieldEulerAngles, m_FieldPhases, m_CrystalStructures, m_Bins, m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits), tbb::auto_partitioner());
-
+      gbcdImpl.setFaceRange(i, i+faceChunkSize);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numThreads, 1), gbcdImpl);
     }
     else
 #endif
     {
-      CalculateGBCDImpl serial(i, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_FieldEulerAngles, m_FieldPhases, m_CrystalStructures, m_Bins, m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits);
-      serial.generate(i, i+faceChunkSize);
+      gbcdImpl.generate(i, i+faceChunkSize, m_GBCD, totalFaceArea);
     }
 
     ss.str("");
@@ -581,27 +643,26 @@ void FindGBCD::execute()
       lastIteration = i;
     }
     notifyStatusMessage(ss.str());
+  }
 
-    for(int j=0;j<faceChunkSize;j++)
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  // Sum the histograms in a fixed order so the GBCD is the same on every run
+  for (size_t t = 0; t < threadGBCD.size(); t++)
+  {
+    for (size_t b = 0; b < threadGBCD[t].gbcd.size(); b++)
     {
-      for(int k=0;k<576;k++)
-      {
-        if(m_Bins[j*576+k] >= 0)
-        {
-          m_GBCD[m_Bins[j*576+k]] += m_SurfaceMeshFaceAreas[i+j];
-          totalFaceArea += m_SurfaceMeshFaceAreas[i+j];
-        }
-      }
+      m_GBCD[b] += threadGBCD[t].gbcd[b];
     }
+    totalFaceArea += threadGBCD[t].totalFaceArea;
   }
+#endif
 
   ss.str("");
   ss << "Starting GBCD Normalization";
   notifyStatusMessage(ss.str());
 
-  int totalBins = m_GBCDsizes[0]*m_GBCDsizes[1]*m_GBCDsizes[2]*m_GBCDsizes[3]*m_GBCDsizes[4];
   double MRDfactor = double(totalBins)/totalFaceArea;
-  for(int i=0;i<totalBins;i++)
+  for(size_t i=0;i<totalBins;i++)
   {
     m_GBCD[i] *= MRDfactor;
   }
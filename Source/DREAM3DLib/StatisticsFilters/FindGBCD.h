@@ -71,6 +71,10 @@ class DREAM3DLib_EXPORT FindGBCD : public SurfaceMeshFilter
     DREAM3D_INSTANCE_STRING_PROPERTY(CrystalStructuresArrayName)
     DREAM3D_INSTANCE_STRING_PROPERTY(GBCDArrayName)
     DREAM3D_INSTANCE_PROPERTY(float, GBCDRes)
+    /* The most memory the per thread histograms may use together, fewer threads are started if they would not fit */
+    DREAM3D_INSTANCE_PROPERTY(uint64_t, ThreadHistogramMemory)
+    /* The number of threads to accumulate the GBCD with, 0 lets TBB decide */
+    DREAM3D_INSTANCE_PROPERTY(int, NumThreads)
 
 
     /* Place your input parameters here. You can use some of the DREAM3D Macros if you want to */
@@ -121,6 +125,15 @@ class DREAM3DLib_EXPORT FindGBCD : public SurfaceMeshFilter
 
     int GBCDIndex (float* gbcddelta, int* gbcdsz, float* gbcdlimits, float* eulerN, float* xstl_norm_sc);
 
+    /**
+    * @brief Returns how many of the requested threads can each have their own histogram
+    * @param histogramBytes The size of one histogram
+    * @param numThreads The number of threads that were asked for
+    * @param memory The most memory all of the histograms may use together
+    * @return A number from 1 to numThreads
+    */
+    static size_t ThreadsForHistograms(size_t histogramBytes, size_t numThreads, uint64_t memory);
+
   protected:
     FindGBCD();
 
@@ -36,11 +36,170 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
 
 #include "DREAM3DLib/GenericFilters/FindCellQuats.h"
 
+/**
+ * @brief Finds the misorientations of the **Cell** pairs that start in one block of
+ * rows of a plane and adds them to the kernel sums of both **Cells** of the pair.
+ * Only half of the kernel offsets are visited, the other half is the same pairs seen
+ * from the other end. The sums and counts are kept for the planes z .. z + kz, which
+ * are stored in a ring by plane % (kz + 1).
+ *
+ * A block of rows writes into the rows up to ky around it, so the blocks are run
+ * as two passes of every other block with blocks at least 2 ky rows high.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+    const int32_t* m_GrainIds;
+    const int32_t* m_CellPhases;
+    const QuatF* m_Quats;
+    const unsigned int* m_CrystalStructures;
+    const std::vector<OrientationOps::Pointer> &m_OrientationOps;
+    const int64_t* m_Dims;
+    const std::vector<int64_t> &m_Offsets;
+    int64_t m_Plane;
+    int64_t m_BlockRows;
+    int64_t m_Parity;
+    double* m_Sums;
+    int32_t* m_Counts;
+    int64_t m_RingPlanes;
+
+  public:
+    FindKernelAvgMisorientationsImpl(const int32_t* grainIds, const int32_t* cellPhases, const QuatF* quats,
+                                     const unsigned int* crystalStructures, const std::vector<OrientationOps::Pointer> &ops,
+                                     const int64_t* dims, const std::vector<int64_t> &offsets, int64_t plane,
+                                     int64_t blockRows, int64_t parity, double* sums, int32_t* counts, int64_t ringPlanes) :
+      m_GrainIds(grainIds),
+      m_CellPhases(cellPhases),
+      m_Quats(quats),
+      m_CrystalStructures(crystalStructures),
+      m_OrientationOps(ops),
+      m_Dims(dims),
+      m_Offsets(offsets),
+      m_Plane(plane),
+      m_BlockRows(blockRows),
+      m_Parity(parity),
+      m_Sums(sums),
+      m_Counts(counts),
+      m_RingPlanes(ringPlanes)
+    {}
+    virtual ~FindKernelAvgMisorientationsImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Dims[0] * m_Dims[1];
+      // Pairs are queued a batch at a time. A pair adds its misorientation to the
+      // ring slots in targetA and targetB, -1 meaning not this end.
+      const size_t batchSize = 256;
+      std::vector<QuatF> q1s(batchSize);
+      std::vector<QuatF> q2s(batchSize);
+      std::vector<float> misos(batchSize);
+      std::vector<int64_t> targetA(batchSize);
+      std::vector<int64_t> targetB(batchSize);
+      size_t batchCount = 0;
+      unsigned int batchPhase = 0;
+
+      for (size_t b = start; b < end; ++b)
+      {
+        int64_t firstRow = (2 * static_cast<int64_t>(b) + m_Parity) * m_BlockRows;
+        int64_t lastRow = std::min(firstRow + m_BlockRows, m_Dims[1]);
+        for (size_t o = 0; o < m_Offsets.size(); o += 3)
+        {
+          int64_t l = m_Offsets[o], k = m_Offsets[o + 1], j = m_Offsets[o + 2];
+          if (m_Plane + j >= m_Dims[2]) { continue; }
+          int64_t firstCol = std::max(static_cast<int64_t>(0), -l);
+          int64_t lastCol = std::min(m_Dims[0], m_Dims[0] - l);
+          for (int64_t row = std::max(firstRow, -k); row < lastRow && row + k < m_Dims[1]; ++row)
+          {
+            int64_t rowStart = m_Plane * planeSize + row * m_Dims[0];
+            int64_t ringRowA = (m_Plane % m_RingPlanes) * planeSize + row * m_Dims[0];
+            int64_t ringRowB = ((m_Plane + j) % m_RingPlanes) * planeSize + (row + k) * m_Dims[0] + l;
+            for (int64_t col = firstCol; col < lastCol; ++col)
+            {
+              int64_t point = rowStart + col;
+              int64_t neighbor = point + j * planeSize + k * m_Dims[0] + l;
+              int32_t grain = m_GrainIds[point];
+              if (grain <= 0 || m_GrainIds[neighbor] != grain) { continue; }
+              bool endA = m_CellPhases[point] > 0;
+              bool endB = (point != neighbor && m_CellPhases[neighbor] > 0);
+              if (endA == false && endB == false) { continue; }
+              unsigned int phaseA = endA ? m_CrystalStructures[m_CellPhases[point]] : 0;
+              unsigned int phaseB = endB ? m_CrystalStructures[m_CellPhases[neighbor]] : 0;
+              int64_t slotA = endA ? ringRowA + col : -1;
+              int64_t slotB = endB ? ringRowB + col : -1;
+              if (endA == true) { m_Counts[slotA]++; }
+              if (endB == true) { m_Counts[slotB]++; }
+              if (endA == true && endB == true && phaseA != phaseB)
+              {
+                // Each end measures with its own symmetry
+                queue(point, neighbor, phaseA, slotA, -1, q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+                queue(neighbor, point, phaseB, slotB, -1, q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+              }
+              else if (endA == true)
+              {
+                queue(point, neighbor, phaseA, slotA, slotB, q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+              }
+              else
+              {
+                queue(neighbor, point, phaseB, slotB, -1, q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+              }
+            }
+          }
+        }
+      }
+      flush(q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+    }
+
+    void queue(int64_t first, int64_t second, unsigned int phase, int64_t slotA, int64_t slotB,
+               std::vector<QuatF> &q1s, std::vector<QuatF> &q2s, std::vector<float> &misos,
+               std::vector<int64_t> &targetA, std::vector<int64_t> &targetB, size_t &batchCount, unsigned int &batchPhase) const
+    {
+      if (batchCount > 0 && (phase != batchPhase || batchCount == q1s.size()))
+      {
+        flush(q1s, q2s, misos, targetA, targetB, batchCount, batchPhase);
+      }
+      batchPhase = phase;
+      QuaternionMathF::Copy(m_Quats[first], q1s[batchCount]);
+      QuaternionMathF::Copy(m_Quats[second], q2s[batchCount]);
+      targetA[batchCount] = slotA;
+      targetB[batchCount] = slotB;
+      batchCount++;
+    }
+
+    void flush(std::vector<QuatF> &q1s, std::vector<QuatF> &q2s, std::vector<float> &misos,
+               std::vector<int64_t> &targetA, std::vector<int64_t> &targetB, size_t &batchCount, unsigned int batchPhase) const
+    {
+      if (batchCount == 0) { return; }
+      m_OrientationOps[batchPhase]->getMisoQuatBatch(&(q1s.front()), &(q2s.front()), batchCount, &(misos.front()), NULL);
+      for (size_t v = 0; v < batchCount; ++v)
+      {
+        float w = misos[v] * (180.0f/DREAM3D::Constants::k_Pi);
+        m_Sums[targetA[v]] += w;
+        if (targetB[v] >= 0) { m_Sums[targetB[v]] += w; }
+      }
+      batchCount = 0;
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -169,93 +328,84 @@ void FindKernelAvgMisorientations::execute()
     return;
   }
 
-  QuatF q1;
-  QuatF q2;
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-  int numVoxel; // number of voxels in the grain...
-  int good = 0;
-
-  float w, totalmisorientation;
-  float n1, n2, n3;
-  unsigned int phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  unsigned int phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = {0,0,0};
   m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
+  };
+  int64_t planeSize = dims[0] * dims[1];
+
+  // Half of the kernel: the offset itself and every offset that comes after it in
+  // (z, y, x) order. The opposite offsets are the same pairs seen from the other end.
+  std::vector<int64_t> offsets;
+  for (int j = 0; j < m_KernelSize.z + 1; j++)
+  {
+    for (int k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
+    {
+      for (int l = -m_KernelSize.x; l < m_KernelSize.x + 1; l++)
+      {
+        if (j == 0 && (k < 0 || (k == 0 && l < 0))) { continue; }
+        offsets.push_back(l);
+        offsets.push_back(k);
+        offsets.push_back(j);
+      }
+    }
+  }
+
+  // Sums and counts of the planes z .. z + kz
+  int64_t ringPlanes = m_KernelSize.z + 1;
+  std::vector<double> sums(ringPlanes * planeSize, 0.0);
+  std::vector<int32_t> counts(ringPlanes * planeSize, 0);
+  int64_t blockRows = std::max(static_cast<int64_t>(2 * m_KernelSize.y), static_cast<int64_t>(4));
+  int64_t numBlocks = (dims[1] + blockRows - 1) / blockRows;
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
 #endif
-  DimType xPoints = static_cast<DimType>(udims[0]);
-  DimType yPoints = static_cast<DimType>(udims[1]);
-  DimType zPoints = static_cast<DimType>(udims[2]);
-  DimType point;
-  size_t neighbor = 0;
-//  int m_KernelSize = 1;
-  DimType jStride;
-  DimType kStride;
-  for (DimType col = 0; col < xPoints; col++)
+
+  for (int64_t plane = 0; plane < dims[2]; plane++)
   {
-    for (DimType row = 0; row < yPoints; row++)
+    if (getCancel() == true)
     {
-      for (DimType plane = 0; plane < zPoints; plane++)
+      return;
+    }
+    for (int64_t parity = 0; parity < 2; parity++)
+    {
+      size_t passBlocks = static_cast<size_t>((numBlocks - parity + 1) / 2);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
       {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if (m_GrainIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-//          q1[1] = m_Quats[point*5 + 1];
-//          q1[2] = m_Quats[point*5 + 2];
-//          q1[3] = m_Quats[point*5 + 3];
-//          q1[4] = m_Quats[point*5 + 4];
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for (int j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for (int k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for (int l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = 1;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0) good = 0;
-                else if(plane + j > zPoints - 1) good = 0;
-                else if(row + k < 0) good = 0;
-                else if(row + k > yPoints - 1) good = 0;
-                else if(col + l < 0) good = 0;
-                else if(col + l > xPoints - 1) good = 0;
-                if(good == 1 && m_GrainIds[point] == m_GrainIds[neighbor])
-                {
-                  w = 10000.0;
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-//                  q2[1] = m_Quats[neighbor*5 + 1];
-//                  q2[2] = m_Quats[neighbor*5 + 2];
-//                  q2[3] = m_Quats[neighbor*5 + 3];
-//                  q2[4] = m_Quats[neighbor*5 + 4];
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
-                  w = w *(180.0f/DREAM3D::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0;
-          }
-        }
-        if (m_GrainIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0;
-        }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, passBlocks),
+                          FindKernelAvgMisorientationsImpl(m_GrainIds, m_CellPhases, quats, m_CrystalStructures, m_OrientationOps, dims, offsets,
+                                                           plane, blockRows, parity, &(sums.front()), &(counts.front()), ringPlanes),
+                          tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        FindKernelAvgMisorientationsImpl serial(m_GrainIds, m_CellPhases, quats, m_CrystalStructures, m_OrientationOps, dims, offsets,
+                                                plane, blockRows, parity, &(sums.front()), &(counts.front()), ringPlanes);
+        serial.generate(0, passBlocks);
+      }
+    }
+
+    // Every pair that touches this plane has been seen, so its kernels are complete
+    int64_t ringStart = (plane % ringPlanes) * planeSize;
+    for (int64_t i = 0; i < planeSize; i++)
+    {
+      int64_t point = plane * planeSize + i;
+      m_KernelAverageMisorientations[point] = 0;
+      if (m_GrainIds[point] > 0 && m_CellPhases[point] > 0 && counts[ringStart + i] > 0)
+      {
+        m_KernelAverageMisorientations[point] = static_cast<float>(sums[ringStart + i] / counts[ringStart + i]);
       }
+      sums[ringStart + i] = 0.0;
+      counts[ringStart + i] = 0;
     }
   }
 
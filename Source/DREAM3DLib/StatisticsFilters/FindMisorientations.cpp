@@ -171,19 +171,6 @@ void FindMisorientations::execute()
     return;
   }
 
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int>& neighborlist = *m_NeighborList;
-
-  std::vector<std::vector<float> > misorientationlists;
-
-  float n1 = 0.0f, n2 = 0.0f, n3= 0.0f;
-  //float r1= 0.0f, r2 = 0.0f, r3 = 0.0f;
-  // int mbin = 0;
-  float w;
-  QuatF q1;
-  QuatF q2;
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
 
@@ -192,42 +179,62 @@ void FindMisorientations::execute()
 
   float radToDeg = 180.0/DREAM3D::Constants::k_Pi;
 
+  // The misorientation lists line up with the neighbor lists so they are built
+  // straight into the compact layout with the same offsets
+  std::vector<size_t> offsets(numgrains + 1, 0);
+  for (size_t i = 1; i < numgrains; i++)
+  {
+    offsets[i + 1] = offsets[i] + m_NeighborList->getListSize(static_cast<int>(i));
+  }
+  std::vector<float> misorientations(offsets[numgrains], -1.0f);
+
   size_t nname;
   // float nsa;
-  misorientationlists.resize(numgrains);
+  // The neighbors of a grain that share its phase are gathered so all of their
+  // misorientations are computed with a single batch call
+  std::vector<QuatF> q1s;
+  std::vector<QuatF> q2s;
+  std::vector<float> misos;
+  std::vector<size_t> slots;
   for (size_t i = 1; i < numgrains; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
+    size_t numneighbors = offsets[i + 1] - offsets[i];
+    // The value vector is empty when no grain has any neighbors
+    if (numneighbors == 0) { continue; }
     phase1 = m_CrystalStructures[m_FieldPhases[i]];
-    misorientationlists[i].resize(neighborlist[i].size(), -1.0);
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
+    int* neighbors = m_NeighborList->getListPointer(static_cast<int>(i));
+    float* misorientationlist = &(misorientations.front()) + offsets[i];
+    q1s.clear();
+    q2s.clear();
+    slots.clear();
+    for (size_t j = 0; j < numneighbors; j++)
     {
-      w = 10000.0;
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
+      nname = neighbors[j];
       phase2 = m_CrystalStructures[m_FieldPhases[nname]];
       if (phase1 == phase2)
       {
-        w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w*radToDeg;
+        q1s.push_back(avgQuats[i]);
+        q2s.push_back(avgQuats[nname]);
+        slots.push_back(j);
       }
       else
       {
-        misorientationlists[i][j] = -100;
+        misorientationlist[j] = -100;
       }
     }
+    if (slots.empty() == true) { continue; }
+    misos.resize(slots.size());
+    m_OrientationOps[phase1]->getMisoQuatBatch(&(q1s.front()), &(q2s.front()), slots.size(), &(misos.front()), NULL);
+    for (size_t j = 0; j < slots.size(); j++)
+    {
+      misorientationlist[slots[j]] = misos[j]*radToDeg;
+    }
   }
 
   // We do this to create new set of MisorientationList objects
   dataCheck(false, m->getNumCellTuples(), m->getNumFieldTuples(), m->getNumEnsembleTuples());
 
-  for (size_t i = 1; i < m->getNumFieldTuples(); i++)
-  {
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<float>::SharedVectorType misoL(new std::vector<float>);
-    misoL->assign(misorientationlists[i].begin(), misorientationlists[i].end());
-    m_MisorientationList->setList(static_cast<int>(i), misoL);
-  }
+  m_MisorientationList->setCompactLists(offsets, misorientations);
 
   notifyStatusMessage("FindMisorientations Completed");
 }
@@ -36,13 +36,69 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/CentroidGrid.h"
 #include "DREAM3DLib/StatisticsFilters/FindSizes.h"
 #include "DREAM3DLib/GenericFilters/FindGrainPhases.h"
 #include "DREAM3DLib/GenericFilters/FindGrainCentroids.h"
 
+/**
+ * @brief Finds the neighborhood of each **Field**: the other **Fields** whose centroid
+ * bin is less than the critical distance of the **Field** away along every axis. Each
+ * **Field** only writes its own list so the **Fields** can be handled concurrently.
+ */
+class FindNeighborhoodsImpl
+{
+  public:
+    FindNeighborhoodsImpl(const CentroidGrid* grid, const float* centroids, const float* criticalDistance,
+                          int32_t* neighborhoods, NeighborList<int>::SharedVectorType* lists) :
+      m_Grid(grid),
+      m_Centroids(centroids),
+      m_CriticalDistance(criticalDistance),
+      m_Neighborhoods(neighborhoods),
+      m_Lists(lists)
+    {}
+    virtual ~FindNeighborhoodsImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      int cell[3];
+      for (size_t i = start; i < end; ++i)
+      {
+        NeighborList<int>::SharedVectorType list(new std::vector<int>);
+        int criticalDistance = static_cast<int>(m_CriticalDistance[i]);
+        m_Grid->getCell(m_Centroids + 3 * i, cell);
+        m_Grid->findInCellRange(cell, criticalDistance - 1, *list);
+        list->erase(std::remove(list->begin(), list->end(), static_cast<int>(i)), list->end());
+        std::sort(list->begin(), list->end());
+        m_Neighborhoods[i] = static_cast<int32_t>(list->size());
+        m_Lists[i] = list;
+      }
+    }
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const CentroidGrid* m_Grid;
+    const float* m_Centroids;
+    const float* m_CriticalDistance;
+    int32_t* m_Neighborhoods;
+    NeighborList<int>::SharedVectorType* m_Lists;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -200,17 +256,12 @@ void FindNeighborhoods::execute()
 // -----------------------------------------------------------------------------
 void FindNeighborhoods::find_neighborhoods()
 {
-  std::stringstream ss;
   VoxelDataContainer* m = getVoxelDataContainer();
 
-  float x, y, z;
-
-  std::vector<std::vector<int> > neighborhoodlist;
   std::vector<float> criticalDistance;
 
-  int totalFields = int(m->getNumFieldTuples());
+  size_t totalFields = m->getNumFieldTuples();
 
-  neighborhoodlist.resize(totalFields);
   criticalDistance.resize(totalFields);
 
   float aveDiam = 0.0f;
@@ -226,69 +277,37 @@ void FindNeighborhoods::find_neighborhoods()
     criticalDistance[i] /= aveDiam;
   }
 
-  float m_OriginX, m_OriginY, m_OriginZ;
-  m->getOrigin(m_OriginX, m_OriginY, m_OriginZ);
+  // The centroids are binned on a grid with the average diameter as the bin size. Only
+  // the bins within the critical distance of a Field need to be searched
+  float origin[3];
+  m->getOrigin(origin);
+  CentroidGrid grid;
+  grid.build(m_Centroids, 1, totalFields, aveDiam, origin);
 
-  int xbin, ybin, zbin; //, bin, bin1, bin2;
-  std::vector<size_t> bins(3*totalFields, 0);
-  for (size_t i = 1; i < totalFields; i++)
+  notifyStatusMessage("Finding Neighborhoods");
+  std::vector<NeighborList<int>::SharedVectorType> neighborhoodlist(totalFields);
+  if (totalFields > 1)
   {
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    xbin = int((x - m_OriginX) / aveDiam);
-    ybin = int((y - m_OriginY) / aveDiam);
-    zbin = int((z - m_OriginZ) / aveDiam);
-    bins[3*i] = xbin;
-    bins[3*i+1] = ybin;
-    bins[3*i+2] = zbin;
-  }
-
-  int bin1x, bin2x, bin1y, bin2y, bin1z, bin2z;
-  int dBinX, dBinY, dBinZ;
-  int criticalDistance1, criticalDistance2;
-  for (size_t i = 1; i < totalFields; i++)
-  {
-    if (i % 1000 == 0)
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if (doParallel == true)
     {
-      ss.str("");
-      ss << "Working On Grain " << i << " of " << totalFields;
-      notifyStatusMessage(ss.str());
+      tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFields),
+                        FindNeighborhoodsImpl(&grid, m_Centroids, &(criticalDistance.front()), m_Neighborhoods, &(neighborhoodlist.front())),
+                        tbb::auto_partitioner());
     }
-    bin1x = bins[3*i];
-    bin1y = bins[3*i+1];
-    bin1z = bins[3*i+2];
-    criticalDistance1 = criticalDistance[i];
-
-    for (size_t j = i + 1; j < totalFields; j++)
+    else
+#endif
     {
-      bin2x = bins[3*j];
-      bin2y = bins[3*j+1];
-      bin2z = bins[3*j+2];
-      criticalDistance2 = criticalDistance[j];
-
-      dBinX = abs(bin2x - bin1x);
-      dBinY = abs(bin2y - bin1y);
-      dBinZ = abs(bin2z - bin1z);
-
-      if (dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
-
-      if (dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
+      FindNeighborhoodsImpl serial(&grid, m_Centroids, &(criticalDistance.front()), m_Neighborhoods, &(neighborhoodlist.front()));
+      serial.generate(1, totalFields);
     }
   }
+
   for (size_t i = 1; i < totalFields; i++)
   {
-    // Set the vector for each list into the NeighborhoodList Object
-    NeighborList<int>::SharedVectorType sharedNeiLst(new std::vector<int>);
-    sharedNeiLst->assign(neighborhoodlist[i].begin(), neighborhoodlist[i].end());
-    m_NeighborhoodList->setList(static_cast<int>(i), sharedNeiLst);
+    // Hand the vector for each list to the NeighborhoodList Object
+    m_NeighborhoodList->setList(static_cast<int>(i), neighborhoodlist[i]);
   }
 }
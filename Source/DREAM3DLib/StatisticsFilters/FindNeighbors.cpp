@@ -37,12 +37,125 @@
 #include "FindNeighbors.h"
 
 #include <sstream>
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/DataArrays/NeighborList.hpp"
 #include "DREAM3DLib/DataArrays/IDataArray.h"
 
+/**
+ * @brief Scans a range of voxels for the faces that two different grains share. Every chunk of
+ * voxels writes the (grain, neighbor) pairs it finds into its own buffer, already sorted and with
+ * the number of shared faces counted, so the chunks can be scanned concurrently and merged later.
+ */
+class FindNeighborsScanImpl
+{
+  public:
+    typedef std::pair<uint64_t, int32_t> EdgeCount;
+
+    FindNeighborsScanImpl(int32_t* grainIds, int8_t* surfaceVoxels, int64_t dims[3], int64_t chunkSize,
+                          std::vector<std::vector<EdgeCount> >& chunkEdges, std::vector<std::vector<int32_t> >& chunkSurfaceGrains) :
+      m_GrainIds(grainIds),
+      m_SurfaceVoxels(surfaceVoxels),
+      m_ChunkSize(chunkSize),
+      m_ChunkEdges(chunkEdges),
+      m_ChunkSurfaceGrains(chunkSurfaceGrains)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~FindNeighborsScanImpl(){}
+
+    static uint64_t edgeKey(int32_t grain, int32_t neighbor)
+    {
+      return (static_cast<uint64_t>(grain) << 32) | static_cast<uint32_t>(neighbor);
+    }
+
+    void scan(size_t start, size_t end) const
+    {
+      int64_t planeSize = m_Dims[0] * m_Dims[1];
+      int64_t totalPoints = planeSize * m_Dims[2];
+      int64_t neighpoints[6] = { -planeSize, -m_Dims[0], -1, 1, m_Dims[0], planeSize };
+      std::vector<uint64_t> keys;
+      for (size_t chunk = start; chunk < end; ++chunk)
+      {
+        keys.clear();
+        std::vector<int32_t>& surfaceGrains = m_ChunkSurfaceGrains[chunk];
+        int64_t last = std::min(static_cast<int64_t>(chunk + 1) * m_ChunkSize, totalPoints);
+        for (int64_t j = static_cast<int64_t>(chunk) * m_ChunkSize; j < last; j++)
+        {
+          int8_t onsurf = 0;
+          int32_t grain = m_GrainIds[j];
+          if(grain > 0)
+          {
+            int64_t column = j % m_Dims[0];
+            int64_t row = (j / m_Dims[0]) % m_Dims[1];
+            int64_t plane = j / planeSize;
+            bool onXYBorder = (column == 0 || column == (m_Dims[0] - 1) || row == 0 || row == (m_Dims[1] - 1));
+            if((onXYBorder == true || plane == 0 || plane == (m_Dims[2] - 1)) && m_Dims[2] != 1)
+            {
+              surfaceGrains.push_back(grain);
+            }
+            if(onXYBorder == true && m_Dims[2] == 1)
+            {
+              surfaceGrains.push_back(grain);
+            }
+            for (int k = 0; k < 6; k++)
+            {
+              if(k == 0 && plane == 0) continue;
+              if(k == 5 && plane == (m_Dims[2] - 1)) continue;
+              if(k == 1 && row == 0) continue;
+              if(k == 4 && row == (m_Dims[1] - 1)) continue;
+              if(k == 2 && column == 0) continue;
+              if(k == 3 && column == (m_Dims[0] - 1)) continue;
+              int32_t neighbor = m_GrainIds[j + neighpoints[k]];
+              if(neighbor != grain && neighbor > 0)
+              {
+                onsurf++;
+                keys.push_back(edgeKey(grain, neighbor));
+              }
+            }
+          }
+          m_SurfaceVoxels[j] = onsurf;
+        }
+
+        // Count the shared faces of each pair of grains
+        std::sort(keys.begin(), keys.end());
+        std::vector<EdgeCount>& edges = m_ChunkEdges[chunk];
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+          if (edges.empty() == false && edges.back().first == keys[i]) { edges.back().second++; }
+          else { edges.push_back(EdgeCount(keys[i], 1)); }
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      scan(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int32_t* m_GrainIds;
+    int8_t* m_SurfaceVoxels;
+    int64_t m_Dims[3];
+    int64_t m_ChunkSize;
+    std::vector<std::vector<EdgeCount> >& m_ChunkEdges;
+    std::vector<std::vector<int32_t> >& m_ChunkSurfaceGrains;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -200,143 +313,112 @@ void FindNeighbors::execute()
     return;
   }
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
   size_t udims[3] = {0,0,0};
   m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
+  int64_t dims[3] = {
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
   };
 
-  DimType neighpoints[6];
-  neighpoints[0] = -dims[0]*dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0]*dims[1];
-
-  float column, row, plane;
-  int grain;
-  size_t nnum;
-  int onsurf = 0;
-  int good = 0;
-  int neighbor = 0;
-
-  //size_t xtalCount = m->getEnsembleData(DREAM3D::EnsembleData::CrystalStructures)->GetNumberOfTuples();
-
-    std::vector<std::vector<int> > neighborlist;
-    std::vector<std::vector<float> > neighborsurfacearealist;
-
-  int nListSize = 100;
-  neighborlist.resize(totalFields);
-  neighborsurfacearealist.resize(totalFields);
   for (int i = 1; i < totalFields; i++)
   {
-    std::stringstream ss;
-    ss << "Finding Neighbors - Initializing Neighbor Lists - " << (static_cast<float>(i)/totalFields)*100 << " Percent Complete";
- //   notifyStatusMessage(ss.str());
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].resize(nListSize, -1.0);
-  m_SurfaceFields[i] = false;
+    m_SurfaceFields[i] = false;
   }
 
-  totalPoints = m->getTotalPoints();
-
-  for (int64_t j = 0; j < totalPoints; j++)
+  // Scan the voxels in chunks that each collect the faces shared by two grains
+  notifyStatusMessage("Finding Neighbors - Determining Neighbor Lists");
+  typedef FindNeighborsScanImpl::EdgeCount EdgeCount;
+  const int64_t chunkSize = 256 * 1024;
+  size_t numChunks = static_cast<size_t>((totalPoints + chunkSize - 1) / chunkSize);
+  std::vector<std::vector<EdgeCount> > chunkEdges(numChunks);
+  std::vector<std::vector<int32_t> > chunkSurfaceGrains(numChunks);
+  FindNeighborsScanImpl scanner(m_GrainIds, m_SurfaceVoxels, dims, chunkSize, chunkEdges, chunkSurfaceGrains);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    std::stringstream ss;
-    ss << "Finding Neighbors - Determining Neighbor Lists - " << (static_cast<float>(j)/totalPoints)*100 << " Percent Complete";
- //   notifyStatusMessage(ss.str());
-    onsurf = 0;
-    grain = m_GrainIds[j];
-    if(grain > 0)
-    {
-      column = static_cast<float>( j % m->getXPoints() );
-      row = static_cast<float>( (j / m->getXPoints()) % m->getYPoints() );
-      plane = static_cast<float>( j / (m->getXPoints() * m->getYPoints()) );
-      if((column == 0 || column == (m->getXPoints() - 1) || row == 0 || row == (m->getYPoints() - 1) || plane == 0 || plane == (m->getZPoints() - 1)) && m->getZPoints() != 1)
-      {
-        m_SurfaceFields[grain] = true;
-      }
-      if((column == 0 || column == (m->getXPoints() - 1) || row == 0 || row == (m->getYPoints() - 1)) && m->getZPoints() == 1)
-      {
-        m_SurfaceFields[grain] = true;
-      }
-      for (int k = 0; k < 6; k++)
-      {
-        good = 1;
-        neighbor = static_cast<int>( j + neighpoints[k] );
-        if(k == 0 && plane == 0) good = 0;
-        if(k == 5 && plane == (m->getZPoints() - 1)) good = 0;
-        if(k == 1 && row == 0) good = 0;
-        if(k == 4 && row == (m->getYPoints() - 1)) good = 0;
-        if(k == 2 && column == 0) good = 0;
-        if(k == 3 && column == (m->getXPoints() - 1)) good = 0;
-        if(good == 1 && m_GrainIds[neighbor] != grain && m_GrainIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[grain];
-          neighborlist[grain].push_back(m_GrainIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[grain] = static_cast<int32_t>(nnum);
-        }
-      }
-    }
-    m_SurfaceVoxels[j] = onsurf;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), scanner, tbb::auto_partitioner());
   }
-
-  // We do this to create new set of NeighborList objects
-  dataCheck(false, totalPoints, totalFields, m->getNumEnsembleTuples());
-
-  for (size_t i = 1; i < m->getNumFieldTuples(); i++)
+  else
+#endif
   {
-    std::stringstream ss;
-    ss << "Finding Neighbors - Calculating Surface Areas - " << ((float)i/totalFields)*100 << " Percent Complete";
-  //  notifyStatusMessage(ss.str());
-
-    std::map<int, int> neighToCount;
-    int numneighs = static_cast<int>( neighborlist[i].size() );
+    scanner.scan(0, numChunks);
+  }
 
-    // this increments the voxel counts for each grain
-    for (int j = 0; j < numneighs; j++)
+  // Merge the chunks. Sorting orders the pairs by grain and then by neighbor so the
+  // counts of a pair that was seen by several chunks end up next to each other.
+  notifyStatusMessage("Finding Neighbors - Merging Neighbor Lists");
+  size_t totalEdges = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    totalEdges += chunkEdges[c].size();
+    for (size_t g = 0; g < chunkSurfaceGrains[c].size(); ++g)
     {
-      neighToCount[neighborlist[i][j]]++;
+      m_SurfaceFields[chunkSurfaceGrains[c][g]] = true;
     }
+    std::vector<int32_t>().swap(chunkSurfaceGrains[c]);
+  }
+  std::vector<EdgeCount> edges;
+  edges.reserve(totalEdges);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    edges.insert(edges.end(), chunkEdges[c].begin(), chunkEdges[c].end());
+    std::vector<EdgeCount>().swap(chunkEdges[c]);
+  }
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
+  {
+    tbb::parallel_sort(edges.begin(), edges.end());
+  }
+  else
+#endif
+  {
+    std::sort(edges.begin(), edges.end());
+  }
 
-    neighToCount.erase(0);
-    neighToCount.erase(-1);
-    //Resize the grains neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for (std::map<int, int>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+  // Build the lists in the compact layout, the neighbors of each grain are in increasing order
+  float xRes = m->getXRes();
+  float yRes = m->getYRes();
+  std::vector<size_t> offsets(totalFields + 1, 0);
+  std::vector<int> neighbors;
+  std::vector<float> sharedAreas;
+  neighbors.reserve(edges.size());
+  sharedAreas.reserve(edges.size());
+  for (size_t e = 0; e < edges.size(); )
+  {
+    int32_t grain = static_cast<int32_t>(edges[e].first >> 32);
+    int32_t number = 0;
+    size_t next = e;
+    while (next < edges.size() && edges[next].first == edges[e].first)
     {
-      int neigh = iter->first; // get the neighbor grain
-      int number = iter->second; // get the number of voxels
-      float area = number * m->getXRes() * m->getYRes();
-
-      // Push the neighbor grain id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      number += edges[next].second;
+      ++next;
     }
-    m_NumNeighbors[i] = int32_t( neighborlist[i].size() );
+    neighbors.push_back(static_cast<int32_t>(edges[e].first & 0xFFFFFFFF));
+    // Same order of multiplication as before so the areas match to the last bit
+    sharedAreas.push_back(number * xRes * yRes);
+    offsets[grain + 1]++;
+    e = next;
+  }
+  std::vector<EdgeCount>().swap(edges);
+  for (int i = 0; i < totalFields; i++)
+  {
+    offsets[i + 1] += offsets[i];
+    m_NumNeighbors[i] = static_cast<int32_t>(offsets[i + 1] - offsets[i]);
+  }
 
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int>::SharedVectorType sharedNeiLst(new std::vector<int>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    m_NeighborList->setList(static_cast<int>(i), sharedNeiLst);
+  // We do this to create new set of NeighborList objects
+  dataCheck(false, totalPoints, totalFields, m->getNumEnsembleTuples());
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    m_SharedSurfaceAreaList->setList(static_cast<int>(i), sharedSAL);
-  }
+  std::vector<size_t> areaOffsets(offsets);
+  m_NeighborList->setCompactLists(offsets, neighbors);
+  m_SharedSurfaceAreaList->setCompactLists(areaOffsets, sharedAreas);
 
  notifyStatusMessage("Finding Neighbors Complete");
 }
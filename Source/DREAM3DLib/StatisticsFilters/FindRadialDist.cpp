@@ -38,18 +38,111 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 #include "MXA/Utilities/MXAFileInfo.h"
 #include "MXA/Utilities/MXADir.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/CentroidGrid.h"
 #include "DREAM3DLib/GenericFilters/FindGrainPhases.h"
 #include "DREAM3DLib/GenericFilters/FindSurfaceGrains.h"
 #include "DREAM3DLib/GenericFilters/FindGrainCentroids.h"
 #include "DREAM3DLib/StatisticsFilters/FindSizes.h"
 
+/**
+ * @brief Counts, for the **Fields** of a block, the other **Fields** in each distance bin
+ * out to the distance to the surface. Every block has its own histogram so the blocks
+ * can be counted concurrently and added up in order afterwards.
+ */
+class FindRadialDistImpl
+{
+  public:
+    FindRadialDistImpl(const CentroidGrid* grid, const float* centroids, const float* equivalentDiameters, const int* grains,
+                       size_t numGrains, const float* distToSurface, float binSize, int numbins, int esdStepSize,
+                       size_t numBlocks, std::vector<std::vector<float> >* blockCounts) :
+      m_Grid(grid),
+      m_Centroids(centroids),
+      m_EquivalentDiameters(equivalentDiameters),
+      m_Grains(grains),
+      m_NumGrains(numGrains),
+      m_DistToSurface(distToSurface),
+      m_BinSize(binSize),
+      m_NumBins(numbins),
+      m_ESDStepSize(esdStepSize),
+      m_NumBlocks(numBlocks),
+      m_BlockCounts(blockCounts)
+    {}
+    virtual ~FindRadialDistImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      std::vector<int> found;
+      float x, y, z;
+      float xn, yn, zn;
+      float dist;
+      for (size_t b = start; b < end; ++b)
+      {
+        std::vector<float>& counts = (*m_BlockCounts)[b];
+        size_t first = b * m_NumGrains / m_NumBlocks;
+        size_t last = (b + 1) * m_NumGrains / m_NumBlocks;
+        for (size_t t = first; t < last; ++t)
+        {
+          int i = m_Grains[t];
+          int limit = int(m_DistToSurface[i]/m_BinSize);
+          if (limit <= 0) { continue; }
+          found.clear();
+          // A little extra radius so rounding can not leave out a Field the test below keeps
+          m_Grid->findInRadius(m_Centroids + 3 * i, float(limit) * m_BinSize * 1.001f, found);
+          x = m_Centroids[3*i];
+          y = m_Centroids[3*i+1];
+          z = m_Centroids[3*i+2];
+          size_t row = size_t(m_EquivalentDiameters[i]/m_ESDStepSize) * m_NumBins;
+          for (size_t f = 0; f < found.size(); ++f)
+          {
+            int j = found[f];
+            if (j == i) { continue; }
+            xn = m_Centroids[3*j];
+            yn = m_Centroids[3*j+1];
+            zn = m_Centroids[3*j+2];
+            dist = ((x - xn)*(x - xn))+((y - yn)*(y - yn))+((z - zn)*(z - zn));
+            dist = sqrt(dist);
+            if(int(dist/m_BinSize) < limit)
+            {
+              counts[row + int(dist/m_BinSize)]++;
+            }
+          }
+        }
+      }
+    }
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const CentroidGrid* m_Grid;
+    const float* m_Centroids;
+    const float* m_EquivalentDiameters;
+    const int* m_Grains;
+    size_t m_NumGrains;
+    const float* m_DistToSurface;
+    float m_BinSize;
+    int m_NumBins;
+    int m_ESDStepSize;
+    size_t m_NumBlocks;
+    std::vector<std::vector<float> >* m_BlockCounts;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -210,8 +303,6 @@ void FindRadialDist::find_radialdist()
 {
   VoxelDataContainer* m = getVoxelDataContainer();
 
-  float x, y, z;
-  float xn, yn, zn;
   float dist;
   size_t numgrains = m->getNumFieldTuples();
 
@@ -273,10 +364,12 @@ void FindRadialDist::find_radialdist()
     count[i].resize(numbins,0);
     volume[i].resize(numbins,0);
   }
+  std::vector<int> grains;
   for (size_t i = 1; i < numgrains; i++)
   {
     if(m_SurfaceFields[i] == false)
     {
+      grains.push_back(static_cast<int>(i));
       for(int j = 0; j < numbins; j++)
       {
         if(j < int(distToSurface[i]/binSize))
@@ -284,26 +377,47 @@ void FindRadialDist::find_radialdist()
           volume[int(m_EquivalentDiameters[i]/ESDStepSize)][j] = volume[int(m_EquivalentDiameters[i]/ESDStepSize)][j] + ((4.0/3.0)*DREAM3D::Constants::k_Pi*float((j+1)*binSize)*float((j+1)*binSize)*float((j+1)*binSize)) - ((4.0/3.0)*DREAM3D::Constants::k_Pi*float(j*binSize)*float(j*binSize)*float(j*binSize));
         }
       }
-      x = m_Centroids[3*i];
-      y = m_Centroids[3*i+1];
-      z = m_Centroids[3*i+2];
-      for (size_t j = 1; j < numgrains; j++)
+    }
+  }
+
+  // Only the Fields within the distance to the surface of a Field are counted, so the
+  // centroids are put on a grid with about one Field per cell and only the cells
+  // around each Field are searched
+  if (grains.empty() == false)
+  {
+    float extent = (boundbox[2] - boundbox[1]) * (boundbox[4] - boundbox[3]) * (boundbox[6] - boundbox[5]);
+    float cellSize = powf(extent / float(grains.size()), 1.0f / 3.0f);
+    if (cellSize < binSize) { cellSize = binSize; }
+    float origin[3] = { boundbox[1], boundbox[3], boundbox[5] };
+    CentroidGrid grid;
+    grid.build(m_Centroids, 1, numgrains, cellSize, origin, m_SurfaceFields);
+
+    size_t numBlocks = std::min<size_t>(grains.size(), 64);
+    std::vector<std::vector<float> > blockCounts(numBlocks, std::vector<float>(sizebins * numbins, 0.0f));
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if (doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1),
+                        FindRadialDistImpl(&grid, m_Centroids, m_EquivalentDiameters, &(grains.front()), grains.size(),
+                                           &(distToSurface.front()), binSize, numbins, ESDStepSize, numBlocks, &blockCounts),
+                        tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FindRadialDistImpl serial(&grid, m_Centroids, m_EquivalentDiameters, &(grains.front()), grains.size(),
+                                &(distToSurface.front()), binSize, numbins, ESDStepSize, numBlocks, &blockCounts);
+      serial.generate(0, numBlocks);
+    }
+    for (size_t b = 0; b < numBlocks; b++)
+    {
+      for (int i = 0; i < sizebins; i++)
       {
-        if(m_SurfaceFields[j] == false && i != j)
+        for (int j = 0; j < numbins; j++)
         {
-          xn = m_Centroids[3*j];
-          yn = m_Centroids[3*j+1];
-          zn = m_Centroids[3*j+2];
-          dist = ((x - xn)*(x - xn))+((y - yn)*(y - yn))+((z - zn)*(z - zn));
-          dist = sqrt(dist);
-          if(int(dist/binSize) < int(distToSurface[i]/binSize))
-          {
-            count[int(m_EquivalentDiameters[i]/ESDStepSize)][int(dist/binSize)]++;
-          }
-          //if(dist < distToSurface[j])
-          //{
-          // count[int(m_EquivalentDiameters[j])][int(dist/m_EquivalentDiameters[j])]++;
-          //}
+          count[i][j] += blockCounts[b][i * numbins + j];
         }
       }
     }
@@ -37,16 +37,8 @@
 #include "GenerateUniqueEdges.h"
 
 
-#include <set>
-
-
 #include "DREAM3DLib/DataArrays/ManagedArrayOfArrays.hpp"
-
-
-
-typedef std::set<int64_t>  EdgeSet_t;
-typedef EdgeSet_t::iterator EdgesIdSetIterator_t;
-
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshKeyGroups.hpp"
 
 
 
@@ -190,54 +182,21 @@ void GenerateUniqueEdges::generateUniqueEdgeIds()
   SurfaceMeshDataContainer* sm = getSurfaceMeshDataContainer();
 
   DREAM3D::SurfaceMesh::FaceListPointer_t trianglesPtr = sm->getFaces();
-  size_t totalPoints = trianglesPtr->GetNumberOfTuples();
-  DREAM3D::SurfaceMesh::Face_t* faces = trianglesPtr->GetPointer(0);
 
   notifyStatusMessage("Stage 1 of 2");
-  struct  { int32_t v0; int32_t v1; } edge;
-  int64_t* u64Edge = reinterpret_cast<int64_t*>(&edge); // This pointer is a 64 bit integer interpretation of the above struct variable
-
-
-  EdgeSet_t uedges_id_set;
-  for(size_t t = 0; t < totalPoints; ++t)
-  {
-    //Get the Triangle
-    DREAM3D::SurfaceMesh::Face_t& tri = faces[t];
-
-    //Edge 0
-    int i = 0;
-    edge.v0 = tri.verts[i];
-    edge.v1 = tri.verts[i+1];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[i+1]; edge.v1 = tri.verts[i]; }
-    uedges_id_set.insert(*u64Edge);
-
-    //Edge 1
-    i = 1;
-    edge.v0 = tri.verts[i];
-    edge.v1 = tri.verts[i+1];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[i+1]; edge.v1 = tri.verts[i]; }
-    uedges_id_set.insert(*u64Edge);
-
-    // Edge 2
-    i = 2;
-    edge.v0 = tri.verts[i];
-    edge.v1 = tri.verts[0];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[0]; edge.v1 = tri.verts[i]; }
-    uedges_id_set.insert(*u64Edge);
-
-  }
-
-  notifyStatusMessage("Stage 1 of 2");
- // std::cout << "uedges_id_set size: " << uedges_id_set.size() << std::endl;
-  DataArray<int>::Pointer uniqueEdgesArrayPtr = DataArray<int>::CreateArray(uedges_id_set.size(), 2, m_SurfaceMeshUniqueEdgesArrayName);
+  // Sort the 3 edges of every triangle. Only the unique edges are needed so the
+  // triangle ids are not carried along.
+  MeshKeyGroups::Pointer edgeGroups = MeshKeyGroups::New();
+  edgeGroups->generateFaceEdges(trianglesPtr, false);
+  std::vector<uint64_t>& edgeKeys = edgeGroups->getKeys();
+
+  notifyStatusMessage("Stage 2 of 2");
+  DataArray<int>::Pointer uniqueEdgesArrayPtr = DataArray<int>::CreateArray(edgeKeys.size(), 2, m_SurfaceMeshUniqueEdgesArrayName);
   int32_t* surfaceMeshUniqueEdges = uniqueEdgesArrayPtr->GetPointer(0);
-  int index = 0;
-  for(EdgeSet_t::iterator iter = uedges_id_set.begin(); iter != uedges_id_set.end(); ++iter)
+  for(size_t index = 0; index < edgeKeys.size(); ++index)
   {
-    *u64Edge = *iter;
-    surfaceMeshUniqueEdges[index*2] = edge.v0;
-    surfaceMeshUniqueEdges[index*2 + 1] = edge.v1;
-    ++index;
+    surfaceMeshUniqueEdges[index*2] = MeshKeyGroups::PairKeyLow(edgeKeys[index]);
+    surfaceMeshUniqueEdges[index*2 + 1] = MeshKeyGroups::PairKeyHigh(edgeKeys[index]);
   }
   sm->addEdgeData(uniqueEdgesArrayPtr->GetName(), uniqueEdgesArrayPtr);
 }
@@ -263,138 +222,60 @@ void GenerateUniqueEdges::generateEdgeTriangleConnectivity()
     notifyErrorMessage("The SurfaceMesh DataContainer Does NOT contain Triangles", -556);
     return;
   }
-  int ntri = trianglesPtr->GetNumberOfTuples();
-
-  // get the triangle definitions - use the pointer to the start of the Struct Array
-  DREAM3D::SurfaceMesh::Face_t* triangles = trianglesPtr->GetPointer(0);
-
-  // need to make a list of triangle edges
-  // each triangle has three edges, made up of two pairs of vertices
-  std::map<int64_t, int> uedges_id_map;
-
-  std::map<int64_t, DREAM3D::SurfaceMesh::UniqueFaceIds_t > edgeTriangleSet;
-
-  int edge_id = 0;
-  int cur_edge_id = 0;
-
-  struct  { int32_t v0; int32_t v1; } edge;
-  int64_t* u64Edge = reinterpret_cast<int64_t*>(&edge); // This pointer is a 64 bit integer interpretation of the above struct variable
 
-  typedef std::map<int64_t, int>::iterator EdgesIdMapIterator_t;
+  // Group the triangles by edge
+  MeshKeyGroups::Pointer edgeGroups = MeshKeyGroups::New();
+  edgeGroups->generateFaceEdges(trianglesPtr);
+  if (getCancel() == true) { return; }
 
-  float curPercent = 0.0;
-  std::stringstream ss;
-
-  for(int i = 0; i < ntri; ++i)
+  notifyStatusMessage("Generating edge list for mesh. Stage 2 of 2");
+  size_t numEdges = edgeGroups->getNumberOfGroups();
+  size_t numTriangles = trianglesPtr->GetNumberOfTuples();
+
+  // The edge ids are handed out in the order the edges first appear, going through edges 0 to 2
+  // of each triangle in turn. The triangles of a group are in ascending order so the first one
+  // is where the edge first appears and only the position of the edge within it is looked up.
+  std::vector<int64_t> groupAtEdgeSlot(numTriangles * 3, -1);
+  for(size_t group = 0; group < numEdges; ++group)
   {
-    if ( static_cast<float>(i)/static_cast<float>(ntri) * 100.0f > (curPercent) )
-    {
-      ss.str("");
-      ss << "Stage 1/2: " << (static_cast<float>(i)/static_cast<float>(ntri) * 100.0f) << "% Complete";
-      notifyStatusMessage(ss.str());
-      curPercent += 5.0f;
-    }
-    if (getCancel() == true) { return; }
-
-    DREAM3D::SurfaceMesh::Face_t& tri = triangles[i];
-    // Edge 0
-    edge.v0 = tri.verts[0];
-    edge.v1 = tri.verts[1];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[1]; edge.v1 = tri.verts[0]; }
-    EdgesIdMapIterator_t iter = uedges_id_map.find(*u64Edge);
-    if ( iter == uedges_id_map.end())
-    {
-       uedges_id_map[*u64Edge] = edge_id;
-       cur_edge_id = edge_id;
-//       tri.e_id[0] = cur_edge_id;
-       ++edge_id;
-    }
-    else
-    {
-//      tri.e_id[0] = (*iter).second;
-    }
-    edgeTriangleSet[*u64Edge].insert(i);
-
-    // Edge 1
-    edge.v0 = tri.verts[1];
-    edge.v1 = tri.verts[2];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[2]; edge.v1 = tri.verts[1]; }
-    iter = uedges_id_map.find(*u64Edge);
-    if ( iter == uedges_id_map.end())
-    {
-       uedges_id_map[*u64Edge] = edge_id;
-       cur_edge_id = edge_id;
-//       tri.e_id[1] = cur_edge_id;
-       ++edge_id;
-    }
-    else
-    {
-//      tri.e_id[1] = (*iter).second;
-    }
-    edgeTriangleSet[*u64Edge].insert(i);
-
-    // Edge 2
-    edge.v0 = tri.verts[2];
-    edge.v1 = tri.verts[0];
-    if (edge.v0 > edge.v1) { edge.v0 = tri.verts[0]; edge.v1 = tri.verts[2]; }
-    iter = uedges_id_map.find(*u64Edge);
-    if ( iter == uedges_id_map.end())
-    {
-       uedges_id_map[*u64Edge] = edge_id;
-       cur_edge_id = edge_id;
-//       tri.e_id[2] = cur_edge_id;
-       ++edge_id;
-    }
-    else
-    {
-//      tri.e_id[2] = (*iter).second;
-    }
-    edgeTriangleSet[*u64Edge].insert(i);
+    int32_t t = edgeGroups->getGroupValues(group)[0];
+    DREAM3D::SurfaceMesh::Face_t& tri = *(trianglesPtr->GetPointer(t));
+    int slot = 0;
+    while (slot < 2 && MeshKeyGroups::PairKey(tri.verts[slot], tri.verts[slot + 1]) != edgeGroups->getKey(group)) { ++slot; }
+    groupAtEdgeSlot[t * 3 + slot] = static_cast<int64_t>(group);
   }
+  std::vector<size_t> groupOfEdge;
+  groupOfEdge.reserve(numEdges);
+  for(size_t i = 0; i < groupAtEdgeSlot.size(); ++i)
+  {
+    if (groupAtEdgeSlot[i] >= 0) { groupOfEdge.push_back(static_cast<size_t>(groupAtEdgeSlot[i])); }
+  }
+  std::vector<int64_t>().swap(groupAtEdgeSlot);
 
-
-  notifyStatusMessage("Generating edge list for mesh. Stage 2 of 2");
-  // Now copy the unique Edges out of the map and into an array at the proper index (which is the "value" that goes with the "key" to the map.
-  int index = 0;
-  DataArray<int>::Pointer uniqueEdgesArrayPtr = DataArray<int>::CreateArray(uedges_id_map.size(), 2, DREAM3D::EdgeData::SurfaceMeshUniqueEdges);
+  DataArray<int>::Pointer uniqueEdgesArrayPtr = DataArray<int>::CreateArray(numEdges, 2, DREAM3D::EdgeData::SurfaceMeshUniqueEdges);
   m_SurfaceMeshUniqueEdges = uniqueEdgesArrayPtr->GetPointer(0);
 
-  ManagedArrayOfArrays<int>::Pointer edgeTriangleArray = ManagedArrayOfArrays<int>::CreateArray(edgeTriangleSet.size(), DREAM3D::EdgeData::SurfaceMeshEdgeFaces);
-
-  float progIndex = 0.0;
-  curPercent = 0.0;
-  float total = static_cast<float>(uedges_id_map.size());
+  ManagedArrayOfArrays<int>::Pointer edgeTriangleArray = ManagedArrayOfArrays<int>::CreateArray(numEdges, DREAM3D::EdgeData::SurfaceMeshEdgeFaces);
 
-
-  for(std::map<int64_t, int>::iterator iter = uedges_id_map.begin(); iter != uedges_id_map.end(); ++iter)
+  for(size_t index = 0; index < numEdges; ++index)
   {
-
-    if ( progIndex/total * 100.0f > (curPercent) )
-    {
-      ss.str("");
-      ss << "Stage 2/2: " << (progIndex/total * 100.0f) << "% Complete";
-      notifyStatusMessage(ss.str());
-      curPercent += 5.0f;
-    }
-    progIndex++;
-    if (getCancel() == true) { return; }
-
-    *u64Edge = iter->first;
-    index = iter->second;
-    m_SurfaceMeshUniqueEdges[index*2] = edge.v0;
-    m_SurfaceMeshUniqueEdges[index*2 + 1] = edge.v1;
+    size_t group = groupOfEdge[index];
+    uint64_t key = edgeGroups->getKey(group);
+    m_SurfaceMeshUniqueEdges[index*2] = MeshKeyGroups::PairKeyLow(key);
+    m_SurfaceMeshUniqueEdges[index*2 + 1] = MeshKeyGroups::PairKeyHigh(key);
 
     ManagedArrayOfArrays<int>::Data_t& entry = *(edgeTriangleArray->GetPointer(index));
-    DREAM3D::SurfaceMesh::UniqueFaceIds_t& triangles = edgeTriangleSet[*u64Edge];
-    // Allocate enough memory to hold the list of triangles
-    entry.count = triangles.size();
-    if (entry.count > 0)
+    // The triangle ids of each group are already in ascending order. A triangle
+    // can not repeat within a group unless it is degenerate so skip any repeats.
+    int32_t* triangles = edgeGroups->getGroupValues(group);
+    size_t count = edgeGroups->getGroupSize(group);
+    entry.data = (int*)(malloc(sizeof(int) * count));
+    entry.count = 0;
+    for(size_t t = 0; t < count; ++t)
     {
-      entry.data = (int*)(malloc(sizeof(int) * entry.count));
-      int index = 0;
-      for(DREAM3D::SurfaceMesh::UniqueFaceIds_t::iterator tIter = triangles.begin(); tIter != triangles.end(); ++tIter)
+      if (entry.count == 0 || entry.data[entry.count - 1] != triangles[t])
       {
-        entry.data[index++] = *tIter; // Copy the value from the triangle Ids set into the ManagedPointer
+        entry.data[entry.count++] = triangles[t]; // Copy the value from the group into the ManagedPointer
       }
     }
   }
@@ -41,6 +41,7 @@
 #include <sstream>
 
 
+#include "MXA/Common/LogTime.h"
 #include "MXA/Common/MXAEndian.h"
 #include "MXA/Utilities/MXAFileInfo.h"
 #include "MXA/Utilities/MXADir.h"
@@ -49,12 +50,15 @@
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/SurfaceMeshStructs.h"
 #include "DREAM3DLib/SurfaceMeshingFilters/GenerateUniqueEdges.h"
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshKeyGroups.hpp"
 #include "DREAM3DLib/SurfaceMeshingFilters/util/Vector3.h"
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
 #include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
 #endif
 
 
@@ -108,7 +112,7 @@ class LaplacianSmoothingImpl
         newVert.pos[1] = currentVert.pos[1];
         newVert.pos[2] = currentVert.pos[2];
         // Get the Triangles for this vertex
-        MeshVertLinks::FaceList& list = m_meshVertLinks->getFaceList(v);
+        MeshVertLinks::FaceList list = m_meshVertLinks->getFaceList(v);
         std::set<int32_t> neighbours;
         // Create the unique List of Vertices that are directly connected to this vertex (vert)
         for(int32_t t = 0; t < list.ncells; ++t )
@@ -145,7 +149,123 @@ class LaplacianSmoothingImpl
 #endif
 };
 
+/**
+ * @brief The LaplacianSmoothingReorderedImpl class computes one smoothing iteration over the reordered
+ * vertices. The new positions are written into a second buffer so every vertex only reads the positions
+ * of the previous iteration. It also tracks the square of the largest displacement so the caller can
+ * decide if the smoothing has converged.
+ */
+class LaplacianSmoothingReorderedImpl
+{
+    const size_t* m_Offsets;
+    const int32_t* m_Neighbors;
+    const float* m_Lambdas;
+    const DREAM3D::SurfaceMesh::Float_t* m_Current;
+    DREAM3D::SurfaceMesh::Float_t* m_Next;
+    double m_MaxDisplacement;
 
+  public:
+    LaplacianSmoothingReorderedImpl(const size_t* offsets, const int32_t* neighbors, const float* lambdas,
+                                    const DREAM3D::SurfaceMesh::Float_t* current, DREAM3D::SurfaceMesh::Float_t* next) :
+      m_Offsets(offsets),
+      m_Neighbors(neighbors),
+      m_Lambdas(lambdas),
+      m_Current(current),
+      m_Next(next),
+      m_MaxDisplacement(0.0)
+    {}
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    LaplacianSmoothingReorderedImpl(LaplacianSmoothingReorderedImpl& other, tbb::split) :
+      m_Offsets(other.m_Offsets),
+      m_Neighbors(other.m_Neighbors),
+      m_Lambdas(other.m_Lambdas),
+      m_Current(other.m_Current),
+      m_Next(other.m_Next),
+      m_MaxDisplacement(0.0)
+    {}
+#endif
+
+    virtual ~LaplacianSmoothingReorderedImpl(){}
+
+    double getMaxDisplacement() const { return m_MaxDisplacement; }
+
+    /**
+     * @brief generate Moves the vertices [start, end) towards the average of their neighbors
+     * @return The square of the largest displacement in the range
+     */
+    double generate(size_t start, size_t end) const
+    {
+      double maxDisplacement = 0.0;
+      for(size_t v = start; v < end; ++v)
+      {
+        const DREAM3D::SurfaceMesh::Float_t* current = m_Current + v * 3;
+        DREAM3D::SurfaceMesh::Float_t* next = m_Next + v * 3;
+        size_t first = m_Offsets[v];
+        size_t last = m_Offsets[v + 1];
+        if (first == last || m_Lambdas[v] == 0.0f)
+        {
+          next[0] = current[0];
+          next[1] = current[1];
+          next[2] = current[2];
+          continue;
+        }
+        double delta[3] = { 0.0, 0.0, 0.0 };
+        for(size_t n = first; n < last; ++n)
+        {
+          const DREAM3D::SurfaceMesh::Float_t* neighbor = m_Current + static_cast<size_t>(m_Neighbors[n]) * 3;
+          delta[0] += neighbor[0] - current[0];
+          delta[1] += neighbor[1] - current[1];
+          delta[2] += neighbor[2] - current[2];
+        }
+        double count = static_cast<double>(last - first);
+        double displacement = 0.0;
+        for (int j = 0; j < 3; ++j)
+        {
+          next[j] = current[j] + m_Lambdas[v] * (delta[j] / count);
+          double d = next[j] - current[j];
+          displacement += d * d;
+        }
+        if (displacement > maxDisplacement) { maxDisplacement = displacement; }
+      }
+      return maxDisplacement;
+    }
+
+    void run(size_t start, size_t end)
+    {
+      double maxDisplacement = generate(start, end);
+      if (maxDisplacement > m_MaxDisplacement) { m_MaxDisplacement = maxDisplacement; }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r)
+    {
+      run(r.begin(), r.end());
+    }
+
+    void join(const LaplacianSmoothingReorderedImpl& rhs)
+    {
+      if (rhs.m_MaxDisplacement > m_MaxDisplacement) { m_MaxDisplacement = rhs.m_MaxDisplacement; }
+    }
+#endif
+};
+
+namespace Detail
+{
+  /**
+   * @brief MortonSpread Spreads the lower 21 bits of a value so there are 2 zero bits between each of them
+   */
+  inline uint64_t MortonSpread(uint64_t x)
+  {
+    x &= 0x1FFFFF;
+    x = (x | (x << 32)) & 0x1F00000000FFFFULL;
+    x = (x | (x << 16)) & 0x1F0000FF0000FFULL;
+    x = (x | (x << 8)) & 0x100F00F00F00F00FULL;
+    x = (x | (x << 4)) & 0x10C30C30C30C30C3ULL;
+    x = (x | (x << 2)) & 0x1249249249249249ULL;
+    return x;
+  }
+}
 
 
 // -----------------------------------------------------------------------------
@@ -166,6 +286,8 @@ LaplacianSmoothing::LaplacianSmoothing() :
   m_QuadPointLambda(0.0),
   m_SurfaceTripleLineLambda(0.0),
   m_SurfaceQuadPointLambda(0.0),
+  m_ReorderVertices(false),
+  m_ConvergenceTolerance(0.0f),
   m_DoConnectivityFilter(false)
 {
   setupFilterParameters();
@@ -254,6 +376,24 @@ void LaplacianSmoothing::setupFilterParameters()
     parameter->setCastableValueType("double");
     parameters.push_back(parameter);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Reorder Vertices for Locality");
+    option->setPropertyName("ReorderVertices");
+    option->setWidgetType(FilterParameter::BooleanWidget);
+    option->setValueType("bool");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer parameter = FilterParameter::New();
+    parameter->setHumanLabel("Convergence Tolerance");
+    parameter->setPropertyName("ConvergenceTolerance");
+    parameter->setWidgetType(FilterParameter::DoubleWidget);
+    parameter->setValueType("float");
+    parameter->setCastableValueType("double");
+    parameter->setUnits("Max Vertex Displacement, Zero runs all Iterations");
+    parameters.push_back(parameter);
+  }
 #if OUTPUT_DEBUG_VTK_FILES
   {
     FilterParameter::Pointer option = FilterParameter::New();
@@ -313,6 +453,8 @@ int LaplacianSmoothing::writeFilterParameters(AbstractFilterParametersWriter* wr
   writer->writeValue("SurfacePointLambda", getSurfacePointLambda());
   writer->writeValue("SurfaceTripleLineLambda", getSurfaceTripleLineLambda());
   writer->writeValue("SurfaceQuadPointLambda", getSurfaceQuadPointLambda());
+  writer->writeValue("ReorderVertices", getReorderVertices());
+  writer->writeValue("ConvergenceTolerance", getConvergenceTolerance());
     writer->closeFilterGroup();
     return ++index; // we want to return the next index that was just written to
 }
@@ -390,7 +532,14 @@ void LaplacianSmoothing::execute()
 
 
   /* Place all your code to execute your filter here. */
-  err = edgeBasedSmoothing();
+  if (m_ReorderVertices == true)
+  {
+    err = reorderedSmoothing();
+  }
+  else
+  {
+    err = edgeBasedSmoothing();
+  }
 
   if (err < 0)
   {
@@ -545,7 +694,9 @@ int LaplacianSmoothing::edgeBasedSmoothing()
 
 
   double dlta = 0.0;
-  for (int q = 0; q < m_IterationSteps; q++)
+  unsigned long long int millis = MXA::getMilliSeconds();
+  int q = 0;
+  while (q < m_IterationSteps)
   {
     if (getCancel() == true) { return -1; }
     ss.str("");
@@ -571,8 +722,10 @@ int LaplacianSmoothing::edgeBasedSmoothing()
 
 
     float ll = 0.0f;
+    double maxDisplacement = 0.0;
     for (int i=0; i < nvert; i++)
     {
+      double displacement = 0.0;
       for (int j = 0; j < 3; j++)
       {
         int in0 = 3*i+j;
@@ -580,10 +733,13 @@ int LaplacianSmoothing::edgeBasedSmoothing()
 
         ll = lambda[i];
         DREAM3D::SurfaceMesh::Vert_t& node = vsm[i];
+        DREAM3D::SurfaceMesh::Float_t old = node.pos[j];
         node.pos[j] += ll*dlta;
         delta[in0] = 0.0; //reset for next iteration
+        displacement += (node.pos[j] - old) * (node.pos[j] - old);
       }
       ncon[i] = 0;//reset for next iteration
+      if (displacement > maxDisplacement) { maxDisplacement = displacement; }
     }
 
 #if OUTPUT_DEBUG_VTK_FILES
@@ -592,7 +748,10 @@ int LaplacianSmoothing::edgeBasedSmoothing()
     testFile << getVtkIterationOutputPath() << "/" << getOutputVTKPrefix() << q << ".vtk";
     writeVTKFile(testFile.str());
 #endif
+    ++q;
+    if (isConverged(maxDisplacement) == true) { break; }
   }
+  notifySmoothingRate(q, MXA::getMilliSeconds() - millis);
 
 
   // This filter had to generate the edge connectivity data so delete it when we are done with it.
@@ -605,6 +764,228 @@ int LaplacianSmoothing::edgeBasedSmoothing()
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LaplacianSmoothing::reorderedSmoothing()
+{
+  int err = 0;
+
+  DREAM3D::SurfaceMesh::VertListPointer_t nodesPtr = getSurfaceMeshDataContainer()->getVertices();
+  size_t nvert = nodesPtr->GetNumberOfTuples();
+  DREAM3D::SurfaceMesh::Vert_t* vsm = nodesPtr->GetPointer(0); // Get the pointer to the from of the array so we can use [] notation
+
+  DataArray<int8_t>::Pointer nodeTypeSharedPtr = DataArray<int8_t>::NullPointer();
+  DataArray<int8_t>* nodeTypePtr = nodeTypeSharedPtr.get();
+  IDataArray::Pointer iNodeTypePtr = getSurfaceMeshDataContainer()->getVertexData(DREAM3D::VertexData::SurfaceMeshNodeType);
+
+  if (NULL == iNodeTypePtr.get() )
+  {
+    // The node type array does not exist so create one with the default node type populated
+    nodeTypeSharedPtr = DataArray<int8_t>::CreateArray(nodesPtr->GetNumberOfTuples(), DREAM3D::VertexData::SurfaceMeshNodeType);
+    nodeTypeSharedPtr->initializeWithValues(DREAM3D::SurfaceMesh::NodeType::Default);
+    nodeTypePtr = nodeTypeSharedPtr.get();
+  }
+  else
+  {
+    // The node type array does exist so use that one.
+    nodeTypePtr = DataArray<int8_t>::SafeObjectDownCast<IDataArray*, DataArray<int8_t>* >(iNodeTypePtr.get());
+  }
+
+  // Generate the Lambda Array
+  err = generateLambdaArray(nodeTypePtr);
+  if (err < 0)
+  {
+    setErrorCondition(-557);
+    notifyErrorMessage("Error generating the Lambda Array", getErrorCondition());
+    return err;
+  }
+  float* lambda = getLambdaArray()->GetPointer(0);
+  std::stringstream ss;
+
+  //  Generate the Unique Edges
+  if (m_DoConnectivityFilter == true)
+  {
+    // There was no Edge connectivity before this filter so delete it when we are done with it
+    GenerateUniqueEdges::Pointer conn = GenerateUniqueEdges::New();
+    ss.str("");
+    ss << getMessagePrefix() << "|->Generating Unique Edge Ids |->";
+    conn->setMessagePrefix(ss.str());
+    conn->setObservers(getObservers());
+    conn->setVoxelDataContainer(getVoxelDataContainer());
+    conn->setSurfaceMeshDataContainer(getSurfaceMeshDataContainer());
+    conn->setSolidMeshDataContainer(getSolidMeshDataContainer());
+    conn->setSurfaceMeshUniqueEdgesArrayName(getSurfaceMeshUniqueEdgesArrayName());
+    conn->execute();
+    if(conn->getErrorCondition() < 0)
+    {
+      return conn->getErrorCondition();
+    }
+  }
+  if (getCancel() == true) { return -1; }
+
+  IDataArray::Pointer uniqueEdgesPtr = getSurfaceMeshDataContainer()->getEdgeData(m_SurfaceMeshUniqueEdgesArrayName);
+  DataArray<int>* uniqueEdges = DataArray<int>::SafePointerDownCast(uniqueEdgesPtr.get());
+  if (NULL == uniqueEdges)
+  {
+    setErrorCondition(-560);
+    notifyErrorMessage("Error retrieving the Unique Edge List", getErrorCondition());
+    return -560;
+  }
+  int* uedges = uniqueEdges->GetPointer(0);
+  size_t nedges = uniqueEdges->GetNumberOfTuples();
+
+  notifyStatusMessage("Reordering Vertices");
+  // Sort the vertices along a Z-Order curve through the bounding box of the mesh
+  float min[3] = { 0.0f, 0.0f, 0.0f };
+  float max[3] = { 0.0f, 0.0f, 0.0f };
+  for (size_t i = 0; i < nvert; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (i == 0 || vsm[i].pos[j] < min[j]) { min[j] = vsm[i].pos[j]; }
+      if (i == 0 || vsm[i].pos[j] > max[j]) { max[j] = vsm[i].pos[j]; }
+    }
+  }
+  double extent = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+  double scale = (extent > 0.0) ? static_cast<double>(0x1FFFFF) / extent : 0.0;
+  std::vector<uint64_t> keys(nvert);
+  std::vector<int32_t> order(nvert);
+  for (size_t i = 0; i < nvert; ++i)
+  {
+    uint64_t x = static_cast<uint64_t>((vsm[i].pos[0] - min[0]) * scale);
+    uint64_t y = static_cast<uint64_t>((vsm[i].pos[1] - min[1]) * scale);
+    uint64_t z = static_cast<uint64_t>((vsm[i].pos[2] - min[2]) * scale);
+    keys[i] = Detail::MortonSpread(x) | (Detail::MortonSpread(y) << 1) | (Detail::MortonSpread(z) << 2);
+    order[i] = static_cast<int32_t>(i);
+  }
+  MeshKeyGroups::SortKeys(keys, order);
+  std::vector<uint64_t>().swap(keys);
+
+  // order maps the new index to the original vertex, rank maps the original vertex to the new index
+  std::vector<int32_t> rank(nvert);
+  std::vector<float> lambdas(nvert);
+  std::vector<DREAM3D::SurfaceMesh::Float_t> current(nvert * 3);
+  std::vector<DREAM3D::SurfaceMesh::Float_t> next(nvert * 3);
+  for (size_t i = 0; i < nvert; ++i)
+  {
+    rank[order[i]] = static_cast<int32_t>(i);
+    lambdas[i] = lambda[order[i]];
+    current[i * 3] = vsm[order[i]].pos[0];
+    current[i * 3 + 1] = vsm[order[i]].pos[1];
+    current[i * 3 + 2] = vsm[order[i]].pos[2];
+  }
+
+  // Build the vertex to vertex connectivity from the unique edges in the new order
+  std::vector<size_t> offsets(nvert + 1, 0);
+  for (size_t i = 0; i < nedges; ++i)
+  {
+    ++offsets[rank[uedges[2 * i]] + 1];
+    ++offsets[rank[uedges[2 * i + 1]] + 1];
+  }
+  for (size_t i = 0; i < nvert; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+  std::vector<int32_t> neighbors(offsets[nvert]);
+  std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < nedges; ++i)
+  {
+    int32_t v0 = rank[uedges[2 * i]];
+    int32_t v1 = rank[uedges[2 * i + 1]];
+    neighbors[fill[v0]++] = v1;
+    neighbors[fill[v1]++] = v0;
+  }
+  std::vector<size_t>().swap(fill);
+  std::vector<int32_t>().swap(rank);
+
+  // This filter had to generate the edge connectivity data so delete it now that we have our own copy.
+  if (m_DoConnectivityFilter == true)
+  {
+    IDataArray::Pointer removedConnectviity = getSurfaceMeshDataContainer()->removeEdgeData(m_SurfaceMeshUniqueEdgesArrayName);
+    BOOST_ASSERT(removedConnectviity.get() != NULL);
+  }
+
+  notifyStatusMessage("Starting to Smooth Vertices");
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  DREAM3D::SurfaceMesh::Float_t* currentPos = &(current.front());
+  DREAM3D::SurfaceMesh::Float_t* nextPos = &(next.front());
+  unsigned long long int millis = MXA::getMilliSeconds();
+  int q = 0;
+  while (q < m_IterationSteps)
+  {
+    if (getCancel() == true) { return -1; }
+    ss.str("");
+    ss << "Iteration " << q;
+    notifyStatusMessage(ss.str());
+
+    LaplacianSmoothingReorderedImpl smoother(&(offsets.front()), (nedges > 0) ? &(neighbors.front()) : NULL, &(lambdas.front()), currentPos, nextPos);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
+    {
+      tbb::parallel_reduce(tbb::blocked_range<size_t>(0, nvert), smoother, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      smoother.run(0, nvert);
+    }
+    // The new positions become the current positions for the next iteration
+    std::swap(currentPos, nextPos);
+    ++q;
+    if (isConverged(smoother.getMaxDisplacement()) == true) { break; }
+  }
+  notifySmoothingRate(q, MXA::getMilliSeconds() - millis);
+
+  // Copy the smoothed positions back into the original vertex order
+  for (size_t i = 0; i < nvert; ++i)
+  {
+    DREAM3D::SurfaceMesh::Vert_t& node = vsm[order[i]];
+    node.pos[0] = currentPos[i * 3];
+    node.pos[1] = currentPos[i * 3 + 1];
+    node.pos[2] = currentPos[i * 3 + 2];
+  }
+
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LaplacianSmoothing::isConverged(double maxDisplacementSquared)
+{
+  if (m_ConvergenceTolerance <= 0.0f)
+  {
+    return false;
+  }
+  if (maxDisplacementSquared < static_cast<double>(m_ConvergenceTolerance) * m_ConvergenceTolerance)
+  {
+    std::stringstream ss;
+    ss << "Converged with a maximum vertex displacement of " << sqrt(maxDisplacementSquared);
+    notifyStatusMessage(ss.str());
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaplacianSmoothing::notifySmoothingRate(int iterations, unsigned long long int millis)
+{
+  std::stringstream ss;
+  ss << iterations << " Iterations in " << millis << " ms";
+  if (millis > 0)
+  {
+    ss << " (" << (iterations * 1000.0 / millis) << " Iterations/sec)";
+  }
+  notifyStatusMessage(ss.str());
+}
+
 
 // -----------------------------------------------------------------------------
 //
@@ -83,6 +83,8 @@ class DREAM3DLib_EXPORT LaplacianSmoothing : public SurfaceMeshFilter
     DREAM3D_INSTANCE_PROPERTY(float, QuadPointLambda)
     DREAM3D_INSTANCE_PROPERTY(float, SurfaceTripleLineLambda)
     DREAM3D_INSTANCE_PROPERTY(float, SurfaceQuadPointLambda)
+    DREAM3D_INSTANCE_PROPERTY(bool, ReorderVertices)
+    DREAM3D_INSTANCE_PROPERTY(float, ConvergenceTolerance)
 
 
     /* This class is designed to be subclassed so that thoes subclasses can add
@@ -162,6 +164,14 @@ class DREAM3DLib_EXPORT LaplacianSmoothing : public SurfaceMeshFilter
      */
     virtual int edgeBasedSmoothing();
 
+    /**
+     * @brief reorderedSmoothing Performs the same smoothing as edgeBasedSmoothing but on a copy of the
+     * vertices that is sorted along a Z-Order (Morton) curve so that neighboring vertices are close together
+     * in memory. The positions are double buffered and each iteration runs in parallel if TBB is available.
+     * @return
+     */
+    virtual int reorderedSmoothing();
+
     /**
      * @brief vertexBasedSmoothing Uses the Vertex->Triangle connectivity information for its algorithm
      * @return
@@ -171,6 +181,18 @@ class DREAM3DLib_EXPORT LaplacianSmoothing : public SurfaceMeshFilter
   private:
     bool m_DoConnectivityFilter;
 
+    /**
+     * @brief isConverged Returns true if the ConvergenceTolerance is set and the largest vertex
+     * displacement of the last iteration is below it
+     * @param maxDisplacementSquared The square of the largest vertex displacement
+     */
+    bool isConverged(double maxDisplacementSquared);
+
+    /**
+     * @brief notifySmoothingRate Sends a status message with the number of iterations per second
+     */
+    void notifySmoothingRate(int iterations, unsigned long long int millis);
+
 #if OUTPUT_DEBUG_VTK_FILES
     void writeVTKFile(const std::string &outputVtkFile);
     int32_t* m_SurfaceMeshFaceLabels;
@@ -333,6 +333,7 @@ M3CSliceBySlice::M3CSliceBySlice() :
   m_SurfaceMeshNodeTypeArrayName(DREAM3D::VertexData::SurfaceMeshNodeType),
   m_SurfaceMeshTriangleLabelsArrayName(DREAM3D::FaceData::SurfaceMeshFaceLabels),
   m_DeleteTempFiles(true),
+  m_MaxInMemoryMeshSize(2048),
   m_GrainIds(NULL)
 {
   setupFilterParameters();
@@ -359,6 +360,15 @@ void M3CSliceBySlice::setupFilterParameters()
     option->setValueType("bool");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Max In Memory Mesh Size");
+    option->setPropertyName("MaxInMemoryMeshSize");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    option->setUnits("MB");
+    parameters.push_back(option);
+  }
 
   setFilterParameters(parameters);
 }
@@ -372,6 +382,7 @@ void M3CSliceBySlice::readFilterParameters(AbstractFilterParametersReader* reade
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
   setDeleteTempFiles( reader->readValue("DeleteTempFiles", false) );
+  setMaxInMemoryMeshSize( reader->readValue("MaxInMemoryMeshSize", getMaxInMemoryMeshSize()) );
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -383,6 +394,7 @@ int M3CSliceBySlice::writeFilterParameters(AbstractFilterParametersWriter* write
 {
   writer->openFilterGroup(this, index);
   writer->writeValue("DeleteTempFiles", getDeleteTempFiles() );
+  writer->writeValue("MaxInMemoryMeshSize", getMaxInMemoryMeshSize() );
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -471,6 +483,10 @@ void M3CSliceBySlice::execute()
   }
 
 
+  // Keep the mesh in memory until it grows past the limit
+  bool inMemory = (m_MaxInMemoryMeshSize > 0);
+  size_t maxMeshBytes = static_cast<size_t>(m_MaxInMemoryMeshSize) * 1024 * 1024;
+
   int cNodeID = 0;
   int cTriID = 0;
   int cEdgeID = 0;
@@ -535,6 +551,14 @@ void M3CSliceBySlice::execute()
   StructArray<SurfaceMesh::M3C::Segment>::Pointer cEdgePtr = StructArray<SurfaceMesh::M3C::Segment>::CreateArray(0, "M3CSliceBySlice_SurfaceMesh::M3C::Segment_Array");
   cEdgePtr->initializeWithZeros();
 
+  if (inMemory == true)
+  {
+    m_MeshVertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray(NSP, DREAM3D::VertexData::SurfaceMeshNodes);
+    m_MeshNodeTypes = DataArray<int8_t>::CreateArray(NSP, 1, DREAM3D::VertexData::SurfaceMeshNodeType);
+    m_MeshFaces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray(NSP, DREAM3D::FaceData::SurfaceMeshFaces);
+    m_MeshFaceLabels = DataArray<int32_t>::CreateArray(NSP, 2, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  }
+
   // Prime the working voxels (2 layers worth) with -3 values indicating border voxels if the
   // volume does NOT have a ghost layer
   if(isWrapped == false)
@@ -623,24 +647,52 @@ void M3CSliceBySlice::execute()
     update_node_edge_kind(nTriangle,cTrianglePtr, cVertexNodeTypePtr, cEdgePtr);
 
     // Output Nodes and triangles...
-    err = writeNodesFile(i, cNodeID, NSP, nodesFile, cVertexPtr, cVertexNodeIdPtr, cVertexNodeTypePtr);
-    if (err < 0)
+    if (inMemory == true)
     {
-      ss.str("");
-      ss << "Error writing Nodes file '" << nodesFile << "'";
-      notifyErrorMessage(ss.str(), -1);
-      setErrorCondition(-1);
-      return;
+      bufferNodes(cNodeID, nNodes, NSP, cVertexPtr, cVertexNodeIdPtr, cVertexNodeTypePtr);
+      bufferTriangles(cTriID, nTriangle, cTrianglePtr, cVertexNodeIdPtr, renumberGrainValue);
+      size_t meshBytes = m_MeshVertices->GetSize() * m_MeshVertices->GetTypeSize()
+          + m_MeshNodeTypes->GetSize() * m_MeshNodeTypes->GetTypeSize()
+          + m_MeshFaces->GetSize() * m_MeshFaces->GetTypeSize()
+          + m_MeshFaceLabels->GetSize() * m_MeshFaceLabels->GetTypeSize();
+      if (meshBytes > maxMeshBytes)
+      {
+        ss.str("");
+        ss << "Mesh is larger than " << m_MaxInMemoryMeshSize << " MB. Moving it to the temp files";
+        notifyStatusMessage(ss.str());
+        err = spillMeshBuffers(nNodes, cTriID + nTriangle, nodesFile, trianglesFile);
+        if (err < 0)
+        {
+          ss.str("");
+          ss << "Error writing the Nodes file '" << nodesFile << "' or triangles file '" << trianglesFile << "'";
+          notifyErrorMessage(ss.str(), -1);
+          setErrorCondition(-1);
+          return;
+        }
+        inMemory = false;
+      }
     }
-
-    err = writeTrianglesFile(i, cTriID, trianglesFile, nTriangle, cTrianglePtr, cVertexNodeIdPtr, renumberGrainValue);
-    if (err < 0)
+    else
     {
-      ss.str("");
-      ss << "Error writing triangles file '" << trianglesFile << "'";
-      notifyErrorMessage(ss.str(), -1);
-      setErrorCondition(-1);
-      return;
+      err = writeNodesFile(i, cNodeID, NSP, nodesFile, cVertexPtr, cVertexNodeIdPtr, cVertexNodeTypePtr);
+      if (err < 0)
+      {
+        ss.str("");
+        ss << "Error writing Nodes file '" << nodesFile << "'";
+        notifyErrorMessage(ss.str(), -1);
+        setErrorCondition(-1);
+        return;
+      }
+
+      err = writeTrianglesFile(i, cTriID, trianglesFile, nTriangle, cTrianglePtr, cVertexNodeIdPtr, renumberGrainValue);
+      if (err < 0)
+      {
+        ss.str("");
+        ss << "Error writing triangles file '" << trianglesFile << "'";
+        notifyErrorMessage(ss.str(), -1);
+        setErrorCondition(-1);
+        return;
+      }
     }
     cNodeID = nNodes;
     cTriID = cTriID + nTriangle;
@@ -663,21 +715,41 @@ void M3CSliceBySlice::execute()
   cEdgePtr = StructArray<SurfaceMesh::M3C::Segment>::NullPointer();
 
 
-  // This will read the mesh from the temp file and store it in the SurfaceMesh Data container
-  BinaryNodesTrianglesReader::Pointer binaryReader = BinaryNodesTrianglesReader::New();
-  binaryReader->setBinaryNodesFile(nodesFile);
-  binaryReader->setBinaryTrianglesFile(trianglesFile);
-  ss.str("");
-  ss << getMessagePrefix() << " |--> " << binaryReader->getNameOfClass();
-  binaryReader->setMessagePrefix(ss.str());
-  binaryReader->setObservers(getObservers());
-  binaryReader->setVoxelDataContainer(getVoxelDataContainer());
-  binaryReader->setSurfaceMeshDataContainer(getSurfaceMeshDataContainer());
-  binaryReader->setSolidMeshDataContainer(getSolidMeshDataContainer());
-  binaryReader->execute();
-  if(binaryReader->getErrorCondition() < 0)
+  if (inMemory == true)
   {
-    setErrorCondition(binaryReader->getErrorCondition());
+    // Trim the arrays down to the nodes and triangles that are in use and hand them over
+    SurfaceMeshDataContainer* sm = getSurfaceMeshDataContainer();
+    m_MeshVertices->Resize(cNodeID);
+    m_MeshNodeTypes->Resize(cNodeID);
+    m_MeshFaces->Resize(cTriID);
+    m_MeshFaceLabels->Resize(cTriID);
+    sm->setVertices(m_MeshVertices);
+    sm->setFaces(m_MeshFaces);
+    sm->addFaceData(m_MeshFaceLabels->GetName(), m_MeshFaceLabels);
+    sm->addVertexData(m_MeshNodeTypes->GetName(), m_MeshNodeTypes);
+    m_MeshVertices = DREAM3D::SurfaceMesh::VertList_t::NullPointer();
+    m_MeshNodeTypes = DataArray<int8_t>::NullPointer();
+    m_MeshFaces = DREAM3D::SurfaceMesh::FaceList_t::NullPointer();
+    m_MeshFaceLabels = DataArray<int32_t>::NullPointer();
+  }
+  else
+  {
+    // This will read the mesh from the temp file and store it in the SurfaceMesh Data container
+    BinaryNodesTrianglesReader::Pointer binaryReader = BinaryNodesTrianglesReader::New();
+    binaryReader->setBinaryNodesFile(nodesFile);
+    binaryReader->setBinaryTrianglesFile(trianglesFile);
+    ss.str("");
+    ss << getMessagePrefix() << " |--> " << binaryReader->getNameOfClass();
+    binaryReader->setMessagePrefix(ss.str());
+    binaryReader->setObservers(getObservers());
+    binaryReader->setVoxelDataContainer(getVoxelDataContainer());
+    binaryReader->setSurfaceMeshDataContainer(getSurfaceMeshDataContainer());
+    binaryReader->setSolidMeshDataContainer(getSolidMeshDataContainer());
+    binaryReader->execute();
+    if(binaryReader->getErrorCondition() < 0)
+    {
+      setErrorCondition(binaryReader->getErrorCondition());
+    }
   }
 
   // This will possibly delete the triangles and Nodes file depending on the
@@ -2912,6 +2984,134 @@ int M3CSliceBySlice::writeTrianglesFile(int zID, int ctid,
   return 0;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void M3CSliceBySlice::bufferNodes(int cNodeID, int nNodes, int NSP,
+                                  DREAM3D::SurfaceMesh::VertList_t::Pointer cVertexPtr,
+                                  DataArray<int32_t>::Pointer cVertexNodeIdPtr,
+                                  DataArray<int8_t>::Pointer cVertexNodeTypePtr)
+{
+  // Grow the arrays by doubling so appending a slice is amortized constant time per node
+  size_t capacity = m_MeshVertices->GetNumberOfTuples();
+  if (static_cast<size_t>(nNodes) > capacity)
+  {
+    capacity = (static_cast<size_t>(nNodes) > capacity * 2) ? nNodes : capacity * 2;
+    m_MeshVertices->Resize(capacity);
+    m_MeshNodeTypes->Resize(capacity);
+  }
+
+  int total = (7 * 2 * NSP);
+  int32_t* nodeID = cVertexNodeIdPtr->GetPointer(0);
+  int8_t* nodeKind = cVertexNodeTypePtr->GetPointer(0);
+  DREAM3D::SurfaceMesh::Vert_t* cVertex = cVertexPtr->GetPointer(0);
+  DREAM3D::SurfaceMesh::Vert_t* vertex = m_MeshVertices->GetPointer(0);
+  int8_t* nodeType = m_MeshNodeTypes->GetPointer(0);
+
+  for (int k = 0; k < total; k++)
+  {
+    int32_t id = nodeID[k];
+    if (id > cNodeID - 1)
+    {
+      vertex[id] = cVertex[k];
+      nodeType[id] = nodeKind[k];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void M3CSliceBySlice::bufferTriangles(int ctid, int nt,
+                                      StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr,
+                                      DataArray<int32_t>::Pointer cVertexNodeIdPtr,
+                                      int32_t grainIdZeroMappingValue)
+{
+  size_t capacity = m_MeshFaces->GetNumberOfTuples();
+  size_t needed = static_cast<size_t>(ctid + nt);
+  if (needed > capacity)
+  {
+    capacity = (needed > capacity * 2) ? needed : capacity * 2;
+    m_MeshFaces->Resize(capacity);
+    m_MeshFaceLabels->Resize(capacity);
+  }
+
+  int32_t* nodeID = cVertexNodeIdPtr->GetPointer(0);
+  SurfaceMesh::M3C::Patch* cTriangle = cTrianglePtr->GetPointer(0);
+  DREAM3D::SurfaceMesh::Face_t* triangle = m_MeshFaces->GetPointer(ctid);
+  int32_t* faceLabels = m_MeshFaceLabels->GetPointer(ctid * 2);
+
+  for (int i = 0; i < nt; i++)
+  {
+    SurfaceMesh::M3C::Patch& patch = cTriangle[i];
+    triangle[i].verts[0] = nodeID[patch.node_id[0]];
+    triangle[i].verts[1] = nodeID[patch.node_id[1]];
+    triangle[i].verts[2] = nodeID[patch.node_id[2]];
+    faceLabels[i * 2] = (patch.nSpin[0] == grainIdZeroMappingValue ? 0 : patch.nSpin[0]);
+    faceLabels[i * 2 + 1] = (patch.nSpin[1] == grainIdZeroMappingValue ? 0 : patch.nSpin[1]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int M3CSliceBySlice::spillMeshBuffers(int numNodes, int numTriangles, const std::string &nodesFile, const std::string &trianglesFile)
+{
+  {
+    FILE* f = fopen(nodesFile.c_str(), "wb");
+    if (NULL == f)
+    {
+      return -1;
+    }
+    ScopedFileMonitor monitor(f);
+    DREAM3D::SurfaceMesh::Vert_t* vertex = m_MeshVertices->GetPointer(0);
+    int8_t* nodeType = m_MeshNodeTypes->GetPointer(0);
+    SurfaceMesh::NodesFile::NodesFileRecord_t record;
+    for (int n = 0; n < numNodes; ++n)
+    {
+      record.nodeId = n;
+      record.nodeKind = nodeType[n];
+      record.x = vertex[n].pos[0];
+      record.y = vertex[n].pos[1];
+      record.z = vertex[n].pos[2];
+      if (fwrite(&record, SurfaceMesh::NodesFile::ByteCount, 1, f) != 1)
+      {
+        return -1;
+      }
+    }
+  }
+  {
+    FILE* f = fopen(trianglesFile.c_str(), "wb");
+    if (NULL == f)
+    {
+      return -1;
+    }
+    ScopedFileMonitor monitor(f);
+    DREAM3D::SurfaceMesh::Face_t* triangle = m_MeshFaces->GetPointer(0);
+    int32_t* faceLabels = m_MeshFaceLabels->GetPointer(0);
+    SurfaceMesh::TrianglesFile::TrianglesFileRecord_t record;
+    for (int t = 0; t < numTriangles; ++t)
+    {
+      record.triId = t;
+      record.nodeId_0 = triangle[t].verts[0];
+      record.nodeId_1 = triangle[t].verts[1];
+      record.nodeId_2 = triangle[t].verts[2];
+      record.label_0 = faceLabels[t * 2];
+      record.label_1 = faceLabels[t * 2 + 1];
+      if (fwrite(&record, SurfaceMesh::TrianglesFile::ByteCount, 1, f) != 1)
+      {
+        return -1;
+      }
+    }
+  }
+
+  m_MeshVertices = DREAM3D::SurfaceMesh::VertList_t::NullPointer();
+  m_MeshNodeTypes = DataArray<int8_t>::NullPointer();
+  m_MeshFaces = DREAM3D::SurfaceMesh::FaceList_t::NullPointer();
+  m_MeshFaceLabels = DataArray<int32_t>::NullPointer();
+  return 0;
+}
+
 
 #if 0
 // -----------------------------------------------------------------------------
@@ -111,6 +111,11 @@ class DREAM3DLib_EXPORT M3CSliceBySlice : public AbstractFilter
     DREAM3D_INSTANCE_STRING_PROPERTY(SurfaceMeshTriangleLabelsArrayName)
 
     DREAM3D_INSTANCE_PROPERTY(bool, DeleteTempFiles)
+    /**
+     * @brief The mesh is kept in memory until it grows past this many MB and is then
+     * written to the temp files instead. A value of 0 always uses the temp files.
+     */
+    DREAM3D_INSTANCE_PROPERTY(int, MaxInMemoryMeshSize)
 
 
     virtual void preflight();
@@ -377,6 +382,31 @@ class DREAM3DLib_EXPORT M3CSliceBySlice : public AbstractFilter
                            DataArray<int32_t>::Pointer cVertexNodeIdPtr,
                            int32_t grainIdZeroMappingValue);
 
+    /**
+     * @brief Copies the new nodes of the current slice into the in memory mesh
+     * @param cNodeID The first node id of the current slice
+     * @param nNodes The total number of nodes after the current slice
+     */
+    void bufferNodes(int cNodeID, int nNodes, int NSP,
+                     DREAM3D::SurfaceMesh::VertList_t::Pointer cVertexPtr,
+                     DataArray<int32_t>::Pointer cVertexNodeIdPtr,
+                     DataArray<int8_t>::Pointer cVertexNodeTypePtr);
+
+    /**
+     * @brief Copies the triangles of the current slice into the in memory mesh
+     */
+    void bufferTriangles(int ctid, int nt,
+                         StructArray<SurfaceMesh::M3C::Patch>::Pointer cTrianglePtr,
+                         DataArray<int32_t>::Pointer cVertexNodeIdPtr,
+                         int32_t grainIdZeroMappingValue);
+
+    /**
+     * @brief Writes the first 'numNodes' nodes and 'numTriangles' triangles of the in memory
+     * mesh to new temp files and releases the in memory mesh.
+     * @return Negative value on error
+     */
+    int spillMeshBuffers(int numNodes, int numTriangles, const std::string &nodesFile, const std::string &trianglesFile);
+
 
     /**
      * @brief volumeHasGhostLayer
@@ -401,6 +431,13 @@ class DREAM3DLib_EXPORT M3CSliceBySlice : public AbstractFilter
     int32_t* m_GrainIds;
     int numgrains;
 
+    // The mesh that is built up in memory. The arrays grow by doubling so they are
+    // usually larger than the number of nodes and triangles that are in use.
+    DREAM3D::SurfaceMesh::VertList_t::Pointer m_MeshVertices;
+    DataArray<int8_t>::Pointer m_MeshNodeTypes;
+    DREAM3D::SurfaceMesh::FaceList_t::Pointer m_MeshFaces;
+    DataArray<int32_t>::Pointer m_MeshFaceLabels;
+
     float m_OriginX, m_OriginY, m_OriginZ;
 
     void dataCheck(bool preflight, size_t voxels, size_t fields, size_t ensembles);
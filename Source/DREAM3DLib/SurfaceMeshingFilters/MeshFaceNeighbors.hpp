@@ -36,10 +36,13 @@
 #ifndef _MeshFaceNeighbors_hpp_H_
 #define _MeshFaceNeighbors_hpp_H_
 
+#include <string.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
-#include <boost/shared_array.hpp>
+#include <boost/assert.hpp>
 
 //-- DREAM3D Includes
 #include "DREAM3DLib/DREAM3DLib.h"
@@ -47,9 +50,122 @@
 #include "DREAM3DLib/Common/SurfaceMeshStructs.h"
 #include "DREAM3DLib/SurfaceMeshingFilters/MeshVertLinks.hpp"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 /**
- * @brief The MeshFaceNeighbors class contains arrays of Faces for each Node in the mesh. This allows quick query to the node
- * to determine what Cells the node is a part of.
+ * @brief Finds the Faces that share an edge with each Face. The first pass only
+ * stores the number of neighbors of each Face, the second pass (when cells is not
+ * NULL) writes the neighbors at the offsets computed from those counts.
+ */
+class MeshFaceNeighborsImpl
+{
+  public:
+    MeshFaceNeighborsImpl(const DREAM3D::SurfaceMesh::Face_t* faces, MeshVertLinks* cellLinks,
+                          int32_t* counts, const int64_t* offsets, int32_t* cells) :
+      m_Faces(faces),
+      m_CellLinks(cellLinks),
+      m_Counts(counts),
+      m_Offsets(offsets),
+      m_Cells(cells)
+    {}
+    virtual ~MeshFaceNeighborsImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
+      std::vector<int> loop_neighbors;
+      loop_neighbors.reserve(32);
+      for (size_t t = start; t < end; ++t)
+      {
+        findNeighbors(t, loop_neighbors);
+        if (NULL == m_Cells)
+        {
+          m_Counts[t] = static_cast<int32_t>(loop_neighbors.size());
+        }
+        else if (loop_neighbors.empty() == false)
+        {
+          ::memcpy(m_Cells + m_Offsets[t], &(loop_neighbors.front()), sizeof(int) * loop_neighbors.size());
+        }
+      }
+    }
+
+    void findNeighbors(size_t t, std::vector<int> &loop_neighbors) const
+    {
+      loop_neighbors.clear();
+      const DREAM3D::SurfaceMesh::Face_t& seedFace = m_Faces[t];
+      int seedTriVert0 = seedFace.verts[0];
+      int seedTriVert1 = seedFace.verts[1];
+      int seedTriVert2 = seedFace.verts[2];
+      for(size_t v = 0; v < 3; ++v)
+      {
+        int nTris = m_CellLinks->getNumberOfFaces(seedFace.verts[v]);
+        int* vertIdxs = m_CellLinks->getFaceListPointer(seedFace.verts[v]);
+
+        for(int vt = 0; vt < nTris; ++vt)
+        {
+          if (vertIdxs[vt] == static_cast<int>(t) ) { continue; } // This is the same triangle as our "source" triangle
+          // We already added this triangle so loop again. The lists are short so a linear search is fine.
+          if (std::find(loop_neighbors.begin(), loop_neighbors.end(), vertIdxs[vt]) != loop_neighbors.end()) { continue; }
+          const DREAM3D::SurfaceMesh::Face_t& vertTri = m_Faces[vertIdxs[vt]];
+          int vCount = 0;
+          // Loop over all the vertex indices of this triangle and try to match 2 of them to the current loop triangle
+          // If there are 2 matches then that triangle is a neighbor of this triangle. if there are more than 2 matches
+          // then there is a real problem with the mesh and the program is going to assert.
+          int trgtTriVert0 = vertTri.verts[0];
+          int trgtTriVert1 = vertTri.verts[1];
+          int trgtTriVert2 = vertTri.verts[2];
+
+          if (seedTriVert0 == trgtTriVert0 || seedTriVert0 == trgtTriVert1 || seedTriVert0 == trgtTriVert2  )
+          {
+            vCount++;
+          }
+          if (seedTriVert1 == trgtTriVert0 || seedTriVert1 == trgtTriVert1 || seedTriVert1 == trgtTriVert2  )
+          {
+            vCount++;
+          }
+          if (seedTriVert2 == trgtTriVert0 || seedTriVert2 == trgtTriVert1 || seedTriVert2 == trgtTriVert2  )
+          {
+            vCount++;
+          }
+
+          BOOST_ASSERT(vCount < 3); // No way 2 faces can share all 3 vertices. Something is VERY wrong at this point
+
+          // So if our vertex match count is 2 then add this triangle index into the list of Face Indices as
+          // neighbors for the source triangle.
+          if (vCount == 2)
+          {
+            loop_neighbors.push_back(vertIdxs[vt]);
+          }
+        }
+      }
+      BOOST_ASSERT(loop_neighbors.size() > 2);
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const DREAM3D::SurfaceMesh::Face_t* m_Faces;
+    MeshVertLinks* m_CellLinks;
+    int32_t* m_Counts;
+    const int64_t* m_Offsets;
+    int32_t* m_Cells;
+};
+
+/**
+ * @brief The MeshFaceNeighbors class contains arrays of Faces for each Face in the mesh. This allows quick query to the Face
+ * to determine what Faces share an edge with it.
+ *
+ * The lists are stored back to back in a single array of Face ids with an offset for
+ * each Face, so the list of Face 't' is cells[offsets[t]] to cells[offsets[t+1]-1].
  */
 class MeshFaceNeighbors
 {
@@ -72,46 +188,49 @@ class MeshFaceNeighbors
     // -----------------------------------------------------------------------------
     virtual ~MeshFaceNeighbors()
     {
-      if ( this->Array == NULL )
-      {
-        return;
-      }
-
-      for (size_t i=0; i < this->Size; i++)
-      {
-        if ( this->Array[i].cells != NULL )
-        {
-          delete [] this->Array[i].cells;
-        }
-      }
-
-      delete [] this->Array;
-    }
-
-    //----------------------------------------------------------------------------
-    inline void insertCellReference(size_t ptId,
-                                    unsigned short pos,
-                                    size_t cellId)
-    {
-      this->Array[ptId].cells[pos] = cellId;
     }
 
     // Description:
     // Get a link structure given a point id.
-    NeighborList& getNeighborList(size_t ptId) {
-      return this->Array[ptId];
+    NeighborList getNeighborList(size_t ptId) {
+      NeighborList list;
+      list.ncells = getNumberOfFaces(ptId);
+      list.cells = getNeighborListPointer(ptId);
+      return list;
     }
 
     // Description:
     // Get the number of cells using the point specified by ptId.
     unsigned short getNumberOfFaces(size_t ptId) {
-      return this->Array[ptId].ncells;
+      return static_cast<unsigned short>(m_Offsets[ptId + 1] - m_Offsets[ptId]);
     }
 
     // Description:
     // Return a list of cell ids using the point.
     int* getNeighborListPointer(size_t ptId) {
-      return this->Array[ptId].cells;
+      return (m_Cells.empty() ? NULL : &(m_Cells.front()) + m_Offsets[ptId]);
+    }
+
+    /**
+     * @brief Returns the offset of the list of each Face followed by the total number of entries
+     */
+    std::vector<int64_t>& getOffsets() { return m_Offsets; }
+
+    /**
+     * @brief Returns the lists of all the Faces stored back to back
+     */
+    std::vector<int32_t>& getCells() { return m_Cells; }
+
+    /**
+     * @brief Replaces the lists with the given offsets and cells. The vectors are
+     * swapped into this object so they are empty on return.
+     */
+    void setLinks(std::vector<int64_t> &offsets, std::vector<int32_t> &cells)
+    {
+      m_Offsets.swap(offsets);
+      m_Cells.swap(cells);
+      std::vector<int64_t>().swap(offsets);
+      std::vector<int32_t>().swap(cells);
     }
 
     // -----------------------------------------------------------------------------
@@ -124,174 +243,90 @@ class MeshFaceNeighbors
 
       size_t nFaces = faces->GetNumberOfTuples();
 
-      allocate(faces->GetNumberOfTuples());
+      m_Offsets.assign(nFaces + 1, 0);
+      m_Cells.clear();
+      if (nFaces == 0)
+      {
+        return;
+      }
 
-      // Allocate an array of bools that we use each iteration of triangle so that we don't put duplicates into the array
-      boost::shared_array<bool> visitedPtr(new bool[nFaces]);
-      bool* visited = visitedPtr.get();
-      ::memset(visitedPtr.get(), 0, nFaces);
+      // The first pass counts the neighbors of each Face, then the second pass
+      // writes them out once we know where each list starts
+      std::vector<int32_t> counts(nFaces, 0);
+      MeshFaceNeighborsImpl countImpl(faces->GetPointer(0), cellLinks.get(), &(counts.front()), NULL, NULL);
 
-      // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-      std::vector<int> loop_neighbors(32, 0);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nFaces), countImpl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        countImpl.generate(0, nFaces);
+      }
 
-      // Build up the Face Adjacency list now that we have the cell links
       for(size_t t = 0; t < nFaces; ++t)
       {
-        //   std::cout << "Analyzing Face " << t << std::endl;
-        DREAM3D::SurfaceMesh::Face_t& seedFace = *(faces->GetPointer(t));
-        for(size_t v = 0; v < 3; ++v)
-        {
-          //   std::cout << " vert " << v << std::endl;
-          int nTris = cellLinks->getNumberOfFaces(seedFace.verts[v]);
-          int* vertIdxs = cellLinks->getFaceListPointer(seedFace.verts[v]);
+        m_Offsets[t + 1] = m_Offsets[t] + counts[t];
+      }
+      std::vector<int32_t>().swap(counts);
+      m_Cells.resize(m_Offsets[nFaces]);
+      if (m_Cells.empty() == true)
+      {
+        return;
+      }
 
-          for(int vt = 0; vt < nTris; ++vt)
-          {
-            if (vertIdxs[vt] == static_cast<int>(t) ) { continue; } // This is the same triangle as our "source" triangle
-            if (visited[vertIdxs[vt]] == true) { continue; } // We already added this triangle so loop again
-            //      std::cout << "   Comparing Face " << vertIdxs[vt] << std::endl;
-            DREAM3D::SurfaceMesh::Face_t& vertTri = *(faces->GetPointer(vertIdxs[vt]));
-            int vCount = 0;
-            // Loop over all the vertex indices of this triangle and try to match 2 of them to the current loop triangle
-            // If there are 2 matches then that triangle is a neighbor of this triangle. if there are more than 2 matches
-            // then there is a real problem with the mesh and the program is going to assert.
-            // Unrolled the loop to shave about 25% of time off the outer loop.
-            int seedTriVert0 = seedFace.verts[0];
-            int seedTriVert1 = seedFace.verts[1];
-            int seedTriVert2 = seedFace.verts[2];
-            int trgtTriVert0 = vertTri.verts[0];
-            int trgtTriVert1 = vertTri.verts[1];
-            int trgtTriVert2 = vertTri.verts[2];
-
-            if (seedTriVert0 == trgtTriVert0 || seedTriVert0 == trgtTriVert1 || seedTriVert0 == trgtTriVert2  )
-            {
-              vCount++;
-            }
-            if (seedTriVert1 == trgtTriVert0 || seedTriVert1 == trgtTriVert1 || seedTriVert1 == trgtTriVert2  )
-            {
-              vCount++;
-            }
-            if (seedTriVert2 == trgtTriVert0 || seedTriVert2 == trgtTriVert1 || seedTriVert2 == trgtTriVert2  )
-            {
-              vCount++;
-            }
-
-            BOOST_ASSERT(vCount < 3); // No way 2 faces can share all 3 vertices. Something is VERY wrong at this point
-
-            // So if our vertex match count is 2 and we have not visited the triangle in question then add this triangle index
-            // into the list of Face Indices as neighbors for the source triangle.
-            if (vCount == 2)
-            {
-              //std::cout << "       Neighbor: " << vertIdxs[vt] << std::endl;
-              // Use the current count of neighbors as the index
-              // into the loop_neighbors vector and place the value of the vertex triangle at that index
-              loop_neighbors[this->Array[t].ncells] = vertIdxs[vt];
-              this->Array[t].ncells++;// Increment the count for the next time through
-              if (this->Array[t].ncells >= loop_neighbors.size())
-              {
-                loop_neighbors.resize(loop_neighbors.size() + 10);
-              }
-              visited[vertIdxs[vt]] = true; // Set this triangle as visited so we do NOT add it again
-            }
-          }
-        }
-        BOOST_ASSERT(this->Array[t].ncells > 2);
-        // Reset all the visited triangle indexs back to false (zero)
-        for(size_t k = 0;k < this->Array[t].ncells; ++k)
-        {
-          visited[loop_neighbors[k]] = false;
-        }
-        // Allocate the array storage for the current triangle to hold its Face list
-        this->Array[t].cells = new int[this->Array[t].ncells];
-        // Only copy the first "N" values from the loop_neighbors vector into the storage array
-        ::memcpy(this->Array[t].cells, &(loop_neighbors[0]), sizeof(int) * this->Array[t].ncells);
+      MeshFaceNeighborsImpl fillImpl(faces->GetPointer(0), cellLinks.get(), NULL, &(m_Offsets.front()), &(m_Cells.front()));
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, nFaces), fillImpl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        fillImpl.generate(0, nFaces);
       }
     }
 
     // -----------------------------------------------------------------------------
-    //
+    // Reads the older serialized form where each list was stored as a 16 bit count
+    // followed by the Face ids.
     // -----------------------------------------------------------------------------
     void deserializeLinks(std::vector<uint8_t> &buffer, size_t nFaces)
     {
       size_t offset = 0;
-      allocate(nFaces); // Allocate all the links with 0 and NULL;
       uint8_t* bufPtr = &(buffer.front());
+      m_Offsets.assign(nFaces + 1, 0);
+      m_Cells.resize((buffer.size() - nFaces * sizeof(uint16_t)) / sizeof(int32_t));
 
-      // Walk the array and allocate all the array links to Zero and NULL
-      uint16_t* ncells = NULL;
-      //int32_t* cells = NULL;
+      uint16_t ncells = 0;
       for(size_t i = 0; i < nFaces; ++i)
       {
-        ncells = reinterpret_cast<uint16_t*>(bufPtr + offset);
-        this->Array[i].ncells = *ncells; // Set the number of cells in this link
+        ::memcpy(&ncells, bufPtr + offset, sizeof(uint16_t)); // Get the number of cells in this link
         offset += 2;
-        this->Array[i].cells = new int32_t[(*ncells)]; // Allocate a new chunk of memory to store the list
-        ::memcpy(this->Array[i].cells, bufPtr + offset, (*ncells)*sizeof(int32_t) ); // Copy from teh buffer into the new list memory
-        offset += (*ncells) * sizeof(int32_t); // Increment the offset
-      }
-    }
-
-
-  protected:
-    MeshFaceNeighbors():Array(NULL),Size(0) {}
-
-    //----------------------------------------------------------------------------
-    // This will allocate memory to hold all the NeighborList structures where each
-    // structure is initialized to Zero Entries and a NULL Pointer
-    void allocate(size_t sz, size_t ext=1000)
-    {
-      static MeshFaceNeighbors::NeighborList linkInit = {0,NULL};
-
-      // This makes sure we deallocate any lists that have been created
-      for (size_t i=0; i<this->Size; i++)
-      {
-        if ( this->Array[i].cells != NULL )
+        m_Offsets[i + 1] = m_Offsets[i] + ncells;
+        if (ncells > 0)
         {
-          delete [] this->Array[i].cells;
+          ::memcpy(&(m_Cells[m_Offsets[i]]), bufPtr + offset, ncells*sizeof(int32_t) ); // Copy from the buffer into the list memory
         }
-      }
-      // Now delete all the "NeighborLists" structures
-      if ( this->Array != NULL )
-      {
-        delete [] this->Array;
-      }
-
-      this->Size = sz;
-      // Allocate a whole new set of structures
-      this->Array = new MeshFaceNeighbors::NeighborList[sz];
-
-      // Initialize each structure to have 0 entries and NULL pointer.
-      for (size_t i=0; i < sz; i++)
-      {
-        this->Array[i] = linkInit;
+        offset += ncells * sizeof(int32_t); // Increment the offset
       }
     }
 
 
-    // -----------------------------------------------------------------------------
-    //
-    // -----------------------------------------------------------------------------
-    void incrementLinkCount(size_t ptId)
-    {
-      this->Array[ptId].ncells++;
-    }
-
-
-    //----------------------------------------------------------------------------
-    // This will allocate the actual memory to hold each NeighborList
-    void allocateLinks(size_t n)
-    {
-      for (size_t i=0; i < n; i++)
-      {
-        this->Array[i].cells = new int[this->Array[i].ncells];
-      }
-    }
+  protected:
+    MeshFaceNeighbors() {}
 
   private:
-    NeighborList* Array;   // pointer to data
-    size_t Size;
-
+    std::vector<int64_t> m_Offsets;
+    std::vector<int32_t> m_Cells;
 
+    MeshFaceNeighbors(const MeshFaceNeighbors&); // Copy Constructor Not Implemented
+    void operator=(const MeshFaceNeighbors&); // Operator '=' Not Implemented
 };
 
 #endif /* _MeshFaceNeighbors_hpp_H_ */
@@ -0,0 +1,500 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef _MeshKeyGroups_hpp_H_
+#define _MeshKeyGroups_hpp_H_
+
+#include <string.h>
+
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
+#include "DREAM3DLib/Common/SurfaceMeshStructs.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief Counts the radix digits of each block of keys for one pass of the sort
+ */
+class MeshKeyRadixCountImpl
+{
+  public:
+    MeshKeyRadixCountImpl(const uint64_t* keys, size_t numKeys, size_t blockSize, int shift, size_t* counts) :
+      m_Keys(keys),
+      m_NumKeys(numKeys),
+      m_BlockSize(blockSize),
+      m_Shift(shift),
+      m_Counts(counts)
+    {}
+    virtual ~MeshKeyRadixCountImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t b = start; b < end; ++b)
+      {
+        size_t* counts = m_Counts + b * 256;
+        ::memset(counts, 0, 256 * sizeof(size_t));
+        size_t last = (b + 1) * m_BlockSize < m_NumKeys ? (b + 1) * m_BlockSize : m_NumKeys;
+        for (size_t i = b * m_BlockSize; i < last; ++i)
+        {
+          counts[(m_Keys[i] >> m_Shift) & 0xFF]++;
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const uint64_t* m_Keys;
+    size_t m_NumKeys;
+    size_t m_BlockSize;
+    int m_Shift;
+    size_t* m_Counts;
+};
+
+/**
+ * @brief Moves each block of keys (and values) to the output positions computed
+ * from the prefix sum of the digit counts. Each block owns its own row of offsets
+ * so the blocks can be scattered concurrently and the sort stays stable.
+ */
+class MeshKeyRadixScatterImpl
+{
+  public:
+    MeshKeyRadixScatterImpl(const uint64_t* keys, const int32_t* values, size_t numKeys, size_t blockSize, int shift,
+                            size_t* offsets, uint64_t* outKeys, int32_t* outValues) :
+      m_Keys(keys),
+      m_Values(values),
+      m_NumKeys(numKeys),
+      m_BlockSize(blockSize),
+      m_Shift(shift),
+      m_Offsets(offsets),
+      m_OutKeys(outKeys),
+      m_OutValues(outValues)
+    {}
+    virtual ~MeshKeyRadixScatterImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t b = start; b < end; ++b)
+      {
+        size_t* offsets = m_Offsets + b * 256;
+        size_t last = (b + 1) * m_BlockSize < m_NumKeys ? (b + 1) * m_BlockSize : m_NumKeys;
+        for (size_t i = b * m_BlockSize; i < last; ++i)
+        {
+          size_t dest = offsets[(m_Keys[i] >> m_Shift) & 0xFF]++;
+          m_OutKeys[dest] = m_Keys[i];
+          if (NULL != m_Values) { m_OutValues[dest] = m_Values[i]; }
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const uint64_t* m_Keys;
+    const int32_t* m_Values;
+    size_t m_NumKeys;
+    size_t m_BlockSize;
+    int m_Shift;
+    size_t* m_Offsets;
+    uint64_t* m_OutKeys;
+    int32_t* m_OutValues;
+};
+
+/**
+ * @brief Writes the three edge keys of each triangle. The value of each key is
+ * the triangle id. The values are skipped if the values pointer is NULL.
+ */
+class MeshFaceEdgeKeysImpl
+{
+  public:
+    MeshFaceEdgeKeysImpl(const DREAM3D::SurfaceMesh::Face_t* faces, uint64_t* keys, int32_t* values) :
+      m_Faces(faces),
+      m_Keys(keys),
+      m_Values(values)
+    {}
+    virtual ~MeshFaceEdgeKeysImpl(){}
+
+    void generate(size_t start, size_t end) const;
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const DREAM3D::SurfaceMesh::Face_t* m_Faces;
+    uint64_t* m_Keys;
+    int32_t* m_Values;
+};
+
+/**
+ * @brief Writes the key of the pair of face labels of each triangle. The value
+ * of each key is the triangle id.
+ */
+class MeshFaceLabelKeysImpl
+{
+  public:
+    MeshFaceLabelKeysImpl(const int32_t* faceLabels, uint64_t* keys, int32_t* values) :
+      m_FaceLabels(faceLabels),
+      m_Keys(keys),
+      m_Values(values)
+    {}
+    virtual ~MeshFaceLabelKeysImpl(){}
+
+    void generate(size_t start, size_t end) const;
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const int32_t* m_FaceLabels;
+    uint64_t* m_Keys;
+    int32_t* m_Values;
+};
+
+/**
+ * @class MeshKeyGroups MeshKeyGroups.hpp DREAM3DLib/SurfaceMeshingFilters/MeshKeyGroups.hpp
+ * @brief Groups the entries of a surface mesh by a 64 bit key, for example the
+ * triangles that share an edge or the triangles that share a pair of grain labels.
+ * The keys are sorted with a parallel radix sort and the runs of equal keys are
+ * stored as compressed rows: the unique keys in ascending order, an offset for
+ * each key and the values of every group stored back to back. The sort is stable
+ * so the values of each group keep the order they were generated in, which for the
+ * generate* methods is ascending triangle id.
+ *
+ * This replaces the std::map/std::set based bookkeeping which used many times
+ * the memory of the mesh itself and could only run on a single thread.
+ */
+class MeshKeyGroups
+{
+  public:
+    DREAM3D_SHARED_POINTERS(MeshKeyGroups)
+    DREAM3D_STATIC_NEW_MACRO(MeshKeyGroups)
+    DREAM3D_TYPE_MACRO(MeshKeyGroups)
+
+    virtual ~MeshKeyGroups() {}
+
+    /**
+     * @brief Returns the key for an unordered pair of 32 bit values. The smaller
+     * value is stored in the low 32 bits so the keys sort by the larger value first.
+     */
+    static uint64_t PairKey(int32_t a, int32_t b)
+    {
+      if (a > b) { int32_t t = a; a = b; b = t; }
+      return (static_cast<uint64_t>(static_cast<uint32_t>(b)) << 32) | static_cast<uint32_t>(a);
+    }
+
+    /**
+     * @brief Returns the smaller value of a key made by PairKey
+     */
+    static int32_t PairKeyLow(uint64_t key)
+    {
+      return static_cast<int32_t>(static_cast<uint32_t>(key & 0xFFFFFFFF));
+    }
+
+    /**
+     * @brief Returns the larger value of a key made by PairKey
+     */
+    static int32_t PairKeyHigh(uint64_t key)
+    {
+      return static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+    }
+
+    /**
+     * @brief Sorts the keys in place with a stable least significant digit radix
+     * sort, 8 bits per pass. Passes where every key has the same digit are skipped
+     * so small keys only cost the passes they need.
+     * @param keys The keys to sort
+     * @param values Values that are moved along with the keys. May be empty.
+     */
+    static void SortKeys(std::vector<uint64_t> &keys, std::vector<int32_t> &values)
+    {
+      size_t numKeys = keys.size();
+      if (numKeys < 2)
+      {
+        return;
+      }
+      bool hasValues = (values.size() == numKeys);
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+#endif
+
+      size_t blockSize = 1 << 16;
+      size_t numBlocks = (numKeys + blockSize - 1) / blockSize;
+      std::vector<size_t> counts(numBlocks * 256, 0);
+      std::vector<uint64_t> keysTmp(numKeys);
+      std::vector<int32_t> valuesTmp(hasValues ? numKeys : 0);
+
+      uint64_t* src = &(keys.front());
+      uint64_t* dst = &(keysTmp.front());
+      int32_t* srcValues = hasValues ? &(values.front()) : NULL;
+      int32_t* dstValues = hasValues ? &(valuesTmp.front()) : NULL;
+
+      for (int shift = 0; shift < 64; shift += 8)
+      {
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1),
+                            MeshKeyRadixCountImpl(src, numKeys, blockSize, shift, &(counts.front())), tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          MeshKeyRadixCountImpl serial(src, numKeys, blockSize, shift, &(counts.front()));
+          serial.generate(0, numBlocks);
+        }
+
+        // Turn the counts into the first output position of each digit of each block
+        size_t total = 0;
+        bool skipPass = false;
+        for (size_t d = 0; d < 256 && skipPass == false; ++d)
+        {
+          size_t digitStart = total;
+          for (size_t b = 0; b < numBlocks; ++b)
+          {
+            size_t c = counts[b * 256 + d];
+            counts[b * 256 + d] = total;
+            total += c;
+          }
+          if (total - digitStart == numKeys) { skipPass = true; }
+        }
+        if (skipPass == true)
+        {
+          continue;
+        }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+        if (doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1),
+                            MeshKeyRadixScatterImpl(src, srcValues, numKeys, blockSize, shift, &(counts.front()), dst, dstValues),
+                            tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          MeshKeyRadixScatterImpl serial(src, srcValues, numKeys, blockSize, shift, &(counts.front()), dst, dstValues);
+          serial.generate(0, numBlocks);
+        }
+        std::swap(src, dst);
+        std::swap(srcValues, dstValues);
+      }
+
+      // An odd number of passes leaves the sorted data in the temporary buffers
+      if (src != &(keys.front()))
+      {
+        keys.swap(keysTmp);
+        if (hasValues == true) { values.swap(valuesTmp); }
+      }
+    }
+
+    /**
+     * @brief Sorts the keys and values then groups the runs of equal keys. The
+     * vectors are consumed by this method. If values is empty only the unique
+     * keys and their offsets are kept.
+     */
+    void generate(std::vector<uint64_t> &keys, std::vector<int32_t> &values)
+    {
+      SortKeys(keys, values);
+
+      m_Keys.clear();
+      m_Offsets.clear();
+      size_t numKeys = keys.size();
+      for (size_t i = 0; i < numKeys; ++i)
+      {
+        if (i == 0 || keys[i] != keys[i - 1])
+        {
+          m_Keys.push_back(keys[i]);
+          m_Offsets.push_back(i);
+        }
+      }
+      m_Offsets.push_back(numKeys);
+      std::vector<uint64_t>().swap(keys);
+      m_Values.swap(values);
+      std::vector<int32_t>().swap(values);
+    }
+
+    /**
+     * @brief Groups the triangles by their edges. The key of each group is the
+     * PairKey of the 2 vertex ids of the edge and the values are the ids of the
+     * triangles that share the edge.
+     * @param facesPtr The triangles of the mesh
+     * @param withFaces If false only the unique edges are generated and the groups
+     * have no values, which saves a third of the memory and time.
+     */
+    void generateFaceEdges(DREAM3D::SurfaceMesh::FaceListPointer_t facesPtr, bool withFaces = true)
+    {
+      size_t numFaces = facesPtr->GetNumberOfTuples();
+      std::vector<uint64_t> keys(numFaces * 3);
+      std::vector<int32_t> values(withFaces ? numFaces * 3 : 0);
+      if (numFaces > 0)
+      {
+        MeshFaceEdgeKeysImpl impl(facesPtr->GetPointer(0), &(keys.front()), withFaces ? &(values.front()) : NULL);
+        generateKeys(impl, numFaces);
+      }
+      generate(keys, values);
+    }
+
+    /**
+     * @brief Groups the triangles by the pair of grain ids on either side of the
+     * triangle. The key of each group is the PairKey of the 2 face labels.
+     * @param faceLabels The 2 component face labels array
+     */
+    void generateFaceLabelPairs(DataArray<int32_t>* faceLabels)
+    {
+      size_t numFaces = faceLabels->GetNumberOfTuples();
+      std::vector<uint64_t> keys(numFaces);
+      std::vector<int32_t> values(numFaces);
+      if (numFaces > 0)
+      {
+        MeshFaceLabelKeysImpl impl(faceLabels->GetPointer(0), &(keys.front()), &(values.front()));
+        generateKeys(impl, numFaces);
+      }
+      generate(keys, values);
+    }
+
+    /**
+     * @brief Returns the number of unique keys
+     */
+    size_t getNumberOfGroups() { return m_Keys.size(); }
+
+    /**
+     * @brief Returns the key of a group
+     */
+    uint64_t getKey(size_t group) { return m_Keys[group]; }
+
+    /**
+     * @brief Returns the number of values in a group
+     */
+    size_t getGroupSize(size_t group) { return m_Offsets[group + 1] - m_Offsets[group]; }
+
+    /**
+     * @brief Returns a pointer to the first value of a group. The values of the
+     * group are contiguous.
+     * @return NULL if the groups were built without values or the group is empty
+     */
+    int32_t* getGroupValues(size_t group)
+    {
+      if (m_Values.empty() == true || m_Offsets[group + 1] == m_Offsets[group]) { return NULL; }
+      return &(m_Values[m_Offsets[group]]);
+    }
+
+    std::vector<uint64_t>& getKeys() { return m_Keys; }
+    std::vector<size_t>& getOffsets() { return m_Offsets; }
+    std::vector<int32_t>& getValues() { return m_Values; }
+
+  protected:
+    MeshKeyGroups() {}
+
+    template<typename T>
+    void generateKeys(T &impl, size_t numFaces)
+    {
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numFaces), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.generate(0, numFaces);
+      }
+    }
+
+  private:
+    std::vector<uint64_t> m_Keys;
+    std::vector<size_t> m_Offsets;
+    std::vector<int32_t> m_Values;
+
+    MeshKeyGroups(const MeshKeyGroups&); // Copy Constructor Not Implemented
+    void operator=(const MeshKeyGroups&); // Operator '=' Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+inline void MeshFaceEdgeKeysImpl::generate(size_t start, size_t end) const
+{
+  for (size_t t = start; t < end; ++t)
+  {
+    const DREAM3D::SurfaceMesh::Face_t& tri = m_Faces[t];
+    m_Keys[t * 3] = MeshKeyGroups::PairKey(tri.verts[0], tri.verts[1]);
+    m_Keys[t * 3 + 1] = MeshKeyGroups::PairKey(tri.verts[1], tri.verts[2]);
+    m_Keys[t * 3 + 2] = MeshKeyGroups::PairKey(tri.verts[2], tri.verts[0]);
+    if (NULL == m_Values) { continue; }
+    m_Values[t * 3] = static_cast<int32_t>(t);
+    m_Values[t * 3 + 1] = static_cast<int32_t>(t);
+    m_Values[t * 3 + 2] = static_cast<int32_t>(t);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+inline void MeshFaceLabelKeysImpl::generate(size_t start, size_t end) const
+{
+  for (size_t t = start; t < end; ++t)
+  {
+    m_Keys[t] = MeshKeyGroups::PairKey(m_FaceLabels[t * 2], m_FaceLabels[t * 2 + 1]);
+    m_Values[t] = static_cast<int32_t>(t);
+  }
+}
+
+#endif /* _MeshKeyGroups_hpp_H_ */
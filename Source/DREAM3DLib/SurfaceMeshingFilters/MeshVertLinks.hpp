@@ -39,15 +39,141 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/shared_array.hpp>
 
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
+#include "DREAM3DLib/Common/SurfaceMeshStructs.h"
 //#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/atomic.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief Counts how many Faces use each vertex. The counter type is a plain integer
+ * for the serial build and a tbb::atomic when the Faces are counted in parallel.
+ */
+template<typename T>
+class MeshVertLinksCountImpl
+{
+  public:
+    MeshVertLinksCountImpl(const DREAM3D::SurfaceMesh::Face_t* faces, T* counts) :
+      m_Faces(faces),
+      m_Counts(counts)
+    {}
+    virtual ~MeshVertLinksCountImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t cellId = start; cellId < end; ++cellId)
+      {
+        m_Counts[m_Faces[cellId].verts[0]]++;
+        m_Counts[m_Faces[cellId].verts[1]]++;
+        m_Counts[m_Faces[cellId].verts[2]]++;
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const DREAM3D::SurfaceMesh::Face_t* m_Faces;
+    T* m_Counts;
+};
+
+/**
+ * @brief Writes each Face id into the lists of its 3 vertices. The cursor of each
+ * vertex starts at 0 and is incremented as the slots are handed out.
+ */
+template<typename T>
+class MeshVertLinksFillImpl
+{
+  public:
+    MeshVertLinksFillImpl(const DREAM3D::SurfaceMesh::Face_t* faces, const int64_t* offsets, T* cursors, int32_t* cells) :
+      m_Faces(faces),
+      m_Offsets(offsets),
+      m_Cursors(cursors),
+      m_Cells(cells)
+    {}
+    virtual ~MeshVertLinksFillImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t cellId = start; cellId < end; ++cellId)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          int32_t ptId = m_Faces[cellId].verts[j];
+          int32_t pos = m_Cursors[ptId]++;
+          m_Cells[m_Offsets[ptId] + pos] = static_cast<int32_t>(cellId);
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const DREAM3D::SurfaceMesh::Face_t* m_Faces;
+    const int64_t* m_Offsets;
+    T* m_Cursors;
+    int32_t* m_Cells;
+};
+
+/**
+ * @brief Sorts the list of each vertex. The parallel fill hands out the slots in
+ * whatever order the threads get to them, sorting makes the lists identical to
+ * the serial build.
+ */
+class MeshVertLinksSortImpl
+{
+  public:
+    MeshVertLinksSortImpl(const int64_t* offsets, int32_t* cells) :
+      m_Offsets(offsets),
+      m_Cells(cells)
+    {}
+    virtual ~MeshVertLinksSortImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t ptId = start; ptId < end; ++ptId)
+      {
+        std::sort(m_Cells + m_Offsets[ptId], m_Cells + m_Offsets[ptId + 1]);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const int64_t* m_Offsets;
+    int32_t* m_Cells;
+};
+
 /**
  * @brief The MeshVertLinks class contains arrays of Faces for each Node in the mesh. This allows quick query to the node
  * to determine what Cells the node is a part of.
+ *
+ * The lists are stored back to back in a single array of Face ids with an offset for
+ * each vertex, so the list of vertex 'v' is cells[offsets[v]] to cells[offsets[v+1]-1]
+ * and the Face ids of each list are in ascending order.
  */
 class MeshVertLinks
 {
@@ -68,51 +194,59 @@ class MeshVertLinks
     // -----------------------------------------------------------------------------
     virtual ~MeshVertLinks()
     {
-      if ( this->Array == NULL )
-      {
-        return;
-      }
-
-      for (size_t i=0; i<this->Size; i++)
-      {
-        if ( this->Array[i].cells != NULL )
-        {
-          delete [] this->Array[i].cells;
-        }
-      }
-
-      delete [] this->Array;
-    }
-
-
-
-    //----------------------------------------------------------------------------
-    inline void insertCellReference(size_t ptId,
-                                    unsigned short pos,
-                                    size_t cellId)
-    {
-      this->Array[ptId].cells[pos] = cellId;
     }
 
     //----------------------------------------------------------------------------
     // Description:
     // Get a link structure given a point id.
-    FaceList& getFaceList(size_t ptId) {
-      return this->Array[ptId];
+    FaceList getFaceList(size_t ptId) {
+      FaceList list;
+      list.ncells = getNumberOfFaces(ptId);
+      list.cells = getFaceListPointer(ptId);
+      return list;
     }
 
     //----------------------------------------------------------------------------
     // Description:
     // Get the number of cells using the point specified by ptId.
     uint16_t getNumberOfFaces(size_t ptId) {
-      return this->Array[ptId].ncells;
+      return static_cast<uint16_t>(m_Offsets[ptId + 1] - m_Offsets[ptId]);
     }
 
     //----------------------------------------------------------------------------
     // Description:
     // Return a list of cell ids using the point.
     int* getFaceListPointer(size_t ptId) {
-      return this->Array[ptId].cells;
+      return (m_Cells.empty() ? NULL : &(m_Cells.front()) + m_Offsets[ptId]);
+    }
+
+    //----------------------------------------------------------------------------
+    // Description:
+    // Get the number of points that have a list
+    size_t getNumberOfPoints() {
+      return (m_Offsets.empty() ? 0 : m_Offsets.size() - 1);
+    }
+
+    /**
+     * @brief Returns the offset of the list of each point followed by the total number of entries
+     */
+    std::vector<int64_t>& getOffsets() { return m_Offsets; }
+
+    /**
+     * @brief Returns the lists of all the points stored back to back
+     */
+    std::vector<int32_t>& getCells() { return m_Cells; }
+
+    /**
+     * @brief Replaces the lists with the given offsets and cells. The vectors are
+     * swapped into this object so they are empty on return.
+     */
+    void setLinks(std::vector<int64_t> &offsets, std::vector<int32_t> &cells)
+    {
+      m_Offsets.swap(offsets);
+      m_Cells.swap(cells);
+      std::vector<int64_t>().swap(offsets);
+      std::vector<int32_t>().swap(cells);
     }
 
     // -----------------------------------------------------------------------------
@@ -127,7 +261,8 @@ class MeshVertLinks
     }
 
     // -----------------------------------------------------------------------------
-    //
+    // Builds the lists with a counting sort: count the uses of each point, turn the
+    // counts into offsets then place each Face id into its slot.
     // -----------------------------------------------------------------------------
     void generateMeshVertLinks(DREAM3D::SurfaceMesh::VertListPointer_t nodes,
                                DREAM3D::SurfaceMesh::FaceListPointer_t Faces )
@@ -136,127 +271,85 @@ class MeshVertLinks
       size_t numPts = nodes->GetNumberOfTuples();
       size_t numCells = Faces->GetNumberOfTuples();
 
-      // Allocate the basic structures
-      allocate(numPts);
-
-      size_t cellId;
-      unsigned short* linkLoc;
-
-      // fill out lists with number of references to cells
-      typedef boost::shared_array<unsigned short> SharedShortArray_t;
-      SharedShortArray_t linkLocPtr(new unsigned short[numPts]);
-      linkLoc = linkLocPtr.get();
-
-      ::memset(linkLoc, 0, numPts*sizeof(unsigned short));
-
-
-      size_t pts[3];
-      size_t npts = 3; // ALWAYS 3 points for a Face
+      m_Offsets.assign(numPts + 1, 0);
+      m_Cells.assign(numCells * 3, 0);
+      if (numCells == 0)
+      {
+        return;
+      }
+      DREAM3D::SurfaceMesh::Face_t* faces = Faces->GetPointer(0);
+      int32_t* cells = &(m_Cells.front());
 
-      //vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-      // traverse data to determine number of uses of each point
-      for (cellId=0; cellId < numCells; cellId++)
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if (doParallel == true)
       {
-        getCellPoints(Faces, cellId, npts, pts);
-        for (size_t j=0; j < npts; j++)
+        typedef tbb::atomic<int32_t> Counter_t;
+        boost::shared_array<Counter_t> countsPtr(new Counter_t[numPts]);
+        Counter_t* counts = countsPtr.get();
+        for (size_t i = 0; i < numPts; ++i) { counts[i] = 0; }
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numCells),
+                          MeshVertLinksCountImpl<Counter_t>(faces, counts), tbb::auto_partitioner());
+        for (size_t i = 0; i < numPts; ++i)
         {
-          this->incrementLinkCount(pts[j]);
+          m_Offsets[i + 1] = m_Offsets[i] + counts[i];
+          counts[i] = 0;
         }
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numCells),
+                          MeshVertLinksFillImpl<Counter_t>(faces, &(m_Offsets.front()), counts, cells), tbb::auto_partitioner());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numPts),
+                          MeshVertLinksSortImpl(&(m_Offsets.front()), cells), tbb::auto_partitioner());
       }
-
-      // now allocate storage for the links
-      this->allocateLinks(numPts);
-
-      for (cellId=0; cellId < numCells; cellId++)
+      else
+#endif
       {
-        getCellPoints(Faces, cellId, npts, pts);
-        for (size_t j=0; j < npts; j++)
+        std::vector<int32_t> counts(numPts, 0);
+        MeshVertLinksCountImpl<int32_t> countImpl(faces, &(counts.front()));
+        countImpl.generate(0, numCells);
+        for (size_t i = 0; i < numPts; ++i)
         {
-          this->insertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
+          m_Offsets[i + 1] = m_Offsets[i] + counts[i];
+          counts[i] = 0;
         }
+        // The serial fill visits the Faces in order so the lists come out sorted
+        MeshVertLinksFillImpl<int32_t> fillImpl(faces, &(m_Offsets.front()), &(counts.front()), cells);
+        fillImpl.generate(0, numCells);
       }
-
     }
 
     // -----------------------------------------------------------------------------
-    //
+    // Reads the older serialized form where each list was stored as a 16 bit count
+    // followed by the Face ids.
     // -----------------------------------------------------------------------------
     void deserializeLinks(std::vector<uint8_t> &buffer, size_t nVerts)
     {
       size_t offset = 0;
-      allocate(nVerts); // Allocate all the links with 0 and NULL;
       uint8_t* bufPtr = &(buffer.front());
+      m_Offsets.assign(nVerts + 1, 0);
+      m_Cells.resize((buffer.size() - nVerts * sizeof(uint16_t)) / sizeof(int32_t));
 
-      // Walk the array and allocate all the array links to Zero and NULL
-      uint16_t* ncells = NULL;
-     // int32_t* cells = NULL;
+      uint16_t ncells = 0;
       for(size_t i = 0; i < nVerts; ++i)
       {
-        ncells = reinterpret_cast<uint16_t*>(bufPtr + offset);
-        this->Array[i].ncells = *ncells; // Set the number of cells in this link
+        ::memcpy(&ncells, bufPtr + offset, sizeof(uint16_t)); // Get the number of cells in this link
         offset += 2;
-        this->Array[i].cells = new int32_t[this->Array[i].ncells]; // Allocate a new chunk of memory to store the list
-        ::memcpy(this->Array[i].cells, bufPtr + offset, this->Array[i].ncells*sizeof(int32_t) ); // Copy from teh buffer into the new list memory
-        offset += this->Array[i].ncells * sizeof(int32_t); // Increment the offset
-      }
-    }
-
-  protected:
-    MeshVertLinks():Array(NULL),Size(0) {}
-
-    //----------------------------------------------------------------------------
-    void allocate(size_t sz, size_t ext=1000)
-    {
-      static MeshVertLinks::FaceList linkInit = {0,NULL};
-
-
-      // This makes sure we deallocate any lists that have been created
-      for (size_t i = 0; i < Size; i++)
-      {
-        if ( this->Array[i].cells != NULL )
+        m_Offsets[i + 1] = m_Offsets[i] + ncells;
+        if (ncells > 0)
         {
-          delete [] this->Array[i].cells;
+          ::memcpy(&(m_Cells[m_Offsets[i]]), bufPtr + offset, ncells*sizeof(int32_t) ); // Copy from the buffer into the list memory
         }
+        offset += ncells * sizeof(int32_t); // Increment the offset
       }
-      // Now delete all the "NeighborLists" structures
-      if ( this->Array != NULL )
-      {
-        delete [] this->Array;
-      }
-
-      this->Size = sz;
-      // Allocate a whole new set of structures
-      this->Array = new MeshVertLinks::FaceList[sz];
-
-      // Initialize each structure to have 0 entries and NULL pointer.
-      for (size_t i=0; i < sz; i++)
-      {
-        this->Array[i] = linkInit;
-      }
-    }
-
-
-    // -----------------------------------------------------------------------------
-    //
-    // -----------------------------------------------------------------------------
-    void incrementLinkCount(size_t ptId)
-    {
-      this->Array[ptId].ncells++;
     }
 
-    //----------------------------------------------------------------------------
-    // Allocate memory for the list of lists of cell ids.
-    void allocateLinks(size_t n)
-    {
-      for (size_t i=0; i < n; i++)
-      {
-        this->Array[i].cells = new int[this->Array[i].ncells];
-      }
-    }
+  protected:
+    MeshVertLinks() {}
 
   private:
-    FaceList* Array;   // pointer to data
-    size_t Size;
+    std::vector<int64_t> m_Offsets;
+    std::vector<int32_t> m_Cells;
 
     MeshVertLinks(const MeshVertLinks&); // Copy Constructor Not Implemented
     void operator=(const MeshVertLinks&); // Operator '=' Not Implemented
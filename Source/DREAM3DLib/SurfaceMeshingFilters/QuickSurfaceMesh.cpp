@@ -41,9 +41,379 @@
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/DataArrays/IDataArray.h"
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #define QSM_GETCOORD(index, res, coord, origin)\
   coord = float((float(index)*float(res)) + float(origin));\
 
+namespace Detail
+{
+  /**
+   * @brief The faces that a voxel can create, in the order that a voxel creates them. The Max faces
+   * lie on the boundary of the volume and the Internal faces lie between the voxel and its +x, +y
+   * or +z neighbor.
+   */
+  enum QSMFaceKind
+  {
+    XMinFace = 0,
+    YMinFace,
+    ZMinFace,
+    XMaxFace,
+    XInternalFace,
+    YMaxFace,
+    YInternalFace,
+    ZMaxFace,
+    ZInternalFace
+  };
+
+  /**
+   * @brief The i, j, k offsets of the 4 nodes of each kind of face from the lowest node of the voxel
+   */
+  static const int QSMFaceNodes[9][4][3] = {
+    { {0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1} },
+    { {0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1} },
+    { {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0} },
+    { {1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1} },
+    { {1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1} },
+    { {1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1} },
+    { {1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1} },
+    { {1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1} },
+    { {1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1} }
+  };
+
+  /**
+   * @brief The 2 triangles of each kind of face as indices into the 4 nodes of the face
+   */
+  static const int QSMFaceTriangles[9][2][3] = {
+    { {0, 1, 2}, {1, 3, 2} },
+    { {0, 2, 1}, {1, 2, 3} },
+    { {0, 1, 2}, {1, 3, 2} },
+    { {2, 1, 0}, {2, 3, 1} },
+    { {0, 1, 2}, {1, 3, 2} },
+    { {2, 1, 0}, {2, 3, 1} },
+    { {0, 1, 2}, {1, 3, 2} },
+    { {1, 2, 0}, {3, 2, 1} },
+    { {0, 2, 1}, {1, 2, 3} }
+  };
+
+  struct QSMFace
+  {
+    int kind;
+    int64_t neighbor; // -1 for a face on the boundary of the volume
+  };
+
+  /**
+   * @brief The grains that touch a node. Only the first 4 grains are kept since the node type
+   * does not distinguish between more than 4 owners.
+   */
+  struct QSMNodeOwners
+  {
+    int32_t labels[4];
+    int8_t count;
+    bool boundary;
+  };
+
+  /**
+   * @brief Fills 'faces' with the faces that the voxel at i, j, k creates and returns how many there are
+   */
+  static int voxelFaces(int32_t* grainIds, const size_t* dims, size_t i, size_t j, size_t k, QSMFace* faces)
+  {
+    size_t xP = dims[0];
+    size_t yP = dims[1];
+    size_t zP = dims[2];
+    int64_t point = (k*xP*yP)+(j*xP)+i;
+    int n = 0;
+    if(i == 0) { faces[n].kind = XMinFace; faces[n].neighbor = -1; n++; }
+    if(j == 0) { faces[n].kind = YMinFace; faces[n].neighbor = -1; n++; }
+    if(k == 0) { faces[n].kind = ZMinFace; faces[n].neighbor = -1; n++; }
+    if(i == (xP-1)) { faces[n].kind = XMaxFace; faces[n].neighbor = -1; n++; }
+    else if(grainIds[point] != grainIds[point + 1]) { faces[n].kind = XInternalFace; faces[n].neighbor = point + 1; n++; }
+    if(j == (yP-1)) { faces[n].kind = YMaxFace; faces[n].neighbor = -1; n++; }
+    else if(grainIds[point] != grainIds[point + xP]) { faces[n].kind = YInternalFace; faces[n].neighbor = point + xP; n++; }
+    if(k == (zP-1)) { faces[n].kind = ZMaxFace; faces[n].neighbor = -1; n++; }
+    else if(grainIds[point] != grainIds[point + xP*yP]) { faces[n].kind = ZInternalFace; faces[n].neighbor = point + xP*yP; n++; }
+    return n;
+  }
+
+  static inline void addOwner(QSMNodeOwners &owners, int32_t label)
+  {
+    for (int8_t o = 0; o < owners.count; ++o)
+    {
+      if (owners.labels[o] == label) { return; }
+    }
+    if (owners.count < 4) { owners.labels[owners.count++] = label; }
+  }
+}
+
+/**
+ * @brief The QuickSurfaceMeshScanImpl class finds the nodes that are used on each plane of nodes.
+ * Node plane p is touched by the faces of voxel layers p-1 and p, so each plane can be scanned on
+ * its own with a single plane of scratch memory. The used nodes of a plane are kept in raster order,
+ * which is also the order they are numbered in, along with their node types. The number of
+ * triangles that voxel layer p creates is counted at the same time.
+ */
+class QuickSurfaceMeshScanImpl
+{
+  public:
+    QuickSurfaceMeshScanImpl(int32_t* grainIds, size_t dims[3],
+                             std::vector<std::vector<int32_t> >* planeNodes,
+                             std::vector<std::vector<int8_t> >* planeNodeTypes,
+                             std::vector<size_t>* layerTriangles) :
+      m_GrainIds(grainIds),
+      m_PlaneNodes(planeNodes),
+      m_PlaneNodeTypes(planeNodeTypes),
+      m_LayerTriangles(layerTriangles)
+    {
+      m_Dims[0] = dims[0];
+      m_Dims[1] = dims[1];
+      m_Dims[2] = dims[2];
+    }
+    virtual ~QuickSurfaceMeshScanImpl(){}
+
+    void scan(size_t start, size_t end) const
+    {
+      size_t planeSize = (m_Dims[0]+1)*(m_Dims[1]+1);
+      std::vector<Detail::QSMNodeOwners> owners(planeSize);
+      for (size_t p = start; p < end; ++p)
+      {
+        if (p > 0)
+        {
+          collectOwners(p-1, 1, owners);
+        }
+        if (p < m_Dims[2])
+        {
+          (*m_LayerTriangles)[p] = collectOwners(p, 0, owners);
+        }
+
+        std::vector<int32_t>& nodes = (*m_PlaneNodes)[p];
+        std::vector<int8_t>& nodeTypes = (*m_PlaneNodeTypes)[p];
+        for (size_t idx = 0; idx < planeSize; ++idx)
+        {
+          Detail::QSMNodeOwners& node = owners[idx];
+          if (node.count == 0 && node.boundary == false) { continue; }
+          // The boundary counts as one more owner and marks the node as a surface node
+          int8_t type = node.count + (node.boundary ? 1 : 0);
+          if (type > 4) { type = 4; }
+          if (node.boundary == true) { type = type + 10; }
+          nodes.push_back(static_cast<int32_t>(idx));
+          nodeTypes.push_back(type);
+          node.count = 0;
+          node.boundary = false;
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      scan(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int32_t* m_GrainIds;
+    size_t m_Dims[3];
+    std::vector<std::vector<int32_t> >* m_PlaneNodes;
+    std::vector<std::vector<int8_t> >* m_PlaneNodeTypes;
+    std::vector<size_t>* m_LayerTriangles;
+
+    /**
+     * @brief Adds the owners of the nodes that the faces of voxel layer 'k' place on its lower
+     * (plane == 0) or upper (plane == 1) node plane and returns the number of triangles of the layer.
+     */
+    size_t collectOwners(size_t k, int plane, std::vector<Detail::QSMNodeOwners> &owners) const
+    {
+      size_t xP = m_Dims[0];
+      size_t yP = m_Dims[1];
+      size_t triangles = 0;
+      Detail::QSMFace faces[6];
+      for(size_t j = 0; j < yP; j++)
+      {
+        for(size_t i = 0; i < xP; i++)
+        {
+          int numFaces = Detail::voxelFaces(m_GrainIds, m_Dims, i, j, k, faces);
+          if (numFaces == 0) { continue; }
+          triangles += 2 * numFaces;
+          int32_t label = m_GrainIds[(k*xP*yP)+(j*xP)+i];
+          for (int f = 0; f < numFaces; ++f)
+          {
+            for (int c = 0; c < 4; ++c)
+            {
+              const int* offset = Detail::QSMFaceNodes[faces[f].kind][c];
+              if (offset[2] != plane) { continue; }
+              Detail::QSMNodeOwners& node = owners[((j+offset[1])*(xP+1)) + i + offset[0]];
+              Detail::addOwner(node, label);
+              if (faces[f].neighbor < 0) { node.boundary = true; }
+              else { Detail::addOwner(node, m_GrainIds[faces[f].neighbor]); }
+            }
+          }
+        }
+      }
+      return triangles;
+    }
+};
+
+/**
+ * @brief The QuickSurfaceMeshEmitImpl class writes the triangles of a range of voxel layers and the
+ * vertices of the node planes below them. Only the node ids of the two planes that bound the current
+ * layer are expanded into full planes; the global node id of a node is the offset of its plane plus
+ * its position in the plane's list of used nodes.
+ */
+class QuickSurfaceMeshEmitImpl
+{
+  public:
+    QuickSurfaceMeshEmitImpl(int32_t* grainIds, int32_t* cellPhases, size_t dims[3], float res[3], float origin[3],
+                             std::vector<std::vector<int32_t> >* planeNodes,
+                             std::vector<std::vector<int8_t> >* planeNodeTypes,
+                             std::vector<size_t>* planeOffsets,
+                             std::vector<size_t>* layerOffsets,
+                             DREAM3D::SurfaceMesh::Vert_t* vertex, int8_t* nodeTypes,
+                             DREAM3D::SurfaceMesh::Face_t* triangle, int32_t* faceLabels, int32_t* phaseLabels) :
+      m_GrainIds(grainIds),
+      m_CellPhases(cellPhases),
+      m_PlaneNodes(planeNodes),
+      m_PlaneNodeTypes(planeNodeTypes),
+      m_PlaneOffsets(planeOffsets),
+      m_LayerOffsets(layerOffsets),
+      m_Vertex(vertex),
+      m_NodeTypes(nodeTypes),
+      m_Triangle(triangle),
+      m_FaceLabels(faceLabels),
+      m_PhaseLabels(phaseLabels)
+    {
+      for (int d = 0; d < 3; ++d)
+      {
+        m_Dims[d] = dims[d];
+        m_Res[d] = res[d];
+        m_Origin[d] = origin[d];
+      }
+    }
+    virtual ~QuickSurfaceMeshEmitImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      size_t xP = m_Dims[0];
+      size_t planeSize = (m_Dims[0]+1)*(m_Dims[1]+1);
+      std::vector<int32_t> lower(planeSize, -1);
+      std::vector<int32_t> upper(planeSize, -1);
+      expandPlane(start, lower, true);
+
+      Detail::QSMFace faces[6];
+      for (size_t k = start; k < end; ++k)
+      {
+        expandPlane(k+1, upper, true);
+        writeVertices(k);
+        if (k+1 == m_Dims[2])
+        {
+          writeVertices(k+1);
+        }
+
+        std::vector<int32_t>* planes[2] = { &lower, &upper };
+        size_t t = (*m_LayerOffsets)[k];
+        for(size_t j = 0; j < m_Dims[1]; j++)
+        {
+          for(size_t i = 0; i < xP; i++)
+          {
+            int numFaces = Detail::voxelFaces(m_GrainIds, m_Dims, i, j, k, faces);
+            size_t point = (k*xP*m_Dims[1])+(j*xP)+i;
+            for (int f = 0; f < numFaces; ++f)
+            {
+              int kind = faces[f].kind;
+              int32_t ids[4];
+              for (int c = 0; c < 4; ++c)
+              {
+                const int* offset = Detail::QSMFaceNodes[kind][c];
+                ids[c] = (*planes[offset[2]])[((j+offset[1])*(xP+1)) + i + offset[0]];
+              }
+              for (int tri = 0; tri < 2; ++tri)
+              {
+                m_Triangle[t].verts[0] = ids[Detail::QSMFaceTriangles[kind][tri][0]];
+                m_Triangle[t].verts[1] = ids[Detail::QSMFaceTriangles[kind][tri][1]];
+                m_Triangle[t].verts[2] = ids[Detail::QSMFaceTriangles[kind][tri][2]];
+                if (faces[f].neighbor < 0)
+                {
+                  m_FaceLabels[t*2] = m_GrainIds[point];
+                  m_FaceLabels[t*2+1] = -1;
+                  if(NULL != m_PhaseLabels) { m_PhaseLabels[t*2] = m_CellPhases[point]; m_PhaseLabels[t*2+1] = 0; }
+                }
+                else
+                {
+                  m_FaceLabels[t*2] = m_GrainIds[faces[f].neighbor];
+                  m_FaceLabels[t*2+1] = m_GrainIds[point];
+                  if(NULL != m_PhaseLabels) { m_PhaseLabels[t*2] = m_CellPhases[faces[f].neighbor]; m_PhaseLabels[t*2+1] = m_CellPhases[point]; }
+                }
+                t++;
+              }
+            }
+          }
+        }
+
+        expandPlane(k, lower, false);
+        lower.swap(upper);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    int32_t* m_GrainIds;
+    int32_t* m_CellPhases;
+    size_t m_Dims[3];
+    float m_Res[3];
+    float m_Origin[3];
+    std::vector<std::vector<int32_t> >* m_PlaneNodes;
+    std::vector<std::vector<int8_t> >* m_PlaneNodeTypes;
+    std::vector<size_t>* m_PlaneOffsets;
+    std::vector<size_t>* m_LayerOffsets;
+    DREAM3D::SurfaceMesh::Vert_t* m_Vertex;
+    int8_t* m_NodeTypes;
+    DREAM3D::SurfaceMesh::Face_t* m_Triangle;
+    int32_t* m_FaceLabels;
+    int32_t* m_PhaseLabels;
+
+    /**
+     * @brief Writes the global node ids of plane 'p' into the full plane 'ids', or resets the
+     * entries back to -1 if 'set' is false. Only the used nodes are touched.
+     */
+    void expandPlane(size_t p, std::vector<int32_t> &ids, bool set) const
+    {
+      const std::vector<int32_t>& nodes = (*m_PlaneNodes)[p];
+      int32_t offset = static_cast<int32_t>((*m_PlaneOffsets)[p]);
+      for (size_t n = 0; n < nodes.size(); ++n)
+      {
+        ids[nodes[n]] = set ? offset + static_cast<int32_t>(n) : -1;
+      }
+    }
+
+    void writeVertices(size_t p) const
+    {
+      const std::vector<int32_t>& nodes = (*m_PlaneNodes)[p];
+      const std::vector<int8_t>& nodeTypes = (*m_PlaneNodeTypes)[p];
+      size_t offset = (*m_PlaneOffsets)[p];
+      size_t rowSize = m_Dims[0] + 1;
+      for (size_t n = 0; n < nodes.size(); ++n)
+      {
+        size_t i = nodes[n] % rowSize;
+        size_t j = nodes[n] / rowSize;
+        DREAM3D::SurfaceMesh::Vert_t& v = m_Vertex[offset + n];
+        QSM_GETCOORD(i, m_Res[0], v.pos[0], m_Origin[0]);
+        QSM_GETCOORD(j, m_Res[1], v.pos[1], m_Origin[1]);
+        QSM_GETCOORD(p, m_Res[2], v.pos[2], m_Origin[2]);
+        m_NodeTypes[offset + n] = nodeTypes[n];
+      }
+    }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -192,315 +562,50 @@ void QuickSurfaceMesh::execute()
     return;
   }
 
-  size_t udims[3] = {0,0,0};
-  m->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] = {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
-  };
+  size_t dims[3] = {0,0,0};
+  m->getDimensions(dims);
+  float res[3] = { m->getXRes(), m->getYRes(), m->getZRes() };
+  float origin[3] = { m_OriginX, m_OriginY, m_OriginZ };
 
-  size_t xP = dims[0];
-  size_t yP = dims[1];
   size_t zP = dims[2];
-  float xRes = m->getXRes();
-  float yRes = m->getYRes();
-  float zRes = m->getZRes();
-
-  std::vector<int> m_NodeIds;
-  std::vector<std::set<int> > ownerLists;
 
-  size_t possibleNumNodes = (xP+1)*(yP+1)*(zP+1);
-  m_NodeIds.resize(possibleNumNodes, -1);
-
-  int nodeCount = 0;
-  int triangleCount = 0;
-
-  size_t point, neigh1, neigh2, neigh3;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  size_t nodeId1, nodeId2, nodeId3, nodeId4;
+  // The nodes are numbered plane by plane so instead of a node id for every possible node of the
+  // volume only the used nodes of each plane are kept and two planes of node ids are expanded at a time.
+  std::vector<std::vector<int32_t> > planeNodes(zP+1);
+  std::vector<std::vector<int8_t> > planeNodeTypes(zP+1);
+  std::vector<size_t> layerTriangles(zP, 0);
 
-  //first determining which nodes are actually boundary nodes and
-  //count number of nodes and triangles that will be created
-  for(size_t k = 0; k < zP; k++)
+  QuickSurfaceMeshScanImpl scanner(m_GrainIds, dims, &planeNodes, &planeNodeTypes, &layerTriangles);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    for(size_t j = 0; j < yP; j++)
-    {
-      for(size_t i = 0; i < xP; i++)
-      {
-        point = (k*xP*yP)+(j*xP)+i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP*yP);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, zP+1), scanner, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    scanner.scan(0, zP+1);
+  }
 
-        if(i == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP-1))
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_GrainIds[point] != m_GrainIds[neigh1])
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP-1))
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_GrainIds[point] != m_GrainIds[neigh2])
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP-1))
-        {
-          nodeId1 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP-1 && m_GrainIds[point] != m_GrainIds[neigh3])
-        {
-          nodeId1 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-      }
-    }
+  // Stitch the planes and layers together with a prefix sum over their counts
+  std::vector<size_t> planeOffsets(zP+1, 0);
+  size_t nodeCount = 0;
+  for (size_t p = 0; p <= zP; ++p)
+  {
+    planeOffsets[p] = nodeCount;
+    nodeCount += planeNodes[p].size();
+  }
+  size_t triangleCount = 0;
+  for (size_t k = 0; k < zP; ++k)
+  {
+    size_t count = layerTriangles[k];
+    layerTriangles[k] = triangleCount;
+    triangleCount += count;
   }
 
   //now create node and triangle arrays knowing the number that will be needed
@@ -521,455 +626,18 @@ void QuickSurfaceMesh::execute()
     phaseLabel = phaseLabelPtr->GetPointer(0);
   }
 
-
-  ownerLists.resize(nodeCount);
-
   //Cycle through again assigning coordinates to each node and assigning node numbers and grain labels to each triangle
-  triangleCount = 0;
-  //const DREAM3D::SurfaceMesh::Float_t k_Two = static_cast<DREAM3D::SurfaceMesh::Float_t>(2.0);
-  for(size_t k = 0; k < zP; k++)
+  QuickSurfaceMeshEmitImpl emitter(m_GrainIds, m_CellPhases, dims, res, origin, &planeNodes, &planeNodeTypes, &planeOffsets, &layerTriangles,
+                                   vertex, nodeTypes, triangle, faceLabels, phaseLabel);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if (doParallel == true)
   {
-    for(size_t j = 0; j < yP; j++)
-    {
-      for(size_t i = 0; i < xP; i++)
-      {
-        point = (k*xP*yP)+(j*xP)+i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP*yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId2];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId4];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP-1))
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId1];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId2];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_GrainIds[point] != m_GrainIds[neigh1])
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh1];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh1];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh1];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh1];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[neigh1]);
-        }
-        if(j == (yP-1))
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId1];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId2];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_GrainIds[point] != m_GrainIds[neigh2])
-        {
-          nodeId1 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = (k*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD(k, zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh2];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh2];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId3];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh2];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh2];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[neigh2]);
-        }
-        if(k == (zP-1))
-        {
-          nodeId1 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId1];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId4];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId2];
-          faceLabels[triangleCount*2] = m_GrainIds[point];
-          faceLabels[triangleCount*2+1] = -1;
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[point];phaseLabel[triangleCount*2+1] = 0;}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_GrainIds[point] != m_GrainIds[neigh3])
-        {
-          nodeId1 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId1]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId1]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId1]].pos[2], m_OriginZ);
-
-          nodeId2 = ((k+1)*(xP+1)*(yP+1)) + (j*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId2]].pos[0], m_OriginX);
-          QSM_GETCOORD(j, yRes, vertex[m_NodeIds[nodeId2]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId2]].pos[2], m_OriginZ);
-
-          nodeId3 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + (i+1);
-          QSM_GETCOORD((i+1), xRes, vertex[m_NodeIds[nodeId3]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId3]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId3]].pos[2], m_OriginZ);
-
-          nodeId4 = ((k+1)*(xP+1)*(yP+1)) + ((j+1)*(xP+1)) + i;
-          QSM_GETCOORD(i, xRes, vertex[m_NodeIds[nodeId4]].pos[0], m_OriginX);
-          QSM_GETCOORD((j+1), yRes, vertex[m_NodeIds[nodeId4]].pos[1], m_OriginY);
-          QSM_GETCOORD((k+1), zRes, vertex[m_NodeIds[nodeId4]].pos[2], m_OriginZ);
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId1];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId2];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh3];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh3];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          triangle[triangleCount].verts[0] = m_NodeIds[nodeId2];
-          triangle[triangleCount].verts[1] = m_NodeIds[nodeId3];
-          triangle[triangleCount].verts[2] = m_NodeIds[nodeId4];
-          faceLabels[triangleCount*2] = m_GrainIds[neigh3];
-          faceLabels[triangleCount*2+1] = m_GrainIds[point];
-          if(m_TransferPhaseId == true) { phaseLabel[triangleCount*2] = m_CellPhases[neigh3];phaseLabel[triangleCount*2+1] = m_CellPhases[point];}
-          triangleCount++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_GrainIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_GrainIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_GrainIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_GrainIds[neigh3]);
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, zP), emitter, tbb::auto_partitioner());
   }
-
-  for (int i = 0; i < nodeCount; i++)
+  else
+#endif
   {
-    nodeTypes[i] = ownerLists[i].size();
-    if(nodeTypes[i] > 4) nodeTypes[i] = 4;
-    if(ownerLists[i].find(-1) != ownerLists[i].end()) nodeTypes[i] = nodeTypes[i]+10;
+    emitter.generate(0, zP);
   }
 
   sm->setFaces(triangles);
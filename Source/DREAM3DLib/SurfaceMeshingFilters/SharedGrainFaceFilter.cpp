@@ -37,6 +37,8 @@
 
 #include "SharedGrainFaceFilter.h"
 
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshKeyGroups.hpp"
+
 
 
 
@@ -163,83 +165,48 @@ void SharedGrainFaceFilter::execute()
 
   IDataArray::Pointer flPtr = getSurfaceMeshDataContainer()->getFaceData(DREAM3D::FaceData::SurfaceMeshFaceLabels);
   DataArray<int32_t>* faceLabelsPtr = DataArray<int32_t>::SafePointerDownCast(flPtr.get());
-  int32_t* faceLabels = faceLabelsPtr->GetPointer(0);
 
   Int32ArrayType::Pointer grainFaceId = Int32ArrayType::CreateArray(trianglesPtr->GetNumberOfTuples(), DREAM3D::FaceData::SurfaceMeshGrainFaceId);
   grainFaceId->initializeWithZeros();
 
 
-  std::map<uint64_t, int> faceSizeMap;
-  std::map<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  uint32_t index = 0;
-  struct { int g; int r; } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for(size_t t = 0; t < totalPoints; ++t)
+  // Group the triangles by the pair of grains they separate
+  MeshKeyGroups::Pointer labelGroups = MeshKeyGroups::New();
+  labelGroups->generateFaceLabelPairs(faceLabelsPtr);
+  size_t numGroups = labelGroups->getNumberOfGroups();
+
+  // The Grain Face Ids are handed out in the order the faces are first seen in
+  // the triangle list
+  std::vector<int32_t> groupOfTriangle(totalPoints, 0);
+  for(size_t g = 0; g < numGroups; ++g)
   {
-    fl0 = faceLabels[t*2];
-    fl1 = faceLabels[t*2+1];
-    if (fl0 < fl1)
+    int32_t* triangleIds = labelGroups->getGroupValues(g);
+    size_t count = labelGroups->getGroupSize(g);
+    for(size_t i = 0; i < count; ++i)
     {
-      faceId.g = fl0;
-      faceId.r = fl1;
+      groupOfTriangle[triangleIds[i]] = static_cast<int32_t>(g);
     }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    std::map<uint64_t, int>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter==faceSizeMap.end())
+  }
+  std::vector<int32_t> faceIdOfGroup(numGroups, -1);
+  int32_t* grainFaceIds = grainFaceId->GetPointer(0);
+  int32_t index = 0;
+  for(size_t t = 0; t < totalPoints; ++t)
+  {
+    int32_t& faceId = faceIdOfGroup[groupOfTriangle[t]];
+    if (faceId < 0)
     {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      grainFaceId->SetValue(t, index);
+      faceId = index;
       ++index;
     }
-    else
-    {
-      faceSizeMap[*faceId_64]++;
-      grainFaceId->SetValue(t, faceIdMap[*faceId_64]);
-    }
+    grainFaceIds[t] = faceId;
   }
-
+  std::vector<int32_t>().swap(groupOfTriangle);
 
   SharedGrainFaces_t faces;
-
-  // Allocate all the vectors that we need
-  for(std::map<uint64_t, int>::iterator iter = faceSizeMap.begin(); iter != faceSizeMap.end(); ++iter)
+  for(size_t g = 0; g < numGroups; ++g)
   {
-    FaceIds_t v;
-    v.reserve((*iter).second);
-    index = faceIdMap[(*iter).first];
-    faces[index] = v;
-  }
-
-
-  // Loop through all the Triangles and assign each one to a unique Grain Face Id.
-  for(size_t t = 0; t < totalPoints; ++t)
-  {
-  #if 0
-    Triangle& tri = triangles[t];
-    if (tri.nSpin[0] < tri.nSpin[1])
-    {
-      faceId.g = tri.nSpin[0];
-      faceId.r = tri.nSpin[1];
-    }
-    else
-    {
-      faceId.g = tri.nSpin[1];
-      faceId.r = tri.nSpin[0];
-    }
-    index = faceIdMap[*faceId_64];
-    #else
-    index = grainFaceId->GetValue(t);
-    #endif
-    faces[index].push_back(t);
+    int32_t* triangleIds = labelGroups->getGroupValues(g);
+    faces[faceIdOfGroup[g]].assign(triangleIds, triangleIds + labelGroups->getGroupSize(g));
   }
 
   m_SharedGrainFaces = faces;
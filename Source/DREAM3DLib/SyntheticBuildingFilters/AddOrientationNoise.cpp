@@ -38,16 +38,80 @@
 
 #include <map>
 
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "MXA/Common/LogTime.h"
 
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/Math/DREAM3DMath.h"
-#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+#include "DREAM3DLib/Utilities/PhiloxRandom.h"
 #include "DREAM3DLib/DataContainers/DataContainerMacros.h"
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
 #include "DREAM3DLib/Math/MatrixMath.h"
 
 const static float m_pi = static_cast<float>(M_PI);
 
+/* Each voxel draws 4 genrand_res53 values, i.e. 8 values of the stream */
+#define NOISE_DRAWS_PER_VOXEL 8
+
+class AddOrientationNoiseImpl
+{
+  public:
+    AddOrientationNoiseImpl(float* eulers, float magnitude, const PhiloxRandom &random) :
+      m_CellEulerAngles(eulers),
+      m_Magnitude(magnitude),
+      m_Random(random)
+    {}
+    virtual ~AddOrientationNoiseImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      // The voxel index picks the position in the stream so the noise does not
+      // depend on how the voxels are split between threads
+      PhiloxRandom rg(m_Random);
+      rg.seek(static_cast<uint64_t>(start) * NOISE_DRAWS_PER_VOXEL);
+      float g[3][3];
+      float newg[3][3];
+      float rot[3][3];
+      float w, n1, n2, n3;
+      for (size_t i = start; i < end; ++i)
+      {
+        float ea1 = m_CellEulerAngles[3*i+0];
+        float ea2 = m_CellEulerAngles[3*i+1];
+        float ea3 = m_CellEulerAngles[3*i+2];
+        OrientationMath::EulerToMat(ea1, ea2, ea3, g);
+        n1 = static_cast<float>( rg.genrand_res53() );
+        n2 = static_cast<float>( rg.genrand_res53() );
+        n3 = static_cast<float>( rg.genrand_res53() );
+        w = static_cast<float>( rg.genrand_res53() );
+        w = 2.0*(w-0.5);
+        w = (m_Magnitude*w);
+        OrientationMath::AxisAngletoMat(w, n1, n2, n3, rot);
+        MatrixMath::Multiply3x3with3x3(g, rot, newg);
+        OrientationMath::MatToEuler(newg, ea1, ea2, ea3);
+        m_CellEulerAngles[3*i+0] = ea1;
+        m_CellEulerAngles[3*i+1] = ea2;
+        m_CellEulerAngles[3*i+2] = ea3;
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    float* m_CellEulerAngles;
+    float m_Magnitude;
+    PhiloxRandom m_Random;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -134,7 +198,6 @@ void AddOrientationNoise::execute()
 {
   int err = 0;
   setErrorCondition(err);
-  DREAM3D_RANDOMNG_NEW()
   VoxelDataContainer* m = getVoxelDataContainer();
 
   if(NULL == m)
@@ -167,34 +230,24 @@ void AddOrientationNoise::execute()
 void  AddOrientationNoise::add_orientation_noise()
 {
  notifyStatusMessage("Adding Orientation Noise");
-  DREAM3D_RANDOMNG_NEW()
+  PhiloxRandom rg(MXA::getMilliSeconds());
 
   VoxelDataContainer* m = getVoxelDataContainer();
-
-  //float ea1, ea2, ea3;
-  float g[3][3];
-  float newg[3][3];
-  float rot[3][3];
-  float w, n1, n2, n3;
   int64_t totalPoints = m->getTotalPoints();
-  for (size_t i = 0; i < static_cast<size_t>(totalPoints); ++i)
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
+                      AddOrientationNoiseImpl(m_CellEulerAngles, m_Magnitude, rg), tbb::auto_partitioner());
+  }
+  else
+#endif
   {
-    float ea1 = m_CellEulerAngles[3*i+0];
-    float ea2 = m_CellEulerAngles[3*i+1];
-    float ea3 = m_CellEulerAngles[3*i+2];
-    OrientationMath::EulerToMat(ea1, ea2, ea3, g);
-    n1 = static_cast<float>( rg.genrand_res53() );
-    n2 = static_cast<float>( rg.genrand_res53() );
-    n3 = static_cast<float>( rg.genrand_res53() );
-    w = static_cast<float>( rg.genrand_res53() );
-    w = 2.0*(w-0.5);
-    w = (m_Magnitude*w);
-    OrientationMath::AxisAngletoMat(w, n1, n2, n3, rot);
-    MatrixMath::Multiply3x3with3x3(g, rot, newg);
-    OrientationMath::MatToEuler(newg, ea1, ea2, ea3);
-    m_CellEulerAngles[3*i+0] = ea1;
-    m_CellEulerAngles[3*i+1] = ea2;
-    m_CellEulerAngles[3*i+2] = ea3;
+    AddOrientationNoiseImpl serial(m_CellEulerAngles, m_Magnitude, rg);
+    serial.generate(0, totalPoints);
   }
 }
 
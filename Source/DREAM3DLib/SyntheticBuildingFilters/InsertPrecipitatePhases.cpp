@@ -785,7 +785,7 @@ void InsertPrecipitatePhases::generate_precipitate(int phase, int Seed, Precip*
     totaldensity = totaldensity + axisodf->GetValue(bin);
     bin++;
   }
-  OrthoOps->determineEulerAngles(bin, phi1, PHI, phi2);
+  OrthoOps->determineEulerAngles(rg, bin, phi1, PHI, phi2);
   VectorOfFloatArray omega3 = pp->getGrainSize_Omegas();
   float mf = omega3[0]->GetValue(diameter);
   float s = omega3[1]->GetValue(diameter);
@@ -1005,7 +1005,7 @@ float InsertPrecipitatePhases::check_neighborhooderror(int gadd, int gremove)
   neighborerror = bhattdist;
   return neighborerror;
 }
-void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float &bhattdist)
+void InsertPrecipitatePhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -1013,7 +1013,7 @@ void InsertPrecipitatePhases::compare_1Ddistributions(std::vector<float> array1,
     bhattdist = bhattdist + sqrt((array1[i]*array2[i]));
   }
 }
-void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<float> > array1, std::vector<std::vector<float> > array2, float &bhattdist)
+void InsertPrecipitatePhases::compare_2Ddistributions(const std::vector<std::vector<float> >& array1, const std::vector<std::vector<float> >& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -1025,7 +1025,7 @@ void InsertPrecipitatePhases::compare_2Ddistributions(std::vector<std::vector<fl
   }
 }
 
-void InsertPrecipitatePhases::compare_3Ddistributions(std::vector<std::vector<std::vector<float> > > array1, std::vector<std::vector<std::vector<float> > > array2, float &bhattdist)
+void InsertPrecipitatePhases::compare_3Ddistributions(const std::vector<std::vector<std::vector<float> > >& array1, const std::vector<std::vector<std::vector<float> > >& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -156,10 +156,10 @@ class DREAM3DLib_EXPORT InsertPrecipitatePhases : public AbstractFilter
     float find_ycoord(long long int index);
     float find_zcoord(long long int index);
 
-    void compare_1Ddistributions(std::vector<float>, std::vector<float>, float &sqrerror);
-    void compare_2Ddistributions(std::vector<std::vector<float> >, std::vector<std::vector<float> >, float &sqrerror);
+    void compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float &sqrerror);
+    void compare_2Ddistributions(const std::vector<std::vector<float> >& array1, const std::vector<std::vector<float> >& array2, float &sqrerror);
 
-    void compare_3Ddistributions(std::vector<std::vector<std::vector<float> > >, std::vector<std::vector<std::vector<float> > >, float &sqrerror);
+    void compare_3Ddistributions(const std::vector<std::vector<std::vector<float> > >& array1, const std::vector<std::vector<std::vector<float> > >& array2, float &sqrerror);
 
     std::vector<int> precipitatephases;
     std::vector<float> precipitatephasefractions;
@@ -36,6 +36,17 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "MXA/Common/LogTime.h"
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/DataContainers/DataContainerMacros.h"
@@ -54,6 +65,112 @@
 #include "DREAM3DLib/StatsData/PrecipitateStatsData.h"
 #include "DREAM3DLib/StatsData/PrimaryStatsData.h"
 
+/**
+ * @brief Finds the MDF bins of the boundaries of the grain(s) of a trial with their new
+ * orientations. All the misorientations of a trial are found with one getMisoQuatBatch()
+ * call. The boundary between the two grains of a switch keeps its bin and is stored as -1.
+ */
+static void find_trial_bins(const CrystallographyTrial& trial, const int* offsets, const int* neighbors, const QuatF* quats,
+                            OrientationOps* ops, int* bins, std::vector<QuatF>& q1s, std::vector<QuatF>& q2s,
+                            std::vector<float>& angles, std::vector<float>& axes)
+{
+  int grains[2] = { trial.m_Grain1, trial.m_Grain2 };
+  int others[2] = { trial.m_Grain2, trial.m_Grain1 };
+  int numGrains = (trial.m_Grain2 < 0) ? 1 : 2;
+  size_t count = 0;
+  for (int g = 0; g < numGrains; ++g)
+  {
+    count += offsets[grains[g] + 1] - offsets[grains[g]];
+  }
+  q1s.resize(count);
+  q2s.resize(count);
+  angles.resize(count);
+  axes.resize(3 * count);
+
+  size_t pairs = 0;
+  for (int g = 0; g < numGrains; ++g)
+  {
+    QuatF newQuat;
+    if (g == 0 && trial.m_Grain2 < 0) { QuaternionMathF::Copy(trial.m_Quat, newQuat); }
+    else { QuaternionMathF::Copy(quats[others[g]], newQuat); }
+    for (int e = offsets[grains[g]]; e < offsets[grains[g] + 1]; ++e)
+    {
+      if (neighbors[e] == others[g]) { continue; }
+      QuaternionMathF::Copy(newQuat, q1s[pairs]);
+      QuaternionMathF::Copy(quats[neighbors[e]], q2s[pairs]);
+      pairs++;
+    }
+  }
+  if (pairs > 0)
+  {
+    ops->getMisoQuatBatch(&(q1s.front()), &(q2s.front()), pairs, &(angles.front()), &(axes.front()));
+  }
+
+  size_t pair = 0;
+  size_t slot = 0;
+  float r1, r2, r3;
+  for (int g = 0; g < numGrains; ++g)
+  {
+    for (int e = offsets[grains[g]]; e < offsets[grains[g] + 1]; ++e)
+    {
+      if (neighbors[e] == others[g])
+      {
+        bins[slot++] = -1;
+        continue;
+      }
+      OrientationMath::AxisAngletoRod(angles[pair], axes[3 * pair], axes[3 * pair + 1], axes[3 * pair + 2], r1, r2, r3);
+      bins[slot++] = ops->getMisoBin(r1, r2, r3);
+      pair++;
+    }
+  }
+}
+
+/**
+ * @brief Finds the MDF bins of a batch of trials. The trials only read the orientations
+ * so they can be scored concurrently.
+ */
+class MatchCrystallographyTrialsImpl
+{
+  public:
+    MatchCrystallographyTrialsImpl(const CrystallographyTrial* trials, const int* offsets, const int* neighbors,
+                                   const QuatF* quats, OrientationOps* ops, int* bins) :
+      m_Trials(trials),
+      m_Offsets(offsets),
+      m_Neighbors(neighbors),
+      m_Quats(quats),
+      m_Ops(ops),
+      m_Bins(bins)
+    {}
+    virtual ~MatchCrystallographyTrialsImpl(){}
+
+    void generate(size_t start, size_t end) const
+    {
+      std::vector<QuatF> q1s;
+      std::vector<QuatF> q2s;
+      std::vector<float> angles;
+      std::vector<float> axes;
+      for (size_t t = start; t < end; ++t)
+      {
+        if (m_Trials[t].m_Grain1 < 0) { continue; }
+        find_trial_bins(m_Trials[t], m_Offsets, m_Neighbors, m_Quats, m_Ops, m_Bins + m_Trials[t].m_BinOffset, q1s, q2s, angles, axes);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+  private:
+    const CrystallographyTrial* m_Trials;
+    const int* m_Offsets;
+    const int* m_Neighbors;
+    const QuatF* m_Quats;
+    OrientationOps* m_Ops;
+    int* m_Bins;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -74,6 +191,8 @@ MatchCrystallography::MatchCrystallography() :
   m_SharedSurfaceAreaListArrayName(DREAM3D::FieldData::SharedSurfaceAreaList),
   m_StatsDataArrayName(DREAM3D::EnsembleData::Statistics),
   m_MaxIterations(1),
+  m_TrialsPerBatch(64),
+  m_RandomSeed(0),
   m_GrainIds(NULL),
   m_CellEulerAngles(NULL),
   m_SurfaceFields(NULL),
@@ -112,6 +231,22 @@ void MatchCrystallography::setupFilterParameters()
     option->setUnits("");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Trials Per Batch");
+    option->setPropertyName("TrialsPerBatch");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Random Seed");
+    option->setPropertyName("RandomSeed");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    parameters.push_back(option);
+  }
   setFilterParameters(parameters);
 }
 // -----------------------------------------------------------------------------
@@ -122,6 +257,9 @@ void MatchCrystallography::readFilterParameters(AbstractFilterParametersReader*
   reader->openFilterGroup(this, index);
   /* Code to read the values goes between these statements */
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE BEGIN*/
+  setMaxIterations(reader->readValue("MaxIterations", getMaxIterations()));
+  setTrialsPerBatch(reader->readValue("TrialsPerBatch", getTrialsPerBatch()));
+  setRandomSeed(reader->readValue("RandomSeed", getRandomSeed()));
 /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -133,6 +271,8 @@ int MatchCrystallography::writeFilterParameters(AbstractFilterParametersWriter*
 {
   writer->openFilterGroup(this, index);
   writer->writeValue("MaxIterations", getMaxIterations() );
+  writer->writeValue("TrialsPerBatch", getTrialsPerBatch() );
+  writer->writeValue("RandomSeed", getRandomSeed() );
     writer->closeFilterGroup();
     return ++index; // we want to return the next index that was just written to
 }
@@ -238,6 +378,13 @@ void MatchCrystallography::execute()
   }
 
 
+  unsigned long long int Seed = MXA::getMilliSeconds();
+  if(m_RandomSeed != 0)
+  {
+    Seed = static_cast<unsigned int>(m_RandomSeed);
+  }
+  DREAM3D_RANDOMNG_NEW_SEEDED(Seed);
+
   std::stringstream ss;
   ss << "Determining Volumes";
   notifyStatusMessage(ss.str());
@@ -261,7 +408,7 @@ void MatchCrystallography::execute()
 
       ss << "Assigning Eulers to Phase " << i;
       notifyStatusMessage(ss.str());
-      assign_eulers(i);
+      assign_eulers(i, rg);
       ss.str("");
 
       ss << "Measuring Misorientations of Phase " << i;
@@ -271,7 +418,7 @@ void MatchCrystallography::execute()
 
       ss << "Matching Crystallography of Phase " << i;
       notifyStatusMessage(ss.str());
-      matchCrystallography(i);
+      matchCrystallography(i, rg);
       ss.str("");
     }
   }
@@ -322,6 +469,15 @@ void MatchCrystallography::initializeArrays(int ensem)
   {
     simmdf->SetValue(j, 0.0);
   }
+
+  // Running sums of the goal ODF so pick_euler can binary search them
+  m_OdfCumulative.resize(actualodf->GetSize());
+  float totaldensity = 0;
+  for (size_t j = 0; j < m_OdfCumulative.size(); j++)
+  {
+    totaldensity = totaldensity + actualodf->GetValue(j);
+    m_OdfCumulative[j] = totaldensity;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -396,10 +552,9 @@ void MatchCrystallography::determine_boundary_areas()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::assign_eulers(int ensem)
+void MatchCrystallography::assign_eulers(int ensem, DREAM3DRandom& rg)
 {
-  DREAM3D_RANDOMNG_NEW()
-      VoxelDataContainer* m = getVoxelDataContainer();
+  VoxelDataContainer* m = getVoxelDataContainer();
 
   int numbins = 0;
   float synea1 = 0, synea2 = 0, synea3 = 0;
@@ -423,7 +578,7 @@ void MatchCrystallography::assign_eulers(int ensem)
 
       choose = pick_euler(random, numbins);
 
-      m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(choose, synea1, synea2, synea3);
+      m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(rg, choose, synea1, synea2, synea3);
       m_FieldEulerAngles[3 * i] = synea1;
       m_FieldEulerAngles[3 * i + 1] = synea2;
       m_FieldEulerAngles[3 * i + 2] = synea3;
@@ -442,381 +597,122 @@ void MatchCrystallography::assign_eulers(int ensem)
 // -----------------------------------------------------------------------------
 int MatchCrystallography::pick_euler(float random, int numbins)
 {
-  int choose = 0;
-  float totaldensity = 0;
-
-  for (int j = 0; j < numbins; j++)
-  {
-    float density = actualodf->GetValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if (random < totaldensity && random >= td1) { choose = static_cast<int> (j); break; }
-  }
-  return choose;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int grain, int ensem, int j, float neighsurfarea, unsigned int sym, QuatF &q1, QuatF &q2)
-{
-  float w;
-  float n1, n2, n3;
-  float r1, r2, r3;
-  float curmiso1, curmiso2, curmiso3;
-  size_t curmisobin, newmisobin;
-
-  curmiso1 = misorientationlists[grain][3 * j];
-  curmiso2 = misorientationlists[grain][3 * j + 1];
-  curmiso3 = misorientationlists[grain][3 * j + 2];
-  curmisobin = m_OrientationOps[sym]->getMisoBin(curmiso1, curmiso2, curmiso3);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-  OrientationMath::AxisAngletoRod(w, n1, n2, n3, r1, r2, r3);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(n1, n2, n3);
-  mdfchange = mdfchange
-      + (((actualmdf->GetValue(curmisobin) - simmdf->GetValue(curmisobin)) * (actualmdf->GetValue(curmisobin) - simmdf->GetValue(curmisobin)))
-         - ((actualmdf->GetValue(curmisobin) - (simmdf->GetValue(curmisobin) - (neighsurfarea / totalSurfaceArea[ensem])))
-            * (actualmdf->GetValue(curmisobin) - (simmdf->GetValue(curmisobin) - (neighsurfarea / totalSurfaceArea[ensem])))));
-  mdfchange = mdfchange
-      + (((actualmdf->GetValue(newmisobin) - simmdf->GetValue(newmisobin)) * (actualmdf->GetValue(newmisobin) - simmdf->GetValue(newmisobin)))
-         - ((actualmdf->GetValue(newmisobin) - (simmdf->GetValue(newmisobin) + (neighsurfarea / totalSurfaceArea[ensem])))
-            * (actualmdf->GetValue(newmisobin) - (simmdf->GetValue(newmisobin) + (neighsurfarea / totalSurfaceArea[ensem])))));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int grain, int ensem, int j, float neighsurfarea, unsigned int sym, QuatF &q1, QuatF &q2)
-{
-  float w;
-  float n1, n2, n3;
-  float r1, r2, r3;
-  float curmiso1, curmiso2, curmiso3;
-  size_t curmisobin, newmisobin;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
-
-  curmiso1 = misorientationlists[grain][3 * j];
-  curmiso2 = misorientationlists[grain][3 * j + 1];
-  curmiso3 = misorientationlists[grain][3 * j + 2];
-  curmisobin = m_OrientationOps[sym]->getMisoBin(curmiso1, curmiso2, curmiso3);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-  OrientationMath::AxisAngletoRod(w, n1, n2, n3, r1, r2, r3);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(n1, n2, n3);
-  misorientationlists[grain][3 * j] = miso1;
-  misorientationlists[grain][3 * j + 1] = miso2;
-  misorientationlists[grain][3 * j + 2] = miso3;
-  simmdf->SetValue(curmisobin, (simmdf->GetValue(curmisobin) - (neighsurfarea / totalSurfaceArea[ensem])));
-  simmdf->SetValue(newmisobin, (simmdf->GetValue(newmisobin) + (neighsurfarea / totalSurfaceArea[ensem])));
+  // The first bin whose running sum is larger than the random number. Bins without any
+  // density are never picked and 0 is returned if the random number is past the total.
+  if (numbins > static_cast<int>(m_OdfCumulative.size())) { numbins = static_cast<int>(m_OdfCumulative.size()); }
+  std::vector<float>::iterator end = m_OdfCumulative.begin() + numbins;
+  std::vector<float>::iterator found = std::upper_bound(m_OdfCumulative.begin(), end, random);
+  if (found == end) { return 0; }
+  return static_cast<int>(found - m_OdfCumulative.begin());
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::matchCrystallography(int ensem)
+void MatchCrystallography::matchCrystallography(int ensem, DREAM3DRandom& rg)
 {
   VoxelDataContainer* m = getVoxelDataContainer();
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int>& neighborlist = *m_NeighborList;
-  NeighborList<float>& neighborsurfacearealist = *m_SharedSurfaceAreaList;
 
   int64_t totalPoints = m->getTotalPoints();
   size_t totalFields = m->getNumFieldTuples();
-
-  //  float xRes = m->getXRes();
-  //  float yRes = m->getYRes();
-  //  float zRes = m->getZRes();
-  //  float volResConst = xRes * yRes * zRes;
-  DREAM3D_RANDOMNG_NEW()
-      int numbins = 0;
-  int iterations = 0, badtrycount = 0;
-  float random = 0;
-  size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  OrientationOps* ops = m_OrientationOps[m_CrystalStructures[ensem]].get();
 
-
-  float ea1 = 0, ea2 = 0, ea3 = 0;
-  float r1 = 0, r2 = 0, r3 = 0;
-  float g1ea1 = 0, g1ea2 = 0, g1ea3 = 0, g2ea1 = 0, g2ea2 = 0, g2ea3 = 0;
-  int g1odfbin = 0, g2odfbin = 0;
-  //float totaldensity = 0;
-  float deltaerror = 0;
-  float currentodferror = 0, currentmdferror = 0;
-  size_t selectedgrain1 = 0, selectedgrain2 = 0;
-  //size_t numensembles = m->getNumEnsembleTuples();
-  size_t numfields = m->getNumFieldTuples();
-  iterations = 0;
-  badtrycount = 0;
+  int numbins = 0;
   if( Ebsd::CrystalStructure::Check::IsCubic(m_CrystalStructures[ensem])) { numbins = 18 * 18 * 18; }
   if( Ebsd::CrystalStructure::Check::IsHexagonal(m_CrystalStructures[ensem])) { numbins = 36 * 36 * 12; }
-  while (badtrycount < (m_MaxIterations/10) && iterations < m_MaxIterations)
+
+  // Only the grains inside the volume are given new orientations
+  m_Candidates.clear();
+  for (size_t i = 1; i < totalFields; i++)
   {
-    std::stringstream ss;
-    ss << "Matching Crystallography - Swapping/Switching Orientations - " << ((float)iterations/float(1000*totalFields))*100 << "% Complete";
-    //      notifyStatusMessage(ss.str());
-    currentodferror = 0;
-    currentmdferror = 0;
-    for (int i = 0; i < numbins; i++)
+    if(m_SurfaceFields[i] == false && m_FieldPhases[i] == static_cast<int32_t>(ensem))
     {
-      currentodferror = currentodferror + ((actualodf->GetValue(i) - simodf->GetValue(i)) * (actualodf->GetValue(i) - simodf->GetValue(i)));
+      m_Candidates.push_back(static_cast<int>(i));
     }
-    for (int i = 0; i < (numbins); i++)
+  }
+
+  // The errors are kept up to date as the bins change instead of being summed for every trial
+  double odferror = 0;
+  double mdferror = 0;
+  for (int i = 0; i < numbins; i++)
+  {
+    odferror = odferror + ((actualodf->GetValue(i) - simodf->GetValue(i)) * (actualodf->GetValue(i) - simodf->GetValue(i)));
+  }
+  for (size_t i = 0; i < simmdf->GetSize(); i++)
+  {
+    mdferror = mdferror + ((actualmdf->GetValue(i) - simmdf->GetValue(i)) * (actualmdf->GetValue(i) - simmdf->GetValue(i)));
+  }
+
+  // The trials draw from a generator of their own that takes a single number from the filter's
+  // generator. The matching can stop part way through a batch, and the trials drawn after that
+  // point must not shift the numbers the later phases draw
+  DREAM3DRandom trialRg;
+  trialRg.init_genrand(rg.genrand_int32());
+
+  m_ChangedStamps.assign(totalFields, -1);
+  int batchSize = (m_TrialsPerBatch > 1) ? m_TrialsPerBatch : 1;
+  int iterations = 0, badtrycount = 0;
+  int batch = 0;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+  while (m_Candidates.empty() == false && badtrycount < (m_MaxIterations/10) && iterations < m_MaxIterations)
+  {
+    // Draw the next batch of trials. Drawing only uses the random numbers, so the trials are the
+    // same as when they are drawn one at a time
+    int numTrials = std::min(batchSize, m_MaxIterations - iterations);
+    m_Trials.resize(numTrials);
+    size_t binCount = 0;
+    for (int t = 0; t < numTrials; ++t)
     {
-      currentmdferror = currentmdferror + ((actualmdf->GetValue(i) - simmdf->GetValue(i)) * (actualmdf->GetValue(i) - simmdf->GetValue(i)));
+      CrystallographyTrial& trial = m_Trials[t];
+      propose_trial(trialRg, ensem, numbins, trial);
+      trial.m_BinOffset = binCount;
+      if(trial.m_Grain1 < 0) { continue; }
+      binCount += m_BoundaryOffsets[trial.m_Grain1 + 1] - m_BoundaryOffsets[trial.m_Grain1];
+      if(trial.m_Grain2 >= 0) { binCount += m_BoundaryOffsets[trial.m_Grain2 + 1] - m_BoundaryOffsets[trial.m_Grain2]; }
     }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>( rg.genrand_res53() );
+    m_TrialBins.resize(binCount + 1);
 
-    if(random < 0.5) // SwapOutOrientation
+    // Find the misorientation bins of all the trials against the current orientations
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true && numTrials > 1)
     {
-      counter = 0;
-      selectedgrain1 = int(rg.genrand_res53() * numfields);
-      while ((m_SurfaceFields[selectedgrain1] == true || m_FieldPhases[selectedgrain1] != static_cast<int32_t>(ensem)) && counter < numfields)
-      {
-        if(selectedgrain1 >= numfields) selectedgrain1 = selectedgrain1 - numfields;
-        selectedgrain1++;
-        counter++;
-      }
-      if(counter == numfields)
-      {
-        badtrycount = 10*m_NumFields[ensem];
-      }
-      else
-      {
-        ea1 = m_FieldEulerAngles[3 * selectedgrain1];
-        ea2 = m_FieldEulerAngles[3 * selectedgrain1 + 1];
-        ea3 = m_FieldEulerAngles[3 * selectedgrain1 + 2];
-        OrientationMath::EulerToRod( ea1,  ea2,  ea3, r1,  r2,  r3);
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(r1, r2, r3);
-        random = static_cast<float>( rg.genrand_res53() );
-        int choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(choose, g1ea1, g1ea2, g1ea3);
-        OrientationMath::EulertoQuat(q1, g1ea1, g1ea2, g1ea3);
-
-        odfchange = ((actualodf->GetValue(choose) - simodf->GetValue(choose)) * (actualodf->GetValue(choose) - simodf->GetValue(choose)))
-            - ((actualodf->GetValue(choose) - (simodf->GetValue(choose) + (m_Volumes[selectedgrain1] / unbiasedvol[ensem])))
-               * (actualodf->GetValue(choose) - (simodf->GetValue(choose) + (m_Volumes[selectedgrain1] / unbiasedvol[ensem]))));
-        odfchange = odfchange
-            + (((actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)) * (actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)))
-               - ((actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])))
-                  * (actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])))));
-
-        mdfchange = 0;
-        size_t size = 0;
-        if(neighborlist[selectedgrain1].size() != 0) size = neighborlist[selectedgrain1].size();
-        for (size_t j = 0; j < size; j++)
-        {
-          int neighbor = neighborlist[selectedgrain1][j];
-          ea1 = m_FieldEulerAngles[3 * neighbor];
-          ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-          ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-          OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-          float neighsurfarea = neighborsurfacearealist[selectedgrain1][j];
-          MC_LoopBody1(selectedgrain1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
-
-        deltaerror = (odfchange / currentodferror) + (mdfchange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FieldEulerAngles[3 * selectedgrain1] = g1ea1;
-          m_FieldEulerAngles[3 * selectedgrain1 + 1] = g1ea2;
-          m_FieldEulerAngles[3 * selectedgrain1 + 2] = g1ea3;
-          QuaternionMathF::Copy(q1, avgQuats[selectedgrain1]);
-          //          m_AvgQuats[4 * selectedgrain1 + 1] = q1[1];
-          //          m_AvgQuats[4 * selectedgrain1 + 2] = q1[2];
-          //          m_AvgQuats[4 * selectedgrain1 + 3] = q1[3];
-          //          m_AvgQuats[4 * selectedgrain1 + 4] = q1[4];
-          simodf->SetValue(choose, (simodf->GetValue(choose) + (m_Volumes[selectedgrain1] / unbiasedvol[ensem])));
-          simodf->SetValue(g1odfbin, (simodf->GetValue(g1odfbin) - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])));
-          size_t size = 0;
-          if(neighborlist[selectedgrain1].size() != 0) size = neighborlist[selectedgrain1].size();
-          for (size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedgrain1][j];
-            ea1 = m_FieldEulerAngles[3 * neighbor];
-            ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-            ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-            OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-            float neighsurfarea = neighborsurfacearealist[selectedgrain1][j];
-            MC_LoopBody2(selectedgrain1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
-      }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numTrials),
+                        MatchCrystallographyTrialsImpl(&(m_Trials.front()), &(m_BoundaryOffsets.front()), &(m_BoundaryNeighbors.front()),
+                                                       avgQuats, ops, &(m_TrialBins.front())),
+                        tbb::auto_partitioner());
     }
-    else // SwitchOrientation
+    else
+#endif
     {
-      counter = 0;
-      selectedgrain1 = int(rg.genrand_res53() * numfields);
-      while ((m_SurfaceFields[selectedgrain1] == true || m_FieldPhases[selectedgrain1] != static_cast<int32_t>(ensem)) && counter < numfields)
-      {
-        if(selectedgrain1 >= numfields) selectedgrain1 = selectedgrain1 - numfields;
-        selectedgrain1++;
-        counter++;
-      }
-      if(counter == numfields)
-      {
-        badtrycount = 10*m_NumFields[ensem];
-      }
-      else
+      MatchCrystallographyTrialsImpl serial(&(m_Trials.front()), &(m_BoundaryOffsets.front()), &(m_BoundaryNeighbors.front()),
+                                            avgQuats, ops, &(m_TrialBins.front()));
+      serial.generate(0, numTrials);
+    }
+
+    // Accept or reject the trials in the order they were drawn
+    for (int t = 0; t < numTrials; ++t)
+    {
+      if(badtrycount >= (m_MaxIterations/10)) { break; }
+      iterations++;
+      badtrycount++;
+      if(m_Trials[t].m_Grain1 < 0) { continue; }
+      if(commit_trial(m_Trials[t], ensem, batch, odferror, mdferror) == true)
       {
-        counter = 0;
-        selectedgrain2 = int(rg.genrand_res53() * numfields);
-        while ((m_SurfaceFields[selectedgrain2] == true || m_FieldPhases[selectedgrain2] != static_cast<int32_t>(ensem) || selectedgrain2 == selectedgrain1) && counter < numfields)
-        {
-          if(selectedgrain2 >= numfields) selectedgrain2 = selectedgrain2 - numfields;
-          selectedgrain2++;
-          counter++;
-        }
-        if(counter == numfields)
-        {
-          badtrycount = 10*m_NumFields[ensem];
-        }
-        else
-        {
-          g1ea1 = m_FieldEulerAngles[3 * selectedgrain1];
-          g1ea2 = m_FieldEulerAngles[3 * selectedgrain1 + 1];
-          g1ea3 = m_FieldEulerAngles[3 * selectedgrain1 + 2];
-          g2ea1 = m_FieldEulerAngles[3 * selectedgrain2];
-          g2ea2 = m_FieldEulerAngles[3 * selectedgrain2 + 1];
-          g2ea3 = m_FieldEulerAngles[3 * selectedgrain2 + 2];
-          QuaternionMathF::Copy(q1, avgQuats[selectedgrain1]);
-          //          q1[1] = m_AvgQuats[4 * selectedgrain1 + 1];
-          //          q1[2] = m_AvgQuats[4 * selectedgrain1 + 2];
-          //          q1[3] = m_AvgQuats[4 * selectedgrain1 + 3];
-          //          q1[4] = m_AvgQuats[4 * selectedgrain1 + 4];
-          OrientationMath::EulerToRod( g1ea1,  g1ea2,  g1ea3, r1,  r2,  r3);
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(r1, r2, r3);
-          QuaternionMathF::Copy(q1, avgQuats[selectedgrain2]);
-          //          q1[1] = m_AvgQuats[4 * selectedgrain2 + 1];
-          //          q1[2] = m_AvgQuats[4 * selectedgrain2 + 2];
-          //          q1[3] = m_AvgQuats[4 * selectedgrain2 + 3];
-          //          q1[4] = m_AvgQuats[4 * selectedgrain2 + 4];
-          OrientationMath::EulerToRod( g2ea1,  g2ea2,  g2ea3, r1,  r2,  r3);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(r1, r2, r3);
-
-          odfchange = ((actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)) * (actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)))
-              - ((actualodf->GetValue(g1odfbin)
-                  - (simodf->GetValue(g1odfbin) - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])
-                     + (m_Volumes[selectedgrain2] / unbiasedvol[ensem])))
-                 * (actualodf->GetValue(g1odfbin)
-                    - (simodf->GetValue(g1odfbin) - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])
-                       + (m_Volumes[selectedgrain2] / unbiasedvol[ensem]))));
-          odfchange = odfchange
-              + (((actualodf->GetValue(g2odfbin) - simodf->GetValue(g2odfbin)) * (actualodf->GetValue(g2odfbin) - simodf->GetValue(g2odfbin)))
-                 - ((actualodf->GetValue(g2odfbin)
-                     - (simodf->GetValue(g2odfbin) - (m_Volumes[selectedgrain2] / unbiasedvol[ensem])
-                        + (m_Volumes[selectedgrain1] / unbiasedvol[ensem])))
-                    * (actualodf->GetValue(g2odfbin)
-                       - (simodf->GetValue(g2odfbin) - (m_Volumes[selectedgrain2] / unbiasedvol[ensem])
-                          + (m_Volumes[selectedgrain1] / unbiasedvol[ensem])))));
-
-          mdfchange = 0;
-          OrientationMath::EulertoQuat(q1, g2ea1, g2ea2, g2ea3);
-          size_t size = 0;
-          if(neighborlist[selectedgrain1].size() != 0) size = neighborlist[selectedgrain1].size();
-          for (size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedgrain1][j];
-            ea1 = m_FieldEulerAngles[3 * neighbor];
-            ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-            ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-            OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-            float neighsurfarea = neighborsurfacearealist[selectedgrain1][j];
-            if(neighbor != static_cast<int>(selectedgrain2) )
-            {
-              MC_LoopBody1(selectedgrain1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          OrientationMath::EulertoQuat(q1, g1ea1, g1ea2, g1ea3);
-          size = 0;
-          if(neighborlist[selectedgrain2].size() != 0) size = neighborlist[selectedgrain2].size();
-          for (size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedgrain2][j];
-            ea1 = m_FieldEulerAngles[3 * neighbor];
-            ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-            ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-            OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-            float neighsurfarea = neighborsurfacearealist[selectedgrain2][j];
-            if(neighbor != selectedgrain1)
-            {
-              MC_LoopBody1(selectedgrain2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          deltaerror = (odfchange / currentodferror) + (mdfchange / currentmdferror);
-          if(deltaerror > 0)
-          {
-            badtrycount = 0;
-            m_FieldEulerAngles[3 * selectedgrain1] = g2ea1;
-            m_FieldEulerAngles[3 * selectedgrain1 + 1] = g2ea2;
-            m_FieldEulerAngles[3 * selectedgrain1 + 2] = g2ea3;
-            m_FieldEulerAngles[3 * selectedgrain2] = g1ea1;
-            m_FieldEulerAngles[3 * selectedgrain2 + 1] = g1ea2;
-            m_FieldEulerAngles[3 * selectedgrain2 + 2] = g1ea3;
-            simodf->SetValue(g1odfbin, (simodf->GetValue(g1odfbin) + (m_Volumes[selectedgrain2] / unbiasedvol[ensem])
-                                        - (m_Volumes[selectedgrain1] / unbiasedvol[ensem])));
-            simodf->SetValue(g2odfbin, (simodf->GetValue(g2odfbin) + (m_Volumes[selectedgrain1] / unbiasedvol[ensem])
-                                        - (m_Volumes[selectedgrain2] / unbiasedvol[ensem])));
-
-            OrientationMath::EulertoQuat(q1, g2ea1, g2ea2, g2ea3);
-            QuaternionMathF::Copy(avgQuats[selectedgrain1], q1);
-            //            m_AvgQuats[4 * selectedgrain1 + 1] = q1[1];
-            //            m_AvgQuats[4 * selectedgrain1 + 2] = q1[2];
-            //            m_AvgQuats[4 * selectedgrain1 + 3] = q1[3];
-            //            m_AvgQuats[4 * selectedgrain1 + 4] = q1[4];
-            size = 0;
-            if(neighborlist[selectedgrain1].size() != 0) size = neighborlist[selectedgrain1].size();
-            for (size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedgrain1][j];
-              ea1 = m_FieldEulerAngles[3 * neighbor];
-              ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-              ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-              OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-              float neighsurfarea = neighborsurfacearealist[selectedgrain1][j];
-              if(neighbor != selectedgrain2)
-              {
-                MC_LoopBody2(selectedgrain1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            OrientationMath::EulertoQuat(q1, g1ea1, g1ea2, g1ea3);
-            QuaternionMathF::Copy(q1, avgQuats[selectedgrain2]);
-//            m_AvgQuats[4 * selectedgrain2 + 1] = q1[1];
-//            m_AvgQuats[4 * selectedgrain2 + 2] = q1[2];
-//            m_AvgQuats[4 * selectedgrain2 + 3] = q1[3];
-//            m_AvgQuats[4 * selectedgrain2 + 4] = q1[4];
-            size = 0;
-            if(neighborlist[selectedgrain2].size() != 0) size = neighborlist[selectedgrain2].size();
-            for (size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedgrain2][j];
-              ea1 = m_FieldEulerAngles[3 * neighbor];
-              ea2 = m_FieldEulerAngles[3 * neighbor + 1];
-              ea3 = m_FieldEulerAngles[3 * neighbor + 2];
-              OrientationMath::EulertoQuat(q2, ea1, ea2, ea3);
-              float neighsurfarea = neighborsurfacearealist[selectedgrain2][j];
-              if(neighbor != selectedgrain1)
-              {
-                MC_LoopBody2(selectedgrain2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-          }
-        }
+        badtrycount = 0;
       }
     }
+    batch++;
+
+    if (getCancel() == true)
+    {
+      return;
+    }
   }
+
   for (int i = 0; i < totalPoints; i++)
   {
     m_CellEulerAngles[3 * i] = m_FieldEulerAngles[3 * m_GrainIds[i]];
@@ -825,6 +721,182 @@ void MatchCrystallography::matchCrystallography(int ensem)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::propose_trial(DREAM3DRandom& rg, int ensem, int numbins, CrystallographyTrial& trial)
+{
+  size_t numCandidates = m_Candidates.size();
+  float random = static_cast<float>( rg.genrand_res53() );
+  trial.m_Grain1 = -1;
+  trial.m_Grain2 = -1;
+  trial.m_Choose = 0;
+  if(random < 0.5) // SwapOutOrientation
+  {
+    trial.m_Grain1 = m_Candidates[static_cast<size_t>(rg.genrand_res53() * numCandidates)];
+    random = static_cast<float>( rg.genrand_res53() );
+    trial.m_Choose = pick_euler(random, numbins);
+    m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(rg, trial.m_Choose, trial.m_Eulers[0], trial.m_Eulers[1], trial.m_Eulers[2]);
+    OrientationMath::EulertoQuat(trial.m_Quat, trial.m_Eulers[0], trial.m_Eulers[1], trial.m_Eulers[2]);
+  }
+  else if(numCandidates > 1) // SwitchOrientation
+  {
+    size_t first = static_cast<size_t>(rg.genrand_res53() * numCandidates);
+    size_t second = static_cast<size_t>(rg.genrand_res53() * (numCandidates - 1));
+    if(second >= first) { second++; }
+    trial.m_Grain1 = m_Candidates[first];
+    trial.m_Grain2 = m_Candidates[second];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MatchCrystallography::commit_trial(CrystallographyTrial& trial, int ensem, int stamp, double& odferror, double& mdferror)
+{
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  OrientationOps* ops = m_OrientationOps[m_CrystalStructures[ensem]].get();
+  int grains[2] = { trial.m_Grain1, trial.m_Grain2 };
+  int numGrains = (trial.m_Grain2 < 0) ? 1 : 2;
+  int* bins = &(m_TrialBins[trial.m_BinOffset]);
+
+  // The bins were found before the earlier trials of the batch were applied. If one of them
+  // changed a grain this trial depends on, find the bins again
+  bool stale = false;
+  for (int g = 0; g < numGrains && stale == false; ++g)
+  {
+    if(m_ChangedStamps[grains[g]] == stamp) { stale = true; }
+    for (int e = m_BoundaryOffsets[grains[g]]; e < m_BoundaryOffsets[grains[g] + 1] && stale == false; ++e)
+    {
+      if(m_ChangedStamps[m_BoundaryNeighbors[e]] == stamp) { stale = true; }
+    }
+  }
+  if(stale == true)
+  {
+    std::vector<QuatF> q1s;
+    std::vector<QuatF> q2s;
+    std::vector<float> angles;
+    std::vector<float> axes;
+    find_trial_bins(trial, &(m_BoundaryOffsets.front()), &(m_BoundaryNeighbors.front()), avgQuats, ops, bins, q1s, q2s, angles, axes);
+  }
+
+  float r1, r2, r3;
+  float odfchange = 0;
+  int g1odfbin = 0, g2odfbin = 0;
+  float g1vol = m_Volumes[trial.m_Grain1] / unbiasedvol[ensem];
+  OrientationMath::EulerToRod(m_FieldEulerAngles[3 * trial.m_Grain1], m_FieldEulerAngles[3 * trial.m_Grain1 + 1], m_FieldEulerAngles[3 * trial.m_Grain1 + 2], r1, r2, r3);
+  g1odfbin = ops->getOdfBin(r1, r2, r3);
+  if(numGrains == 1)
+  {
+    int choose = trial.m_Choose;
+    odfchange = ((actualodf->GetValue(choose) - simodf->GetValue(choose)) * (actualodf->GetValue(choose) - simodf->GetValue(choose)))
+        - ((actualodf->GetValue(choose) - (simodf->GetValue(choose) + g1vol))
+           * (actualodf->GetValue(choose) - (simodf->GetValue(choose) + g1vol)));
+    odfchange = odfchange
+        + (((actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)) * (actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)))
+           - ((actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - g1vol))
+              * (actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - g1vol))));
+  }
+  else
+  {
+    float g2vol = m_Volumes[trial.m_Grain2] / unbiasedvol[ensem];
+    OrientationMath::EulerToRod(m_FieldEulerAngles[3 * trial.m_Grain2], m_FieldEulerAngles[3 * trial.m_Grain2 + 1], m_FieldEulerAngles[3 * trial.m_Grain2 + 2], r1, r2, r3);
+    g2odfbin = ops->getOdfBin(r1, r2, r3);
+    odfchange = ((actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)) * (actualodf->GetValue(g1odfbin) - simodf->GetValue(g1odfbin)))
+        - ((actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - g1vol + g2vol))
+           * (actualodf->GetValue(g1odfbin) - (simodf->GetValue(g1odfbin) - g1vol + g2vol)));
+    odfchange = odfchange
+        + (((actualodf->GetValue(g2odfbin) - simodf->GetValue(g2odfbin)) * (actualodf->GetValue(g2odfbin) - simodf->GetValue(g2odfbin)))
+           - ((actualodf->GetValue(g2odfbin) - (simodf->GetValue(g2odfbin) - g2vol + g1vol))
+              * (actualodf->GetValue(g2odfbin) - (simodf->GetValue(g2odfbin) - g2vol + g1vol))));
+  }
+
+  float mdfchange = 0;
+  int slot = 0;
+  for (int g = 0; g < numGrains; ++g)
+  {
+    for (int e = m_BoundaryOffsets[grains[g]]; e < m_BoundaryOffsets[grains[g] + 1]; ++e)
+    {
+      int newmisobin = bins[slot++];
+      if(newmisobin < 0) { continue; }
+      int curmisobin = m_BoundaryBins[e];
+      float neighsurfarea = m_BoundaryWeights[e];
+      mdfchange = mdfchange
+          + (((actualmdf->GetValue(curmisobin) - simmdf->GetValue(curmisobin)) * (actualmdf->GetValue(curmisobin) - simmdf->GetValue(curmisobin)))
+             - ((actualmdf->GetValue(curmisobin) - (simmdf->GetValue(curmisobin) - neighsurfarea))
+                * (actualmdf->GetValue(curmisobin) - (simmdf->GetValue(curmisobin) - neighsurfarea))));
+      mdfchange = mdfchange
+          + (((actualmdf->GetValue(newmisobin) - simmdf->GetValue(newmisobin)) * (actualmdf->GetValue(newmisobin) - simmdf->GetValue(newmisobin)))
+             - ((actualmdf->GetValue(newmisobin) - (simmdf->GetValue(newmisobin) + neighsurfarea))
+                * (actualmdf->GetValue(newmisobin) - (simmdf->GetValue(newmisobin) + neighsurfarea))));
+    }
+  }
+
+  float deltaerror = static_cast<float>((odfchange / odferror) + (mdfchange / mdferror));
+  if(deltaerror <= 0) { return false; }
+
+  if(numGrains == 1)
+  {
+    m_FieldEulerAngles[3 * trial.m_Grain1] = trial.m_Eulers[0];
+    m_FieldEulerAngles[3 * trial.m_Grain1 + 1] = trial.m_Eulers[1];
+    m_FieldEulerAngles[3 * trial.m_Grain1 + 2] = trial.m_Eulers[2];
+    QuaternionMathF::Copy(trial.m_Quat, avgQuats[trial.m_Grain1]);
+    adjust_odf(trial.m_Choose, g1vol, odferror);
+    adjust_odf(g1odfbin, -g1vol, odferror);
+  }
+  else
+  {
+    float g2vol = m_Volumes[trial.m_Grain2] / unbiasedvol[ensem];
+    for (int k = 0; k < 3; ++k)
+    {
+      std::swap(m_FieldEulerAngles[3 * trial.m_Grain1 + k], m_FieldEulerAngles[3 * trial.m_Grain2 + k]);
+    }
+    std::swap(avgQuats[trial.m_Grain1], avgQuats[trial.m_Grain2]);
+    adjust_odf(g1odfbin, g2vol - g1vol, odferror);
+    adjust_odf(g2odfbin, g1vol - g2vol, odferror);
+  }
+
+  slot = 0;
+  for (int g = 0; g < numGrains; ++g)
+  {
+    for (int e = m_BoundaryOffsets[grains[g]]; e < m_BoundaryOffsets[grains[g] + 1]; ++e)
+    {
+      int newmisobin = bins[slot++];
+      if(newmisobin < 0) { continue; }
+      adjust_mdf(m_BoundaryBins[e], -m_BoundaryWeights[e], mdferror);
+      adjust_mdf(newmisobin, m_BoundaryWeights[e], mdferror);
+      m_BoundaryBins[e] = newmisobin;
+      if(m_ReverseBoundaries[e] >= 0) { m_BoundaryBins[m_ReverseBoundaries[e]] = newmisobin; }
+    }
+    m_ChangedStamps[grains[g]] = stamp;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::adjust_odf(int bin, float change, double& odferror)
+{
+  float diff = actualodf->GetValue(bin) - simodf->GetValue(bin);
+  odferror = odferror - diff * diff;
+  simodf->SetValue(bin, simodf->GetValue(bin) + change);
+  diff = actualodf->GetValue(bin) - simodf->GetValue(bin);
+  odferror = odferror + diff * diff;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::adjust_mdf(int bin, float change, double& mdferror)
+{
+  float diff = actualmdf->GetValue(bin) - simmdf->GetValue(bin);
+  mdferror = mdferror - diff * diff;
+  simmdf->SetValue(bin, simmdf->GetValue(bin) + change);
+  diff = actualmdf->GetValue(bin) - simmdf->GetValue(bin);
+  mdferror = mdferror + diff * diff;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -837,73 +909,81 @@ void MatchCrystallography::measure_misorientations(int ensem)
   NeighborList<int>& neighborlist = *m_NeighborList;
   NeighborList<float>& neighborsurfacearealist = *m_SharedSurfaceAreaList;
 
-  float w;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float r1 = 0.0f, r2 = 0.0f, r3 = 0.0f;
-  QuatF q1;
-  QuatF q2;
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  unsigned int crys1;
-  int mbin = 0;
+  OrientationOps* ops = m_OrientationOps[m_CrystalStructures[ensem]].get();
   size_t totalFields = m->getNumFieldTuples();
-  //float threshold = 0.0f;
 
-  misorientationlists.resize(totalFields);
-  std::stringstream ss;
+  // Gather the boundaries between grains of this phase
+  m_BoundaryOffsets.assign(totalFields + 1, 0);
+  m_BoundaryNeighbors.clear();
+  m_BoundaryWeights.clear();
   for (size_t i = 1; i < totalFields; i++)
   {
-    if(m_FieldPhases[i] == ensem)
+    m_BoundaryOffsets[i] = static_cast<int>(m_BoundaryNeighbors.size());
+    if(m_FieldPhases[i] != ensem) { continue; }
+    size_t size = 0;
+    if(neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
     {
-      if(misorientationlists[i].size() != 0)
-      {
-        misorientationlists[i].clear();
-      }
-      if(neighborlist[i].size() != 0)
+      size = neighborlist[i].size();
+    }
+    for (size_t j = 0; j < size; j++)
+    {
+      int nname = neighborlist[i][j];
+      if(m_FieldPhases[nname] == ensem)
       {
-        misorientationlists[i].resize(neighborlist[i].size() * 3, 0.0);
+        m_BoundaryNeighbors.push_back(nname);
+        m_BoundaryWeights.push_back(neighborsurfacearealist[i][j] / totalSurfaceArea[ensem]);
       }
-      QuaternionMathF::Copy(avgQuats[i], q1);
-//      q1[1] = m_AvgQuats[4 * i + 1];
-//      q1[2] = m_AvgQuats[4 * i + 2];
-//      q1[3] = m_AvgQuats[4 * i + 3];
-//      q1[4] = m_AvgQuats[4 * i + 4];
-      crys1 = m_CrystalStructures[ensem];
-      size_t size = 0;
-      if(neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
+    }
+  }
+  m_BoundaryOffsets[totalFields] = static_cast<int>(m_BoundaryNeighbors.size());
+  size_t numBoundaries = m_BoundaryNeighbors.size();
+
+  m_ReverseBoundaries.assign(numBoundaries, -1);
+  for (size_t i = 1; i < totalFields; i++)
+  {
+    for (int e = m_BoundaryOffsets[i]; e < m_BoundaryOffsets[i + 1]; ++e)
+    {
+      int nname = m_BoundaryNeighbors[e];
+      for (int r = m_BoundaryOffsets[nname]; r < m_BoundaryOffsets[nname + 1]; ++r)
       {
-        size = neighborlist[i].size();
+        if(m_BoundaryNeighbors[r] == static_cast<int>(i)) { m_ReverseBoundaries[e] = r; break; }
       }
+    }
+  }
 
-      for (size_t j = 0; j < size; j++)
+  // Find the misorientation of every boundary
+  std::vector<QuatF> q1s(numBoundaries);
+  std::vector<QuatF> q2s(numBoundaries);
+  std::vector<float> angles(numBoundaries);
+  std::vector<float> axes(3 * numBoundaries);
+  for (size_t i = 1; i < totalFields; i++)
+  {
+    for (int e = m_BoundaryOffsets[i]; e < m_BoundaryOffsets[i + 1]; ++e)
+    {
+      QuaternionMathF::Copy(avgQuats[i], q1s[e]);
+      QuaternionMathF::Copy(avgQuats[m_BoundaryNeighbors[e]], q2s[e]);
+    }
+  }
+  if(numBoundaries > 0)
+  {
+    ops->getMisoQuatBatch(&(q1s.front()), &(q2s.front()), numBoundaries, &(angles.front()), &(axes.front()));
+  }
+
+  // Each boundary is counted once in the MDF, from a grain inside the volume
+  float r1 = 0.0f, r2 = 0.0f, r3 = 0.0f;
+  m_BoundaryBins.resize(numBoundaries);
+  for (size_t i = 1; i < totalFields; i++)
+  {
+    for (int e = m_BoundaryOffsets[i]; e < m_BoundaryOffsets[i + 1]; ++e)
+    {
+      OrientationMath::AxisAngletoRod(angles[e], axes[3 * e], axes[3 * e + 1], axes[3 * e + 2], r1, r2, r3);
+      int mbin = ops->getMisoBin(r1, r2, r3);
+      m_BoundaryBins[e] = mbin;
+      int nname = m_BoundaryNeighbors[e];
+      if(m_SurfaceFields[i] == false && (nname > static_cast<int>(i) || m_SurfaceFields[nname] == true))
       {
-        int nname = neighborlist[i][j];
-        if(m_FieldPhases[nname] == ensem)
-        {
-          w = 10000.0;
-          float neighsurfarea = neighborsurfacearealist[i][j];
-          QuaternionMathF::Copy(avgQuats[nname], q2);
-//          q2[1] = m_AvgQuats[4 * nname + 1];
-//          q2[2] = m_AvgQuats[4 * nname + 2];
-//          q2[3] = m_AvgQuats[4 * nname + 3];
-//          q2[4] = m_AvgQuats[4 * nname + 4];
-          w = m_OrientationOps[crys1]->getMisoQuat(q1, q2, n1, n2, n3);
-          OrientationMath::AxisAngletoRod(w, n1, n2, n3, r1, r2, r3);
-          misorientationlists[i][3 * j] = r1;
-          misorientationlists[i][3 * j + 1] = r2;
-          misorientationlists[i][3 * j + 2] = r3;
-          mbin = m_OrientationOps[crys1]->getMisoBin(misorientationlists[i][3 * j], misorientationlists[i][3 * j + 1], misorientationlists[i][3 * j + 2]);
-          if(m_SurfaceFields[i] == false && (nname > static_cast<int>(i) || m_SurfaceFields[nname] == true))
-          {
-            simmdf->SetValue(mbin, (simmdf->GetValue(mbin)+(neighsurfarea/totalSurfaceArea[m_FieldPhases[i]])));
-          }
-        }
-        else
-        {
-          misorientationlists[i][3 * j] = -100;
-          misorientationlists[i][3 * j + 1] = -100;
-          misorientationlists[i][3 * j + 2] = -100;
-        }
+        simmdf->SetValue(mbin, (simmdf->GetValue(mbin) + m_BoundaryWeights[e]));
       }
     }
   }
@@ -55,6 +55,22 @@
 #include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
 #include "DREAM3DLib/DataArrays/NeighborList.hpp"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+/**
+ * @brief A proposed change of orientation that is scored as part of a batch. Either a
+ * new orientation is swapped in for m_Grain1 or, when m_Grain2 is not -1, the orientations
+ * of the two grains are switched. m_BinOffset is where the misorientation bins of the
+ * boundaries of the grain(s) with their new orientations are stored.
+ */
+typedef struct {
+    int m_Grain1;
+    int m_Grain2;
+    int m_Choose;
+    float m_Eulers[3];
+    QuatF m_Quat;
+    size_t m_BinOffset;
+} CrystallographyTrial;
 
 /**
  * @class MatchCrystallography MatchCrystallography.h DREAM3DLib/SyntheticBuilderFilters/MatchCrystallography.h
@@ -96,6 +112,8 @@ class DREAM3DLib_EXPORT MatchCrystallography : public AbstractFilter
     typedef boost::shared_array<int> SharedIntArray;
 
     DREAM3D_INSTANCE_PROPERTY(int, MaxIterations)
+    DREAM3D_INSTANCE_PROPERTY(int, TrialsPerBatch)
+    DREAM3D_INSTANCE_PROPERTY(int, RandomSeed)
 
     virtual const std::string getGroupName() {return DREAM3D::FilterGroups::SyntheticBuildingFilters;}
     virtual const std::string getSubGroupName() { return DREAM3D::FilterSubGroups::CrystallographyFilters; }
@@ -128,13 +146,26 @@ class DREAM3DLib_EXPORT MatchCrystallography : public AbstractFilter
 
     void determine_volumes();
     void determine_boundary_areas();
-    void assign_eulers(int ensem);
+    void assign_eulers(int ensem, DREAM3DRandom& rg);
     int pick_euler(float random, int numbins);
-    void MC_LoopBody1(int grain, int ensem, int j, float neighsurfarea, unsigned int sym, QuatF &q1, QuatF &q2);
-    void MC_LoopBody2(int grain, int phase, int j, float neighsurfarea, unsigned int sym, QuatF &q1, QuatF &q2);
-    void matchCrystallography(int ensem);
+    void matchCrystallography(int ensem, DREAM3DRandom& rg);
     void measure_misorientations(int ensem);
 
+    /**
+     * @brief Draws the next trial from the random number generator. Only the random
+     * numbers are used so trials can be drawn ahead of the ones being committed.
+     */
+    void propose_trial(DREAM3DRandom& rg, int ensem, int numbins, CrystallographyTrial& trial);
+
+    /**
+     * @brief Scores a trial against the current ODF and MDF and applies it if it lowers the
+     * error. Returns true if the trial was accepted.
+     */
+    bool commit_trial(CrystallographyTrial& trial, int ensem, int stamp, double& odferror, double& mdferror);
+
+    void adjust_odf(int bin, float change, double& odferror);
+    void adjust_mdf(int bin, float change, double& mdferror);
+
   private:
 
     // Cell Data
@@ -170,7 +201,20 @@ class DREAM3DLib_EXPORT MatchCrystallography : public AbstractFilter
     FloatArrayType::Pointer simmdf;
 
 
-    std::vector<std::vector<float> > misorientationlists;
+    // The boundaries of the grains of the current phase in compressed row form. For each
+    // boundary the neighbor, its share of the total boundary area, its current MDF bin and
+    // the index of the same boundary in the list of the neighbor are kept
+    std::vector<int> m_BoundaryOffsets;
+    std::vector<int> m_BoundaryNeighbors;
+    std::vector<float> m_BoundaryWeights;
+    std::vector<int> m_BoundaryBins;
+    std::vector<int> m_ReverseBoundaries;
+
+    std::vector<int> m_Candidates;
+    std::vector<float> m_OdfCumulative;
+    std::vector<CrystallographyTrial> m_Trials;
+    std::vector<int> m_TrialBins;
+    std::vector<int> m_ChangedStamps;
 
     OrientationMath::Pointer m_CubicOps;
     OrientationMath::Pointer m_HexOps;
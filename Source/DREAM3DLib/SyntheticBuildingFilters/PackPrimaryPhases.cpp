@@ -36,9 +36,11 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
@@ -225,6 +227,129 @@ class AssignVoxelsGapsImpl
 
 };
 
+/**
+ * @brief Scores a batch of grain moves. Each move takes its grain off the packing grid at the old
+ * center and puts it back at the new one, keeping the move if the filling error did not go up.
+ * The moves of a batch never touch the same packing points so they can be scored in any order.
+ */
+class PackPrimaryPhasesMovesImpl
+{
+    PackingMove* m_Moves;
+    const std::vector<std::vector<FootprintRun> >* m_Footprints;
+    int32_t* m_GrainOwners;
+    bool* m_ExclusionZones;
+    int* m_PackQualities;
+    int m_PackingPoints[3];
+    bool m_PeriodicBoundaries;
+
+  public:
+    PackPrimaryPhasesMovesImpl(PackingMove* moves, const std::vector<std::vector<FootprintRun> >* footprints,
+                               int32_t* grainOwners, bool* exclusionZones, int* packQualities,
+                               int* packingPoints, bool periodicBoundaries) :
+      m_Moves(moves),
+      m_Footprints(footprints),
+      m_GrainOwners(grainOwners),
+      m_ExclusionZones(exclusionZones),
+      m_PackQualities(packQualities),
+      m_PeriodicBoundaries(periodicBoundaries)
+    {
+      m_PackingPoints[0] = packingPoints[0];
+      m_PackingPoints[1] = packingPoints[1];
+      m_PackingPoints[2] = packingPoints[2];
+    }
+    virtual ~PackPrimaryPhasesMovesImpl(){}
+
+    // -----------------------------------------------------------------------------
+    // Adds (or removes) the footprint of a grain at the given center and returns the change in the
+    // filling error times the number of packing points. This is the same update check_fillingerror does.
+    // -----------------------------------------------------------------------------
+    int64_t place(const std::vector<FootprintRun>& runs, const int center[3], bool add, int* packQuality) const
+    {
+      int k1 = add ? 2 : -2;
+      int k2 = add ? -1 : 3;
+      int k3 = add ? 1 : -1;
+      int64_t change = 0;
+      size_t size = 0;
+      float packquality = 0;
+      int col, row, plane;
+      for (size_t i = 0; i < runs.size(); i++)
+      {
+        const FootprintRun& run = runs[i];
+        size = size + run.m_Length;
+        col = run.m_Column + center[0];
+        row = run.m_Row + center[1];
+        if(m_PeriodicBoundaries == true)
+        {
+          if(col < 0) col = col + m_PackingPoints[0];
+          if(col > m_PackingPoints[0] - 1) col = col - m_PackingPoints[0];
+          if(row < 0) row = row + m_PackingPoints[1];
+          if(row > m_PackingPoints[1] - 1) row = row - m_PackingPoints[1];
+        }
+        else if(col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1])
+        {
+          continue;
+        }
+        size_t rowIdx = (m_PackingPoints[0]*row) + col;
+        for (int j = 0; j < run.m_Length; j++)
+        {
+          plane = run.m_Plane + center[2] + j;
+          if(m_PeriodicBoundaries == true)
+          {
+            if(plane < 0) plane = plane + m_PackingPoints[2];
+            if(plane > m_PackingPoints[2] - 1) plane = plane - m_PackingPoints[2];
+          }
+          else if(plane < 0 || plane >= m_PackingPoints[2])
+          {
+            continue;
+          }
+          size_t grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + rowIdx;
+          int currentGrainOwner = m_GrainOwners[grainOwnersIdx];
+          change = change + (k1 * currentGrainOwner + k2);
+          m_GrainOwners[grainOwnersIdx] = currentGrainOwner + k3;
+          if(add == true)
+          {
+            if(run.m_Exclusion == true) m_ExclusionZones[grainOwnersIdx] = true;
+            packquality = packquality + ((currentGrainOwner) * (currentGrainOwner));
+          }
+          else if(run.m_Exclusion == true && m_GrainOwners[grainOwnersIdx] == 0)
+          {
+            m_ExclusionZones[grainOwnersIdx] = false;
+          }
+        }
+      }
+      if(add == true) { *packQuality = static_cast<int>( packquality / float(size) ); }
+      return change;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void generate(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        PackingMove& move = m_Moves[i];
+        const std::vector<FootprintRun>& runs = (*m_Footprints)[move.m_Grain];
+        int64_t change = place(runs, move.m_OldCenter, false, NULL);
+        change = change + place(runs, move.m_NewCenter, true, m_PackQualities + move.m_Grain);
+        move.m_FillingChange = change;
+        move.m_Accepted = (change <= 0);
+        if(move.m_Accepted == false)
+        {
+          place(runs, move.m_NewCenter, false, NULL);
+          place(runs, move.m_OldCenter, true, m_PackQualities + move.m_Grain);
+        }
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t> &r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+};
+
 
 // -----------------------------------------------------------------------------
 //
@@ -249,6 +374,8 @@ PackPrimaryPhases::PackPrimaryPhases() :
   m_CsvOutputFile(""),
   m_PeriodicBoundaries(false),
   m_WriteGoalAttributes(false),
+  m_MoveBatchSize(1),
+  m_RandomSeed(0),
   m_GrainIds(NULL),
   m_CellPhases(NULL),
   m_SurfaceVoxels(NULL),
@@ -279,6 +406,9 @@ PackPrimaryPhases::PackPrimaryPhases() :
 
   m_HalfPackingRes[0] = m_HalfPackingRes[1] = m_HalfPackingRes[2] = 1.0f;
   m_OneOverHalfPackingRes[0] = m_OneOverHalfPackingRes[1] = m_OneOverHalfPackingRes[2] = 1.0f;
+  m_GrainHashDims[0] = m_GrainHashDims[1] = m_GrainHashDims[2] = 0;
+  m_OneOverGrainHashRes = 1.0f;
+  m_MoveLockDims[0] = m_MoveLockDims[1] = m_MoveLockDims[2] = 0;
 
   Seed = MXA::getMilliSeconds();
   setupFilterParameters();
@@ -323,6 +453,22 @@ void PackPrimaryPhases::setupFilterParameters()
     option->setValueType("string");
     parameters.push_back(option);
   }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Moves Per Batch");
+    option->setPropertyName("MoveBatchSize");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    parameters.push_back(option);
+  }
+  {
+    FilterParameter::Pointer option = FilterParameter::New();
+    option->setHumanLabel("Random Seed");
+    option->setPropertyName("RandomSeed");
+    option->setWidgetType(FilterParameter::IntWidget);
+    option->setValueType("int");
+    parameters.push_back(option);
+  }
 
   setFilterParameters(parameters);
 }
@@ -335,6 +481,8 @@ void PackPrimaryPhases::readFilterParameters(AbstractFilterParametersReader* rea
   setPeriodicBoundaries(reader->readValue("PeriodicBoundaries", getPeriodicBoundaries()));
   setWriteGoalAttributes(reader->readValue("WriteGoalAttributes", getWriteGoalAttributes()));
   setCsvOutputFile(reader->readValue("CsvOutputFile", getCsvOutputFile()));
+  setMoveBatchSize(reader->readValue("MoveBatchSize", getMoveBatchSize()));
+  setRandomSeed(reader->readValue("RandomSeed", getRandomSeed()));
   /* FILTER_WIDGETCODEGEN_AUTO_GENERATED_CODE END*/
   reader->closeFilterGroup();
 }
@@ -348,6 +496,8 @@ int PackPrimaryPhases::writeFilterParameters(AbstractFilterParametersWriter* wri
   writer->writeValue("PeriodicBoundaries", getPeriodicBoundaries() );
   writer->writeValue("WriteGoalAttributes", getWriteGoalAttributes() );
   writer->writeValue("CsvOutputFile", getCsvOutputFile() );
+  writer->writeValue("MoveBatchSize", getMoveBatchSize() );
+  writer->writeValue("RandomSeed", getRandomSeed() );
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -429,6 +579,10 @@ void PackPrimaryPhases::execute()
   int err = 0;
   setErrorCondition(err);
   unsigned long long int Seed = MXA::getMilliSeconds();
+  if(m_RandomSeed != 0)
+  {
+    Seed = static_cast<unsigned int>(m_RandomSeed);
+  }
   DREAM3D_RANDOMNG_NEW_SEEDED(Seed);
 
   int64_t totalPoints = m->getTotalPoints();
@@ -585,6 +739,13 @@ void PackPrimaryPhases::execute()
 
   int gid = 1;
   firstPrimaryField = gid;
+  // The resized field arrays are not initialized. Clear the fields that have not been generated yet
+  // so check_sizedisterror does not count them as grains
+  for (int i = firstPrimaryField; i < estNumGrains; i++)
+  {
+    m_FieldPhases[i] = 0;
+    m_Active[i] = false;
+  }
   std::vector<float> curphasevol;
   curphasevol.resize(primaryphases.size());
   float factor = 1.0;
@@ -757,15 +918,20 @@ void PackPrimaryPhases::execute()
 
   size_t numgrains = m->getNumFieldTuples();
 
-  columnlist.resize(numgrains);
-  rowlist.resize(numgrains);
-  planelist.resize(numgrains);
-  ellipfunclist.resize(numgrains);
+  m_Footprints.clear();
+  m_Footprints.resize(numgrains);
+  m_FootprintBounds.resize(6 * numgrains);
   packqualities.resize(numgrains);
   fillingerror = 1;
 
+  // Every grain starts its search for an open spot from the center of the volume. Grains are only
+  // added here so the exclusion zones only ever grow and the first open spot can never be before the
+  // one found for the previous grain, which lets the search pick up where it left off.
   int count = 0;
   int column, row, plane;
+  column = static_cast<int>( ((sizex * 0.5f) - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
+  row = static_cast<int>( ((sizey * 0.5f) - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
+  plane = static_cast<int>( ((sizez * 0.5f) - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
   int progGrain = 0;
   int progGrainInc = numgrains * .01;
   for (size_t i = firstPrimaryField; i < numgrains; i++)
@@ -785,10 +951,6 @@ void PackPrimaryPhases::execute()
     m_Centroids[3 * i + 1] = yc;
     m_Centroids[3 * i + 2] = zc;
     insert_grain(i);
-    count = 0;
-    column = static_cast<int>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-    row = static_cast<int>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-    plane = static_cast<int>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
     grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + column;
     while(exclusionZones[grainOwnersIdx] == true && count < m_TotalPackingPoints)
     {
@@ -827,6 +989,8 @@ void PackPrimaryPhases::execute()
   }
 
   notifyStatusMessage("Determining Neighbors");
+  initialize_grainhash();
+  initialize_neighborhoodhist();
   progGrain = 0;
   progGrainInc = numgrains * .01;
   uint64_t millis = MXA::getMilliSeconds();
@@ -857,11 +1021,12 @@ void PackPrimaryPhases::execute()
 
   millis = MXA::getMilliSeconds();
   startMillis = millis;
-  bool good;
-  float xshift, yshift, zshift;
   int lastIteration = 0;
   int numIterationsPerTime = 0;
-  for (int iteration = 0; iteration < totalAdjustments; ++iteration)
+  int moveBatchSize = (m_MoveBatchSize > 1) ? m_MoveBatchSize : 1;
+  int movesScored = 1;
+  int nextErrorIteration = 0;
+  for (int iteration = 0; iteration < totalAdjustments; iteration += movesScored)
   {
     currentMillis = MXA::getMilliSeconds();
     if (currentMillis - millis > 1000)
@@ -893,64 +1058,24 @@ void PackPrimaryPhases::execute()
 
     int option = iteration % 2;
 
-    if(writeErrorFile == true && iteration % 25 == 0)
+    if(writeErrorFile == true && iteration >= nextErrorIteration)
     {
+      nextErrorIteration = (iteration / 25 + 1) * 25;
       outFile << iteration << " " << fillingerror << "  " << oldsizedisterror << "  " << oldneighborhooderror << "  " << numgrains << " " << acceptedmoves
               << std::endl;
     }
 
+    if(moveBatchSize > 1)
+    {
+      acceptedmoves = acceptedmoves + batch_moves(iteration, std::min(moveBatchSize, totalAdjustments - iteration), rg, grainOwnersPtr, exclusionZonesPtr, movesScored);
+      continue;
+    }
+
     // JUMP - this option moves one grain to a random spot in the volume
     if(option == 0)
     {
-      randomgrain = firstPrimaryField + int(rg.genrand_res53() * (numgrains-firstPrimaryField));
-      good = false;
-      count = 0;
-      while(good == false && count < static_cast<int>((numgrains-firstPrimaryField)) )
-      {
-        xc = m_Centroids[3*randomgrain];
-        yc = m_Centroids[3*randomgrain+1];
-        zc = m_Centroids[3*randomgrain+2];
-        column = static_cast<int>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-        row = static_cast<int>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-        plane = static_cast<int>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + column;
-        if(grainOwners[grainOwnersIdx] > 1) good = true;
-        else randomgrain++;
-        if(static_cast<size_t>(randomgrain) >= numgrains) randomgrain = firstPrimaryField;
-        count++;
-      }
-      Seed++;
-
-      count = 0;
-      xc = static_cast<float>(rg.genrand_res53() * sizex);
-      yc = static_cast<float>(rg.genrand_res53() * sizey);
-      zc = static_cast<float>(rg.genrand_res53() * sizez);
-      column = static_cast<int>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-      row = static_cast<int>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-      plane = static_cast<int>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-
-      while(exclusionZones[grainOwnersIdx] == true && count < m_TotalPackingPoints)
-      {
-        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + column;
-        if(column >= m_PackingPoints[0])
-        {
-          column = 0;
-          row++;
-          if(row >= m_PackingPoints[1])
-          {
-            row = 0;
-            plane++;
-            if(plane >= m_PackingPoints[2])
-            {
-              plane = 0;
-            }
-          }
-        }
-        count++;
-      }
-      xc = static_cast<float>((column*m_PackingRes[0]) + (m_PackingRes[0]*0.5));
-      yc = static_cast<float>((row*m_PackingRes[1]) + (m_PackingRes[1]*0.5));
-      zc = static_cast<float>((plane*m_PackingRes[2]) + (m_PackingRes[2]*0.5));
+      randomgrain = choose_move_grain(rg, grainOwners);
+      choose_move_target(option, randomgrain, rg, xc, yc, zc);
       oldxc = m_Centroids[3 * randomgrain];
       oldyc = m_Centroids[3 * randomgrain + 1];
       oldzc = m_Centroids[3 * randomgrain + 2];
@@ -974,36 +1099,11 @@ void PackPrimaryPhases::execute()
     // NUDGE - this option moves one grain to a spot close to its current centroid
     if(option == 1)
     {
-      randomgrain = firstPrimaryField + int(rg.genrand_res53() * (numgrains-firstPrimaryField));
-      good = false;
-      count = 0;
-      while(good == false && count < static_cast<int>((numgrains-firstPrimaryField)) )
-      {
-        xc = m_Centroids[3*randomgrain];
-        yc = m_Centroids[3*randomgrain+1];
-        zc = m_Centroids[3*randomgrain+2];
-        column = static_cast<int>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-        row = static_cast<int>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-        plane = static_cast<int>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + column;
-        if(grainOwners[grainOwnersIdx] > 1) good = true;
-        else randomgrain++;
-        if(static_cast<size_t>(randomgrain) >= numgrains) randomgrain = firstPrimaryField;
-        count++;
-      }
-      Seed++;
+      randomgrain = choose_move_grain(rg, grainOwners);
       oldxc = m_Centroids[3 * randomgrain];
       oldyc = m_Centroids[3 * randomgrain + 1];
       oldzc = m_Centroids[3 * randomgrain + 2];
-      xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])) );
-      yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])) );
-      zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])) );
-      if((oldxc+xshift) < sizex && (oldxc+xshift) > 0) xc = oldxc + xshift;
-      else xc = oldxc;
-      if((oldyc+yshift) < sizey && (oldyc+yshift) > 0) yc = oldyc + yshift;
-      else yc = oldyc;
-      if((oldzc+zshift) < sizez && (oldzc+zshift) > 0) zc = oldzc + zshift;
-      else zc = oldzc;
+      choose_move_target(option, randomgrain, rg, xc, yc, zc);
       oldfillingerror = fillingerror;
       fillingerror = check_fillingerror(-1000, static_cast<int>(randomgrain), grainOwnersPtr, exclusionZonesPtr);
       move_grain(randomgrain, xc, yc, zc);
@@ -1172,6 +1272,301 @@ void PackPrimaryPhases::initialize_packinggrid()
   m_PackingPoints[2] = m->getZPoints()/2;
 
   m_TotalPackingPoints = m_PackingPoints[0] * m_PackingPoints[1] * m_PackingPoints[2];
+
+  // The grain hash is only built once all of the grains have been placed
+  m_GrainHash.clear();
+  m_GrainHashIndices.clear();
+  m_MoveLocks.clear();
+  m_MoveGrainStamps.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initialize_grainhash()
+{
+  VoxelDataContainer* m = getVoxelDataContainer();
+  size_t numgrains = m->getNumFieldTuples();
+
+  float maxdia = 0.0f;
+  for (size_t i = firstPrimaryField; i < numgrains; i++)
+  {
+    if(m_EquivalentDiameters[i] > maxdia) { maxdia = m_EquivalentDiameters[i]; }
+  }
+  // Pad the cell size a little so that rounding can never put 2 grains that are closer
+  // than the largest diameter more than 1 cell apart
+  float hashres = maxdia * 1.001f;
+  float size[3] = {sizex, sizey, sizez};
+  if(hashres <= 0.0f) { hashres = std::max(sizex, std::max(sizey, sizez)); }
+  m_OneOverGrainHashRes = 1.0f / hashres;
+  for (int i = 0; i < 3; i++)
+  {
+    m_GrainHashDims[i] = static_cast<int>(size[i] * m_OneOverGrainHashRes) + 1;
+  }
+
+  m_GrainHash.clear();
+  m_GrainHash.resize(m_GrainHashDims[0] * m_GrainHashDims[1] * m_GrainHashDims[2]);
+  m_GrainHashIndices.clear();
+  m_GrainHashIndices.resize(numgrains, 0);
+  int cell[3];
+  for (size_t i = firstPrimaryField; i < numgrains; i++)
+  {
+    size_t index = grainhash_index(m_Centroids[3*i], m_Centroids[3*i+1], m_Centroids[3*i+2], cell);
+    m_GrainHash[index].push_back(static_cast<int>(i));
+    m_GrainHashIndices[i] = index;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PackPrimaryPhases::grainhash_index(float x, float y, float z, int cell[3])
+{
+  float coords[3] = {x, y, z};
+  for (int i = 0; i < 3; i++)
+  {
+    cell[i] = static_cast<int>(coords[i] * m_OneOverGrainHashRes);
+    if(cell[i] < 0) { cell[i] = 0; }
+    if(cell[i] > m_GrainHashDims[i] - 1) { cell[i] = m_GrainHashDims[i] - 1; }
+  }
+  return (m_GrainHashDims[0]*m_GrainHashDims[1]*cell[2]) + (m_GrainHashDims[0]*cell[1]) + cell[0];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::update_grainhash(size_t gnum)
+{
+  // Nothing to do until the hash has been built
+  if(gnum >= m_GrainHashIndices.size()) { return; }
+  int cell[3];
+  size_t index = grainhash_index(m_Centroids[3*gnum], m_Centroids[3*gnum+1], m_Centroids[3*gnum+2], cell);
+  size_t oldindex = m_GrainHashIndices[gnum];
+  if(index == oldindex) { return; }
+  std::vector<int>& oldcell = m_GrainHash[oldindex];
+  std::vector<int>::iterator iter = std::find(oldcell.begin(), oldcell.end(), static_cast<int>(gnum));
+  *iter = oldcell.back();
+  oldcell.pop_back();
+  m_GrainHash[index].push_back(static_cast<int>(gnum));
+  m_GrainHashIndices[gnum] = index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::find_packing_center(size_t gnum, int center[3])
+{
+  find_packing_center(m_Centroids[3*gnum], m_Centroids[3*gnum+1], m_Centroids[3*gnum+2], center);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::find_packing_center(float x, float y, float z, int center[3])
+{
+  center[0] = static_cast<int>( (x - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
+  center[1] = static_cast<int>( (y - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
+  center[2] = static_cast<int>( (z - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PackPrimaryPhases::choose_move_grain(DREAM3DRandom& rg, int32_t* grainOwners)
+{
+  size_t numgrains = getVoxelDataContainer()->getNumFieldTuples();
+  int center[3];
+  int randomgrain = firstPrimaryField + int(rg.genrand_res53() * (numgrains-firstPrimaryField));
+  bool good = false;
+  int count = 0;
+  while(good == false && count < static_cast<int>((numgrains-firstPrimaryField)) )
+  {
+    find_packing_center(randomgrain, center);
+    size_t grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*center[2]) + (m_PackingPoints[0]*center[1]) + center[0];
+    if(grainOwners[grainOwnersIdx] > 1) good = true;
+    else randomgrain++;
+    if(static_cast<size_t>(randomgrain) >= numgrains) randomgrain = firstPrimaryField;
+    count++;
+  }
+  return randomgrain;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::choose_move_target(int option, size_t gnum, DREAM3DRandom& rg, float& xc, float& yc, float& zc)
+{
+  if(option == 0)
+  {
+    // The grain jumps to the random spot even if it lies in an exclusion zone; the filling error
+    // decides whether the jump is kept
+    xc = static_cast<float>(rg.genrand_res53() * sizex);
+    yc = static_cast<float>(rg.genrand_res53() * sizey);
+    zc = static_cast<float>(rg.genrand_res53() * sizez);
+    int center[3];
+    find_packing_center(xc, yc, zc, center);
+    xc = static_cast<float>((center[0]*m_PackingRes[0]) + (m_PackingRes[0]*0.5));
+    yc = static_cast<float>((center[1]*m_PackingRes[1]) + (m_PackingRes[1]*0.5));
+    zc = static_cast<float>((center[2]*m_PackingRes[2]) + (m_PackingRes[2]*0.5));
+  }
+  else
+  {
+    float oldxc = m_Centroids[3 * gnum];
+    float oldyc = m_Centroids[3 * gnum + 1];
+    float oldzc = m_Centroids[3 * gnum + 2];
+    float xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])) );
+    float yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])) );
+    float zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])) );
+    if((oldxc+xshift) < sizex && (oldxc+xshift) > 0) xc = oldxc + xshift;
+    else xc = oldxc;
+    if((oldyc+yshift) < sizey && (oldyc+yshift) > 0) yc = oldyc + yshift;
+    else yc = oldyc;
+    if((oldzc+zshift) < sizez && (oldzc+zshift) > 0) zc = oldzc + zshift;
+    else zc = oldzc;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PackPrimaryPhases::batch_moves(int firstIteration, int batchSize, DREAM3DRandom& rg, Int32ArrayType::Pointer grainOwnersPtr, BoolArrayType::Pointer exclusionZonesPtr, int& movesScored)
+{
+  int32_t* grainOwners = grainOwnersPtr->GetPointer(0);
+  bool* exclusionZones = exclusionZonesPtr->GetPointer(0);
+
+  // The packing grid is split into blocks of packing points that a move has to claim before it
+  // can join the batch
+  int lockCellSize = 4;
+  if(m_MoveLocks.empty() == true)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      m_MoveLockDims[i] = (m_PackingPoints[i] + lockCellSize - 1) / lockCellSize;
+    }
+    m_MoveLocks.assign(m_MoveLockDims[0] * m_MoveLockDims[1] * m_MoveLockDims[2], -1);
+  }
+
+  // Propose the moves from the current state of the packing. A move that could overlap an earlier
+  // move of the batch is dropped and counts as a rejected move. Once a grain comes up a second time
+  // the packing has run out of distinct grains to move, so the batch ends there.
+  size_t numgrains = getVoxelDataContainer()->getNumFieldTuples();
+  if(m_MoveGrainStamps.size() != numgrains) { m_MoveGrainStamps.assign(numgrains, -1); }
+  m_Moves.clear();
+  int proposed = 0;
+  float xc, yc, zc;
+  for (int i = 0; i < batchSize; i++)
+  {
+    int iteration = firstIteration + i;
+    PackingMove move;
+    move.m_Grain = choose_move_grain(rg, grainOwners);
+    if(m_MoveGrainStamps[move.m_Grain] == firstIteration) { break; }
+    m_MoveGrainStamps[move.m_Grain] = firstIteration;
+    proposed++;
+    choose_move_target(iteration % 2, move.m_Grain, rg, xc, yc, zc);
+    move.m_NewCentroid[0] = xc;
+    move.m_NewCentroid[1] = yc;
+    move.m_NewCentroid[2] = zc;
+    find_packing_center(move.m_Grain, move.m_OldCenter);
+    find_packing_center(xc, yc, zc, move.m_NewCenter);
+    move.m_FillingChange = 0;
+    move.m_Accepted = false;
+    if(claim_move_region(move.m_Grain, move.m_OldCenter, firstIteration, false) == false
+        || claim_move_region(move.m_Grain, move.m_NewCenter, firstIteration, false) == false)
+    {
+      continue;
+    }
+    claim_move_region(move.m_Grain, move.m_OldCenter, firstIteration, true);
+    claim_move_region(move.m_Grain, move.m_NewCenter, firstIteration, true);
+    m_Moves.push_back(move);
+  }
+  movesScored = std::max(proposed, 1);
+  if(m_Moves.empty() == true) { return 0; }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if (doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, m_Moves.size()),
+                      PackPrimaryPhasesMovesImpl(&(m_Moves.front()), &m_Footprints, grainOwners, exclusionZones, &(packqualities.front()), m_PackingPoints, m_PeriodicBoundaries),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    PackPrimaryPhasesMovesImpl serial(&(m_Moves.front()), &m_Footprints, grainOwners, exclusionZones, &(packqualities.front()), m_PackingPoints, m_PeriodicBoundaries);
+    serial.generate(0, m_Moves.size());
+  }
+
+  // Commit the accepted moves in the order they were proposed. The neighborhood error is updated
+  // after every accepted move, the same as the one move at a time loop does
+  int accepted = 0;
+  for (size_t i = 0; i < m_Moves.size(); i++)
+  {
+    PackingMove& move = m_Moves[i];
+    if(move.m_Accepted == false) { continue; }
+    fillingerror = fillingerror * float(m_TotalPackingPoints);
+    fillingerror = fillingerror + static_cast<float>(move.m_FillingChange);
+    fillingerror = fillingerror / float(m_TotalPackingPoints);
+    move_grain(move.m_Grain, move.m_NewCentroid[0], move.m_NewCentroid[1], move.m_NewCentroid[2]);
+    oldneighborhooderror = check_neighborhooderror(-1000, move.m_Grain);
+    accepted++;
+  }
+  return accepted;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::claim_move_region(size_t gnum, int center[3], int stamp, bool mark)
+{
+  int* bounds = &(m_FootprintBounds[6 * gnum]);
+  std::vector<int> cells[3];
+  for (int i = 0; i < 3; i++)
+  {
+    find_lock_cells(center[i] + bounds[2*i], center[i] + bounds[2*i+1], i, cells[i]);
+  }
+  for (size_t k = 0; k < cells[2].size(); k++)
+  {
+    for (size_t j = 0; j < cells[1].size(); j++)
+    {
+      for (size_t i = 0; i < cells[0].size(); i++)
+      {
+        int& lock = m_MoveLocks[(m_MoveLockDims[0]*m_MoveLockDims[1]*cells[2][k]) + (m_MoveLockDims[0]*cells[1][j]) + cells[0][i]];
+        if(mark == true) { lock = stamp; }
+        else if(lock == stamp) { return false; }
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::find_lock_cells(int minPoint, int maxPoint, int axis, std::vector<int>& cells)
+{
+  int lockCellSize = 4;
+  int points = m_PackingPoints[axis];
+  cells.clear();
+  if(m_PeriodicBoundaries == false)
+  {
+    if(minPoint < 0) { minPoint = 0; }
+    if(maxPoint > points - 1) { maxPoint = points - 1; }
+  }
+  else if(maxPoint - minPoint >= points)
+  {
+    minPoint = 0;
+    maxPoint = points - 1;
+  }
+  int point = minPoint;
+  while(point <= maxPoint)
+  {
+    int wrapped = point % points;
+    if(wrapped < 0) { wrapped = wrapped + points; }
+    cells.push_back(wrapped / lockCellSize);
+    point = point + (lockCellSize - (wrapped % lockCellSize));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1237,7 +1632,7 @@ void PackPrimaryPhases::generate_grain(int phase, int Seed, Field* field, unsign
     totaldensity = totaldensity + axisodf->GetValue(bin);
     bin++;
   }
-  m_OrthoOps->determineEulerAngles(bin, phi1, PHI, phi2);
+  m_OrthoOps->determineEulerAngles(rg, bin, phi1, PHI, phi2);
   VectorOfFloatArray omega3 = pp->getGrainSize_Omegas();
   float mf = omega3[0]->GetValue(diameter);
   float s = omega3[1]->GetValue(diameter);
@@ -1280,35 +1675,12 @@ void PackPrimaryPhases::transfer_attributes(int gnum, Field* field)
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::move_grain(size_t gnum, float xc, float yc, float zc)
 {
-  int occolumn, ocrow, ocplane;
-  int nccolumn, ncrow, ncplane;
-  int shiftcolumn, shiftrow, shiftplane;
-  float oxc = m_Centroids[3*gnum];
-  float oyc = m_Centroids[3*gnum+1];
-  float ozc = m_Centroids[3*gnum+2];
-  occolumn = static_cast<int>( (oxc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-  ocrow = static_cast<int>( (oyc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-  ocplane = static_cast<int>( (ozc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-  nccolumn = static_cast<int>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-  ncrow = static_cast<int>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-  ncplane = static_cast<int>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-  shiftcolumn = nccolumn - occolumn;
-  shiftrow = ncrow - ocrow;
-  shiftplane = ncplane - ocplane;
+  // The footprint of the grain is relative to the packing grid point of its centroid so
+  // only the centroid needs to change
   m_Centroids[3*gnum] = xc;
   m_Centroids[3*gnum+1] = yc;
   m_Centroids[3*gnum+2] = zc;
-  size_t size = columnlist[gnum].size();
-
-  for (size_t i = 0; i < size; i++)
-  {
-    int& cl = columnlist[gnum][i];
-    cl += shiftcolumn;
-    int& rl = rowlist[gnum][i];
-    rl += shiftrow;
-    int& pl = planelist[gnum][i];
-    pl += shiftplane;
-  }
+  update_grainhash(gnum);
 }
 
 // -----------------------------------------------------------------------------
@@ -1316,7 +1688,6 @@ void PackPrimaryPhases::move_grain(size_t gnum, float xc, float yc, float zc)
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::determine_neighbors(size_t gnum, int add)
 {
-  VoxelDataContainer* m = getVoxelDataContainer();
   float x, y, z;
   float xn, yn, zn;
   float dia, dia2;
@@ -1325,26 +1696,41 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, int add)
   y = m_Centroids[3*gnum+1];
   z = m_Centroids[3*gnum+2];
   dia = m_EquivalentDiameters[gnum];
-  size_t numFieldTuples = m->getNumFieldTuples();
   int32_t increment = 0;
   if(add > 0) { increment = 1; }
   if(add < 0) { increment = -1; }
-  for (size_t n = firstPrimaryField; n < numFieldTuples; n++)
-  {
-    xn = m_Centroids[3*n];
-    yn = m_Centroids[3*n+1];
-    zn = m_Centroids[3*n+2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
-    if(dx < dia && dy < dia && dz < dia)
-    {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
-    }
-    if(dx < dia2 && dy < dia2 && dz < dia2)
+  int cell[3];
+  grainhash_index(x, y, z, cell);
+  int kmin = std::max(cell[2] - 1, 0), kmax = std::min(cell[2] + 1, m_GrainHashDims[2] - 1);
+  int jmin = std::max(cell[1] - 1, 0), jmax = std::min(cell[1] + 1, m_GrainHashDims[1] - 1);
+  int imin = std::max(cell[0] - 1, 0), imax = std::min(cell[0] + 1, m_GrainHashDims[0] - 1);
+  for (int k = kmin; k <= kmax; k++)
+  {
+    for (int j = jmin; j <= jmax; j++)
     {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      for (int i = imin; i <= imax; i++)
+      {
+        std::vector<int>& grains = m_GrainHash[(m_GrainHashDims[0]*m_GrainHashDims[1]*k) + (m_GrainHashDims[0]*j) + i];
+        for (size_t iter = 0; iter < grains.size(); iter++)
+        {
+          size_t n = grains[iter];
+          xn = m_Centroids[3*n];
+          yn = m_Centroids[3*n+1];
+          zn = m_Centroids[3*n+2];
+          dia2 = m_EquivalentDiameters[n];
+          dx = fabs(x - xn);
+          dy = fabs(y - yn);
+          dz = fabs(z - zn);
+          if(dx < dia && dy < dia && dz < dia)
+          {
+            update_neighborhood(gnum, increment);
+          }
+          if(dx < dia2 && dy < dia2 && dz < dia2)
+          {
+            update_neighborhood(n, increment);
+          }
+        }
+      }
     }
   }
 }
@@ -1352,85 +1738,96 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, int add)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-float PackPrimaryPhases::check_neighborhooderror(int gadd, int gremove)
+void PackPrimaryPhases::initialize_neighborhoodhist()
 {
-  // Optimized Code
   VoxelDataContainer* m = getVoxelDataContainer();
-
   StatsDataArray& statsDataArray = *m_StatsDataArray;
+  size_t numgrains = m->getNumFieldTuples();
 
-  float neighborerror;
-  float bhattdist;
-  float dia;
-  int nnum;
-  size_t diabin = 0;
-  size_t nnumbin = 0;
-  int index = 0;
-  std::vector<int> count;
-  int phase;
-  typedef std::vector<std::vector<float> > VectOfVectFloat_t;
-  for (size_t iter = 0; iter < simneighbordist.size(); ++iter)
+  m_NeighborHist.resize(primaryphases.size());
+  m_NeighborHistCounts.resize(primaryphases.size());
+  m_NeighborHistPhases.assign(numgrains, -1);
+  m_NeighborHistDiaBins.assign(numgrains, 0);
+  for (size_t iter = 0; iter < primaryphases.size(); ++iter)
   {
-    phase = primaryphases[iter];
-    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    VectOfVectFloat_t& curSimNeighborDist = simneighbordist[iter];
-    size_t curSImNeighborDist_Size = curSimNeighborDist.size();
-    float oneOverNeighborDistStep = 1.0f/neighbordiststep[iter];
-
-    count.resize(curSImNeighborDist_Size, 0);
-    for (size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      curSimNeighborDist[i].resize(40);
-      for (size_t j = 0; j < 40; j++)
-      {
-        curSimNeighborDist[i][j] = 0;
-      }
-    }
-    if(gadd > 0 && m_FieldPhases[gadd] == phase)
-    {
-      determine_neighbors(gadd, 1);
-    }
-    if(gremove > 0 && m_FieldPhases[gremove] == phase)
+    // Each phase has its own grain counts per size bin. The counts used to be carried over from
+    // the previous phase, so the neighborhood distributions of all but the first phase were
+    // normalized by the grains of the earlier phases as well
+    m_NeighborHist[iter].assign(simneighbordist[iter].size() * 40, 0);
+    m_NeighborHistCounts[iter].assign(simneighbordist[iter].size(), 0);
+    for (size_t i = 0; i < simneighbordist[iter].size(); i++)
     {
-      determine_neighbors(gremove, -1);
+      simneighbordist[iter][i].resize(40);
     }
 
+    // The size bin of a grain does not change during the packing so find it once
+    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[primaryphases[iter]].get());
     float maxGrainDia = pp->getMaxGrainDiameter();
     float minGrainDia = pp->getMinGrainDiameter();
     float oneOverBinStepSize = 1.0f/pp->getBinStepSize();
-
-
-    for (size_t i = firstPrimaryField; i < m->getNumFieldTuples(); i++)
+    for (size_t i = firstPrimaryField; i < numgrains; i++)
     {
-      nnum = 0;
-      index = i;
-      if(index != gremove && m_FieldPhases[index] == phase)
-      {
-        dia = m_EquivalentDiameters[index];
-        if(dia > maxGrainDia) { dia = maxGrainDia; }
-        if(dia < minGrainDia) { dia = minGrainDia; }
-        diabin = static_cast<size_t>(((dia - minGrainDia) * oneOverBinStepSize) );
-        nnum = m_Neighborhoods[index];
-        nnumbin = static_cast<size_t>( nnum * oneOverNeighborDistStep );
-        if(nnumbin >= 40) { nnumbin = 39; }
-        curSimNeighborDist[diabin][nnumbin]++;
-        count[diabin]++;
-      }
-    }
-    if(gadd > 0 && m_FieldPhases[gadd] == phase)
-    {
-      dia = m_EquivalentDiameters[gadd];
+      if(m_FieldPhases[i] != primaryphases[iter]) { continue; }
+      float dia = m_EquivalentDiameters[i];
       if(dia > maxGrainDia) { dia = maxGrainDia; }
       if(dia < minGrainDia) { dia = minGrainDia; }
-      diabin = static_cast<size_t>(((dia - minGrainDia) * oneOverBinStepSize) );
-      nnum = m_Neighborhoods[gadd];
-      nnumbin = static_cast<size_t>( nnum * oneOverNeighborDistStep );
-      if(nnumbin >= 40) { nnumbin = 39; }
-      curSimNeighborDist[diabin][nnumbin]++;
-      count[diabin]++;
+      m_NeighborHistPhases[i] = static_cast<int>(iter);
+      m_NeighborHistDiaBins[i] = static_cast<int>(((dia - minGrainDia) * oneOverBinStepSize) );
+      add_to_neighborhoodhist(i, 1);
     }
-    float runningtotal = 0.0f;
+  }
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::add_to_neighborhoodhist(size_t gnum, int count)
+{
+  int iter = m_NeighborHistPhases[gnum];
+  if(iter < 0) { return; }
+  int diabin = m_NeighborHistDiaBins[gnum];
+  int nnumbin = static_cast<int>( m_Neighborhoods[gnum] * (1.0f/neighbordiststep[iter]) );
+  if(nnumbin >= 40 || nnumbin < 0) { nnumbin = 39; }
+  m_NeighborHist[iter][diabin * 40 + nnumbin] += count;
+  m_NeighborHistCounts[iter][diabin] += count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::update_neighborhood(size_t gnum, int increment)
+{
+  add_to_neighborhoodhist(gnum, -1);
+  m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+  add_to_neighborhoodhist(gnum, 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PackPrimaryPhases::check_neighborhooderror(int gadd, int gremove)
+{
+  float neighborerror;
+  float bhattdist;
+  int phase;
+  for (size_t iter = 0; iter < simneighbordist.size(); ++iter)
+  {
+    phase = primaryphases[iter];
+    std::vector<std::vector<float> >& curSimNeighborDist = simneighbordist[iter];
+    size_t curSImNeighborDist_Size = curSimNeighborDist.size();
+    std::vector<int>& hist = m_NeighborHist[iter];
+    std::vector<int>& count = m_NeighborHistCounts[iter];
+
+    // The histogram holds every grain of the phase once. The removed grain is left out of
+    // the distribution and the added grain is counted one more time.
+    bool addGrain = (gadd > 0 && m_FieldPhases[gadd] == phase);
+    bool removeGrain = (gremove > 0 && m_FieldPhases[gremove] == phase);
+    if(addGrain == true) { determine_neighbors(gadd, 1); }
+    if(removeGrain == true) { determine_neighbors(gremove, -1); }
+    if(addGrain == true) { add_to_neighborhoodhist(gadd, 1); }
+    if(removeGrain == true) { add_to_neighborhoodhist(gremove, -1); }
+
+    float runningtotal = 0.0f;
     for (size_t i = 0; i < curSImNeighborDist_Size; i++)
     {
       if (count[i] == 0)
@@ -1446,7 +1843,7 @@ float PackPrimaryPhases::check_neighborhooderror(int gadd, int gremove)
         float oneOverCount = 1.0f / (float)(count[i]);
         for (size_t j = 0; j < 40; j++)
         {
-          curSimNeighborDist[i][j] = curSimNeighborDist[i][j] * oneOverCount;
+          curSimNeighborDist[i][j] = static_cast<float>(hist[i * 40 + j]) * oneOverCount;
           runningtotal = runningtotal + curSimNeighborDist[i][j];
         }
       }
@@ -1461,15 +1858,10 @@ float PackPrimaryPhases::check_neighborhooderror(int gadd, int gremove)
       }
     }
 
-    if(gadd > 0 && m_FieldPhases[gadd] == phase)
-    {
-      determine_neighbors(gadd, -1);
-    }
-
-    if(gremove > 0 && m_FieldPhases[gremove] == phase)
-    {
-      determine_neighbors(gremove, 1);
-    }
+    if(addGrain == true) { add_to_neighborhoodhist(gadd, -1); }
+    if(removeGrain == true) { add_to_neighborhoodhist(gremove, 1); }
+    if(addGrain == true) { determine_neighbors(gadd, -1); }
+    if(removeGrain == true) { determine_neighbors(gremove, 1); }
   }
   compare_3Ddistributions(simneighbordist, neighbordist, bhattdist);
   neighborerror = bhattdist;
@@ -1479,7 +1871,7 @@ float PackPrimaryPhases::check_neighborhooderror(int gadd, int gremove)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare_1Ddistributions(std::vector<float> array1, std::vector<float> array2, float &bhattdist)
+void PackPrimaryPhases::compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -1491,7 +1883,7 @@ void PackPrimaryPhases::compare_1Ddistributions(std::vector<float> array1, std::
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare_2Ddistributions(std::vector<std::vector<float> > array1, std::vector<std::vector<float> > array2, float &bhattdist)
+void PackPrimaryPhases::compare_2Ddistributions(const std::vector<std::vector<float> >& array1, const std::vector<std::vector<float> >& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -1506,7 +1898,7 @@ void PackPrimaryPhases::compare_2Ddistributions(std::vector<std::vector<float> >
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::compare_3Ddistributions(std::vector<std::vector<std::vector<float> > > array1, std::vector<std::vector<std::vector<float> > > array2, float &bhattdist)
+void PackPrimaryPhases::compare_3Ddistributions(const std::vector<std::vector<std::vector<float> > >& array1, const std::vector<std::vector<std::vector<float> > >& array2, float &bhattdist)
 {
   bhattdist = 0;
   for (size_t i = 0; i < array1.size(); i++)
@@ -1607,49 +1999,53 @@ float PackPrimaryPhases::check_fillingerror(int gadd, int gremove, Int32ArrayTyp
 
   fillingerror = fillingerror * float(m_TotalPackingPoints);
   int col, row, plane;
+  int center[3];
   int k1 = 0, k2 = 0, k3 = 0;
   if(gadd > 0)
   {
     k1 = 2;
     k2 = -1;
     k3 = 1;
-    size_t size = columnlist[gadd].size();
-    std::vector<int>& cl = columnlist[gadd];
-    std::vector<int>& rl = rowlist[gadd];
-    std::vector<int>& pl = planelist[gadd];
-    std::vector<float>& efl = ellipfunclist[gadd];
+    find_packing_center(gadd, center);
+    std::vector<FootprintRun>& runs = m_Footprints[gadd];
+    size_t size = 0;
     float packquality = 0;
-    for (size_t i = 0; i < size; i++)
+    for (size_t i = 0; i < runs.size(); i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
+      const FootprintRun& run = runs[i];
+      size = size + run.m_Length;
+      col = run.m_Column + center[0];
+      row = run.m_Row + center[1];
       if(m_PeriodicBoundaries == true)
       {
         if(col < 0) col = col + m_PackingPoints[0];
         if(col > m_PackingPoints[0] - 1) col = col - m_PackingPoints[0];
         if(row < 0) row = row + m_PackingPoints[1];
         if(row > m_PackingPoints[1] - 1) row = row - m_PackingPoints[1];
-        if(plane < 0) plane = plane + m_PackingPoints[2];
-        if(plane > m_PackingPoints[2] - 1) plane = plane - m_PackingPoints[2];
-        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + col;
-        int currentGrainOwner = grainOwners[grainOwnersIdx];
-        fillingerror = fillingerror + (k1 * currentGrainOwner  + k2);
-        grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
-        if(efl[i] > 0.25) exclusionZones[grainOwnersIdx] = true;
-        packquality = packquality + ((currentGrainOwner) * (currentGrainOwner));
       }
-      else
+      else if(col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1])
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        continue;
+      }
+      size_t rowIdx = (m_PackingPoints[0]*row) + col;
+      for (int j = 0; j < run.m_Length; j++)
+      {
+        plane = run.m_Plane + center[2] + j;
+        if(m_PeriodicBoundaries == true)
+        {
+          if(plane < 0) plane = plane + m_PackingPoints[2];
+          if(plane > m_PackingPoints[2] - 1) plane = plane - m_PackingPoints[2];
+        }
+        else if(plane < 0 || plane >= m_PackingPoints[2])
         {
-          grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + col;
-          int currentGrainOwner = grainOwners[grainOwnersIdx];
-          fillingerror = fillingerror + (k1 * currentGrainOwner + k2);
-          grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
-          if(efl[i] > 0.25) exclusionZones[grainOwnersIdx] = true;
-          packquality = packquality + ((currentGrainOwner) * (currentGrainOwner));
+          continue;
         }
+        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + rowIdx;
+        int currentGrainOwner = grainOwners[grainOwnersIdx];
+        fillingerror = fillingerror + (k1 * currentGrainOwner + k2);
+        grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
+        if(run.m_Exclusion == true) exclusionZones[grainOwnersIdx] = true;
+        packquality = packquality + ((currentGrainOwner) * (currentGrainOwner));
       }
     }
     packqualities[gadd] = static_cast<int>( packquality / float(size) );
@@ -1659,40 +2055,42 @@ float PackPrimaryPhases::check_fillingerror(int gadd, int gremove, Int32ArrayTyp
     k1 = -2;
     k2 = 3;
     k3 = -1;
-    size_t size = columnlist[gremove].size();
-    std::vector<int>& cl = columnlist[gremove];
-    std::vector<int>& rl = rowlist[gremove];
-    std::vector<int>& pl = planelist[gremove];
-    std::vector<float>& efl = ellipfunclist[gremove];
-    for (size_t i = 0; i < size; i++)
+    find_packing_center(gremove, center);
+    std::vector<FootprintRun>& runs = m_Footprints[gremove];
+    for (size_t i = 0; i < runs.size(); i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
+      const FootprintRun& run = runs[i];
+      col = run.m_Column + center[0];
+      row = run.m_Row + center[1];
       if(m_PeriodicBoundaries == true)
       {
         if(col < 0) col = col + m_PackingPoints[0];
         if(col > m_PackingPoints[0] - 1) col = col - m_PackingPoints[0];
         if(row < 0) row = row + m_PackingPoints[1];
         if(row > m_PackingPoints[1] - 1) row = row - m_PackingPoints[1];
-        if(plane < 0) plane = plane + m_PackingPoints[2];
-        if(plane > m_PackingPoints[2] - 1) plane = plane - m_PackingPoints[2];
-        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + col;
-        int currentGrainOwner = grainOwners[grainOwnersIdx];
-        fillingerror = fillingerror + ( k1 * currentGrainOwner + k2);
-        grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
-        if(efl[i] > 0.25 && grainOwners[grainOwnersIdx] == 0) exclusionZones[grainOwnersIdx] = false;
       }
-      else
+      else if(col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1])
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        continue;
+      }
+      size_t rowIdx = (m_PackingPoints[0]*row) + col;
+      for (int j = 0; j < run.m_Length; j++)
+      {
+        plane = run.m_Plane + center[2] + j;
+        if(m_PeriodicBoundaries == true)
         {
-          grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + (m_PackingPoints[0]*row) + col;
-          int currentGrainOwner = grainOwners[grainOwnersIdx];
-          fillingerror = fillingerror + (k1 * currentGrainOwner + k2);
-          grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
-          if(efl[i] > 0.25 && grainOwners[grainOwnersIdx] == 0) exclusionZones[grainOwnersIdx] = false;
+          if(plane < 0) plane = plane + m_PackingPoints[2];
+          if(plane > m_PackingPoints[2] - 1) plane = plane - m_PackingPoints[2];
         }
+        else if(plane < 0 || plane >= m_PackingPoints[2])
+        {
+          continue;
+        }
+        grainOwnersIdx = (m_PackingPoints[0]*m_PackingPoints[1]*plane) + rowIdx;
+        int currentGrainOwner = grainOwners[grainOwnersIdx];
+        fillingerror = fillingerror + (k1 * currentGrainOwner + k2);
+        grainOwners[grainOwnersIdx] = currentGrainOwner + k3;
+        if(run.m_Exclusion == true && grainOwners[grainOwnersIdx] == 0) exclusionZones[grainOwnersIdx] = false;
       }
     }
   }
@@ -1761,6 +2159,13 @@ void PackPrimaryPhases::insert_grain(size_t gnum)
   if(zmin < -m_PackingPoints[2]) zmin = -m_PackingPoints[2];
   if(zmax > 2 * m_PackingPoints[2] - 1) zmax = (2 * m_PackingPoints[2] - 1);
 
+  // The footprint is stored relative to the packing point of the centroid so that
+  // moving the grain does not have to touch it
+  int center[3];
+  find_packing_center(gnum, center);
+  std::vector<FootprintRun>& runs = m_Footprints[gnum];
+  runs.clear();
+
   float OneOverRadcur1 = 1.0/radcur1;
   float OneOverRadcur2 = 1.0/radcur2;
   float OneOverRadcur3 = 1.0/radcur3;
@@ -1787,14 +2192,40 @@ void PackPrimaryPhases::insert_grain(size_t gnum)
         inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
         if(inside >= 0)
         {
-          columnlist[gnum].push_back(column);
-          rowlist[gnum].push_back(row);
-          planelist[gnum].push_back(plane);
-          ellipfunclist[gnum].push_back(inside);
+          bool exclusion = (inside > 0.25);
+          if(runs.empty() == false && runs.back().m_Column == column - center[0] && runs.back().m_Row == row - center[1]
+             && runs.back().m_Plane + runs.back().m_Length == plane - center[2] && runs.back().m_Exclusion == exclusion)
+          {
+            runs.back().m_Length++;
+          }
+          else
+          {
+            FootprintRun run;
+            run.m_Column = column - center[0];
+            run.m_Row = row - center[1];
+            run.m_Plane = plane - center[2];
+            run.m_Length = 1;
+            run.m_Exclusion = exclusion;
+            runs.push_back(run);
+          }
         }
       }
     }
   }
+
+  // Keep the box around the footprint so a batch of moves can tell which moves could overlap
+  int* bounds = &(m_FootprintBounds[6 * gnum]);
+  bounds[0] = bounds[2] = bounds[4] = 0;
+  bounds[1] = bounds[3] = bounds[5] = 0;
+  for (size_t i = 0; i < runs.size(); i++)
+  {
+    bounds[0] = std::min(bounds[0], runs[i].m_Column);
+    bounds[1] = std::max(bounds[1], runs[i].m_Column);
+    bounds[2] = std::min(bounds[2], runs[i].m_Row);
+    bounds[3] = std::max(bounds[3], runs[i].m_Row);
+    bounds[4] = std::min(bounds[4], runs[i].m_Plane);
+    bounds[5] = std::max(bounds[5], runs[i].m_Plane + runs[i].m_Length - 1);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -2316,9 +2747,11 @@ int PackPrimaryPhases::estimate_numgrains(int xpoints, int ypoints, int zpoints,
   // Create a Reference Variable so we can use the [] syntax
   StatsDataArray& statsDataArray = *statsDataArrayPtr;
 
-  DREAM3D_RANDOMNG_NEW()
+  unsigned long long int seed = MXA::getMilliSeconds();
+  if(m_RandomSeed != 0) { seed = static_cast<unsigned int>(m_RandomSeed); }
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
 
-      std::vector<int> primaryphases;
+  std::vector<int> primaryphases;
   std::vector<double> primaryphasefractions;
   double totalprimaryfractions = 0.0;
   StatsData::Pointer statsData = StatsData::NullPointer();
@@ -51,6 +51,7 @@
 #include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
 #include "DREAM3DLib/ShapeOps/ShapeOps.h"
 #include "DREAM3DLib/OrientationOps/OrthoRhombicOps.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
 typedef struct {
     float m_Volumes;
@@ -62,6 +63,32 @@ typedef struct {
     int m_Neighborhoods;
 } Field;
 
+/**
+ * @brief A run of consecutive packing grid points along the plane (Z) direction that are
+ * covered by a grain. The position is relative to the packing grid point of the grain centroid
+ * so moving a grain does not touch its runs.
+ */
+typedef struct {
+    int m_Column;
+    int m_Row;
+    int m_Plane;
+    int m_Length;
+    bool m_Exclusion;
+} FootprintRun;
+
+/**
+ * @brief A proposed move of a grain that is scored as part of a batch of moves. The
+ * centers are the packing grid points that hold the old and new centroids.
+ */
+typedef struct {
+    int m_Grain;
+    float m_NewCentroid[3];
+    int m_OldCenter[3];
+    int m_NewCenter[3];
+    int64_t m_FillingChange;
+    bool m_Accepted;
+} PackingMove;
+
 /**
  * @class PackPrimaryPhases PackPrimaryPhases.h DREAM3DLib/SyntheticBuilderFilters/PackPrimaryPhases.h
  * @brief
@@ -107,6 +134,8 @@ class DREAM3DLib_EXPORT PackPrimaryPhases : public AbstractFilter
     DREAM3D_INSTANCE_STRING_PROPERTY(CsvOutputFile)
     DREAM3D_INSTANCE_PROPERTY(bool, PeriodicBoundaries)
     DREAM3D_INSTANCE_PROPERTY(bool, WriteGoalAttributes)
+    DREAM3D_INSTANCE_PROPERTY(int, MoveBatchSize)
+    DREAM3D_INSTANCE_PROPERTY(int, RandomSeed)
 
 
     virtual void setupFilterParameters();
@@ -135,6 +164,45 @@ class DREAM3DLib_EXPORT PackPrimaryPhases : public AbstractFilter
 
     void initialize_packinggrid();
 
+    /**
+     * @brief initialize_grainhash Bins the grain centroids into a uniform grid whose cells are
+     * as large as the largest grain diameter so the neighbors of a grain are always found in
+     * the 27 cells around it.
+     */
+    void initialize_grainhash();
+    void update_grainhash(size_t grainNum);
+    size_t grainhash_index(float x, float y, float z, int cell[3]);
+
+    /**
+     * @brief find_packing_center Finds the packing grid point that holds the centroid of a grain
+     */
+    void find_packing_center(size_t grainNum, int center[3]);
+    void find_packing_center(float x, float y, float z, int center[3]);
+
+    /**
+     * @brief choose_move_grain Picks a random grain whose centroid sits in an overlapped part
+     * of the packing grid, falling back on the next grains in order.
+     */
+    int choose_move_grain(DREAM3DRandom& rg, int32_t* grainOwners);
+
+    /**
+     * @brief choose_move_target Picks the new centroid of a grain. Option 0 jumps the grain to a
+     * random spot in the volume and option 1 nudges it by up to 2 packing points along each axis.
+     */
+    void choose_move_target(int option, size_t grainNum, DREAM3DRandom& rg, float& xc, float& yc, float& zc);
+
+    /**
+     * @brief batch_moves Proposes a batch of moves, drops the ones whose footprints could touch
+     * the same packing points as an earlier move of the batch and scores the rest concurrently.
+     * Every move only touches its own part of the packing grid so the result does not depend on
+     * the number of threads or the order the moves are scored in.
+     * @param movesScored Receives the number of moves that were proposed
+     * @return The number of moves that were accepted
+     */
+    int batch_moves(int firstIteration, int batchSize, DREAM3DRandom& rg, Int32ArrayType::Pointer grainOwnersPtr, BoolArrayType::Pointer exclusionZonesPtr, int& movesScored);
+    bool claim_move_region(size_t grainNum, int center[3], int stamp, bool mark);
+    void find_lock_cells(int minPoint, int maxPoint, int axis, std::vector<int>& cells);
+
     void generate_grain(int phase, int Seed, Field* grain, unsigned int shapeclass);
 
     void transfer_attributes(int gnum, Field* field);
@@ -144,6 +212,15 @@ class DREAM3DLib_EXPORT PackPrimaryPhases : public AbstractFilter
 
     float check_sizedisterror(Field* field);
     void determine_neighbors(size_t grainNum, int add);
+
+    /**
+     * @brief initialize_neighborhoodhist Builds the histogram of neighborhood counts for each
+     * primary phase. The histogram is kept up to date by update_neighborhood so that
+     * check_neighborhooderror does not have to visit every grain.
+     */
+    void initialize_neighborhoodhist();
+    void update_neighborhood(size_t grainNum, int increment);
+    void add_to_neighborhoodhist(size_t grainNum, int count);
     float check_neighborhooderror(int gadd, int gremove);
 
   float check_fillingerror(int gadd, int gremove, Int32ArrayType::Pointer grainOwnersPtr, BoolArrayType::Pointer exclusionZonesPtr);
@@ -152,9 +229,9 @@ class DREAM3DLib_EXPORT PackPrimaryPhases : public AbstractFilter
     void cleanup_grains();
   void write_goal_attributes();
 
-    void compare_1Ddistributions(std::vector<float>, std::vector<float>, float &sqrerror);
-    void compare_2Ddistributions(std::vector<std::vector<float> >, std::vector<std::vector<float> >, float &sqrerror);
-    void compare_3Ddistributions(std::vector<std::vector<std::vector<float> > >, std::vector<std::vector<std::vector<float> > >, float &sqrerror);
+    void compare_1Ddistributions(const std::vector<float>& array1, const std::vector<float>& array2, float &sqrerror);
+    void compare_2Ddistributions(const std::vector<std::vector<float> >& array1, const std::vector<std::vector<float> >& array2, float &sqrerror);
+    void compare_3Ddistributions(const std::vector<std::vector<std::vector<float> > >& array1, const std::vector<std::vector<std::vector<float> > >& array2, float &sqrerror);
 
     int writeVtkFile(int32_t* grainOwners, bool* exclusionZonesPtr);
     int estimate_numgrains(int xpoints, int ypoints, int zpoints, float xres, float yres, float zres);
@@ -194,10 +271,23 @@ class DREAM3DLib_EXPORT PackPrimaryPhases : public AbstractFilter
 
     OrthoRhombicOps::Pointer m_OrthoOps;
 
-    std::vector<std::vector<int> > columnlist;
-    std::vector<std::vector<int> > rowlist;
-    std::vector<std::vector<int> > planelist;
-    std::vector<std::vector<float> > ellipfunclist;
+    std::vector<std::vector<FootprintRun> > m_Footprints;
+    std::vector<int> m_FootprintBounds;
+
+    std::vector<PackingMove> m_Moves;
+    std::vector<int> m_MoveGrainStamps;
+    std::vector<int> m_MoveLocks;
+    int m_MoveLockDims[3];
+
+    std::vector<std::vector<int> > m_GrainHash;
+    std::vector<size_t> m_GrainHashIndices;
+    int m_GrainHashDims[3];
+    float m_OneOverGrainHashRes;
+
+    std::vector<std::vector<int> > m_NeighborHist;
+    std::vector<std::vector<int> > m_NeighborHistCounts;
+    std::vector<int> m_NeighborHistPhases;
+    std::vector<int> m_NeighborHistDiaBins;
 
     unsigned long long int Seed;
 
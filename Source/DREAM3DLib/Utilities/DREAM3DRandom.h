@@ -30,7 +30,8 @@
 
 /* This class uses the Mersenne Twister pseudorandom number generator code internally.
  * This class should be thread safe as long as only a single thread uses any particular
- * instance of this class.
+ * instance of this class. Parallel loops that need reproducible random numbers should
+ * use PhiloxRandom, which can hand each task its own stream.
  */
 
 #ifndef DREAM3DRANDOM_H_
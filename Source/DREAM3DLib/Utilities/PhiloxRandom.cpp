@@ -0,0 +1,238 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PhiloxRandom.h"
+
+#include <math.h>
+
+/* Philox4x32 multipliers and Weyl sequence key increments */
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+#define PHILOX_ROUNDS 10
+
+/* No block has been generated into the buffer yet */
+#define PHILOX_NO_BLOCK 0xFFFFFFFFFFFFFFFFULL
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PhiloxRandom::PhiloxRandom()
+{
+  init_genrand(0, 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PhiloxRandom::PhiloxRandom(uint64_t seed, uint64_t stream)
+{
+  init_genrand(seed, stream);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PhiloxRandom::init_genrand(uint64_t seed, uint64_t stream)
+{
+  m_Key[0] = static_cast<uint32_t>(seed);
+  m_Key[1] = static_cast<uint32_t>(seed >> 32);
+  m_Stream = stream;
+  m_Position = 0;
+  m_BufferBlock = PHILOX_NO_BLOCK;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PhiloxRandom PhiloxRandom::createStream(uint64_t stream) const
+{
+  return PhiloxRandom(getSeed(), stream);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t PhiloxRandom::getSeed() const
+{
+  return (static_cast<uint64_t>(m_Key[1]) << 32) | m_Key[0];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PhiloxRandom::philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+  uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for (int round = 0; round < PHILOX_ROUNDS; ++round)
+  {
+    if (round > 0)
+    {
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+    uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+    uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+// -----------------------------------------------------------------------------
+// The low half of the counter is the block number and the high half the stream
+// -----------------------------------------------------------------------------
+void PhiloxRandom::generateBlock(uint64_t block)
+{
+  uint32_t counter[4];
+  counter[0] = static_cast<uint32_t>(block);
+  counter[1] = static_cast<uint32_t>(block >> 32);
+  counter[2] = static_cast<uint32_t>(m_Stream);
+  counter[3] = static_cast<uint32_t>(m_Stream >> 32);
+  philox4x32(counter, m_Key, m_Buffer);
+  m_BufferBlock = block;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PhiloxRandom::genrand_beta(double aa, double bb)
+{
+  const double expmax = 89.0;
+  const double infnty = 1.0E38;
+  double a, b, alpha, beta, u1, u2, v, w, z;
+
+  if (aa > 1.0 && bb > 1.0)
+  {
+    // Algorithm BB
+    a = (aa < bb) ? aa : bb;
+    b = (aa < bb) ? bb : aa;
+    alpha = a + b;
+    beta = sqrt((alpha - 2.0) / (2.0 * a * b - alpha));
+    double gamma = a + 1.0 / beta;
+    while (true)
+    {
+      u1 = genrand_res53();
+      u2 = genrand_res53();
+      v = beta * log(u1 / (1.0 - u1));
+      w = (v > expmax) ? infnty : a * exp(v);
+      z = u1 * u1 * u2;
+      double r = gamma * v - 1.3862944;
+      double s = a + r - w;
+      if (s + 2.609438 >= 5.0 * z) { break; }
+      double t = log(z);
+      if (s > t) { break; }
+      if (r + alpha * log(alpha / (b + w)) >= t) { break; }
+    }
+  }
+  else
+  {
+    // Algorithm BC
+    a = (aa > bb) ? aa : bb;
+    b = (aa > bb) ? bb : aa;
+    alpha = a + b;
+    beta = 1.0 / b;
+    double delta = 1.0 + a - b;
+    double k1 = delta * (1.38889E-2 + 4.16667E-2 * b) / (a * beta - 0.777778);
+    double k2 = 0.25 + (0.5 + 0.25 / delta) * b;
+    while (true)
+    {
+      u1 = genrand_res53();
+      u2 = genrand_res53();
+      if (u1 < 0.5)
+      {
+        double y = u1 * u2;
+        z = u1 * y;
+        if (0.25 * u2 + z - y >= k1) { continue; }
+      }
+      else
+      {
+        z = u1 * u1 * u2;
+        if (z <= 0.25)
+        {
+          v = beta * log(u1 / (1.0 - u1));
+          w = (v > expmax) ? infnty : a * exp(v);
+          break;
+        }
+        if (z >= k2) { continue; }
+      }
+      v = beta * log(u1 / (1.0 - u1));
+      w = (v > expmax) ? infnty : a * exp(v);
+      if (alpha * (log(alpha / (b + w)) + v) - 1.3862944 >= log(z)) { break; }
+    }
+  }
+  return (a == aa) ? w / (b + w) : b / (b + w);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PhiloxRandom::genrand_norm(double m, double s)
+{
+  const double p0 = 0.322232431088;
+  const double q0 = 0.099348462606;
+  const double p1 = 1.0;
+  const double q1 = 0.588581570495;
+  const double p2 = 0.342242088547;
+  const double q2 = 0.531103462366;
+  const double p3 = 0.204231210245e-1;
+  const double q3 = 0.103537752850;
+  const double p4 = 0.453642210148e-4;
+  const double q4 = 0.385607006340e-2;
+  double u, t, p, q, z;
+
+  u = genrand_res53();
+  if (u < 0.5)
+  { t = sqrt(-2.0 * log(u)); }
+  else
+  { t = sqrt(-2.0 * log(1.0 - u)); }
+  p   = p0 + t * (p1 + t * (p2 + t * (p3 + t * p4)));
+  q   = q0 + t * (q1 + t * (q2 + t * (q3 + t * q4)));
+  if (u < 0.5)
+  { z = (p / q) - t; }
+  else
+  { z = t - (p / q); }
+  return (m + s * z);
+}
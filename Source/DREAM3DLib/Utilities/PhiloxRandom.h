@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef PHILOXRANDOM_H_
+#define PHILOXRANDOM_H_
+
+#include "MXA/MXA.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+
+/**
+ * @class PhiloxRandom PhiloxRandom.h DREAM3DLib/Utilities/PhiloxRandom.h
+ * @brief Counter based random number generator using the Philox4x32-10 function of
+ * Salmon et al. "Parallel Random Numbers: As Easy as 1, 2, 3" (SC11).
+ *
+ * Every output is a pure function of (seed, stream, position), so a generator can
+ * jump to any position in O(1) and any number of independent streams can be made
+ * from a single seed. A parallel loop can give each task its own stream (or seek a
+ * shared stream to an offset derived from the loop index) and produce the same
+ * numbers no matter how the work is split between threads.
+ *
+ * The generator is a small value type. Copies are independent and may be used by
+ * different threads; a single instance must only be used by one thread at a time.
+ * The genrand_* methods mirror DREAM3DRandom so code can switch between the two.
+ * @version 1.0
+ */
+class DREAM3DLib_EXPORT PhiloxRandom
+{
+  public:
+    PhiloxRandom();
+    PhiloxRandom(uint64_t seed, uint64_t stream = 0);
+
+    /**
+     * @brief Resets the generator to the start of the given stream of the given seed.
+     */
+    void init_genrand(uint64_t seed, uint64_t stream = 0);
+
+    /**
+     * @brief Returns a generator for another stream of the same seed, positioned at
+     * its start. Streams with different ids never overlap.
+     */
+    PhiloxRandom createStream(uint64_t stream) const;
+
+    uint64_t getSeed() const;
+    uint64_t getStream() const { return m_Stream; }
+
+    /**
+     * @brief The number of 32 bit values drawn from the stream so far. Each
+     * genrand_res53() call draws 2 values, all other uniform methods draw 1.
+     */
+    uint64_t getPosition() const { return m_Position; }
+
+    /**
+     * @brief Moves the generator to an absolute position in its stream.
+     */
+    void seek(uint64_t position) { m_Position = position; }
+
+    /**
+     * @brief Skips the next n 32 bit values. This is O(1).
+     */
+    void discard(uint64_t n) { m_Position += n; }
+
+    /* generates a random number on [0,0xffffffff]-interval */
+    uint32_t genrand_int32()
+    {
+      uint64_t block = m_Position >> 2;
+      if (block != m_BufferBlock) { generateBlock(block); }
+      return m_Buffer[m_Position++ & 3];
+    }
+
+    /* generates a random number on [0,1]-real-interval */
+    double genrand_real1() { return genrand_int32() * (1.0 / 4294967295.0); }
+
+    /* generates a random number on [0,1)-real-interval */
+    double genrand_real2() { return genrand_int32() * (1.0 / 4294967296.0); }
+
+    /* generates a random number on (0,1)-real-interval */
+    double genrand_real3() { return (static_cast<double>(genrand_int32()) + 0.5) * (1.0 / 4294967296.0); }
+
+    /* generates a random number on [0,1) with 53-bit resolution*/
+    double genrand_res53()
+    {
+      uint32_t a = genrand_int32() >> 5;
+      uint32_t b = genrand_int32() >> 6;
+      return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Beta distributed value using Cheng's BB and BC algorithms. Unlike
+     * DREAM3DRandom::genrand_beta this keeps no static state.
+     */
+    double genrand_beta(double a, double b);
+
+    /**
+     * @brief Normally distributed value with mean 'm' and standard deviation 's'.
+     */
+    double genrand_norm(double m, double s);
+
+    /**
+     * @brief The Philox4x32-10 bijection. Exposed so the known answer tests can
+     * check it directly.
+     */
+    static void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+  private:
+    uint32_t m_Key[2];
+    uint64_t m_Stream;
+    uint64_t m_Position;
+    uint64_t m_BufferBlock;
+    uint32_t m_Buffer[4];
+
+    void generateBlock(uint64_t block);
+};
+
+#endif /* PHILOXRANDOM_H_ */
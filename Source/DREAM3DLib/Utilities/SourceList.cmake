@@ -15,6 +15,7 @@ set(DREAM3DLib_Utilities_HDRS
   ${DREAM3DLib_SOURCE_DIR}/Utilities/DREAM3DEndian.h
   ${DREAM3DLib_SOURCE_DIR}/Utilities/DREAM3DRandom.h
   ${DREAM3DLib_SOURCE_DIR}/Utilities/ImageUtilities.h
+  ${DREAM3DLib_SOURCE_DIR}/Utilities/PhiloxRandom.h
   ${DREAM3DLib_SOURCE_DIR}/Utilities/PoleFigureUtilities.h
   ${DREAM3DLib_SOURCE_DIR}/Utilities/TimeUtilities.h
 
@@ -26,6 +27,7 @@ set(DREAM3DLib_Utilities_SRCS
   ${DREAM3DLib_SOURCE_DIR}/Utilities/ColorUtilities.cpp
   ${DREAM3DLib_SOURCE_DIR}/Utilities/DREAM3DRandom.cpp
   ${DREAM3DLib_SOURCE_DIR}/Utilities/ImageUtilities.cpp
+  ${DREAM3DLib_SOURCE_DIR}/Utilities/PhiloxRandom.cpp
   ${DREAM3DLib_SOURCE_DIR}/Utilities/PoleFigureUtilities.cpp
 
 )
@@ -42,6 +42,7 @@
 
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdReader.h"
 
 /**
  * @class EbsdImporter EbsdImporter.h EbsdLib/EbsdImporter.h
@@ -86,13 +87,36 @@ class EbsdLib_EXPORT EbsdImporter
 
 
     /**
-     * @brief Imports the EBSD file. This is a pure virtual method to force subclasses
-     * to implement this method.
+     * @brief Imports the EBSD file by parsing it with parseFile() and then writing
+     * the parsed data with writeParsedFile().
      * @param fildId HDF5 fileId of an open HDF5 file that the data will be stored into
      * @param index The integer index value of this EBSD data file
      * @param ebsdFile The raw data file from the manufacturere (.ang, .ctf)
      */
-    virtual int importFile(hid_t fileId, int64_t index, const std::string &ebsd) = 0;
+    virtual int importFile(hid_t fileId, int64_t index, const std::string &ebsd)
+    {
+      return writeParsedFile(fileId, index, ebsd, parseFile(ebsd));
+    }
+
+    /**
+     * @brief Reads the raw EBSD file into memory. Implementations must not touch
+     * any state of the importer or the HDF5 library so that several files can be
+     * parsed concurrently while another thread is writing. The value returned
+     * from the reader's readFile() method is stored as the reader's error code.
+     * @param ebsdFile The raw data file from the manufacturere (.ang, .ctf)
+     * @return The reader holding the parsed data
+     */
+    virtual EbsdReader::Pointer parseFile(const std::string &ebsdFile) = 0;
+
+    /**
+     * @brief Writes a file that was read with parseFile() into the HDF5 file. Any
+     * error encountered while parsing is reported from here.
+     * @param fildId HDF5 fileId of an open HDF5 file that the data will be stored into
+     * @param index The integer index value of this EBSD data file
+     * @param ebsdFile The raw data file from the manufacturere (.ang, .ctf)
+     * @param reader The reader returned from parseFile()
+     */
+    virtual int writeParsedFile(hid_t fileId, int64_t index, const std::string &ebsdFile, EbsdReader::Pointer reader) = 0;
 
     /**
      * @brief Returns the dimensions for the EBSD Data set
@@ -60,6 +60,7 @@ class EbsdLib_EXPORT EbsdReader
 {
   public:
     EbsdReader();
+    EBSD_SHARED_POINTERS(EbsdReader)
     EBSD_TYPE_MACRO(EbsdReader)
 
     virtual ~EbsdReader();
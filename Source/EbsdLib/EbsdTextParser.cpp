@@ -0,0 +1,315 @@
+/* ============================================================================
+ * Copyright (c) 2011 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2011 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "EbsdTextParser.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits>
+
+namespace Detail
+{
+  static const double Pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  /* Mantissas with more digits than this are handed to strtod */
+  static const int MaxMantissaDigits = 19;
+
+  /**
+   * @brief Rounds the double to a float the way strtof would have. The double
+   * was computed with a single correctly rounded operation so it is within half
+   * an ulp of the true value; that is only a problem if it also lands on (or right
+   * next to) the halfway point between two floats, in which case we return false
+   * so the caller can fall back to the C library.
+   */
+  static inline bool roundToFloat(double d, float &value)
+  {
+    if (d != 0.0 && (d < std::numeric_limits<float>::min() && d > -std::numeric_limits<float>::min()))
+    {
+      return false; // denormal float result
+    }
+    uint64_t bits;
+    ::memcpy(&bits, &d, sizeof(bits));
+    uint64_t dropped = bits & 0x1FFFFFFFULL; // The 29 mantissa bits a float does not have
+    if (dropped >= 0x0FFFFFFFULL && dropped <= 0x10000001ULL)
+    {
+      return false;
+    }
+    value = static_cast<float>(d);
+    return true;
+  }
+
+#if defined (_MSC_VER) && _MSC_VER < 1800
+  // No strtof before Visual Studio 2013
+  static inline float toFloat(const char* str, char** end) { return static_cast<float>(::strtod(str, end)); }
+#else
+  static inline float toFloat(const char* str, char** end) { return ::strtof(str, end); }
+#endif
+
+  /**
+   * @brief Slow path for anything the hand written parser does not handle
+   * (very long mantissas, large exponents, nan, inf).
+   */
+  static bool parseFloatWithStrtod(char* tokenStart, char* &ptr, float &value, bool commaIsDecimal)
+  {
+    char* end = tokenStart;
+    float f = 0.0f;
+    if (commaIsDecimal == true)
+    {
+      // Copy the token so the ',' can be swapped without touching the line
+      char tmp[128];
+      size_t i = 0;
+      while (i < 127 && tokenStart[i] != 0 && tokenStart[i] != '\t' && tokenStart[i] != ' ')
+      {
+        tmp[i] = (tokenStart[i] == ',') ? '.' : tokenStart[i];
+        ++i;
+      }
+      tmp[i] = 0;
+      char* tmpEnd = tmp;
+      f = toFloat(tmp, &tmpEnd);
+      end = tokenStart + (tmpEnd - tmp);
+    }
+    else
+    {
+      f = toFloat(tokenStart, &end);
+    }
+    if (end == tokenStart) { return false; }
+    value = f;
+    ptr = end;
+    return true;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::EbsdTextParser(std::istream &in, size_t blockSize) :
+m_Stream(in),
+m_Start(0),
+m_End(0),
+m_BytesRead(0)
+{
+  if (blockSize < 1024) { blockSize = 1024; }
+  // One extra byte so the last line of the buffer can always be NULL terminated
+  m_Buffer.resize(blockSize + 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextParser::~EbsdTextParser()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::fillBuffer()
+{
+  if (m_Stream.good() == false)
+  {
+    return false;
+  }
+  // Move the partial line that is left to the front of the buffer
+  size_t remaining = m_End - m_Start;
+  if (remaining > 0 && m_Start > 0)
+  {
+    ::memmove( &(m_Buffer.front()), &(m_Buffer[m_Start]), remaining);
+  }
+  m_Start = 0;
+  m_End = remaining;
+  // A single line is longer than the whole buffer so grow it
+  if (m_End == m_Buffer.size() - 1)
+  {
+    m_Buffer.resize(m_Buffer.size() * 2);
+  }
+  m_Stream.read( &(m_Buffer[m_End]), static_cast<std::streamsize>(m_Buffer.size() - 1 - m_End));
+  size_t count = static_cast<size_t>(m_Stream.gcount());
+  m_End += count;
+  m_BytesRead += count;
+  m_Buffer[m_End] = 0;
+  return count > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+char* EbsdTextParser::nextLine(size_t* length)
+{
+  char* newLine = NULL;
+  while (true)
+  {
+    if (m_Start < m_End)
+    {
+      newLine = static_cast<char*>(::memchr( &(m_Buffer[m_Start]), '\n', m_End - m_Start));
+      if (NULL != newLine) { break; }
+    }
+    if (fillBuffer() == false) { break; }
+  }
+
+  if (m_Start >= m_End)
+  {
+    return NULL; // Nothing left in the stream
+  }
+
+  char* line = &(m_Buffer[m_Start]);
+  size_t lineLength = 0;
+  if (NULL == newLine)
+  {
+    // Last line of the stream without a trailing line feed. The buffer is
+    // already NULL terminated at m_End
+    lineLength = m_End - m_Start;
+    m_Start = m_End;
+  }
+  else
+  {
+    lineLength = newLine - line;
+    *newLine = 0;
+    m_Start += lineLength + 1;
+  }
+  if (lineLength > 0 && line[lineLength - 1] == '\r')
+  {
+    --lineLength;
+    line[lineLength] = 0;
+  }
+  if (NULL != length) { *length = lineLength; }
+  return line;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextParser::parseFloat(char* &ptr, float &value, bool commaIsDecimal)
+{
+  char* p = ptr;
+  while (*p == ' ' || *p == '\t') { ++p; }
+  char* tokenStart = p;
+
+  bool negative = false;
+  if (*p == '-') { negative = true; ++p; }
+  else if (*p == '+') { ++p; }
+
+  uint64_t mantissa = 0;
+  int numDigits = 0; // Significant digits stored in the mantissa
+  int exponent = 0;
+  bool sawDigit = false;
+
+  // Integer part
+  while (*p >= '0' && *p <= '9')
+  {
+    sawDigit = true;
+    if (numDigits < Detail::MaxMantissaDigits)
+    {
+      mantissa = mantissa * 10 + (*p - '0');
+      if (mantissa > 0) { ++numDigits; }
+    }
+    else
+    {
+      ++exponent;
+    }
+    ++p;
+  }
+  // Fraction part
+  if (*p == '.' || (commaIsDecimal == true && *p == ','))
+  {
+    char* afterPoint = p + 1;
+    if (sawDigit == true || (*afterPoint >= '0' && *afterPoint <= '9'))
+    {
+      p = afterPoint;
+      while (*p >= '0' && *p <= '9')
+      {
+        sawDigit = true;
+        if (numDigits < Detail::MaxMantissaDigits)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+          if (mantissa > 0) { ++numDigits; }
+          --exponent;
+        }
+        ++p;
+      }
+    }
+  }
+  if (sawDigit == false)
+  {
+    // Could be "nan" or "inf" or nothing at all
+    return Detail::parseFloatWithStrtod(tokenStart, ptr, value, commaIsDecimal);
+  }
+  if (numDigits >= Detail::MaxMantissaDigits)
+  {
+    return Detail::parseFloatWithStrtod(tokenStart, ptr, value, commaIsDecimal);
+  }
+  // Exponent part. Only consumed if at least one digit follows
+  if (*p == 'e' || *p == 'E')
+  {
+    char* e = p + 1;
+    bool expNegative = false;
+    if (*e == '-') { expNegative = true; ++e; }
+    else if (*e == '+') { ++e; }
+    if (*e >= '0' && *e <= '9')
+    {
+      int expValue = 0;
+      while (*e >= '0' && *e <= '9')
+      {
+        if (expValue < 10000) { expValue = expValue * 10 + (*e - '0'); }
+        ++e;
+      }
+      exponent += expNegative ? -expValue : expValue;
+      p = e;
+    }
+  }
+
+  double d = static_cast<double>(mantissa);
+  if (mantissa != 0)
+  {
+    if (mantissa > (1ULL << 53) || exponent > 22 || exponent < -22)
+    {
+      return Detail::parseFloatWithStrtod(tokenStart, ptr, value, commaIsDecimal);
+    }
+    if (exponent < 0) { d = d / Detail::Pow10[-exponent]; }
+    else if (exponent > 0) { d = d * Detail::Pow10[exponent]; }
+  }
+  if (negative == true) { d = -d; }
+
+  float f = 0.0f;
+  if (Detail::roundToFloat(d, f) == false)
+  {
+    return Detail::parseFloatWithStrtod(tokenStart, ptr, value, commaIsDecimal);
+  }
+  value = f;
+  ptr = p;
+  return true;
+}
@@ -0,0 +1,155 @@
+/* ============================================================================
+ * Copyright (c) 2011 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2011 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#ifndef EBSDTEXTPARSER_H_
+#define EBSDTEXTPARSER_H_
+
+#include <istream>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdSetGetMacros.h"
+
+/**
+ * @class EbsdTextParser EbsdTextParser.h EbsdLib/EbsdTextParser.h
+ * @brief Reads the data section of a text based EBSD file (.ang, .ctf, .mic)
+ * in large blocks and hands back each line in place, without any per line
+ * allocations. The static parseFloat/parseInt methods convert a single
+ * column and advance the cursor so a reader can write each value straight
+ * into its column arrays instead of going through sscanf.
+ *
+ * The parsers accept the same input that the "%f" and "%d" sscanf conversions
+ * accept for the numbers found in EBSD files and produce bit identical values.
+ * @version 1.0
+ */
+class EbsdLib_EXPORT EbsdTextParser
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param in The stream to read from. Reading starts at the current position
+     * of the stream so any header may already have been consumed.
+     * @param blockSize The number of bytes to read from the stream at a time.
+     */
+    EbsdTextParser(std::istream &in, size_t blockSize = 4 * 1024 * 1024);
+    virtual ~EbsdTextParser();
+
+    /**
+     * @brief Returns the next line of the stream. The returned pointer points
+     * into the internal buffer, the line ending (\n or \r\n) is replaced with a
+     * NULL character and the pointer is valid until the next call to nextLine().
+     * @param length If not NULL, receives the number of characters in the line
+     * @return NULL if the end of the stream has been reached.
+     */
+    char* nextLine(size_t* length = NULL);
+
+    /**
+     * @brief Returns the total number of bytes consumed from the stream so far.
+     */
+    size_t getBytesRead() { return m_BytesRead; }
+
+    /**
+     * @brief Parses a floating point value starting at 'ptr', skipping any
+     * leading spaces or tabs, so it is meant for whitespace delimited columns.
+     * Check isEmptyField() first when a delimiter separates fields that may be
+     * empty. On success 'ptr' is advanced past the number.
+     * @param ptr The current cursor. Must point into a NULL terminated string.
+     * @param value Receives the parsed value. Not modified on failure.
+     * @param commaIsDecimal Accept ',' as the decimal separator (European .ctf files)
+     * @return true if a number was parsed.
+     */
+    static bool parseFloat(char* &ptr, float &value, bool commaIsDecimal = false);
+
+    /**
+     * @brief Parses a base 10 integer starting at 'ptr', skipping any leading
+     * spaces or tabs. On success 'ptr' is advanced past the number.
+     * @return true if a number was parsed.
+     */
+    static inline bool parseInt(char* &ptr, int &value)
+    {
+      char* p = ptr;
+      while (*p == ' ' || *p == '\t') { ++p; }
+      bool negative = false;
+      if (*p == '-') { negative = true; ++p; }
+      else if (*p == '+') { ++p; }
+      if (*p < '0' || *p > '9') { return false; }
+      int v = 0;
+      while (*p >= '0' && *p <= '9')
+      {
+        v = v * 10 + (*p - '0');
+        ++p;
+      }
+      value = negative ? -v : v;
+      ptr = p;
+      return true;
+    }
+
+    /**
+     * @brief Returns true if the field at 'ptr' holds nothing but spaces before
+     * the delimiter or the end of the line. The number parsers skip tabs as
+     * whitespace, so an empty field in a tab delimited file would otherwise be
+     * read from the next column.
+     */
+    static inline bool isEmptyField(const char* ptr, char delimiter)
+    {
+      while (*ptr == ' ') { ++ptr; }
+      return (*ptr == 0 || *ptr == delimiter);
+    }
+
+    /**
+     * @brief Moves 'ptr' past the rest of the current column and the delimiter
+     * that ends it. Used for tab delimited files where a column may hold
+     * trailing characters that are not part of the number.
+     */
+    static inline void skipColumn(char* &ptr, char delimiter)
+    {
+      while (*ptr != 0 && *ptr != delimiter) { ++ptr; }
+      if (*ptr == delimiter) { ++ptr; }
+    }
+
+  private:
+    std::istream& m_Stream;
+    std::vector<char> m_Buffer;
+    size_t m_Start;
+    size_t m_End;
+    size_t m_BytesRead;
+
+    bool fillBuffer();
+
+    EbsdTextParser(const EbsdTextParser&); // Copy Constructor Not Implemented
+    void operator=(const EbsdTextParser&); // Operator '=' Not Implemented
+};
+
+#endif /* EBSDTEXTPARSER_H_ */
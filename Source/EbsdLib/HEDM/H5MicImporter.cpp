@@ -151,19 +151,37 @@ int H5MicImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int H5MicImporter::importFile(hid_t fileId, int64_t z, const std::string &MicFile)
+EbsdReader::Pointer H5MicImporter::parseFile(const std::string &MicFile)
+{
+  //  std::cout << "H5MicImporter: Importing " << MicFile << std::endl;
+  MicReader* reader = new MicReader;
+  EbsdReader::Pointer readerPtr(reader);
+  reader->setFileName(MicFile);
+
+  // Now actually read the file
+  reader->setErrorCode(reader->readFile());
+  return readerPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::writeParsedFile(hid_t fileId, int64_t z, const std::string &MicFile, EbsdReader::Pointer ebsdReader)
 {
   herr_t err = -1;
   setCancel(false);
   setErrorCondition(false);
   setPipelineMessage("");
 
-  //  std::cout << "H5MicImporter: Importing " << MicFile << std::endl;
-  MicReader reader;
-  reader.setFileName(MicFile);
-
-  // Now actually read the file
-  err = reader.readFile();
+  MicReader* readerPtr = dynamic_cast<MicReader*>(ebsdReader.get());
+  if (NULL == readerPtr)
+  {
+    setPipelineMessage("H5MicImporter Error: The data for '" + MicFile + "' was not read by a MicReader.");
+    setErrorCondition(-1);
+    return -1;
+  }
+  MicReader &reader = *readerPtr;
+  err = reader.getErrorCode();
 
   // Check for errors
   if (err < 0)
@@ -74,12 +74,21 @@ class EbsdLib_EXPORT H5MicImporter : public EbsdImporter
     virtual ~H5MicImporter();
 
     /**
-     * @brief Imports a specific file into the HDF5 file
+     * @brief Reads the .mic file into a new MicReader. Safe to call from several
+     * threads at once.
+     * @param MicFile The absolute path to the input .mic file
+     * @return The MicReader holding the data. Its error code is the value returned by readFile()
+     */
+    virtual EbsdReader::Pointer parseFile(const std::string &MicFile);
+
+    /**
+     * @brief Writes a file parsed with parseFile() into the HDF5 file
      * @param fileId The valid HDF5 file Id for an already open HDF5 file
      * @param index The slice index for the file
-     * @param MicFile The absolute path to the input .Mic file
+     * @param MicFile The absolute path to the input .mic file
+     * @param reader The MicReader returned from parseFile()
      */
-    int importFile(hid_t fileId, int64_t index, const std::string &MicFile);
+    virtual int writeParsedFile(hid_t fileId, int64_t index, const std::string &MicFile, EbsdReader::Pointer reader);
 
     /**
      * @brief Writes the phase data into the HDF5 file
@@ -47,6 +47,7 @@
 #include "MicConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 #ifdef _MSC_VER
 
@@ -414,28 +415,27 @@ int MicReader::readData(std::ifstream &in, char* buf, size_t bufSize)
     return -1;
   }
 
-  ::memset(buf, 0, bufSize); // Clear the buffer
-  in.getline(buf, kBufferSize);// Read the next line of data
-  fieldsRead = sscanf(buf, "%f", &origEdgeLength);
+  EbsdTextParser parser(in);
+  char* line = parser.nextLine();// Read the next line of data
+  if (NULL == line) { return -1; }
+  fieldsRead = EbsdTextParser::parseFloat(line, origEdgeLength) ? 1 : 0;
   if(fieldsRead != 1) {}
-  ::memset(buf, 0, bufSize); // Clear the buffer
-  in.getline(buf, kBufferSize);// Read the next line of data
-  this->parseDataLine(buf, 0);
+  line = parser.nextLine();// Read the next line of data
+  if (NULL == line) { return -1; }
+  this->parseDataLine(line, 0);
   int level = m_Level[0];
   float newEdgeLength = origEdgeLength/powf(2.0,float(level));
   totalPossibleDataRows = static_cast<size_t>(6.0f*powf(4.0f,float(level)));
   initPointers(totalPossibleDataRows);
-  this->parseDataLine(buf, 0);
-  ::memset(buf, 0, bufSize); // Clear the buffer
-  in.getline(buf, kBufferSize);// Read the next line of data
+  this->parseDataLine(line, 0);
+  line = parser.nextLine();// Read the next line of data
   ++counter;
   for(size_t i = 1; i < totalPossibleDataRows; ++i)
   {
-    this->parseDataLine(buf, i);
-    ::memset(buf, 0, bufSize); // Clear the buffer
-    in.getline(buf, kBufferSize);// Read the next line of data
+    if (NULL == line) break;
+    this->parseDataLine(line, i);
+    line = parser.nextLine();// Read the next line of data
     ++counter;
-    if (in.eof() == true) break;
   }
   totalDataRows = counter;
 
@@ -616,7 +616,7 @@ void MicReader::parseHeaderLine(char* buf, size_t length)
 // -----------------------------------------------------------------------------
 //  Read the data part of the Mic file
 // -----------------------------------------------------------------------------
-void MicReader::parseDataLine(const std::string &line, size_t i)
+void MicReader::parseDataLine(char* line, size_t i)
 {
   /* When reading the data there should be at least 8 cols of data. There may even
    * be 10 columns of data. The column names should be the following:
@@ -638,7 +638,15 @@ void MicReader::parseDataLine(const std::string &line, size_t i)
   int up = 0, level = 0, good = 0;
   size_t offset = 0;
   size_t fieldsRead = 0;
-  fieldsRead = sscanf(line.c_str(), "%f %f %f %d %d %d %f %f %f %f", &x, &y,&z, &up, &level, &good, &p1, &p, &p2, &conf);
+  // Same semantics as sscanf(line, "%f %f %f %d %d %d %f %f %f %f", ...)
+  float* floatColumns[10] = { &x, &y, &z, NULL, NULL, NULL, &p1, &p, &p2, &conf };
+  int* intColumns[10] = { NULL, NULL, NULL, &up, &level, &good, NULL, NULL, NULL, NULL };
+  char* ptr = line;
+  for (fieldsRead = 0; fieldsRead < 10; ++fieldsRead)
+  {
+    bool ok = (NULL != intColumns[fieldsRead]) ? EbsdTextParser::parseInt(ptr, *(intColumns[fieldsRead])) : EbsdTextParser::parseFloat(ptr, *(floatColumns[fieldsRead]));
+    if (ok == false) { break; }
+  }
     if(fieldsRead != 10) {}
   offset = i;
 
@@ -212,7 +212,7 @@ class EbsdLib_EXPORT MicReader : public EbsdReader
   /** @brief Parses the data from a line of data from the HEDM .Mic file
     * @param line The line of data to parse
     */
-    void parseDataLine(const std::string &line, size_t i);
+    void parseDataLine(char* line, size_t i);
 
     MicReader(const MicReader&);    // Copy Constructor Not Implemented
     void operator=(const MicReader&);  // Operator '=' Not Implemented
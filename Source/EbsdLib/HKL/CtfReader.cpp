@@ -47,6 +47,7 @@
 #include "CtfPhase.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 
 
@@ -359,13 +360,18 @@ int CtfReader::readData(std::ifstream &in)
 
   setNumberOfElements(totalDataRows);
 
-  char buf[kBufferSize];
-  ::memset(buf, 0, kBufferSize);
-  in.getline(buf, kBufferSize);
-  // over write the newline at the end of the line with a NULL character
-  uint32_t idx = 0;
-  while (idx < kBufferSize && buf[idx] != 0 ) { ++idx; }
-  if(buf[idx - 1] < 32) { buf[idx - 1] = 0; }
+  // Everything after the header is read in large blocks
+  EbsdTextParser parser(in);
+  size_t length = 0;
+  char* buf = parser.nextLine(&length);
+  if (NULL == buf)
+  {
+    setErrorMessage("Premature End Of File reached while looking for the column headers.");
+    setErrorCode(-105);
+    return -105;
+  }
+  // over write any trailing control character with a NULL character
+  if(length > 0 && buf[length - 1] < 32) { buf[length - 1] = 0; }
 
   std::vector<std::string> tokens = tokenize(buf, '\t');
 
@@ -408,32 +414,27 @@ int CtfReader::readData(std::ifstream &in)
   }
 
   size_t counter = 0;
-  for (int slice = zStart; slice < zEnd; ++slice)
+  bool endOfFile = false;
+  for (int slice = zStart; slice < zEnd && endOfFile == false; ++slice)
   {
-    for (size_t row = 0; row < yCells; ++row)
+    for (size_t row = 0; row < yCells && endOfFile == false; ++row)
     {
       for (size_t col = 0; col < xCells; ++col)
       {
-        ::memset(buf, 0, kBufferSize);
-        in.getline(buf, kBufferSize);
+        buf = parser.nextLine();
+        if(NULL == buf)
+        {
+          endOfFile = true;
+          break;
+        }
 
         if ( (m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead) )
         {
-          idx = 0;
-          while (buf[idx] != 0 && idx < kBufferSize) { ++idx; }
-          if(buf[idx - 1] < 32) { buf[idx - 1] = 0; }
-          if(in.eof() == true) {
-            break;
-          }
           parseDataLine(buf, row, col, counter, xCells, yCells);
           ++counter;
         }
 
       }
-      if(in.eof() == true)
-      {
-        break;
-      }
     }
  //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
     if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
@@ -442,7 +443,7 @@ int CtfReader::readData(std::ifstream &in)
     }
   }
 
-  if(counter != getNumberOfElements() && in.eof() == true)
+  if(counter != getNumberOfElements() && endOfFile == true)
   {
     ss.str("");
     ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter
@@ -555,31 +556,18 @@ int CtfReader::parseHeaderLines(std::vector<std::vector<std::string> > &headerLi
 // -----------------------------------------------------------------------------
 //  Read the data part of the .ctf file
 // -----------------------------------------------------------------------------
-void CtfReader::parseDataLine(const std::string &line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells )
+void CtfReader::parseDataLine(char* line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells )
 {
-  /* When reading the data there should be at least 11 cols of data.
+  /* When reading the data there should be at least 11 cols of data. The
+   * columns are tab delimited and European style files use a ',' as the decimal
+   * separator which the parsers handle directly.
    */
-//  float x, y,  p1, p, p2, mad;
-//  int phase, bCount, error, bc, bs;
-//  size_t offset = i;
-
-  // Filter the line to convert European command style decimals to US/UK style points
-  std::vector<char> cLine(line.size()+1);
-  ::memcpy( &(cLine.front()), line.c_str(), line.size() + 1);
-  for (size_t c = 0; c < cLine.size(); ++c)
-  {
-    if(cLine[c] == ',')
-    {
-      cLine[c] = '.';
-    }
-  }
-
-  std::vector<std::string> tokens = tokenize( &(cLine.front()), '\t');
-  BOOST_ASSERT(tokens.size() == m_DataParsers.size());
-
-  for (unsigned int i = 0; i < m_DataParsers.size(); ++i)
+  char* ptr = line;
+  size_t numParsers = m_DataParsers.size();
+  for (size_t i = 0; i < numParsers; ++i)
   {
-    m_DataParsers[i]->parse(tokens[i], offset);
+    m_DataParsers[i]->parse(ptr, offset);
+    EbsdTextParser::skipColumn(ptr, '\t');
   }
 
 }
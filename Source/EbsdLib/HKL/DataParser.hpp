@@ -33,6 +33,7 @@
 #include <string>
 
 #include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 class DataParser
 {
@@ -42,7 +43,14 @@ class DataParser
 
     virtual ~DataParser() {}
 
-    virtual void parse(const std::string &token, size_t offset)=0;
+    /**
+     * @brief Parses the tab delimited field at the cursor into the array at
+     * 'offset' and moves the cursor past the value. An empty field, or one that
+     * does not hold a number, stores 0 and leaves the cursor in place.
+     * @param ptr The cursor into the current NULL terminated line of data
+     * @param offset The index into the array
+     */
+    virtual void parse(char* &ptr, size_t offset)=0;
   protected:
     DataParser(){}
 
@@ -71,10 +79,13 @@ class Int32Parser : public DataParser
     EBSD_INSTANCE_PROPERTY(size_t, Size)
     EBSD_INSTANCE_STRING_PROPERTY(ColumnName)
 
-    virtual void parse(const std::string &token, size_t offset)
+    virtual void parse(char* &ptr, size_t offset)
     {
-      int value;
-      sscanf( token.c_str(), "%d", &value);
+      int value = 0;
+      if (EbsdTextParser::isEmptyField(ptr, '\t') == false)
+      {
+        EbsdTextParser::parseInt(ptr, value);
+      }
       m_Ptr[offset] = value;
     }
   protected:
@@ -113,10 +124,14 @@ class FloatParser : public DataParser
     EBSD_INSTANCE_PROPERTY(size_t, Size)
     EBSD_INSTANCE_STRING_PROPERTY(ColumnName)
 
-    virtual void parse(const std::string &token, size_t offset)
+    virtual void parse(char* &ptr, size_t offset)
     {
-      float value;
-      sscanf( token.c_str(), "%f", &value);
+      float value = 0.0f;
+      // European .ctf files use ',' as the decimal separator
+      if (EbsdTextParser::isEmptyField(ptr, '\t') == false)
+      {
+        EbsdTextParser::parseFloat(ptr, value, true);
+      }
       m_Ptr[offset] = value;
       //printf("%s: %f\n", m_ColumnName.c_str(), value);
     }
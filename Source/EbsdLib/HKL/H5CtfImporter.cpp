@@ -152,19 +152,37 @@ int H5CtfImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int H5CtfImporter::importFile(hid_t fileId, int64_t z, const std::string &ctfFile)
+EbsdReader::Pointer H5CtfImporter::parseFile(const std::string &ctfFile)
+{
+//  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
+  CtfReader* reader = new CtfReader;
+  EbsdReader::Pointer readerPtr(reader);
+  reader->setFileName(ctfFile);
+
+  // Now actually read the file
+  reader->setErrorCode(reader->readFile());
+  return readerPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeParsedFile(hid_t fileId, int64_t z, const std::string &ctfFile, EbsdReader::Pointer ebsdReader)
 {
   herr_t err = -1;
   setCancel(false);
   setErrorCondition(0);
   setPipelineMessage("");
 
-//  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
-  CtfReader reader;
-  reader.setFileName(ctfFile);
-
-  // Now actually read the file
-  err = reader.readFile();
+  CtfReader* readerPtr = dynamic_cast<CtfReader*>(ebsdReader.get());
+  if (NULL == readerPtr)
+  {
+    setPipelineMessage("H5CtfImporter Error: The data for '" + ctfFile + "' was not read by a CtfReader.");
+    setErrorCondition(-1);
+    return -1;
+  }
+  CtfReader &reader = *readerPtr;
+  err = reader.getErrorCode();
 
   // Check for errors
   if (err < 0)
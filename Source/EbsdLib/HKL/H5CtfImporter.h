@@ -70,12 +70,21 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
     virtual ~H5CtfImporter();
 
     /**
-     * @brief Imports a specific file into the HDF5 file
+     * @brief Reads the .ctf file into a new CtfReader. Safe to call from several
+     * threads at once.
+     * @param ctfFile The absolute path to the input .ctf file
+     * @return The CtfReader holding the data. Its error code is the value returned by readFile()
+     */
+    virtual EbsdReader::Pointer parseFile(const std::string &ctfFile);
+
+    /**
+     * @brief Writes a file parsed with parseFile() into the HDF5 file
      * @param fileId The valid HDF5 file Id for an already open HDF5 file
      * @param index The slice index for the file
-     * @param angFile The absolute path to the input .ang file
+     * @param ctfFile The absolute path to the input .ctf file
+     * @param reader The CtfReader returned from parseFile()
      */
-    int importFile(hid_t fileId, int64_t index, const std::string &angFile);
+    virtual int writeParsedFile(hid_t fileId, int64_t index, const std::string &ctfFile, EbsdReader::Pointer reader);
 
     /**
      * @brief Writes the phase data into the HDF5 file
@@ -47,6 +47,7 @@
 #include "AngConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 
 
@@ -375,9 +376,13 @@ void AngReader::readData(std::ifstream &in, char* buf, size_t bufSize)
   int nxOdd = 0;
   int nxEven = 0;
 
+  // The header parsing loop has already consumed the first line of data into
+  // 'buf'. Everything after it is read in large blocks.
+  EbsdTextParser parser(in);
+  char* line = buf;
   for(size_t i = 0; i < totalDataPoints; ++i)
   {
-    this->parseDataLine(buf, i);
+    this->parseDataLine(line, i);
 
     if (fabs(m_Y[i]-oldY)>1e-6)
     {
@@ -393,10 +398,9 @@ void AngReader::readData(std::ifstream &in, char* buf, size_t bufSize)
     if (yChange == 0) ++nxOdd;
     if (yChange == 1) ++nxEven;
 
-    ::memset(buf, 0, bufSize); // Clear the buffer
-    in.getline(buf, kBufferSize);// Read the next line of data
     ++counter;
-    if (in.eof() == true)
+    line = parser.nextLine(); // Read the next line of data
+    if (NULL == line)
     {
       break;
     }
@@ -418,7 +422,7 @@ void AngReader::readData(std::ifstream &in, char* buf, size_t bufSize)
     this->deallocateArrayData<float > (m_SEMSignal);
   }
 
-  if (counter != totalDataPoints && in.eof() == true)
+  if (counter != totalDataPoints && NULL == line)
   {
     ss.str("");
 
@@ -551,7 +555,7 @@ void AngReader::parseHeaderLine(char* buf, size_t length)
 // -----------------------------------------------------------------------------
 //  Read the data part of the ANG file
 // -----------------------------------------------------------------------------
-void AngReader::parseDataLine(const std::string &line, size_t i)
+void AngReader::parseDataLine(char* line, size_t i)
 {
   /* When reading the data there should be at least 8 cols of data. There may even
    * be 10 columns of data. The column names should be the following:
@@ -573,7 +577,15 @@ void AngReader::parseDataLine(const std::string &line, size_t i)
   int ph = -1;
   size_t offset = 0;
   size_t fieldsRead = 0;
-  fieldsRead = sscanf(line.c_str(), "%f %f %f %f %f %f %f %d %f %f", &p1, &p,&p2, &x, &y, &iqual, &conf, &ph, &semSignal, &fit);
+  // Same semantics as sscanf(line, "%f %f %f %f %f %f %f %d %f %f", ...): stop
+  // at the first column that does not parse and keep the defaults after that
+  float* floatColumns[10] = { &p1, &p, &p2, &x, &y, &iqual, &conf, NULL, &semSignal, &fit };
+  char* ptr = line;
+  for (fieldsRead = 0; fieldsRead < 10; ++fieldsRead)
+  {
+    bool ok = (fieldsRead == 7) ? EbsdTextParser::parseInt(ptr, ph) : EbsdTextParser::parseFloat(ptr, *(floatColumns[fieldsRead]));
+    if (ok == false) { break; }
+  }
 
   offset = i;
 
@@ -152,19 +152,37 @@ int H5AngImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int H5AngImporter::importFile(hid_t fileId, int64_t z, const std::string &angFile)
+EbsdReader::Pointer H5AngImporter::parseFile(const std::string &angFile)
+{
+  //  std::cout << "H5AngImporter: Importing " << angFile << std::endl;
+  AngReader* reader = new AngReader;
+  EbsdReader::Pointer readerPtr(reader);
+  reader->setFileName(angFile);
+
+  // Now actually read the file
+  reader->setErrorCode(reader->readFile());
+  return readerPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeParsedFile(hid_t fileId, int64_t z, const std::string &angFile, EbsdReader::Pointer ebsdReader)
 {
   herr_t err = -1;
   setCancel(false);
   setErrorCondition(false);
   setPipelineMessage("");
 
-  //  std::cout << "H5AngImporter: Importing " << angFile << std::endl;
-  AngReader reader;
-  reader.setFileName(angFile);
-
-  // Now actually read the file
-  err = reader.readFile();
+  AngReader* readerPtr = dynamic_cast<AngReader*>(ebsdReader.get());
+  if (NULL == readerPtr)
+  {
+    setPipelineMessage("H5AngImporter Error: The data for '" + angFile + "' was not read by an AngReader.");
+    setErrorCondition(-1);
+    return -1;
+  }
+  AngReader &reader = *readerPtr;
+  err = reader.getErrorCode();
 
   // Check for errors
   if (err < 0)
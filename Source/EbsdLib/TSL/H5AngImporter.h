@@ -74,12 +74,21 @@ class EbsdLib_EXPORT H5AngImporter : public EbsdImporter
     virtual ~H5AngImporter();
 
     /**
-     * @brief Imports a specific file into the HDF5 file
+     * @brief Reads the .ang file into a new AngReader. Safe to call from several
+     * threads at once.
+     * @param angFile The absolute path to the input .ang file
+     * @return The AngReader holding the data. Its error code is the value returned by readFile()
+     */
+    virtual EbsdReader::Pointer parseFile(const std::string &angFile);
+
+    /**
+     * @brief Writes a file parsed with parseFile() into the HDF5 file
      * @param fileId The valid HDF5 file Id for an already open HDF5 file
      * @param index The slice index for the file
      * @param angFile The absolute path to the input .ang file
+     * @param reader The AngReader returned from parseFile()
      */
-    int importFile(hid_t fileId, int64_t index, const std::string &angFile);
+    virtual int writeParsedFile(hid_t fileId, int64_t index, const std::string &angFile, EbsdReader::Pointer reader);
 
     /**
      * @brief Writes the phase data into the HDF5 file
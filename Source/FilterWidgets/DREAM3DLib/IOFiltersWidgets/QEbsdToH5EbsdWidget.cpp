@@ -130,6 +130,8 @@ void QEbsdToH5EbsdWidget::getGuiParametersFromFilter(AbstractFilter* filt)
   m_EulerTransformationAxis = filter->getEulerTransformationAxis();
   setRefFrameZDir( filter->getRefFrameZDir() );
   setEbsdFileList( filter->getEbsdFileList() );
+  m_UseParallelImport->setChecked( filter->getUseParallelImport() );
+  m_ImportMemoryLimit->setValue( filter->getImportMemoryLimit() );
 }
 
 // -----------------------------------------------------------------------------
@@ -151,6 +153,8 @@ AbstractFilter::Pointer QEbsdToH5EbsdWidget::getFilter(bool defaultValues)
   filter->setSampleTransformationAxis(m_SampleTransformationAxis);
   filter->setEulerTransformationAngle(m_EulerTransformationAngle);
   filter->setEulerTransformationAxis(m_EulerTransformationAxis);
+  filter->setUseParallelImport(m_UseParallelImport->isChecked());
+  filter->setImportMemoryLimit(m_ImportMemoryLimit->value());
 
 
   filter->setRefFrameZDir( getRefFrameZDir() );
@@ -286,6 +290,8 @@ void QEbsdToH5EbsdWidget::readOptions(QSettings &prefs)
   READ_FILEPATH_SETTING(prefs, m_, OutputFile, "Untitled.h5ebsd");
   READ_CHECKBOX_SETTING(prefs, m_, StackLowToHigh, true)
   READ_CHECKBOX_SETTING(prefs, m_, StackHighToLow, false)
+  READ_CHECKBOX_SETTING(prefs, m_, UseParallelImport, false)
+  READ_SETTING(prefs, m_, ImportMemoryLimit, ok, i, 1024 , Int);
 
   READ_BOOL_SETTING(prefs, m_, TSLchecked, false)
   READ_BOOL_SETTING(prefs, m_, HKLchecked, false)
@@ -321,6 +327,8 @@ void QEbsdToH5EbsdWidget::writeOptions(QSettings &prefs)
   WRITE_STRING_SETTING(prefs, m_, OutputFile)
   WRITE_CHECKBOX_SETTING(prefs, m_, StackHighToLow)
   WRITE_CHECKBOX_SETTING(prefs, m_, StackLowToHigh)
+  WRITE_CHECKBOX_SETTING(prefs, m_, UseParallelImport)
+  WRITE_SETTING(prefs, m_, ImportMemoryLimit)
 
   WRITE_BOOL_SETTING(prefs, m_, TSLchecked, m_TSLchecked)
   WRITE_BOOL_SETTING(prefs, m_, HKLchecked, m_HKLchecked)
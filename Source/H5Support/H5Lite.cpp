@@ -225,6 +225,111 @@ bool H5Lite::datasetExists( hid_t loc_id, const std::string& dsetName )
   return (err < 0) ? false : true;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5Lite::computeChunkDims(int32_t rank, const hsize_t* dims, size_t typeSize,
+                              const ChunkedWriteOptions &options, hsize_t* chunkDims)
+{
+  if (options.ChunkDims.size() == static_cast<size_t>(rank))
+  {
+    for (int32_t i = 0; i < rank; ++i)
+    {
+      chunkDims[i] = options.ChunkDims[i];
+      if (chunkDims[i] < 1) { chunkDims[i] = 1; }
+      if (chunkDims[i] > dims[i]) { chunkDims[i] = dims[i]; }
+    }
+    return;
+  }
+
+  // Keep every dimension but the slowest one whole
+  hsize_t rowBytes = static_cast<hsize_t>(typeSize);
+  for (int32_t i = 1; i < rank; ++i)
+  {
+    chunkDims[i] = dims[i];
+    rowBytes = rowBytes * dims[i];
+  }
+  if (rowBytes < 1) { rowBytes = 1; }
+  hsize_t rows = static_cast<hsize_t>(options.TargetChunkBytes) / rowBytes;
+  hsize_t multiple = options.ChunkDim0Multiple;
+  if (multiple < 1) { multiple = 1; }
+  rows = (rows / multiple) * multiple;
+  if (rows < multiple) { rows = multiple; }
+  if (rows > dims[0]) { rows = dims[0]; }
+  if (rows < 1) { rows = 1; }
+  chunkDims[0] = rows;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Lite::createChunkedDatasetCreationPList(int32_t rank, const hsize_t* dims, size_t typeSize,
+                                                const ChunkedWriteOptions &options)
+{
+  std::vector<hsize_t> chunkDims(rank, 1);
+  computeChunkDims(rank, dims, typeSize, options, &(chunkDims.front()));
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if (dcpl < 0)
+  {
+    return dcpl;
+  }
+  herr_t err = H5Pset_chunk(dcpl, rank, &(chunkDims.front()));
+  if (err >= 0 && options.Shuffle == true)
+  {
+    err = H5Pset_shuffle(dcpl);
+  }
+  if (err >= 0 && options.DeflateLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    unsigned int level = static_cast<unsigned int>(options.DeflateLevel > 9 ? 9 : options.DeflateLevel);
+    err = H5Pset_deflate(dcpl, level);
+  }
+  if (err < 0)
+  {
+    std::cout << "Error setting up the chunked dataset creation properties" << std::endl;
+    H5Pclose(dcpl);
+    return err;
+  }
+  return dcpl;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Lite::createChunkCacheAccessPList(const ChunkedWriteOptions &options)
+{
+  if (options.ChunkCacheBytes == 0)
+  {
+    return H5P_DEFAULT;
+  }
+  hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+  if (dapl < 0)
+  {
+    return H5P_DEFAULT;
+  }
+  // A prime number of hash slots well above the number of chunks that fit in the cache
+  size_t slots = options.ChunkCacheSlots;
+  if (slots == 0) { slots = 12421; }
+  if (H5Pset_chunk_cache(dapl, slots, options.ChunkCacheBytes, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+  {
+    H5Pclose(dapl);
+    return H5P_DEFAULT;
+  }
+  return dapl;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+herr_t H5Lite::closeChunkCacheAccessPList(hid_t dapl)
+{
+  if (dapl == H5P_DEFAULT)
+  {
+    return 0;
+  }
+  return H5Pclose(dapl);
+}
+
 // -----------------------------------------------------------------------------
 //  We assume a null terminated string
 // -----------------------------------------------------------------------------
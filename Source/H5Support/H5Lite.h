@@ -93,6 +93,34 @@ namespace H5Support_NAMESPACE {
 class H5Lite
 {
 public:
+  /**
+   * @brief Dataset creation and access settings used by writePointerDatasetChunked.
+   * If ChunkDims is empty a chunk shape is computed that spans the full extent
+   * of every dimension except the slowest, which is cut down so that a chunk
+   * holds about TargetChunkBytes. ChunkDim0Multiple keeps that slowest chunk
+   * dimension a multiple of some row count (for example one XY slice of a
+   * volume). A DeflateLevel of 0 disables compression and a ChunkCacheBytes of
+   * 0 leaves the HDF5 default chunk cache in place.
+   */
+  struct ChunkedWriteOptions
+  {
+    ChunkedWriteOptions() :
+      DeflateLevel(0),
+      Shuffle(false),
+      TargetChunkBytes(1024 * 1024),
+      ChunkDim0Multiple(1),
+      ChunkCacheBytes(0),
+      ChunkCacheSlots(0)
+    {}
+    std::vector<hsize_t> ChunkDims;
+    int32_t DeflateLevel;
+    bool Shuffle;
+    size_t TargetChunkBytes;
+    hsize_t ChunkDim0Multiple;
+    size_t ChunkCacheBytes;
+    size_t ChunkCacheSlots;
+  };
+
   /**
    * @brief Turns off the global error handler/reporting objects. Note that once
    * they are turned off using this method they CAN NOT be turned back on. If you
@@ -452,6 +480,124 @@ static herr_t writePointerDataset (hid_t loc_id,
   return retErr;
 }
 
+/**
+ * @brief Computes the chunk dimensions for a dataset as described for
+ * ChunkedWriteOptions. Every chunk dimension is at least 1 and at most the
+ * matching dataset dimension.
+ * @param rank The number of dimensions
+ * @param dims The sizes of each dimension
+ * @param typeSize The size in bytes of a single element
+ * @param options The chunking options
+ * @param chunkDims [output] Receives rank chunk dimensions
+ */
+static H5Support_EXPORT void computeChunkDims(int32_t rank, const hsize_t* dims, size_t typeSize,
+                                              const ChunkedWriteOptions &options, hsize_t* chunkDims);
+
+/**
+ * @brief Creates a dataset creation property list with a chunked layout and the
+ * shuffle and deflate filters requested in the options. The deflate filter is
+ * silently skipped if the HDF5 library was built without it.
+ * @return The property list id which the caller must close, or a negative value on error
+ */
+static H5Support_EXPORT hid_t createChunkedDatasetCreationPList(int32_t rank, const hsize_t* dims, size_t typeSize,
+                                                                const ChunkedWriteOptions &options);
+
+/**
+ * @brief Creates a dataset access property list that sizes the chunk cache as
+ * requested in the options.
+ * @return H5P_DEFAULT if no cache size was requested, otherwise a property list
+ * id which the caller must close with closeChunkCacheAccessPList
+ */
+static H5Support_EXPORT hid_t createChunkCacheAccessPList(const ChunkedWriteOptions &options);
+
+/**
+ * @brief Closes a property list returned from createChunkCacheAccessPList
+ */
+static H5Support_EXPORT herr_t closeChunkCacheAccessPList(hid_t dapl);
+
+/**
+ * @brief Writes the data of a pointer to an HDF5 file using a chunked dataset
+ * layout so that the data can be compressed and partially read back.
+ * @param loc_id The hdf5 object id of the parent
+ * @param dsetName The name of the dataset to write to. This can be a name of Path
+ * @param rank The number of dimensions
+ * @param dims The sizes of each dimension
+ * @param data The data to be written.
+ * @param options The chunk shape, filter and chunk cache settings
+ * @return Standard hdf5 error condition.
+ */
+template <typename T>
+static herr_t writePointerDatasetChunked (hid_t loc_id,
+                            const std::string& dsetName,
+                            int32_t   rank,
+                            hsize_t* dims,
+                            T* data,
+                            const ChunkedWriteOptions &options)
+{
+  herr_t err    = -1;
+  hid_t did     = -1;
+  hid_t sid     = -1;
+  herr_t retErr = 0;
+
+  if(NULL == data) { return -2;}
+  hid_t dataType = H5Lite::HDFTypeForPrimitive(data[0]);
+  if(dataType == -1)
+  {
+    return -1;
+  }
+  // Chunked datasets can not have a zero sized dimension
+  for (int32_t i = 0; i < rank; ++i)
+  {
+    if (dims[i] == 0)
+    {
+      return writePointerDataset(loc_id, dsetName, rank, dims, data);
+    }
+  }
+
+  sid = H5Screate_simple( rank, dims, NULL);
+  if (sid < 0)
+  {
+    return sid;
+  }
+  hid_t dcpl = createChunkedDatasetCreationPList(rank, dims, sizeof(T), options);
+  if (dcpl < 0)
+  {
+    H5Sclose(sid);
+    return dcpl;
+  }
+  hid_t dapl = createChunkCacheAccessPList(options);
+  // Create the Dataset
+  did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, dapl);
+  if ( did >= 0 )
+  {
+    err = H5Dwrite( did, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data );
+    if (err < 0 ) {
+      std::cout << "Error Writing Chunked Data '" << dsetName << "'" << std::endl;
+      retErr = err;
+    }
+    err = H5Dclose( did );
+    if (err < 0) {
+      std::cout << "Error Closing Dataset." << std::endl;
+      retErr = err;
+    }
+  } else {
+    retErr = did;
+  }
+  closeChunkCacheAccessPList(dapl);
+  err = H5Pclose(dcpl);
+  if (err < 0) {
+    std::cout << "Error Closing Dataset Creation Property List" << std::endl;
+    retErr = err;
+  }
+  /* Terminate access to the data space. */
+  err= H5Sclose( sid );
+  if (err< 0) {
+    std::cout << "Error Closing Dataspace" << std::endl;
+    retErr = err;
+  }
+  return retErr;
+}
+
 template <typename T>
 static herr_t replacePointerDataset (hid_t loc_id,
                             const std::string& dsetName,
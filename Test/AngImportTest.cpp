@@ -142,6 +142,47 @@ void TestShortFile()
   DREAM3D_REQUIRED(err, <, 0)
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestParseAndWrite()
+{
+  EbsdImporter::Pointer importer = H5AngImporter::New();
+  std::string angFile = EbsdImportTest::FileDir + EbsdImportTest::TestFile1;
+
+  hid_t fileId = H5Utilities::createFile(EbsdImportTest::H5EbsdOutputFile);
+  DREAM3D_REQUIRE(fileId > 0)
+
+  // Slice 0 goes through importFile(), slice 1 is parsed first and written later
+  // which is how EbsdToH5Ebsd uses the importer when importing in parallel
+  int err = importer->importFile(fileId, 0, angFile);
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  EbsdReader::Pointer reader = importer->parseFile(angFile);
+  EbsdReader::Pointer badReader = importer->parseFile(EbsdImportTest::ShortFile);
+  DREAM3D_REQUIRED(reader->getErrorCode(), >=, 0)
+  DREAM3D_REQUIRED(badReader->getErrorCode(), <, 0)
+
+  err = importer->writeParsedFile(fileId, 1, angFile, reader);
+  DREAM3D_REQUIRED(err, >=, 0)
+
+  // Errors from parsing are reported when the slice is written
+  err = importer->writeParsedFile(fileId, 2, EbsdImportTest::ShortFile, badReader);
+  DREAM3D_REQUIRED(err, <, 0)
+  DREAM3D_REQUIRE_EQUAL(importer->getErrorCondition(), badReader->getErrorCode())
+
+  std::vector<float> slice0;
+  std::vector<float> slice1;
+  err = H5Lite::readVectorDataset(fileId, "0/Data/" + Ebsd::Ang::Phi1, slice0);
+  DREAM3D_REQUIRED(err, >=, 0)
+  err = H5Lite::readVectorDataset(fileId, "1/Data/" + Ebsd::Ang::Phi1, slice1);
+  DREAM3D_REQUIRED(err, >=, 0)
+  DREAM3D_REQUIRE_EQUAL(slice0.size(), slice1.size())
+  DREAM3D_REQUIRE(slice0 == slice1)
+
+  err = H5Utilities::closeFile(fileId);
+}
+
 // -----------------------------------------------------------------------------
 //  Use test framework
 // -----------------------------------------------------------------------------
@@ -154,6 +195,7 @@ int main(int argc, char **argv)
   DREAM3D_REGISTER_TEST( TestHexGrid() )
   DREAM3D_REGISTER_TEST( TestMissingGrid() )
   DREAM3D_REGISTER_TEST( TestShortFile() )
+  DREAM3D_REGISTER_TEST( TestParseAndWrite() )
 
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
 
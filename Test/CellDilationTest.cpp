@@ -0,0 +1,221 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <limits>
+#include <list>
+#include <vector>
+
+#include "MXA/Common/LogTime.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/CellDilationHelper.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const size_t k_Dim = 24;
+
+// -----------------------------------------------------------------------------
+// Builds a volume of slanted grains (GrainIds 1 to 9) with a random scalar in every
+// Cell. A fraction of the Cells get badId and a few get otherId.
+// -----------------------------------------------------------------------------
+static VoxelDataContainer::Pointer createBadDataVolume(unsigned long long int seed, float badFraction, int32_t badId, int32_t otherId)
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = { k_Dim, k_Dim, k_Dim };
+  m->setDimensions(dims);
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  FloatArrayType::Pointer values = FloatArrayType::CreateArray(totalPoints, "Values");
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    int32_t grain = static_cast<int32_t>(1 + (i / 7 + (i / k_Dim) / 3 + (i / (k_Dim * k_Dim)) / 5) % 9);
+    float random = static_cast<float>(rg.genrand_res53());
+    if (random < badFraction) { grain = badId; }
+    else if (random < badFraction + 0.02f) { grain = otherId; }
+    grainIds->SetValue(i, grain);
+    values->SetValue(i, static_cast<float>(rg.genrand_res53()));
+  }
+  m->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+  m->addCellData("Values", values);
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+// The sweeps the filters used before the work queue. Every sweep finds a neighbor
+// for each Cell that changes using the GrainIds of the previous sweep, then copies.
+// -----------------------------------------------------------------------------
+static void sweep(VoxelDataContainer* m, bool dilation, int32_t badMin, int32_t badMax, int32_t goodMin, int maxSweeps)
+{
+  int32_t* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get())->GetPointer(0);
+  int64_t dims[3] = { k_Dim, k_Dim, k_Dim };
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int64_t neighpoints[6] = { -dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1] };
+  std::vector<int64_t> neighbors(totalPoints, -1);
+  std::list<std::string> names = m->getCellArrayNameList();
+  for (int s = 0; maxSweeps < 0 || s < maxSweeps; ++s)
+  {
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      int64_t x = i % dims[0], y = (i / dims[0]) % dims[1], z = i / (dims[0] * dims[1]);
+      int32_t grain = grainIds[i];
+      bool bad = (grain >= badMin && grain <= badMax);
+      bool good = (grain >= goodMin);
+      if ((dilation && !bad) || (!dilation && !good)) { continue; }
+      std::vector<int> counts(12, 0);
+      int most = 0;
+      for (int l = 0; l < 6; ++l)
+      {
+        if ((l == 0 && z == 0) || (l == 5 && z == dims[2] - 1) || (l == 1 && y == 0)
+            || (l == 4 && y == dims[1] - 1) || (l == 2 && x == 0) || (l == 3 && x == dims[0] - 1)) { continue; }
+        int32_t neighbor = grainIds[i + neighpoints[l]];
+        if (dilation && neighbor >= goodMin && ++counts[neighbor] > most)
+        {
+          most = counts[neighbor];
+          neighbors[i] = i + neighpoints[l];
+        }
+        if (!dilation && neighbor >= badMin && neighbor <= badMax) { neighbors[i] = i + neighpoints[l]; }
+      }
+    }
+    size_t changed = 0;
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      if (neighbors[i] < 0) { continue; }
+      for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+      {
+        m->getCellData(*iter)->CopyTuple(neighbors[i], i);
+      }
+      neighbors[i] = -1;
+      changed++;
+    }
+    if (changed == 0) { break; }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static void compareToSweeps(bool dilation, int32_t badMin, int32_t badMax, int32_t goodMin, int32_t badId, int32_t otherId, int layers)
+{
+  for (unsigned long long int seed = 1; seed < 5; ++seed)
+  {
+    float badFraction = 0.1f * seed;
+    VoxelDataContainer::Pointer expected = createBadDataVolume(seed, badFraction, badId, otherId);
+    VoxelDataContainer::Pointer actual = createBadDataVolume(seed, badFraction, badId, otherId);
+    sweep(expected.get(), dilation, badMin, badMax, goodMin, layers);
+
+    Int32ArrayType::Pointer grainIds = boost::dynamic_pointer_cast<Int32ArrayType>(actual->getCellData(DREAM3D::CellData::GrainIds));
+    CellDilationHelper helper(actual.get(), grainIds->GetPointer(0), badMin, badMax, goodMin);
+    size_t changed = (dilation == true) ? helper.dilate(layers) : helper.erode(layers);
+    DREAM3D_REQUIRE(changed > 0)
+
+    Int32ArrayType::Pointer expectedIds = boost::dynamic_pointer_cast<Int32ArrayType>(expected->getCellData(DREAM3D::CellData::GrainIds));
+    FloatArrayType::Pointer expectedValues = boost::dynamic_pointer_cast<FloatArrayType>(expected->getCellData("Values"));
+    FloatArrayType::Pointer values = boost::dynamic_pointer_cast<FloatArrayType>(actual->getCellData("Values"));
+    for (size_t i = 0; i < grainIds->GetSize(); ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL(expectedIds->GetValue(i), grainIds->GetValue(i))
+      DREAM3D_REQUIRE_EQUAL(expectedValues->GetValue(i), values->GetValue(i))
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// FillBadData: small defects (< 0) are filled from GrainIds > 0, large ones (0) stay
+// -----------------------------------------------------------------------------
+void TestFillBadData()
+{
+  compareToSweeps(true, std::numeric_limits<int32_t>::min(), -1, 1, -1, 0, -1);
+}
+
+// -----------------------------------------------------------------------------
+// MinSize and MinNeighbors: removed Cells (< 0) are filled from GrainIds >= 0
+// -----------------------------------------------------------------------------
+void TestMinSize()
+{
+  compareToSweeps(true, std::numeric_limits<int32_t>::min(), -1, 0, -1, 0, -1);
+}
+
+// -----------------------------------------------------------------------------
+// OpenCloseBadData: a fixed number of dilations or erosions of the bad data (0)
+// -----------------------------------------------------------------------------
+void TestOpenCloseBadData()
+{
+  for (int layers = 1; layers < 4; ++layers)
+  {
+    compareToSweeps(true, 0, 0, 1, 0, -1, layers);
+    compareToSweeps(false, 0, 0, 1, 0, -1, layers);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Bad Cells that no good Cell can reach are left alone instead of sweeping forever
+// -----------------------------------------------------------------------------
+void TestUnreachable()
+{
+  VoxelDataContainer::Pointer m = createBadDataVolume(7, 0.0f, -1, 0);
+  Int32ArrayType::Pointer grainIds = boost::dynamic_pointer_cast<Int32ArrayType>(m->getCellData(DREAM3D::CellData::GrainIds));
+  for (size_t i = 0; i < grainIds->GetSize(); ++i)
+  {
+    grainIds->SetValue(i, (i < k_Dim * k_Dim) ? 0 : -1);
+  }
+  CellDilationHelper helper(m.get(), grainIds->GetPointer(0), std::numeric_limits<int32_t>::min(), -1, 1);
+  DREAM3D_REQUIRE_EQUAL(helper.dilate(-1), 0)
+  DREAM3D_REQUIRE_EQUAL(grainIds->GetValue(grainIds->GetSize() - 1), -1)
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestFillBadData() )
+  DREAM3D_REGISTER_TEST( TestMinSize() )
+  DREAM3D_REGISTER_TEST( TestOpenCloseBadData() )
+  DREAM3D_REGISTER_TEST( TestUnreachable() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,160 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/CentroidGrid.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const size_t k_NumPoints = 2000;
+
+// -----------------------------------------------------------------------------
+// Random points in [-20, 80) on every axis, so some fall before the origin
+// -----------------------------------------------------------------------------
+std::vector<float> createPoints()
+{
+  unsigned long long int seed = 2468;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  std::vector<float> points(3 * k_NumPoints);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i] = static_cast<float>(rg.genrand_res53() * 100.0 - 20.0);
+  }
+  return points;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCellRange()
+{
+  std::vector<float> points = createPoints();
+  float origin[3] = { 0.0f, 0.0f, 0.0f };
+  float cellSize = 7.5f;
+  CentroidGrid grid;
+  grid.build(&(points.front()), 1, k_NumPoints, cellSize, origin);
+
+  std::vector<int> found;
+  int cell[3], other[3];
+  for (size_t i = 1; i < k_NumPoints; i += 7)
+  {
+    int reach = static_cast<int>(i % 4);
+    grid.getCell(&(points[3 * i]), cell);
+    found.clear();
+    grid.findInCellRange(cell, reach, found);
+    std::sort(found.begin(), found.end());
+
+    std::vector<int> expected;
+    for (size_t j = 1; j < k_NumPoints; ++j)
+    {
+      grid.getCell(&(points[3 * j]), other);
+      if (abs(other[0] - cell[0]) <= reach && abs(other[1] - cell[1]) <= reach && abs(other[2] - cell[2]) <= reach)
+      {
+        expected.push_back(static_cast<int>(j));
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(expected.size(), found.size())
+    for (size_t k = 0; k < expected.size(); ++k)
+    {
+      DREAM3D_REQUIRE_EQUAL(expected[k], found[k])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestRadius()
+{
+  std::vector<float> points = createPoints();
+  bool* skip = new bool[k_NumPoints];
+  for (size_t i = 0; i < k_NumPoints; ++i)
+  {
+    skip[i] = (i % 5 == 0);
+  }
+  float origin[3] = { -20.0f, -20.0f, -20.0f };
+  CentroidGrid grid;
+  grid.build(&(points.front()), 1, k_NumPoints, 4.0f, origin, skip);
+
+  std::vector<int> found;
+  for (size_t i = 1; i < k_NumPoints; i += 11)
+  {
+    float radius = static_cast<float>(i % 23);
+    found.clear();
+    grid.findInRadius(&(points[3 * i]), radius, found);
+    std::sort(found.begin(), found.end());
+
+    std::vector<int> expected;
+    for (size_t j = 1; j < k_NumPoints; ++j)
+    {
+      if (skip[j] == true) { continue; }
+      float dx = points[3 * j] - points[3 * i];
+      float dy = points[3 * j + 1] - points[3 * i + 1];
+      float dz = points[3 * j + 2] - points[3 * i + 2];
+      if (dx * dx + dy * dy + dz * dz <= radius * radius)
+      {
+        expected.push_back(static_cast<int>(j));
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(expected.size(), found.size())
+    for (size_t k = 0; k < expected.size(); ++k)
+    {
+      DREAM3D_REQUIRE_EQUAL(expected[k], found[k])
+    }
+  }
+  delete[] skip;
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestCellRange() )
+  DREAM3D_REGISTER_TEST( TestRadius() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -39,6 +39,7 @@
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/DataArrays/DataArray.hpp"
 #include "DREAM3DLib/DataArrays/NeighborList.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
 
 #include "UnitTestSupport.hpp"
 
@@ -321,6 +322,282 @@ void TestEraseElements()
 
 
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCompactTuples()
+{
+  // Keep every third tuple plus the last one
+  std::vector<bool> keep(NUM_TUPLES_2, false);
+  keep[0] = true;
+  keep[3] = true;
+  keep[6] = true;
+  keep[9] = true;
+  {
+    DataArray<int32_t>::Pointer array = DataArray<int32_t>::CreateArray(NUM_TUPLES_2, NUM_COMPONENTS_2, "Test1");
+    for(size_t i = 0; i < NUM_TUPLES_2; ++i)
+    {
+      array->SetComponent(i, 0, static_cast<int32_t>(i));
+      array->SetComponent(i, 1, static_cast<int32_t>(i * 100));
+    }
+    int err = array->CompactTuples(keep);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE_EQUAL(array->GetNumberOfTuples(), 4);
+    DREAM3D_REQUIRE_EQUAL(array->GetSize(), 8);
+    for(size_t i = 0; i < 4; ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->GetComponent(i, 0), static_cast<int32_t>(i * 3));
+      DREAM3D_REQUIRE_EQUAL(array->GetComponent(i, 1), static_cast<int32_t>(i * 300));
+    }
+
+    // A mask of the wrong length is rejected and keeping everything changes nothing
+    err = array->CompactTuples(keep);
+    DREAM3D_REQUIRE_EQUAL(err, -100);
+    err = array->CompactTuples(std::vector<bool>(4, true));
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE_EQUAL(array->GetComponent(3, 1), 900);
+
+    err = array->CompactTuples(std::vector<bool>(4, false));
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE_EQUAL(array->GetNumberOfTuples(), 0);
+  }
+
+  // An array that does not own its memory must leave the original buffer alone
+  {
+    DataArray<int32_t>::Pointer array = DataArray<int32_t>::CreateArray(NUM_TUPLES_2, "Test2");
+    for(size_t i = 0; i < NUM_TUPLES_2; ++i)
+    {
+      array->SetValue(i, static_cast<int32_t>(i));
+    }
+    int32_t* original = array->GetPointer(0);
+    array->releaseOwnership();
+    int err = array->CompactTuples(keep);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE(array->GetPointer(0) != original);
+    DREAM3D_REQUIRE_EQUAL(array->GetNumberOfTuples(), 4);
+    DREAM3D_REQUIRE_EQUAL(array->GetValue(2), 6);
+    for(size_t i = 0; i < NUM_TUPLES_2; ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL(original[i], static_cast<int32_t>(i));
+    }
+    free(original);
+  }
+
+  // Both layouts of the NeighborList give the same lists
+  for(int layout = 0; layout < 2; ++layout)
+  {
+    NeighborList<int32_t>::Pointer n = NeighborList<int32_t>::New();
+    std::vector<size_t> offsets(NUM_TUPLES_2 + 1, 0);
+    std::vector<int32_t> values;
+    for(size_t i = 0; i < NUM_TUPLES_2; ++i)
+    {
+      for(size_t j = 0; j < i % 4; ++j) { values.push_back(static_cast<int32_t>(i * 10 + j)); }
+      offsets[i + 1] = values.size();
+    }
+    n->setCompactLists(offsets, values);
+    if (layout == 1) { n->getList(0); }
+    DREAM3D_REQUIRE_EQUAL(n->isCompact(), (layout == 0));
+
+    int err = n->CompactTuples(keep);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    DREAM3D_REQUIRE_EQUAL(n->GetNumberOfTuples(), 4);
+    DREAM3D_REQUIRE_EQUAL(n->GetSize(), 0 + 3 + 2 + 1);
+    for(size_t i = 0; i < 4; ++i)
+    {
+      size_t old = i * 3;
+      DREAM3D_REQUIRE_EQUAL(n->getListSize(static_cast<int>(i)), static_cast<int>(old % 4));
+      bool ok = true;
+      for(size_t j = 0; j < old % 4; ++j)
+      {
+        DREAM3D_REQUIRE_EQUAL(n->getValue(static_cast<int>(i), static_cast<int>(j), ok), static_cast<int32_t>(old * 10 + j));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCompactFieldDataArrays()
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t numFields = 1000;
+  DataArray<float>::Pointer centroids = DataArray<float>::CreateArray(numFields, 3, "Centroids");
+  DataArray<bool>::Pointer active = DataArray<bool>::CreateArray(numFields, "Active");
+  NeighborList<int32_t>::Pointer lists = NeighborList<int32_t>::New();
+  lists->SetName("Lists");
+  std::vector<bool> keep(numFields, false);
+  for(size_t i = 0; i < numFields; ++i)
+  {
+    keep[i] = (i % 10 == 0 || i % 7 == 3);
+    active->SetValue(i, keep[i]);
+    centroids->SetComponent(i, 0, static_cast<float>(i));
+    centroids->SetComponent(i, 1, static_cast<float>(i) * 0.5f);
+    centroids->SetComponent(i, 2, -static_cast<float>(i));
+    lists->addEntry(static_cast<int>(i), static_cast<int32_t>(i));
+  }
+  m->addFieldData(centroids->GetName(), centroids);
+  m->addFieldData(active->GetName(), active);
+  m->addFieldData(lists->GetName(), lists);
+
+  std::vector<int64_t> newIds;
+  int err = m->compactFieldDataArrays(keep, newIds);
+  DREAM3D_REQUIRE_EQUAL(err, 0);
+  DREAM3D_REQUIRE_EQUAL(newIds.size(), numFields);
+
+  size_t kept = 0;
+  for(size_t i = 0; i < numFields; ++i)
+  {
+    if (keep[i] == false)
+    {
+      DREAM3D_REQUIRE_EQUAL(newIds[i], -1);
+      continue;
+    }
+    DREAM3D_REQUIRE_EQUAL(newIds[i], static_cast<int64_t>(kept));
+    DREAM3D_REQUIRE_EQUAL(centroids->GetComponent(kept, 0), static_cast<float>(i));
+    DREAM3D_REQUIRE_EQUAL(centroids->GetComponent(kept, 1), static_cast<float>(i) * 0.5f);
+    DREAM3D_REQUIRE_EQUAL(centroids->GetComponent(kept, 2), -static_cast<float>(i));
+    DREAM3D_REQUIRE_EQUAL(active->GetValue(kept), true);
+    DREAM3D_REQUIRE_EQUAL(lists->getList(static_cast<int>(kept))->at(0), static_cast<int32_t>(i));
+    kept++;
+  }
+  DREAM3D_REQUIRE_EQUAL(m->getNumFieldTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(centroids->GetNumberOfTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(active->GetNumberOfTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(lists->GetNumberOfTuples(), kept);
+
+  // An array with the wrong number of tuples stops the compaction before anything is changed
+  DataArray<int32_t>::Pointer shortArray = DataArray<int32_t>::CreateArray(kept - 1, "Short");
+  m->addFieldData(shortArray->GetName(), shortArray);
+  std::vector<bool> keepFirst(kept, false);
+  keepFirst[0] = true;
+  err = m->compactFieldDataArrays(keepFirst, newIds);
+  DREAM3D_REQUIRE_EQUAL(err, -100);
+  DREAM3D_REQUIRE_EQUAL(centroids->GetNumberOfTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(active->GetNumberOfTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(lists->GetNumberOfTuples(), kept);
+  DREAM3D_REQUIRE_EQUAL(shortArray->GetNumberOfTuples(), kept - 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMemoryMappedArray()
+{
+  size_t numTuples = 100000;
+  {
+    FloatArrayType::Pointer array = FloatArrayType::CreateMappedArray(numTuples, 3, "Mapped");
+    DREAM3D_REQUIRE(array.get() != NULL);
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), true);
+    DREAM3D_REQUIRE_EQUAL(array->isAllocated(), true);
+    // A new file is zero filled
+    float* ptr = array->GetPointer(0);
+    DREAM3D_REQUIRE_EQUAL(ptr[0], 0.0f);
+    DREAM3D_REQUIRE_EQUAL(ptr[numTuples * 3 - 1], 0.0f);
+    for(size_t i = 0; i < numTuples * 3; ++i)
+    {
+      ptr[i] = static_cast<float>(i);
+    }
+
+    // Growing keeps the values and the new part is zero
+    array->Resize(numTuples * 2);
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), true);
+    DREAM3D_REQUIRE_EQUAL(array->GetNumberOfTuples(), numTuples * 2);
+    DREAM3D_REQUIRE_EQUAL(array->GetValue(numTuples * 3 - 1), static_cast<float>(numTuples * 3 - 1));
+    DREAM3D_REQUIRE_EQUAL(array->GetValue(numTuples * 6 - 1), 0.0f);
+
+    // Erasing works in place in the file
+    std::vector<size_t> eraseElements;
+    eraseElements.push_back(0);
+    eraseElements.push_back(2);
+    array->EraseTuples(eraseElements);
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), true);
+    DREAM3D_REQUIRE_EQUAL(array->GetNumberOfTuples(), numTuples * 2 - 2);
+    DREAM3D_REQUIRE_EQUAL(array->GetComponent(0, 0), 3.0f);
+    DREAM3D_REQUIRE_EQUAL(array->GetComponent(1, 2), 11.0f);
+
+    // Moving to the heap and back keeps the values
+    DREAM3D_REQUIRE_EQUAL(array->setMemoryMapped(false), 1);
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), false);
+    DREAM3D_REQUIRE_EQUAL(array->GetComponent(1, 2), 11.0f);
+    DREAM3D_REQUIRE_EQUAL(array->setMemoryMapped(true), 1);
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), true);
+    DREAM3D_REQUIRE_EQUAL(array->GetComponent(1, 2), 11.0f);
+
+    // Whoever takes the memory frees it with free() so it has to be moved to the heap
+    array->releaseOwnership();
+    DREAM3D_REQUIRE_EQUAL(array->isMemoryMapped(), false);
+    float* released = array->GetPointer(0);
+    DREAM3D_REQUIRE_EQUAL(released[5], 11.0f);
+    free(released);
+  }
+
+  // Arrays at or above the threshold are mapped, including ones that grow past it
+  MemoryMappedFile::SetMappingThreshold(numTuples * sizeof(int32_t));
+  {
+    Int32ArrayType::Pointer small = Int32ArrayType::CreateArray(numTuples - 1, "Small");
+    DREAM3D_REQUIRE_EQUAL(small->isMemoryMapped(), false);
+    Int32ArrayType::Pointer large = Int32ArrayType::CreateArray(numTuples, "Large");
+    DREAM3D_REQUIRE_EQUAL(large->isMemoryMapped(), true);
+    small->SetValue(3, 42);
+    small->Resize(numTuples + 1);
+    DREAM3D_REQUIRE_EQUAL(small->isMemoryMapped(), true);
+    DREAM3D_REQUIRE_EQUAL(small->GetValue(3), 42);
+
+    IDataArray::Pointer copy = large->deepCopy();
+    DREAM3D_REQUIRE_EQUAL(copy->isMemoryMapped(), true);
+  }
+  MemoryMappedFile::SetMappingThreshold(0);
+  {
+    Int32ArrayType::Pointer large = Int32ArrayType::CreateArray(numTuples, "Large");
+    DREAM3D_REQUIRE_EQUAL(large->isMemoryMapped(), false);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMemoryBudget()
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = {40, 40, 40};
+  m->setDimensions(dims);
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(totalPoints, 3, DREAM3D::CellData::EulerAngles);
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  BoolArrayType::Pointer active = BoolArrayType::CreateArray(10, DREAM3D::FieldData::Active);
+  for(size_t i = 0; i < totalPoints; ++i)
+  {
+    grainIds->SetValue(i, static_cast<int32_t>(i));
+  }
+  m->addCellData(eulers->GetName(), eulers);
+  m->addCellData(grainIds->GetName(), grainIds);
+  m->addFieldData(active->GetName(), active);
+
+  uint64_t heapBytes = m->applyMemoryBudget();
+  DREAM3D_REQUIRE_EQUAL(heapBytes, totalPoints * 16 + 10);
+
+  // Only the largest array has to move to get under the budget
+  m->setMemoryBudget(totalPoints * 8);
+  DREAM3D_REQUIRE_EQUAL(eulers->isMemoryMapped(), true);
+  DREAM3D_REQUIRE_EQUAL(grainIds->isMemoryMapped(), false);
+  DREAM3D_REQUIRE_EQUAL(active->isMemoryMapped(), false);
+  DREAM3D_REQUIRE_EQUAL(m->applyMemoryBudget(), totalPoints * 4 + 10);
+
+  // A new array that does not fit is mapped, the ones filters already hold are left alone
+  int32_t* grainIdsPtr = grainIds->GetPointer(0);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::Phases);
+  m->addCellData(phases->GetName(), phases);
+  DREAM3D_REQUIRE_EQUAL(phases->isMemoryMapped(), true);
+  DREAM3D_REQUIRE(grainIds->GetPointer(0) == grainIdsPtr);
+  DREAM3D_REQUIRE_EQUAL(grainIds->GetValue(totalPoints - 1), static_cast<int32_t>(totalPoints - 1));
+
+  // A small array still fits
+  FloatArrayType::Pointer volumes = FloatArrayType::CreateArray(10, DREAM3D::FieldData::Volumes);
+  m->addFieldData(volumes->GetName(), volumes);
+  DREAM3D_REQUIRE_EQUAL(volumes->isMemoryMapped(), false);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -507,6 +784,61 @@ void TestNeighborList()
 }
 
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCompactNeighborList()
+{
+  NeighborList<int32_t>::Pointer n = NeighborList<int32_t>::New();
+  n->SetName("Test");
+
+  // List i holds the values i*10 up to i*10 + i - 1, so list 0 is empty
+  std::vector<size_t> offsets(5, 0);
+  std::vector<int32_t> values;
+  for(int i = 0; i < 4; ++i)
+  {
+    for(int j = 0; j < i; ++j) { values.push_back(i * 10 + j); }
+    offsets[i + 1] = values.size();
+  }
+  n->setCompactLists(offsets, values);
+  DREAM3D_REQUIRE_EQUAL(offsets.size(), 0);
+  DREAM3D_REQUIRE_EQUAL(n->isCompact(), true);
+  DREAM3D_REQUIRE_EQUAL(n->GetNumberOfTuples(), 4);
+  DREAM3D_REQUIRE_EQUAL(n->GetSize(), 6);
+
+  bool ok = true;
+  DREAM3D_REQUIRE(n->getListPointer(0) == NULL);
+  for(int i = 0; i < 4; ++i)
+  {
+    DREAM3D_REQUIRE_EQUAL(n->getListSize(i), i);
+    for(int j = 0; j < i; ++j)
+    {
+      DREAM3D_REQUIRE_EQUAL(n->getListPointer(i)[j], i * 10 + j);
+      DREAM3D_REQUIRE_EQUAL(n->getValue(i, j, ok), i * 10 + j);
+    }
+  }
+  n->getValue(2, 2, ok);
+  DREAM3D_REQUIRE_EQUAL(ok, false);
+  DREAM3D_REQUIRE_EQUAL(n->isCompact(), true);
+
+  // Asking for a vector converts the lists without changing them
+  NeighborList<int32_t>& lists = *n;
+  DREAM3D_REQUIRE_EQUAL(lists[3].size(), 3);
+  DREAM3D_REQUIRE_EQUAL(n->isCompact(), false);
+  for(int i = 0; i < 4; ++i)
+  {
+    DREAM3D_REQUIRE_EQUAL(n->getListSize(i), i);
+    for(int j = 0; j < i; ++j)
+    {
+      DREAM3D_REQUIRE_EQUAL(lists[i][j], i * 10 + j);
+    }
+  }
+  n->addEntry(0, 7);
+  DREAM3D_REQUIRE_EQUAL(n->getListSize(0), 1);
+  DREAM3D_REQUIRE_EQUAL(n->GetSize(), 7);
+}
+
+
 
 // -----------------------------------------------------------------------------
 //  Use unit test framework
@@ -524,7 +856,12 @@ int main(int argc, char **argv)
       DREAM3D_REGISTER_TEST( TestDataArray() )
       DREAM3D_REGISTER_TEST( TestEraseElements() )
       DREAM3D_REGISTER_TEST( TestCopyTuples() )
+      DREAM3D_REGISTER_TEST( TestCompactTuples() )
+      DREAM3D_REGISTER_TEST( TestCompactFieldDataArrays() )
+      DREAM3D_REGISTER_TEST( TestMemoryMappedArray() )
+      DREAM3D_REGISTER_TEST( TestMemoryBudget() )
       DREAM3D_REGISTER_TEST( TestNeighborList() )
+      DREAM3D_REGISTER_TEST( TestCompactNeighborList() )
 
     #if REMOVE_TEST_FILES
       DREAM3D_REGISTER_TEST( RemoveTestFiles() )
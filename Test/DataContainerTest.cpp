@@ -85,6 +85,7 @@ dataContainer->addCellData(name, m_msgType##Ptr);
 void RemoveTestFiles()
 {
   MXADir::remove(UnitTest::DataContainerIOTest::TestFile);
+  MXADir::remove(UnitTest::DataContainerIOTest::SubVolumeFile);
 }
 
 
@@ -215,6 +216,119 @@ void TestDataContainerReader()
   DREAM3D_REQUIRE(err >= 0)
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSubVolumeReader()
+{
+  // Every Z slice is its own grain
+  size_t nx = 10;
+  size_t ny = 8;
+  size_t nz = 6;
+  size_t size = nx * ny * nz;
+  {
+    VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+    m->setDimensions(nx, ny, nz);
+    float res[3] = {0.5f, 0.5f, 2.0f};
+    m->setResolution(res);
+    MXADir::mkdir(UnitTest::DataContainerIOTest::TestDir, true);
+
+    Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(size, DREAM3D::CellData::GrainIds);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(size, 4, DREAM3D::CellData::Quats);
+    for (size_t i = 0; i < size; ++i)
+    {
+      grainIds->SetValue(i, static_cast<int32_t>(i / (nx * ny) + 1));
+      for (int c = 0; c < 4; ++c)
+      {
+        quats->SetComponent(i, c, static_cast<float>(i * 4 + c));
+      }
+    }
+    m->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+    m->addCellData(DREAM3D::CellData::Quats, quats);
+
+    FloatArrayType::Pointer volumes = FloatArrayType::CreateArray(nz + 1, DREAM3D::FieldData::Volumes);
+    for (size_t i = 0; i < nz + 1; ++i)
+    {
+      volumes->SetValue(i, i * 1.5f);
+    }
+    m->addFieldData(DREAM3D::FieldData::Volumes, volumes);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setVoxelDataContainer(m.get());
+    writer->setOutputFile(UnitTest::DataContainerIOTest::SubVolumeFile);
+    writer->setWriteXdmfFile(false);
+    writer->setWriteChunkedData(true);
+    writer->setCompressionLevel(1);
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCondition(), 0);
+  }
+
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  DataContainerReader::Pointer reader = DataContainerReader::New();
+  reader->setInputFile(UnitTest::DataContainerIOTest::SubVolumeFile);
+  reader->setVoxelDataContainer(m.get());
+  reader->setReadVoxelData(true);
+  reader->setReadSurfaceMeshData(false);
+  reader->setReadSolidMeshData(false);
+  reader->setReadAllArrays(true);
+  reader->setReadSubVolume(true);
+  reader->setXMin(2);
+  reader->setXMax(6);
+  reader->setYMin(1);
+  reader->setYMax(5);
+  reader->setZMin(2);
+  reader->setZMax(3);
+  reader->execute();
+  DREAM3D_REQUIRE(reader->getErrorCondition() >= 0)
+
+  size_t dims[3] = {0, 0, 0};
+  m->getDimensions(dims);
+  DREAM3D_REQUIRE_EQUAL(dims[0], 5);
+  DREAM3D_REQUIRE_EQUAL(dims[1], 5);
+  DREAM3D_REQUIRE_EQUAL(dims[2], 2);
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  m->getOrigin(origin);
+  DREAM3D_REQUIRE_EQUAL(origin[0], 1.0f);
+  DREAM3D_REQUIRE_EQUAL(origin[1], 0.5f);
+  DREAM3D_REQUIRE_EQUAL(origin[2], 4.0f);
+
+  Int32ArrayType* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get());
+  FloatArrayType* quats = FloatArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::Quats).get());
+  DREAM3D_REQUIRE_NE(0, grainIds);
+  DREAM3D_REQUIRE_NE(0, quats);
+  DREAM3D_REQUIRE_EQUAL(grainIds->GetNumberOfTuples(), 50);
+  DREAM3D_REQUIRE_EQUAL(quats->GetNumberOfComponents(), 4);
+  for (size_t z = 0; z < dims[2]; ++z)
+  {
+    for (size_t y = 0; y < dims[1]; ++y)
+    {
+      for (size_t x = 0; x < dims[0]; ++x)
+      {
+        size_t i = (z * dims[1] + y) * dims[0] + x;
+        size_t fileIndex = ((z + 2) * ny + (y + 1)) * nx + (x + 2);
+        // Only grains 3 and 4 are inside the box so they become 1 and 2
+        DREAM3D_REQUIRE_EQUAL(grainIds->GetValue(i), static_cast<int32_t>(z + 1));
+        for (int c = 0; c < 4; ++c)
+        {
+          DREAM3D_REQUIRE_EQUAL(quats->GetComponent(i, c), static_cast<float>(fileIndex * 4 + c));
+        }
+      }
+    }
+  }
+
+  FloatArrayType* volumes = FloatArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::Volumes).get());
+  DREAM3D_REQUIRE_NE(0, volumes);
+  DREAM3D_REQUIRE_EQUAL(m->getNumFieldTuples(), 3);
+  DREAM3D_REQUIRE_EQUAL(volumes->GetValue(1), 3 * 1.5f);
+  DREAM3D_REQUIRE_EQUAL(volumes->GetValue(2), 4 * 1.5f);
+  DREAM3D_REQUIRE_EQUAL(m->getFieldData(DREAM3D::FieldData::Active).get(), 0);
+
+  // A box outside of the volume is an error
+  reader->setZMax(6);
+  reader->execute();
+  DREAM3D_REQUIRE(reader->getErrorCondition() < 0)
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -543,6 +657,7 @@ int main(int argc, char **argv)
 
   DREAM3D_REGISTER_TEST( TestDataContainerWriter() )
   DREAM3D_REGISTER_TEST( TestDataContainerReader() )
+  DREAM3D_REGISTER_TEST( TestSubVolumeReader() )
 
 #if REMOVE_TEST_FILES
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
@@ -0,0 +1,383 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <vector>
+
+#include "MXA/Common/LogTime.h"
+#include "MXA/Utilities/MXADir.h"
+#include "MXA/Utilities/MXAFileInfo.h"
+
+#include "EbsdLib/EbsdMacros.h"
+#include "EbsdLib/TSL/AngReader.h"
+#include "EbsdLib/TSL/AngConstants.h"
+#include "EbsdLib/HKL/CtfReader.h"
+#include "EbsdLib/HKL/CtfConstants.h"
+
+#include "UnitTestSupport.hpp"
+#include "EbsdTestFileLocation.h"
+
+static int s_XCells = 400;
+static int s_YCells = 300;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  MXADir::remove(UnitTest::EbsdReaderBenchmark::AngFile);
+  MXADir::remove(UnitTest::EbsdReaderBenchmark::CtfFile);
+  MXADir::remove(UnitTest::EbsdReaderBenchmark::EuropeanCtfFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float randomFloat(float min, float max)
+{
+  return min + (max - min) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void printThroughput(const std::string &name, const std::string &file, unsigned long long int millis)
+{
+  double megaBytes = static_cast<double>(MXAFileInfo::fileSize(file)) / (1024.0 * 1024.0);
+  double seconds = (millis == 0) ? 0.001 : static_cast<double>(millis) / 1000.0;
+  std::cout << "  " << name << ": " << millis << " ms  " << (megaBytes / seconds) << " MB/s" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+//  Writes a square grid .ang file with 10 columns of data
+// -----------------------------------------------------------------------------
+void WriteSyntheticAngFile(const std::string &filename)
+{
+  FILE* f = fopen(filename.c_str(), "wb");
+  DREAM3D_REQUIRE(f != NULL)
+  fprintf(f, "# TEM_PIXperUM          1.000000\n");
+  fprintf(f, "# x-star                0.372300\n");
+  fprintf(f, "# y-star                0.689300\n");
+  fprintf(f, "# z-star                0.970100\n");
+  fprintf(f, "# WorkingDistance       5.000000\n");
+  fprintf(f, "#\n");
+  fprintf(f, "# Phase 1\n");
+  fprintf(f, "# MaterialName  \tNickel\n");
+  fprintf(f, "# Formula     \tNi\n");
+  fprintf(f, "# Info\t\t\n");
+  fprintf(f, "# Symmetry              43\n");
+  fprintf(f, "# LatticeConstants      3.520 3.520 3.520  90.000  90.000  90.000\n");
+  fprintf(f, "# NumberFamilies        1\n");
+  fprintf(f, "# hklFamilies   \t 1  1  1 1 0.000000\n");
+  fprintf(f, "# Categories 0 0 0 0 0 \n");
+  fprintf(f, "#\n");
+  fprintf(f, "# GRID: SqrGrid\n");
+  fprintf(f, "# XSTEP: 0.250000\n");
+  fprintf(f, "# YSTEP: 0.250000\n");
+  fprintf(f, "# NCOLS_ODD: %d\n", s_XCells);
+  fprintf(f, "# NCOLS_EVEN: %d\n", s_XCells);
+  fprintf(f, "# NROWS: %d\n", s_YCells);
+  fprintf(f, "#\n");
+  for (int y = 0; y < s_YCells; ++y)
+  {
+    for (int x = 0; x < s_XCells; ++x)
+    {
+      fprintf(f, " %8.5f %8.5f %8.5f %12.5f %12.5f %6.1f %6.3f %2d %6d %6.3f\n",
+              randomFloat(0.0f, 6.28318f), randomFloat(0.0f, 3.14159f), randomFloat(0.0f, 6.28318f),
+              x * 0.25f, y * 0.25f, randomFloat(0.0f, 3000.0f), randomFloat(-1.0f, 1.0f),
+              rand() % 3, rand() % 2000 - 1000, randomFloat(0.0f, 180.0f));
+    }
+  }
+  fclose(f);
+}
+
+// -----------------------------------------------------------------------------
+//  Writes a .ctf file. European files use ',' as the decimal separator. Every
+//  97th point leaves the Bands, MAD and BS columns empty
+// -----------------------------------------------------------------------------
+void WriteSyntheticCtfFile(const std::string &filename, bool european)
+{
+  FILE* f = fopen(filename.c_str(), "wb");
+  DREAM3D_REQUIRE(f != NULL)
+  fprintf(f, "Channel Text File\r\n");
+  fprintf(f, "Prj\tSynthetic.cpr\r\n");
+  fprintf(f, "Author\t[Unknown]\r\n");
+  fprintf(f, "JobMode\tGrid\r\n");
+  fprintf(f, "XCells\t%d\r\n", s_XCells);
+  fprintf(f, "YCells\t%d\r\n", s_YCells);
+  fprintf(f, "XStep\t0.5\r\n");
+  fprintf(f, "YStep\t0.5\r\n");
+  fprintf(f, "AcqE1\t0\r\n");
+  fprintf(f, "AcqE2\t0\r\n");
+  fprintf(f, "AcqE3\t0\r\n");
+  fprintf(f, "Euler angles refer to Sample Coordinate system (CS0)!\tMag\t200\tCoverage\t100\tDevice\t0\tKV\t15\tTiltAngle\t70\tTiltAxis\t0\r\n");
+  fprintf(f, "Phases\t1\r\n");
+  fprintf(f, "3.231;3.231;5.148\t90;90;120\tZirc-alloy4\t9\t0\t0_5.0.6.0\t-67395467\t[Zr4.cry]\r\n");
+  fprintf(f, "Phase\tX\tY\tBands\tError\tEuler1\tEuler2\tEuler3\tMAD\tBC\tBS\r\n");
+  char line[512];
+  for (int y = 0; y < s_YCells; ++y)
+  {
+    for (int x = 0; x < s_XCells; ++x)
+    {
+      int n = 0;
+      if ((y * s_XCells + x) % 97 == 0)
+      {
+        n = snprintf(line, 512, "%d\t%.4f\t%.4f\t\t%d\t%.2f\t%.3f\t%.3f\t\t%d\t\r\n",
+                     rand() % 2, x * 0.5f, y * 0.5f, rand() % 5,
+                     randomFloat(0.0f, 360.0f), randomFloat(0.0f, 90.0f), randomFloat(0.0f, 360.0f),
+                     rand() % 255);
+      }
+      else
+      {
+        n = snprintf(line, 512, "%d\t%.4f\t%.4f\t%d\t%d\t%.2f\t%.3f\t%.3f\t%.4f\t%d\t%d\r\n",
+                     rand() % 2, x * 0.5f, y * 0.5f, rand() % 12, rand() % 5,
+                     randomFloat(0.0f, 360.0f), randomFloat(0.0f, 90.0f), randomFloat(0.0f, 360.0f),
+                     randomFloat(0.0f, 2.0f), rand() % 255, rand() % 255);
+      }
+      if (european == true)
+      {
+        for (int i = 0; i < n; ++i) { if (line[i] == '.') { line[i] = ','; } }
+      }
+      fwrite(line, 1, n, f);
+    }
+  }
+  fclose(f);
+}
+
+// -----------------------------------------------------------------------------
+//  The getline + sscanf loop that AngReader used to parse the data section with
+// -----------------------------------------------------------------------------
+size_t ReadAngWithSscanf(const std::string &filename, std::vector<std::vector<float> > &columns, std::vector<int> &phases)
+{
+  std::ifstream in(filename.c_str());
+  char buf[kBufferSize];
+  size_t count = 0;
+  ::memset(buf, 0, kBufferSize);
+  in.getline(buf, kBufferSize);
+  while (buf[0] == '#' && in.eof() == false)
+  {
+    ::memset(buf, 0, kBufferSize);
+    in.getline(buf, kBufferSize);
+  }
+  columns.resize(9);
+  while (in.eof() == false || buf[0] != 0)
+  {
+    float v[9] = { 0.0f, 0.0f, 0.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f };
+    int ph = -1;
+    std::string line(buf);
+    sscanf(line.c_str(), "%f %f %f %f %f %f %f %d %f %f", v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, &ph, v + 7, v + 8);
+    for (int c = 0; c < 9; ++c) { columns[c].push_back(v[c]); }
+    phases.push_back(ph);
+    ++count;
+    ::memset(buf, 0, kBufferSize);
+    in.getline(buf, kBufferSize);
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//  The getline + tokenize + sscanf loop that CtfReader used to parse the data
+//  section with. Every column is stored as a float for the comparison
+// -----------------------------------------------------------------------------
+size_t ReadCtfWithSscanf(const std::string &filename, std::vector<std::string> &names, std::vector<std::vector<float> > &columns)
+{
+  std::ifstream in(filename.c_str());
+  char buf[kBufferSize];
+  size_t count = 0;
+  ::memset(buf, 0, kBufferSize);
+  in.getline(buf, kBufferSize);
+  while (strncmp(buf, "Phase\t", 6) != 0 && in.eof() == false)
+  {
+    ::memset(buf, 0, kBufferSize);
+    in.getline(buf, kBufferSize);
+  }
+  std::string header(buf);
+  size_t start = 0;
+  size_t pos = 0;
+  while (pos != std::string::npos)
+  {
+    pos = header.find('\t', start);
+    std::string name = header.substr(start, pos - start);
+    if (name.size() > 0 && name[name.size() - 1] < 32) { name.resize(name.size() - 1); }
+    names.push_back(name);
+    start = pos + 1;
+  }
+  columns.resize(names.size());
+
+  while (true)
+  {
+    ::memset(buf, 0, kBufferSize);
+    in.getline(buf, kBufferSize);
+    if (in.eof() == true) { break; }
+    std::string line(buf);
+    for (size_t c = 0; c < line.size(); ++c) { if (line[c] == ',') { line[c] = '.'; } }
+    std::vector<std::string> tokens;
+    start = 0;
+    pos = 0;
+    while (pos != std::string::npos)
+    {
+      pos = line.find('\t', start);
+      tokens.push_back(line.substr(start, pos - start));
+      start = pos + 1;
+    }
+    for (size_t c = 0; c < names.size(); ++c)
+    {
+      float value = 0.0f;
+      if (names[c].compare(Ebsd::Ctf::Phase) == 0 || names[c].compare(Ebsd::Ctf::Bands) == 0 || names[c].compare(Ebsd::Ctf::Error) == 0
+          || names[c].compare(Ebsd::Ctf::BC) == 0 || names[c].compare(Ebsd::Ctf::BS) == 0)
+      {
+        int iValue = 0;
+        sscanf(tokens[c].c_str(), "%d", &iValue);
+        value = static_cast<float>(iValue);
+      }
+      else
+      {
+        sscanf(tokens[c].c_str(), "%f", &value);
+      }
+      columns[c].push_back(value);
+    }
+    ++count;
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestAngReader()
+{
+  std::string filename = UnitTest::EbsdReaderBenchmark::AngFile;
+  WriteSyntheticAngFile(filename);
+  std::cout << "Synthetic .ang file: " << s_XCells << " x " << s_YCells << " points" << std::endl;
+
+  std::vector<std::vector<float> > columns;
+  std::vector<int> phases;
+  unsigned long long int millis = MXA::getMilliSeconds();
+  size_t count = ReadAngWithSscanf(filename, columns, phases);
+  printThroughput("getline + sscanf", filename, MXA::getMilliSeconds() - millis);
+  DREAM3D_REQUIRE_EQUAL(count, static_cast<size_t>(s_XCells * s_YCells))
+
+  AngReader reader;
+  reader.setFileName(filename);
+  millis = MXA::getMilliSeconds();
+  int err = reader.readFile();
+  printThroughput("AngReader       ", filename, MXA::getMilliSeconds() - millis);
+  DREAM3D_REQUIRE(err >= 0)
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), count)
+
+  const std::string names[9] = { Ebsd::Ang::Phi1, Ebsd::Ang::Phi, Ebsd::Ang::Phi2, Ebsd::Ang::XPosition, Ebsd::Ang::YPosition,
+                                 Ebsd::Ang::ImageQuality, Ebsd::Ang::ConfidenceIndex, Ebsd::Ang::SEMSignal, Ebsd::Ang::Fit };
+  for (int c = 0; c < 9; ++c)
+  {
+    float* ptr = reinterpret_cast<float*>(reader.getPointerByName(names[c]));
+    DREAM3D_REQUIRE(ptr != NULL)
+    for (size_t i = 0; i < count; ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL(ptr[i], columns[c][i])
+    }
+  }
+  int* phasePtr = reinterpret_cast<int*>(reader.getPointerByName(Ebsd::Ang::PhaseData));
+  for (size_t i = 0; i < count; ++i)
+  {
+    DREAM3D_REQUIRE_EQUAL(phasePtr[i], phases[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCtfReader(const std::string &filename, bool european)
+{
+  WriteSyntheticCtfFile(filename, european);
+  std::cout << "Synthetic " << (european ? "European" : "US") << " .ctf file: " << s_XCells << " x " << s_YCells << " points" << std::endl;
+
+  std::vector<std::string> names;
+  std::vector<std::vector<float> > columns;
+  unsigned long long int millis = MXA::getMilliSeconds();
+  size_t count = ReadCtfWithSscanf(filename, names, columns);
+  printThroughput("getline + sscanf", filename, MXA::getMilliSeconds() - millis);
+  DREAM3D_REQUIRE_EQUAL(count, static_cast<size_t>(s_XCells * s_YCells))
+
+  CtfReader reader;
+  reader.setFileName(filename);
+  millis = MXA::getMilliSeconds();
+  int err = reader.readFile();
+  printThroughput("CtfReader       ", filename, MXA::getMilliSeconds() - millis);
+  DREAM3D_REQUIRE(err >= 0)
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), count)
+
+  for (size_t c = 0; c < names.size(); ++c)
+  {
+    void* ptr = reader.getPointerByName(names[c]);
+    DREAM3D_REQUIRE(ptr != NULL)
+    bool isInt = (reader.getPointerType(names[c]) == Ebsd::Int32);
+    for (size_t i = 0; i < count; ++i)
+    {
+      float value = isInt ? static_cast<float>(reinterpret_cast<int*>(ptr)[i]) : reinterpret_cast<float*>(ptr)[i];
+      DREAM3D_REQUIRE_EQUAL(value, columns[c][i])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework. An optional "XCells YCells" pair on the command line
+//  sets the size of the synthetic scans for benchmarking larger files
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  if (argc > 2)
+  {
+    s_XCells = atoi(argv[1]);
+    s_YCells = atoi(argv[2]);
+  }
+  srand(12345);
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestAngReader() )
+  DREAM3D_REGISTER_TEST( TestCtfReader(UnitTest::EbsdReaderBenchmark::CtfFile, false) )
+  DREAM3D_REGISTER_TEST( TestCtfReader(UnitTest::EbsdReaderBenchmark::EuropeanCtfFile, true) )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
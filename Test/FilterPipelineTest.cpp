@@ -45,10 +45,69 @@
 #include "DREAM3DLib/ReconstructionFilters/AlignSections.h"
 #include "DREAM3DLib/ReconstructionFilters/SegmentGrains.h"
 #include "DREAM3DLib/ProcessingFilters/MinSize.h"
+#include "DREAM3DLib/Common/PipelineProfiler.h"
 
 #include "UnitTestSupport.hpp"
 #include "TestFileLocations.h"
 
+namespace ProfileTest
+{
+  const size_t NumTuples = 1000;
+  const std::string ArrayName("ProfiledArray");
+}
+
+/**
+ * @brief Adds a float array with a known size to the cell data, or removes it
+ * again, so that the profiler has something to measure.
+ */
+class ProfiledArrayFilter : public AbstractFilter
+{
+  public:
+    DREAM3D_SHARED_POINTERS(ProfiledArrayFilter)
+    DREAM3D_STATIC_NEW_MACRO(ProfiledArrayFilter)
+    DREAM3D_TYPE_MACRO_SUPER(ProfiledArrayFilter, AbstractFilter)
+
+    DREAM3D_INSTANCE_PROPERTY(bool, RemoveArray)
+
+    virtual ~ProfiledArrayFilter(){}
+
+    virtual const std::string getGroupName()
+    {
+      return "UnitTest";
+    }
+    virtual const std::string getHumanLabel()
+    {
+      return "Profiled Array, \"Test\"";
+    }
+    virtual void execute()
+    {
+      setErrorCondition(0);
+      VoxelDataContainer* m = getVoxelDataContainer();
+      if (m_RemoveArray == true)
+      {
+        m->removeCellData(ProfileTest::ArrayName);
+        return;
+      }
+      FloatArrayType::Pointer data = FloatArrayType::CreateArray(ProfileTest::NumTuples, 3, ProfileTest::ArrayName);
+      data->initializeWithZeros();
+      m->addCellData(ProfileTest::ArrayName, data);
+    }
+    virtual void preflight()
+    {
+    }
+
+  protected:
+    ProfiledArrayFilter() :
+        AbstractFilter(),
+        m_RemoveArray(false)
+    {
+    }
+
+  private:
+    ProfiledArrayFilter(const ProfiledArrayFilter&); // Copy Constructor Not Implemented
+    void operator=(const ProfiledArrayFilter&); // Operator '=' Not Implemented
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -113,6 +172,54 @@ void TestFilterPipeline()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPipelineProfiler()
+{
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  ProfiledArrayFilter::Pointer create = ProfiledArrayFilter::New();
+  pipeline->pushBack(create);
+  ProfiledArrayFilter::Pointer remove = ProfiledArrayFilter::New();
+  remove->setRemoveArray(true);
+  pipeline->pushBack(remove);
+
+  PipelineProfiler::Pointer profiler = PipelineProfiler::New();
+  pipeline->setProfiler(profiler);
+  pipeline->execute();
+  DREAM3D_REQUIRE_EQUAL(0, pipeline->getErrorCondition());
+
+  std::vector<FilterProfile>& profiles = profiler->getProfiles();
+  DREAM3D_REQUIRE_EQUAL(2, profiles.size());
+
+  uint64_t arrayBytes = ProfileTest::NumTuples * 3 * sizeof(float);
+  DREAM3D_REQUIRE_EQUAL(arrayBytes, profiles[0].bytesCreated[FilterProfile::CellArrays]);
+  DREAM3D_REQUIRE_EQUAL(0, profiles[0].bytesRemoved[FilterProfile::CellArrays]);
+  DREAM3D_REQUIRE_EQUAL(0, profiles[0].bytesCreated[FilterProfile::FieldArrays]);
+  DREAM3D_REQUIRE_EQUAL(0, profiles[1].bytesCreated[FilterProfile::CellArrays]);
+  DREAM3D_REQUIRE_EQUAL(arrayBytes, profiles[1].bytesRemoved[FilterProfile::CellArrays]);
+  DREAM3D_REQUIRE_EQUAL(0, profiles[0].pipelineIndex);
+  DREAM3D_REQUIRE_EQUAL(1, profiles[1].pipelineIndex);
+  DREAM3D_REQUIRE(profiles[0].filterClassName.compare("ProfiledArrayFilter") == 0);
+
+  std::stringstream json;
+  profiler->writeJson(json);
+  DREAM3D_REQUIRE(json.str().find("\"ClassName\": \"ProfiledArrayFilter\"") != std::string::npos);
+  DREAM3D_REQUIRE(json.str().find("\"HumanLabel\": \"Profiled Array, \\\"Test\\\"\"") != std::string::npos);
+
+  std::stringstream csv;
+  profiler->writeCsv(csv);
+  std::string header;
+  std::getline(csv, header);
+  DREAM3D_REQUIRE(header.find("PipelineIndex,ClassName,HumanLabel") == 0);
+  std::string line;
+  std::getline(csv, line);
+  DREAM3D_REQUIRE(line.find("0,ProfiledArrayFilter,\"Profiled Array, \"\"Test\"\"\"") == 0);
+
+  profiler->clear();
+  DREAM3D_REQUIRE_EQUAL(0, profiler->getProfiles().size());
+}
+
 // -----------------------------------------------------------------------------
 //  Use test framework
 // -----------------------------------------------------------------------------
@@ -122,6 +229,7 @@ int main(int argc, char **argv) {
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
 #endif
   DREAM3D_REGISTER_TEST( TestFilterPipeline() )
+  DREAM3D_REGISTER_TEST( TestPipelineProfiler() )
 
 #if REMOVE_TEST_FILES
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
@@ -0,0 +1,319 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/StatisticsFilters/FindEuclideanDistMap.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const int k_NumGrains = 10;
+
+// -----------------------------------------------------------------------------
+// Each Cell belongs to the nearest of a few random seeds, with a few Cells that
+// have no grain. With 'walls' a plane of Cells with no grain splits the volume, the
+// far side holds two grains, and one corner is a single grain sealed off by Cells
+// with no grain so it has no boundary to measure from.
+// -----------------------------------------------------------------------------
+static VoxelDataContainer::Pointer createDistanceMapVolume(size_t xp, size_t yp, size_t zp, float res[3], bool walls)
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = { xp, yp, zp };
+  m->setDimensions(dims);
+  m->setResolution(res);
+  size_t totalPoints = xp * yp * zp;
+
+  unsigned long long int seed = 2468;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  float seeds[k_NumGrains][3];
+  for (int g = 0; g < k_NumGrains; ++g)
+  {
+    seeds[g][0] = static_cast<float>(rg.genrand_res53() * xp);
+    seeds[g][1] = static_cast<float>(rg.genrand_res53() * yp);
+    seeds[g][2] = static_cast<float>(rg.genrand_res53() * zp);
+  }
+
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    size_t xi = i % xp, yi = (i / xp) % yp, zi = i / (xp * yp);
+    float x = static_cast<float>(xi), y = static_cast<float>(yi), z = static_cast<float>(zi);
+    int nearest = 0;
+    float nearestDist = -1.0f;
+    for (int g = 0; g < k_NumGrains; ++g)
+    {
+      float d = (x - seeds[g][0]) * (x - seeds[g][0]) + (y - seeds[g][1]) * (y - seeds[g][1]) + (z - seeds[g][2]) * (z - seeds[g][2]);
+      if (nearestDist < 0.0f || d < nearestDist) { nearest = g; nearestDist = d; }
+    }
+    int grain = (rg.genrand_res53() < 0.03) ? 0 : nearest + 1;
+    if (walls == true && xi == 8) { grain = 0; }
+    else if (walls == true && xi > 8)
+    {
+      grain = (yi < yp / 2) ? k_NumGrains + 1 : k_NumGrains + 2;
+      if (xi >= 11 && yi <= 3 && zi <= 3) { grain = (xi == 11 || yi == 3 || zi == 3) ? 0 : k_NumGrains + 3; }
+    }
+    grainIds->SetValue(i, grain);
+  }
+  m->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+// Labels the 6-connected regions of Cells that have a grain
+// -----------------------------------------------------------------------------
+static void findRegions(int32_t* grainIds, int64_t xp, int64_t yp, int64_t zp, std::vector<int> &regions)
+{
+  int64_t totalPoints = xp * yp * zp;
+  regions.assign(totalPoints, -1);
+  int numRegions = 0;
+  for (int64_t start = 0; start < totalPoints; ++start)
+  {
+    if (grainIds[start] <= 0 || regions[start] >= 0) { continue; }
+    std::vector<int64_t> front(1, start);
+    regions[start] = numRegions;
+    while (front.empty() == false)
+    {
+      int64_t a = front.back();
+      front.pop_back();
+      int64_t x = a % xp, y = (a / xp) % yp, z = a / (xp * yp);
+      int64_t candidates[6][3] = { {x - 1, y, z}, {x + 1, y, z}, {x, y - 1, z}, {x, y + 1, z}, {x, y, z - 1}, {x, y, z + 1} };
+      for (int k = 0; k < 6; ++k)
+      {
+        int64_t* c = candidates[k];
+        if (c[0] < 0 || c[0] >= xp || c[1] < 0 || c[1] >= yp || c[2] < 0 || c[2] >= zp) { continue; }
+        int64_t n = (c[2] * yp + c[1]) * xp + c[0];
+        if (grainIds[n] > 0 && regions[n] < 0)
+        {
+          regions[n] = numRegions;
+          front.push_back(n);
+        }
+      }
+    }
+    ++numRegions;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the number of different grains among the face neighbors of a Cell
+// -----------------------------------------------------------------------------
+static size_t countNeighborGrains(int32_t* grainIds, int64_t i, int64_t xp, int64_t yp, int64_t zp)
+{
+  int64_t x = i % xp, y = (i / xp) % yp, z = i / (xp * yp);
+  int64_t candidates[6][3] = { {x - 1, y, z}, {x + 1, y, z}, {x, y - 1, z}, {x, y + 1, z}, {x, y, z - 1}, {x, y, z + 1} };
+  std::set<int32_t> grains;
+  for (int k = 0; k < 6; ++k)
+  {
+    int64_t* c = candidates[k];
+    if (c[0] < 0 || c[0] >= xp || c[1] < 0 || c[1] >= yp || c[2] < 0 || c[2] >= zp) { continue; }
+    int32_t neighbor = grainIds[(c[2] * yp + c[1]) * xp + c[0]];
+    if (neighbor > 0 && neighbor != grainIds[i]) { grains.insert(neighbor); }
+  }
+  return grains.size();
+}
+
+// -----------------------------------------------------------------------------
+// Checks every distance map against the distance to each boundary Cell of the
+// same region, measured in steps of the finest Cell spacing. Returns the number of
+// Cell distances that had no boundary Cell to measure from
+// -----------------------------------------------------------------------------
+static size_t CompareWithBruteForce(VoxelDataContainer::Pointer m)
+{
+  int64_t xp = m->getXPoints(), yp = m->getYPoints(), zp = m->getZPoints();
+  int64_t totalPoints = m->getTotalPoints();
+  float res[3];
+  m->getResolution(res);
+  float minRes = std::min(res[0], std::min(res[1], res[2]));
+  double spacing[3] = { res[0] / minRes, res[1] / minRes, res[2] / minRes };
+
+  int32_t* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get())->GetPointer(0);
+  int32_t* nearestNeighbors = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::NearestNeighbors).get())->GetPointer(0);
+  const std::string names[3] = { DREAM3D::CellData::GBEuclideanDistances, DREAM3D::CellData::TJEuclideanDistances, DREAM3D::CellData::QPEuclideanDistances };
+
+  std::vector<int> regions;
+  findRegions(grainIds, xp, yp, zp, regions);
+
+  size_t unreachable = 0;
+  for (int mapType = 0; mapType < 3; ++mapType)
+  {
+    float* distances = FloatArrayType::SafePointerDownCast(m->getCellData(names[mapType]).get())->GetPointer(0);
+    std::vector<int64_t> seeds;
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      bool isSeed = (grainIds[i] > 0 && countNeighborGrains(grainIds, i, xp, yp, zp) > static_cast<size_t>(mapType));
+      DREAM3D_REQUIRE_EQUAL(isSeed, (distances[i] == 0.0f))
+      if (isSeed == true) { seeds.push_back(i); }
+    }
+
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      if (grainIds[i] <= 0)
+      {
+        DREAM3D_REQUIRE_EQUAL(distances[i], -1.0f)
+        DREAM3D_REQUIRE_EQUAL(nearestNeighbors[i * 3 + mapType], 0)
+        continue;
+      }
+      if (distances[i] == 0.0f) { continue; }
+      double best = -1.0;
+      for (size_t s = 0; s < seeds.size(); ++s)
+      {
+        if (regions[seeds[s]] != regions[i]) { continue; }
+        double dx = spacing[0] * static_cast<double>(i % xp - seeds[s] % xp);
+        double dy = spacing[1] * static_cast<double>((i / xp) % yp - (seeds[s] / xp) % yp);
+        double dz = spacing[2] * static_cast<double>(i / (xp * yp) - seeds[s] / (xp * yp));
+        double d = sqrt(dx * dx + dy * dy + dz * dz);
+        if (best < 0.0 || d < best) { best = d; }
+      }
+      if (best < 0.0)
+      {
+        DREAM3D_REQUIRE_EQUAL(distances[i], -1.0f)
+        DREAM3D_REQUIRE_EQUAL(nearestNeighbors[i * 3 + mapType], -1)
+        ++unreachable;
+        continue;
+      }
+      DREAM3D_REQUIRED(fabs(distances[i] - best), <, 1.0e-4)
+
+      // The nearest neighbor must come from one of the closest boundary Cells
+      bool found = false;
+      for (size_t s = 0; s < seeds.size() && found == false; ++s)
+      {
+        if (regions[seeds[s]] != regions[i]) { continue; }
+        double dx = spacing[0] * static_cast<double>(i % xp - seeds[s] % xp);
+        double dy = spacing[1] * static_cast<double>((i / xp) % yp - (seeds[s] / xp) % yp);
+        double dz = spacing[2] * static_cast<double>(i / (xp * yp) - seeds[s] / (xp * yp));
+        double d = sqrt(dx * dx + dy * dy + dz * dz);
+        found = (fabs(d - best) < 1.0e-4 && nearestNeighbors[seeds[s] * 3 + mapType] == nearestNeighbors[i * 3 + mapType]);
+      }
+      DREAM3D_REQUIRE(found == true)
+    }
+  }
+  return unreachable;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestExactDistances()
+{
+  float res[3] = { 0.5f, 0.25f, 1.0f };
+  VoxelDataContainer::Pointer m = createDistanceMapVolume(15, 13, 9, res, false);
+  FindEuclideanDistMap::Pointer filter = FindEuclideanDistMap::New();
+  filter->setCalcManhattanDist(false);
+  filter->setVoxelDataContainer(m.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CompareWithBruteForce(m);
+}
+
+// -----------------------------------------------------------------------------
+// Cells with no grain block the distances like they do for the Manhattan distances
+// -----------------------------------------------------------------------------
+void TestExactDistancesWithBarriers()
+{
+  float res[3] = { 1.0f, 0.5f, 0.75f };
+  VoxelDataContainer::Pointer m = createDistanceMapVolume(15, 13, 9, res, true);
+  FindEuclideanDistMap::Pointer filter = FindEuclideanDistMap::New();
+  filter->setCalcManhattanDist(false);
+  filter->setVoxelDataContainer(m.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  DREAM3D_REQUIRED(CompareWithBruteForce(m), >, 0)
+
+  // The sealed off grain has no boundary of its own
+  float* gbDistances = FloatArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GBEuclideanDistances).get())->GetPointer(0);
+  size_t sealed = (1 * 13 + 1) * 15 + 13;
+  DREAM3D_REQUIRE_EQUAL(gbDistances[sealed], -1.0f)
+}
+
+// -----------------------------------------------------------------------------
+// With an isotropic resolution both options count in voxel steps, and the straight
+// line distance is never longer than the city-block one
+// -----------------------------------------------------------------------------
+void TestExactMatchesManhattanUnits()
+{
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+  VoxelDataContainer::Pointer exact = createDistanceMapVolume(15, 13, 9, res, true);
+  VoxelDataContainer::Pointer manhattan = createDistanceMapVolume(15, 13, 9, res, true);
+
+  FindEuclideanDistMap::Pointer filter = FindEuclideanDistMap::New();
+  filter->setCalcManhattanDist(false);
+  filter->setVoxelDataContainer(exact.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  filter->setCalcManhattanDist(true);
+  filter->setVoxelDataContainer(manhattan.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+  const std::string names[3] = { DREAM3D::CellData::GBEuclideanDistances, DREAM3D::CellData::TJEuclideanDistances, DREAM3D::CellData::QPEuclideanDistances };
+  int64_t totalPoints = exact->getTotalPoints();
+  for (int mapType = 0; mapType < 3; ++mapType)
+  {
+    float* e = FloatArrayType::SafePointerDownCast(exact->getCellData(names[mapType]).get())->GetPointer(0);
+    float* c = FloatArrayType::SafePointerDownCast(manhattan->getCellData(names[mapType]).get())->GetPointer(0);
+    for (int64_t i = 0; i < totalPoints; ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL((e[i] < 0.0f), (c[i] < 0.0f))
+      DREAM3D_REQUIRED(e[i], <=, c[i] + 1.0e-4f)
+      if (c[i] == 1.0f) { DREAM3D_REQUIRE_EQUAL(e[i], 1.0f) }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestExactDistances() )
+  DREAM3D_REGISTER_TEST( TestExactDistancesWithBarriers() )
+  DREAM3D_REGISTER_TEST( TestExactMatchesManhattanUnits() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
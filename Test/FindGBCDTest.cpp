@@ -0,0 +1,189 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/StatisticsFilters/FindGBCD.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+#define NUM_GRAINS 20
+#define NUM_FACES 3000
+
+// -----------------------------------------------------------------------------
+// Random grains of one cubic phase and random faces between them. The face areas
+// are multiples of 1/8 so the sums in the GBCD are exact in any order.
+// -----------------------------------------------------------------------------
+static void createGBCDInput(VoxelDataContainer* m, SurfaceMeshDataContainer* sm)
+{
+  unsigned long long int seed = 2468;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(NUM_GRAINS + 1, 3, DREAM3D::FieldData::EulerAngles);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(NUM_GRAINS + 1, DREAM3D::FieldData::Phases);
+  for (int g = 0; g <= NUM_GRAINS; ++g)
+  {
+    eulers->SetComponent(g, 0, static_cast<float>(rg.genrand_res53() * 2.0 * M_PI));
+    eulers->SetComponent(g, 1, static_cast<float>(acos(2.0 * rg.genrand_res53() - 1.0)));
+    eulers->SetComponent(g, 2, static_cast<float>(rg.genrand_res53() * 2.0 * M_PI));
+    phases->SetValue(g, 1);
+  }
+  m->addFieldData(DREAM3D::FieldData::EulerAngles, eulers);
+  m->addFieldData(DREAM3D::FieldData::Phases, phases);
+
+  typedef DataArray<unsigned int> XTalStructArrayType;
+  XTalStructArrayType::Pointer crystalStructures = XTalStructArrayType::CreateArray(2, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->SetValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->SetValue(1, Ebsd::CrystalStructure::Cubic_High);
+  m->addEnsembleData(DREAM3D::EnsembleData::CrystalStructures, crystalStructures);
+
+  // Only the face data is used, so the faces do not need real vertices
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray(3, DREAM3D::VertexData::SurfaceMeshNodes);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray(NUM_FACES, DREAM3D::FaceData::SurfaceMeshFaces);
+  Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(NUM_FACES, 2, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  DoubleArrayType::Pointer normals = DoubleArrayType::CreateArray(NUM_FACES, 3, DREAM3D::FaceData::SurfaceMeshFaceNormals);
+  DoubleArrayType::Pointer areas = DoubleArrayType::CreateArray(NUM_FACES, DREAM3D::FaceData::SurfaceMeshFaceAreas);
+  for (int t = 0; t < NUM_FACES; ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    f.verts[0] = 0;
+    f.verts[1] = 1;
+    f.verts[2] = 2;
+    int grain1 = 1 + static_cast<int>(rg.genrand_int32() % NUM_GRAINS);
+    int grain2 = 1 + static_cast<int>(rg.genrand_int32() % (NUM_GRAINS - 1));
+    if (grain2 >= grain1) { ++grain2; }
+    labels->SetComponent(t, 0, grain1);
+    labels->SetComponent(t, 1, grain2);
+    double n[3] = { rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5 };
+    double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for (int c = 0; c < 3; ++c)
+    {
+      normals->SetComponent(t, c, n[c] / length);
+    }
+    areas->SetValue(t, (1 + rg.genrand_int32() % 8) / 8.0);
+  }
+  sm->setVertices(vertices);
+  sm->setFaces(faces);
+  sm->addFaceData(DREAM3D::FaceData::SurfaceMeshFaceLabels, labels);
+  sm->addFaceData(DREAM3D::FaceData::SurfaceMeshFaceNormals, normals);
+  sm->addFaceData(DREAM3D::FaceData::SurfaceMeshFaceAreas, areas);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static std::vector<double> runFindGBCD(int numThreads, uint64_t memory)
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  createGBCDInput(m.get(), sm.get());
+
+  FindGBCD::Pointer filter = FindGBCD::New();
+  filter->setVoxelDataContainer(m.get());
+  filter->setSurfaceMeshDataContainer(sm.get());
+  filter->setNumThreads(numThreads);
+  filter->setThreadHistogramMemory(memory);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+  DoubleArrayType* gbcd = DoubleArrayType::SafePointerDownCast(sm->getEnsembleData(DREAM3D::EnsembleData::GBCD).get());
+  DREAM3D_REQUIRE(NULL != gbcd);
+  return std::vector<double>(gbcd->GetPointer(0), gbcd->GetPointer(0) + gbcd->GetSize());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestThreadsForHistograms()
+{
+  DREAM3D_REQUIRE_EQUAL(FindGBCD::ThreadsForHistograms(1000, 4, 1000000), 4);
+  DREAM3D_REQUIRE_EQUAL(FindGBCD::ThreadsForHistograms(1000, 4, 4000), 4);
+  DREAM3D_REQUIRE_EQUAL(FindGBCD::ThreadsForHistograms(1000, 4, 2500), 2);
+  DREAM3D_REQUIRE_EQUAL(FindGBCD::ThreadsForHistograms(1000, 4, 999), 1);
+  DREAM3D_REQUIRE_EQUAL(FindGBCD::ThreadsForHistograms(1000, 1, 1000000), 1);
+}
+
+// -----------------------------------------------------------------------------
+//  The histograms of several threads summed together give the same GBCD as the
+//  serial path, also when the memory cap leaves fewer threads than were asked for
+// -----------------------------------------------------------------------------
+void TestThreadGBCDMatchesSerial()
+{
+  const uint64_t k_Unlimited = 1024 * 1024 * 1024;
+  std::vector<double> serial = runFindGBCD(1, k_Unlimited);
+  // The default 9 degree bins give 400000 bins per histogram
+  const uint64_t k_HistogramBytes = 400000 * sizeof(double);
+  std::vector<double> fourThreads = runFindGBCD(4, k_Unlimited);
+  std::vector<double> cappedThreads = runFindGBCD(4, k_HistogramBytes * 2 + k_HistogramBytes / 2);
+  std::vector<double> cappedToSerial = runFindGBCD(4, k_HistogramBytes / 2);
+
+  DREAM3D_REQUIRE(serial.empty() == false);
+  double total = 0.0;
+  for (size_t i = 0; i < serial.size(); ++i)
+  {
+    total += serial[i];
+  }
+  DREAM3D_REQUIRE(total > 0.0);
+  DREAM3D_REQUIRE(fourThreads == serial);
+  DREAM3D_REQUIRE(cappedThreads == serial);
+  DREAM3D_REQUIRE(cappedToSerial == serial);
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestThreadsForHistograms() )
+  DREAM3D_REGISTER_TEST( TestThreadGBCDMatchesSerial() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
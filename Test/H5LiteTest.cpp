@@ -104,6 +104,7 @@ void RemoveTestFiles()
 #if REMOVE_TEST_FILES
   MXADir::remove(UnitTest::H5LiteTest::FileName);
   MXADir::remove(UnitTest::H5LiteTest::LargeFile);
+  MXADir::remove(UnitTest::H5LiteTest::ChunkedFile);
 #endif
 }
 
@@ -1150,6 +1151,98 @@ void TestLargeFileSupport()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestChunkDims()
+{
+  H5Lite::ChunkedWriteOptions options;
+  hsize_t dims[2] = { 1000000, 3 };
+  hsize_t chunkDims[2] = { 0, 0 };
+
+  // 1 MB of 3 component floats
+  H5Lite::computeChunkDims(2, dims, sizeof(float), options, chunkDims);
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], (1024 * 1024) / (3 * sizeof(float)) )
+  DREAM3D_REQUIRE_EQUAL(chunkDims[1], 3)
+
+  // Whole slices of a 100 x 100 volume
+  options.ChunkDim0Multiple = 100 * 100;
+  H5Lite::computeChunkDims(2, dims, sizeof(float), options, chunkDims);
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], 80000)
+
+  // A slice larger than the target still gives one slice per chunk
+  options.TargetChunkBytes = 1024;
+  H5Lite::computeChunkDims(2, dims, sizeof(float), options, chunkDims);
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], 10000)
+
+  // Chunks never exceed the dataset
+  dims[0] = 10;
+  H5Lite::computeChunkDims(2, dims, sizeof(float), options, chunkDims);
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], 10)
+
+  // Explicit chunk dimensions are clamped to the dataset
+  options.ChunkDims.push_back(64);
+  options.ChunkDims.push_back(0);
+  H5Lite::computeChunkDims(2, dims, sizeof(float), options, chunkDims);
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], 10)
+  DREAM3D_REQUIRE_EQUAL(chunkDims[1], 1)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestChunkedDatasetWrite()
+{
+  hid_t file_id = H5Fcreate(UnitTest::H5LiteTest::ChunkedFile.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  DREAM3D_REQUIRE(file_id > 0);
+
+  // A 64 x 32 x 16 volume of grain ids which compresses very well
+  size_t numTuples = 64 * 32 * 16;
+  std::vector<int32_t> data(numTuples, 0);
+  for (size_t i = 0; i < numTuples; ++i)
+  {
+    data[i] = static_cast<int32_t>(i / 500);
+  }
+  int32_t rank = 1;
+  hsize_t dims[1] = { numTuples };
+
+  H5Lite::ChunkedWriteOptions options;
+  options.DeflateLevel = 6;
+  options.Shuffle = true;
+  options.TargetChunkBytes = 64 * 32 * 4 * sizeof(int32_t);
+  options.ChunkDim0Multiple = 64 * 32;
+  options.ChunkCacheBytes = 4 * 1024 * 1024;
+  herr_t err = H5Lite::writePointerDatasetChunked(file_id, "GrainIds", rank, dims, &(data.front()), options);
+  DREAM3D_REQUIRE(err >= 0);
+
+  // Zero sized datasets fall back to the contiguous layout
+  hsize_t emptyDims[1] = { 0 };
+  err = H5Lite::writePointerDatasetChunked(file_id, "Empty", rank, emptyDims, &(data.front()), options);
+  DREAM3D_REQUIRE(err >= 0);
+
+  std::vector<int32_t> rData(numTuples, -1);
+  err = H5Lite::readPointerDataset(file_id, "GrainIds", &(rData.front()));
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(data == rData);
+
+  hid_t did = H5Dopen(file_id, "GrainIds", H5P_DEFAULT);
+  DREAM3D_REQUIRE(did > 0);
+  hid_t dcpl = H5Dget_create_plist(did);
+  DREAM3D_REQUIRE_EQUAL(H5Pget_layout(dcpl), H5D_CHUNKED)
+  hsize_t chunkDims[1] = { 0 };
+  DREAM3D_REQUIRE_EQUAL(H5Pget_chunk(dcpl, 1, chunkDims), 1)
+  DREAM3D_REQUIRE_EQUAL(chunkDims[0], 64 * 32 * 4)
+  if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    DREAM3D_REQUIRE(H5Dget_storage_size(did) < numTuples * sizeof(int32_t));
+  }
+  H5Pclose(dcpl);
+  H5Dclose(did);
+
+  err = H5Fclose(file_id);
+  DREAM3D_REQUIRE(err >= 0);
+}
+
 #define TYPE_DETECTION(m_msgType, check)\
 {\
   m_msgType v = 0x00;\
@@ -1197,6 +1290,8 @@ int main(int argc, char **argv)
   int err = EXIT_SUCCESS;
   DREAM3D_REGISTER_TEST( TestTypeDetection() )
   DREAM3D_REGISTER_TEST( H5LiteTest() )
+  DREAM3D_REGISTER_TEST( TestChunkDims() )
+  DREAM3D_REGISTER_TEST( TestChunkedDatasetWrite() )
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
 
   PRINT_TEST_SUMMARY();
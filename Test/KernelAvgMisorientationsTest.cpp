@@ -0,0 +1,183 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/OrientationOps/OrientationOps.h"
+#include "DREAM3DLib/StatisticsFilters/FindKernelAvgMisorientations.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const int64_t k_Dims[3] = { 19, 16, 13 };
+
+// -----------------------------------------------------------------------------
+// Slab grains (one cubic, one hexagonal) with slightly scattered orientations and
+// a few Cells without a grain or phase
+// -----------------------------------------------------------------------------
+static VoxelDataContainer::Pointer createKernelVolume()
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = { static_cast<size_t>(k_Dims[0]), static_cast<size_t>(k_Dims[1]), static_cast<size_t>(k_Dims[2]) };
+  m->setDimensions(dims);
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  unsigned long long int seed = 4242;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, 4, DREAM3D::CellData::Quats);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::Phases);
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    int64_t x = i % dims[0], y = (i / dims[0]) % dims[1], z = i / (dims[0] * dims[1]);
+    int32_t grain = 1 + static_cast<int32_t>((x + 2 * y + 3 * z) / 11) % 4;
+    float random = static_cast<float>(rg.genrand_res53());
+    grainIds->SetValue(i, random < 0.04f ? 0 : grain);
+    phases->SetValue(i, (random > 0.04f && random < 0.06f) ? 0 : 1 + grain % 2);
+    float q[4] = { 0.2f * grain, 0.5f, -0.3f, 0.6f - 0.1f * grain };
+    float norm = 0.0f;
+    for (int c = 0; c < 4; ++c)
+    {
+      q[c] += 0.05f * static_cast<float>(rg.genrand_res53() - 0.5);
+      norm += q[c] * q[c];
+    }
+    for (int c = 0; c < 4; ++c)
+    {
+      quats->SetComponent(i, c, q[c] / sqrtf(norm));
+    }
+  }
+  m->addCellData(DREAM3D::CellData::Quats, quats);
+  m->addCellData(DREAM3D::CellData::Phases, phases);
+  m->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+
+  DataArray<unsigned int>::Pointer crystalStructures = DataArray<unsigned int>::CreateArray(3, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->SetValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->SetValue(1, Ebsd::CrystalStructure::Cubic_High);
+  crystalStructures->SetValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+  m->addEnsembleData(DREAM3D::EnsembleData::CrystalStructures, crystalStructures);
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+// Every Cell measured against its whole kernel, one pair at a time
+// -----------------------------------------------------------------------------
+void TestKernelSize(int kx, int ky, int kz)
+{
+  VoxelDataContainer::Pointer m = createKernelVolume();
+  FindKernelAvgMisorientations::Pointer filter = FindKernelAvgMisorientations::New();
+  filter->setVoxelDataContainer(m.get());
+  IntVec3Widget_t kernelSize;
+  kernelSize.x = kx;
+  kernelSize.y = ky;
+  kernelSize.z = kz;
+  filter->setKernelSize(kernelSize);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+  QuatF* quats = reinterpret_cast<QuatF*>(FloatArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::Quats).get())->GetPointer(0));
+  int32_t* phases = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::Phases).get())->GetPointer(0);
+  int32_t* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get())->GetPointer(0);
+  float* kam = FloatArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::KernelAverageMisorientations).get())->GetPointer(0);
+  unsigned int xtal[3] = { Ebsd::CrystalStructure::UnknownCrystalStructure, Ebsd::CrystalStructure::Cubic_High, Ebsd::CrystalStructure::Hexagonal_High };
+  std::vector<OrientationOps::Pointer> ops = OrientationOps::getOrientationOpsVector();
+
+  float n1, n2, n3;
+  for (int64_t z = 0; z < k_Dims[2]; ++z)
+  {
+    for (int64_t y = 0; y < k_Dims[1]; ++y)
+    {
+      for (int64_t x = 0; x < k_Dims[0]; ++x)
+      {
+        int64_t point = (z * k_Dims[1] + y) * k_Dims[0] + x;
+        float expected = 0.0f;
+        if (grainIds[point] > 0 && phases[point] > 0)
+        {
+          double total = 0.0;
+          int count = 0;
+          for (int64_t j = z - kz; j <= z + kz; ++j)
+          {
+            for (int64_t k = y - ky; k <= y + ky; ++k)
+            {
+              for (int64_t l = x - kx; l <= x + kx; ++l)
+              {
+                if (j < 0 || k < 0 || l < 0 || j >= k_Dims[2] || k >= k_Dims[1] || l >= k_Dims[0]) { continue; }
+                int64_t neighbor = (j * k_Dims[1] + k) * k_Dims[0] + l;
+                if (grainIds[neighbor] != grainIds[point]) { continue; }
+                total += ops[xtal[phases[point]]]->getMisoQuat(quats[point], quats[neighbor], n1, n2, n3) * (180.0f/DREAM3D::Constants::k_Pi);
+                count++;
+              }
+            }
+          }
+          expected = static_cast<float>(total / count);
+        }
+        DREAM3D_REQUIRE(fabs(kam[point] - expected) < 1.0e-3f)
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestKernels()
+{
+  TestKernelSize(1, 1, 1);
+  TestKernelSize(3, 1, 2);
+  TestKernelSize(0, 2, 0);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestKernels() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,181 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <iostream>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/SurfaceMeshStructs.h"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/SurfaceMeshingFilters/LaplacianSmoothing.h"
+
+#include "UnitTestSupport.hpp"
+
+// -----------------------------------------------------------------------------
+// Builds a flat nx by ny patch of triangles in the XY plane. The outer ring of
+// vertices is marked as surface nodes and the interior vertices are pushed
+// off the plane by a pseudo random amount.
+// -----------------------------------------------------------------------------
+SurfaceMeshDataContainer::Pointer createNoisyPatch(int nx, int ny)
+{
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray(nx * ny, DREAM3D::VertexData::SurfaceMeshNodes);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray((nx - 1) * (ny - 1) * 2, DREAM3D::FaceData::SurfaceMeshFaces);
+  DataArray<int8_t>::Pointer nodeTypes = DataArray<int8_t>::CreateArray(nx * ny, DREAM3D::VertexData::SurfaceMeshNodeType);
+
+  unsigned int seed = 12345;
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      int v = j * nx + i;
+      bool surface = (i == 0 || j == 0 || i == nx - 1 || j == ny - 1);
+      seed = seed * 1103515245 + 12345;
+      DREAM3D::SurfaceMesh::Vert_t& vert = *(vertices->GetPointer(v));
+      vert.pos[0] = static_cast<float>(i);
+      vert.pos[1] = static_cast<float>(j);
+      vert.pos[2] = surface ? 0.0f : static_cast<float>((seed >> 16) & 0x7FFF) / 32767.0f - 0.5f;
+      nodeTypes->SetValue(v, surface ? DREAM3D::SurfaceMesh::NodeType::SurfaceDefault : DREAM3D::SurfaceMesh::NodeType::Default);
+    }
+  }
+  int t = 0;
+  for (int j = 0; j < ny - 1; ++j)
+  {
+    for (int i = 0; i < nx - 1; ++i)
+    {
+      int n0 = j * nx + i;
+      int tris[2][3] = { { n0, n0 + 1, n0 + nx + 1 }, { n0, n0 + nx + 1, n0 + nx } };
+      for (int k = 0; k < 2; ++k)
+      {
+        DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+        f.verts[0] = tris[k][0];
+        f.verts[1] = tris[k][1];
+        f.verts[2] = tris[k][2];
+        ++t;
+      }
+    }
+  }
+  sm->setVertices(vertices);
+  sm->setFaces(faces);
+  sm->addVertexData(nodeTypes->GetName(), nodeTypes);
+  return sm;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LaplacianSmoothing::Pointer createSmoothingFilter(SurfaceMeshDataContainer* sm, int iterations)
+{
+  LaplacianSmoothing::Pointer filter = LaplacianSmoothing::New();
+  filter->setSurfaceMeshDataContainer(sm);
+  filter->setIterationSteps(iterations);
+  filter->setLambda(0.25f);
+  filter->setSurfacePointLambda(0.0f);
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestReorderedSmoothing()
+{
+  SurfaceMeshDataContainer::Pointer edgeMesh = createNoisyPatch(40, 30);
+  SurfaceMeshDataContainer::Pointer reorderedMesh = createNoisyPatch(40, 30);
+
+  LaplacianSmoothing::Pointer filter = createSmoothingFilter(edgeMesh.get(), 25);
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+  filter = createSmoothingFilter(reorderedMesh.get(), 25);
+  filter->setReorderVertices(true);
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+  // Both versions must produce the same positions in the original vertex order
+  DREAM3D::SurfaceMesh::VertListPointer_t edgeVerts = edgeMesh->getVertices();
+  DREAM3D::SurfaceMesh::VertListPointer_t reorderedVerts = reorderedMesh->getVertices();
+  for (size_t v = 0; v < edgeVerts->GetNumberOfTuples(); ++v)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      DREAM3D_REQUIRE(fabs(edgeVerts->GetPointer(v)->pos[j] - reorderedVerts->GetPointer(v)->pos[j]) < 1.0e-4);
+    }
+  }
+  // The temporary unique edges are removed again
+  DREAM3D_REQUIRE(reorderedMesh->getEdgeData(DREAM3D::EdgeData::SurfaceMeshUniqueEdges).get() == NULL);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestConvergenceTolerance()
+{
+  for (int reorder = 0; reorder < 2; ++reorder)
+  {
+    SurfaceMeshDataContainer::Pointer sm = createNoisyPatch(20, 20);
+    // With the outer ring locked the patch relaxes back into the plane. The
+    // tolerance has to stop the filter long before the iteration count.
+    LaplacianSmoothing::Pointer filter = createSmoothingFilter(sm.get(), 100000000);
+    filter->setReorderVertices(reorder == 1);
+    filter->setConvergenceTolerance(1.0e-6f);
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    DREAM3D::SurfaceMesh::VertListPointer_t vertices = sm->getVertices();
+    for (size_t v = 0; v < vertices->GetNumberOfTuples(); ++v)
+    {
+      DREAM3D_REQUIRE(fabs(vertices->GetPointer(v)->pos[2]) < 1.0e-3);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestReorderedSmoothing() )
+  DREAM3D_REGISTER_TEST( TestConvergenceTolerance() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
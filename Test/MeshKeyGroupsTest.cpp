@@ -0,0 +1,266 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/SurfaceMeshStructs.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshKeyGroups.hpp"
+#include "DREAM3DLib/SurfaceMeshingFilters/SharedGrainFaceFilter.h"
+
+#include "UnitTestSupport.hpp"
+
+typedef std::pair<uint64_t, int32_t> KeyValue_t;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool lessKey(const KeyValue_t &a, const KeyValue_t &b)
+{
+  return a.first < b.first;
+}
+
+// -----------------------------------------------------------------------------
+// Builds a nx by ny grid of quads, each split into 2 triangles
+// -----------------------------------------------------------------------------
+SurfaceMeshDataContainer::Pointer createGridMesh(int nx, int ny)
+{
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray((nx + 1) * (ny + 1), DREAM3D::VertexData::SurfaceMeshNodes);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray(nx * ny * 2, DREAM3D::FaceData::SurfaceMeshFaces);
+  DataArray<int32_t>::Pointer faceLabels = DataArray<int32_t>::CreateArray(nx * ny * 2, 2, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  for (int j = 0; j <= ny; ++j)
+  {
+    for (int i = 0; i <= nx; ++i)
+    {
+      DREAM3D::SurfaceMesh::Vert_t& v = *(vertices->GetPointer(j * (nx + 1) + i));
+      v.pos[0] = static_cast<float>(i);
+      v.pos[1] = static_cast<float>(j);
+      v.pos[2] = 0.0f;
+    }
+  }
+  srand(11);
+  int t = 0;
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      int n0 = j * (nx + 1) + i;
+      int n1 = n0 + 1;
+      int n2 = n0 + nx + 1;
+      int n3 = n2 + 1;
+      int tris[2][3] = { { n0, n1, n3 }, { n0, n3, n2 } };
+      for (int k = 0; k < 2; ++k)
+      {
+        DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+        f.verts[0] = tris[k][0];
+        f.verts[1] = tris[k][1];
+        f.verts[2] = tris[k][2];
+        // A handful of grains including the "outside" label of -1
+        faceLabels->SetComponent(t, 0, rand() % 7 - 1);
+        faceLabels->SetComponent(t, 1, rand() % 7 - 1);
+        ++t;
+      }
+    }
+  }
+  sm->setVertices(vertices);
+  sm->setFaces(faces);
+  sm->addFaceData(faceLabels->GetName(), faceLabels);
+  return sm;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSortKeys()
+{
+  // Enough keys for several blocks of the radix sort and a mix of small keys,
+  // keys that differ only in the high bytes and plenty of duplicates
+  size_t numKeys = 300000;
+  std::vector<uint64_t> keys(numKeys);
+  std::vector<int32_t> values(numKeys);
+  std::vector<KeyValue_t> expected(numKeys);
+  srand(3);
+  for (size_t i = 0; i < numKeys; ++i)
+  {
+    uint64_t key = static_cast<uint64_t>(rand() % 5000);
+    if (i % 3 == 0) { key |= static_cast<uint64_t>(rand() % 300) << 40; }
+    if (i % 7 == 0) { key |= static_cast<uint64_t>(rand() % 4) << 62; }
+    keys[i] = key;
+    values[i] = static_cast<int32_t>(i);
+    expected[i] = KeyValue_t(key, static_cast<int32_t>(i));
+  }
+  std::stable_sort(expected.begin(), expected.end(), lessKey);
+
+  std::vector<uint64_t> sortedKeys(keys);
+  std::vector<int32_t> noValues;
+  MeshKeyGroups::SortKeys(sortedKeys, noValues);
+  MeshKeyGroups::SortKeys(keys, values);
+  DREAM3D_REQUIRE_EQUAL(keys.size(), numKeys);
+  DREAM3D_REQUIRE_EQUAL(values.size(), numKeys);
+  DREAM3D_REQUIRE_EQUAL(noValues.size(), 0);
+  for (size_t i = 0; i < numKeys; ++i)
+  {
+    DREAM3D_REQUIRE_EQUAL(keys[i], expected[i].first);
+    DREAM3D_REQUIRE_EQUAL(values[i], expected[i].second);
+    DREAM3D_REQUIRE_EQUAL(sortedKeys[i], expected[i].first);
+  }
+
+  // Grouping the sorted keys
+  std::vector<uint64_t> groupKeys(numKeys);
+  std::vector<int32_t> groupValues(numKeys);
+  for (size_t i = 0; i < numKeys; ++i)
+  {
+    groupKeys[i] = expected[numKeys - 1 - i].first;
+    groupValues[i] = static_cast<int32_t>(i);
+  }
+  MeshKeyGroups::Pointer groups = MeshKeyGroups::New();
+  groups->generate(groupKeys, groupValues);
+  size_t total = 0;
+  for (size_t g = 0; g < groups->getNumberOfGroups(); ++g)
+  {
+    if (g > 0) { DREAM3D_REQUIRE(groups->getKey(g - 1) < groups->getKey(g)); }
+    int32_t* v = groups->getGroupValues(g);
+    for (size_t i = 0; i < groups->getGroupSize(g); ++i)
+    {
+      DREAM3D_REQUIRE_EQUAL(expected[numKeys - 1 - v[i]].first, groups->getKey(g));
+      if (i > 0) { DREAM3D_REQUIRE(v[i - 1] < v[i]); }
+    }
+    total += groups->getGroupSize(g);
+  }
+  DREAM3D_REQUIRE_EQUAL(total, numKeys);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFaceEdges()
+{
+  SurfaceMeshDataContainer::Pointer sm = createGridMesh(40, 30);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = sm->getFaces();
+
+  std::map<uint64_t, std::set<int32_t> > expected;
+  for (size_t t = 0; t < faces->GetNumberOfTuples(); ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    for (int e = 0; e < 3; ++e)
+    {
+      expected[MeshKeyGroups::PairKey(f.verts[e], f.verts[(e + 1) % 3])].insert(static_cast<int32_t>(t));
+    }
+  }
+
+  MeshKeyGroups::Pointer groups = MeshKeyGroups::New();
+  groups->generateFaceEdges(faces);
+  DREAM3D_REQUIRE_EQUAL(groups->getNumberOfGroups(), expected.size());
+  size_t g = 0;
+  for (std::map<uint64_t, std::set<int32_t> >::iterator iter = expected.begin(); iter != expected.end(); ++iter, ++g)
+  {
+    DREAM3D_REQUIRE_EQUAL(groups->getKey(g), (*iter).first);
+    DREAM3D_REQUIRE(MeshKeyGroups::PairKeyLow(groups->getKey(g)) < MeshKeyGroups::PairKeyHigh(groups->getKey(g)));
+    std::set<int32_t>& triangles = (*iter).second;
+    DREAM3D_REQUIRE_EQUAL(groups->getGroupSize(g), triangles.size());
+    DREAM3D_REQUIRE(std::equal(triangles.begin(), triangles.end(), groups->getGroupValues(g)));
+  }
+
+  MeshKeyGroups::Pointer edges = MeshKeyGroups::New();
+  edges->generateFaceEdges(faces, false);
+  DREAM3D_REQUIRE(edges->getKeys() == groups->getKeys());
+  DREAM3D_REQUIRE_EQUAL(edges->getValues().size(), 0);
+  DREAM3D_REQUIRE(edges->getGroupValues(0) == NULL);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSharedGrainFaces()
+{
+  SurfaceMeshDataContainer::Pointer sm = createGridMesh(50, 50);
+  DataArray<int32_t>* faceLabels = DataArray<int32_t>::SafePointerDownCast(sm->getFaceData(DREAM3D::FaceData::SurfaceMeshFaceLabels).get());
+  size_t numFaces = faceLabels->GetNumberOfTuples();
+
+  // Grain face ids are handed out in the order each pair of labels is first seen
+  std::map<uint64_t, int32_t> faceIdMap;
+  std::vector<int32_t> expectedIds(numFaces);
+  SharedGrainFaceFilter::SharedGrainFaces_t expectedFaces;
+  for (size_t t = 0; t < numFaces; ++t)
+  {
+    uint64_t key = MeshKeyGroups::PairKey(faceLabels->GetComponent(t, 0), faceLabels->GetComponent(t, 1));
+    if (faceIdMap.find(key) == faceIdMap.end())
+    {
+      int32_t id = static_cast<int32_t>(faceIdMap.size());
+      faceIdMap[key] = id;
+    }
+    expectedIds[t] = faceIdMap[key];
+    expectedFaces[expectedIds[t]].push_back(static_cast<int>(t));
+  }
+
+  SharedGrainFaceFilter::Pointer filter = SharedGrainFaceFilter::New();
+  filter->setSurfaceMeshDataContainer(sm.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+  DataArray<int32_t>* grainFaceIds = DataArray<int32_t>::SafePointerDownCast(sm->getFaceData(DREAM3D::FaceData::SurfaceMeshGrainFaceId).get());
+  DREAM3D_REQUIRE_NE(NULL, grainFaceIds);
+  for (size_t t = 0; t < numFaces; ++t)
+  {
+    DREAM3D_REQUIRE_EQUAL(grainFaceIds->GetValue(t), expectedIds[t]);
+  }
+  DREAM3D_REQUIRE(filter->getSharedGrainFaces() == expectedFaces);
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestSortKeys() )
+  DREAM3D_REGISTER_TEST( TestFaceEdges() )
+  DREAM3D_REGISTER_TEST( TestSharedGrainFaces() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
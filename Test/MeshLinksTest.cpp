@@ -0,0 +1,320 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "H5Support/H5Lite.h"
+
+#include "MXA/Utilities/MXADir.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/SurfaceMeshStructs.h"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/IOFilters/SurfaceMeshDataContainerReader.h"
+#include "DREAM3DLib/IOFilters/SurfaceMeshDataContainerWriter.h"
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshVertLinks.hpp"
+#include "DREAM3DLib/SurfaceMeshingFilters/MeshFaceNeighbors.hpp"
+
+#include "UnitTestSupport.hpp"
+#include "TestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+  MXADir::remove(UnitTest::MeshLinksTest::TestFile);
+}
+
+// -----------------------------------------------------------------------------
+// Builds a closed torus shaped mesh from a nx by ny grid of quads, each split
+// into 2 triangles, so every triangle has exactly 3 neighbors.
+// -----------------------------------------------------------------------------
+SurfaceMeshDataContainer::Pointer createTorusMesh(int nx, int ny)
+{
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray(nx * ny, DREAM3D::VertexData::SurfaceMeshNodes);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray(nx * ny * 2, DREAM3D::FaceData::SurfaceMeshFaces);
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      DREAM3D::SurfaceMesh::Vert_t& v = *(vertices->GetPointer(j * nx + i));
+      v.pos[0] = static_cast<float>(i);
+      v.pos[1] = static_cast<float>(j);
+      v.pos[2] = 0.0f;
+    }
+  }
+  int t = 0;
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      int n0 = j * nx + i;
+      int n1 = j * nx + (i + 1) % nx;
+      int n2 = ((j + 1) % ny) * nx + i;
+      int n3 = ((j + 1) % ny) * nx + (i + 1) % nx;
+      int tris[2][3] = { { n0, n1, n3 }, { n0, n3, n2 } };
+      for (int k = 0; k < 2; ++k)
+      {
+        DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+        f.verts[0] = tris[k][0];
+        f.verts[1] = tris[k][1];
+        f.verts[2] = tris[k][2];
+        ++t;
+      }
+    }
+  }
+  sm->setVertices(vertices);
+  sm->setFaces(faces);
+  return sm;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMeshVertLinks()
+{
+  SurfaceMeshDataContainer::Pointer sm = createTorusMesh(60, 45);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = sm->getFaces();
+  size_t nVerts = sm->getVertices()->GetNumberOfTuples();
+
+  std::vector<std::vector<int> > expected(nVerts);
+  for (size_t t = 0; t < faces->GetNumberOfTuples(); ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    for (int v = 0; v < 3; ++v)
+    {
+      expected[f.verts[v]].push_back(static_cast<int>(t));
+    }
+  }
+
+  sm->buildMeshVertLinks();
+  MeshVertLinks::Pointer links = sm->getMeshVertLinks();
+  DREAM3D_REQUIRE_EQUAL(links->getNumberOfPoints(), nVerts);
+  DREAM3D_REQUIRE_EQUAL(links->getOffsets().back(), static_cast<int64_t>(faces->GetNumberOfTuples() * 3));
+  for (size_t v = 0; v < nVerts; ++v)
+  {
+    DREAM3D_REQUIRE_EQUAL(links->getNumberOfFaces(v), expected[v].size());
+    DREAM3D_REQUIRE(std::equal(expected[v].begin(), expected[v].end(), links->getFaceListPointer(v)));
+    MeshVertLinks::FaceList list = links->getFaceList(v);
+    DREAM3D_REQUIRE_EQUAL(list.ncells, expected[v].size());
+    DREAM3D_REQUIRE_EQUAL(list.cells, links->getFaceListPointer(v));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMeshFaceNeighbors()
+{
+  SurfaceMeshDataContainer::Pointer sm = createTorusMesh(60, 45);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = sm->getFaces();
+  size_t nFaces = faces->GetNumberOfTuples();
+
+  // The neighbors of a triangle are the other triangles on its 3 edges
+  std::map<std::pair<int, int>, std::vector<int> > edgeFaces;
+  for (size_t t = 0; t < nFaces; ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    for (int e = 0; e < 3; ++e)
+    {
+      int a = std::min(f.verts[e], f.verts[(e + 1) % 3]);
+      int b = std::max(f.verts[e], f.verts[(e + 1) % 3]);
+      edgeFaces[std::make_pair(a, b)].push_back(static_cast<int>(t));
+    }
+  }
+
+  sm->buildMeshFaceNeighborLists();
+  MeshFaceNeighbors::Pointer neighbors = sm->getMeshFaceNeighborLists();
+  DREAM3D_REQUIRE_EQUAL(neighbors->getOffsets().size(), nFaces + 1);
+  for (size_t t = 0; t < nFaces; ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    std::set<int> expected;
+    for (int e = 0; e < 3; ++e)
+    {
+      int a = std::min(f.verts[e], f.verts[(e + 1) % 3]);
+      int b = std::max(f.verts[e], f.verts[(e + 1) % 3]);
+      std::vector<int>& shared = edgeFaces[std::make_pair(a, b)];
+      for (size_t i = 0; i < shared.size(); ++i)
+      {
+        if (shared[i] != static_cast<int>(t)) { expected.insert(shared[i]); }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(neighbors->getNumberOfFaces(t), 3);
+    int* list = neighbors->getNeighborListPointer(t);
+    std::set<int> found(list, list + neighbors->getNumberOfFaces(t));
+    DREAM3D_REQUIRE(found == expected);
+  }
+  // Building the neighbors on its own does not leave the vertex links behind
+  DREAM3D_REQUIRE(sm->getMeshVertLinks().get() == NULL);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMeshLinksReadWrite()
+{
+  SurfaceMeshDataContainer::Pointer sm = createTorusMesh(30, 20);
+  sm->buildMeshVertLinks();
+  sm->buildMeshFaceNeighborLists();
+
+  hid_t fileId = H5Fcreate(UnitTest::MeshLinksTest::TestFile.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  DREAM3D_REQUIRE(fileId > 0);
+  SurfaceMeshDataContainerWriter::Pointer writer = SurfaceMeshDataContainerWriter::New();
+  writer->setHdfFileId(fileId);
+  writer->setSurfaceMeshDataContainer(sm.get());
+  writer->execute();
+  DREAM3D_REQUIRE(writer->getErrorCondition() >= 0);
+
+  // The links are stored as 2 flat datasets
+  hid_t dcGid = H5Gopen(fileId, DREAM3D::HDF5::SurfaceMeshDataContainerName.c_str(), H5P_DEFAULT);
+  DREAM3D_REQUIRE(dcGid > 0);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshVertLinksFacesName), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsFaces), true);
+  H5Gclose(dcGid);
+
+  SurfaceMeshDataContainer::Pointer sm2 = SurfaceMeshDataContainer::New();
+  SurfaceMeshDataContainerReader::Pointer reader = SurfaceMeshDataContainerReader::New();
+  reader->setHdfFileId(fileId);
+  reader->setSurfaceMeshDataContainer(sm2.get());
+  reader->execute();
+  H5Fclose(fileId);
+
+  DREAM3D_REQUIRE(sm2->getMeshVertLinks().get() != NULL);
+  DREAM3D_REQUIRE(sm2->getMeshFaceNeighborLists().get() != NULL);
+  DREAM3D_REQUIRE(sm2->getMeshVertLinks()->getOffsets() == sm->getMeshVertLinks()->getOffsets());
+  DREAM3D_REQUIRE(sm2->getMeshVertLinks()->getCells() == sm->getMeshVertLinks()->getCells());
+  DREAM3D_REQUIRE(sm2->getMeshFaceNeighborLists()->getOffsets() == sm->getMeshFaceNeighborLists()->getOffsets());
+  DREAM3D_REQUIRE(sm2->getMeshFaceNeighborLists()->getCells() == sm->getMeshFaceNeighborLists()->getCells());
+}
+
+// -----------------------------------------------------------------------------
+// Links that hold no faces at all still write both flat datasets and read back
+// -----------------------------------------------------------------------------
+void TestEmptyLinksReadWrite()
+{
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = DREAM3D::SurfaceMesh::VertList_t::CreateArray(6, DREAM3D::VertexData::SurfaceMeshNodes);
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = DREAM3D::SurfaceMesh::FaceList_t::CreateArray(2, DREAM3D::FaceData::SurfaceMeshFaces);
+  for (int i = 0; i < 6; ++i)
+  {
+    DREAM3D::SurfaceMesh::Vert_t& v = *(vertices->GetPointer(i));
+    v.pos[0] = static_cast<float>(i % 3);
+    v.pos[1] = static_cast<float>(i / 3);
+    v.pos[2] = 0.0f;
+  }
+  for (int t = 0; t < 2; ++t)
+  {
+    DREAM3D::SurfaceMesh::Face_t& f = *(faces->GetPointer(t));
+    f.verts[0] = t * 3;
+    f.verts[1] = t * 3 + 1;
+    f.verts[2] = t * 3 + 2;
+  }
+  sm->setVertices(vertices);
+  sm->setFaces(faces);
+  std::vector<int64_t> offsets(7, 0);
+  std::vector<int32_t> cells;
+  MeshVertLinks::Pointer links = MeshVertLinks::New();
+  links->setLinks(offsets, cells);
+  sm->setMeshVertLinks(links);
+  offsets.assign(3, 0);
+  MeshFaceNeighbors::Pointer neighbors = MeshFaceNeighbors::New();
+  neighbors->setLinks(offsets, cells);
+  sm->setMeshFaceNeighborLists(neighbors);
+
+  hid_t fileId = H5Fcreate(UnitTest::MeshLinksTest::TestFile.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  DREAM3D_REQUIRE(fileId > 0);
+  SurfaceMeshDataContainerWriter::Pointer writer = SurfaceMeshDataContainerWriter::New();
+  writer->setHdfFileId(fileId);
+  writer->setSurfaceMeshDataContainer(sm.get());
+  writer->execute();
+  DREAM3D_REQUIRE(writer->getErrorCondition() >= 0);
+
+  hid_t dcGid = H5Gopen(fileId, DREAM3D::HDF5::SurfaceMeshDataContainerName.c_str(), H5P_DEFAULT);
+  DREAM3D_REQUIRE(dcGid > 0);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshVertLinksOffsetsName), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshVertLinksFacesName), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsOffsets), true);
+  DREAM3D_REQUIRE_EQUAL(H5Lite::datasetExists(dcGid, DREAM3D::HDF5::MeshFaceNeighborListsFaces), true);
+  H5Gclose(dcGid);
+
+  SurfaceMeshDataContainer::Pointer sm2 = SurfaceMeshDataContainer::New();
+  SurfaceMeshDataContainerReader::Pointer reader = SurfaceMeshDataContainerReader::New();
+  reader->setHdfFileId(fileId);
+  reader->setSurfaceMeshDataContainer(sm2.get());
+  reader->execute();
+  H5Fclose(fileId);
+
+  DREAM3D_REQUIRE(reader->getErrorCondition() >= 0);
+  DREAM3D_REQUIRE(sm2->getMeshVertLinks().get() != NULL);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshVertLinks()->getOffsets().size(), 7);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshVertLinks()->getCells().empty(), true);
+  DREAM3D_REQUIRE(sm2->getMeshFaceNeighborLists().get() != NULL);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshFaceNeighborLists()->getOffsets().size(), 3);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshFaceNeighborLists()->getOffsets().back(), 0);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshFaceNeighborLists()->getCells().empty(), true);
+  DREAM3D_REQUIRE_EQUAL(sm2->getMeshFaceNeighborLists()->getNumberOfFaces(1), 0);
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestMeshVertLinks() )
+  DREAM3D_REGISTER_TEST( TestMeshFaceNeighbors() )
+  DREAM3D_REGISTER_TEST( TestMeshLinksReadWrite() )
+  DREAM3D_REGISTER_TEST( TestEmptyLinksReadWrite() )
+#if REMOVE_TEST_FILES
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+#endif
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,335 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataArrays/NeighborList.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/OrientationOps/OrientationOps.h"
+#include "DREAM3DLib/StatisticsFilters/FindMisorientations.h"
+#include "DREAM3DLib/StatisticsFilters/FindNeighbors.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const int k_NumGrains = 12;
+
+// -----------------------------------------------------------------------------
+// Each Cell belongs to the nearest of a few random seeds, with a few Cells that
+// have no grain
+// -----------------------------------------------------------------------------
+static VoxelDataContainer::Pointer createNeighborListVolume(size_t xp, size_t yp, size_t zp, float* res)
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = { xp, yp, zp };
+  m->setDimensions(dims);
+  m->setResolution(res);
+  size_t totalPoints = xp * yp * zp;
+
+  unsigned long long int seed = 1357;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  float seeds[k_NumGrains][3];
+  for (int g = 0; g < k_NumGrains; ++g)
+  {
+    seeds[g][0] = static_cast<float>(rg.genrand_res53() * xp);
+    seeds[g][1] = static_cast<float>(rg.genrand_res53() * yp);
+    seeds[g][2] = static_cast<float>(rg.genrand_res53() * zp);
+  }
+
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    float x = static_cast<float>(i % xp), y = static_cast<float>((i / xp) % yp), z = static_cast<float>(i / (xp * yp));
+    int nearest = 0;
+    float nearestDist = -1.0f;
+    for (int g = 0; g < k_NumGrains; ++g)
+    {
+      float d = (x - seeds[g][0]) * (x - seeds[g][0]) + (y - seeds[g][1]) * (y - seeds[g][1]) + (z - seeds[g][2]) * (z - seeds[g][2]);
+      if (nearestDist < 0.0f || d < nearestDist) { nearest = g; nearestDist = d; }
+    }
+    grainIds->SetValue(i, rg.genrand_res53() < 0.03 ? 0 : nearest + 1);
+  }
+  m->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+  m->resizeFieldDataArrays(k_NumGrains + 1);
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+// The neighbors and shared areas as FindNeighbors found them with one vector per grain
+// -----------------------------------------------------------------------------
+static void findNeighborVectors(VoxelDataContainer* m, std::vector<std::vector<int> > &neighborlist,
+                                std::vector<std::vector<float> > &arealist, std::vector<int> &surfaceVoxels, std::vector<bool> &surfaceFields)
+{
+  int64_t xp = m->getXPoints(), yp = m->getYPoints(), zp = m->getZPoints();
+  int64_t totalPoints = m->getTotalPoints();
+  int32_t* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get())->GetPointer(0);
+  int64_t neighpoints[6] = { -xp * yp, -xp, -1, 1, xp, xp * yp };
+
+  std::vector<std::vector<int> > voxelNeighbors(k_NumGrains + 1);
+  surfaceVoxels.assign(totalPoints, 0);
+  surfaceFields.assign(k_NumGrains + 1, false);
+  for (int64_t j = 0; j < totalPoints; j++)
+  {
+    int grain = grainIds[j];
+    if (grain <= 0) { continue; }
+    int64_t column = j % xp, row = (j / xp) % yp, plane = j / (xp * yp);
+    if ((column == 0 || column == xp - 1 || row == 0 || row == yp - 1 || plane == 0 || plane == zp - 1) && zp != 1) { surfaceFields[grain] = true; }
+    if ((column == 0 || column == xp - 1 || row == 0 || row == yp - 1) && zp == 1) { surfaceFields[grain] = true; }
+    for (int k = 0; k < 6; k++)
+    {
+      if (k == 0 && plane == 0) { continue; }
+      if (k == 5 && plane == zp - 1) { continue; }
+      if (k == 1 && row == 0) { continue; }
+      if (k == 4 && row == yp - 1) { continue; }
+      if (k == 2 && column == 0) { continue; }
+      if (k == 3 && column == xp - 1) { continue; }
+      int neighbor = grainIds[j + neighpoints[k]];
+      if (neighbor != grain && neighbor > 0)
+      {
+        surfaceVoxels[j]++;
+        voxelNeighbors[grain].push_back(neighbor);
+      }
+    }
+  }
+
+  neighborlist.assign(k_NumGrains + 1, std::vector<int>());
+  arealist.assign(k_NumGrains + 1, std::vector<float>());
+  for (int i = 1; i <= k_NumGrains; i++)
+  {
+    std::map<int, int> neighToCount;
+    for (size_t j = 0; j < voxelNeighbors[i].size(); j++)
+    {
+      neighToCount[voxelNeighbors[i][j]]++;
+    }
+    for (std::map<int, int>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+    {
+      neighborlist[i].push_back(iter->first);
+      arealist[i].push_back(iter->second * m->getXRes() * m->getYRes());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static void CompareNeighbors(size_t xp, size_t yp, size_t zp, float* res)
+{
+  VoxelDataContainer::Pointer m = createNeighborListVolume(xp, yp, zp, res);
+  FindNeighbors::Pointer filter = FindNeighbors::New();
+  filter->setVoxelDataContainer(m.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+  std::vector<std::vector<int> > neighborlist;
+  std::vector<std::vector<float> > arealist;
+  std::vector<int> surfaceVoxels;
+  std::vector<bool> surfaceFields;
+  findNeighborVectors(m.get(), neighborlist, arealist, surfaceVoxels, surfaceFields);
+
+  NeighborList<int>* neighbors = NeighborList<int>::SafeObjectDownCast<IDataArray*, NeighborList<int>*>(m->getFieldData(DREAM3D::FieldData::NeighborList).get());
+  NeighborList<float>* areas = NeighborList<float>::SafeObjectDownCast<IDataArray*, NeighborList<float>*>(m->getFieldData(DREAM3D::FieldData::SharedSurfaceAreaList).get());
+  DREAM3D_REQUIRE(NULL != neighbors)
+  DREAM3D_REQUIRE(NULL != areas)
+  DREAM3D_REQUIRE_EQUAL(neighbors->isCompact(), true)
+  DREAM3D_REQUIRE_EQUAL(areas->isCompact(), true)
+  int32_t* numNeighbors = Int32ArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::NumNeighbors).get())->GetPointer(0);
+  bool* fieldsOnSurface = BoolArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::SurfaceFields).get())->GetPointer(0);
+  int8_t* voxelsOnSurface = Int8ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::SurfaceVoxels).get())->GetPointer(0);
+
+  for (int64_t j = 0; j < m->getTotalPoints(); j++)
+  {
+    DREAM3D_REQUIRE_EQUAL(static_cast<int>(voxelsOnSurface[j]), surfaceVoxels[j])
+  }
+  for (int i = 1; i <= k_NumGrains; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(fieldsOnSurface[i], surfaceFields[i])
+    DREAM3D_REQUIRE_EQUAL(numNeighbors[i], static_cast<int32_t>(neighborlist[i].size()))
+    DREAM3D_REQUIRE_EQUAL(neighbors->getListSize(i), static_cast<int>(neighborlist[i].size()))
+    DREAM3D_REQUIRE_EQUAL(areas->getListSize(i), static_cast<int>(arealist[i].size()))
+    const int* list = neighbors->getListPointer(i);
+    const float* areaList = areas->getListPointer(i);
+    for (size_t j = 0; j < neighborlist[i].size(); j++)
+    {
+      DREAM3D_REQUIRE_EQUAL(list[j], neighborlist[i][j])
+      DREAM3D_REQUIRE_EQUAL(areaList[j], arealist[i][j])
+    }
+  }
+
+  // Converting to one vector per list gives the same lists
+  neighbors->convertToVectors();
+  areas->convertToVectors();
+  DREAM3D_REQUIRE_EQUAL(neighbors->isCompact(), false)
+  for (int i = 1; i <= k_NumGrains; i++)
+  {
+    DREAM3D_REQUIRE(neighborlist[i] == (*neighbors)[i])
+    DREAM3D_REQUIRE(arealist[i] == (*areas)[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFindNeighbors()
+{
+  float res[3] = { 0.5f, 0.25f, 2.0f };
+  CompareNeighbors(23, 17, 11, res);
+  CompareNeighbors(31, 19, 1, res);
+  // The areas must match the old formula to the last bit, which a resolution that
+  // is not a power of 2 shows
+  float oddRes[3] = { 0.3f, 0.7f, 1.1f };
+  CompareNeighbors(23, 17, 11, oddRes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static void addOrientations(VoxelDataContainer* m)
+{
+  size_t numFields = m->getNumFieldTuples();
+  unsigned long long int seed = 97531;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(numFields, 4, DREAM3D::FieldData::AvgQuats);
+  Int32ArrayType::Pointer fieldPhases = Int32ArrayType::CreateArray(numFields, DREAM3D::FieldData::FieldPhases);
+  for (size_t i = 0; i < numFields; ++i)
+  {
+    float q[4];
+    float norm = 0.0f;
+    for (int c = 0; c < 4; ++c)
+    {
+      q[c] = static_cast<float>(rg.genrand_res53() - 0.5);
+      norm += q[c] * q[c];
+    }
+    for (int c = 0; c < 4; ++c)
+    {
+      avgQuats->SetComponent(i, c, q[c] / sqrtf(norm));
+    }
+    fieldPhases->SetValue(i, 1 + static_cast<int32_t>(i % 3 == 0));
+  }
+  m->addFieldData(DREAM3D::FieldData::AvgQuats, avgQuats);
+  m->addFieldData(DREAM3D::FieldData::FieldPhases, fieldPhases);
+
+  DataArray<unsigned int>::Pointer crystalStructures = DataArray<unsigned int>::CreateArray(3, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->SetValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->SetValue(1, Ebsd::CrystalStructure::Cubic_High);
+  crystalStructures->SetValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+  m->addEnsembleData(DREAM3D::EnsembleData::CrystalStructures, crystalStructures);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFindMisorientations()
+{
+  float res[3] = { 0.5f, 0.25f, 2.0f };
+  VoxelDataContainer::Pointer m = createNeighborListVolume(23, 17, 11, res);
+  FindNeighbors::Pointer neighborFilter = FindNeighbors::New();
+  neighborFilter->setVoxelDataContainer(m.get());
+  neighborFilter->execute();
+  DREAM3D_REQUIRE_EQUAL(neighborFilter->getErrorCondition(), 0)
+  addOrientations(m.get());
+
+  FindMisorientations::Pointer filter = FindMisorientations::New();
+  filter->setVoxelDataContainer(m.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+  NeighborList<int>* neighbors = NeighborList<int>::SafeObjectDownCast<IDataArray*, NeighborList<int>*>(m->getFieldData(DREAM3D::FieldData::NeighborList).get());
+  NeighborList<float>* misorientations = NeighborList<float>::SafeObjectDownCast<IDataArray*, NeighborList<float>*>(m->getFieldData(DREAM3D::FieldData::MisorientationList).get());
+  DREAM3D_REQUIRE(NULL != misorientations)
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(FloatArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::AvgQuats).get())->GetPointer(0));
+  int32_t* fieldPhases = Int32ArrayType::SafePointerDownCast(m->getFieldData(DREAM3D::FieldData::FieldPhases).get())->GetPointer(0);
+  unsigned int xtal[3] = { Ebsd::CrystalStructure::UnknownCrystalStructure, Ebsd::CrystalStructure::Cubic_High, Ebsd::CrystalStructure::Hexagonal_High };
+  std::vector<OrientationOps::Pointer> ops = OrientationOps::getOrientationOpsVector();
+  float n1, n2, n3;
+  for (int i = 1; i <= k_NumGrains; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(misorientations->getListSize(i), neighbors->getListSize(i))
+    for (int j = 0; j < neighbors->getListSize(i); j++)
+    {
+      bool ok = true;
+      int nname = neighbors->getValue(i, j, ok);
+      float expected = -100.0f;
+      if (xtal[fieldPhases[i]] == xtal[fieldPhases[nname]])
+      {
+        expected = ops[xtal[fieldPhases[i]]]->getMisoQuat(avgQuats[i], avgQuats[nname], n1, n2, n3) * (180.0f/DREAM3D::Constants::k_Pi);
+      }
+      DREAM3D_REQUIRE(fabs(misorientations->getValue(i, j, ok) - expected) < 1.0e-4f)
+    }
+  }
+
+  // A single grain has no neighbors so there are no misorientations at all
+  VoxelDataContainer::Pointer single = VoxelDataContainer::New();
+  size_t dims[3] = { 4, 3, 2 };
+  single->setDimensions(dims);
+  Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(24, DREAM3D::CellData::GrainIds);
+  grainIds->initializeWithValues(1);
+  single->addCellData(DREAM3D::CellData::GrainIds, grainIds);
+  single->resizeFieldDataArrays(2);
+  neighborFilter->setVoxelDataContainer(single.get());
+  neighborFilter->execute();
+  DREAM3D_REQUIRE_EQUAL(neighborFilter->getErrorCondition(), 0)
+  addOrientations(single.get());
+  filter->setVoxelDataContainer(single.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  misorientations = NeighborList<float>::SafeObjectDownCast<IDataArray*, NeighborList<float>*>(single->getFieldData(DREAM3D::FieldData::MisorientationList).get());
+  DREAM3D_REQUIRE_EQUAL(misorientations->GetSize(), 0)
+  DREAM3D_REQUIRE_EQUAL(misorientations->getListSize(1), 0)
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestFindNeighbors() )
+  DREAM3D_REGISTER_TEST( TestFindMisorientations() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -36,6 +36,7 @@
 
 
 #include <iostream>
+#include <vector>
 
 #include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/OrientationOps/OrientationOps.h"
@@ -44,6 +45,7 @@
 #include "DREAM3DLib/OrientationOps/HexagonalOps.h"
 #include "DREAM3DLib/OrientationOps/OrthoRhombicOps.h"
 #include "DREAM3DLib/OrientationOps/TrigonalOps.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
 
 #include "UnitTestSupport.hpp"
 #include "TestFileLocations.h"
@@ -186,6 +188,48 @@ void Rotations()
   std::cout << "MultiplyQuaternionVector: " << outVec[0] << ", " << outVec[1] << ", " << outVec[2] << std::endl;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMisoQuatBatch()
+{
+  const size_t numPairs = 100000;
+  DREAM3DRandom rg;
+  rg.init_genrand(12345);
+  std::vector<QuatF> q1(numPairs);
+  std::vector<QuatF> q2(numPairs);
+  for (size_t i = 0; i < numPairs; ++i)
+  {
+    q1[i] = QuaternionMathF::NewXYZW(rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5);
+    q2[i] = QuaternionMathF::NewXYZW(rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5);
+    QuaternionMathF::UnitQuaternion(q1[i]);
+    QuaternionMathF::UnitQuaternion(q2[i]);
+  }
+
+  std::vector<float> angles(numPairs);
+  std::vector<float> axes(numPairs * 3);
+  std::vector<float> anglesOnly(numPairs);
+  std::vector<OrientationOps::Pointer> ops = OrientationOps::getOrientationOpsVector();
+  for (size_t o = 0; o < ops.size(); ++o)
+  {
+    ops[o]->getMisoQuatBatch(&(q1.front()), &(q2.front()), numPairs, &(angles.front()), &(axes.front()));
+    ops[o]->getMisoQuatBatch(&(q1.front()), &(q2.front()), numPairs, &(anglesOnly.front()), NULL);
+
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+      QuatF a = q1[i];
+      QuatF b = q2[i];
+      float w = ops[o]->getMisoQuat(a, b, n1, n2, n3);
+      DREAM3D_REQUIRE_EQUAL(w, angles[i])
+      DREAM3D_REQUIRE_EQUAL(n1, axes[i * 3])
+      DREAM3D_REQUIRE_EQUAL(n2, axes[i * 3 + 1])
+      DREAM3D_REQUIRE_EQUAL(n3, axes[i * 3 + 2])
+      DREAM3D_REQUIRE_EQUAL(w, anglesOnly[i])
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //  Use test framework
 // -----------------------------------------------------------------------------
@@ -196,6 +240,7 @@ int main(int argc, char **argv) {
 
   DREAM3D_REGISTER_TEST( TestQuatMath() )
   DREAM3D_REGISTER_TEST( Rotations() )
+  DREAM3D_REGISTER_TEST( TestMisoQuatBatch() )
 
   PRINT_TEST_SUMMARY();
   return err;
@@ -0,0 +1,193 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/DataContainers/SurfaceMeshDataContainer.h"
+#include "DREAM3DLib/SurfaceMeshingFilters/QuickSurfaceMesh.h"
+
+#include "UnitTestSupport.hpp"
+
+// The expected values were written by the original QuickSurfaceMesh. Nodes are
+// given by their raster index in the (xP+1)*(yP+1)*(zP+1) lattice of nodes since
+// only the numbering of the nodes is allowed to change. Each triangle is its 3
+// nodes followed by its 2 face labels.
+
+// A single voxel: every face and node is on the boundary of the volume
+static const int k_BoundaryNodeTypes[8] = { 12, 12, 12, 12, 12, 12, 12, 12 };
+static const int k_BoundaryTriangles[12][5] = {
+  { 0, 2, 4, 7, -1 }, { 2, 6, 4, 7, -1 }, { 0, 4, 1, 7, -1 }, { 1, 4, 5, 7, -1 },
+  { 0, 1, 2, 7, -1 }, { 1, 3, 2, 7, -1 }, { 5, 3, 1, 7, -1 }, { 5, 7, 3, 7, -1 },
+  { 7, 2, 3, 7, -1 }, { 7, 6, 2, 7, -1 }, { 4, 7, 5, 7, -1 }, { 6, 7, 4, 7, -1 }
+};
+
+// 2x2x2 voxels where 4 grains meet at the center node and along the edges that
+// run from it to the boundary
+static const int32_t k_JunctionGrainIds[8] = { 1, 2, 3, 3, 1, 2, 4, 4 };
+static const int k_JunctionNodeTypes[27] = {
+  12, 13, 12, 13, 14, 13, 12, 12, 12,
+  12, 13, 12, 14,  4, 14, 13, 13, 13,
+  12, 13, 12, 13, 14, 13, 12, 12, 12
+};
+static const int k_JunctionTriangles[64][5] = {
+  { 0, 3, 9, 1, -1 }, { 3, 12, 9, 1, -1 }, { 0, 9, 1, 1, -1 }, { 1, 9, 10, 1, -1 },
+  { 0, 1, 3, 1, -1 }, { 1, 4, 3, 1, -1 }, { 1, 4, 10, 2, 1 }, { 4, 13, 10, 2, 1 },
+  { 4, 3, 13, 3, 1 }, { 3, 12, 13, 3, 1 }, { 1, 10, 2, 2, -1 }, { 2, 10, 11, 2, -1 },
+  { 1, 2, 4, 2, -1 }, { 2, 5, 4, 2, -1 }, { 11, 5, 2, 2, -1 }, { 11, 14, 5, 2, -1 },
+  { 5, 4, 14, 3, 2 }, { 4, 13, 14, 3, 2 }, { 3, 6, 12, 3, -1 }, { 6, 15, 12, 3, -1 },
+  { 3, 4, 6, 3, -1 }, { 4, 7, 6, 3, -1 }, { 16, 6, 7, 3, -1 }, { 16, 15, 6, 3, -1 },
+  { 13, 16, 12, 4, 3 }, { 12, 16, 15, 4, 3 }, { 4, 5, 7, 3, -1 }, { 5, 8, 7, 3, -1 },
+  { 14, 8, 5, 3, -1 }, { 14, 17, 8, 3, -1 }, { 17, 7, 8, 3, -1 }, { 17, 16, 7, 3, -1 },
+  { 14, 17, 13, 4, 3 }, { 13, 17, 16, 4, 3 }, { 9, 12, 18, 1, -1 }, { 12, 21, 18, 1, -1 },
+  { 9, 18, 10, 1, -1 }, { 10, 18, 19, 1, -1 }, { 10, 13, 19, 2, 1 }, { 13, 22, 19, 2, 1 },
+  { 13, 12, 22, 4, 1 }, { 12, 21, 22, 4, 1 }, { 18, 22, 19, 1, -1 }, { 21, 22, 18, 1, -1 },
+  { 10, 19, 11, 2, -1 }, { 11, 19, 20, 2, -1 }, { 20, 14, 11, 2, -1 }, { 20, 23, 14, 2, -1 },
+  { 14, 13, 23, 4, 2 }, { 13, 22, 23, 4, 2 }, { 19, 23, 20, 2, -1 }, { 22, 23, 19, 2, -1 },
+  { 12, 15, 21, 4, -1 }, { 15, 24, 21, 4, -1 }, { 25, 15, 16, 4, -1 }, { 25, 24, 15, 4, -1 },
+  { 21, 25, 22, 4, -1 }, { 24, 25, 21, 4, -1 }, { 23, 17, 14, 4, -1 }, { 23, 26, 17, 4, -1 },
+  { 26, 16, 17, 4, -1 }, { 26, 25, 16, 4, -1 }, { 22, 26, 23, 4, -1 }, { 25, 26, 22, 4, -1 }
+};
+
+// -----------------------------------------------------------------------------
+// Meshes the volume and compares the mesh with the expected triangles, face
+// labels, node types and vertex positions
+// -----------------------------------------------------------------------------
+void CheckSurfaceMesh(size_t dims[3], const int32_t* grainIds, const int* nodeTypes, const int (*triangles)[5], size_t numTriangles)
+{
+  float res[3] = { 0.5f, 1.0f, 2.0f };
+  float origin[3] = { 1.0f, 2.0f, 3.0f };
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  m->setDimensions(dims);
+  m->setResolution(res);
+  m->setOrigin(origin);
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+  Int32ArrayType::Pointer grainIdsPtr = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::GrainIds);
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    grainIdsPtr->SetValue(i, grainIds[i]);
+  }
+  m->addCellData(DREAM3D::CellData::GrainIds, grainIdsPtr);
+
+  SurfaceMeshDataContainer::Pointer sm = SurfaceMeshDataContainer::New();
+  QuickSurfaceMesh::Pointer filter = QuickSurfaceMesh::New();
+  filter->setVoxelDataContainer(m.get());
+  filter->setSurfaceMeshDataContainer(sm.get());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+
+  DREAM3D::SurfaceMesh::VertListPointer_t vertices = sm->getVertices();
+  DREAM3D::SurfaceMesh::FaceListPointer_t faces = sm->getFaces();
+  Int32ArrayType* faceLabels = Int32ArrayType::SafePointerDownCast(sm->getFaceData(DREAM3D::FaceData::SurfaceMeshFaceLabels).get());
+  Int8ArrayType* types = Int8ArrayType::SafePointerDownCast(sm->getVertexData(DREAM3D::VertexData::SurfaceMeshNodeType).get());
+  DREAM3D_REQUIRE(NULL != faceLabels)
+  DREAM3D_REQUIRE(NULL != types)
+
+  // Every node of these volumes is used, so each lattice node must show up exactly once
+  size_t nodesX = dims[0] + 1;
+  size_t nodesY = dims[1] + 1;
+  size_t numNodes = nodesX * nodesY * (dims[2] + 1);
+  DREAM3D_REQUIRE_EQUAL(vertices->GetNumberOfTuples(), numNodes)
+  std::vector<int> latticeIndex(numNodes, -1);
+  std::vector<bool> found(numNodes, false);
+  for (size_t n = 0; n < numNodes; ++n)
+  {
+    int ijk[3];
+    for (int d = 0; d < 3; ++d)
+    {
+      float pos = (*vertices)[n].pos[d];
+      ijk[d] = static_cast<int>(floorf((pos - origin[d]) / res[d] + 0.5f));
+      DREAM3D_REQUIRE(ijk[d] >= 0 && ijk[d] <= static_cast<int>(dims[d]))
+      DREAM3D_REQUIRE_EQUAL(pos, float((float(ijk[d]) * res[d]) + origin[d]))
+    }
+    size_t lattice = (ijk[2] * nodesX * nodesY) + (ijk[1] * nodesX) + ijk[0];
+    DREAM3D_REQUIRE_EQUAL(found[lattice], false)
+    found[lattice] = true;
+    latticeIndex[n] = static_cast<int>(lattice);
+    DREAM3D_REQUIRE_EQUAL(static_cast<int>(types->GetValue(n)), nodeTypes[lattice])
+  }
+
+  DREAM3D_REQUIRE_EQUAL(faces->GetNumberOfTuples(), numTriangles)
+  for (size_t t = 0; t < numTriangles; ++t)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      DREAM3D_REQUIRE_EQUAL(latticeIndex[(*faces)[t].verts[c]], triangles[t][c])
+    }
+    DREAM3D_REQUIRE_EQUAL(faceLabels->GetValue(2 * t), triangles[t][3])
+    DREAM3D_REQUIRE_EQUAL(faceLabels->GetValue(2 * t + 1), triangles[t][4])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestBoundaryVoxel()
+{
+  size_t dims[3] = { 1, 1, 1 };
+  int32_t grainIds[1] = { 7 };
+  CheckSurfaceMesh(dims, grainIds, k_BoundaryNodeTypes, k_BoundaryTriangles, 12);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGrainJunction()
+{
+  size_t dims[3] = { 2, 2, 2 };
+  CheckSurfaceMesh(dims, k_JunctionGrainIds, k_JunctionNodeTypes, k_JunctionTriangles, 64);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestBoundaryVoxel() )
+  DREAM3D_REGISTER_TEST( TestGrainJunction() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
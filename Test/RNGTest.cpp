@@ -29,31 +29,221 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 #include <stdlib.h>
+#include <math.h>
 #include <iostream>
+#include <vector>
+
+#include "MXA/Common/LogTime.h"
 
 #include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+#include "DREAM3DLib/Utilities/PhiloxRandom.h"
 
-#include "MXA/Common/LogTime.h"
+#include "UnitTestSupport.hpp"
 
-int main(int argc, char **argv)
+// Kept small so the throughput report adds little to the test run
+#define THROUGHPUT_DRAWS 2000000
+
+// -----------------------------------------------------------------------------
+//  Known answers from the Random123 distribution (kat_vectors, philox4x32 10 rounds)
+// -----------------------------------------------------------------------------
+void TestPhiloxKnownAnswers()
 {
-  std::cout << "RNGTest Start..." << std::endl;
-  DREAM3D_RANDOMNG_NEW()
-    float random;
-  for (int i = 0; i < 1000000; ++i)
+  uint32_t counters[3][4] = { {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                              {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                              {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344} };
+  uint32_t keys[3][2] = { {0x00000000, 0x00000000},
+                          {0xffffffff, 0xffffffff},
+                          {0xa4093822, 0x299f31d0} };
+  uint32_t answers[3][4] = { {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                             {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                             {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1} };
+  for (int i = 0; i < 3; ++i)
+  {
+    uint32_t out[4];
+    PhiloxRandom::philox4x32(counters[i], keys[i], out);
+    for (int j = 0; j < 4; ++j)
+    {
+      DREAM3D_REQUIRE_EQUAL(out[j], answers[i][j])
+    }
+  }
+
+  // The first block of seed 0, stream 0 is the first known answer
+  PhiloxRandom rg;
+  for (int j = 0; j < 4; ++j)
+  {
+    DREAM3D_REQUIRE_EQUAL(rg.genrand_int32(), answers[0][j])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPhiloxSeekAndDiscard()
+{
+  PhiloxRandom rg(0x0123456789ABCDEFULL, 7);
+  std::vector<uint32_t> values(1000);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = rg.genrand_int32();
+  }
+  DREAM3D_REQUIRE_EQUAL(rg.getPosition(), 1000)
+
+  PhiloxRandom jumped(0x0123456789ABCDEFULL, 7);
+  jumped.seek(517);
+  DREAM3D_REQUIRE_EQUAL(jumped.genrand_int32(), values[517])
+  jumped.discard(100);
+  DREAM3D_REQUIRE_EQUAL(jumped.genrand_int32(), values[618])
+  jumped.seek(3);
+  DREAM3D_REQUIRE_EQUAL(jumped.genrand_int32(), values[3])
+
+  // Copies continue independently from the same position
+  PhiloxRandom copy(jumped);
+  DREAM3D_REQUIRE_EQUAL(copy.genrand_int32(), values[4])
+  DREAM3D_REQUIRE_EQUAL(jumped.genrand_int32(), values[4])
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPhiloxStreams()
+{
+  PhiloxRandom rg(42);
+  PhiloxRandom stream = rg.createStream(3);
+  PhiloxRandom direct(42, 3);
+  DREAM3D_REQUIRE_EQUAL(stream.getSeed(), 42)
+  DREAM3D_REQUIRE_EQUAL(stream.getStream(), 3)
+  int same = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    uint32_t a = rg.genrand_int32();
+    uint32_t b = stream.genrand_int32();
+    DREAM3D_REQUIRE_EQUAL(b, direct.genrand_int32())
+    if (a == b) { same++; }
+  }
+  DREAM3D_REQUIRE(same < 2)
+
+  // Splitting a loop into chunks and seeking each chunk to its first index gives
+  // the same numbers no matter what the chunk size is
+  const size_t count = 10007;
+  std::vector<double> serial(count);
+  PhiloxRandom serialRg(99, 1);
+  for (size_t i = 0; i < count; ++i)
+  {
+    serial[i] = serialRg.genrand_res53();
+  }
+  size_t chunkSizes[3] = {1, 64, 1000};
+  for (int c = 0; c < 3; ++c)
   {
-    random = static_cast<float>( rg.genrand_res53() );
-    if (random > 0.95)
+    for (size_t start = 0; start < count; start += chunkSizes[c])
     {
-      std::cout << "Here" << std::endl;
+      PhiloxRandom chunkRg(99, 1);
+      chunkRg.seek(2 * start);
+      size_t end = (start + chunkSizes[c] < count) ? start + chunkSizes[c] : count;
+      for (size_t i = start; i < end; ++i)
+      {
+        DREAM3D_REQUIRE_EQUAL(chunkRg.genrand_res53(), serial[i])
+      }
     }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPhiloxDistributions()
+{
+  PhiloxRandom rg(2012);
+  const int count = 200000;
+  double sum = 0.0;
+  double sumSq = 0.0;
+  for (int i = 0; i < count; ++i)
+  {
+    double value = rg.genrand_res53();
+    DREAM3D_REQUIRE(value >= 0.0 && value < 1.0)
+    sum += value;
+  }
+  DREAM3D_REQUIRE(fabs(sum / count - 0.5) < 0.005)
 
+  sum = 0.0;
+  for (int i = 0; i < count; ++i)
+  {
+    double value = rg.genrand_norm(1.0, 2.0);
+    sum += value;
+    sumSq += value * value;
   }
+  double mean = sum / count;
+  DREAM3D_REQUIRE(fabs(mean - 1.0) < 0.02)
+  DREAM3D_REQUIRE(fabs(sumSq / count - mean * mean - 4.0) < 0.1)
 
-  std::cout << "RNGTest Ending" << std::endl;
-  return EXIT_SUCCESS;
+  // Both of Cheng's algorithms: BB for a, b > 1 and BC otherwise
+  double params[3][2] = { {2.0, 5.0}, {0.5, 0.8}, {15.0, 1.5} };
+  for (int p = 0; p < 3; ++p)
+  {
+    sum = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+      double value = rg.genrand_beta(params[p][0], params[p][1]);
+      DREAM3D_REQUIRE(value >= 0.0 && value <= 1.0)
+      sum += value;
+    }
+    double expected = params[p][0] / (params[p][0] + params[p][1]);
+    DREAM3D_REQUIRE(fabs(sum / count - expected) < 0.005)
+  }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+void printThroughput(const std::string &name, T &rg)
+{
+  unsigned long long int millis = MXA::getMilliSeconds();
+  uint32_t bits = 0;
+  for (int i = 0; i < THROUGHPUT_DRAWS; ++i)
+  {
+    bits ^= static_cast<uint32_t>(rg.genrand_int32());
+  }
+  unsigned long long int intMillis = MXA::getMilliSeconds() - millis;
 
+  millis = MXA::getMilliSeconds();
+  double sum = 0.0;
+  for (int i = 0; i < THROUGHPUT_DRAWS / 2; ++i)
+  {
+    sum += rg.genrand_res53();
+  }
+  unsigned long long int res53Millis = MXA::getMilliSeconds() - millis;
 
+  if (intMillis == 0) { intMillis = 1; }
+  if (res53Millis == 0) { res53Millis = 1; }
+  std::cout << "  " << name << ": genrand_int32 " << (THROUGHPUT_DRAWS / 1000.0 / intMillis) << " M/s  genrand_res53 "
+            << (THROUGHPUT_DRAWS / 2 / 1000.0 / res53Millis) << " M/s  (" << bits << ", " << sum << ")" << std::endl;
+}
 
+// -----------------------------------------------------------------------------
+//  Only reports the draw rates of both generators. Timings vary too much from
+//  machine to machine to assert on
+// -----------------------------------------------------------------------------
+void TestThroughput()
+{
+  DREAM3D_RANDOMNG_NEW()
+  printThroughput("DREAM3DRandom", rg);
+  PhiloxRandom philox(MXA::getMilliSeconds());
+  printThroughput("PhiloxRandom ", philox);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestPhiloxKnownAnswers() )
+  DREAM3D_REGISTER_TEST( TestPhiloxSeekAndDiscard() )
+  DREAM3D_REGISTER_TEST( TestPhiloxStreams() )
+  DREAM3D_REGISTER_TEST( TestPhiloxDistributions() )
+  DREAM3D_REGISTER_TEST( TestThroughput() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
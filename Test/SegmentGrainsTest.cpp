@@ -0,0 +1,221 @@
+/* ============================================================================
+ * Copyright (c) 2013, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2013, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/DataArrays/DataArray.hpp"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/Math/OrientationMath.h"
+#include "DREAM3DLib/Math/QuaternionMath.hpp"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+#include "DREAM3DLib/ReconstructionFilters/EBSDSegmentGrains.h"
+#include "DREAM3DLib/ReconstructionFilters/ScalarSegmentGrains.h"
+
+#include "UnitTestSupport.hpp"
+
+// The edge length of the test volume. Pass a larger value on the command line,
+// for example 1000 for a 1e9 voxel volume, to benchmark the two segmentations.
+static size_t s_Dim = 64;
+// The edge length of the cubic blocks that make up the synthetic grains
+static const size_t k_BlockSize = 8;
+
+// -----------------------------------------------------------------------------
+// Builds a volume of cubic grains with random orientations, a little orientation
+// noise inside every grain and a sprinkling of bad voxels.
+// -----------------------------------------------------------------------------
+static VoxelDataContainer::Pointer createSegmentationVolume()
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+  size_t dims[3] = { s_Dim, s_Dim, s_Dim };
+  m->setDimensions(dims);
+  size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  size_t blocks = (s_Dim + k_BlockSize - 1) / k_BlockSize;
+  size_t numBlocks = blocks * blocks * blocks;
+
+  unsigned long long int seed = 12345;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  std::vector<float> blockEulers(numBlocks * 3, 0.0f);
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    blockEulers[i * 3 + 0] = static_cast<float>(rg.genrand_res53() * 2.0 * M_PI);
+    blockEulers[i * 3 + 1] = static_cast<float>(rg.genrand_res53() * M_PI);
+    blockEulers[i * 3 + 2] = static_cast<float>(rg.genrand_res53() * 2.0 * M_PI);
+  }
+
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, 4, DREAM3D::CellData::Quats);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, DREAM3D::CellData::Phases);
+  BoolArrayType::Pointer goodVoxels = BoolArrayType::CreateArray(totalPoints, DREAM3D::CellData::GoodVoxels);
+  Int32ArrayType::Pointer blockIds = Int32ArrayType::CreateArray(totalPoints, "BlockIds");
+  QuatF* q = reinterpret_cast<QuatF*>(quats->GetPointer(0));
+
+  for (size_t z = 0; z < dims[2]; ++z)
+  {
+    for (size_t y = 0; y < dims[1]; ++y)
+    {
+      for (size_t x = 0; x < dims[0]; ++x)
+      {
+        size_t i = (z * dims[1] + y) * dims[0] + x;
+        size_t block = ((z / k_BlockSize) * blocks + (y / k_BlockSize)) * blocks + (x / k_BlockSize);
+        float noise = static_cast<float>((rg.genrand_res53() - 0.5) * 0.005);
+        OrientationMath::EulertoQuat(q[i], blockEulers[block * 3] + noise, blockEulers[block * 3 + 1], blockEulers[block * 3 + 2]);
+        phases->SetValue(i, 1);
+        goodVoxels->SetValue(i, rg.genrand_res53() > 0.03);
+        blockIds->SetValue(i, static_cast<int32_t>(block));
+      }
+    }
+  }
+  m->addCellData(DREAM3D::CellData::Quats, quats);
+  m->addCellData(DREAM3D::CellData::Phases, phases);
+  m->addCellData(DREAM3D::CellData::GoodVoxels, goodVoxels);
+  m->addCellData("BlockIds", blockIds);
+
+  typedef DataArray<unsigned int> XTalStructArrayType;
+  XTalStructArrayType::Pointer xtal = XTalStructArrayType::CreateArray(2, DREAM3D::EnsembleData::CrystalStructures);
+  xtal->SetValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  xtal->SetValue(1, Ebsd::CrystalStructure::Cubic_High);
+  m->addEnsembleData(DREAM3D::EnsembleData::CrystalStructures, xtal);
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+// Renumbers the grains in the order of their lowest voxel index, which is the
+// numbering that the parallel segmentation produces.
+// -----------------------------------------------------------------------------
+static std::vector<int32_t> renumberGrains(int32_t* grainIds, size_t totalPoints, size_t totalFields)
+{
+  std::vector<int32_t> newIds(totalFields, 0);
+  std::vector<int32_t> result(totalPoints, 0);
+  int32_t gnum = 1;
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    int32_t grain = grainIds[i];
+    if (grain <= 0) { continue; }
+    if (newIds[grain] == 0)
+    {
+      newIds[grain] = gnum;
+      ++gnum;
+    }
+    result[i] = newIds[grain];
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+static void CompareSegmentations(SegmentGrains* floodFill, SegmentGrains* unionFind)
+{
+  VoxelDataContainer::Pointer m = createSegmentationVolume();
+  size_t totalPoints = m->getTotalPoints();
+
+  floodFill->setVoxelDataContainer(m.get());
+  floodFill->setUseParallelSegmentation(false);
+  floodFill->execute();
+  DREAM3D_REQUIRE(floodFill->getErrorCondition() >= 0)
+  size_t floodFillFields = m->getNumFieldTuples();
+  Int32ArrayType* grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get());
+  DREAM3D_REQUIRE_NE(NULL, grainIds)
+  std::vector<int32_t> expected = renumberGrains(grainIds->GetPointer(0), totalPoints, floodFillFields);
+
+  m->removeCellData(DREAM3D::CellData::GrainIds);
+  m->resizeFieldDataArrays(1);
+
+  unionFind->setVoxelDataContainer(m.get());
+  unionFind->setUseParallelSegmentation(true);
+  unionFind->execute();
+  DREAM3D_REQUIRE(unionFind->getErrorCondition() >= 0)
+  DREAM3D_REQUIRE_EQUAL(floodFillFields, m->getNumFieldTuples())
+  grainIds = Int32ArrayType::SafePointerDownCast(m->getCellData(DREAM3D::CellData::GrainIds).get());
+  DREAM3D_REQUIRE_NE(NULL, grainIds)
+  for (size_t i = 0; i < totalPoints; ++i)
+  {
+    DREAM3D_REQUIRE_EQUAL(expected[i], grainIds->GetValue(i))
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestEBSDSegmentGrains()
+{
+  EBSDSegmentGrains::Pointer floodFill = EBSDSegmentGrains::New();
+  floodFill->setMisorientationTolerance(5.0f);
+  floodFill->setRandomizeGrainIds(false);
+  EBSDSegmentGrains::Pointer unionFind = EBSDSegmentGrains::New();
+  unionFind->setMisorientationTolerance(5.0f);
+  unionFind->setRandomizeGrainIds(false);
+  CompareSegmentations(floodFill.get(), unionFind.get());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestScalarSegmentGrains()
+{
+  ScalarSegmentGrains::Pointer floodFill = ScalarSegmentGrains::New();
+  floodFill->setScalarArrayName("BlockIds");
+  floodFill->setScalarTolerance(0.0f);
+  floodFill->setRandomizeGrainIds(false);
+  ScalarSegmentGrains::Pointer unionFind = ScalarSegmentGrains::New();
+  unionFind->setScalarArrayName("BlockIds");
+  unionFind->setScalarTolerance(0.0f);
+  unionFind->setRandomizeGrainIds(false);
+  CompareSegmentations(floodFill.get(), unionFind.get());
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+  if (argc > 1)
+  {
+    s_Dim = static_cast<size_t>(atoi(argv[1]));
+  }
+
+  DREAM3D_REGISTER_TEST( TestEBSDSegmentGrains() )
+  DREAM3D_REGISTER_TEST( TestScalarSegmentGrains() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
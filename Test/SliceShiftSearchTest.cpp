@@ -0,0 +1,200 @@
+/* ============================================================================
+ * Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/SliceShiftSearch.h"
+#include "DREAM3DLib/Utilities/DREAM3DRandom.h"
+
+#include "UnitTestSupport.hpp"
+
+static const int64_t k_NX = 45;
+static const int64_t k_NY = 38;
+static const int64_t k_NZ = 6;
+
+/**
+ * @brief Mismatch of the good flags, as AlignSectionsFeature scores a shift
+ */
+class MaskScorer : public SliceShiftScorer
+{
+    const std::vector<bool> &m_Mask;
+    const int64_t* m_Dims;
+
+  public:
+    MaskScorer(const std::vector<bool> &mask, const int64_t* dims) : m_Mask(mask), m_Dims(dims) {}
+    virtual ~MaskScorer() {}
+
+    bool at(int64_t x, int64_t y, int64_t z) const { return m_Mask[(z * m_Dims[1] + y) * m_Dims[0] + x]; }
+
+    virtual float cost(int64_t slice, int xshift, int yshift, int step) const
+    {
+      float mismatches = 0;
+      float count = 0;
+      for (int64_t y = 0; y < m_Dims[1]; y += step)
+      {
+        for (int64_t x = 0; x < m_Dims[0]; x += step)
+        {
+          if (x + xshift < 0 || x + xshift >= m_Dims[0] || y + yshift < 0 || y + yshift >= m_Dims[1]) { continue; }
+          if (at(x, y, slice + 1) != at(x + xshift, y + yshift, slice)) { mismatches++; }
+          count++;
+        }
+      }
+      return mismatches / count;
+    }
+
+    virtual bool costTable(int64_t slice, std::vector<float> &table) const
+    {
+      std::vector<char> ref(m_Dims[0] * m_Dims[1]), cur(m_Dims[0] * m_Dims[1]);
+      for (int64_t y = 0; y < m_Dims[1]; ++y)
+      {
+        for (int64_t x = 0; x < m_Dims[0]; ++x)
+        {
+          ref[y * m_Dims[0] + x] = at(x, y, slice + 1);
+          cur[y * m_Dims[0] + x] = at(x, y, slice);
+        }
+      }
+      SliceShiftSearch::mismatchTable(reinterpret_cast<bool*>(&(ref.front())), reinterpret_cast<bool*>(&(cur.front())), m_Dims, 4, table);
+      return true;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// An ellipse with a few holes that moves by a known shift from slice to slice.
+// Slice z is moved by shifts[z] relative to slice z + 1.
+// -----------------------------------------------------------------------------
+std::vector<bool> createStack(const std::vector<int> &xshifts, const std::vector<int> &yshifts)
+{
+  unsigned long long int seed = 1357;
+  DREAM3D_RANDOMNG_NEW_SEEDED(seed)
+  std::vector<bool> mask(k_NX * k_NY * k_NZ, false);
+  float cx = 0.45f * k_NX, cy = 0.5f * k_NY;
+  for (int64_t z = k_NZ - 1; z >= 0; --z)
+  {
+    if (z < k_NZ - 1)
+    {
+      cx += xshifts[z];
+      cy += yshifts[z];
+    }
+    for (int64_t y = 0; y < k_NY; ++y)
+    {
+      for (int64_t x = 0; x < k_NX; ++x)
+      {
+        float ex = (x - cx) / (0.3f * k_NX), ey = (y - cy) / (0.28f * k_NY);
+        mask[(z * k_NY + y) * k_NX + x] = (ex * ex + ey * ey < 1.0f) && (ex > 0.0f || ey > 0.0f || rg.genrand_res53() > 0.1);
+      }
+    }
+  }
+  return mask;
+}
+
+// -----------------------------------------------------------------------------
+// The FFT table must hold exactly the costs of the direct count
+// -----------------------------------------------------------------------------
+void TestMismatchTable()
+{
+  std::vector<int> xshifts(k_NZ, 0), yshifts(k_NZ, 0);
+  xshifts[2] = 3;
+  yshifts[2] = -2;
+  std::vector<bool> mask = createStack(xshifts, yshifts);
+  int64_t dims[3] = { k_NX, k_NY, k_NZ };
+  MaskScorer scorer(mask, dims);
+
+  std::vector<float> table;
+  for (int64_t slice = 0; slice < k_NZ - 1; ++slice)
+  {
+    DREAM3D_REQUIRE_EQUAL(scorer.costTable(slice, table), true)
+    DREAM3D_REQUIRE_EQUAL(table.size(), static_cast<size_t>(k_NX * k_NY))
+    for (int y = static_cast<int>(1 - k_NY / 2); y < k_NY / 2; ++y)
+    {
+      for (int x = static_cast<int>(1 - k_NX / 2); x < k_NX / 2; ++x)
+      {
+        DREAM3D_REQUIRE_EQUAL(table[(y + k_NY / 2) * k_NX + (x + k_NX / 2)], scorer.cost(slice, x, y, 4))
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSearch()
+{
+  std::vector<int> xshifts(k_NZ, 0), yshifts(k_NZ, 0);
+  int knownX[k_NZ - 1] = { 2, -9, 0, 12, -4 };
+  int knownY[k_NZ - 1] = { -1, 3, 8, -6, 0 };
+  for (int64_t z = 0; z < k_NZ - 1; ++z)
+  {
+    xshifts[z] = knownX[z];
+    yshifts[z] = knownY[z];
+  }
+  std::vector<bool> mask = createStack(xshifts, yshifts);
+  int64_t dims[3] = { k_NX, k_NY, k_NZ };
+  size_t udims[3] = { k_NX, k_NY, k_NZ };
+  MaskScorer scorer(mask, dims);
+
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    SliceShiftSearch search(&scorer, udims);
+    search.setPyramidLevels(mode == 1 ? 2 : 0);
+    search.setUseCostTable(mode == 2);
+    std::vector<int> foundX(k_NZ, 100), foundY(k_NZ, 100);
+    search.findShifts(0, k_NZ - 1, foundX, foundY);
+    for (int64_t z = 0; z < k_NZ - 1; ++z)
+    {
+      DREAM3D_REQUIRE_EQUAL(foundX[z], knownX[z])
+      DREAM3D_REQUIRE_EQUAL(foundY[z], knownY[z])
+    }
+    DREAM3D_REQUIRE_EQUAL(foundX[k_NZ - 1], 100)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestMismatchTable() )
+  DREAM3D_REGISTER_TEST( TestSearch() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -35,6 +35,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 
+#include <list>
 #include <string>
 
 #include "MXA/Common/LogTime.h"
@@ -45,6 +46,13 @@
 #include "DREAM3DLib/Common/Constants.h"
 #include "DREAM3DLib/DataArrays/StructArray.hpp"
 #include "DREAM3DLib/FilterParameters/FilterParameter.h"
+#include "DREAM3DLib/DataContainers/VoxelDataContainer.h"
+#include "DREAM3DLib/SyntheticBuildingFilters/InitializeSyntheticVolume.h"
+#include "DREAM3DLib/SyntheticBuildingFilters/PackPrimaryPhases.h"
+#include "DREAM3DLib/SyntheticBuildingFilters/MatchCrystallography.h"
+#include "DREAM3DLib/StatisticsFilters/FindNeighbors.h"
+#include "DREAM3DLib/StatisticsFilters/FindNumFields.h"
+#include "DREAM3DLib/GenericFilters/FindSurfaceGrains.h"
 
 
 #include "UnitTestSupport.hpp"
@@ -68,7 +76,169 @@ void Test2PhaseMatrixPrecipitate()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VoxelDataContainer::Pointer PackPrimaryPhasesVolume(size_t dims, int moveBatchSize, int seed)
+{
+  VoxelDataContainer::Pointer m = VoxelDataContainer::New();
+
+  InitializeSyntheticVolume::Pointer init = InitializeSyntheticVolume::New();
+  init->setVoxelDataContainer(m.get());
+  init->setInputFile(UnitTest::SyntheticTest::PrimaryInputFile);
+  std::vector<uint32_t> shapeTypes;
+  shapeTypes.push_back(DREAM3D::ShapeType::UnknownShapeType);
+  shapeTypes.push_back(DREAM3D::ShapeType::EllipsoidShape);
+  init->setShapeTypes(shapeTypes);
+  init->setXVoxels(dims);
+  init->setYVoxels(dims);
+  init->setZVoxels(dims);
+  init->setXRes(1.0f);
+  init->setYRes(1.0f);
+  init->setZRes(1.0f);
+  init->execute();
+  DREAM3D_REQUIRE(init->getErrorCondition() >= 0)
+
+  PackPrimaryPhases::Pointer pack = PackPrimaryPhases::New();
+  pack->setVoxelDataContainer(m.get());
+  pack->setVtkOutputFile("");
+  pack->setMoveBatchSize(moveBatchSize);
+  pack->setRandomSeed(seed);
+  pack->execute();
+  DREAM3D_REQUIRE(pack->getErrorCondition() >= 0)
+  return m;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer PackPrimaryPhasesWithSeed(int moveBatchSize, int seed)
+{
+  VoxelDataContainer::Pointer m = PackPrimaryPhasesVolume(32, moveBatchSize, seed);
+  Int32ArrayType::Pointer grainIds = boost::dynamic_pointer_cast<Int32ArrayType>(m->getCellData(DREAM3D::CellData::GrainIds));
+  DREAM3D_REQUIRE(grainIds.get() != NULL)
+  return grainIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPackPrimaryPhasesRepeatable()
+{
+  int batchSizes[2] = {1, 16};
+  for (int b = 0; b < 2; b++)
+  {
+    Int32ArrayType::Pointer first = PackPrimaryPhasesWithSeed(batchSizes[b], 4567);
+    Int32ArrayType::Pointer second = PackPrimaryPhasesWithSeed(batchSizes[b], 4567);
+    DREAM3D_REQUIRE_EQUAL(first->GetNumberOfTuples(), second->GetNumberOfTuples())
+    int32_t maxGrain = 0;
+    for (size_t i = 0; i < first->GetNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(first->GetValue(i), second->GetValue(i))
+      if(first->GetValue(i) > maxGrain) { maxGrain = first->GetValue(i); }
+    }
+    DREAM3D_REQUIRE(maxGrain > 1)
+  }
+}
+
+
+// -----------------------------------------------------------------------------
+// Adds primary phases with the same statistics as the first one and deals the
+// grains out to the phases in turn
+// -----------------------------------------------------------------------------
+void SplitIntoPhases(VoxelDataContainer* m, size_t numPhases)
+{
+  std::list<std::string> names = m->getEnsembleArrayNameList();
+  for (std::list<std::string>::iterator iter = names.begin(); iter != names.end(); ++iter)
+  {
+    IDataArray::Pointer array = m->getEnsembleData(*iter);
+    array->Resize(numPhases + 1);
+    for (size_t p = 2; p <= numPhases; p++)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->CopyTuple(1, p), 0)
+    }
+  }
+  m->setNumEnsembleTuples(numPhases + 1);
 
+  Int32ArrayType::Pointer fieldPhases = boost::dynamic_pointer_cast<Int32ArrayType>(m->getFieldData(DREAM3D::FieldData::Phases));
+  Int32ArrayType::Pointer cellPhases = boost::dynamic_pointer_cast<Int32ArrayType>(m->getCellData(DREAM3D::CellData::Phases));
+  Int32ArrayType::Pointer grainIds = boost::dynamic_pointer_cast<Int32ArrayType>(m->getCellData(DREAM3D::CellData::GrainIds));
+  DREAM3D_REQUIRE(fieldPhases.get() != NULL)
+  DREAM3D_REQUIRE(cellPhases.get() != NULL)
+  DREAM3D_REQUIRE(grainIds.get() != NULL)
+  for (size_t i = 1; i < fieldPhases->GetNumberOfTuples(); i++)
+  {
+    fieldPhases->SetValue(i, static_cast<int32_t>(1 + (i % numPhases)));
+  }
+  for (size_t i = 0; i < grainIds->GetNumberOfTuples(); i++)
+  {
+    cellPhases->SetValue(i, fieldPhases->GetValue(grainIds->GetValue(i)));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer MatchCrystallographyWithSeed(int trialsPerBatch, int seed, size_t numPhases, int maxIterations)
+{
+  VoxelDataContainer::Pointer m = PackPrimaryPhasesVolume(64, 16, 4567);
+  if (numPhases > 1)
+  {
+    SplitIntoPhases(m.get(), numPhases);
+  }
+
+  FindNeighbors::Pointer neighbors = FindNeighbors::New();
+  neighbors->setVoxelDataContainer(m.get());
+  neighbors->execute();
+  DREAM3D_REQUIRE(neighbors->getErrorCondition() >= 0)
+
+  FindSurfaceGrains::Pointer surface = FindSurfaceGrains::New();
+  surface->setVoxelDataContainer(m.get());
+  surface->execute();
+  DREAM3D_REQUIRE(surface->getErrorCondition() >= 0)
+
+  FindNumFields::Pointer numFields = FindNumFields::New();
+  numFields->setVoxelDataContainer(m.get());
+  numFields->execute();
+  DREAM3D_REQUIRE(numFields->getErrorCondition() >= 0)
+
+  MatchCrystallography::Pointer match = MatchCrystallography::New();
+  match->setVoxelDataContainer(m.get());
+  match->setMaxIterations(maxIterations);
+  match->setTrialsPerBatch(trialsPerBatch);
+  match->setRandomSeed(seed);
+  match->execute();
+  DREAM3D_REQUIRE(match->getErrorCondition() >= 0)
+
+  FloatArrayType::Pointer eulers = boost::dynamic_pointer_cast<FloatArrayType>(m->getFieldData(DREAM3D::FieldData::EulerAngles));
+  DREAM3D_REQUIRE(eulers.get() != NULL)
+  return eulers;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CompareEulers(FloatArrayType::Pointer single, FloatArrayType::Pointer batched)
+{
+  DREAM3D_REQUIRE_EQUAL(single->GetSize(), batched->GetSize())
+  DREAM3D_REQUIRE(single->GetSize() > 3)
+  for (size_t i = 0; i < single->GetSize(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(single->GetValue(i), batched->GetValue(i))
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The trials of a batch are scored together, but the orientations must not
+// depend on how many trials are in a batch. In the two phase case the matching
+// of the first phase gives up part way through a batch, which must not change
+// the orientations of the second phase either
+// -----------------------------------------------------------------------------
+void TestMatchCrystallographyBatches()
+{
+  CompareEulers(MatchCrystallographyWithSeed(1, 8910, 1, 5000), MatchCrystallographyWithSeed(64, 8910, 1, 5000));
+  CompareEulers(MatchCrystallographyWithSeed(1, 8910, 2, 100), MatchCrystallographyWithSeed(48, 8910, 2, 100));
+}
 
 // -----------------------------------------------------------------------------
 //  Use unit test framework
@@ -78,6 +248,8 @@ int main(int argc, char **argv)
   int err = EXIT_SUCCESS;
 
   DREAM3D_REGISTER_TEST( Test2PhaseMatrixPrecipitate() )
+  DREAM3D_REGISTER_TEST( TestPackPrimaryPhasesRepeatable() )
+  DREAM3D_REGISTER_TEST( TestMatchCrystallographyBatches() )
   DREAM3D_REGISTER_TEST( RemoveTestFiles() )
   PRINT_TEST_SUMMARY();
 
@@ -41,49 +41,173 @@
 // C++ Includes
 #include <string>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <list>
 
 // TCLAP Includes
 #include <tclap/CmdLine.h>
 #include <tclap/ValueArg.h>
+#include <tclap/ValuesConstraint.h>
 
 // Boost includes
 #include <boost/assert.hpp>
 
-// Qt Includes
-#include "QtGui/QApplication"
-#include "QtCore/QSettings"
-
-
 // MXA Includes
 #include "MXA/Common/LogTime.h"
 
+// HDF5 Includes
+#include "H5Support/H5Utilities.h"
+#include "H5Support/H5Lite.h"
+
 // DREAM3DLib includes
+#include "DREAM3DLib/DREAM3DLib.h"
 #include "DREAM3DLib/DREAM3DVersion.h"
-#include "DREAM3DLib/DataArrays/DataArray.hpp"
-#include "DREAM3DLib/OrientationOps/OrientationOps.h"
+#include "DREAM3DLib/Common/Constants.h"
+#include "DREAM3DLib/Common/FilterManager.h"
+#include "DREAM3DLib/Common/FilterPipeline.h"
+#include "DREAM3DLib/Common/PipelineProfiler.h"
+#include "DREAM3DLib/FilterParameters/H5FilterParametersReader.h"
 
-#include "FilterWidgets/FilterWidgetsLib.h"
-#include "PipelineBuilder/FilterWidgetManager.h"
-#include "PipelineBuilder/IFilterWidgetFactory.h"
 
+// -----------------------------------------------------------------------------
+// Builds the pipeline from the "Pipeline" group of a .dream3d file
+// -----------------------------------------------------------------------------
+int readPipeline(const std::string &filePath, FilterPipeline::Pointer pipeline)
+{
+  hid_t fileId = H5Utilities::openFile(filePath, true);
+  if (fileId < 0)
+  {
+    std::cout << "Error opening the pipeline file '" << filePath << "'" << std::endl;
+    return -1;
+  }
+  hid_t pipelineGroupId = H5Gopen(fileId, DREAM3D::HDF5::PipelineGroupName.c_str(), H5P_DEFAULT);
+  if (pipelineGroupId < 0)
+  {
+    std::cout << "The file '" << filePath << "' does not contain a '" << DREAM3D::HDF5::PipelineGroupName << "' group" << std::endl;
+    H5Utilities::closeFile(fileId);
+    return -1;
+  }
 
+  H5FilterParametersReader::Pointer reader = H5FilterParametersReader::New();
+  reader->setGroupId(pipelineGroupId);
 
+  std::list<std::string> groupList;
+  int err = H5Utilities::getGroupObjects(pipelineGroupId, H5Utilities::H5Support_GROUP, groupList);
+
+  FilterManager::Pointer fm = FilterManager::Instance();
+  std::string classNameStr = "";
+  for (int i = 0; i < static_cast<int>(groupList.size()); i++)
+  {
+    std::stringstream ss;
+    ss << i;
+    err = H5Lite::readStringAttribute(pipelineGroupId, ss.str(), "ClassName", classNameStr);
+    IFilterFactory::Pointer ff = fm->getFactoryForFilter(classNameStr);
+    if (err < 0 || NULL == ff.get())
+    {
+      std::cout << "Unknown filter '" << classNameStr << "' at index " << i << " of the pipeline" << std::endl;
+      err = -1;
+      break;
+    }
+    AbstractFilter::Pointer filter = ff->create();
+    filter->readFilterParameters(reader.get(), i);
+    pipeline->pushBack(filter);
+  }
+  H5Gclose(pipelineGroupId);
+  H5Utilities::closeFile(fileId);
+  return err;
+}
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int main (int argc, char  *argv[])
+int main (int argc, char *argv[])
 {
+  std::string pipelineFile;
+  std::string profileFile;
+  std::string profileFormat;
+
+  try
+  {
+    // Handle program options passed on command line.
+    TCLAP::CmdLine cmd("PipelineRunner", ' ', DREAM3DLib::Version::Complete());
 
-  QuatF q = QuaternionMathF::NewXYZW(0.565907, -0.24196, 0.106982, -0.7808710);
-  float euler[3] = {0.0, 0.0, 0.0};
+    TCLAP::ValueArg<std::string> pipelineArg( "p", "pipeline", "The .dream3d file whose 'Pipeline' group holds the filters to run.", true, "", "Pipeline File");
+    cmd.add(pipelineArg);
 
+    TCLAP::ValueArg<std::string> profileArg( "", "profile", "Writes the time, memory and array sizes of each filter to this file.", false, "", "Profile File");
+    cmd.add(profileArg);
 
-  OrientationMath::QuattoEuler(q, euler[0], euler[1], euler[2]);
+    std::vector<std::string> formats;
+    formats.push_back("json");
+    formats.push_back("csv");
+    TCLAP::ValuesConstraint<std::string> formatConstraint(formats);
+    TCLAP::ValueArg<std::string> profileFormatArg( "", "profile-format", "The format of the profile file.", false, "json", &formatConstraint);
+    cmd.add(profileFormatArg);
 
-//2.6014, 1.32595, 3.40947
-  std::cout << "Quat:  " << q.x << ", " << q.y << ", " << q.z << ", " << q.w << std::endl;
-  std::cout << "Euler: " << euler[0] << ", " << euler[1] << ", "  << euler[2] << std::endl;
+    // Parse the argv array.
+    cmd.parse(argc, argv);
+    if (argc == 1)
+    {
+      std::cout << "PipelineRunner program was not provided any arguments. Use the --help argument to show the help listing." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    pipelineFile = pipelineArg.getValue();
+    profileFile = profileArg.getValue();
+    profileFormat = profileFormatArg.getValue();
+  }
+  catch (TCLAP::ArgException &e) // catch any exceptions
+  {
+    std::cerr << logTime() << " error: " << e.error() << " for arg " << e.argId() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  FilterManager::Pointer fm = FilterManager::Instance();
+  FilterManager::RegisterKnownFilters(fm.get());
+
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  if (readPipeline(pipelineFile, pipeline) < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  PipelineProfiler::Pointer profiler = PipelineProfiler::NullPointer();
+  if (profileFile.empty() == false)
+  {
+    profiler = PipelineProfiler::New();
+    pipeline->setProfiler(profiler);
+  }
+
+  std::cout << logTime() << " Running " << pipeline->size() << " filters from " << pipelineFile << std::endl;
+  pipeline->run();
+  int err = pipeline->getErrorCondition();
+
+  if (NULL != profiler.get())
+  {
+    std::ofstream out(profileFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (out.is_open() == false)
+    {
+      std::cout << "Error opening the profile file '" << profileFile << "' for writing" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (profileFormat.compare("csv") == 0)
+    {
+      profiler->writeCsv(out);
+    }
+    else
+    {
+      profiler->writeJson(out);
+    }
+  }
+
+  if (err < 0)
+  {
+    std::cout << "The pipeline stopped with error " << err << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
 }
 
 